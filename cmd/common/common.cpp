@@ -63,6 +63,18 @@ void add_logging_options(CLI::App& cli, log::Settings& log_settings) {
     log_opts.add_flag("--log.utc", log_settings.log_utc, "Prints log timings in UTC");
     log_opts.add_flag("--log.threads", log_settings.log_threads, "Prints thread ids");
     log_opts.add_option("--log.file", log_settings.log_file, "Tee all log lines to given file name");
+    log_opts.add_flag("--log.async", log_settings.log_async, "Writes log lines from a background thread");
+    log_opts.add_option("--log.async.buffer", log_settings.log_async_buffer_size,
+                        "Size in bytes of the asynchronous log buffer of each thread")
+        ->capture_default_str();
+    std::map<std::string, log::OverflowPolicy> overflow_mapping{
+        {"drop", log::OverflowPolicy::kDrop},
+        {"block", log::OverflowPolicy::kBlock},
+    };
+    log_opts.add_option("--log.async.overflow", log_settings.log_async_overflow,
+                        "What to do when the asynchronous log buffer is full: drop the line or block")
+        ->transform(CLI::Transformer(overflow_mapping, CLI::ignore_case))
+        ->default_str("drop");
 }
 
 void add_option_chain(CLI::App& cli, uint64_t& network_id) {
@@ -94,6 +106,13 @@ void add_option_private_api_address(CLI::App& cli, std::string& private_api_addr
                            "DO NOT EXPOSE TO THE INTERNET");
 }
 
+void add_option_metrics_address(CLI::App& cli, std::string& metrics_address) {
+    add_option_ip_endpoint(cli, "--metrics.addr", metrics_address,
+                           "Metrics network address to serve Prometheus scrapes at /metrics\n"
+                           "An empty string means to not start the listener\n"
+                           "Use the endpoint form i.e. ip-address:port");
+}
+
 void add_option_remote_sentry_addresses(CLI::App& cli, std::vector<std::string>& addresses, bool is_required) {
     cli.add_option("--sentry.remote.addr", addresses, "Remote Sentry gRPC API addresses (comma separated): <host>:<port>,<host2>:<port2>,...")
         ->delimiter(',')
@@ -123,9 +142,40 @@ void add_option_wait_mode(CLI::App& cli, concurrency::WaitMode& wait_mode) {
         ->default_val(concurrency::WaitMode::blocking);
 }
 
+void add_option_cpu_set(CLI::App& cli, const std::string& name, concurrency::CpuSet& cpu_set, const std::string& description) {
+    cli.add_option_function<std::string>(
+           name,
+           [&cpu_set](const std::string& cpu_list) { cpu_set = concurrency::parse_cpu_set(cpu_list); },
+           description + " as CPU list (e.g. 0-3,8,10-11), empty means no pinning")
+        ->check([](const std::string& cpu_list) -> std::string {
+            try {
+                concurrency::parse_cpu_set(cpu_list);
+            } catch (const std::invalid_argument& ex) {
+                return ex.what();
+            }
+            return {};
+        });
+}
+
+void add_option_affinity_mode(CLI::App& cli, const std::string& name, concurrency::AffinityMode& affinity_mode, const std::string& description) {
+    std::map<std::string, concurrency::AffinityMode> affinity_mode_mapping{
+        {"shared", concurrency::AffinityMode::shared},
+        {"per_cpu", concurrency::AffinityMode::per_cpu},
+        {"per_numa_node", concurrency::AffinityMode::per_numa_node},
+    };
+    cli.add_option(name, affinity_mode, description)
+        ->capture_default_str()
+        ->check(CLI::Range(concurrency::AffinityMode::shared, concurrency::AffinityMode::per_numa_node))
+        ->transform(CLI::Transformer(affinity_mode_mapping, CLI::ignore_case))
+        ->default_val(concurrency::AffinityMode::shared);
+}
+
 void add_context_pool_options(CLI::App& cli, concurrency::ContextPoolSettings& settings) {
     add_option_num_contexts(cli, settings.num_contexts);
     add_option_wait_mode(cli, settings.wait_mode);
+    add_option_cpu_set(cli, "--contexts.cpus", settings.cpu_set, "The CPUs running the execution contexts");
+    add_option_affinity_mode(cli, "--contexts.affinity", settings.affinity_mode,
+                             "The placement of execution contexts over their CPUs: shared, per_cpu or per_numa_node");
 }
 
 std::string get_node_name_from_build_info(const buildinfo* build_info) {
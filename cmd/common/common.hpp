@@ -49,9 +49,18 @@ void add_option_etherbase(CLI::App& cli, std::string& etherbase_address);
 //! \brief Set up option for the IP address of Core private gRPC API
 void add_option_private_api_address(CLI::App& cli, std::string& private_api_address);
 
+//! \brief Set up option for the IP address of the Prometheus metrics endpoint
+void add_option_metrics_address(CLI::App& cli, std::string& metrics_address);
+
 //! \brief Set up option for the remote Sentry gRPC API address(es)
 void add_option_remote_sentry_addresses(CLI::App& cli, std::vector<std::string>& addresses, bool is_required);
 
+//! \brief Set up option for a set of CPUs where threads are pinned
+void add_option_cpu_set(CLI::App& cli, const std::string& name, concurrency::CpuSet& cpu_set, const std::string& description);
+
+//! \brief Set up option for the placement policy of threads over their CPUs
+void add_option_affinity_mode(CLI::App& cli, const std::string& name, concurrency::AffinityMode& affinity_mode, const std::string& description);
+
 //! \brief Set up context pool options
 void add_context_pool_options(CLI::App& cli, concurrency::ContextPoolSettings& settings);
 
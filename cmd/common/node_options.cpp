@@ -71,6 +71,7 @@ void add_node_options(CLI::App& cli, node::Settings& settings) {
     cli.add_flag("--fakepow", settings.fake_pow, "Disables proof-of-work verification");
 
     add_option_private_api_address(cli, settings.server_settings.address_uri);
+    add_option_metrics_address(cli, settings.metrics_end_point);
     add_option_remote_sentry_addresses(cli, settings.remote_sentry_addresses, /*is_required=*/false);
 
     // Chain options
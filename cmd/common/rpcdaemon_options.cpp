@@ -23,6 +23,7 @@
 
 #include <silkworm/silkrpc/common/constants.hpp>
 
+#include "common.hpp"
 #include "ip_endpoint_option.hpp"
 
 namespace silkworm::cmd::common {
@@ -86,6 +87,10 @@ void add_rpcdaemon_options(CLI::App& cli, silkworm::rpc::DaemonSettings& setting
         ->check(CLI::Range(1, 1024))
         ->capture_default_str();
 
+    add_option_cpu_set(cli, "--workers.cpus", settings.workers_cpu_set, "The CPUs running the worker threads");
+    add_option_affinity_mode(cli, "--workers.affinity", settings.workers_affinity_mode,
+                             "The placement of worker threads over their CPUs: shared, per_cpu or per_numa_node");
+
     cli.add_option("--api", settings.eth_api_spec)
         ->description("Execution Layer JSON RPC API namespaces as comma-separated list of strings")
         ->check(ApiSpecValidator())
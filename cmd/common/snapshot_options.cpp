@@ -23,6 +23,17 @@ void add_snapshot_options(CLI::App& cli, snapshot::SnapshotSettings& snapshot_se
                  "Flag indicating if usage of snapshots should be enabled or disable");
     cli.add_flag("--snapshots.no_downloader", snapshot_settings.no_downloader,
                  "If set, the snapshot downloader is disabled and just already present local snapshots are used");
+    cli.add_flag("--snapshots.freeze", snapshot_settings.freeze,
+                 "If set, blocks older than the freeze threshold are periodically moved from the database into snapshots");
+    cli.add_option("--snapshots.freeze_threshold", snapshot_settings.freeze_threshold,
+                   "The number of most recent blocks always kept in the database when freezing")
+        ->capture_default_str();
+    cli.add_flag("--snapshots.freeze_keep_blocks", snapshot_settings.freeze_keep_blocks,
+                 "If set, frozen blocks are also kept in the database, e.g. for a remote rpcdaemon reading them through KV");
+    cli.add_option("--snapshots.segment_size", snapshot_settings.segment_size,
+                   "The number of blocks in each snapshot segment produced by freezing (multiple of 1000)")
+        ->capture_default_str()
+        ->check(CLI::Range(snapshot::kMinimumSegmentSize, snapshot::kDefaultSegmentSize));
 
     // TODO(canepat) add options for the other snapshot settings and for all bittorrent settings
 }
@@ -14,6 +14,7 @@
    limitations under the License.
 */
 
+#include <algorithm>
 #include <chrono>
 #include <fstream>
 #include <stdexcept>
@@ -28,6 +29,7 @@
 #include <silkworm/core/chain/config.hpp>
 #include <silkworm/infra/common/log.hpp>
 #include <silkworm/node/bittorrent/client.hpp>
+#include <silkworm/node/db/access_layer.hpp>
 #include <silkworm/node/snapshot/index.hpp>
 #include <silkworm/node/snapshot/repository.hpp>
 #include <silkworm/node/snapshot/snapshot.hpp>
@@ -53,7 +55,8 @@ struct SnapSettings : public SnapshotSettings {
     std::vector<std::string> snapshot_file_names{kDefaultSnapshotFiles};
     int page_size{kDefaultPageSize};
     bool skip_system_txs{true};
-    std::string lookup_hash;
+    std::vector<std::string> lookup_hashes;
+    std::string chaindata{DataDirectory{}.chaindata().path().string()};
 };
 
 //! The settings for handling BitTorrent protocol customized for this tool
@@ -69,6 +72,7 @@ enum class SnapshotTool {
     decode_segment,
     download,
     lookup_header,
+    lookup_txn,
     sync
 };
 
@@ -109,6 +113,7 @@ void parse_command_line(int argc, char* argv[], CLI::App& app, SnapshotToolboxSe
         {"decode_segment", SnapshotTool::decode_segment},
         {"download", SnapshotTool::download},
         {"lookup_header", SnapshotTool::lookup_header},
+        {"lookup_txn", SnapshotTool::lookup_txn},
         {"sync", SnapshotTool::sync},
     };
     app.add_option("--tool", settings.tool, "The snapshot tool to use")
@@ -141,9 +146,11 @@ void parse_command_line(int argc, char* argv[], CLI::App& app, SnapshotToolboxSe
         ->check(CLI::Range(3, 20));
     app.add_flag("--seeding", bittorrent_settings.seeding, "Flag indicating if torrents should be seeded when download is finished")
         ->capture_default_str();
-    app.add_option("--hash", snapshot_settings.lookup_hash, "The hash to lookup in snapshot files")
+    app.add_option("--hash", snapshot_settings.lookup_hashes, "The hashes to lookup in snapshot files (repeatable)")
         ->capture_default_str()
         ->check(HashValidator{});
+    app.add_option("--chaindata", snapshot_settings.chaindata, "The path to the database used by lookup_txn")
+        ->capture_default_str();
 
     app.parse(argc, argv);
 }
@@ -272,31 +279,79 @@ void download(const BitTorrentSettings& settings) {
     SILK_INFO << "Download elapsed: " << duration_as<std::chrono::seconds>(elapsed) << " sec";
 }
 
+std::vector<Hash> parse_lookup_hashes(const SnapSettings& settings) {
+    std::vector<Hash> hashes;
+    hashes.reserve(settings.lookup_hashes.size());
+    for (const auto& lookup_hash : settings.lookup_hashes) {
+        hashes.push_back(*Hash::from_hex(lookup_hash));
+    }
+    return hashes;
+}
+
 void lookup_header(const SnapSettings& settings) {
-    const auto hash{Hash::from_hex(settings.lookup_hash)};
-    SILK_INFO << "Lookup header hash: " << hash->to_hex();
+    const auto hashes{parse_lookup_hashes(settings)};
+    SILK_INFO << "Lookup header hashes: " << hashes.size();
     std::chrono::time_point start{std::chrono::steady_clock::now()};
 
-    const HeaderSnapshot* matching_snapshot{nullptr};
+    std::vector<const HeaderSnapshot*> matching_snapshots(hashes.size(), nullptr);
     SnapshotRepository snapshot_repository{settings};
     snapshot_repository.reopen_folder();
     snapshot_repository.view_header_segments([&](const HeaderSnapshot* snapshot) -> bool {
-        const auto header{snapshot->header_by_hash(*hash)};
-        if (header) {
-            matching_snapshot = snapshot;
+        // Lookup all the hashes still not found in one batch per snapshot
+        std::vector<std::size_t> missing_indexes;
+        std::vector<Hash> missing_hashes;
+        for (std::size_t i{0}; i < hashes.size(); ++i) {
+            if (!matching_snapshots[i]) {
+                missing_indexes.push_back(i);
+                missing_hashes.push_back(hashes[i]);
+            }
         }
-        return header.has_value();
+        const auto headers{snapshot->headers_by_hash(missing_hashes)};
+        for (std::size_t i{0}; i < headers.size(); ++i) {
+            if (headers[i]) {
+                matching_snapshots[missing_indexes[i]] = snapshot;
+            }
+        }
+        return std::all_of(matching_snapshots.cbegin(), matching_snapshots.cend(), [](const auto* s) { return s != nullptr; });
     });
-    if (matching_snapshot) {
-        SILK_INFO << "Lookup header hash: " << hash->to_hex() << " found in: " << matching_snapshot->path().filename();
-    } else {
-        SILK_INFO << "Lookup header hash: " << hash->to_hex() << " NOT found";
+    for (std::size_t i{0}; i < hashes.size(); ++i) {
+        if (matching_snapshots[i]) {
+            SILK_INFO << "Lookup header hash: " << hashes[i].to_hex() << " found in: " << matching_snapshots[i]->path().filename();
+        } else {
+            SILK_INFO << "Lookup header hash: " << hashes[i].to_hex() << " NOT found";
+        }
     }
 
     std::chrono::duration elapsed{std::chrono::steady_clock::now() - start};
     SILK_INFO << "Lookup header elapsed: " << duration_as<std::chrono::milliseconds>(elapsed) << " msec";
 }
 
+void lookup_txn(const SnapSettings& settings) {
+    const auto hashes{parse_lookup_hashes(settings)};
+    SILK_INFO << "Lookup txn hashes: " << hashes.size();
+    std::chrono::time_point start{std::chrono::steady_clock::now()};
+
+    SnapshotRepository snapshot_repository{settings};
+    snapshot_repository.reopen_folder();
+    db::DataModel::set_snapshot_repository(&snapshot_repository);
+
+    // Transactions are looked up in db first, then in snapshots like the node does
+    auto env{db::open_env(db::EnvConfig{.path = settings.chaindata, .readonly = true})};
+    db::ROTxn txn{env};
+    db::DataModel data_model{txn};
+    const auto transactions{data_model.read_transactions(hashes)};
+    for (std::size_t i{0}; i < hashes.size(); ++i) {
+        if (transactions[i]) {
+            SILK_INFO << "Lookup txn hash: " << hashes[i].to_hex() << " found, nonce: " << transactions[i]->nonce;
+        } else {
+            SILK_INFO << "Lookup txn hash: " << hashes[i].to_hex() << " NOT found";
+        }
+    }
+
+    std::chrono::duration elapsed{std::chrono::steady_clock::now() - start};
+    SILK_INFO << "Lookup txn elapsed: " << duration_as<std::chrono::milliseconds>(elapsed) << " msec";
+}
+
 void sync(const SnapSettings& snapshot_settings) {
     std::chrono::time_point start{std::chrono::steady_clock::now()};
 
@@ -338,6 +393,8 @@ int main(int argc, char* argv[]) {
             download(settings.download_settings);
         } else if (settings.tool == SnapshotTool::lookup_header) {
             lookup_header(settings.snapshot_settings);
+        } else if (settings.tool == SnapshotTool::lookup_txn) {
+            lookup_txn(settings.snapshot_settings);
         } else if (settings.tool == SnapshotTool::sync) {
             sync(settings.snapshot_settings);
         } else {
@@ -22,6 +22,7 @@
 #include <regex>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <list>
 
 #include <CLI/CLI.hpp>
@@ -48,6 +49,7 @@
 #include <silkworm/node/db/mdbx.hpp>
 #include <silkworm/node/db/prune_mode.hpp>
 #include <silkworm/node/db/stages.hpp>
+#include <silkworm/node/db/state_snapshot.hpp>
 #include <silkworm/node/stagedsync/stages/stage_interhashes/trie_cursor.hpp>
 
 #include "jsonfile/types.hpp"
@@ -1529,6 +1531,49 @@ void do_dump_state(db::EnvConfig& config, const std::string& evm_state_file_name
     outfile.close();
 }
 
+void do_export_state(db::EnvConfig& config, const std::string& file_name, uint32_t threads) {
+    auto env{silkworm::db::open_env(config)};
+
+    // The header txn stays open during export: all export txns are required to see its same snapshot
+    db::state_snapshot::Header header;
+    db::ROTxn txn{env};
+    header.block_number = db::stages::read_stage_progress(txn, db::stages::kExecutionKey);
+    const auto header_hash{db::read_canonical_header_hash(txn, header.block_number)};
+    if (!header_hash) {
+        throw std::runtime_error("Missing canonical header for block " + std::to_string(header.block_number));
+    }
+    const auto block_header{db::read_header(txn, header.block_number, header_hash->bytes)};
+    if (!block_header) {
+        throw std::runtime_error("Missing header for block " + std::to_string(header.block_number));
+    }
+    header.state_root = block_header->state_root;
+
+    StopWatch sw(/*auto_start=*/true);
+    db::state_snapshot::export_state(env, file_name, header, txn.id(), threads);
+    log::Info("Export state", {"block", std::to_string(header.block_number),
+                               "state root", to_hex(header.state_root, true),
+                               "in", StopWatch::format(sw.lap().second)});
+}
+
+void do_import_state(db::EnvConfig& config, const DataDirectory& data_dir, const std::string& file_name, bool dry) {
+    if (!config.exclusive) {
+        throw std::runtime_error("Function requires exclusive access to database");
+    }
+
+    auto env{silkworm::db::open_env(config)};
+    db::RWTxn txn(env);
+
+    StopWatch sw(/*auto_start=*/true);
+    const auto header{db::state_snapshot::import_state(txn, file_name, data_dir.etl().path())};
+    if (!dry) {
+        txn.commit();
+    }
+    // Stage progresses are left untouched: headers and bodies up to the snapshot block are still required
+    log::Info("Import state", {"block", std::to_string(header.block_number),
+                               "state root", to_hex(header.state_root, true),
+                               "in", StopWatch::format(sw.lap().second)});
+}
+
 void do_reset_to_download(db::EnvConfig& config, bool keep_senders) {
     if (!config.exclusive) {
         throw std::runtime_error("Function requires exclusive access to database");
@@ -1854,6 +1899,18 @@ int main(int argc, char* argv[]) {
 
     auto cmd_dump_state_out_file_opt = cmd_dump_state->add_option("--out-file", "Output file")->default_val("silkworm-evm-state.json");
 
+    // Binary state snapshot
+    auto cmd_export_state =
+        app_main.add_subcommand("export-state", "Export plain state into a binary chunked snapshot");
+    auto cmd_export_state_file_opt = cmd_export_state->add_option("--file", "Output file")->default_val("silkworm-state.snapshot");
+    auto cmd_export_state_threads_opt = cmd_export_state->add_option("--threads", "Number of export threads")
+                                            ->default_val(std::max(1u, std::thread::hardware_concurrency()))
+                                            ->check(CLI::Range(1u, 1024u));
+
+    auto cmd_import_state =
+        app_main.add_subcommand("import-state", "Bulk-load plain and hashed state from a binary snapshot");
+    auto cmd_import_state_file_opt = cmd_import_state->add_option("--file", "Input file")->required()->check(CLI::ExistingFile);
+
     /*
      * Parse arguments and validate
      */
@@ -1950,6 +2007,12 @@ int main(int argc, char* argv[]) {
             do_reset_to_download(src_config, static_cast<bool>(*cmd_reset_to_download_keep_senders_opt));
         } else if (*cmd_dump_state) {
             do_dump_state(src_config, cmd_dump_state_out_file_opt->as<std::string>());
+        } else if (*cmd_export_state) {
+            do_export_state(src_config, cmd_export_state_file_opt->as<std::string>(),
+                            cmd_export_state_threads_opt->as<uint32_t>());
+        } else if (*cmd_import_state) {
+            do_import_state(src_config, data_dir, cmd_import_state_file_opt->as<std::string>(),
+                            static_cast<bool>(*app_dry_opt));
         }
 
         return 0;
@@ -345,7 +345,10 @@ int main(int argc, char* argv[]) {
             .private_api_addr = settings.rpcdaemon_settings.private_api_addr,
             .log_verbosity = settings.log_settings.log_verbosity,
             .wait_mode = settings.rpcdaemon_settings.context_pool_settings.wait_mode,
+            .workers_cpu_set = settings.rpcdaemon_settings.workers_cpu_set,
             .jwt_secret_file = settings.rpcdaemon_settings.jwt_secret_file.value(),
+            .snapshot_repository = settings.node_settings.snapshot_repository,
+            .task_scheduler = settings.node_settings.task_scheduler,
         };
         chainsync::Sync chain_sync_process{
             context_pool.next_io_context(),
@@ -0,0 +1,901 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "bn254.hpp"
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#if defined(__BMI2__) && defined(__ADX__)
+#include <immintrin.h>
+#endif
+
+namespace silkworm::bn254 {
+
+namespace {
+
+    using Limbs = std::array<uint64_t, 4>;  // little-endian
+
+    // Wide arithmetic primitives
+
+#if defined(__BMI2__) && defined(__ADX__)
+
+    //! t + a * b + carry: returns the low word and sets carry to the high one
+    inline uint64_t mac(uint64_t t, uint64_t a, uint64_t b, uint64_t& carry) noexcept {
+        unsigned long long hi;
+        unsigned long long lo{_mulx_u64(a, b, &hi)};
+        unsigned char c{_addcarryx_u64(0, lo, t, &lo)};
+        hi += c;
+        c = _addcarryx_u64(0, lo, carry, &lo);
+        carry = hi + c;
+        return lo;
+    }
+
+    inline uint64_t add_carry(uint64_t a, uint64_t b, uint64_t& carry) noexcept {
+        unsigned long long sum;
+        carry = _addcarryx_u64(static_cast<unsigned char>(carry), a, b, &sum);
+        return sum;
+    }
+
+    inline uint64_t sub_borrow(uint64_t a, uint64_t b, uint64_t& borrow) noexcept {
+        unsigned long long difference;
+        borrow = _subborrow_u64(static_cast<unsigned char>(borrow), a, b, &difference);
+        return difference;
+    }
+
+#elif defined(__SIZEOF_INT128__)
+
+    __extension__ using uint128 = unsigned __int128;
+
+    inline uint64_t mac(uint64_t t, uint64_t a, uint64_t b, uint64_t& carry) noexcept {
+        const uint128 r{static_cast<uint128>(a) * b + t + carry};
+        carry = static_cast<uint64_t>(r >> 64);
+        return static_cast<uint64_t>(r);
+    }
+
+    inline uint64_t add_carry(uint64_t a, uint64_t b, uint64_t& carry) noexcept {
+        const uint128 r{static_cast<uint128>(a) + b + carry};
+        carry = static_cast<uint64_t>(r >> 64);
+        return static_cast<uint64_t>(r);
+    }
+
+    inline uint64_t sub_borrow(uint64_t a, uint64_t b, uint64_t& borrow) noexcept {
+        const uint128 r{static_cast<uint128>(a) - b - borrow};
+        borrow = static_cast<uint64_t>(r >> 64) & 1;
+        return static_cast<uint64_t>(r);
+    }
+
+#else
+
+    inline uint64_t add_carry(uint64_t a, uint64_t b, uint64_t& carry) noexcept {
+        const uint64_t sum{a + b};
+        const uint64_t result{sum + carry};
+        carry = static_cast<uint64_t>(sum < a) | static_cast<uint64_t>(result < sum);
+        return result;
+    }
+
+    inline uint64_t sub_borrow(uint64_t a, uint64_t b, uint64_t& borrow) noexcept {
+        const uint64_t difference{a - b};
+        const uint64_t result{difference - borrow};
+        borrow = static_cast<uint64_t>(a < b) | static_cast<uint64_t>(difference < borrow);
+        return result;
+    }
+
+    inline uint64_t mac(uint64_t t, uint64_t a, uint64_t b, uint64_t& carry) noexcept {
+        const uint64_t a_lo{a & 0xffffffff}, a_hi{a >> 32};
+        const uint64_t b_lo{b & 0xffffffff}, b_hi{b >> 32};
+        const uint64_t lo_lo{a_lo * b_lo}, hi_lo{a_hi * b_lo}, lo_hi{a_lo * b_hi}, hi_hi{a_hi * b_hi};
+        const uint64_t cross{(lo_lo >> 32) + (hi_lo & 0xffffffff) + lo_hi};
+        uint64_t hi{(hi_lo >> 32) + (cross >> 32) + hi_hi};
+        uint64_t lo{(cross << 32) | (lo_lo & 0xffffffff)};
+        uint64_t c{0};
+        lo = add_carry(lo, t, c);
+        hi += c;
+        c = 0;
+        lo = add_carry(lo, carry, c);
+        carry = hi + c;
+        return lo;
+    }
+
+#endif
+
+    // Base field Fp, p = 21888242871839275222246405745257275088696311157297823662689037894645226208583
+
+    constexpr Limbs kModulus{0x3c208c16d87cfd47, 0x97816a916871ca8d, 0xb85045b68181585d, 0x30644e72e131a029};
+    constexpr uint64_t kMontgomeryInv{0x87d20782e4866389};  // -p^-1 mod 2^64
+    constexpr Limbs kR{0xd35d438dc58f0d9d, 0x0a78eb28f5c70b3d, 0x666ea36f7879462c, 0x0e0a77c19a07df2f};
+    constexpr Limbs kR2{0xf32cfc5b538afa89, 0xb5e71911d44501fb, 0x47ab1eff0a417ff6, 0x06d89f71cab8351f};
+    constexpr Limbs kR3{0xb1cd6dafda1530df, 0x62f210e6a7283db6, 0xef7f0b0c0ada0afb, 0x20fd6e902d592544};
+
+    // The BN parameter u and the NAF of 6u + 2 (least significant digit first), i.e. the optimal ate loop count
+    constexpr uint64_t kU{4965661367192848881};
+    constexpr Limbs kSixUSquared{0xf83e9682e87cfd46, 0x6f4d8248eeb859fb, 0, 0};  // for the G2 subgroup check
+    constexpr std::array<int8_t, 66> kAteLoopNaf{
+        0, 0, 0, 1, 0, 1, 0, -1, 0, 0, -1, 0, 0, 0, 1, 0, 0, -1, 0, -1, 0, 0, 0, 1, 0, -1, 0, 0, 0, 0, -1, 0, 0,
+        1, 0, -1, 0, 0, 1, 0, 0, 0, 0, 0, -1, 0, 0, -1, 0, 1, 0, -1, 0, 0, 0, -1, 0, -1, 0, 0, 0, 1, 0, -1, 0, 1};
+
+    inline bool less_than(const Limbs& a, const Limbs& b) noexcept {
+        for (std::size_t i{4}; i-- > 0;) {
+            if (a[i] != b[i]) {
+                return a[i] < b[i];
+            }
+        }
+        return false;
+    }
+
+    //! a -= b, returns the borrow
+    inline uint64_t sub_in_place(Limbs& a, const Limbs& b) noexcept {
+        uint64_t borrow{0};
+        for (std::size_t i{0}; i < 4; ++i) {
+            a[i] = sub_borrow(a[i], b[i], borrow);
+        }
+        return borrow;
+    }
+
+    //! a += b, returns the carry
+    inline uint64_t add_in_place(Limbs& a, const Limbs& b) noexcept {
+        uint64_t carry{0};
+        for (std::size_t i{0}; i < 4; ++i) {
+            a[i] = add_carry(a[i], b[i], carry);
+        }
+        return carry;
+    }
+
+    inline void shift_right_1(Limbs& a, uint64_t top_bit) noexcept {
+        for (std::size_t i{0}; i < 3; ++i) {
+            a[i] = (a[i] >> 1) | (a[i + 1] << 63);
+        }
+        a[3] = (a[3] >> 1) | (top_bit << 63);
+    }
+
+    struct Fp {
+        Limbs v{};  // Montgomery form
+
+        static constexpr Fp zero() noexcept { return {}; }
+        static constexpr Fp one() noexcept { return {kR}; }
+
+        [[nodiscard]] bool is_zero() const noexcept { return (v[0] | v[1] | v[2] | v[3]) == 0; }
+
+        friend bool operator==(const Fp&, const Fp&) = default;
+    };
+
+    //! a0..a3 - p if not negative, a0..a3 otherwise; the hot paths below are unrolled by hand to keep limbs in registers
+    inline Fp reduce_once(uint64_t a0, uint64_t a1, uint64_t a2, uint64_t a3) noexcept {
+        uint64_t borrow{0};
+        const uint64_t r0{sub_borrow(a0, kModulus[0], borrow)};
+        const uint64_t r1{sub_borrow(a1, kModulus[1], borrow)};
+        const uint64_t r2{sub_borrow(a2, kModulus[2], borrow)};
+        const uint64_t r3{sub_borrow(a3, kModulus[3], borrow)};
+        const uint64_t keep{0 - borrow};  // all ones if a < p
+        return {{(a0 & keep) | (r0 & ~keep), (a1 & keep) | (r1 & ~keep), (a2 & keep) | (r2 & ~keep),
+                 (a3 & keep) | (r3 & ~keep)}};
+    }
+
+    inline Fp operator+(const Fp& a, const Fp& b) noexcept {
+        uint64_t carry{0};  // p < 2^254, no carry out
+        const uint64_t s0{add_carry(a.v[0], b.v[0], carry)};
+        const uint64_t s1{add_carry(a.v[1], b.v[1], carry)};
+        const uint64_t s2{add_carry(a.v[2], b.v[2], carry)};
+        const uint64_t s3{add_carry(a.v[3], b.v[3], carry)};
+        return reduce_once(s0, s1, s2, s3);
+    }
+
+    inline Fp operator-(const Fp& a, const Fp& b) noexcept {
+        uint64_t borrow{0};
+        const uint64_t d0{sub_borrow(a.v[0], b.v[0], borrow)};
+        const uint64_t d1{sub_borrow(a.v[1], b.v[1], borrow)};
+        const uint64_t d2{sub_borrow(a.v[2], b.v[2], borrow)};
+        const uint64_t d3{sub_borrow(a.v[3], b.v[3], borrow)};
+        const uint64_t mask{0 - borrow};  // add p back if negative
+        uint64_t carry{0};
+        const uint64_t r0{add_carry(d0, kModulus[0] & mask, carry)};
+        const uint64_t r1{add_carry(d1, kModulus[1] & mask, carry)};
+        const uint64_t r2{add_carry(d2, kModulus[2] & mask, carry)};
+        const uint64_t r3{add_carry(d3, kModulus[3] & mask, carry)};
+        return {{r0, r1, r2, r3}};
+    }
+
+    inline Fp operator-(const Fp& a) noexcept { return Fp::zero() - a; }
+
+    //! One CIOS round: t = (t + a * b + m * p) / 2^64 with m chosen so that the division is exact
+    inline void montgomery_round(uint64_t& t0, uint64_t& t1, uint64_t& t2, uint64_t& t3, const Limbs& a,
+                                 uint64_t b) noexcept {
+        uint64_t a_carry{0};
+        const uint64_t u0{mac(t0, a[0], b, a_carry)};
+        const uint64_t m{u0 * kMontgomeryInv};
+        uint64_t m_carry{0};
+        mac(u0, m, kModulus[0], m_carry);
+        const uint64_t u1{mac(t1, a[1], b, a_carry)};
+        t0 = mac(u1, m, kModulus[1], m_carry);
+        const uint64_t u2{mac(t2, a[2], b, a_carry)};
+        t1 = mac(u2, m, kModulus[2], m_carry);
+        const uint64_t u3{mac(t3, a[3], b, a_carry)};
+        t2 = mac(u3, m, kModulus[3], m_carry);
+        t3 = m_carry + a_carry;
+    }
+
+    //! Montgomery multiplication (CIOS), skipping the extra carry word because the top limb of p is below 2^63 - 1
+    inline Fp operator*(const Fp& a, const Fp& b) noexcept {
+        uint64_t t0{0}, t1{0}, t2{0}, t3{0};
+        montgomery_round(t0, t1, t2, t3, a.v, b.v[0]);
+        montgomery_round(t0, t1, t2, t3, a.v, b.v[1]);
+        montgomery_round(t0, t1, t2, t3, a.v, b.v[2]);
+        montgomery_round(t0, t1, t2, t3, a.v, b.v[3]);
+        return reduce_once(t0, t1, t2, t3);
+    }
+
+    inline Fp square(const Fp& a) noexcept { return a * a; }
+    inline Fp twice(const Fp& a) noexcept { return a + a; }
+
+    //! Binary extended Euclidean algorithm on the Montgomery representation aR, giving (aR)^-1, then scaled by R^3
+    Fp inverse(const Fp& a) noexcept {
+        if (a.is_zero()) {
+            return a;
+        }
+        constexpr Limbs kOne{1, 0, 0, 0};
+        Limbs u{a.v}, v{kModulus}, x1{kOne}, x2{};
+        const auto halve{[](Limbs& x) {
+            const uint64_t carry{(x[0] & 1) ? add_in_place(x, kModulus) : 0};
+            shift_right_1(x, carry);
+        }};
+        while (u != kOne && v != kOne) {
+            while ((u[0] & 1) == 0) {
+                shift_right_1(u, 0);
+                halve(x1);
+            }
+            while ((v[0] & 1) == 0) {
+                shift_right_1(v, 0);
+                halve(x2);
+            }
+            if (!less_than(u, v)) {
+                sub_in_place(u, v);
+                if (sub_in_place(x1, x2)) add_in_place(x1, kModulus);
+            } else {
+                sub_in_place(v, u);
+                if (sub_in_place(x2, x1)) add_in_place(x2, kModulus);
+            }
+        }
+        return Fp{u == kOne ? x1 : x2} * Fp{kR3};
+    }
+
+    //! Reads a big-endian 32-byte number, std::nullopt if not less than p
+    std::optional<Fp> read_fp(const uint8_t* bytes_be) noexcept {
+        Limbs x{};
+        for (std::size_t i{0}; i < 32; ++i) {
+            x[3 - i / 8] = (x[3 - i / 8] << 8) | bytes_be[i];
+        }
+        if (!less_than(x, kModulus)) {
+            return std::nullopt;
+        }
+        return Fp{x} * Fp{kR2};
+    }
+
+    void write_fp(uint8_t* bytes_be, const Fp& a) noexcept {
+        const Fp x{a * Fp{{1, 0, 0, 0}}};  // out of Montgomery form
+        for (std::size_t i{0}; i < 32; ++i) {
+            bytes_be[31 - i] = static_cast<uint8_t>(x.v[i / 8] >> (8 * (i % 8)));
+        }
+    }
+
+    Limbs read_scalar(const uint8_t* bytes_be) noexcept {
+        Limbs x{};
+        for (std::size_t i{0}; i < 32; ++i) {
+            x[3 - i / 8] = (x[3 - i / 8] << 8) | bytes_be[i];
+        }
+        return x;
+    }
+
+    // Quadratic extension Fp2 = Fp[i] / (i^2 + 1)
+
+    struct Fp2 {
+        Fp c0, c1;
+
+        static constexpr Fp2 zero() noexcept { return {}; }
+        static constexpr Fp2 one() noexcept { return {Fp::one(), Fp::zero()}; }
+
+        [[nodiscard]] bool is_zero() const noexcept { return c0.is_zero() && c1.is_zero(); }
+
+        friend bool operator==(const Fp2&, const Fp2&) = default;
+    };
+
+    inline Fp2 operator+(const Fp2& a, const Fp2& b) noexcept { return {a.c0 + b.c0, a.c1 + b.c1}; }
+    inline Fp2 operator-(const Fp2& a, const Fp2& b) noexcept { return {a.c0 - b.c0, a.c1 - b.c1}; }
+    inline Fp2 operator-(const Fp2& a) noexcept { return {-a.c0, -a.c1}; }
+    inline Fp2 twice(const Fp2& a) noexcept { return a + a; }
+
+    inline Fp2 operator*(const Fp2& a, const Fp2& b) noexcept {
+        const Fp a0b0{a.c0 * b.c0};
+        const Fp a1b1{a.c1 * b.c1};
+        return {a0b0 - a1b1, (a.c0 + a.c1) * (b.c0 + b.c1) - a0b0 - a1b1};
+    }
+
+    inline Fp2 operator*(const Fp2& a, const Fp& b) noexcept { return {a.c0 * b, a.c1 * b}; }
+
+    inline Fp2 square(const Fp2& a) noexcept {
+        const Fp a0a1{a.c0 * a.c1};
+        return {(a.c0 + a.c1) * (a.c0 - a.c1), twice(a0a1)};
+    }
+
+    inline Fp2 conjugate(const Fp2& a) noexcept { return {a.c0, -a.c1}; }
+
+    //! Multiplication by the non-residue xi = 9 + i defining Fp6
+    inline Fp2 mul_by_xi(const Fp2& a) noexcept {
+        const Fp2 a8{twice(twice(twice(a)))};
+        const Fp2 a9{a8 + a};
+        return {a9.c0 - a.c1, a9.c1 + a.c0};
+    }
+
+    Fp2 inverse(const Fp2& a) noexcept {
+        const Fp t{inverse(square(a.c0) + square(a.c1))};
+        return {a.c0 * t, -(a.c1 * t)};
+    }
+
+    // Sextic extension Fp6 = Fp2[v] / (v^3 - xi)
+
+    struct Fp6 {
+        Fp2 c0, c1, c2;
+
+        static constexpr Fp6 zero() noexcept { return {}; }
+        static constexpr Fp6 one() noexcept { return {Fp2::one(), Fp2::zero(), Fp2::zero()}; }
+
+        friend bool operator==(const Fp6&, const Fp6&) = default;
+    };
+
+    inline Fp6 operator+(const Fp6& a, const Fp6& b) noexcept { return {a.c0 + b.c0, a.c1 + b.c1, a.c2 + b.c2}; }
+    inline Fp6 operator-(const Fp6& a, const Fp6& b) noexcept { return {a.c0 - b.c0, a.c1 - b.c1, a.c2 - b.c2}; }
+    inline Fp6 operator-(const Fp6& a) noexcept { return {-a.c0, -a.c1, -a.c2}; }
+
+    Fp6 operator*(const Fp6& a, const Fp6& b) noexcept {
+        const Fp2 t0{a.c0 * b.c0};
+        const Fp2 t1{a.c1 * b.c1};
+        const Fp2 t2{a.c2 * b.c2};
+        return {
+            t0 + mul_by_xi((a.c1 + a.c2) * (b.c1 + b.c2) - t1 - t2),
+            (a.c0 + a.c1) * (b.c0 + b.c1) - t0 - t1 + mul_by_xi(t2),
+            (a.c0 + a.c2) * (b.c0 + b.c2) - t0 - t2 + t1,
+        };
+    }
+
+    //! Chung-Hasan SQR2
+    Fp6 square(const Fp6& a) noexcept {
+        const Fp2 s0{square(a.c0)};
+        const Fp2 s1{twice(a.c0 * a.c1)};
+        const Fp2 s2{square(a.c0 - a.c1 + a.c2)};
+        const Fp2 s3{twice(a.c1 * a.c2)};
+        const Fp2 s4{square(a.c2)};
+        return {s0 + mul_by_xi(s3), s1 + mul_by_xi(s4), s1 + s2 + s3 - s0 - s4};
+    }
+
+    //! Multiplication by v
+    inline Fp6 mul_by_v(const Fp6& a) noexcept { return {mul_by_xi(a.c2), a.c0, a.c1}; }
+
+    //! Multiplication by b0 + b1 * v
+    Fp6 mul_by_01(const Fp6& a, const Fp2& b0, const Fp2& b1) noexcept {
+        const Fp2 t0{a.c0 * b0};
+        const Fp2 t1{a.c1 * b1};
+        return {
+            mul_by_xi((a.c1 + a.c2) * b1 - t1) + t0,
+            (b0 + b1) * (a.c0 + a.c1) - t0 - t1,
+            (a.c0 + a.c2) * b0 - t0 + t1,
+        };
+    }
+
+    Fp6 inverse(const Fp6& a) noexcept {
+        const Fp2 c0{square(a.c0) - mul_by_xi(a.c1 * a.c2)};
+        const Fp2 c1{mul_by_xi(square(a.c2)) - a.c0 * a.c1};
+        const Fp2 c2{square(a.c1) - a.c0 * a.c2};
+        const Fp2 t{inverse(a.c0 * c0 + mul_by_xi(a.c2 * c1 + a.c1 * c2))};
+        return {c0 * t, c1 * t, c2 * t};
+    }
+
+    // Dodecic extension Fp12 = Fp6[w] / (w^2 - v)
+
+    struct Fp12 {
+        Fp6 c0, c1;
+
+        static constexpr Fp12 one() noexcept { return {Fp6::one(), Fp6::zero()}; }
+
+        friend bool operator==(const Fp12&, const Fp12&) = default;
+    };
+
+    Fp12 operator*(const Fp12& a, const Fp12& b) noexcept {
+        const Fp6 t0{a.c0 * b.c0};
+        const Fp6 t1{a.c1 * b.c1};
+        return {t0 + mul_by_v(t1), (a.c0 + a.c1) * (b.c0 + b.c1) - t0 - t1};
+    }
+
+    Fp12 square(const Fp12& a) noexcept {
+        const Fp6 t{a.c0 * a.c1};
+        return {(a.c0 + a.c1) * (a.c0 + mul_by_v(a.c1)) - t - mul_by_v(t), t + t};
+    }
+
+    //! The p^6 Frobenius map, which is also the inverse for elements of the cyclotomic subgroup
+    inline Fp12 conjugate(const Fp12& a) noexcept { return {a.c0, -a.c1}; }
+
+    Fp12 inverse(const Fp12& a) noexcept {
+        const Fp6 t{inverse(square(a.c0) - mul_by_v(square(a.c1)))};
+        return {a.c0 * t, -(a.c1 * t)};
+    }
+
+    //! Multiplication by the sparse c0 + c3 * w + c4 * v * w, the shape of line functions for the D-type twist
+    Fp12 mul_by_034(const Fp12& f, const Fp2& c0, const Fp2& c3, const Fp2& c4) noexcept {
+        const Fp6 a{f.c0.c0 * c0, f.c0.c1 * c0, f.c0.c2 * c0};
+        const Fp6 b{mul_by_01(f.c1, c3, c4)};
+        const Fp6 e{mul_by_01(f.c0 + f.c1, c0 + c3, c4)};
+        return {mul_by_v(b) + a, e - a - b};
+    }
+
+    //! Granger-Scott squaring, valid only in the cyclotomic subgroup (i.e. after the easy part of the exponentiation)
+    Fp12 cyclotomic_square(const Fp12& a) noexcept {
+        const Fp2& r0{a.c0.c0};
+        const Fp2& r4{a.c0.c1};
+        const Fp2& r3{a.c0.c2};
+        const Fp2& r2{a.c1.c0};
+        const Fp2& r1{a.c1.c1};
+        const Fp2& r5{a.c1.c2};
+
+        const auto square_fp4{[](const Fp2& x, const Fp2& y, Fp2& t0, Fp2& t1) {
+            const Fp2 xy{x * y};
+            t0 = (x + y) * (mul_by_xi(y) + x) - xy - mul_by_xi(xy);
+            t1 = twice(xy);
+        }};
+        Fp2 t0, t1, t2, t3, t4, t5;
+        square_fp4(r0, r1, t0, t1);
+        square_fp4(r2, r3, t2, t3);
+        square_fp4(r4, r5, t4, t5);
+
+        const Fp2 xi_t5{mul_by_xi(t5)};
+        Fp12 z;
+        z.c0.c0 = twice(t0 - r0) + t0;
+        z.c1.c1 = twice(t1 + r1) + t1;
+        z.c1.c0 = twice(xi_t5 + r2) + xi_t5;
+        z.c0.c2 = twice(t4 - r3) + t4;
+        z.c0.c1 = twice(t2 - r4) + t2;
+        z.c1.c2 = twice(t3 + r5) + t3;
+        return z;
+    }
+
+    // Frobenius coefficients gamma[k][e - 1] = xi^(e * (p^k - 1) / 6) for the coefficient of w^e
+    constexpr Fp2 kFrobeniusGamma[3][5]{
+        {
+            {{{0xaf9ba69633144907, 0xca6b1d7387afb78a, 0x11bded5ef08a2087, 0x02f34d751a1f3a7c}},
+             {{0xa222ae234c492d72, 0xd00f02a4565de15b, 0xdc2ff3a253dfc926, 0x10a75716b3899551}}},
+            {{{0xb5773b104563ab30, 0x347f91c8a9aa6454, 0x7a007127242e0991, 0x1956bcd8118214ec}},
+             {{0x6e849f1ea0aa4757, 0xaa1c7b6d89f89141, 0xb6e713cdfae0ca3a, 0x26694fbb4e82ebc3}}},
+            {{{0xe4bbdd0c2936b629, 0xbb30f162e133bacb, 0x31a9d1b6f9645366, 0x253570bea500f8dd}},
+             {{0xa1d77ce45ffe77c7, 0x07affd117826d1db, 0x6d16bd27bb7edc6b, 0x2c87200285defecc}}},
+            {{{0x7361d77f843abe92, 0xa5bb2bd3273411fb, 0x9c941f314b3e2399, 0x15df9cddbb9fd3ec}},
+             {{0x5dddfd154bd8c949, 0x62cb29a5a4445b60, 0x37bc870a0c7dd2b9, 0x24830a9d3171f0fd}}},
+            {{{0xc970692f41690fe7, 0xe240342127694b0b, 0x32bee66b83c459e8, 0x12aabced0ab08841}},
+             {{0x0d485d2340aebfa9, 0x05193418ab2fcc57, 0xd3b0a40b8a4910f5, 0x2f21ebb535d2925a}}},
+        },
+        {
+            {{{0xca8d800500fa1bf2, 0xf0c5d61468b39769, 0x0e201271ad0d4418, 0x04290f65bad856e6}}, {}},
+            {{{0x3350c88e13e80b9c, 0x7dce557cdb5e56b9, 0x6001b4b8b615564a, 0x2682e617020217e0}}, {}},
+            {{{0x68c3488912edefaa, 0x8d087f6872aabf4f, 0x51e1a24709081231, 0x2259d6b14729c0fa}}, {}},
+            {{{0x71930c11d782e155, 0xa6bb947cffbe3323, 0xaa303344d4741444, 0x2c3b3f0d26594943}}, {}},
+            {{{0x08cfc388c494f1ab, 0x19b315148d1373d4, 0x584e90fdcb6c0213, 0x09e1685bdf2f8849}}, {}},
+        },
+        {
+            {{{0x365316184e46d97d, 0x0af7129ed4c96d9f, 0x659da72fca1009b5, 0x08116d8983a20d23}},
+             {{0xb1df4af7c39c1939, 0x3d9f02878a73bf7f, 0x9b2220928caf0ae0, 0x26684515eff054a6}}},
+            {{{0xc9af22f716ad6bad, 0xb311782a4aa662b2, 0x19eeaf64e248c7f4, 0x20273e77e3439f82}},
+             {{0xacc02860f7ce93ac, 0x3933d5817ba76b4c, 0x69e6188b446c8467, 0x0a46036d4417cc55}}},
+            {{{0x5764af0aaf46471e, 0xdc50792e873e0fc1, 0x86a673ff881d04f6, 0x0b2eddb43c30a74c}},
+             {{0x9a490f32787e8580, 0x8fd16d7ff04af8b1, 0x4b39888ec6027bf2, 0x03dd2e705b52a15d}}},
+            {{{0x448a93a57b6762df, 0xbfd62df528fdeadf, 0xd858f5d00e9bd47a, 0x06b03d4d3476ec58}},
+             {{0x2b19daf4bcc936d1, 0xa1a54e7a56f4299f, 0xb533eee05adeaef1, 0x170c812b84dda0b2}}},
+            {{{0xe0bc4b2275cf559f, 0xc238b945c154e60f, 0x803982a5929a7d5e, 0x15ce052df7e4a37e}},
+             {{0x2d28efbdbf3799a7, 0x9b097e3c1ad60773, 0x982d4113af4a535b, 0x24e18991e3056063}}},
+        },
+    };
+
+    //! The p^k Frobenius map for k in {1, 2, 3}
+    Fp12 frobenius(const Fp12& a, std::size_t k) noexcept {
+        const auto& gamma{kFrobeniusGamma[k - 1]};
+        const auto frobenius_fp2{[k](const Fp2& x) { return k % 2 == 1 ? conjugate(x) : x; }};
+        return {
+            {
+                frobenius_fp2(a.c0.c0),
+                frobenius_fp2(a.c0.c1) * gamma[1],
+                frobenius_fp2(a.c0.c2) * gamma[3],
+            },
+            {
+                frobenius_fp2(a.c1.c0) * gamma[0],
+                frobenius_fp2(a.c1.c1) * gamma[2],
+                frobenius_fp2(a.c1.c2) * gamma[4],
+            },
+        };
+    }
+
+    // Curves: G1 is y^2 = x^3 + 3 over Fp, G2 is the D-type twist y^2 = x^3 + 3 / xi over Fp2
+
+    constexpr Fp kB{{0x7a17caa950ad28d7, 0x1f6ac17ae15521b9, 0x334bea4e696bd284, 0x2a1f6744ce179d8e}};
+    constexpr Fp2 kTwistB{
+        {{0x3bf938e377b802a8, 0x020b1b273633535d, 0x26b7edf049755260, 0x2514c6324384a86d}},
+        {{0x38e7ecccd1dcff67, 0x65f0b37d93ce0d3e, 0xd749d0dd22ac00aa, 0x0141b9ce4a688d4d}},
+    };
+    constexpr Fp kTwoInv{{0x87bee7d24f060572, 0xd0fd2add2f1c6ae5, 0x8f5f7492fcfd4f44, 0x1f37631a3d9cbfac}};
+
+    template <typename F>
+    struct Affine {
+        F x, y;
+        bool infinity{false};
+    };
+
+    //! Jacobian coordinates (X / Z^2, Y / Z^3), Z == 0 for the point at infinity
+    template <typename F>
+    struct Jacobian {
+        F x, y, z;
+
+        [[nodiscard]] bool is_infinity() const noexcept { return z.is_zero(); }
+    };
+
+    template <typename F>
+    Jacobian<F> to_jacobian(const Affine<F>& p) noexcept {
+        if (p.infinity) {
+            return {F::one(), F::one(), F::zero()};
+        }
+        return {p.x, p.y, F::one()};
+    }
+
+    template <typename F>
+    Affine<F> to_affine(const Jacobian<F>& p) noexcept {
+        if (p.is_infinity()) {
+            return {F::zero(), F::zero(), true};
+        }
+        const F z_inv{inverse(p.z)};
+        const F z_inv2{square(z_inv)};
+        return {p.x * z_inv2, p.y * z_inv2 * z_inv};
+    }
+
+    //! dbl-2009-l for a = 0
+    template <typename F>
+    Jacobian<F> dbl(const Jacobian<F>& p) noexcept {
+        if (p.is_infinity()) {
+            return p;
+        }
+        const F a{square(p.x)};
+        const F b{square(p.y)};
+        const F c{square(b)};
+        const F d{twice(square(p.x + b) - a - c)};
+        const F e{twice(a) + a};
+        const F f{square(e)};
+        const F x3{f - twice(d)};
+        const F c8{twice(twice(twice(c)))};
+        return {x3, e * (d - x3) - c8, twice(p.y * p.z)};
+    }
+
+    //! add-2007-bl
+    template <typename F>
+    Jacobian<F> add(const Jacobian<F>& p, const Jacobian<F>& q) noexcept {
+        if (p.is_infinity()) {
+            return q;
+        }
+        if (q.is_infinity()) {
+            return p;
+        }
+        const F z1z1{square(p.z)};
+        const F z2z2{square(q.z)};
+        const F u1{p.x * z2z2};
+        const F u2{q.x * z1z1};
+        const F s1{p.y * q.z * z2z2};
+        const F s2{q.y * p.z * z1z1};
+        const F h{u2 - u1};
+        const F r{twice(s2 - s1)};
+        if (h.is_zero()) {
+            return r.is_zero() ? dbl(p) : Jacobian<F>{F::one(), F::one(), F::zero()};
+        }
+        const F i{square(twice(h))};
+        const F j{h * i};
+        const F v{u1 * i};
+        const F x3{square(r) - j - twice(v)};
+        return {x3, r * (v - x3) - twice(s1 * j), (square(p.z + q.z) - z1z1 - z2z2) * h};
+    }
+
+    //! Fixed 4-bit window multiplication by a 256-bit scalar
+    template <typename F>
+    Jacobian<F> mul(const Jacobian<F>& p, const Limbs& scalar) noexcept {
+        std::array<Jacobian<F>, 16> table;
+        table[0] = {F::one(), F::one(), F::zero()};
+        table[1] = p;
+        for (std::size_t i{2}; i < table.size(); ++i) {
+            table[i] = (i % 2 == 0) ? dbl(table[i / 2]) : add(table[i - 1], p);
+        }
+        Jacobian<F> result{table[0]};
+        bool leading_zeros{true};
+        for (std::size_t window{64}; window-- > 0;) {
+            if (!leading_zeros) {
+                for (std::size_t i{0}; i < 4; ++i) {
+                    result = dbl(result);
+                }
+            }
+            const auto digit{(scalar[window / 16] >> (4 * (window % 16))) & 0xf};
+            if (digit != 0) {
+                result = leading_zeros ? table[digit] : add(result, table[digit]);
+                leading_zeros = false;
+            }
+        }
+        return result;
+    }
+
+    template <typename F>
+    bool is_on_curve(const F& x, const F& y, const F& b) noexcept {
+        return square(y) == square(x) * x + b;
+    }
+
+    std::optional<Affine<Fp>> read_g1(const uint8_t* bytes_be) noexcept {
+        const auto x{read_fp(bytes_be)};
+        const auto y{read_fp(bytes_be + 32)};
+        if (!x || !y) {
+            return std::nullopt;
+        }
+        if (x->is_zero() && y->is_zero()) {
+            return Affine<Fp>{*x, *y, true};
+        }
+        if (!is_on_curve(*x, *y, kB)) {
+            return std::nullopt;
+        }
+        return Affine<Fp>{*x, *y};
+    }
+
+    void write_g1(uint8_t* bytes_be, const Affine<Fp>& p) noexcept {
+        if (p.infinity) {
+            std::fill_n(bytes_be, 64, uint8_t{0});
+            return;
+        }
+        write_fp(bytes_be, p.x);
+        write_fp(bytes_be + 32, p.y);
+    }
+
+    std::optional<Fp2> read_fp2(const uint8_t* bytes_be) noexcept {
+        const auto c1{read_fp(bytes_be)};
+        const auto c0{read_fp(bytes_be + 32)};
+        if (!c0 || !c1) {
+            return std::nullopt;
+        }
+        return Fp2{*c0, *c1};
+    }
+
+    //! The twisted p-power Frobenius endomorphism on G2
+    Affine<Fp2> mul_by_characteristic(const Affine<Fp2>& q) noexcept {
+        const Fp2& twist_mul_by_q_x{kFrobeniusGamma[0][1]};  // xi^((p - 1) / 3)
+        const Fp2& twist_mul_by_q_y{kFrobeniusGamma[0][2]};  // xi^((p - 1) / 2)
+        return {conjugate(q.x) * twist_mul_by_q_x, conjugate(q.y) * twist_mul_by_q_y};
+    }
+
+    std::optional<Affine<Fp2>> read_g2(const uint8_t* bytes_be) noexcept {
+        const auto x{read_fp2(bytes_be)};
+        const auto y{read_fp2(bytes_be + 64)};
+        if (!x || !y) {
+            return std::nullopt;
+        }
+        if (x->is_zero() && y->is_zero()) {
+            return Affine<Fp2>{*x, *y, true};
+        }
+        if (!is_on_curve(*x, *y, kTwistB)) {
+            return std::nullopt;
+        }
+        // Unlike G1, the twist has points out of the r-torsion subgroup. Rather than checking that [r]Q is infinity,
+        // use psi(Q) == [6u^2]Q with a half-size scalar, see "Co-factor clearing and subgroup membership testing on
+        // pairing-friendly curves" (https://eprint.iacr.org/2022/352)
+        const Affine<Fp2> q{*x, *y};
+        const Affine<Fp2> psi_q{mul_by_characteristic(q)};
+        const Jacobian<Fp2> q_6u2{mul(to_jacobian(q), kSixUSquared)};
+        if (q_6u2.is_infinity()) {
+            return std::nullopt;
+        }
+        const Fp2 z2{square(q_6u2.z)};
+        if (q_6u2.x != psi_q.x * z2 || q_6u2.y != psi_q.y * z2 * q_6u2.z) {
+            return std::nullopt;
+        }
+        return q;
+    }
+
+    // Optimal ate pairing, see "Faster Explicit Formulas for Computing Pairings over Ordinary Curves"
+    // (https://eprint.iacr.org/2010/354) for the homogeneous projective line functions
+
+    //! Coefficients of a line function before its evaluation at the G1 point
+    struct LineCoefficients {
+        Fp2 c0, c3, c4;
+    };
+
+    //! Homogeneous projective coordinates (X / Z, Y / Z)
+    struct G2Projective {
+        Fp2 x, y, z;
+    };
+
+    LineCoefficients doubling_step(G2Projective& r) noexcept {
+        const Fp2 a{r.x * r.y * kTwoInv};
+        const Fp2 b{square(r.y)};
+        const Fp2 c{square(r.z)};
+        const Fp2 e{kTwistB * (twice(c) + c)};
+        const Fp2 f{twice(e) + e};
+        const Fp2 g{(b + f) * kTwoInv};
+        const Fp2 h{square(r.y + r.z) - (b + c)};
+        const Fp2 i{e - b};
+        const Fp2 j{square(r.x)};
+        const Fp2 e_square{square(e)};
+
+        r.x = a * (b - f);
+        r.y = square(g) - (twice(e_square) + e_square);
+        r.z = b * h;
+        return {-h, twice(j) + j, i};
+    }
+
+    LineCoefficients addition_step(G2Projective& r, const Affine<Fp2>& q) noexcept {
+        const Fp2 theta{r.y - q.y * r.z};
+        const Fp2 lambda{r.x - q.x * r.z};
+        const Fp2 c{square(theta)};
+        const Fp2 d{square(lambda)};
+        const Fp2 e{lambda * d};
+        const Fp2 f{r.z * c};
+        const Fp2 g{r.x * d};
+        const Fp2 h{e + f - twice(g)};
+        r.x = lambda * h;
+        r.y = theta * (g - h) - e * r.y;
+        r.z = r.z * e;
+        const Fp2 j{theta * q.x - lambda * q.y};
+        return {lambda, -theta, j};
+    }
+
+    //! All the line coefficients of the Miller loop for a G2 point, in loop order
+    std::vector<LineCoefficients> prepare_g2(const Affine<Fp2>& q) noexcept {
+        std::vector<LineCoefficients> coefficients;
+        coefficients.reserve(kAteLoopNaf.size() + 32);
+        G2Projective r{q.x, q.y, Fp2::one()};
+        const Affine<Fp2> neg_q{q.x, -q.y};
+        for (std::size_t i{kAteLoopNaf.size() - 1}; i-- > 0;) {
+            coefficients.push_back(doubling_step(r));
+            if (kAteLoopNaf[i] == 1) {
+                coefficients.push_back(addition_step(r, q));
+            } else if (kAteLoopNaf[i] == -1) {
+                coefficients.push_back(addition_step(r, neg_q));
+            }
+        }
+        const Affine<Fp2> q1{mul_by_characteristic(q)};
+        Affine<Fp2> q2{mul_by_characteristic(q1)};
+        q2.y = -q2.y;
+        coefficients.push_back(addition_step(r, q1));
+        coefficients.push_back(addition_step(r, q2));
+        return coefficients;
+    }
+
+    inline Fp12 evaluate_line(const Fp12& f, const LineCoefficients& line, const Affine<Fp>& p) noexcept {
+        return mul_by_034(f, line.c0 * p.y, line.c3 * p.x, line.c4);
+    }
+
+    struct PreparedPair {
+        Affine<Fp> p;
+        std::vector<LineCoefficients> lines;
+    };
+
+    //! Miller loops of all the pairs sharing the accumulator, so squarings are paid once rather than once per pair
+    Fp12 multi_miller_loop(const std::vector<PreparedPair>& pairs) noexcept {
+        Fp12 f{Fp12::one()};
+        std::size_t line_index{0};
+        for (std::size_t i{kAteLoopNaf.size() - 1}; i > 0; --i) {
+            if (i != kAteLoopNaf.size() - 1) {
+                f = square(f);
+            }
+            for (const auto& pair : pairs) {
+                f = evaluate_line(f, pair.lines[line_index], pair.p);
+            }
+            ++line_index;
+            if (kAteLoopNaf[i - 1] != 0) {
+                for (const auto& pair : pairs) {
+                    f = evaluate_line(f, pair.lines[line_index], pair.p);
+                }
+                ++line_index;
+            }
+        }
+        for (std::size_t k{0}; k < 2; ++k, ++line_index) {
+            for (const auto& pair : pairs) {
+                f = evaluate_line(f, pair.lines[line_index], pair.p);
+            }
+        }
+        return f;
+    }
+
+    //! f^-u for f in the cyclotomic subgroup
+    Fp12 exp_by_neg_u(const Fp12& f) noexcept {
+        Fp12 result{f};
+        for (int bit{61}; bit >= 0; --bit) {  // u has 63 bits, the top one is f itself
+            result = cyclotomic_square(result);
+            if ((kU >> bit) & 1) {
+                result = result * f;
+            }
+        }
+        return conjugate(result);
+    }
+
+    //! Easy part f^((p^6 - 1) * (p^2 + 1)), then the hard part following Fuentes-Castaneda et al. "Faster hashing
+    //! to G2", which raises to a multiple of (p^4 - p^2 + 1) / r not divisible by r, so the result is one iff the
+    //! pairing is
+    Fp12 final_exponentiation(const Fp12& f) noexcept {
+        Fp12 r{conjugate(f) * inverse(f)};
+        r = frobenius(r, 2) * r;
+
+        const Fp12 y0{exp_by_neg_u(r)};
+        const Fp12 y1{cyclotomic_square(y0)};
+        const Fp12 y2{cyclotomic_square(y1)};
+        const Fp12 y3{conjugate(y2 * y1)};
+        const Fp12 y4{exp_by_neg_u(y2 * y1)};
+        const Fp12 y5{cyclotomic_square(y4)};
+        const Fp12 y6{conjugate(exp_by_neg_u(y5))};
+        const Fp12 y7{y6 * y4};
+        const Fp12 y8{y7 * y3};
+        const Fp12 y9{y8 * y1};
+        const Fp12 y10{y8 * y4};
+        const Fp12 y11{y10 * r};
+        const Fp12 y13{frobenius(y9, 1) * y11};
+        const Fp12 y14{frobenius(y8, 2) * y13};
+        const Fp12 y15{frobenius(conjugate(r) * y9, 3)};
+        return y15 * y14;
+    }
+
+}  // namespace
+
+bool add(std::span<uint8_t, 64> out, std::span<const uint8_t, 128> in) noexcept {
+    const auto a{read_g1(in.data())};
+    const auto b{read_g1(in.data() + 64)};
+    if (!a || !b) {
+        return false;
+    }
+    write_g1(out.data(), to_affine(add(to_jacobian(*a), to_jacobian(*b))));
+    return true;
+}
+
+bool mul(std::span<uint8_t, 64> out, std::span<const uint8_t, 96> in) noexcept {
+    const auto a{read_g1(in.data())};
+    if (!a) {
+        return false;
+    }
+    write_g1(out.data(), to_affine(mul(to_jacobian(*a), read_scalar(in.data() + 64))));
+    return true;
+}
+
+std::optional<bool> pairing_check(std::span<const uint8_t> input) noexcept {
+    static constexpr std::size_t kPairSize{192};
+    if (input.size() % kPairSize != 0) {
+        return std::nullopt;
+    }
+
+    std::vector<PreparedPair> pairs;
+    pairs.reserve(input.size() / kPairSize);
+    for (std::size_t offset{0}; offset < input.size(); offset += kPairSize) {
+        const auto a{read_g1(&input[offset])};
+        if (!a) {
+            return std::nullopt;
+        }
+        const auto b{read_g2(&input[offset + 64])};
+        if (!b) {
+            return std::nullopt;
+        }
+        // e(a, b) is one if either point is at infinity
+        if (a->infinity || b->infinity) {
+            continue;
+        }
+        pairs.push_back({*a, prepare_g2(*b)});
+    }
+    if (pairs.empty()) {
+        return true;
+    }
+    return final_exponentiation(multi_miller_loop(pairs)) == Fp12::one();
+}
+
+}  // namespace silkworm::bn254
@@ -0,0 +1,54 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+
+// Native arithmetic on the BN254 (a.k.a. alt_bn128) pairing-friendly curve backing the precompiles of
+// EIP-196: Precompiled contracts for addition and scalar multiplication on the elliptic curve alt_bn128
+// EIP-197: Precompiled contracts for optimal ate pairing check on the elliptic curve alt_bn128
+//
+// Field elements are kept in Montgomery form on 4 64-bit limbs. The multiplication uses BMI2/ADX instructions when
+// the target supports both (-march=broadwell or later, or the SILKWORM_BN254_ADX build option), 128-bit integers if
+// the compiler has them and a portable 32-bit split otherwise. The pairing check is a multi-pairing: all the Miller
+// loops share the same accumulator squarings and a single final exponentiation.
+// Inputs are public, so none of the code below is constant time.
+
+namespace silkworm::bn254 {
+
+//! \brief EIP-196 ECADD: sum of two G1 points
+//! \param in [in] : two points as big-endian (x, y) coordinates of 32 bytes each, (0, 0) being the point at infinity
+//! \param out [out] : the sum in the same encoding
+//! \return Whether both points are valid, i.e. coordinates less than the field modulus and point on the curve
+bool add(std::span<uint8_t, 64> out, std::span<const uint8_t, 128> in) noexcept;
+
+//! \brief EIP-196 ECMUL: product of a G1 point by a scalar
+//! \param in [in] : the point encoded as for add followed by the big-endian 32-byte scalar
+//! \param out [out] : the product encoded as for add
+//! \return Whether the point is valid
+bool mul(std::span<uint8_t, 64> out, std::span<const uint8_t, 96> in) noexcept;
+
+//! \brief EIP-197 pairing check: whether e(a1, b1) * ... * e(ak, bk) == 1
+//! \param input [in] : k pairs of 192 bytes each: a G1 point encoded as for add followed by a G2 point encoded as
+//! (x.imaginary, x.real, y.imaginary, y.real) big-endian 32-byte numbers
+//! \return std::nullopt if the input length is not a multiple of 192 or if any point is not valid (G2 points must
+//! also be in the r-torsion subgroup), otherwise the check outcome
+std::optional<bool> pairing_check(std::span<const uint8_t> input) noexcept;
+
+}  // namespace silkworm::bn254
@@ -0,0 +1,230 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "bn254.hpp"
+
+#include <array>
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/core/common/util.hpp>
+
+namespace silkworm::bn254 {
+
+// Expected values computed with an independent Python implementation of the curve
+
+static std::optional<Bytes> run_add(std::string_view hex) {
+    const Bytes in{*from_hex(hex)};
+    REQUIRE(in.size() == 128);
+    Bytes out(64, '\0');
+    if (!add(std::span<uint8_t, 64>{out.data(), 64}, std::span<const uint8_t, 128>{in.data(), 128})) {
+        return std::nullopt;
+    }
+    return out;
+}
+
+static std::optional<Bytes> run_mul(std::string_view hex) {
+    const Bytes in{*from_hex(hex)};
+    REQUIRE(in.size() == 96);
+    Bytes out(64, '\0');
+    if (!mul(std::span<uint8_t, 64>{out.data(), 64}, std::span<const uint8_t, 96>{in.data(), 96})) {
+        return std::nullopt;
+    }
+    return out;
+}
+
+static std::optional<bool> run_pairing_check(std::string_view hex) {
+    const Bytes in{*from_hex(hex)};
+    return pairing_check(in);
+}
+
+static constexpr std::string_view kInfinity{
+    "0000000000000000000000000000000000000000000000000000000000000000"
+    "0000000000000000000000000000000000000000000000000000000000000000"};
+
+TEST_CASE("BN254 addition") {
+    SECTION("distinct points") {
+        const auto sum{run_add(
+            "2fc8969ac3831dba0777a792f21d1422ae47c22f0c2325abceb92204a94488b202a0ea28ead77b5373ecb0ab6359bb79"
+            "3b3381a90b965f654392b45c25e76e470a15245413521600f4b64981559d3aa8c187bc38df67ee06db3c0f86ce5790dd"
+            "18022fb51ee64ce15d7e587218db714202963e47c4cbb11c25d2068d9fdc846d")};
+        REQUIRE(sum);
+        CHECK(to_hex(*sum) ==
+              "1f3232f1653f22b1d2667f891ecdf8ba0be1e215087bbaec7b177e75a0b41d8b12d24063aa11e54cabd1491d7323a877"
+              "f480d51952e0c6eff96a6530b599f568");
+    }
+
+    SECTION("doubling") {
+        const auto sum{run_add(
+            "16afd2746ed1d47518c1f67768163e6ecb3181f89931bd7bfd97b34683fb5baa1c6ced6e9fbb87937397ec94572b7d70"
+            "d1168849c4618a5842742728d844206e16afd2746ed1d47518c1f67768163e6ecb3181f89931bd7bfd97b34683fb5baa"
+            "1c6ced6e9fbb87937397ec94572b7d70d1168849c4618a5842742728d844206e")};
+        REQUIRE(sum);
+        CHECK(to_hex(*sum) ==
+              "12cbc0843903e5c1ac2c6694cdbe2bcdfc130341d062305c9f9ab49f10e0960621afe0832f573251573b2d6317d9c265"
+              "06265c228f20da9fad7b08e09645b04f");
+    }
+
+    SECTION("opposite points") {
+        const auto sum{run_add(
+            "16afd2746ed1d47518c1f67768163e6ecb3181f89931bd7bfd97b34683fb5baa1c6ced6e9fbb87937397ec94572b7d70"
+            "d1168849c4618a5842742728d844206e16afd2746ed1d47518c1f67768163e6ecb3181f89931bd7bfd97b34683fb5baa"
+            "13f761044176189644b859222a55daecc66ae247a4104034f9ac64ee0038dcd9")};
+        REQUIRE(sum);
+        CHECK(to_hex(*sum) == kInfinity);
+    }
+
+    SECTION("point at infinity") {
+        const auto sum{run_add(
+            "16afd2746ed1d47518c1f67768163e6ecb3181f89931bd7bfd97b34683fb5baa1c6ced6e9fbb87937397ec94572b7d70"
+            "d1168849c4618a5842742728d844206e0000000000000000000000000000000000000000000000000000000000000000"
+            "0000000000000000000000000000000000000000000000000000000000000000")};
+        REQUIRE(sum);
+        CHECK(to_hex(*sum) ==
+              "16afd2746ed1d47518c1f67768163e6ecb3181f89931bd7bfd97b34683fb5baa1c6ced6e9fbb87937397ec94572b7d70"
+              "d1168849c4618a5842742728d844206e");
+    }
+
+    SECTION("point not on the curve") {
+        CHECK_FALSE(run_add(
+            "000000000000000000000000000000000000000000000000000000000000000100000000000000000000000000000000"
+            "000000000000000000000000000000030000000000000000000000000000000000000000000000000000000000000001"
+            "0000000000000000000000000000000000000000000000000000000000000002"));
+    }
+
+    SECTION("coordinate not less than the modulus") {
+        CHECK_FALSE(run_add(
+            "30644e72e131a029b85045b68181585d97816a916871ca8d3c208c16d87cfd4700000000000000000000000000000000"
+            "000000000000000000000000000000020000000000000000000000000000000000000000000000000000000000000001"
+            "0000000000000000000000000000000000000000000000000000000000000002"));
+    }
+}
+
+TEST_CASE("BN254 scalar multiplication") {
+    SECTION("random scalar") {
+        const auto product{run_mul(
+            "16afd2746ed1d47518c1f67768163e6ecb3181f89931bd7bfd97b34683fb5baa1c6ced6e9fbb87937397ec94572b7d70"
+            "d1168849c4618a5842742728d844206ea5e333cb88dcf94384d4cd1f47ca7883ff5a52f1a05885ac7671863c0bdbc23a")};
+        REQUIRE(product);
+        CHECK(to_hex(*product) ==
+              "2570711e5fd0467b9edddaac8f1ba091853f2f4b2c544286a1a19ced5fbfd6860b9bcacc07319c1749bbd9345cec2bc1"
+              "2a3f2a3f1db184f324a4249b30e09ea8");
+    }
+
+    SECTION("group order") {
+        const auto product{run_mul(
+            "16afd2746ed1d47518c1f67768163e6ecb3181f89931bd7bfd97b34683fb5baa1c6ced6e9fbb87937397ec94572b7d70"
+            "d1168849c4618a5842742728d844206e30644e72e131a029b85045b68181585d2833e84879b9709143e1f593f0000001")};
+        REQUIRE(product);
+        CHECK(to_hex(*product) == kInfinity);
+    }
+
+    SECTION("zero") {
+        const auto product{run_mul(
+            "16afd2746ed1d47518c1f67768163e6ecb3181f89931bd7bfd97b34683fb5baa1c6ced6e9fbb87937397ec94572b7d70"
+            "d1168849c4618a5842742728d844206e0000000000000000000000000000000000000000000000000000000000000000")};
+        REQUIRE(product);
+        CHECK(to_hex(*product) == kInfinity);
+    }
+
+    SECTION("largest scalar") {
+        const auto product{run_mul(
+            "16afd2746ed1d47518c1f67768163e6ecb3181f89931bd7bfd97b34683fb5baa1c6ced6e9fbb87937397ec94572b7d70"
+            "d1168849c4618a5842742728d844206effffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff")};
+        REQUIRE(product);
+        CHECK(to_hex(*product) ==
+              "264f57ef03e602b3086fc00ac46abc1b10e0e514c0062d415301837b6955a0c627f090bfd9759c5ae5ab4f11e9837593"
+              "f341dae954a5e90ee54181852a2dd82c");
+    }
+
+    SECTION("point not on the curve") {
+        CHECK_FALSE(run_mul(
+            "000000000000000000000000000000000000000000000000000000000000000100000000000000000000000000000000"
+            "000000000000000000000000000000030000000000000000000000000000000000000000000000000000000000000005"));
+    }
+}
+
+TEST_CASE("BN254 pairing check") {
+    SECTION("empty input") {
+        CHECK(run_pairing_check("") == true);
+    }
+
+    SECTION("truncated input") {
+        CHECK_FALSE(run_pairing_check("ab"));
+    }
+
+    SECTION("bilinearity: e(P, Q) * e(-xy G1, G2) == 1") {
+        CHECK(run_pairing_check(
+                  "26d3c1aa68131658b740c72c6834342a0168d15c126103fd6aa1fcb116bb4695231d5044b8b91de5a356320e905a84f3"
+                  "c70b1811c31488cb86dad2085ee3bda727db5aea449052a99b0d19de9068631a8319dd0cc03e6009b8680314fb42c26c"
+                  "21e34e75b42c9c45a28b166a5a5cb294dc6de2193790accaa73f50a0a010db962b7c270ff1858db07b3ba5a2f2f0189f"
+                  "f8bae222eea32fe5535370f60eaeb0000ae571410a9ad479dc61cc794816f9c81057b56d5d71517e2f2d7d8ffc7ad70b"
+                  "086edd026c8a302b30da2b0485836b23f4bdf7d20b5d2c3fb198164d17d20e3508e41d67c65416c4e20224319ad2223c"
+                  "1fdcf82ce2b99f580758cc32da60d772198e9393920d483a7260bfb731fb5d25f1aa493335a9e71297e485b7aef312c2"
+                  "1800deef121f1e76426a00665e5c4479674322d4f75edadd46debd5cd992f6ed090689d0585ff075ec9e99ad690c3395"
+                  "bc4b313370b38ef355acdadcd122975b12c85ea5db8c6deb4aab71808dcb408fe3d1e7690c43d37b4ce6cc0166fa7daa") == true);
+    }
+
+    SECTION("failing check") {
+        CHECK(run_pairing_check(
+                  "26d3c1aa68131658b740c72c6834342a0168d15c126103fd6aa1fcb116bb4695231d5044b8b91de5a356320e905a84f3"
+                  "c70b1811c31488cb86dad2085ee3bda727db5aea449052a99b0d19de9068631a8319dd0cc03e6009b8680314fb42c26c"
+                  "21e34e75b42c9c45a28b166a5a5cb294dc6de2193790accaa73f50a0a010db962b7c270ff1858db07b3ba5a2f2f0189f"
+                  "f8bae222eea32fe5535370f60eaeb0000ae571410a9ad479dc61cc794816f9c81057b56d5d71517e2f2d7d8ffc7ad70b"
+                  "000000000000000000000000000000000000000000000000000000000000000130644e72e131a029b85045b68181585d"
+                  "97816a916871ca8d3c208c16d87cfd45198e9393920d483a7260bfb731fb5d25f1aa493335a9e71297e485b7aef312c2"
+                  "1800deef121f1e76426a00665e5c4479674322d4f75edadd46debd5cd992f6ed090689d0585ff075ec9e99ad690c3395"
+                  "bc4b313370b38ef355acdadcd122975b12c85ea5db8c6deb4aab71808dcb408fe3d1e7690c43d37b4ce6cc0166fa7daa") == false);
+    }
+
+    SECTION("three pairs") {
+        CHECK(run_pairing_check(
+                  "26d3c1aa68131658b740c72c6834342a0168d15c126103fd6aa1fcb116bb4695231d5044b8b91de5a356320e905a84f3"
+                  "c70b1811c31488cb86dad2085ee3bda727db5aea449052a99b0d19de9068631a8319dd0cc03e6009b8680314fb42c26c"
+                  "21e34e75b42c9c45a28b166a5a5cb294dc6de2193790accaa73f50a0a010db962b7c270ff1858db07b3ba5a2f2f0189f"
+                  "f8bae222eea32fe5535370f60eaeb0000ae571410a9ad479dc61cc794816f9c81057b56d5d71517e2f2d7d8ffc7ad70b"
+                  "000000000000000000000000000000000000000000000000000000000000000100000000000000000000000000000000"
+                  "0000000000000000000000000000000217666990c132ef29b82c2e8e62488f719ef8ebf6c3b36fcc2302476fdd402fbf"
+                  "146d9e84cf93bca44a5b360478e0e1aece43cfaa480c744c0e6b9a5857ca0a8f11803a4536c6775dd9326da61d89489c"
+                  "c400d896382f05f69c228dd234216a120cc0684bcbf3af5572ccc1c975770341bcf9c8071c52750bb417855e86566cda"
+                  "0ccf3e3c5ca9fe72f6f8921baa6460df3838d8d142b97d54e0078e13aff641df2f078db758ef7a553d81a1e924f2ee2c"
+                  "4fec1a561997394b806ba84c3fd86480198e9393920d483a7260bfb731fb5d25f1aa493335a9e71297e485b7aef312c2"
+                  "1800deef121f1e76426a00665e5c4479674322d4f75edadd46debd5cd992f6ed090689d0585ff075ec9e99ad690c3395"
+                  "bc4b313370b38ef355acdadcd122975b12c85ea5db8c6deb4aab71808dcb408fe3d1e7690c43d37b4ce6cc0166fa7daa") == true);
+    }
+
+    SECTION("pairs with a point at infinity are skipped") {
+        CHECK(run_pairing_check(
+                  "000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+                  "0000000000000000000000000000000027db5aea449052a99b0d19de9068631a8319dd0cc03e6009b8680314fb42c26c"
+                  "21e34e75b42c9c45a28b166a5a5cb294dc6de2193790accaa73f50a0a010db962b7c270ff1858db07b3ba5a2f2f0189f"
+                  "f8bae222eea32fe5535370f60eaeb0000ae571410a9ad479dc61cc794816f9c81057b56d5d71517e2f2d7d8ffc7ad70b"
+                  "26d3c1aa68131658b740c72c6834342a0168d15c126103fd6aa1fcb116bb4695231d5044b8b91de5a356320e905a84f3"
+                  "c70b1811c31488cb86dad2085ee3bda70000000000000000000000000000000000000000000000000000000000000000"
+                  "000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+                  "000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000") == true);
+    }
+
+    SECTION("twist point out of the G2 subgroup") {
+        CHECK_FALSE(run_pairing_check(
+            "26d3c1aa68131658b740c72c6834342a0168d15c126103fd6aa1fcb116bb4695231d5044b8b91de5a356320e905a84f3"
+            "c70b1811c31488cb86dad2085ee3bda70000000000000000000000000000000000000000000000000000000000000000"
+            "00000000000000000000000000000000000000000000000000000000000000010d1271953ed9ea0836846e70a1934187"
+            "998c7f790cb4d7511b7f8da82de048a42869111d5381f072f8e2728fdb825a51aadd70e52c9830e9ab4b871c0531f1bb"));
+    }
+}
+
+}  // namespace silkworm::bn254
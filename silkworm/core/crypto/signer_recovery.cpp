@@ -0,0 +1,155 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "signer_recovery.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include <silkworm/core/common/assert.hpp>
+#include <silkworm/core/common/hash_maps.hpp>
+#include <silkworm/core/crypto/ecdsa.h>
+
+namespace silkworm {
+
+#if defined(__wasm__)
+inline constexpr std::size_t kDefaultSignerCacheSize{1'024};
+#else
+// About 200 bytes per entry including LRU bookkeeping
+inline constexpr std::size_t kDefaultSignerCacheSize{32'768};
+#endif
+
+SignerCache::SignerCache(std::size_t max_size) : max_size_{max_size} {
+    const std::size_t shard_size{std::max<std::size_t>(max_size / kShards, 1)};
+    for (auto& shard : shards_) {
+        shard = std::make_unique<Shard>(shard_size, /*thread_safe=*/true);
+    }
+}
+
+SignerCache::Shard& SignerCache::shard_for(const SignerRecoveryInput& input) const noexcept {
+    // Use other bytes than the hash function, so that entries are spread across the buckets of each shard
+    return *shards_[(input.message_hash.bytes[31] ^ input.signature[31]) % kShards];
+}
+
+std::optional<evmc::address> SignerCache::get(const SignerRecoveryInput& input) {
+    auto signer{shard_for(input).get_as_copy(input)};
+    (signer ? hits_ : misses_).fetch_add(1, std::memory_order_relaxed);
+    return signer;
+}
+
+void SignerCache::put(const SignerRecoveryInput& input, const evmc::address& signer) {
+    shard_for(input).put(input, signer);
+}
+
+std::size_t SignerCache::size() const noexcept {
+    std::size_t total{0};
+    for (const auto& shard : shards_) {
+        total += shard->size();
+    }
+    return total;
+}
+
+SignerCache::Stats SignerCache::stats() const noexcept {
+    return {.hits = hits_.load(std::memory_order_relaxed), .misses = misses_.load(std::memory_order_relaxed)};
+}
+
+void SignerCache::clear() noexcept {
+    for (auto& shard : shards_) {
+        shard->clear();
+    }
+}
+
+SignerCache& signer_cache() {
+    static SignerCache cache{kDefaultSignerCacheSize};
+    return cache;
+}
+
+#ifndef ANTELOPE
+secp256k1_context* signer_recovery_context() {
+    // Never destroyed: it may be in use by other static objects until the very end of the process
+    static secp256k1_context* context{secp256k1_context_create(SILKWORM_SECP256K1_CONTEXT_FLAGS)};
+    return context;
+}
+#endif
+
+static std::optional<evmc::address> recover(const SignerRecoveryInput& input) noexcept {
+    evmc::address signer;
+#if defined(ANTELOPE)
+    const bool ok{silkworm_recover_address(signer.bytes, input.message_hash.bytes, input.signature.data(),
+                                           input.odd_y_parity)};
+#else
+    const bool ok{silkworm_recover_address(signer.bytes, input.message_hash.bytes, input.signature.data(),
+                                           input.odd_y_parity, signer_recovery_context())};
+#endif
+    if (!ok) {
+        return std::nullopt;
+    }
+    return signer;
+}
+
+std::optional<evmc::address> recover_signer(const SignerRecoveryInput& input, SignerCache* cache) {
+    if (cache) {
+        if (auto signer{cache->get(input)}) {
+            return signer;
+        }
+    }
+    auto signer{recover(input)};
+    if (signer && cache) {
+        cache->put(input, *signer);
+    }
+    return signer;
+}
+
+std::size_t recover_signers(std::span<const SignerRecoveryInput> inputs,
+                            std::span<std::optional<evmc::address>> signers,
+                            SignerCache* cache) {
+    SILKWORM_ASSERT(signers.size() == inputs.size());
+
+    // First occurrence in the batch of each input not found in the cache
+    FlatHashMap<SignerRecoveryInput, std::size_t> first_occurrence;
+    std::vector<std::size_t> duplicates;
+    for (std::size_t i{0}; i < inputs.size(); ++i) {
+        if (cache) {
+            signers[i] = cache->get(inputs[i]);
+            if (signers[i]) {
+                continue;
+            }
+        }
+        if (!first_occurrence.emplace(inputs[i], i).second) {
+            duplicates.push_back(i);
+        }
+    }
+
+    std::size_t failures{0};
+    for (const auto& input_and_index : first_occurrence) {
+        const auto index{input_and_index.second};
+        signers[index] = recover(inputs[index]);
+        if (!signers[index]) {
+            ++failures;
+        } else if (cache) {
+            cache->put(inputs[index], *signers[index]);
+        }
+    }
+    for (const auto index : duplicates) {
+        signers[index] = signers[first_occurrence.find(inputs[index])->second];
+        if (!signers[index]) {
+            ++failures;
+        }
+    }
+    return failures;
+}
+
+}  // namespace silkworm
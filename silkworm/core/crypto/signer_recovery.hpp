@@ -0,0 +1,131 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+
+#ifndef ANTELOPE
+#include <secp256k1.h>
+#endif
+
+#include <evmc/evmc.hpp>
+
+#include <silkworm/core/common/lru_cache.hpp>
+
+// Recovery of secp256k1 signers shared by sender recovery (transactions, RPC) and the ECREC precompile, so that a
+// signature recovered by one of them is not recovered again by the others. Sync paths (Senders stage, engine
+// payloads) recover w/o cache, their transactions being seen once.
+
+namespace silkworm {
+
+//! \brief What identifies an ECDSA recovery: the signed 32-byte message hash and the r || s signature plus y parity
+//! \remarks Validation of r, s and v against the chain rules is up to the caller
+struct SignerRecoveryInput {
+    evmc::bytes32 message_hash;
+    std::array<uint8_t, 64> signature{};
+    bool odd_y_parity{false};
+
+    friend bool operator==(const SignerRecoveryInput&, const SignerRecoveryInput&) = default;
+};
+
+}  // namespace silkworm
+
+namespace std {
+
+template <>
+struct hash<silkworm::SignerRecoveryInput> {
+    //! Message hash and signature are both uniformly distributed, so mixing a few words of each is enough
+    size_t operator()(const silkworm::SignerRecoveryInput& input) const noexcept {
+        uint64_t message_word, r_word, s_word;
+        std::memcpy(&message_word, input.message_hash.bytes, sizeof(uint64_t));
+        std::memcpy(&r_word, input.signature.data(), sizeof(uint64_t));
+        std::memcpy(&s_word, input.signature.data() + 32, sizeof(uint64_t));
+        return static_cast<size_t>(message_word ^ (r_word * 0x9e3779b97f4a7c15ull) ^ (s_word >> 1) ^
+                                   static_cast<uint64_t>(input.odd_y_parity));
+    }
+};
+
+}  // namespace std
+
+namespace silkworm {
+
+//! \brief Concurrent bounded cache of recovered signers, split into independently locked LRU shards
+//! \details Only successful recoveries are cached, so a cache hit always yields the same address a recovery would
+class SignerCache {
+  public:
+    static constexpr std::size_t kShards{16};
+
+    struct Stats {
+        uint64_t hits{0};
+        uint64_t misses{0};
+    };
+
+    explicit SignerCache(std::size_t max_size);
+
+    SignerCache(const SignerCache&) = delete;
+    SignerCache& operator=(const SignerCache&) = delete;
+
+    [[nodiscard]] std::optional<evmc::address> get(const SignerRecoveryInput& input);
+    void put(const SignerRecoveryInput& input, const evmc::address& signer);
+
+    [[nodiscard]] std::size_t size() const noexcept;
+    [[nodiscard]] std::size_t max_size() const noexcept { return max_size_; }
+    [[nodiscard]] Stats stats() const noexcept;
+
+    void clear() noexcept;
+
+  private:
+    using Shard = lru_cache<SignerRecoveryInput, evmc::address>;
+
+    Shard& shard_for(const SignerRecoveryInput& input) const noexcept;
+
+    std::size_t max_size_;
+    std::array<std::unique_ptr<Shard>, kShards> shards_;  // uses unique_ptr because lru_cache is not movable
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+};
+
+//! \brief The process-wide signer cache consulted by all the recovery functions below
+SignerCache& signer_cache();
+
+#ifndef ANTELOPE
+//! \brief The process-wide secp256k1 context used for recovery, created once because its precomputed tables take
+//! ~10ms to build. secp256k1 contexts are safe to use concurrently for verification
+secp256k1_context* signer_recovery_context();
+#endif
+
+//! \brief Recovers the address which signed the message hash, first looking it up in the cache (if any)
+//! \return The signer address or std::nullopt if the signature is not recoverable
+std::optional<evmc::address> recover_signer(const SignerRecoveryInput& input, SignerCache* cache = &signer_cache());
+
+//! \brief Recovers the signers of a whole batch: cached signers are taken from the cache (if any), repeated inputs in
+//! the batch are recovered only once and all the rest is recovered in one pass with the shared context
+//! \param signers [out] : the recovered signers, one for each input (std::nullopt if not recoverable)
+//! \return The number of inputs whose signer is not recoverable
+std::size_t recover_signers(std::span<const SignerRecoveryInput> inputs,
+                            std::span<std::optional<evmc::address>> signers,
+                            SignerCache* cache = &signer_cache());
+
+}  // namespace silkworm
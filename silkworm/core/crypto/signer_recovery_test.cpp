@@ -0,0 +1,110 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "signer_recovery.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/core/common/util.hpp>
+
+namespace silkworm {
+
+using namespace evmc::literals;
+
+static SignerRecoveryInput sample_input() {
+    SignerRecoveryInput input{
+        .message_hash = 0x18c547e4f7b0f325ad1e56f57e26c745b09a3e503d86e00e5255ff7f715d3d1c_bytes32,
+        .odd_y_parity = true,
+    };
+    const Bytes signature{*from_hex(
+        "73b1693892219d736caba55bdb67216e485557ea6b6af75f37096c9aa6a5a75f"
+        "eeb940b1d03b21e36b0e47e79769f095fe2ab855bd91e3a38756b7d75a9c4549")};
+    std::copy(signature.begin(), signature.end(), input.signature.begin());
+    return input;
+}
+
+static constexpr auto kSampleSigner{0xa94f5374fce5edbc8e2a8697c15331677e6ebf0b_address};
+
+TEST_CASE("Recover signer") {
+    SignerCache cache{64};
+    const auto input{sample_input()};
+
+    SECTION("without cache") {
+        CHECK(recover_signer(input, nullptr) == kSampleSigner);
+    }
+
+    SECTION("cache hit after recovery") {
+        CHECK(recover_signer(input, &cache) == kSampleSigner);
+        CHECK(cache.size() == 1);
+        CHECK(cache.get(input) == kSampleSigner);
+        CHECK(recover_signer(input, &cache) == kSampleSigner);
+        CHECK(cache.stats().hits == 2);
+        CHECK(cache.stats().misses == 1);
+    }
+
+    SECTION("parity is part of the key") {
+        REQUIRE(recover_signer(input, &cache) == kSampleSigner);
+        auto other_parity{input};
+        other_parity.odd_y_parity = false;
+        CHECK(recover_signer(other_parity, &cache) != kSampleSigner);
+    }
+
+    SECTION("unrecoverable signature is not cached") {
+        SignerRecoveryInput invalid{.message_hash = input.message_hash};
+        CHECK_FALSE(recover_signer(invalid, &cache));
+        CHECK(cache.size() == 0);
+    }
+}
+
+TEST_CASE("Recover signers in batch") {
+    SignerCache cache{64};
+    const auto input{sample_input()};
+    const SignerRecoveryInput invalid{.message_hash = input.message_hash};
+
+    const std::vector<SignerRecoveryInput> inputs{input, invalid, input, input, invalid};
+    std::vector<std::optional<evmc::address>> signers(inputs.size());
+    CHECK(recover_signers(inputs, signers, &cache) == 2);
+    CHECK(signers[0] == kSampleSigner);
+    CHECK_FALSE(signers[1]);
+    CHECK(signers[2] == kSampleSigner);
+    CHECK(signers[3] == kSampleSigner);
+    CHECK_FALSE(signers[4]);
+    CHECK(cache.size() == 1);
+
+    // Second time the valid ones come from the cache
+    const auto misses{cache.stats().misses};
+    CHECK(recover_signers(inputs, signers, &cache) == 2);
+    CHECK(signers[2] == kSampleSigner);
+    CHECK(cache.stats().misses == misses + 2);
+}
+
+TEST_CASE("Signer cache is bounded") {
+    SignerCache cache{SignerCache::kShards};
+    auto input{sample_input()};
+    for (uint8_t i{0}; i < 200; ++i) {
+        input.message_hash.bytes[0] = i;
+        input.message_hash.bytes[31] = i;
+        cache.put(input, kSampleSigner);
+    }
+    CHECK(cache.size() <= cache.max_size());
+    cache.clear();
+    CHECK(cache.size() == 0);
+}
+
+}  // namespace silkworm
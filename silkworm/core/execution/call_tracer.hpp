@@ -0,0 +1,38 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <silkworm/core/common/hash_maps.hpp>
+#include <silkworm/core/execution/evm.hpp>
+
+namespace silkworm {
+
+//! Addresses appearing as sender or recipient of any call frame
+struct CallTraces {
+    FlatHashSet<evmc::address> senders;
+    FlatHashSet<evmc::address> recipients;
+};
+
+//! Message observer collecting the from/to addresses of every call frame (including precompiles and creations)
+inline MessageObserver make_call_traces_observer(CallTraces& traces) {
+    return [&traces](const evmc_message& msg) {
+        traces.senders.insert(msg.sender);
+        traces.recipients.insert(msg.recipient);
+    };
+}
+
+}  // namespace silkworm
@@ -177,6 +177,10 @@ evmc::Result EVM::create(const evmc_message& message) noexcept {
         .create2_salt = message.create2_salt,
     };
 
+    if (message_observer_) {
+        (*message_observer_)(deploy_message);
+    }
+
     auto evm_res{execute(deploy_message, ByteView{message.input_data, message.input_size}, /*code_hash=*/nullptr)};
 
     if (evm_res.status_code == EVMC_SUCCESS) {
@@ -268,6 +272,10 @@ evmc::Result EVM::call(const evmc_message& msg) noexcept {
         }
     }
 
+    if (message_observer_) {
+        (*message_observer_)(message);
+    }
+
     if (precompile::is_precompile(message.code_address, rev)) {
         static_assert(std::size(precompile::kContracts) < 256);
         const uint8_t num{message.code_address.bytes[kAddressLength - 1]};
@@ -387,8 +395,17 @@ evmc_result EVM::execute_with_baseline_interpreter(evmc_revision rev, const evmc
             analysis = *optional_analysis;
         }
     }
+    if (!analysis && code_hash && analysis_store) {
+        analysis = analysis_store->load(*code_hash, code);
+        if (analysis && use_cache) {
+            analysis_cache->put(*code_hash, analysis);
+        }
+    }
     if (!analysis) {
         analysis = std::make_shared<evmone::baseline::CodeAnalysis>(evmone::baseline::analyze(rev, code));
+        if (code_hash && analysis_store) {
+            analysis_store->on_analysis(*code_hash, code, *analysis);
+        }
         if (use_cache) {
             analysis_cache->put(*code_hash, analysis);
         }
@@ -604,7 +621,14 @@ evmc::bytes32 EvmHost::get_block_hash(int64_t n) const noexcept {
     assert(std::in_range<std::size_t>(new_size_u64));
     const size_t new_size{static_cast<size_t>(new_size_u64)};
 
+    if (evm_.block_hashes && new_size <= evm_.block_hashes->size()) {
+        return (*evm_.block_hashes)[new_size - 1];
+    }
+
     std::vector<evmc::bytes32>& hashes{evm_.block_hashes_};
+    if (hashes.empty() && evm_.block_hashes) {
+        hashes = *evm_.block_hashes;  // resume the walk after the known ancestors
+    }
     if (hashes.empty()) {
         hashes.push_back(evm_.block_.header.parent_hash);
     }
@@ -75,8 +75,25 @@ using EvmTracers = std::vector<std::reference_wrapper<EvmTracer>>;
 
 using AnalysisCache = lru_cache<evmc::bytes32, std::shared_ptr<evmone::baseline::CodeAnalysis>>;
 
+//! \brief Second-level store of code analyses backing AnalysisCache, e.g. persisted across restarts
+class AnalysisStore {
+  public:
+    virtual ~AnalysisStore() = default;
+
+    //! \brief Returns the stored analysis of code having code_hash, nullptr if missing
+    virtual std::shared_ptr<evmone::baseline::CodeAnalysis> load(const evmc::bytes32& code_hash,
+                                                                 ByteView code) noexcept = 0;
+
+    //! \brief Notifies that code having code_hash has just been analyzed
+    virtual void on_analysis(const evmc::bytes32& code_hash, ByteView code,
+                             const evmone::baseline::CodeAnalysis& analysis) noexcept = 0;
+};
+
 using FilterFunction = std::function<bool(const evmc_message&)>;
 
+//! Called once per message frame (calls, creations and precompiles) without hooking into instruction execution
+using MessageObserver = std::function<void(const evmc_message&)>;
+
 class EVM {
   public:
     // Not copyable nor movable
@@ -107,6 +124,8 @@ class EVM {
 
     AnalysisCache* analysis_cache{nullptr};                   // provide one for better performance
     ObjectPool<evmone::ExecutionState>* state_pool{nullptr};  // ditto
+    AnalysisStore* analysis_store{nullptr};                   // looked up on analysis_cache misses
+    const std::vector<evmc::bytes32>* block_hashes{nullptr};  // known ancestor hashes (parent first) to save header reads
 
     evmc_vm* exo_evm{nullptr};  // it's possible to use an exogenous EVMC VM
 
@@ -116,10 +135,18 @@ class EVM {
       message_filter_ = message_filter;
     }
 
+    //! Unlike add_tracer, an observer keeps the fast execution paths (no per-instruction tracing, empty code skipped)
+    void set_message_observer(std::optional<MessageObserver> message_observer) {
+      message_observer_ = std::move(message_observer);
+    }
+
     uint64_t get_eos_evm_version()const {
       return eos_evm_version_;
     }
 
+    //! The ancestor hashes (parent first) walked so far on BLOCKHASH, zero for headers not found
+    [[nodiscard]] const std::vector<evmc::bytes32>& walked_block_hashes() const noexcept { return block_hashes_; }
+
   private:
     friend class EvmHost;
 
@@ -144,6 +171,7 @@ class EVM {
 
     evmc_vm* evm1_{nullptr};
     std::optional<FilterFunction> message_filter_;
+    std::optional<MessageObserver> message_observer_;
 
     evmone::gas_parameters gas_params_;
     uint64_t eos_evm_version_=0;
@@ -335,6 +335,42 @@ TEST_CASE("Contract overwrite") {
     CHECK(res.data.empty());
 }
 
+TEST_CASE("BLOCKHASH from preloaded ancestor hashes") {
+    Block block{};
+    block.header.number = 10'000;
+    block.header.parent_hash = 0x01_bytes32;
+
+    evmc::address caller{0x92a1d964b8fc79c5694343cc943c27a94a3be131_address};
+    evmc::address contract_address{0x8b299e2b7d7f43c0ce3068263545309ff4ffb521_address};
+
+    // return BLOCKHASH(NUMBER - 2)
+    InMemoryState db;
+    IntraBlockState state{db};
+    state.set_code(contract_address, *from_hex("600243034060005260206000f3"));
+
+    EVM evm{block, state, kMainnetConfig};
+
+    Transaction txn{};
+    txn.from = caller;
+    txn.to = contract_address;
+
+    SECTION("not in the database") {
+        CallResult res{evm.execute(txn, 100'000, {})};
+        CHECK(res.status == EVMC_SUCCESS);
+        CHECK(res.data == Bytes(32, 0));
+        CHECK(evm.walked_block_hashes() == std::vector<evmc::bytes32>{0x01_bytes32, evmc::bytes32{}});
+    }
+
+    SECTION("preloaded") {
+        const std::vector<evmc::bytes32> block_hashes{0x01_bytes32, 0x02_bytes32};
+        evm.block_hashes = &block_hashes;
+        CallResult res{evm.execute(txn, 100'000, {})};
+        CHECK(res.status == EVMC_SUCCESS);
+        CHECK(res.data == Bytes{ByteView{0x02_bytes32}});
+        CHECK(evm.walked_block_hashes().empty());  // nothing walked
+    }
+}
+
 TEST_CASE("EIP-3541: Reject new contracts starting with the 0xEF byte") {
     const ChainConfig& config{kMainnetConfig};
 
@@ -708,6 +744,41 @@ TEST_CASE("Tracing precompiled contract failure") {
     CHECK(res.status == EVMC_PRECOMPILE_FAILURE);
 }
 
+TEST_CASE("Message observer") {
+    Block block{};
+    block.header.number = 10'336'006;
+
+    InMemoryState db;
+    IntraBlockState state{db};
+    EVM evm{block, state, kMainnetConfig};
+
+    std::vector<std::pair<evmc::address, evmc::address>> frames;
+    evm.set_message_observer([&](const evmc_message& msg) { frames.emplace_back(msg.sender, msg.recipient); });
+
+    evmc::address caller{0x0a6bb546b9208cfab9e8fa2b9b2c042b18df7030_address};
+    evmc::address blake2f_precompile{0x0000000000000000000000000000000000000009_address};
+    evmc::address empty_account{0x5b38da6a701c568545dcfcb03fcb875f56beddc4_address};
+
+    Transaction txn{};
+    txn.from = caller;
+    uint64_t gas{50'000};
+
+    // Creation without code
+    CHECK(evm.execute(txn, gas, {}).status == EVMC_SUCCESS);
+    // Call to an account w/o code, which is still skipped as no tracer is registered
+    txn.to = empty_account;
+    CHECK(evm.execute(txn, gas, {}).status == EVMC_SUCCESS);
+    // Call to a precompile
+    txn.to = blake2f_precompile;
+    CHECK(evm.execute(txn, gas, {}).status == EVMC_PRECOMPILE_FAILURE);
+
+    REQUIRE(frames.size() == 3);
+    CHECK(frames[0] == std::pair{caller, create_address(caller, 0)});
+    CHECK(frames[1] == std::pair{caller, empty_account});
+    CHECK(frames[2] == std::pair{caller, blake2f_precompile});
+    CHECK(evm.tracers().empty());
+}
+
 TEST_CASE("Smart contract creation w/ insufficient balance") {
     Block block{};
     block.header.number = 1;
@@ -24,6 +24,7 @@
 
 #if not defined(ANTELOPE)
 #include <gmp.h>
+#include <atomic>
 #include <bit>
 #endif
 
@@ -31,8 +32,9 @@
 #include <cstring>
 #include <limits>
 
-#include <silkworm/core/crypto/ecdsa.h>
+#include <silkworm/core/crypto/bn254.hpp>
 #include <silkworm/core/crypto/secp256k1n.hpp>
+#include <silkworm/core/crypto/signer_recovery.hpp>
 #include <silkworm/core/types/hash.hpp>
 
 #if defined(ANTELOPE)
@@ -105,17 +107,20 @@ std::optional<Bytes> ecrec_run(ByteView input) noexcept {
         return Bytes{};
     }
 
-    Bytes out(32, 0);
+    SignerRecoveryInput recovery{.odd_y_parity = v != 27};
+    std::memcpy(recovery.message_hash.bytes, &d[0], kHashLength);
+    std::memcpy(recovery.signature.data(), &d[64], recovery.signature.size());
     #if defined(ANTELOPE)
-    if (!silkworm_recover_address(&out[12], &d[0], &d[64], v != 27)) {
-        return Bytes{};
-    }
+    // No process-wide cache in the contract, where nothing survives the action
+    const auto signer{recover_signer(recovery, /*cache=*/nullptr)};
     #else
-    static secp256k1_context* context{secp256k1_context_create(SILKWORM_SECP256K1_CONTEXT_FLAGS)};
-    if (!silkworm_recover_address(&out[12], &d[0], &d[64], v != 27, context)) {
+    const auto signer{recover_signer(recovery)};
+    #endif
+    if (!signer) {
         return Bytes{};
     }
-    #endif
+    Bytes out(32, 0);
+    std::memcpy(&out[12], signer->bytes, kAddressLength);
     return out;
 }
 
@@ -318,6 +323,16 @@ std::optional<Bytes> expmod_run(ByteView input_view) noexcept {
 }
 
 #if not defined(ANTELOPE)
+static std::atomic<Bn254Backend> selected_bn254_backend{Bn254Backend::kNative};
+
+void set_bn254_backend(Bn254Backend backend) noexcept {
+    selected_bn254_backend.store(backend, std::memory_order_relaxed);
+}
+
+Bn254Backend bn254_backend() noexcept {
+    return selected_bn254_backend.load(std::memory_order_relaxed);
+}
+
 // Utility functions for zkSNARK related precompiled contracts.
 // See Yellow Paper, Appendix E "Precompiled Contracts", as well as
 // EIP-196: Precompiled contracts for addition and scalar multiplication on the elliptic curve alt_bn128
@@ -454,6 +469,14 @@ std::optional<Bytes> bn_add_run(ByteView input_view) noexcept {
 
     return out;
     #else
+    if (bn254_backend() == Bn254Backend::kNative) {
+        Bytes out(64, '\0');
+        if (!bn254::add(std::span<uint8_t, 64>{out.data(), 64}, std::span<const uint8_t, 128>{input.data(), 128})) {
+            return std::nullopt;
+        }
+        return out;
+    }
+
     init_libff();
 
     std::optional<libff::alt_bn128_G1> x{decode_g1_element(input.data())};
@@ -491,6 +514,14 @@ std::optional<Bytes> bn_mul_run(ByteView input_view) noexcept {
 
     return out;
     #else
+    if (bn254_backend() == Bn254Backend::kNative) {
+        Bytes out(64, '\0');
+        if (!bn254::mul(std::span<uint8_t, 64>{out.data(), 64}, std::span<const uint8_t, 96>{input.data(), 96})) {
+            return std::nullopt;
+        }
+        return out;
+    }
+
     init_libff();
 
     std::optional<libff::alt_bn128_G1> x{decode_g1_element(input.data())};
@@ -530,6 +561,18 @@ std::optional<Bytes> snarkv_run(ByteView input) noexcept {
     }
     return out;
     #else
+    if (bn254_backend() == Bn254Backend::kNative) {
+        const std::optional<bool> check{bn254::pairing_check(input)};
+        if (!check) {
+            return std::nullopt;
+        }
+        Bytes out(32, '\0');
+        if (*check) {
+            out[31] = 1;
+        }
+        return out;
+    }
+
     init_libff();
     using namespace libff;
 
@@ -50,6 +50,18 @@ uint64_t expmod_gas(ByteView input, evmc_revision) noexcept;
 // EIP-198: Big integer modular exponentiation
 std::optional<Bytes> expmod_run(ByteView input) noexcept;
 
+#ifndef ANTELOPE
+//! \brief Implementations of the alt_bn128 precompiles (0x06, 0x07 and 0x08)
+enum class Bn254Backend {
+    kNative,  // silkworm/core/crypto/bn254.hpp
+    kLibff,   // reference implementation, kept to cross-check the native one
+};
+
+//! \brief Selects the process-wide alt_bn128 backend, kNative by default
+void set_bn254_backend(Bn254Backend backend) noexcept;
+Bn254Backend bn254_backend() noexcept;
+#endif
+
 // EIP-196: Precompiled contracts for addition and scalar multiplication on the elliptic curve alt_bn128
 uint64_t bn_add_gas(ByteView input, evmc_revision) noexcept;
 std::optional<Bytes> bn_add_run(ByteView input) noexcept;
@@ -14,20 +14,165 @@
    limitations under the License.
 */
 
+#include <algorithm>
+#include <vector>
+
 #include <benchmark/benchmark.h>
+#include <secp256k1_recovery.h>
 
 #include <silkworm/core/common/util.hpp>
+#include <silkworm/core/crypto/signer_recovery.hpp>
 #include <silkworm/core/execution/precompile.hpp>
 
+static const silkworm::Bytes kEcRecoveryInput{
+    *silkworm::from_hex("18c547e4f7b0f325ad1e56f57e26c745b09a3e503d86e00e5255ff7f715d3d1c0000000000000000000000000000"
+                        "00000000000000000000000000000000001c73b1693892219d736caba55bdb67216e485557ea6b6af75f37096c9a"
+                        "a6a5a75feeb940b1d03b21e36b0e47e79769f095fe2ab855bd91e3a38756b7d75a9c4549")};
+
 static void ec_recovery(benchmark::State& state) {
     using namespace silkworm;
-    Bytes in{
-        *from_hex("18c547e4f7b0f325ad1e56f57e26c745b09a3e503d86e00e5255ff7f715d3d1c0000000000000000000000000000"
-                  "00000000000000000000000000000000001c73b1693892219d736caba55bdb67216e485557ea6b6af75f37096c9a"
-                  "a6a5a75feeb940b1d03b21e36b0e47e79769f095fe2ab855bd91e3a38756b7d75a9c4549")};
     for (auto _ : state) {
-        precompile::ecrec_run(in);
+        signer_cache().clear();  // always recover, as before the signer cache
+        precompile::ecrec_run(kEcRecoveryInput);
     }
 }
 
 BENCHMARK(ec_recovery);
+
+static void ec_recovery_cached(benchmark::State& state) {
+    using namespace silkworm;
+    for (auto _ : state) {
+        precompile::ecrec_run(kEcRecoveryInput);
+    }
+}
+
+BENCHMARK(ec_recovery_cached);
+
+//! Signatures of count messages where only the first distinct ones are different, signed by different keys
+static std::vector<silkworm::SignerRecoveryInput> signed_inputs(std::size_t count, std::size_t distinct) {
+    using namespace silkworm;
+    secp256k1_context* context{signer_recovery_context()};
+    std::vector<SignerRecoveryInput> inputs;
+    inputs.reserve(count);
+    for (std::size_t i{0}; i < count; ++i) {
+        const uint64_t n{i % distinct + 1};
+        uint8_t private_key[32]{};
+        SignerRecoveryInput input;
+        for (std::size_t j{0}; j < 8; ++j) {
+            private_key[31 - j] = static_cast<uint8_t>(n >> (8 * j));
+            input.message_hash.bytes[j] = static_cast<uint8_t>(n >> (8 * j));
+        }
+        secp256k1_ecdsa_recoverable_signature signature;
+        secp256k1_ecdsa_sign_recoverable(context, &signature, input.message_hash.bytes, private_key, nullptr, nullptr);
+        int recovery_id{0};
+        secp256k1_ecdsa_recoverable_signature_serialize_compact(context, input.signature.data(), &recovery_id,
+                                                                &signature);
+        input.odd_y_parity = recovery_id == 1;
+        inputs.push_back(input);
+    }
+    return inputs;
+}
+
+//! Batch throughput: arguments are the batch size and the percentage of distinct signatures within the batch
+static void ec_recovery_batch(benchmark::State& state) {
+    using namespace silkworm;
+    const auto batch_size{static_cast<std::size_t>(state.range(0))};
+    const auto distinct{std::max<std::size_t>(batch_size * static_cast<std::size_t>(state.range(1)) / 100, 1)};
+    const auto inputs{signed_inputs(batch_size, distinct)};
+    std::vector<std::optional<evmc::address>> signers(batch_size);
+    SignerCache cache{4 * batch_size};  // room for uneven shards
+    for (auto _ : state) {
+        cache.clear();
+        recover_signers(inputs, signers, &cache);
+        benchmark::DoNotOptimize(signers.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(ec_recovery_batch)->Args({16, 100})->Args({256, 100})->Args({256, 50})->Args({256, 10});
+
+//! Batch throughput when the whole batch has been recovered before, e.g. by the Senders stage
+static void ec_recovery_batch_cached(benchmark::State& state) {
+    using namespace silkworm;
+    const auto batch_size{static_cast<std::size_t>(state.range(0))};
+    const auto inputs{signed_inputs(batch_size, batch_size)};
+    std::vector<std::optional<evmc::address>> signers(batch_size);
+    SignerCache cache{4 * batch_size};  // room for uneven shards
+    recover_signers(inputs, signers, &cache);
+    for (auto _ : state) {
+        recover_signers(inputs, signers, &cache);
+        benchmark::DoNotOptimize(signers.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(ec_recovery_batch_cached)->Arg(16)->Arg(256);
+
+static const silkworm::Bytes kBnAddInput{
+    *silkworm::from_hex("00000000000000000000000000000000000000000000000000000000000000010000000000000000000000000000"
+                        "00000000000000000000000000000000000200000000000000000000000000000000000000000000000000000000"
+                        "000000010000000000000000000000000000000000000000000000000000000000000002")};
+
+static const silkworm::Bytes kBnMulInput{
+    *silkworm::from_hex("1a87b0584ce92f4593d161480614f2989035225609f08058ccfa3d0f940febe31a2f3c951f6dadcc7ee"
+                        "9007dff81504b0fcd6d7cf59996efdc33d92bf7f9f8f600000000000000000000000000000000000000"
+                        "00000000000000000000000009")};
+
+// Two pairs passing the check
+static const silkworm::Bytes kSnarkvInput{
+    *silkworm::from_hex("0f25929bcb43d5a57391564615c9e70a992b10eafa4db109709649cf48c50dd216da2f5cb6be7a0aa72c440c53c9"
+                        "bbdfec6c36c7d515536431b3a865468acbba2e89718ad33c8bed92e210e81d1853435399a271913a6520736a4729"
+                        "cf0d51eb01a9e2ffa2e92599b68e44de5bcf354fa2642bd4f26b259daa6f7ce3ed57aeb314a9a87b789a58af499b"
+                        "314e13c3d65bede56c07ea2d418d6874857b70763713178fb49a2d6cd347dc58973ff49613a20757d0fcc22079f9"
+                        "abd10c3baee245901b9e027bd5cfc2cb5db82d4dc9677ac795ec500ecd47deee3b5da006d6d049b811d7511c7815"
+                        "8de484232fc68daf8a45cf217d1c2fae693ff5871e8752d73b21198e9393920d483a7260bfb731fb5d25f1aa4933"
+                        "35a9e71297e485b7aef312c21800deef121f1e76426a00665e5c4479674322d4f75edadd46debd5cd992f6ed0906"
+                        "89d0585ff075ec9e99ad690c3395bc4b313370b38ef355acdadcd122975b12c85ea5db8c6deb4aab71808dcb408f"
+                        "e3d1e7690c43d37b4ce6cc0166fa7daa")};
+
+template <silkworm::precompile::Bn254Backend backend>
+static void bn_add(benchmark::State& state) {
+    using namespace silkworm;
+    precompile::set_bn254_backend(backend);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(precompile::bn_add_run(kBnAddInput));
+    }
+    precompile::set_bn254_backend(precompile::Bn254Backend::kNative);
+}
+
+BENCHMARK_TEMPLATE(bn_add, silkworm::precompile::Bn254Backend::kNative);
+BENCHMARK_TEMPLATE(bn_add, silkworm::precompile::Bn254Backend::kLibff);
+
+template <silkworm::precompile::Bn254Backend backend>
+static void bn_mul(benchmark::State& state) {
+    using namespace silkworm;
+    precompile::set_bn254_backend(backend);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(precompile::bn_mul_run(kBnMulInput));
+    }
+    precompile::set_bn254_backend(precompile::Bn254Backend::kNative);
+}
+
+BENCHMARK_TEMPLATE(bn_mul, silkworm::precompile::Bn254Backend::kNative);
+BENCHMARK_TEMPLATE(bn_mul, silkworm::precompile::Bn254Backend::kLibff);
+
+//! Pairing check of as many pairs as the argument, as in zk-proof verifiers
+template <silkworm::precompile::Bn254Backend backend>
+static void snarkv(benchmark::State& state) {
+    using namespace silkworm;
+    const auto pairs{static_cast<std::size_t>(state.range(0))};
+    Bytes input;
+    while (input.size() < pairs * 192) {
+        input += kSnarkvInput;
+    }
+    input.resize(pairs * 192);
+    precompile::set_bn254_backend(backend);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(precompile::snarkv_run(input));
+    }
+    precompile::set_bn254_backend(precompile::Bn254Backend::kNative);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(snarkv, silkworm::precompile::Bn254Backend::kNative)->Arg(1)->Arg(2)->Arg(4)->Arg(8);
+BENCHMARK_TEMPLATE(snarkv, silkworm::precompile::Bn254Backend::kLibff)->Arg(1)->Arg(2)->Arg(4)->Arg(8);
@@ -16,6 +16,9 @@
 
 #include "precompile.hpp"
 
+#include <string_view>
+#include <utility>
+
 #include <catch2/catch.hpp>
 
 #include <silkworm/core/common/util.hpp>
@@ -177,6 +180,78 @@ TEST_CASE("SNARKV") {
     CHECK(to_hex(*out) == "0000000000000000000000000000000000000000000000000000000000000000");
 }
 
+#ifndef ANTELOPE
+TEST_CASE("BN254 backends agree") {
+    // Valid and invalid inputs alike, the native backend must give the same outputs as libff
+    const std::pair<RunFunction, std::string_view> cases[]{
+        {bn_add_run,
+         "00000000000000000000000000000000000000000000000000000000000000010000000000000000000000000000"
+         "00000000000000000000000000000000000200000000000000000000000000000000000000000000000000000000"
+         "000000010000000000000000000000000000000000000000000000000000000000000002"},
+        {bn_add_run,
+         "00000000000000000000000000000000000000000000000000000000000000010000000000000000000000000000"
+         "00000000000000000000000000000000000300000000000000000000000000000000000000000000000000000000"
+         "000000010000000000000000000000000000000000000000000000000000000000000002"},
+        {bn_add_run,
+         "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+         "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+         "000000010000000000000000000000000000000000000000000000000000000000000002"},
+        {bn_add_run,
+         "00000000000000000000000000000000000000000000000000000000000000010000000000000000000000000000"
+         "000000000000000000000000000000000002"},
+        {bn_mul_run,
+         "00000000000000000000000000000000000000000000000000000000000000010000000000000000000000000000"
+         "00000000000000000000000000000000000230644e72e131a029b85045b68181585d2833e84879b9709143e1f593"
+         "f0000001"},
+        {bn_mul_run,
+         "00000000000000000000000000000000000000000000000000000000000000010000000000000000000000000000"
+         "000000000000000000000000000000000002ffffffffffffffffffffffffffffffffffffffffffffffffffffffff"
+         "ffffffff"},
+        {bn_mul_run,
+         "00000000000000000000000000000000000000000000000000000000000000010000000000000000000000000000"
+         "00000000000000000000000000000000000300000000000000000000000000000000000000000000000000000000"
+         "00000002"},
+        {snarkv_run,
+         "26d3c1aa68131658b740c72c6834342a0168d15c126103fd6aa1fcb116bb4695231d5044b8b91de5a356320e905a"
+         "84f3c70b1811c31488cb86dad2085ee3bda727db5aea449052a99b0d19de9068631a8319dd0cc03e6009b8680314"
+         "fb42c26c21e34e75b42c9c45a28b166a5a5cb294dc6de2193790accaa73f50a0a010db962b7c270ff1858db07b3b"
+         "a5a2f2f0189ff8bae222eea32fe5535370f60eaeb0000ae571410a9ad479dc61cc794816f9c81057b56d5d71517e"
+         "2f2d7d8ffc7ad70b0000000000000000000000000000000000000000000000000000000000000001000000000000"
+         "000000000000000000000000000000000000000000000000000217666990c132ef29b82c2e8e62488f719ef8ebf6"
+         "c3b36fcc2302476fdd402fbf146d9e84cf93bca44a5b360478e0e1aece43cfaa480c744c0e6b9a5857ca0a8f1180"
+         "3a4536c6775dd9326da61d89489cc400d896382f05f69c228dd234216a120cc0684bcbf3af5572ccc1c975770341"
+         "bcf9c8071c52750bb417855e86566cda0ccf3e3c5ca9fe72f6f8921baa6460df3838d8d142b97d54e0078e13aff6"
+         "41df2f078db758ef7a553d81a1e924f2ee2c4fec1a561997394b806ba84c3fd86480198e9393920d483a7260bfb7"
+         "31fb5d25f1aa493335a9e71297e485b7aef312c21800deef121f1e76426a00665e5c4479674322d4f75edadd46de"
+         "bd5cd992f6ed090689d0585ff075ec9e99ad690c3395bc4b313370b38ef355acdadcd122975b12c85ea5db8c6deb"
+         "4aab71808dcb408fe3d1e7690c43d37b4ce6cc0166fa7daa"},
+        {snarkv_run,
+         "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+         "00000000000000000000000000000000000027db5aea449052a99b0d19de9068631a8319dd0cc03e6009b8680314"
+         "fb42c26c21e34e75b42c9c45a28b166a5a5cb294dc6de2193790accaa73f50a0a010db962b7c270ff1858db07b3b"
+         "a5a2f2f0189ff8bae222eea32fe5535370f60eaeb0000ae571410a9ad479dc61cc794816f9c81057b56d5d71517e"
+         "2f2d7d8ffc7ad70b26d3c1aa68131658b740c72c6834342a0168d15c126103fd6aa1fcb116bb4695231d5044b8b9"
+         "1de5a356320e905a84f3c70b1811c31488cb86dad2085ee3bda70000000000000000000000000000000000000000"
+         "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+         "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+         "00000000000000000000000000000000"},
+        {snarkv_run,
+         "26d3c1aa68131658b740c72c6834342a0168d15c126103fd6aa1fcb116bb4695231d5044b8b91de5a356320e905a"
+         "84f3c70b1811c31488cb86dad2085ee3bda700000000000000000000000000000000000000000000000000000000"
+         "0000000000000000000000000000000000000000000000000000000000000000000000010d1271953ed9ea083684"
+         "6e70a1934187998c7f790cb4d7511b7f8da82de048a42869111d5381f072f8e2728fdb825a51aadd70e52c9830e9"
+         "ab4b871c0531f1bb"},
+    };
+    for (const auto& [run, hex] : cases) {
+        const Bytes in{*from_hex(hex)};
+        set_bn254_backend(Bn254Backend::kLibff);
+        const std::optional<Bytes> expected{run(in)};
+        set_bn254_backend(Bn254Backend::kNative);
+        CHECK(run(in) == expected);
+    }
+}
+#endif
+
 // https://eips.ethereum.org/EIPS/eip-152#test-cases
 TEST_CASE("BLAKE2") {
     Bytes in{
@@ -17,18 +17,61 @@
 #include "prefix_set.hpp"
 
 #include <algorithm>
+#include <array>
+#include <cstring>
+#include <iterator>
+#include <utility>
 
 namespace silkworm::trie {
 
-void PrefixSet::insert(ByteView key, bool marker) { insert(Bytes(key), marker); }
+//! Sets (or runs of keys sharing a prefix) smaller than this are sorted by comparison
+static constexpr size_t kRadixSortThreshold{256};
 
-void PrefixSet::insert(Bytes&& key, bool marker) {
-    keys_.emplace_back(key, marker);
+//! Stable LSD radix sort of the items on a 64-bit key, one byte per pass, skipping the passes where all the keys share
+//! the digit
+template <typename T, typename Key>
+static void radix_sort(std::vector<T>& items, std::vector<T>& buffer, Key key) {
+    for (unsigned shift{0}; shift < 64; shift += 8) {
+        std::array<size_t, 256> offsets{};
+        for (const auto& item : items) {
+            ++offsets[(key(item) >> shift) & 0xff];
+        }
+        if (std::find(offsets.begin(), offsets.end(), items.size()) != offsets.end()) {
+            continue;
+        }
+        size_t offset{0};
+        for (auto& count : offsets) {
+            offset += std::exchange(count, offset);
+        }
+        for (auto& item : items) {
+            buffer[offsets[(key(item) >> shift) & 0xff]++] = std::move(item);
+        }
+        items.swap(buffer);
+    }
+}
+
+void PrefixSet::insert(ByteView key, bool marker) {
+    // Bytes up to the last one which is not a nibble are stored as they are
+    size_t raw_length{key.length()};
+    while (raw_length > 0 && key[raw_length - 1] < 0x10) {
+        --raw_length;
+    }
+    const size_t nibbles_length{key.length() - raw_length};
+
+    entries_.push_back({fixed_prefix(key), arena_.length(), static_cast<uint16_t>(raw_length),
+                        static_cast<uint16_t>(nibbles_length), marker});
+    arena_.append(key.substr(0, raw_length));
+    for (size_t i{raw_length}; i < key.length(); i += 2) {
+        const uint8_t low{i + 1 < key.length() ? key[i + 1] : uint8_t{0}};
+        arena_.push_back(static_cast<uint8_t>(key[i] << 4 | low));
+    }
     sorted_ = false;
 }
 
+void PrefixSet::insert(Bytes&& key, bool marker) { insert(ByteView{key}, marker); }
+
 bool PrefixSet::contains(ByteView prefix) {
-    if (keys_.empty()) {
+    if (entries_.empty()) {
         return false;
     }
 
@@ -38,51 +81,246 @@ bool PrefixSet::contains(ByteView prefix) {
     // We optimize for the case when contains() queries are issued with increasing prefixes,
     // e.g. contains("00"), contains("04"), contains("0b"), contains("0b05"), contains("0c"), contains("0f"), ...
     // instead of some random order.
-    while (index_ > 0 && keys_[index_].first > prefix) {
-        --index_;
-    }
-
-    for (size_t max_index{keys_.size() - 1};; ++index_) {
-        const auto& [key, _]{keys_[index_]};
-        if (key.starts_with(prefix)) {
-            return true;
-        }
-        if (key > prefix || index_ == max_index) {
-            return false;
-        }
-    }
+    index_ = std::min(lower_bound(prefix), entries_.size() - 1);
+    return compare(entries_[index_], prefix, /*prefix_only=*/true) == 0;
 }
 
 std::pair<bool, ByteView> PrefixSet::contains_and_next_marked(ByteView prefix, size_t invariant_prefix_len) {
     bool is_contained{contains(prefix)};
     ByteView next_created{};
+    if (entries_.empty()) {
+        return {is_contained, next_created};
+    }
 
     invariant_prefix_len = std::min(invariant_prefix_len, prefix.size());
 
-    // Lookup next marked created key
-    for (size_t i{index_}, e{keys_.size()}; i < e; ++i) {
-        auto& item{keys_[i]};
+    // Lookup next marked created key: keys sharing the invariant part of the prefix are contiguous and the first
+    // one (if any) is at index_
+    if (const uint32_t rank{next_marked_[index_]}; rank + 1 < marked_offsets_.size()) {
+        const ByteView marked{marked_keys_.data() + marked_offsets_[rank],
+                              marked_offsets_[rank + 1] - marked_offsets_[rank]};
 
         // Check we're in the same invariant part of the prefix
-        if (invariant_prefix_len && std::memcmp(&prefix[0], &item.first[0], invariant_prefix_len) != 0) {
-            break;
+        if (!invariant_prefix_len || (marked.size() >= invariant_prefix_len &&
+                                      std::memcmp(prefix.data(), marked.data(), invariant_prefix_len) == 0)) {
+            next_created = marked;
         }
+    }
 
-        if (item.second) {
-            next_created = ByteView(item.first);
-            break;
+    return {is_contained, next_created};
+}
+
+uint64_t PrefixSet::fixed_prefix(ByteView key) noexcept {
+    uint64_t prefix{0};
+    for (size_t i{0}, e{std::min<size_t>(key.length(), sizeof(uint64_t))}; i < e; ++i) {
+        prefix |= static_cast<uint64_t>(key[i]) << (56 - 8 * i);
+    }
+    return prefix;
+}
+
+uint64_t PrefixSet::fixed_prefix(const Entry& entry, size_t depth) const noexcept {
+    if (depth == 0) {
+        return entry.prefix;
+    }
+    uint64_t prefix{0};
+    const size_t length{size_t{entry.raw_length} + entry.nibbles_length};
+    for (size_t i{depth * sizeof(uint64_t)}, e{std::min(length, i + sizeof(uint64_t))}, shift{56}; i < e;
+         ++i, shift -= 8) {
+        prefix |= static_cast<uint64_t>(byte_at(entry, i)) << shift;
+    }
+    return prefix;
+}
+
+uint8_t PrefixSet::byte_at(const Entry& entry, size_t i) const noexcept {
+    if (i < entry.raw_length) {
+        return arena_[entry.offset + i];
+    }
+    const size_t j{i - entry.raw_length};
+    const uint8_t byte{arena_[entry.offset + entry.raw_length + j / 2]};
+    return static_cast<uint8_t>(j % 2 ? byte & 0x0f : byte >> 4);
+}
+
+int PrefixSet::compare(const Entry& lhs, const Entry& rhs) const noexcept {
+    const size_t lhs_length{size_t{lhs.raw_length} + lhs.nibbles_length};
+    const size_t rhs_length{size_t{rhs.raw_length} + rhs.nibbles_length};
+    for (size_t i{0}, e{std::min(lhs_length, rhs_length)}; i < e; ++i) {
+        const uint8_t lhs_byte{byte_at(lhs, i)}, rhs_byte{byte_at(rhs, i)};
+        if (lhs_byte != rhs_byte) {
+            return lhs_byte < rhs_byte ? -1 : 1;
         }
     }
+    return lhs_length < rhs_length ? -1 : (lhs_length > rhs_length ? 1 : 0);
+}
 
-    return {is_contained, next_created};
+int PrefixSet::compare(const Entry& entry, ByteView key, bool prefix_only) const noexcept {
+    const uint8_t* data{&arena_[entry.offset]};
+    const size_t length{static_cast<size_t>(entry.raw_length) + entry.nibbles_length};
+    const size_t common_length{std::min(length, key.length())};
+    const size_t raw_length{std::min<size_t>(entry.raw_length, common_length)};
+    if (raw_length) {
+        if (const int diff{std::memcmp(data, key.data(), raw_length)}; diff != 0) {
+            return diff;
+        }
+    }
+    const uint8_t* nibbles{data + entry.raw_length};
+    for (size_t i{raw_length}; i < common_length; ++i) {
+        const size_t j{i - entry.raw_length};
+        const auto nibble{static_cast<uint8_t>(j % 2 ? nibbles[j / 2] & 0x0f : nibbles[j / 2] >> 4)};
+        if (nibble != key[i]) {
+            return nibble < key[i] ? -1 : 1;
+        }
+    }
+    if (length < key.length()) {
+        return -1;
+    }
+    return length > key.length() && !prefix_only ? 1 : 0;
+}
+
+size_t PrefixSet::encoded_length(const Entry& entry) const noexcept {
+    return entry.raw_length + (entry.nibbles_length + 1u) / 2;
+}
+
+void PrefixSet::unpack(const Entry& entry, Bytes& key) const {
+    const uint8_t* data{&arena_[entry.offset]};
+    key.assign(data, entry.raw_length);
+    for (size_t j{0}; j < entry.nibbles_length; ++j) {
+        const uint8_t byte{data[entry.raw_length + j / 2]};
+        key.push_back(static_cast<uint8_t>(j % 2 ? byte & 0x0f : byte >> 4));
+    }
+}
+
+size_t PrefixSet::lower_bound(ByteView key) const noexcept {
+    const uint64_t key_prefix{fixed_prefix(key)};
+    const auto less = [&](const Entry& entry) {
+        // The fixed-width prefixes decide unless equal
+        return entry.prefix != key_prefix ? entry.prefix < key_prefix : compare(entry, key) < 0;
+    };
+
+    // Gallop from the last compared key towards the searched one, then binary search within the last step
+    const size_t size{entries_.size()};
+    size_t first{index_}, last{index_};
+    if (index_ < size && less(entries_[index_])) {
+        size_t step{1};
+        first = index_ + 1;
+        while (index_ + step < size && less(entries_[index_ + step])) {
+            first = index_ + step + 1;
+            step *= 2;
+        }
+        last = std::min(index_ + step, size);
+    } else {
+        size_t step{1};
+        first = 0;
+        while (step <= index_ && !less(entries_[index_ - step])) {
+            last = index_ - step;
+            step *= 2;
+        }
+        if (step <= index_) {
+            first = index_ - step + 1;
+        }
+    }
+    const auto begin{entries_.begin()};
+    return static_cast<size_t>(std::partition_point(begin + static_cast<std::ptrdiff_t>(first),
+                                                    begin + static_cast<std::ptrdiff_t>(last), less) -
+                               begin);
 }
 
 void PrefixSet::ensure_sorted() {
-    if (!sorted_) {
-        std::sort(keys_.begin(), keys_.end());
-        keys_.erase(std::unique(keys_.begin(), keys_.end()), keys_.end());
-        sorted_ = true;
+    if (sorted_) {
+        return;
+    }
+
+    if (entries_.size() < kRadixSortThreshold) {
+        std::sort(entries_.begin(), entries_.end(),
+                  [this](const Entry& lhs, const Entry& rhs) { return compare(lhs, rhs) < 0; });
+    } else {
+        std::vector<Entry> buffer(entries_.size());
+        radix_sort(entries_, buffer, [](const Entry& entry) { return entry.prefix; });
+        sort_ties(0, entries_.size(), 0);
+    }
+
+    // Compact the arena in key order merging duplicates, then unpack the marked keys
+    Bytes arena;
+    arena.reserve(arena_.length());
+    size_t count{0};
+    for (const auto& entry : entries_) {
+        const ByteView encoded{&arena_[entry.offset], encoded_length(entry)};
+        if (count > 0) {
+            auto& previous{entries_[count - 1]};
+            if (previous.raw_length == entry.raw_length && previous.nibbles_length == entry.nibbles_length &&
+                ByteView{&arena[previous.offset], encoded.length()} == encoded) {
+                previous.marker = previous.marker || entry.marker;
+                continue;
+            }
+        }
+        Entry& compacted{entries_[count++]};
+        compacted = entry;
+        compacted.offset = arena.length();
+        arena.append(encoded);
+    }
+    entries_.resize(count);
+    arena_ = std::move(arena);
+
+    // Rank of the next marked key for each entry, the count of marked keys if none
+    Bytes key;
+    marked_keys_.clear();
+    marked_offsets_.assign(1, 0);
+    next_marked_.resize(count);
+    for (size_t i{0}; i < count; ++i) {
+        if (entries_[i].marker) {
+            next_marked_[i] = static_cast<uint32_t>(marked_offsets_.size() - 1);
+            unpack(entries_[i], key);
+            marked_keys_.append(key);
+            marked_offsets_.push_back(marked_keys_.length());
+        }
+    }
+    for (size_t i{count}, next{marked_offsets_.size() - 1}; i > 0; --i) {
+        if (entries_[i - 1].marker) {
+            next = next_marked_[i - 1];
+        }
+        next_marked_[i - 1] = static_cast<uint32_t>(next);
+    }
+
+    index_ = 0;
+    sorted_ = true;
+}
+
+void PrefixSet::sort_ties(size_t first, size_t last, size_t depth) {
+    while (first < last) {
+        const uint64_t chunk{fixed_prefix(entries_[first], depth)};
+        size_t run_last{first + 1};
+        while (run_last < last && fixed_prefix(entries_[run_last], depth) == chunk) {
+            ++run_last;
+        }
+        if (run_last - first > 1) {
+            sort_run(first, run_last, depth + 1);
+        }
+        first = run_last;
     }
 }
 
+void PrefixSet::sort_run(size_t first, size_t last, size_t depth) {
+    const auto begin{entries_.begin() + static_cast<std::ptrdiff_t>(first)};
+    const auto end{entries_.begin() + static_cast<std::ptrdiff_t>(last)};
+    if (last - first < kRadixSortThreshold) {
+        std::sort(begin, end, [this](const Entry& lhs, const Entry& rhs) { return compare(lhs, rhs) < 0; });
+        return;
+    }
+
+    // Keys no longer than the chunks they share only differ by their length
+    const auto length = [](const Entry& entry) { return size_t{entry.raw_length} + entry.nibbles_length; };
+    if (std::all_of(begin, end, [&](const Entry& entry) { return length(entry) <= depth * sizeof(uint64_t); })) {
+        std::sort(begin, end, [&](const Entry& lhs, const Entry& rhs) { return length(lhs) < length(rhs); });
+        return;
+    }
+
+    // Otherwise sort on the next chunk, e.g. past the storage prefix shared by the keys of one account
+    std::vector<std::pair<uint64_t, Entry>> run, buffer(last - first);
+    run.reserve(last - first);
+    std::transform(begin, end, std::back_inserter(run),
+                   [&](const Entry& entry) { return std::make_pair(fixed_prefix(entry, depth), entry); });
+    radix_sort(run, buffer, [](const std::pair<uint64_t, Entry>& item) { return item.first; });
+    std::transform(run.begin(), run.end(), begin, [](const std::pair<uint64_t, Entry>& item) { return item.second; });
+    sort_ties(first, last, depth);
+}
+
 }  // namespace silkworm::trie
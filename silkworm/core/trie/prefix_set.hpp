@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <cstdint>
+#include <utility>
 #include <vector>
 
 #include <silkworm/core/common/base.hpp>
@@ -26,6 +28,11 @@ namespace silkworm::trie {
  * A set of "nibbled" byte strings with the following property:
  *  If x ∈ S and x starts with y, then y ∈ S.
  *  Corresponds to RetainList in Erigon.
+ *
+ * Keys are stored in one contiguous arena: the bytes up to the last one which is not a nibble (e.g. the storage
+ * prefix) as they are, the trailing nibbles packed two per byte. Sorting is lazy: a radix sort on the fixed-width
+ * prefix of the keys (ties broken by full comparison), then the arena is compacted in key order. Queries issued with
+ * increasing prefixes gallop from the position of the previous one.
  */
 class PrefixSet {
   public:
@@ -49,23 +56,64 @@ class PrefixSet {
     //! \param [in] prefix : the prefix to search for
     //! \param [in] invariant_prefix_len : when searching for next marked the scanned items must begin with this number
     //! of identical bytes
+    //! \remarks The returned key is valid until the set is modified
     std::pair<bool, ByteView> contains_and_next_marked(ByteView prefix, size_t invariant_prefix_len = 0);
 
-    [[nodiscard]] size_t size() const { return keys_.size(); }
-    [[nodiscard]] bool empty() const { return keys_.empty(); }
+    [[nodiscard]] size_t size() const { return entries_.size(); }
+    [[nodiscard]] bool empty() const { return entries_.empty(); }
 
     void clear() noexcept {
-        keys_.clear();
+        arena_.clear();
+        entries_.clear();
+        next_marked_.clear();
+        marked_keys_.clear();
+        marked_offsets_.clear();
         index_ = 0;
         sorted_ = false;
     }
 
   private:
+    struct Entry {
+        uint64_t prefix{0};          // First 8 bytes of the key (zero padded) as big-endian, the sort key
+        uint64_t offset{0};          // Offset of the encoded key in arena_
+        uint16_t raw_length{0};      // Number of leading bytes stored as they are
+        uint16_t nibbles_length{0};  // Number of trailing nibbles stored packed
+        bool marker{false};          // Whether the key is marked as newly created
+    };
+
+    [[nodiscard]] static uint64_t fixed_prefix(ByteView key) noexcept;
+
+    //! \brief The 8 bytes of the entry key (zero padded) starting at depth * 8 as big-endian
+    [[nodiscard]] uint64_t fixed_prefix(const Entry& entry, size_t depth) const noexcept;
+    [[nodiscard]] uint8_t byte_at(const Entry& entry, size_t i) const noexcept;
+
+    //! \brief Lexicographic comparison of the entry keys (<0, 0, >0)
+    [[nodiscard]] int compare(const Entry& lhs, const Entry& rhs) const noexcept;
+
+    //! \brief Lexicographic comparison of the entry key with the provided one (<0, 0, >0)
+    //! \param [in] prefix_only : whether an entry key starting with the provided one compares equal
+    [[nodiscard]] int compare(const Entry& entry, ByteView key, bool prefix_only = false) const noexcept;
+    [[nodiscard]] size_t encoded_length(const Entry& entry) const noexcept;
+    void unpack(const Entry& entry, Bytes& key) const;
+
+    //! \brief Index of the first entry not less than the key, searched by galloping from index_
+    [[nodiscard]] size_t lower_bound(ByteView key) const noexcept;
+
     void ensure_sorted();
 
-    std::vector<std::pair<Bytes, bool>> keys_;  // Collection of nibbled keys with marker of newly created
-    size_t index_{0};                           // Index of last compared key
-    bool sorted_{false};                        // Whether nibbled_keys_ has been unique-ed and sorted
+    //! \brief Sorts the runs of entries in [first, last) sharing the chunk at depth (see fixed_prefix)
+    void sort_ties(size_t first, size_t last, size_t depth);
+
+    //! \brief Sorts the entries in [first, last) sharing the chunks before depth
+    void sort_run(size_t first, size_t last, size_t depth);
+
+    Bytes arena_;                           // Encoded keys
+    std::vector<Entry> entries_;            // Collection of keys with marker of newly created
+    std::vector<uint32_t> next_marked_;     // Rank of the next marked key for each entry (once sorted)
+    Bytes marked_keys_;                     // Marked keys, unpacked to be returned as views
+    std::vector<uint64_t> marked_offsets_;  // Offsets of the marked keys in marked_keys_ (plus end)
+    size_t index_{0};                       // Index of last compared key
+    bool sorted_{false};                    // Whether entries_ has been unique-ed and sorted
 };
 
 }  // namespace silkworm::trie
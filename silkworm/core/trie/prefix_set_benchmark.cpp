@@ -0,0 +1,92 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <silkworm/core/trie/prefix_set.hpp>
+
+//! Change set as gathered by InterHashes: hashed keys as nibbles, storage ones after the storage prefix of the few
+//! accounts holding most of the changed slots
+static std::vector<silkworm::Bytes> changed_keys(std::size_t count, bool storage) {
+    using namespace silkworm;
+    std::mt19937_64 rng{count};
+    std::vector<Bytes> prefixes(storage ? 64 : 1);
+    for (auto& prefix : prefixes) {
+        prefix.resize(storage ? 40 : 0);
+        std::generate(prefix.begin(), prefix.end(), [&]() { return static_cast<uint8_t>(rng()); });
+    }
+    std::vector<Bytes> keys;
+    keys.reserve(count);
+    for (std::size_t i{0}; i < count; ++i) {
+        Bytes key{prefixes[rng() % prefixes.size()]};
+        for (std::size_t j{0}; j < 64; ++j) {
+            key.push_back(static_cast<uint8_t>(rng() & 0x0f));
+        }
+        keys.push_back(std::move(key));
+    }
+    return keys;
+}
+
+static void prefix_set_build(benchmark::State& state) {
+    using namespace silkworm;
+    const auto keys{changed_keys(static_cast<std::size_t>(state.range(0)), state.range(1) != 0)};
+    for (auto _ : state) {
+        trie::PrefixSet ps;
+        for (const auto& key : keys) {
+            ps.insert(key, /*marker=*/key.back() == 0);
+        }
+        benchmark::DoNotOptimize(ps.contains(keys.front()));  // Sorts
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(prefix_set_build)->ArgsProduct({{10'000, 1'000'000}, {0, 1}})->Unit(benchmark::kMillisecond);
+
+//! Queries as issued by TrieCursor: increasing prefixes of the changed keys, each followed by its siblings
+static void prefix_set_increasing_queries(benchmark::State& state) {
+    using namespace silkworm;
+    auto keys{changed_keys(static_cast<std::size_t>(state.range(0)), state.range(1) != 0)};
+    trie::PrefixSet ps;
+    for (const auto& key : keys) {
+        ps.insert(key, /*marker=*/key.back() == 0);
+    }
+    std::sort(keys.begin(), keys.end());
+    const std::size_t invariant_prefix_len{state.range(1) != 0 ? 40u : 0u};
+
+    std::vector<Bytes> queries;
+    for (std::size_t i{0}; i < keys.size(); i += 16) {
+        for (std::size_t length{invariant_prefix_len + 1}; length < invariant_prefix_len + 8; ++length) {
+            Bytes query{keys[i].substr(0, length)};
+            queries.push_back(query);
+            query.back() = static_cast<uint8_t>((query.back() + 1) & 0x0f);
+            queries.push_back(std::move(query));
+        }
+    }
+    std::sort(queries.begin(), queries.end());
+
+    for (auto _ : state) {
+        for (const auto& query : queries) {
+            benchmark::DoNotOptimize(ps.contains_and_next_marked(query, invariant_prefix_len));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(queries.size()));
+}
+
+BENCHMARK(prefix_set_increasing_queries)->ArgsProduct({{10'000, 1'000'000}, {0, 1}});
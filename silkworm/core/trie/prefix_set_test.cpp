@@ -16,6 +16,10 @@
 
 #include "prefix_set.hpp"
 
+#include <algorithm>
+#include <map>
+#include <random>
+
 #include <catch2/catch.hpp>
 
 #include <silkworm/core/common/cast.hpp>
@@ -108,4 +112,90 @@ TEST_CASE("Prefix set - storage prefix") {
     }
 }
 
+TEST_CASE("Prefix set - compact vs reference") {
+    std::mt19937_64 rng{42};
+    const auto random_nibbles = [&](size_t length) {
+        Bytes nibbles(length, '\0');
+        for (auto& nibble : nibbles) {
+            nibble = static_cast<uint8_t>(rng() & 0x0f);
+        }
+        return nibbles;
+    };
+
+    // Both nibbled keys and storage keys (i.e. raw prefix followed by nibbles), many more than the radix sort threshold
+    std::vector<Bytes> prefixes;
+    for (size_t i{0}; i < 8; ++i) {
+        Bytes prefix(40, '\0');
+        for (auto& byte : prefix) {
+            byte = static_cast<uint8_t>(rng());
+        }
+        prefixes.push_back(prefix);
+    }
+    PrefixSet ps;
+    std::map<Bytes, bool> reference;
+    for (size_t i{0}; i < 10'000; ++i) {
+        Bytes key{i % 2 ? prefixes[rng() % prefixes.size()] : Bytes{}};
+        key.append(random_nibbles(rng() % 65));
+        const bool marker{rng() % 5 == 0};
+        ps.insert(key, marker);
+        reference[key] = reference[key] || marker;
+        if (i % 7 == 0) {
+            ps.insert(key, !marker);  // duplicate
+            reference[key] = true;
+        }
+    }
+
+    const auto check = [&](ByteView prefix, size_t invariant_prefix_len) {
+        auto it{reference.lower_bound(Bytes{prefix})};
+        const bool expected_contains{it != reference.end() && it->first.starts_with(prefix)};
+        if (it == reference.end()) {
+            --it;
+        }
+        ByteView expected_next{};
+        const ByteView invariant{prefix.substr(0, invariant_prefix_len)};
+        for (; it != reference.end() && it->first.starts_with(invariant); ++it) {
+            if (it->second) {
+                expected_next = it->first;
+                break;
+            }
+        }
+        const auto [contains, next_created]{ps.contains_and_next_marked(prefix, invariant_prefix_len)};
+        CHECK(contains == expected_contains);
+        CHECK(next_created == expected_next);
+    };
+
+    std::vector<Bytes> queries;
+    for (size_t i{0}; i < 2'000; ++i) {
+        Bytes query{rng() % 2 ? prefixes[rng() % prefixes.size()] : Bytes{}};
+        query.append(random_nibbles(rng() % 6));
+        queries.push_back(query);
+    }
+    for (const auto& [key, _] : reference) {
+        if (rng() % 20 == 0) {
+            queries.push_back(key.substr(0, key.length() - rng() % (key.length() + 1)));
+        }
+    }
+
+    SECTION("increasing prefixes") {
+        std::sort(queries.begin(), queries.end());
+        for (const auto& query : queries) {
+            check(query, query.length() >= 40 ? 40 : 0);
+        }
+    }
+    SECTION("random prefixes") {
+        for (const auto& query : queries) {
+            check(query, 0);
+        }
+    }
+    SECTION("insert after queries") {
+        check(queries.front(), 0);
+        const Bytes key{random_nibbles(64)};
+        ps.insert(key, true);
+        reference[key] = true;
+        for (const auto& query : queries) {
+            check(query, 0);
+        }
+    }
+}
+
 }  // namespace silkworm::trie
@@ -79,8 +79,25 @@ std::optional<intx::uint256> BlockHeader::data_gas_price() const {
 
 //! \brief Recover transaction senders for each block.
 void Block::recover_senders() {
+    // Recover all pending senders in one batch, the special signatures directly
+    std::vector<Transaction*> pending;
+    std::vector<SignerRecoveryInput> inputs;
     for (Transaction& txn : transactions) {
-        txn.recover_sender();
+        if (txn.from.has_value()) {
+            continue;
+        }
+        if (is_special_signature(txn.r, txn.s)) {
+            txn.recover_sender();
+            continue;
+        }
+        pending.push_back(&txn);
+        inputs.push_back(txn.signer_recovery_input());
+    }
+
+    std::vector<std::optional<evmc::address>> senders(inputs.size());
+    recover_signers(inputs, senders);
+    for (std::size_t i{0}; i < pending.size(); ++i) {
+        pending[i]->from = senders[i];
     }
 }
 
@@ -16,11 +16,12 @@
 
 #include "transaction.hpp"
 
+#include <cstring>
+
 #include <ethash/keccak.hpp>
 
 #include <silkworm/core/common/cast.hpp>
 #include <silkworm/core/common/util.hpp>
-#include <silkworm/core/crypto/ecdsa.h>
 #include <silkworm/core/protocol/param.hpp>
 #include <silkworm/core/rlp/decode_vector.hpp>
 #include <silkworm/core/rlp/encode_vector.hpp>
@@ -416,6 +417,18 @@ void UnsignedTransaction::encode_for_signing(Bytes& into) const {
     }
 }
 
+SignerRecoveryInput Transaction::signer_recovery_input() const {
+    Bytes rlp{};
+    encode_for_signing(rlp);
+    const ethash::hash256 hash{keccak256(rlp)};
+
+    SignerRecoveryInput input{.odd_y_parity = odd_y_parity};
+    std::memcpy(input.message_hash.bytes, hash.bytes, kHashLength);
+    intx::be::unsafe::store(input.signature.data(), r);
+    intx::be::unsafe::store(input.signature.data() + kHashLength, s);
+    return input;
+}
+
 void Transaction::recover_sender() {
     if (from.has_value()) {
         return;
@@ -426,25 +439,7 @@ void Transaction::recover_sender() {
         return;
     }
 
-    Bytes rlp{};
-    encode_for_signing(rlp);
-    ethash::hash256 hash{keccak256(rlp)};
-
-    uint8_t signature[kHashLength * 2];
-    intx::be::unsafe::store(signature, r);
-    intx::be::unsafe::store(signature + kHashLength, s);
-
-    from = evmc::address{};
-    #if defined(ANTELOPE)
-    if (!silkworm_recover_address(from->bytes, hash.bytes, signature, odd_y_parity)) {
-        from = std::nullopt;
-    }
-    #else
-    static secp256k1_context* context{secp256k1_context_create(SILKWORM_SECP256K1_CONTEXT_FLAGS)};
-    if (!silkworm_recover_address(from->bytes, hash.bytes, signature, odd_y_parity, context)) {
-        from = std::nullopt;
-    }
-    #endif
+    from = recover_signer(signer_recovery_input());
 }
 
 intx::uint512 UnsignedTransaction::maximum_gas_cost() const {
@@ -22,6 +22,7 @@
 #include <intx/intx.hpp>
 
 #include <silkworm/core/common/base.hpp>
+#include <silkworm/core/crypto/signer_recovery.hpp>
 #include <silkworm/core/rlp/decode.hpp>
 #include <silkworm/core/types/hash.hpp>
 
@@ -95,6 +96,10 @@ struct Transaction : public UnsignedTransaction {
     //! If recovery fails the from field is set to null.
     void recover_sender();
 
+    //! \brief The signing hash and signature to recover the sender from, e.g. in batch with other transactions
+    //! \remarks Not meaningful for special signatures (see is_special_signature)
+    [[nodiscard]] SignerRecoveryInput signer_recovery_input() const;
+
     [[nodiscard]] evmc::bytes32 hash() const;
 };
 
@@ -16,6 +16,11 @@
 
 #include "log.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <condition_variable>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <mutex>
@@ -31,17 +36,135 @@ namespace silkworm::log {
 //! The fixed size for thread name in log traces
 constexpr auto kThreadNameFixedSize{11};
 
+//! Fixed-size part of each record in the asynchronous buffers, followed by the line content
+struct RecordHeader {
+    uint32_t size{0};
+    Level level{Level::kNone};
+    std::chrono::system_clock::time_point timestamp;
+};
+
+//! \brief Single-producer single-consumer ring of variable-size records filled by one logging thread
+class RecordRing {
+  public:
+    explicit RecordRing(std::size_t capacity) : buffer_(std::bit_ceil(std::max(capacity, std::size_t{4'096}))) {}
+
+    //! Longer lines are truncated, so that a line can always fit once the ring is drained
+    [[nodiscard]] std::size_t max_content_size() const { return buffer_.size() / 4; }
+
+    //! \brief Producer side: copies the record into the ring unless there is not enough room
+    bool try_push(const RecordHeader& header, std::string_view content) {
+        const std::size_t tail{tail_.load(std::memory_order_relaxed)};
+        const std::size_t head{head_.load(std::memory_order_acquire)};
+        if (buffer_.size() - (tail - head) < sizeof(RecordHeader) + content.size()) {
+            return false;
+        }
+        write(tail, &header, sizeof(RecordHeader));
+        write(tail + sizeof(RecordHeader), content.data(), content.size());
+        tail_.store(tail + sizeof(RecordHeader) + content.size(), std::memory_order_release);
+        return true;
+    }
+
+    //! \brief Consumer side: moves all the records available into the batch
+    template <typename Batch>
+    void drain(Batch& batch) {
+        std::size_t head{head_.load(std::memory_order_relaxed)};
+        const std::size_t tail{tail_.load(std::memory_order_acquire)};
+        while (head != tail) {
+            auto& [header, content] = batch.emplace_back();
+            read(head, &header, sizeof(RecordHeader));
+            content.resize(header.size);
+            read(head + sizeof(RecordHeader), content.data(), content.size());
+            head += sizeof(RecordHeader) + header.size;
+        }
+        head_.store(head, std::memory_order_release);
+    }
+
+    [[nodiscard]] bool empty() const {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+    //! Set when the owner thread exits, so that the ring can be dropped once drained
+    std::atomic_bool abandoned{false};
+
+  private:
+    void write(std::size_t position, const void* data, std::size_t size) {
+        const std::size_t offset{position & (buffer_.size() - 1)};
+        const std::size_t first{std::min(size, buffer_.size() - offset)};
+        std::memcpy(buffer_.data() + offset, data, first);
+        std::memcpy(buffer_.data(), static_cast<const char*>(data) + first, size - first);
+    }
+    void read(std::size_t position, void* data, std::size_t size) const {
+        const std::size_t offset{position & (buffer_.size() - 1)};
+        const std::size_t first{std::min(size, buffer_.size() - offset)};
+        std::memcpy(data, buffer_.data() + offset, first);
+        std::memcpy(static_cast<char*>(data) + first, buffer_.data(), size - first);
+    }
+
+    std::vector<char> buffer_;
+    alignas(64) std::atomic<std::size_t> head_{0};  // Consumer position, always increasing
+    alignas(64) std::atomic<std::size_t> tail_{0};  // Producer position, always increasing
+};
+
+//! \brief Background thread formatting and writing the records pushed by logging threads
+//! \details Each logging thread registers its own ring at its first line, so pushing never takes a lock. Records
+//! drained together are written in timestamp order
+class AsyncWriter {
+  public:
+    AsyncWriter(std::size_t buffer_size, OverflowPolicy overflow_policy);
+    ~AsyncWriter();
+
+    AsyncWriter(const AsyncWriter&) = delete;
+    AsyncWriter& operator=(const AsyncWriter&) = delete;
+
+    void push(const RecordHeader& header, std::string_view content);
+
+    //! \brief Waits until the records pushed before this call are written
+    void flush();
+
+  private:
+    using Record = std::pair<RecordHeader, std::string>;
+
+    RecordRing& thread_ring();
+    void notify();
+    void run();
+    bool write_batch();
+
+    static inline std::atomic<uint64_t> next_id_{0};
+
+    const uint64_t id_;
+    const std::size_t buffer_size_;
+    const OverflowPolicy overflow_policy_;
+    std::mutex rings_mutex_;
+    std::vector<std::shared_ptr<RecordRing>> rings_;
+    std::atomic<uint64_t> dropped_{0};
+
+    std::mutex wake_mutex_;
+    std::condition_variable wake_cv_;
+    std::condition_variable written_cv_;
+    uint64_t rounds_{0};  // Completed drain rounds, protected by wake_mutex_
+    bool wake_requested_{false};
+    bool stopping_{false};
+
+    std::vector<Record> batch_;
+    std::thread thread_;
+};
+
 static Settings settings_{};
 static std::mutex out_mtx{};
 static std::unique_ptr<std::fstream> file_{nullptr};
+static std::unique_ptr<AsyncWriter> async_writer_{nullptr};  // Declared after file_, so it is destroyed first
 thread_local std::string thread_name_{};
 
 void init(Settings& settings) {
+    async_writer_.reset();
     settings_ = settings;
     if (!settings_.log_file.empty()) {
         tee_file(std::filesystem::path(settings.log_file));
     }
     init_terminal();
+    if (settings_.log_async) {
+        async_writer_ = std::make_unique<AsyncWriter>(settings_.log_async_buffer_size, settings_.log_async_overflow);
+    }
 }
 
 void tee_file(const std::filesystem::path& path) {
@@ -105,22 +228,177 @@ void prepare_for_logging(std::ostream& ss) {
     }
 }
 
-BufferBase::BufferBase(Level level) : should_print_(level <= settings_.log_verbosity) {
-    if (!should_print_) return;
+//! Prepends level and timestamp to the line content
+static std::string format_line(Level level, std::chrono::system_clock::time_point timestamp, std::string_view content) {
+    auto [prefix, color] = get_level_settings(level);
 
-    if (settings_.log_thousands_sep != 0) {
-        ss_.imbue(std::locale(ss_.getloc(), new separate_thousands(settings_.log_thousands_sep)));
+    static const absl::TimeZone tz{settings_.log_utc ? absl::LocalTimeZone() : absl::UTCTimeZone()};
+    std::string line{kColorReset};
+    line.append(" ").append(color).append(prefix).append(kColorReset).append(" ");
+    line.append(kColorCyan).append("[").append(absl::FormatTime("%m-%d|%H:%M:%E3S", absl::FromChrono(timestamp), tz));
+    line.append(" ").append(tz.name()).append("] ").append(kColorReset);
+    line.append(content);
+    return line;
+}
+
+//! Writes the line to console and file (if any) without flushing them, out_mtx must be held
+static void write_line(std::string line) {
+    // Pattern to identify colorization
+    static const std::regex color_pattern("(\\\x1b\\[[0-9;]{1,}m)");
+
+    bool colorized{true};
+    if (settings_.log_nocolor) {
+        line = std::regex_replace(line, color_pattern, "");
+        colorized = false;
+    }
+    auto& out = settings_.log_std_out ? std::cout : std::cerr;
+    out << line << '\n';
+    if (file_ && file_->is_open()) {
+        if (colorized) {
+            line = std::regex_replace(line, color_pattern, "");
+        }
+        *file_ << line << '\n';
     }
+}
 
-    auto [prefix, color] = get_level_settings(level);
+static void flush_output() {
+    auto& out = settings_.log_std_out ? std::cout : std::cerr;
+    out.flush();
+    if (file_ && file_->is_open()) {
+        file_->flush();
+    }
+}
 
-    // Prefix
-    ss_ << kColorReset << " " << color << prefix << kColorReset << " ";
+void flush() {
+    if (async_writer_) {
+        async_writer_->flush();
+    }
+}
 
-    // TimeStamp
-    static const absl::TimeZone tz{settings_.log_utc ? absl::LocalTimeZone() : absl::UTCTimeZone()};
-    absl::Time now{absl::Now()};
-    ss_ << kColorCyan << "[" << absl::FormatTime("%m-%d|%H:%M:%E3S", now, tz) << " " << tz << "] " << kColorReset;
+AsyncWriter::AsyncWriter(std::size_t buffer_size, OverflowPolicy overflow_policy)
+    : id_{next_id_.fetch_add(1) + 1}, buffer_size_{buffer_size}, overflow_policy_{overflow_policy} {
+    thread_ = std::thread{[this]() { run(); }};
+}
+
+AsyncWriter::~AsyncWriter() {
+    {
+        std::scoped_lock lock{wake_mutex_};
+        stopping_ = true;
+    }
+    wake_cv_.notify_one();
+    thread_.join();
+}
+
+RecordRing& AsyncWriter::thread_ring() {
+    //! The ring of the calling thread, tagged with the writer it belongs to
+    struct ThreadRing {
+        uint64_t writer_id{0};
+        std::shared_ptr<RecordRing> ring;
+        ~ThreadRing() {
+            if (ring) ring->abandoned = true;
+        }
+    };
+    thread_local ThreadRing current;
+
+    if (current.writer_id != id_) {
+        if (current.ring) current.ring->abandoned = true;
+        current.ring = std::make_shared<RecordRing>(buffer_size_);
+        current.writer_id = id_;
+        std::scoped_lock lock{rings_mutex_};
+        rings_.push_back(current.ring);
+    }
+    return *current.ring;
+}
+
+void AsyncWriter::push(const RecordHeader& header, std::string_view content) {
+    RecordRing& ring{thread_ring()};
+    content = content.substr(0, ring.max_content_size());
+    RecordHeader record_header{header};
+    record_header.size = static_cast<uint32_t>(content.size());
+    while (!ring.try_push(record_header, content)) {
+        if (overflow_policy_ == OverflowPolicy::kDrop) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        notify();
+        std::this_thread::sleep_for(std::chrono::microseconds{50});
+    }
+}
+
+void AsyncWriter::notify() {
+    {
+        std::scoped_lock lock{wake_mutex_};
+        wake_requested_ = true;
+    }
+    wake_cv_.notify_one();
+}
+
+void AsyncWriter::flush() {
+    std::unique_lock lock{wake_mutex_};
+    // The round in progress (if any) may have missed the latest records, the next one cannot
+    const uint64_t target_round{rounds_ + 2};
+    wake_requested_ = true;
+    wake_cv_.notify_one();
+    written_cv_.wait(lock, [&]() { return rounds_ >= target_round || stopping_; });
+}
+
+void AsyncWriter::run() {
+    using namespace std::chrono_literals;
+    log::set_thread_name("log_writer");
+    bool stopping{false};
+    while (!stopping) {
+        const bool written{write_batch()};
+        std::unique_lock lock{wake_mutex_};
+        ++rounds_;
+        written_cv_.notify_all();
+        stopping = stopping_;
+        if (!written && !stopping && !wake_requested_) {
+            wake_cv_.wait_for(lock, 10ms, [&]() { return wake_requested_ || stopping_; });
+        }
+        wake_requested_ = false;
+    }
+    // Last records pushed before stopping
+    write_batch();
+}
+
+bool AsyncWriter::write_batch() {
+    batch_.clear();
+    {
+        std::scoped_lock lock{rings_mutex_};
+        for (auto& ring : rings_) {
+            ring->drain(batch_);
+        }
+        std::erase_if(rings_, [](const auto& ring) { return ring->abandoned && ring->empty(); });
+    }
+    const uint64_t dropped{dropped_.exchange(0, std::memory_order_relaxed)};
+    if (batch_.empty() && dropped == 0) {
+        return false;
+    }
+
+    std::stable_sort(batch_.begin(), batch_.end(), [](const Record& lhs, const Record& rhs) {
+        return lhs.first.timestamp < rhs.first.timestamp;
+    });
+    std::unique_lock out_lck{out_mtx};
+    for (auto& [header, content] : batch_) {
+        write_line(format_line(header.level, header.timestamp, content));
+    }
+    if (dropped > 0) {
+        write_line(format_line(Level::kWarning, std::chrono::system_clock::now(),
+                               "Log lines dropped, asynchronous buffer full: " + std::to_string(dropped)));
+    }
+    flush_output();
+    return true;
+}
+
+BufferBase::BufferBase(Level level)
+    : should_print_(level <= kMaxCompiledLevel && level <= settings_.log_verbosity),
+      level_{level},
+      timestamp_{should_print_ ? std::chrono::system_clock::now() : std::chrono::system_clock::time_point{}} {
+    if (!should_print_) return;
+
+    if (settings_.log_thousands_sep != 0) {
+        ss_.imbue(std::locale(ss_.getloc(), new separate_thousands(settings_.log_thousands_sep)));
+    }
 
     // ThreadId
     if (settings_.log_threads) {
@@ -135,24 +413,18 @@ BufferBase::BufferBase(Level level, std::string_view msg, const Args& args) : Bu
 void BufferBase::flush() {
     if (!should_print_) return;
 
-    // Pattern to identify colorization
-    static const std::regex color_pattern("(\\\x1b\\[[0-9;]{1,}m)");
-
-    bool colorized{true};
-    std::string line{ss_.str()};
-    if (settings_.log_nocolor) {
-        line = std::regex_replace(line, color_pattern, "");
-        colorized = false;
-    }
-    std::unique_lock out_lck{out_mtx};
-    auto& out = settings_.log_std_out ? std::cout : std::cerr;
-    out << line << std::endl;
-    if (file_ && file_->is_open()) {
-        if (colorized) {
-            line = std::regex_replace(line, color_pattern, "");
+    if (async_writer_) {
+        async_writer_->push(RecordHeader{.level = level_, .timestamp = timestamp_}, ss_.str());
+        if (level_ == Level::kCritical) {
+            async_writer_->flush();
         }
-        *file_ << line << std::endl;
+        return;
     }
+
+    std::string line{format_line(level_, timestamp_, ss_.str())};
+    std::unique_lock out_lck{out_mtx};
+    write_line(std::move(line));
+    flush_output();
 }
 
 }  // namespace silkworm::log
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <chrono>
+#include <cstddef>
 #include <filesystem>
 #include <sstream>
 #include <vector>
@@ -35,15 +37,31 @@ enum class Level {
     kTrace      // Trace calls to functions
 };
 
+//! \brief Most verbose level compiled in: SILK_* statements above it are removed together with their arguments
+//! \details Set by the SILKWORM_LOG_MAX_LEVEL build option, e.g. kInfo removes all SILK_DEBUG and SILK_TRACE
+#ifndef SILKWORM_LOG_MAX_LEVEL
+#define SILKWORM_LOG_MAX_LEVEL kTrace
+#endif
+inline constexpr Level kMaxCompiledLevel{Level::SILKWORM_LOG_MAX_LEVEL};
+
+//! \brief What a thread does when its asynchronous log buffer is full
+enum class OverflowPolicy {
+    kDrop,  // Discard the line: the number of discarded lines is logged as soon as there is room
+    kBlock  // Wait for the writer thread to make room
+};
+
 //! \brief Holds logging configuration
 struct Settings {
-    bool log_std_out{false};            // Whether console logging goes to std::cout or std::cerr (default)
-    bool log_utc{false};                // Whether timestamps should be in UTC or imbue local timezone
-    bool log_nocolor{false};            // Whether to disable colorized output
-    bool log_threads{false};            // Whether to print thread ids in log lines
-    Level log_verbosity{Level::kInfo};  // Log verbosity level
-    std::string log_file;               // Log to file
-    char log_thousands_sep{'\''};       // Thousands separator
+    bool log_std_out{false};                                   // Whether console logging goes to std::cout or std::cerr (default)
+    bool log_utc{false};                                       // Whether timestamps should be in UTC or imbue local timezone
+    bool log_nocolor{false};                                   // Whether to disable colorized output
+    bool log_threads{false};                                   // Whether to print thread ids in log lines
+    Level log_verbosity{Level::kInfo};                         // Log verbosity level
+    std::string log_file;                                      // Log to file
+    char log_thousands_sep{'\''};                              // Thousands separator
+    bool log_async{false};                                     // Whether log lines are written by a background thread
+    std::size_t log_async_buffer_size{256 * 1024};             // Size in bytes of the asynchronous buffer of each thread
+    OverflowPolicy log_async_overflow{OverflowPolicy::kDrop};  // Behaviour when the asynchronous buffer is full
 };
 
 //! \brief Initializes logging facilities
@@ -76,6 +94,9 @@ void tee_file(const std::filesystem::path& path);
 
 void prepare_for_logging(std::ostream&);
 
+//! \brief Waits until the lines logged so far are written when logging asynchronously, otherwise does nothing
+void flush();
+
 using Args = std::vector<std::string>;
 
 class BufferBase {
@@ -114,7 +135,9 @@ class BufferBase {
     }
     void flush();
     const bool should_print_;
-    std::stringstream ss_;
+    const Level level_;
+    const std::chrono::system_clock::time_point timestamp_;
+    std::stringstream ss_;  // Line content, the level prefix and the timestamp are added when written
 };
 
 template <Level level>
@@ -134,9 +157,9 @@ using Message = LogBuffer<Level::kNone>;
 
 }  // namespace silkworm::log
 
-#define SILK_LOGBUFFER(level_)                    \
-    if (!silkworm::log::test_verbosity(level_)) { \
-    } else                                        \
+#define SILK_LOGBUFFER(level_)                                                                  \
+    if (!(level_ <= silkworm::log::kMaxCompiledLevel && silkworm::log::test_verbosity(level_))) { \
+    } else                                                                                      \
         silkworm::log::LogBuffer<level_>()
 
 #define SILK_TRACE SILK_LOGBUFFER(silkworm::log::Level::kTrace)
@@ -17,8 +17,10 @@
 #include "log.hpp"
 
 #include <iostream>
+#include <regex>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include <catch2/catch.hpp>
 
@@ -148,4 +150,90 @@ TEST_CASE("LogBuffer", "[silkworm][common][log]") {
     }
 }
 
+TEST_CASE("SILK_* macros do not evaluate arguments of disabled levels", "[silkworm][common][log]") {
+    test::SetLogVerbosityGuard guard{Level::kInfo};
+    int evaluations{0};
+    auto evaluate = [&evaluations]() { return ++evaluations; };
+    SILK_DEBUG << evaluate();
+    SILK_TRACE << evaluate();
+    CHECK(evaluations == 0);
+}
+
+//! Count the lines containing text
+static std::size_t count_lines(const std::string& output, const std::string& text) {
+    std::size_t count{0};
+    std::istringstream stream{output};
+    for (std::string line; std::getline(stream, line);) {
+        if (line.find(text) != std::string::npos) ++count;
+    }
+    return count;
+}
+
+TEST_CASE("Asynchronous logging", "[silkworm][common][log]") {
+    std::stringstream output;
+    StreamSwap cerr_swap{std::cerr, output};
+
+    Settings log_settings;
+    log_settings.log_async = true;
+    log_settings.log_nocolor = true;
+    log_settings.log_async_buffer_size = 4'096;
+
+    constexpr int kThreads{4};
+    constexpr int kLinesPerThread{500};
+    auto log_from_threads = [&]() {
+        std::vector<std::thread> threads;
+        for (int t{0}; t < kThreads; ++t) {
+            threads.emplace_back([t]() {
+                for (int i{0}; i < kLinesPerThread; ++i) {
+                    Info("async line", {"thread", std::to_string(t), "index", std::to_string(i)});
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        flush();
+    };
+
+    SECTION("block on overflow writes all lines") {
+        log_settings.log_async_overflow = OverflowPolicy::kBlock;
+        init(log_settings);
+        log_from_threads();
+        CHECK(count_lines(output.str(), "async line") == kThreads * kLinesPerThread);
+        CHECK(count_lines(output.str(), "Log lines dropped") == 0);
+    }
+
+    SECTION("drop on overflow reports dropped lines") {
+        log_settings.log_async_overflow = OverflowPolicy::kDrop;
+        init(log_settings);
+        log_from_threads();
+        std::size_t dropped{0};
+        const std::regex dropped_pattern{"Log lines dropped, asynchronous buffer full: ([0-9]+)"};
+        const std::string text{output.str()};
+        for (std::sregex_iterator it{text.begin(), text.end(), dropped_pattern}, end; it != end; ++it) {
+            dropped += std::stoul((*it)[1].str());
+        }
+        CHECK(count_lines(text, "async line") + dropped == kThreads * kLinesPerThread);
+    }
+
+    SECTION("lines of one thread keep their order") {
+        log_settings.log_async_overflow = OverflowPolicy::kBlock;
+        init(log_settings);
+        for (int i{0}; i < 100; ++i) {
+            Info("ordered line", {"index", std::to_string(i)});
+        }
+        flush();
+        std::istringstream stream{output.str()};
+        int expected_index{0};
+        for (std::string line; std::getline(stream, line);) {
+            if (line.find("ordered line") == std::string::npos) continue;
+            CHECK(line.find("index=" + std::to_string(expected_index) + " ") != std::string::npos);
+            ++expected_index;
+        }
+        CHECK(expected_index == 100);
+    }
+
+    // Back to synchronous logging with default settings
+    Settings default_settings;
+    init(default_settings);
+}
+
 }  // namespace silkworm::log
@@ -21,6 +21,7 @@
 #include <functional>
 #include <memory>
 #include <ostream>
+#include <utility>
 #include <vector>
 
 #include <boost/asio/io_context.hpp>
@@ -28,6 +29,7 @@
 #include <silkworm/infra/common/log.hpp>
 #include <silkworm/infra/concurrency/context_pool_settings.hpp>
 #include <silkworm/infra/concurrency/idle_strategy.hpp>
+#include <silkworm/infra/concurrency/thread_affinity.hpp>
 
 namespace silkworm::concurrency {
 
@@ -82,6 +84,7 @@ class ContextPool {
         contexts_.reserve(pool_size);
     }
     explicit ContextPool(ContextPoolSettings settings) : ContextPool(settings.num_contexts) {
+        set_affinity(std::move(settings.cpu_set), settings.affinity_mode);
         for (size_t i{0}; i < settings.num_contexts; ++i) {
             add_context(T{contexts_.size(), settings.wait_mode});
         }
@@ -104,6 +107,12 @@ class ContextPool {
         return contexts_[num_contexts];
     }
 
+    //! Place the execution threads over the CPU set according to the policy, must be called before \ref start()
+    void set_affinity(CpuSet cpu_set, AffinityMode affinity_mode) {
+        cpu_set_ = std::move(cpu_set);
+        affinity_mode_ = affinity_mode;
+    }
+
     //! Start one execution thread for each context.
     virtual void start() {
         SILK_TRACE << "ContextPool::start START";
@@ -113,6 +122,14 @@ class ContextPool {
             auto& context = contexts_[i];
             context_threads_.create_thread([&, i = i]() {
                 log::set_thread_name(std::string("asio_ctx_s" + std::to_string(i)).c_str());
+                // Pin before running the loop, so that any helper thread spawned by the context inherits the placement
+                const auto context_cpu_set{thread_cpu_set(cpu_set_, affinity_mode_, i)};
+                if (!context_cpu_set.empty()) {
+                    if (!set_thread_affinity(context_cpu_set)) {
+                        SILK_WARN << "ContextPool::start context[" << i << "] cannot pin to cpus: " << to_string(context_cpu_set);
+                    }
+                    SILK_INFO << "ContextPool context[" << i << "] placement " << thread_placement();
+                }
                 SILK_TRACE << "Thread start context[" << i << "] thread_id: " << std::this_thread::get_id();
                 context.execute_loop();
                 SILK_TRACE << "Thread end context[" << i << "] thread_id: " << std::this_thread::get_id();
@@ -183,6 +200,12 @@ class ContextPool {
 
     //! Flag indicating if pool has been stopped.
     std::atomic_bool stopped_{false};
+
+    //! The CPUs running the execution threads (empty means no pinning).
+    CpuSet cpu_set_;
+
+    //! The placement policy of the execution threads over the CPUs.
+    AffinityMode affinity_mode_{AffinityMode::shared};
 };
 
 }  // namespace silkworm::concurrency
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <silkworm/infra/concurrency/idle_strategy.hpp>
+#include <silkworm/infra/concurrency/thread_affinity.hpp>
 
 namespace silkworm::concurrency {
 
@@ -24,6 +25,8 @@ namespace silkworm::concurrency {
 struct ContextPoolSettings {
     uint32_t num_contexts{std::thread::hardware_concurrency() / 2};  // The number of execution contexts to activate
     WaitMode wait_mode{WaitMode::blocking};                          // The waiting strategy when context has no work
+    CpuSet cpu_set;                                                  // The CPUs running the contexts (empty means no pinning)
+    AffinityMode affinity_mode{AffinityMode::shared};                // The placement policy of contexts over the CPUs
 };
 
 }  // namespace silkworm::concurrency
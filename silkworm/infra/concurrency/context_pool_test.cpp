@@ -17,10 +17,12 @@
 #include "context_pool.hpp"
 
 #include <atomic>
+#include <future>
 #include <stdexcept>
 #include <thread>
 
 #include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/post.hpp>
 #include <catch2/catch.hpp>
 
 #include <silkworm/infra/common/log.hpp>
@@ -128,6 +130,19 @@ TEST_CASE("ContextPool", "[silkworm][concurrency][Context]") {
         CHECK_NOTHROW(context_pool.stop());
     }
 
+    SECTION("start/stop w/ pinned contexts") {
+        const auto allowed_cpus{get_thread_affinity()};
+        ContextPool context_pool{ContextPoolSettings{.num_contexts = 2, .cpu_set = allowed_cpus, .affinity_mode = AffinityMode::per_cpu}};
+        CHECK_NOTHROW(context_pool.start());
+        for (std::size_t i{0}; i < context_pool.num_contexts(); ++i) {
+            auto& context = context_pool.next_context();
+            std::promise<CpuSet> context_cpu_set;
+            boost::asio::post(*context.io_context(), [&]() { context_cpu_set.set_value(get_thread_affinity()); });
+            CHECK(context_cpu_set.get_future().get() == thread_cpu_set(allowed_cpus, AffinityMode::per_cpu, context.id()));
+        }
+        CHECK_NOTHROW(context_pool.stop());
+    }
+
     SECTION("join") {
         ContextPool context_pool{2};
         context_pool.add_context(Context{0, WaitMode::blocking});
@@ -0,0 +1,146 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "task_scheduler.hpp"
+
+#include <optional>
+#include <random>
+
+#include <silkworm/infra/common/log.hpp>
+
+namespace silkworm::concurrency {
+
+//! The scheduler and worker running on the calling thread (if any)
+static thread_local const TaskScheduler* tls_scheduler{nullptr};
+static thread_local void* tls_worker{nullptr};
+
+TaskScheduler::TaskScheduler(TaskSchedulerSettings settings) : settings_{std::move(settings)} {
+    const std::size_t num_workers{std::max<std::size_t>(settings_.num_workers, 1)};
+    workers_.reserve(num_workers);
+    for (std::size_t i{0}; i < num_workers; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+    // Start the threads only when all the deques exist, since any worker may steal from any other
+    for (std::size_t i{0}; i < num_workers; ++i) {
+        workers_[i]->thread = std::thread{[this, i]() { run_worker(i); }};
+    }
+}
+
+TaskScheduler::~TaskScheduler() {
+    {
+        std::scoped_lock lock{mutex_};
+        stopping_ = true;
+    }
+    work_available_.notify_all();
+    for (auto& worker : workers_) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+}
+
+bool TaskScheduler::is_worker() const {
+    return tls_scheduler == this;
+}
+
+TaskScheduler::Worker* TaskScheduler::current_worker() const {
+    return tls_scheduler == this ? static_cast<Worker*>(tls_worker) : nullptr;
+}
+
+void TaskScheduler::schedule(Task* task) {
+    // Count the task before publishing it, so that no worker can go to sleep while it is pending
+    num_queued_.fetch_add(1, std::memory_order_seq_cst);
+    if (Worker* worker = current_worker()) {
+        worker->deque.push(task);
+    } else {
+        std::scoped_lock lock{mutex_};
+        injection_queue_.push_back(task);
+    }
+    if (num_sleeping_.load(std::memory_order_seq_cst) > 0) {
+        std::scoped_lock lock{mutex_};
+        work_available_.notify_one();
+    }
+}
+
+bool TaskScheduler::try_run_one() {
+    Worker* worker = current_worker();
+    std::optional<Task*> task;
+    if (worker) {
+        task = worker->deque.pop();
+    }
+    if (!task && num_queued_.load(std::memory_order_relaxed) > 0) {
+        std::scoped_lock lock{mutex_};
+        if (!injection_queue_.empty()) {
+            task = injection_queue_.front();
+            injection_queue_.pop_front();
+        }
+    }
+    if (!task && num_queued_.load(std::memory_order_relaxed) > 0) {
+        // Scan the other deques starting from a random victim to spread the thieves
+        static thread_local std::minstd_rand random_engine{std::random_device{}()};
+        const std::size_t first_victim{random_engine() % workers_.size()};
+        for (std::size_t i{0}; i < workers_.size() && !task; ++i) {
+            Worker* victim = workers_[(first_victim + i) % workers_.size()].get();
+            if (victim != worker) {
+                task = victim->deque.steal();
+            }
+        }
+    }
+    if (!task) {
+        return false;
+    }
+    num_queued_.fetch_sub(1, std::memory_order_relaxed);
+    std::unique_ptr<Task> running_task{*task};
+    try {
+        running_task->run();
+    } catch (const std::exception& ex) {
+        SILK_ERROR << "TaskScheduler: unexpected exception in task: " << ex.what();
+    } catch (...) {
+        SILK_ERROR << "TaskScheduler: unexpected exception in task";
+    }
+    return true;
+}
+
+void TaskScheduler::run_worker(std::size_t index) {
+    tls_scheduler = this;
+    tls_worker = workers_[index].get();
+    const auto name{settings_.name + std::to_string(index)};
+    log::set_thread_name(name.c_str());
+    const auto worker_cpu_set{thread_cpu_set(settings_.cpu_set, settings_.affinity_mode, index)};
+    if (!worker_cpu_set.empty()) {
+        if (!set_thread_affinity(worker_cpu_set)) {
+            SILK_WARN << "TaskScheduler: cannot pin worker " << name << " to cpus: " << to_string(worker_cpu_set);
+        }
+        SILK_INFO << "TaskScheduler: worker " << name << " placement " << thread_placement();
+    }
+
+    while (true) {
+        if (try_run_one()) {
+            continue;
+        }
+        std::unique_lock lock{mutex_};
+        num_sleeping_.fetch_add(1, std::memory_order_seq_cst);
+        work_available_.wait(lock, [&]() { return num_queued_.load(std::memory_order_seq_cst) > 0 || stopping_; });
+        num_sleeping_.fetch_sub(1, std::memory_order_relaxed);
+        if (stopping_ && num_queued_.load(std::memory_order_seq_cst) == 0) {
+            break;
+        }
+    }
+    tls_worker = nullptr;
+    tls_scheduler = nullptr;
+}
+
+}  // namespace silkworm::concurrency
@@ -0,0 +1,276 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <silkworm/infra/concurrency/coroutine.hpp>
+
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/this_coro.hpp>
+
+#include <silkworm/infra/concurrency/awaitable_future.hpp>
+#include <silkworm/infra/concurrency/thread_affinity.hpp>
+#include <silkworm/infra/concurrency/work_stealing_deque.hpp>
+
+namespace silkworm::concurrency {
+
+//! The configuration settings for \refitem TaskScheduler
+struct TaskSchedulerSettings {
+    std::size_t num_workers{std::thread::hardware_concurrency()};  // The number of worker threads
+    CpuSet cpu_set;                                                // The CPUs running the workers (empty means no pinning)
+    AffinityMode affinity_mode{AffinityMode::shared};              // The placement policy of workers over the CPUs
+    std::string name{"sched_w"};                                   // The prefix of the worker thread names
+};
+
+//! Work-stealing scheduler for CPU-bound tasks
+//! @details Each worker owns a Chase-Lev deque: tasks submitted by a worker go to the bottom of its own deque, so that
+//! recently forked subtasks run first on the same core, while idle workers steal the oldest (i.e. biggest) tasks from
+//! the top of the others' deques. Tasks submitted by any other thread go to a shared injection queue.
+//! The fork/join helpers split a range recursively and join by running pending tasks instead of blocking, so they
+//! can be nested freely inside tasks without starving the workers.
+class TaskScheduler {
+  public:
+    explicit TaskScheduler(TaskSchedulerSettings settings);
+    explicit TaskScheduler(std::size_t num_workers = std::thread::hardware_concurrency())
+        : TaskScheduler(TaskSchedulerSettings{.num_workers = num_workers}) {}
+
+    //! Run all the pending tasks, then stop and join the workers
+    ~TaskScheduler();
+
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+    [[nodiscard]] std::size_t num_workers() const { return workers_.size(); }
+
+    //! Whether the calling thread is one of the workers of this scheduler
+    [[nodiscard]] bool is_worker() const;
+
+    //! Schedule the task for execution, any exception escaping from the task is logged and swallowed
+    template <typename F>
+    void post(F&& f) {
+        schedule(make_task(std::forward<F>(f)));
+    }
+
+    //! Schedule the task for execution, its result or exception is delivered through the returned future
+    template <typename F, typename R = std::invoke_result_t<std::decay_t<F>>>
+    std::future<R> submit(F&& f) {
+        std::promise<R> promise;
+        auto result{promise.get_future()};
+        post([f = std::forward<F>(f), promise = std::move(promise)]() mutable {
+            try {
+                if constexpr (std::is_void_v<R>) {
+                    std::invoke(f);
+                    promise.set_value();
+                } else {
+                    promise.set_value(std::invoke(f));
+                }
+            } catch (...) {
+                promise.set_exception(std::current_exception());
+            }
+        });
+        return result;
+    }
+
+    //! Schedule the task for execution and resume the calling coroutine on its own executor when the task is done
+    template <typename F, typename R = std::invoke_result_t<F>>
+    boost::asio::awaitable<R> async_submit(F f) {
+        using Result = std::conditional_t<std::is_void_v<R>, bool, R>;
+        auto executor = co_await boost::asio::this_coro::executor;
+        AwaitablePromise<Result> promise{executor};
+        auto result{promise.get_future()};
+        post([f = std::move(f), promise = std::move(promise)]() mutable {
+            try {
+                if constexpr (std::is_void_v<R>) {
+                    std::invoke(f);
+                    promise.set_value(true);
+                } else {
+                    promise.set_value(std::invoke(f));
+                }
+            } catch (...) {
+                promise.set_exception(std::current_exception());
+            }
+        });
+        if constexpr (std::is_void_v<R>) {
+            co_await result.get_async();
+        } else {
+            co_return co_await result.get_async();
+        }
+    }
+
+    //! Wait for the future, running pending tasks meanwhile if called by a worker (which must not block)
+    template <typename T>
+    void wait(const std::future<T>& future) {
+        if (!is_worker()) {
+            future.wait();
+            return;
+        }
+        help_until([&]() { return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready; });
+    }
+
+    //! Apply the function to each index in [first, last) in parallel, splitting the range down to chunks of grain size
+    //! @details The first exception thrown (if any) is rethrown after all the chunks have completed
+    template <typename F>
+    void parallel_for(std::size_t first, std::size_t last, std::size_t grain, F&& f) {
+        if (first >= last) return;
+        JoinState join;
+        fork_range(join, first, last, std::max<std::size_t>(grain, 1), f);
+        help_until([&]() { return join.pending.load(std::memory_order_acquire) == 0; });
+        if (join.error) {
+            std::rethrow_exception(join.error);
+        }
+    }
+
+    //! Map each index in [first, last) and reduce the results in parallel, in index order so that the reduction
+    //! function needs to be associative but not commutative
+    template <typename T, typename Map, typename Reduce>
+    T parallel_reduce(std::size_t first, std::size_t last, std::size_t grain, T identity, Map&& map, Reduce&& reduce) {
+        if (first >= last) return identity;
+        grain = std::max<std::size_t>(grain, 1);
+        const std::size_t num_chunks{(last - first + grain - 1) / grain};
+        // Wrapped to keep the partial results in distinct memory locations even when T is bool
+        struct Partial {
+            T value;
+        };
+        std::vector<Partial> partials(num_chunks, Partial{identity});
+        parallel_for(0, num_chunks, 1, [&](std::size_t chunk) {
+            const std::size_t begin{first + chunk * grain}, end{std::min(begin + grain, last)};
+            T partial{identity};
+            for (std::size_t i{begin}; i < end; ++i) {
+                partial = reduce(std::move(partial), map(i));
+            }
+            partials[chunk].value = std::move(partial);
+        });
+        T result{std::move(identity)};
+        for (auto& partial : partials) {
+            result = reduce(std::move(result), std::move(partial.value));
+        }
+        return result;
+    }
+
+  private:
+    //! Type-erased move-only task
+    struct Task {
+        virtual ~Task() = default;
+        virtual void run() = 0;
+    };
+
+    template <typename F>
+    struct TaskImpl : Task {
+        explicit TaskImpl(F&& f) : function(std::move(f)) {}
+        void run() override { function(); }
+        F function;
+    };
+
+    template <typename F>
+    static Task* make_task(F&& f) {
+        return new TaskImpl<std::decay_t<F>>{std::decay_t<F>{std::forward<F>(f)}};
+    }
+
+    //! The state shared by the subtasks of a fork/join
+    struct JoinState {
+        std::atomic<std::size_t> pending{0};
+        std::mutex error_mutex;
+        std::exception_ptr error;
+    };
+
+    template <typename F>
+    void fork_range(JoinState& join, std::size_t first, std::size_t last, std::size_t grain, F& f) {
+        // Fork the upper halves until the range fits the grain, then run the lower one here
+        while (last - first > grain) {
+            const std::size_t middle{first + (last - first) / 2};
+            join.pending.fetch_add(1, std::memory_order_relaxed);
+            post([this, &join, middle, last, grain, &f]() {
+                fork_range(join, middle, last, grain, f);
+                join.pending.fetch_sub(1, std::memory_order_release);
+            });
+            last = middle;
+        }
+        try {
+            for (std::size_t i{first}; i < last; ++i) {
+                f(i);
+            }
+        } catch (...) {
+            std::scoped_lock lock{join.error_mutex};
+            if (!join.error) join.error = std::current_exception();
+        }
+    }
+
+    struct Worker {
+        WorkStealingDeque<Task*> deque;
+        std::thread thread;
+    };
+
+    void schedule(Task* task);
+
+    //! Run one pending task (if any) taking it from the own deque first, then the injection queue and other deques
+    bool try_run_one();
+
+    //! Run pending tasks until the predicate is satisfied
+    template <typename Predicate>
+    void help_until(Predicate&& done) {
+        while (!done()) {
+            if (!try_run_one()) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void run_worker(std::size_t index);
+
+    //! The worker of this scheduler running on the calling thread (if any)
+    [[nodiscard]] Worker* current_worker() const;
+
+    TaskSchedulerSettings settings_;
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+
+    //! The queue of the tasks submitted from outside the workers
+    std::deque<Task*> injection_queue_;
+
+    //! The mutex protecting the injection queue and the sleep/wake-up protocol
+    std::mutex mutex_;
+
+    //! The condition signalled to wake up sleeping workers
+    std::condition_variable work_available_;
+
+    //! The number of tasks scheduled but not yet taken by any thread
+    std::atomic<std::size_t> num_queued_{0};
+
+    //! The number of workers sleeping on the condition
+    std::atomic<std::size_t> num_sleeping_{0};
+
+    //! Flag indicating if the workers must exit as soon as no task is left
+    bool stopping_{false};
+};
+
+}  // namespace silkworm::concurrency
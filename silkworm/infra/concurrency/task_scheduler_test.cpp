@@ -0,0 +1,148 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "task_scheduler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/use_future.hpp>
+#include <catch2/catch.hpp>
+
+#include <silkworm/infra/test/log.hpp>
+
+namespace silkworm::concurrency {
+
+//! Naive recursive Fibonacci forking both branches down to a threshold, i.e. deeply nested fork/join
+static uint64_t fibonacci(TaskScheduler& scheduler, uint64_t n) {
+    if (n < 12) {
+        return n < 2 ? n : fibonacci(scheduler, n - 1) + fibonacci(scheduler, n - 2);
+    }
+    uint64_t results[2]{};
+    scheduler.parallel_for(0, 2, 1, [&](std::size_t i) { results[i] = fibonacci(scheduler, n - 1 - i); });
+    return results[0] + results[1];
+}
+
+TEST_CASE("TaskScheduler", "[silkworm][concurrency][task_scheduler]") {
+    test::SetLogVerbosityGuard guard{log::Level::kNone};
+    TaskScheduler scheduler{4};
+    CHECK(scheduler.num_workers() == 4);
+    CHECK(!scheduler.is_worker());
+
+    SECTION("post") {
+        std::atomic<int> count{0};
+        {
+            TaskScheduler local_scheduler{2};
+            for (int i{0}; i < 1'000; ++i) {
+                local_scheduler.post([&]() { ++count; });
+            }
+        }  // all pending tasks are run before destruction
+        CHECK(count == 1'000);
+    }
+
+    SECTION("submit") {
+        auto value = scheduler.submit([&]() { return scheduler.is_worker(); });
+        CHECK(value.get());
+        auto nothing = scheduler.submit([]() {});
+        CHECK_NOTHROW(nothing.get());
+        auto error = scheduler.submit([]() -> int { throw std::runtime_error{"error"}; });
+        CHECK_THROWS_AS(error.get(), std::runtime_error);
+    }
+
+    SECTION("wait inside task") {
+        // Every worker waits for a task submitted after it, which must be run by the waiting workers themselves
+        std::vector<std::future<int>> results;
+        for (int i{0}; i < 16; ++i) {
+            results.push_back(scheduler.submit([&scheduler, i]() {
+                auto inner = scheduler.submit([i]() { return i; });
+                scheduler.wait(inner);
+                return inner.get();
+            }));
+        }
+        for (int i{0}; i < 16; ++i) {
+            CHECK(results[static_cast<std::size_t>(i)].get() == i);
+        }
+    }
+
+    SECTION("parallel_for") {
+        std::vector<int> visited(10'000, 0);
+        scheduler.parallel_for(0, visited.size(), 64, [&](std::size_t i) { ++visited[i]; });
+        CHECK(std::all_of(visited.cbegin(), visited.cend(), [](int v) { return v == 1; }));
+
+        scheduler.parallel_for(5, 5, 1, [](std::size_t) { FAIL("empty range"); });
+    }
+
+    SECTION("parallel_for exception") {
+        std::atomic<int> count{0};
+        CHECK_THROWS_AS(scheduler.parallel_for(0, 100, 1, [&](std::size_t i) {
+            ++count;
+            if (i == 42) throw std::invalid_argument{"42"};
+        }),
+                        std::invalid_argument);
+        CHECK(count == 100);  // all the chunks are completed anyway
+    }
+
+    SECTION("parallel_reduce") {
+        const auto sum = scheduler.parallel_reduce(
+            0, 100'000, 1'000, uint64_t{0}, [](std::size_t i) { return uint64_t{i}; }, std::plus<uint64_t>{});
+        CHECK(sum == 99'999ull * 100'000 / 2);
+
+        // The reduction order is the index order
+        const auto digits = scheduler.parallel_reduce(
+            0, 10, 3, std::string{}, [](std::size_t i) { return std::to_string(i); },
+            [](std::string a, std::string b) { return a + b; });
+        CHECK(digits == "0123456789");
+
+        CHECK(scheduler.parallel_reduce(
+                  3, 3, 1, 7, [](std::size_t) { return 0; }, std::plus<int>{}) == 7);
+    }
+
+    SECTION("nested fork/join") {
+        CHECK(fibonacci(scheduler, 25) == 75'025);
+        auto nested = scheduler.submit([&]() { return fibonacci(scheduler, 20); });
+        CHECK(nested.get() == 6'765);
+    }
+
+    SECTION("async_submit") {
+        boost::asio::io_context io_context;
+        auto result = boost::asio::co_spawn(
+            io_context,
+            [&]() -> boost::asio::awaitable<int> {
+                co_await scheduler.async_submit([]() {});
+                co_return co_await scheduler.async_submit([]() { return 42; });
+            },
+            boost::asio::use_future);
+        io_context.run();
+        CHECK(result.get() == 42);
+
+        auto error = boost::asio::co_spawn(
+            io_context,
+            [&]() -> boost::asio::awaitable<void> {
+                co_await scheduler.async_submit([]() { throw std::runtime_error{"error"}; });
+            },
+            boost::asio::use_future);
+        io_context.restart();
+        io_context.run();
+        CHECK_THROWS_AS(error.get(), std::runtime_error);
+    }
+}
+
+}  // namespace silkworm::concurrency
@@ -0,0 +1,246 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "thread_affinity.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+
+#include <boost/asio/post.hpp>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <silkworm/infra/common/log.hpp>
+
+namespace silkworm::concurrency {
+
+static uint32_t parse_cpu_index(std::string_view token, std::string_view cpu_list) {
+    while (!token.empty() && token.front() == ' ') token.remove_prefix(1);
+    while (!token.empty() && token.back() == ' ') token.remove_suffix(1);
+    uint32_t cpu{0};
+    const auto [ptr, ec] = std::from_chars(token.data(), token.data() + token.size(), cpu);
+    if (token.empty() || ec != std::errc{} || ptr != token.data() + token.size()) {
+        throw std::invalid_argument{"invalid CPU list: " + std::string{cpu_list}};
+    }
+    return cpu;
+}
+
+CpuSet parse_cpu_set(std::string_view cpu_list) {
+    CpuSet cpu_set;
+    if (cpu_list.find_first_not_of(" \n") == std::string_view::npos) {
+        return cpu_set;
+    }
+    std::string_view remaining{cpu_list};
+    while (!remaining.empty() && remaining.back() == '\n') remaining.remove_suffix(1);
+    while (true) {
+        const auto comma = remaining.find(',');
+        const auto item = remaining.substr(0, comma);
+        const auto dash = item.find('-');
+        const uint32_t first = parse_cpu_index(item.substr(0, dash), cpu_list);
+        const uint32_t last = dash == std::string_view::npos ? first : parse_cpu_index(item.substr(dash + 1), cpu_list);
+        if (first > last) {
+            throw std::invalid_argument{"invalid CPU range in CPU list: " + std::string{cpu_list}};
+        }
+        for (uint32_t cpu{first}; cpu <= last; ++cpu) {
+            cpu_set.push_back(cpu);
+        }
+        if (comma == std::string_view::npos) break;
+        remaining.remove_prefix(comma + 1);
+    }
+    std::sort(cpu_set.begin(), cpu_set.end());
+    cpu_set.erase(std::unique(cpu_set.begin(), cpu_set.end()), cpu_set.end());
+    return cpu_set;
+}
+
+std::string to_string(const CpuSet& cpu_set) {
+    std::string cpu_list;
+    for (std::size_t i{0}; i < cpu_set.size();) {
+        std::size_t j{i};
+        while (j + 1 < cpu_set.size() && cpu_set[j + 1] == cpu_set[j] + 1) ++j;
+        if (!cpu_list.empty()) cpu_list.push_back(',');
+        cpu_list.append(std::to_string(cpu_set[i]));
+        if (j > i) {
+            cpu_list.push_back('-');
+            cpu_list.append(std::to_string(cpu_set[j]));
+        }
+        i = j + 1;
+    }
+    return cpu_list;
+}
+
+std::vector<CpuSet> numa_nodes() {
+    std::vector<CpuSet> nodes;
+#if defined(__linux__)
+    static const std::filesystem::path kNodesDir{"/sys/devices/system/node"};
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator{kNodesDir, ec}) {
+        const auto name = entry.path().filename().string();
+        if (name.size() <= 4 || name.compare(0, 4, "node") != 0) continue;
+        uint32_t node{0};
+        const auto [ptr, parse_ec] = std::from_chars(name.data() + 4, name.data() + name.size(), node);
+        if (parse_ec != std::errc{} || ptr != name.data() + name.size()) continue;
+        std::ifstream cpulist_file{entry.path() / "cpulist"};
+        std::string cpu_list;
+        if (!std::getline(cpulist_file, cpu_list)) continue;
+        if (nodes.size() <= node) nodes.resize(node + 1);
+        try {
+            nodes[node] = parse_cpu_set(cpu_list);
+        } catch (const std::invalid_argument&) {
+            return {};
+        }
+    }
+#endif
+    return nodes;
+}
+
+std::optional<uint32_t> numa_node_of(uint32_t cpu) {
+    const auto nodes = numa_nodes();
+    for (std::size_t node{0}; node < nodes.size(); ++node) {
+        if (std::binary_search(nodes[node].cbegin(), nodes[node].cend(), cpu)) {
+            return static_cast<uint32_t>(node);
+        }
+    }
+    return std::nullopt;
+}
+
+CpuSet thread_cpu_set(const CpuSet& cpu_set, AffinityMode mode, std::size_t thread_index) {
+    if (cpu_set.empty()) {
+        return {};
+    }
+    switch (mode) {
+        case AffinityMode::shared:
+            return cpu_set;
+        case AffinityMode::per_cpu:
+            return {cpu_set[thread_index % cpu_set.size()]};
+        case AffinityMode::per_numa_node: {
+            // Split the set by NUMA node skipping the nodes having no CPU in it
+            std::vector<CpuSet> node_cpu_sets;
+            for (const auto& node_cpus : numa_nodes()) {
+                CpuSet node_cpu_set;
+                std::set_intersection(cpu_set.cbegin(), cpu_set.cend(), node_cpus.cbegin(), node_cpus.cend(),
+                                      std::back_inserter(node_cpu_set));
+                if (!node_cpu_set.empty()) {
+                    node_cpu_sets.push_back(std::move(node_cpu_set));
+                }
+            }
+            if (node_cpu_sets.empty()) {
+                return cpu_set;
+            }
+            return node_cpu_sets[thread_index % node_cpu_sets.size()];
+        }
+    }
+    return cpu_set;
+}
+
+bool set_thread_affinity(const CpuSet& cpu_set) {
+    if (cpu_set.empty()) {
+        return false;
+    }
+#if defined(__linux__)
+    cpu_set_t native_cpu_set;
+    CPU_ZERO(&native_cpu_set);
+    for (const auto cpu : cpu_set) {
+        if (cpu >= CPU_SETSIZE) {
+            return false;
+        }
+        CPU_SET(cpu, &native_cpu_set);
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(native_cpu_set), &native_cpu_set) == 0;
+#else
+    return false;
+#endif
+}
+
+CpuSet get_thread_affinity() {
+    CpuSet cpu_set;
+#if defined(__linux__)
+    cpu_set_t native_cpu_set;
+    CPU_ZERO(&native_cpu_set);
+    if (pthread_getaffinity_np(pthread_self(), sizeof(native_cpu_set), &native_cpu_set) == 0) {
+        for (uint32_t cpu{0}; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &native_cpu_set)) {
+                cpu_set.push_back(cpu);
+            }
+        }
+    }
+#endif
+    return cpu_set;
+}
+
+std::string thread_placement() {
+    const auto cpu_set = get_thread_affinity();
+    if (cpu_set.empty()) {
+        return "cpus: unknown";
+    }
+    std::string placement{"cpus: " + to_string(cpu_set)};
+    const auto nodes = numa_nodes();
+    CpuSet thread_nodes;
+    for (std::size_t node{0}; node < nodes.size(); ++node) {
+        const bool overlaps = std::any_of(cpu_set.cbegin(), cpu_set.cend(), [&](uint32_t cpu) {
+            return std::binary_search(nodes[node].cbegin(), nodes[node].cend(), cpu);
+        });
+        if (overlaps) {
+            thread_nodes.push_back(static_cast<uint32_t>(node));
+        }
+    }
+    if (!thread_nodes.empty()) {
+        placement.append(" numa: " + to_string(thread_nodes));
+    }
+    return placement;
+}
+
+void set_thread_pool_affinity(boost::asio::thread_pool& pool, std::size_t num_threads,
+                              const CpuSet& cpu_set, AffinityMode mode, std::string_view pool_name) {
+    std::mutex mutex;
+    std::condition_variable all_arrived;
+    std::size_t num_arrived{0};
+    std::size_t num_done{0};
+
+    // Each task holds its thread until all the tasks have started, so that every thread gets exactly one of them
+    for (std::size_t i{0}; i < num_threads; ++i) {
+        boost::asio::post(pool, [&]() {
+            std::unique_lock lock{mutex};
+            const std::size_t thread_index{num_arrived++};
+            const auto name{std::string{pool_name} + std::to_string(thread_index)};
+            log::set_thread_name(name.c_str());
+            const auto thread_cpus{thread_cpu_set(cpu_set, mode, thread_index)};
+            if (!thread_cpus.empty() && !set_thread_affinity(thread_cpus)) {
+                SILK_WARN << "Cannot pin thread " << name << " to cpus: " << to_string(thread_cpus);
+            }
+            SILK_INFO << "Thread " << name << " placement " << thread_placement();
+            all_arrived.notify_all();
+            all_arrived.wait(lock, [&]() { return num_arrived == num_threads; });
+            if (++num_done == num_threads) {
+                all_arrived.notify_all();
+            }
+        });
+    }
+
+    // Wait until all the tasks are done touching the synchronization state living on this stack frame
+    std::unique_lock lock{mutex};
+    all_arrived.wait(lock, [&]() { return num_done == num_threads; });
+}
+
+}  // namespace silkworm::concurrency
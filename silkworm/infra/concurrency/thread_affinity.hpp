@@ -0,0 +1,72 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <boost/asio/thread_pool.hpp>
+
+namespace silkworm::concurrency {
+
+//! Sorted set of logical CPU indices
+using CpuSet = std::vector<uint32_t>;
+
+//! The placement policy of execution threads over their CPU set
+enum class AffinityMode {
+    shared,         // all threads may run on any CPU in the set
+    per_cpu,        // each thread is pinned to one CPU in the set, round-robin
+    per_numa_node,  // each thread is pinned to the CPUs in the set of one NUMA node, round-robin
+};
+
+//! Parse a CPU list in Linux cpuset format (e.g. "0-3,8,10-11") into a sorted set without duplicates
+//! \throws std::invalid_argument if the list is malformed
+CpuSet parse_cpu_set(std::string_view cpu_list);
+
+//! Format a CPU set in Linux cpuset format collapsing consecutive CPUs into ranges
+std::string to_string(const CpuSet& cpu_set);
+
+//! The CPU set of each NUMA node indexed by node, empty if the topology is unknown (i.e. non-Linux platforms)
+std::vector<CpuSet> numa_nodes();
+
+//! The NUMA node the CPU belongs to, if known
+std::optional<uint32_t> numa_node_of(uint32_t cpu);
+
+//! The CPU set assigned to the execution thread having the specified index according to the placement policy
+//! \return the empty set if \p cpu_set is empty, i.e. no pinning
+CpuSet thread_cpu_set(const CpuSet& cpu_set, AffinityMode mode, std::size_t thread_index);
+
+//! Pin the calling thread to the CPU set, threads created afterwards by the calling thread inherit the same set
+//! \return true if successful, false if the CPU set is empty or invalid or pinning is not supported on this platform
+bool set_thread_affinity(const CpuSet& cpu_set);
+
+//! The CPU set the calling thread is allowed to run on, empty if not supported on this platform
+CpuSet get_thread_affinity();
+
+//! Describe where the calling thread runs, i.e. allowed CPUs and their NUMA nodes
+std::string thread_placement();
+
+//! Pin each thread in the pool to its CPU set according to the placement policy, reporting the placement in the log
+//! \warning \p num_threads must be the number of threads in the pool, otherwise this call never returns
+void set_thread_pool_affinity(boost::asio::thread_pool& pool, std::size_t num_threads,
+                              const CpuSet& cpu_set, AffinityMode mode, std::string_view pool_name);
+
+}  // namespace silkworm::concurrency
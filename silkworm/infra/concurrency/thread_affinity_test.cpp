@@ -0,0 +1,110 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "thread_affinity.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+
+#include <boost/asio/thread_pool.hpp>
+#include <catch2/catch.hpp>
+
+#include <silkworm/infra/test/log.hpp>
+
+namespace silkworm::concurrency {
+
+TEST_CASE("parse_cpu_set", "[silkworm][concurrency][thread_affinity]") {
+    CHECK(parse_cpu_set("").empty());
+    CHECK(parse_cpu_set("3") == CpuSet{3});
+    CHECK(parse_cpu_set("0-3") == CpuSet{0, 1, 2, 3});
+    CHECK(parse_cpu_set("8,0-2, 10-11\n") == CpuSet{0, 1, 2, 8, 10, 11});
+    CHECK(parse_cpu_set("1-2,2,1") == CpuSet{1, 2});
+
+    CHECK_THROWS_AS(parse_cpu_set("a"), std::invalid_argument);
+    CHECK_THROWS_AS(parse_cpu_set("1,,2"), std::invalid_argument);
+    CHECK_THROWS_AS(parse_cpu_set("3-1"), std::invalid_argument);
+    CHECK_THROWS_AS(parse_cpu_set("1-"), std::invalid_argument);
+    CHECK_THROWS_AS(parse_cpu_set("-1"), std::invalid_argument);
+}
+
+TEST_CASE("to_string", "[silkworm][concurrency][thread_affinity]") {
+    CHECK(to_string(CpuSet{}).empty());
+    CHECK(to_string(CpuSet{5}) == "5");
+    CHECK(to_string(CpuSet{0, 1, 2, 3, 8, 10, 11}) == "0-3,8,10-11");
+    CHECK(parse_cpu_set(to_string(CpuSet{1, 3, 4, 5, 7})) == CpuSet{1, 3, 4, 5, 7});
+}
+
+TEST_CASE("thread_cpu_set", "[silkworm][concurrency][thread_affinity]") {
+    const CpuSet cpu_set{2, 3, 4};
+
+    SECTION("no pinning") {
+        CHECK(thread_cpu_set({}, AffinityMode::shared, 0).empty());
+        CHECK(thread_cpu_set({}, AffinityMode::per_cpu, 1).empty());
+        CHECK(thread_cpu_set({}, AffinityMode::per_numa_node, 2).empty());
+    }
+
+    SECTION("shared") {
+        CHECK(thread_cpu_set(cpu_set, AffinityMode::shared, 0) == cpu_set);
+        CHECK(thread_cpu_set(cpu_set, AffinityMode::shared, 5) == cpu_set);
+    }
+
+    SECTION("per_cpu") {
+        CHECK(thread_cpu_set(cpu_set, AffinityMode::per_cpu, 0) == CpuSet{2});
+        CHECK(thread_cpu_set(cpu_set, AffinityMode::per_cpu, 2) == CpuSet{4});
+        CHECK(thread_cpu_set(cpu_set, AffinityMode::per_cpu, 3) == CpuSet{2});
+    }
+
+    SECTION("per_numa_node") {
+        // Whatever the topology, each thread gets a non-empty subset of the CPUs
+        for (std::size_t i{0}; i < 4; ++i) {
+            const auto node_cpu_set{thread_cpu_set(cpu_set, AffinityMode::per_numa_node, i)};
+            REQUIRE(!node_cpu_set.empty());
+            CHECK(std::includes(cpu_set.cbegin(), cpu_set.cend(), node_cpu_set.cbegin(), node_cpu_set.cend()));
+        }
+    }
+}
+
+#if defined(__linux__)
+TEST_CASE("set_thread_affinity", "[silkworm][concurrency][thread_affinity]") {
+    const auto allowed_cpus{get_thread_affinity()};
+    REQUIRE(!allowed_cpus.empty());
+
+    std::thread pinned_thread{[&]() {
+        CHECK(!set_thread_affinity({}));
+        CHECK(set_thread_affinity({allowed_cpus.back()}));
+        CHECK(get_thread_affinity() == CpuSet{allowed_cpus.back()});
+        CHECK(thread_placement().starts_with("cpus: " + std::to_string(allowed_cpus.back())));
+    }};
+    pinned_thread.join();
+
+    // Pinning another thread does not affect the calling one
+    CHECK(get_thread_affinity() == allowed_cpus);
+}
+
+TEST_CASE("set_thread_pool_affinity", "[silkworm][concurrency][thread_affinity]") {
+    test::SetLogVerbosityGuard guard{log::Level::kNone};
+    const auto allowed_cpus{get_thread_affinity()};
+    REQUIRE(!allowed_cpus.empty());
+
+    constexpr std::size_t kNumThreads{3};
+    boost::asio::thread_pool pool{kNumThreads};
+    CHECK_NOTHROW(set_thread_pool_affinity(pool, kNumThreads, allowed_cpus, AffinityMode::per_cpu, "test_worker_"));
+    pool.join();
+}
+#endif  // defined(__linux__)
+
+}  // namespace silkworm::concurrency
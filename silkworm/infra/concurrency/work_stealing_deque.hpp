@@ -0,0 +1,146 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+namespace silkworm::concurrency {
+
+//! Lock-free work-stealing deque by Chase and Lev with the C11 memory model mapping by Lê, Pop, Cohen and Zappa Nardelli
+//! @details The owner thread pushes and pops at the bottom (LIFO), any other thread steals from the top (FIFO).
+//! The standalone fences of the original mapping are folded into sequentially consistent accesses, which are
+//! supported by thread sanitizer.
+//! The circular buffer grows as needed and the retired buffers are kept until destruction, since thieves may still be
+//! reading from them.
+//! @see "Dynamic Circular Work-Stealing Deque" [https://doi.org/10.1145/1073970.1073974]
+//! @see "Correct and Efficient Work-Stealing for Weak Memory Models" [https://doi.org/10.1145/2442516.2442524]
+template <typename T>
+class WorkStealingDeque {
+    static_assert(std::is_trivially_copyable_v<T>, "WorkStealingDeque items must be trivially copyable");
+
+  public:
+    explicit WorkStealingDeque(std::size_t initial_capacity = 1'024) {
+        std::size_t capacity{1};
+        while (capacity < initial_capacity) capacity <<= 1;
+        buffers_.push_back(std::make_unique<Buffer>(capacity));
+        buffer_.store(buffers_.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    //! Push the item at the bottom, must be called by the owner thread only
+    void push(T item) {
+        const int64_t bottom = bottom_.load(std::memory_order_relaxed);
+        const int64_t top = top_.load(std::memory_order_acquire);
+        Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+        if (bottom - top > static_cast<int64_t>(buffer->capacity()) - 1) {
+            buffer = grow(buffer, bottom, top);
+        }
+        buffer->put(bottom, item);
+        bottom_.store(bottom + 1, std::memory_order_release);
+    }
+
+    //! Pop the item at the bottom (if any), must be called by the owner thread only
+    std::optional<T> pop() {
+        const int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+        Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+        bottom_.store(bottom, std::memory_order_seq_cst);
+        int64_t top = top_.load(std::memory_order_seq_cst);
+        if (top > bottom) {
+            // Empty deque
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+            return std::nullopt;
+        }
+        std::optional<T> item{buffer->get(bottom)};
+        if (top == bottom) {
+            // Last item: race against thieves
+            if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                item.reset();
+            }
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return item;
+    }
+
+    //! Steal the item at the top (if any), may be called by any thread
+    std::optional<T> steal() {
+        int64_t top = top_.load(std::memory_order_seq_cst);
+        const int64_t bottom = bottom_.load(std::memory_order_seq_cst);
+        if (top >= bottom) {
+            return std::nullopt;
+        }
+        Buffer* buffer = buffer_.load(std::memory_order_acquire);
+        const T item = buffer->get(top);
+        if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return std::nullopt;  // lost the race against the owner or another thief
+        }
+        return item;
+    }
+
+    //! The approximate number of items, exact only if called by the owner thread when no steal is in progress
+    [[nodiscard]] std::size_t size() const {
+        const int64_t bottom = bottom_.load(std::memory_order_relaxed);
+        const int64_t top = top_.load(std::memory_order_relaxed);
+        return bottom > top ? static_cast<std::size_t>(bottom - top) : 0;
+    }
+
+    [[nodiscard]] bool empty() const { return size() == 0; }
+
+  private:
+    class Buffer {
+      public:
+        explicit Buffer(std::size_t capacity) : mask_{capacity - 1}, items_{std::make_unique<std::atomic<T>[]>(capacity)} {}
+
+        [[nodiscard]] std::size_t capacity() const { return mask_ + 1; }
+
+        void put(int64_t index, T item) {
+            items_[static_cast<std::size_t>(index) & mask_].store(item, std::memory_order_relaxed);
+        }
+        T get(int64_t index) const {
+            return items_[static_cast<std::size_t>(index) & mask_].load(std::memory_order_relaxed);
+        }
+
+      private:
+        std::size_t mask_;
+        std::unique_ptr<std::atomic<T>[]> items_;
+    };
+
+    Buffer* grow(Buffer* buffer, int64_t bottom, int64_t top) {
+        buffers_.push_back(std::make_unique<Buffer>(buffer->capacity() * 2));
+        Buffer* bigger = buffers_.back().get();
+        for (int64_t i{top}; i < bottom; ++i) {
+            bigger->put(i, buffer->get(i));
+        }
+        buffer_.store(bigger, std::memory_order_release);
+        return bigger;
+    }
+
+    alignas(64) std::atomic<int64_t> top_{0};
+    alignas(64) std::atomic<int64_t> bottom_{0};
+    alignas(64) std::atomic<Buffer*> buffer_{nullptr};
+
+    //! All the buffers ever allocated, owned here because thieves may read from retired ones
+    std::vector<std::unique_ptr<Buffer>> buffers_;
+};
+
+}  // namespace silkworm::concurrency
@@ -0,0 +1,88 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "work_stealing_deque.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace silkworm::concurrency {
+
+TEST_CASE("WorkStealingDeque: owner push/pop", "[silkworm][concurrency][work_stealing_deque]") {
+    WorkStealingDeque<int> deque{2};
+    CHECK(deque.empty());
+    CHECK(!deque.pop());
+    CHECK(!deque.steal());
+
+    for (int i{0}; i < 10; ++i) {  // grow beyond initial capacity
+        deque.push(i);
+    }
+    CHECK(deque.size() == 10);
+    CHECK(deque.steal() == 0);  // thieves take the oldest
+    CHECK(deque.pop() == 9);    // owner takes the newest
+    CHECK(deque.pop() == 8);
+    CHECK(deque.steal() == 1);
+    CHECK(deque.size() == 6);
+    for (int i{7}; i >= 2; --i) {
+        CHECK(deque.pop() == i);
+    }
+    CHECK(deque.empty());
+    CHECK(!deque.pop());
+}
+
+TEST_CASE("WorkStealingDeque: concurrent steal", "[silkworm][concurrency][work_stealing_deque]") {
+    constexpr int kNumItems{100'000};
+    constexpr int kNumThieves{3};
+    WorkStealingDeque<int> deque{16};
+    std::vector<std::atomic<int>> taken(kNumItems);
+    std::atomic_bool done{false};
+
+    std::vector<std::thread> thieves;
+    for (int t{0}; t < kNumThieves; ++t) {
+        thieves.emplace_back([&]() {
+            while (!done || !deque.empty()) {
+                if (const auto item = deque.steal()) {
+                    ++taken[static_cast<std::size_t>(*item)];
+                }
+            }
+        });
+    }
+    for (int i{0}; i < kNumItems; ++i) {
+        deque.push(i);
+        if (i % 3 == 0) {
+            if (const auto item = deque.pop()) {
+                ++taken[static_cast<std::size_t>(*item)];
+            }
+        }
+    }
+    while (const auto item = deque.pop()) {
+        ++taken[static_cast<std::size_t>(*item)];
+    }
+    done = true;
+    for (auto& thief : thieves) {
+        thief.join();
+    }
+
+    // Each item must have been taken exactly once, either by the owner or by one thief
+    for (int i{0}; i < kNumItems; ++i) {
+        CHECK(taken[static_cast<std::size_t>(i)] == 1);
+    }
+}
+
+}  // namespace silkworm::concurrency
@@ -95,7 +95,9 @@ ClientContextPool::ClientContextPool(std::size_t pool_size, concurrency::WaitMod
 }
 
 ClientContextPool::ClientContextPool(concurrency::ContextPoolSettings settings)
-    : ClientContextPool(settings.num_contexts, settings.wait_mode) {}
+    : ClientContextPool(settings.num_contexts, settings.wait_mode) {
+    set_affinity(std::move(settings.cpu_set), settings.affinity_mode);
+}
 
 void ClientContextPool::start() {
     // Cannot restart because ::grpc::CompletionQueue inside agrpc::GrpcContext cannot be reused
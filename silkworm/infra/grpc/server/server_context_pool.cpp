@@ -125,6 +125,7 @@ ServerContextPool::ServerContextPool(std::size_t pool_size) : ContextPool(pool_s
 ServerContextPool::ServerContextPool(concurrency::ContextPoolSettings settings,
                                      const ServerCompletionQueueFactory& queue_factory)
     : ServerContextPool(settings.num_contexts) {
+    set_affinity(std::move(settings.cpu_set), settings.affinity_mode);
     // Create as many execution contexts as required by the pool size
     for (std::size_t i{0}; i < settings.num_contexts; ++i) {
         add_context(queue_factory(), settings.wait_mode);
@@ -0,0 +1,142 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "exposition_server.hpp"
+
+#include <exception>
+#include <utility>
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/read_until.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/asio/write.hpp>
+#include <gsl/util>
+
+#include <silkworm/infra/common/log.hpp>
+#include <silkworm/infra/concurrency/awaitable_wait_for_all.hpp>
+#include <silkworm/infra/concurrency/awaitable_wait_for_one.hpp>
+#include <silkworm/infra/concurrency/timeout.hpp>
+
+namespace silkworm::metrics {
+
+using boost::asio::ip::tcp;
+
+//! Upper limit for the request head, the body (if any) is never read
+constexpr std::size_t kMaxRequestSize{8 * 1024};
+
+constexpr std::string_view kMetricsPath{"/metrics"};
+
+ExpositionServer::ExpositionServer(std::string end_point, Registry& registry)
+    : end_point_{std::move(end_point)}, registry_{registry} {}
+
+Task<void> ExpositionServer::run() {
+    const auto separator{end_point_.rfind(':')};
+    const auto host{end_point_.substr(0, separator)};
+    const auto port{separator == std::string::npos ? std::string{} : end_point_.substr(separator + 1)};
+
+    auto executor = co_await boost::asio::this_coro::executor;
+    tcp::resolver resolver{executor};
+    const auto endpoints = co_await resolver.async_resolve(host, port, boost::asio::use_awaitable);
+    const tcp::endpoint endpoint{endpoints.begin()->endpoint()};
+
+    tcp::acceptor acceptor{executor};
+    acceptor.open(endpoint.protocol());
+    acceptor.set_option(tcp::acceptor::reuse_address(true));
+    acceptor.bind(endpoint);
+    acceptor.listen();
+    log::Info("Metrics", {"endpoint", end_point_, "path", std::string{kMetricsPath}});
+
+    using namespace concurrency::awaitable_wait_for_all;
+    concurrency::TaskGroup connections{executor, kMaxConnections};
+    co_await (accept_connections(acceptor, connections) && connections.wait());
+}
+
+Task<void> ExpositionServer::accept_connections(tcp::acceptor& acceptor, concurrency::TaskGroup& connections) {
+    auto executor = co_await boost::asio::this_coro::executor;
+    while (acceptor.is_open()) {
+        auto socket = co_await acceptor.async_accept(boost::asio::use_awaitable);
+        if (num_connections_ >= kMaxConnections) {
+            SILK_DEBUG << "ExpositionServer::accept_connections too many connections, closing the new one";
+            boost::system::error_code ec;
+            socket.close(ec);
+            continue;
+        }
+        ++num_connections_;
+        connections.spawn(executor, serve(std::move(socket)));
+    }
+}
+
+Task<void> ExpositionServer::serve(tcp::socket socket) {
+    using namespace concurrency::awaitable_wait_for_one;
+    auto _ = gsl::finally([this] { --num_connections_; });
+
+    // Any error is confined to this connection: the task group would rethrow it on the executor
+    try {
+        co_await (exchange(socket) || concurrency::timeout(kConnectionTimeout));
+    } catch (const concurrency::TimeoutExpiredError&) {
+        SILK_DEBUG << "ExpositionServer::serve connection timed out";
+    } catch (const std::exception& e) {
+        SILK_DEBUG << "ExpositionServer::serve connection error: " << e.what();
+    }
+
+    boost::system::error_code ec;
+    socket.shutdown(tcp::socket::shutdown_both, ec);
+    socket.close(ec);
+}
+
+Task<void> ExpositionServer::exchange(tcp::socket& socket) const {
+    std::string request;
+    co_await boost::asio::async_read_until(socket, boost::asio::dynamic_buffer(request, kMaxRequestSize), "\r\n\r\n",
+                                           boost::asio::use_awaitable);
+    const auto request_line{std::string_view{request}.substr(0, request.find("\r\n"))};
+    const auto response{handle(request_line)};
+    co_await boost::asio::async_write(socket, boost::asio::buffer(response), boost::asio::use_awaitable);
+}
+
+std::string ExpositionServer::handle(std::string_view request_line) const {
+    // Request line is <method> <target> <version>, a query string in target is accepted and ignored
+    const auto method_end{request_line.find(' ')};
+    const auto method{request_line.substr(0, method_end)};
+    std::string_view target;
+    if (method_end != std::string_view::npos) {
+        target = request_line.substr(method_end + 1);
+        target = target.substr(0, target.find(' '));
+        target = target.substr(0, target.find('?'));
+    }
+
+    std::string status{"200 OK"};
+    std::string content_type{"text/plain; version=0.0.4; charset=utf-8"};
+    std::string body;
+    if (method != "GET") {
+        status = "405 Method Not Allowed";
+        content_type = "text/plain";
+    } else if (target != kMetricsPath) {
+        status = "404 Not Found";
+        content_type = "text/plain";
+    } else {
+        body = registry_.expose();
+    }
+
+    std::string response{"HTTP/1.1 " + status + "\r\n"};
+    response += "Content-Type: " + content_type + "\r\n";
+    response += "Content-Length: " + std::to_string(body.size()) + "\r\n";
+    response += "Connection: close\r\n\r\n";
+    response += body;
+    return response;
+}
+
+}  // namespace silkworm::metrics
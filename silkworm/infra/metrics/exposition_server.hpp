@@ -0,0 +1,68 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include <silkworm/infra/concurrency/task.hpp>
+
+#include <boost/asio/ip/tcp.hpp>
+
+#include <silkworm/infra/concurrency/task_group.hpp>
+#include <silkworm/infra/metrics/registry.hpp>
+
+namespace silkworm::metrics {
+
+//! \brief Minimal HTTP server answering GET /metrics with the registry content in Prometheus text format
+//! \details Each connection is served by its own task on the executor running the server, within a deadline for the
+//! whole exchange, so that a stalled client neither blocks the next scrapes nor holds its socket forever. Connections
+//! beyond kMaxConnections in flight are closed at once
+class ExpositionServer {
+  public:
+    //! The maximum number of connections served at the same time
+    static constexpr std::size_t kMaxConnections{16};
+
+    //! The deadline for reading the request and writing the response of a connection
+    static constexpr std::chrono::milliseconds kConnectionTimeout{10'000};
+
+    //! \param end_point [in] : the listening end-point as <address>:<port>
+    explicit ExpositionServer(std::string end_point, Registry& registry = default_registry());
+
+    ExpositionServer(const ExpositionServer&) = delete;
+    ExpositionServer& operator=(const ExpositionServer&) = delete;
+
+    //! \brief Accepts and serves connections until cancelled
+    Task<void> run();
+
+    //! \brief Builds the HTTP response to the given request line (e.g. "GET /metrics HTTP/1.1")
+    [[nodiscard]] std::string handle(std::string_view request_line) const;
+
+  private:
+    Task<void> accept_connections(boost::asio::ip::tcp::acceptor& acceptor, concurrency::TaskGroup& connections);
+    Task<void> serve(boost::asio::ip::tcp::socket socket);
+    Task<void> exchange(boost::asio::ip::tcp::socket& socket) const;
+
+    std::string end_point_;
+    Registry& registry_;
+    std::atomic<std::size_t> num_connections_{0};
+};
+
+}  // namespace silkworm::metrics
@@ -0,0 +1,44 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "exposition_server.hpp"
+
+#include <string>
+
+#include <catch2/catch.hpp>
+
+namespace silkworm::metrics {
+
+static bool contains(const std::string& text, const std::string& line) {
+    return text.find(line) != std::string::npos;
+}
+
+TEST_CASE("ExpositionServer response", "[silkworm][infra][metrics]") {
+    Registry registry;
+    registry.counter("test_total", "Total").inc();
+    ExpositionServer server{"localhost:0", registry};
+
+    const auto metrics{server.handle("GET /metrics HTTP/1.1")};
+    CHECK(metrics.starts_with("HTTP/1.1 200 OK\r\n"));
+    CHECK(contains(metrics, "Content-Type: text/plain; version=0.0.4"));
+    CHECK(contains(metrics, "\r\n\r\n# HELP test_total Total\n"));
+
+    CHECK(server.handle("GET /metrics?x=1 HTTP/1.1").starts_with("HTTP/1.1 200 OK\r\n"));
+    CHECK(server.handle("GET / HTTP/1.1").starts_with("HTTP/1.1 404 Not Found\r\n"));
+    CHECK(server.handle("POST /metrics HTTP/1.1").starts_with("HTTP/1.1 405 Method Not Allowed\r\n"));
+}
+
+}  // namespace silkworm::metrics
@@ -0,0 +1,241 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "registry.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace silkworm::metrics {
+
+uint64_t Counter::value() const noexcept {
+    uint64_t total{0};
+    for (const auto& shard : shards_) {
+        total += shard.value.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+std::size_t Histogram::bucket_index(uint64_t value) noexcept {
+    if (value < kSubBuckets) {
+        return static_cast<std::size_t>(value);
+    }
+    const auto msb{static_cast<unsigned>(std::bit_width(value) - 1)};
+    if (msb >= kMaxBits) {
+        return kBuckets - 1;
+    }
+    const unsigned shift{msb - kSubBucketBits};
+    return static_cast<std::size_t>((msb - kSubBucketBits + 1) * kSubBuckets + ((value >> shift) & (kSubBuckets - 1)));
+}
+
+uint64_t Histogram::bucket_upper_bound(std::size_t index) noexcept {
+    if (index < kSubBuckets) {
+        return index;
+    }
+    const auto shift{static_cast<unsigned>(index / kSubBuckets - 1)};
+    const uint64_t sub_bucket{index % kSubBuckets};
+    return ((kSubBuckets + sub_bucket + 1) << shift) - 1;
+}
+
+Histogram::Snapshot Histogram::snapshot() const {
+    Snapshot snapshot;
+    snapshot.buckets.resize(kBuckets);
+    for (std::size_t s{0}; s < kShards; ++s) {
+        const Shard& shard{shards_[s]};
+        for (std::size_t i{0}; i < kBuckets; ++i) {
+            const uint64_t bucket_count{shard.buckets[i].load(std::memory_order_relaxed)};
+            snapshot.buckets[i] += bucket_count;
+            snapshot.count += bucket_count;
+        }
+        snapshot.sum += shard.sum.load(std::memory_order_relaxed);
+    }
+    return snapshot;
+}
+
+uint64_t Histogram::Snapshot::quantile(double q) const noexcept {
+    if (count == 0) {
+        return 0;
+    }
+    auto rank{static_cast<uint64_t>(std::ceil(q * static_cast<double>(count)))};
+    rank = std::clamp<uint64_t>(rank, 1, count);
+    uint64_t cumulative{0};
+    for (std::size_t i{0}; i < buckets.size(); ++i) {
+        cumulative += buckets[i];
+        if (cumulative >= rank) {
+            return bucket_upper_bound(i);
+        }
+    }
+    return bucket_upper_bound(buckets.size() - 1);
+}
+
+template <typename Metric>
+Family<Metric>& Registry::family(std::string_view name, std::string_view help, std::string_view label_name,
+                                 double unit) {
+    std::scoped_lock lock{mutex_};
+    auto it{entries_.find(name)};
+    if (it == entries_.end()) {
+        Entry entry{std::string{help}, unit, std::make_unique<Family<Metric>>(std::string{label_name})};
+        it = entries_.emplace(std::string{name}, std::move(entry)).first;
+    }
+    auto* family{std::get_if<std::unique_ptr<Family<Metric>>>(&it->second.metric)};
+    if (family == nullptr || (*family)->label_name() != label_name) {
+        throw std::invalid_argument{"metric already registered with another type or label: " + std::string{name}};
+    }
+    return **family;
+}
+
+Family<Counter>& Registry::counter_family(std::string_view name, std::string_view help, std::string_view label_name) {
+    return family<Counter>(name, help, label_name, 1.0);
+}
+
+Family<Gauge>& Registry::gauge_family(std::string_view name, std::string_view help, std::string_view label_name) {
+    return family<Gauge>(name, help, label_name, 1.0);
+}
+
+Family<Histogram>& Registry::histogram_family(std::string_view name, std::string_view help,
+                                              std::string_view label_name, double unit) {
+    return family<Histogram>(name, help, label_name, unit);
+}
+
+void Registry::add_callback(std::string_view name, std::string_view help, CallbackMetric metric) {
+    std::scoped_lock lock{mutex_};
+    auto it{entries_.find(name)};
+    if (it == entries_.end()) {
+        entries_.emplace(std::string{name}, Entry{std::string{help}, 1.0, std::move(metric)});
+        return;
+    }
+    auto* callback_metric{std::get_if<CallbackMetric>(&it->second.metric)};
+    if (callback_metric == nullptr || callback_metric->is_counter != metric.is_counter) {
+        throw std::invalid_argument{"metric already registered with another type: " + std::string{name}};
+    }
+    *callback_metric = std::move(metric);
+}
+
+void Registry::counter_callback(std::string_view name, std::string_view help, Callback callback) {
+    add_callback(name, help, CallbackMetric{.is_counter = true, .callback = std::move(callback)});
+}
+
+void Registry::gauge_callback(std::string_view name, std::string_view help, Callback callback) {
+    add_callback(name, help, CallbackMetric{.is_counter = false, .callback = std::move(callback)});
+}
+
+namespace {
+
+    void write_escaped(std::ostream& out, std::string_view text, bool quotes) {
+        for (const char c : text) {
+            if (c == '\\') {
+                out << "\\\\";
+            } else if (c == '\n') {
+                out << "\\n";
+            } else if (quotes && c == '"') {
+                out << "\\\"";
+            } else {
+                out << c;
+            }
+        }
+    }
+
+    void write_header(std::ostream& out, std::string_view name, std::string_view help, std::string_view type) {
+        out << "# HELP " << name << ' ';
+        write_escaped(out, help, /*quotes=*/false);
+        out << "\n# TYPE " << name << ' ' << type << '\n';
+    }
+
+    //! Writes the series name followed by its labels, if any: the quantile one is appended for summaries
+    void write_series(std::ostream& out, std::string_view name, std::string_view label_name,
+                      std::string_view label_value, std::string_view quantile = {}) {
+        out << name;
+        if (label_name.empty() && quantile.empty()) {
+            out << ' ';
+            return;
+        }
+        out << '{';
+        if (!label_name.empty()) {
+            out << label_name << "=\"";
+            write_escaped(out, label_value, /*quotes=*/true);
+            out << '"';
+            if (!quantile.empty()) out << ',';
+        }
+        if (!quantile.empty()) {
+            out << "quantile=\"" << quantile << '"';
+        }
+        out << "} ";
+    }
+
+    constexpr std::array<std::pair<double, std::string_view>, 4> kQuantiles{{
+        {0.5, "0.5"},
+        {0.9, "0.9"},
+        {0.99, "0.99"},
+        {0.999, "0.999"},
+    }};
+
+}  // namespace
+
+std::string Registry::expose() const {
+    std::ostringstream out;
+    out.precision(std::numeric_limits<double>::digits10);
+
+    std::scoped_lock lock{mutex_};
+    for (const auto& name_and_entry : entries_) {
+        // Named references rather than structured bindings, which cannot be captured by lambdas on all compilers
+        const std::string& name{name_and_entry.first};
+        const Entry& entry{name_and_entry.second};
+        const auto& metric{entry.metric};
+        if (const auto* counters{std::get_if<std::unique_ptr<Family<Counter>>>(&metric)}) {
+            write_header(out, name, entry.help, "counter");
+            (*counters)->for_each([&](const std::string& label_value, const Counter& counter) {
+                write_series(out, name, (*counters)->label_name(), label_value);
+                out << counter.value() << '\n';
+            });
+        } else if (const auto* gauges{std::get_if<std::unique_ptr<Family<Gauge>>>(&metric)}) {
+            write_header(out, name, entry.help, "gauge");
+            (*gauges)->for_each([&](const std::string& label_value, const Gauge& gauge) {
+                write_series(out, name, (*gauges)->label_name(), label_value);
+                out << gauge.value() << '\n';
+            });
+        } else if (const auto* histograms{std::get_if<std::unique_ptr<Family<Histogram>>>(&metric)}) {
+            write_header(out, name, entry.help, "summary");
+            const auto& label_name{(*histograms)->label_name()};
+            (*histograms)->for_each([&](const std::string& label_value, const Histogram& histogram) {
+                const auto snapshot{histogram.snapshot()};
+                for (const auto& [q, quantile] : kQuantiles) {
+                    write_series(out, name, label_name, label_value, quantile);
+                    out << static_cast<double>(snapshot.quantile(q)) * entry.unit << '\n';
+                }
+                write_series(out, name + "_sum", label_name, label_value);
+                out << static_cast<double>(snapshot.sum) * entry.unit << '\n';
+                write_series(out, name + "_count", label_name, label_value);
+                out << snapshot.count << '\n';
+            });
+        } else if (const auto* callback_metric{std::get_if<CallbackMetric>(&metric)}) {
+            write_header(out, name, entry.help, callback_metric->is_counter ? "counter" : "gauge");
+            write_series(out, name, {}, {});
+            out << callback_metric->callback() << '\n';
+        }
+    }
+    return out.str();
+}
+
+Registry& default_registry() {
+    static Registry registry;
+    return registry;
+}
+
+}  // namespace silkworm::metrics
@@ -0,0 +1,231 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+#include <absl/container/btree_map.h>
+
+namespace silkworm::metrics {
+
+//! Number of shards each metric value is split into to avoid cache-line contention among recording threads
+inline constexpr std::size_t kShards{8};
+
+//! \brief Index of the shard assigned to the calling thread, round-robin at its first recording
+inline std::size_t shard_index() noexcept {
+    static std::atomic<std::size_t> next_index{0};
+    thread_local const std::size_t index{next_index.fetch_add(1, std::memory_order_relaxed) % kShards};
+    return index;
+}
+
+//! \brief Monotonically increasing value, recording is a relaxed add on the calling thread shard
+class Counter {
+  public:
+    void inc(uint64_t n = 1) noexcept { shards_[shard_index()].value.fetch_add(n, std::memory_order_relaxed); }
+
+    [[nodiscard]] uint64_t value() const noexcept;
+
+  private:
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> value{0};
+    };
+    std::array<Shard, kShards> shards_;
+};
+
+//! \brief Value which can go up and down
+class Gauge {
+  public:
+    void set(int64_t value) noexcept { value_.store(value, std::memory_order_relaxed); }
+    void add(int64_t n) noexcept { value_.fetch_add(n, std::memory_order_relaxed); }
+    void sub(int64_t n) noexcept { value_.fetch_sub(n, std::memory_order_relaxed); }
+
+    [[nodiscard]] int64_t value() const noexcept { return value_.load(std::memory_order_relaxed); }
+
+  private:
+    std::atomic<int64_t> value_{0};
+};
+
+//! \brief Distribution of non-negative integer samples (e.g. durations in ns) in HDR-like log-linear buckets
+//! \details Values below kSubBuckets are exact, greater ones fall into kSubBuckets linear buckets per power of 2,
+//! so the relative error is bounded by 1/kSubBuckets; values beyond 2^kMaxBits go into the last bucket
+class Histogram {
+  public:
+    static constexpr unsigned kSubBucketBits{4};
+    static constexpr uint64_t kSubBuckets{1u << kSubBucketBits};
+    static constexpr unsigned kMaxBits{44};
+    static constexpr std::size_t kBuckets{(kMaxBits - kSubBucketBits + 1) * kSubBuckets};
+
+    struct Snapshot {
+        uint64_t count{0};
+        uint64_t sum{0};
+        std::vector<uint64_t> buckets;
+
+        //! \brief Upper bound of the bucket holding the q-quantile (0 <= q <= 1) sample or zero if empty
+        [[nodiscard]] uint64_t quantile(double q) const noexcept;
+    };
+
+    Histogram() : shards_{std::make_unique<Shard[]>(kShards)} {}
+
+    void record(uint64_t value) noexcept {
+        Shard& shard{shards_[shard_index()]};
+        shard.buckets[bucket_index(value)].fetch_add(1, std::memory_order_relaxed);
+        shard.sum.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] Snapshot snapshot() const;
+
+    static std::size_t bucket_index(uint64_t value) noexcept;
+    static uint64_t bucket_upper_bound(std::size_t index) noexcept;
+
+  private:
+    struct alignas(64) Shard {
+        std::array<std::atomic<uint64_t>, kBuckets> buckets{};
+        std::atomic<uint64_t> sum{0};
+    };
+    std::unique_ptr<Shard[]> shards_;
+};
+
+//! \brief Metrics sharing name and help, one per value of a single label (none for the unlabelled metric)
+//! \details Lookup of an existing metric takes a shared lock and no allocation, so callers on hot paths may either
+//! keep the returned reference or look it up each time
+template <typename Metric>
+class Family {
+  public:
+    explicit Family(std::string label_name) : label_name_{std::move(label_name)} {}
+
+    [[nodiscard]] const std::string& label_name() const { return label_name_; }
+
+    Metric& with(std::string_view label_value = {}) {
+        {
+            std::shared_lock lock{mutex_};
+            if (const auto it{series_.find(label_value)}; it != series_.end()) {
+                return *it->second;
+            }
+        }
+        std::unique_lock lock{mutex_};
+        auto& metric{series_[std::string{label_value}]};
+        if (!metric) {
+            metric = std::make_unique<Metric>();
+        }
+        return *metric;
+    }
+
+    template <typename Visitor>
+    void for_each(Visitor visitor) const {
+        std::shared_lock lock{mutex_};
+        for (const auto& [label_value, metric] : series_) {
+            visitor(label_value, *metric);
+        }
+    }
+
+  private:
+    std::string label_name_;
+    mutable std::shared_mutex mutex_;
+    absl::btree_map<std::string, std::unique_ptr<Metric>, std::less<>> series_;
+};
+
+//! \brief Collection of named metrics exposed in Prometheus text format
+//! \details Registering a name again returns the existing metric (or replaces the callback), registering it with
+//! another type throws std::invalid_argument. Returned references are stable for the registry lifetime
+class Registry {
+  public:
+    using Callback = std::function<double()>;
+
+    Registry() = default;
+
+    Registry(const Registry&) = delete;
+    Registry& operator=(const Registry&) = delete;
+
+    Counter& counter(std::string_view name, std::string_view help) { return counter_family(name, help, {}).with(); }
+    Gauge& gauge(std::string_view name, std::string_view help) { return gauge_family(name, help, {}).with(); }
+
+    //! \param unit [in] : scale applied to samples on exposition (e.g. 1e-9 for durations recorded in ns)
+    Histogram& histogram(std::string_view name, std::string_view help, double unit = 1.0) {
+        return histogram_family(name, help, {}, unit).with();
+    }
+
+    Family<Counter>& counter_family(std::string_view name, std::string_view help, std::string_view label_name);
+    Family<Gauge>& gauge_family(std::string_view name, std::string_view help, std::string_view label_name);
+    Family<Histogram>& histogram_family(std::string_view name, std::string_view help, std::string_view label_name,
+                                        double unit = 1.0);
+
+    //! \brief Metrics whose values are sampled at exposition, e.g. counters already kept by other components
+    void counter_callback(std::string_view name, std::string_view help, Callback callback);
+    void gauge_callback(std::string_view name, std::string_view help, Callback callback);
+
+    //! \brief Current value of all metrics in Prometheus text exposition format (version 0.0.4)
+    //! \remarks Histograms are exposed as summaries with precomputed quantiles
+    [[nodiscard]] std::string expose() const;
+
+  private:
+    struct CallbackMetric {
+        bool is_counter{false};
+        Callback callback;
+    };
+
+    struct Entry {
+        std::string help;
+        double unit{1.0};
+        std::variant<std::unique_ptr<Family<Counter>>,
+                     std::unique_ptr<Family<Gauge>>,
+                     std::unique_ptr<Family<Histogram>>,
+                     CallbackMetric>
+            metric;
+    };
+
+    template <typename Metric>
+    Family<Metric>& family(std::string_view name, std::string_view help, std::string_view label_name, double unit);
+    void add_callback(std::string_view name, std::string_view help, CallbackMetric metric);
+
+    mutable std::mutex mutex_;
+    std::map<std::string, Entry, std::less<>> entries_;
+};
+
+//! \brief The process-wide registry exposed by the metrics endpoint
+Registry& default_registry();
+
+//! \brief Records the lifetime of the timer in nanoseconds into the histogram
+class ScopedTimer {
+  public:
+    explicit ScopedTimer(Histogram& histogram) noexcept
+        : histogram_{histogram}, start_{std::chrono::steady_clock::now()} {}
+    ~ScopedTimer() {
+        const auto elapsed{std::chrono::steady_clock::now() - start_};
+        histogram_.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+  private:
+    Histogram& histogram_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace silkworm::metrics
@@ -0,0 +1,118 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "registry.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace silkworm::metrics {
+
+static bool contains(const std::string& text, const std::string& line) {
+    return text.find(line) != std::string::npos;
+}
+
+TEST_CASE("Counter sums all shards", "[silkworm][infra][metrics]") {
+    Counter counter;
+    std::vector<std::thread> threads;
+    for (int i{0}; i < 4; ++i) {
+        threads.emplace_back([&counter]() {
+            for (int j{0}; j < 1'000; ++j) counter.inc();
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    counter.inc(10);
+    CHECK(counter.value() == 4'010);
+}
+
+TEST_CASE("Histogram buckets", "[silkworm][infra][metrics]") {
+    SECTION("exact below sub-bucket count") {
+        for (uint64_t value{0}; value < Histogram::kSubBuckets; ++value) {
+            CHECK(Histogram::bucket_index(value) == value);
+            CHECK(Histogram::bucket_upper_bound(Histogram::bucket_index(value)) == value);
+        }
+    }
+    SECTION("bounded relative error") {
+        for (uint64_t value : {16ull, 17ull, 31ull, 32ull, 33ull, 1'000ull, 123'456ull, 987'654'321ull}) {
+            const auto upper_bound{Histogram::bucket_upper_bound(Histogram::bucket_index(value))};
+            CHECK(upper_bound >= value);
+            CHECK(upper_bound - value <= value / Histogram::kSubBuckets);
+        }
+    }
+    SECTION("monotonic") {
+        std::size_t previous{0};
+        for (uint64_t value{1}; value < 1'000'000; value = value * 3 / 2 + 1) {
+            const auto index{Histogram::bucket_index(value)};
+            CHECK(index >= previous);
+            previous = index;
+        }
+    }
+    SECTION("overflow goes into last bucket") {
+        CHECK(Histogram::bucket_index(~uint64_t{0}) == Histogram::kBuckets - 1);
+        CHECK(Histogram::bucket_index(uint64_t{1} << Histogram::kMaxBits) == Histogram::kBuckets - 1);
+        CHECK(Histogram::bucket_index((uint64_t{1} << Histogram::kMaxBits) - 1) == Histogram::kBuckets - 1);
+    }
+}
+
+TEST_CASE("Histogram quantiles", "[silkworm][infra][metrics]") {
+    Histogram histogram;
+    CHECK(histogram.snapshot().quantile(0.5) == 0);
+
+    for (uint64_t value{1}; value <= 100; ++value) {
+        histogram.record(value);
+    }
+    const auto snapshot{histogram.snapshot()};
+    CHECK(snapshot.count == 100);
+    CHECK(snapshot.sum == 5'050);
+    CHECK(snapshot.quantile(0.0) == 1);
+    CHECK(snapshot.quantile(0.5) >= 50);
+    CHECK(snapshot.quantile(0.5) <= 53);
+    CHECK(snapshot.quantile(1.0) >= 100);
+    CHECK(snapshot.quantile(1.0) <= 103);
+}
+
+TEST_CASE("Registry exposition", "[silkworm][infra][metrics]") {
+    Registry registry;
+    registry.counter("test_blocks_total", "Blocks").inc(3);
+    registry.gauge("test_peers", "Peers").set(-2);
+    auto& latency{registry.histogram_family("test_duration_seconds", "Latency", "method", 1e-3)};
+    latency.with("eth_call").record(2);
+    registry.gauge_callback("test_ratio", "Ratio", []() { return 0.5; });
+
+    SECTION("same name returns same metric") {
+        CHECK(&registry.counter("test_blocks_total", "Blocks") == &registry.counter("test_blocks_total", "Blocks"));
+        CHECK(&latency.with("eth_call") == &latency.with("eth_call"));
+        CHECK_THROWS_AS(registry.gauge("test_blocks_total", "Blocks"), std::invalid_argument);
+        CHECK_THROWS_AS(registry.histogram_family("test_duration_seconds", "Latency", "other"), std::invalid_argument);
+    }
+
+    SECTION("text format") {
+        const auto text{registry.expose()};
+        CHECK(contains(text, "# HELP test_blocks_total Blocks\n# TYPE test_blocks_total counter\ntest_blocks_total 3\n"));
+        CHECK(contains(text, "# TYPE test_peers gauge\ntest_peers -2\n"));
+        CHECK(contains(text, "# TYPE test_duration_seconds summary\n"));
+        CHECK(contains(text, "test_duration_seconds{method=\"eth_call\",quantile=\"0.5\"} 0.002\n"));
+        CHECK(contains(text, "test_duration_seconds_sum{method=\"eth_call\"} 0.002\n"));
+        CHECK(contains(text, "test_duration_seconds_count{method=\"eth_call\"} 1\n"));
+        CHECK(contains(text, "test_ratio 0.5\n"));
+    }
+}
+
+}  // namespace silkworm::metrics
@@ -33,6 +33,18 @@
 #include <silkworm/node/db/mdbx.hpp>
 #include <silkworm/node/db/prune_mode.hpp>
 
+namespace silkworm::snapshot {
+class SnapshotRepository;
+}
+
+namespace silkworm::concurrency {
+class TaskScheduler;
+}
+
+namespace silkworm::stagedsync {
+class BlockPreverifier;
+}
+
 namespace silkworm {
 
 struct NodeSettings {
@@ -51,6 +63,9 @@ struct NodeSettings {
     uint32_t sync_loop_throttle_seconds{0};                // Minimum interval amongst sync cycle
     uint32_t sync_loop_log_interval_seconds{30};           // Interval for sync loop to emit logs
     std::string node_name;                                 // The node identifying name
+    snapshot::SnapshotRepository* snapshot_repository{};   // Snapshot repository where blocks are frozen (if any)
+    concurrency::TaskScheduler* task_scheduler{};          // Work-stealing scheduler for CPU-bound tasks (if any)
+    stagedsync::BlockPreverifier* block_preverifier{};     // Stateless checks of new blocks started on arrival (if any)
 };
 
 }  // namespace silkworm
@@ -836,6 +836,25 @@ void write_canonical_hash(RWTxn& txn, BlockNum b, const evmc::bytes32& hash) {
     hashes_cursor->upsert(skey, svalue);
 }
 
+static std::optional<uint64_t> read_block_u64(ROTxn& txn, const MapConfig& map_config, BlockNum b) {
+    auto cursor = txn.ro_cursor(map_config);
+    auto key{db::block_key(b)};
+    auto data{cursor->find(to_slice(key), /*throw_notfound=*/false)};
+    if (!data) {
+        return std::nullopt;
+    }
+    SILKWORM_ASSERT(data.value.length() == sizeof(uint64_t));
+    return endian::load_big_u64(static_cast<const uint8_t*>(data.value.data()));
+}
+
+std::optional<uint64_t> read_cumulative_gas_used(ROTxn& txn, BlockNum b) {
+    return read_block_u64(txn, table::kCumulativeGasIndex, b);
+}
+
+std::optional<uint64_t> read_cumulative_transaction_count(ROTxn& txn, BlockNum b) {
+    return read_block_u64(txn, table::kCumulativeTransactionIndex, b);
+}
+
 void delete_canonical_hash(RWTxn& txn, BlockNum b) {
     auto hashes_cursor = txn.rw_cursor(db::table::kCanonicalHashes);
     Bytes key = db::block_key(b);
@@ -931,6 +950,41 @@ void write_last_finalized_block(RWTxn& txn, const evmc::bytes32& hash) {
     write_last_fcu_field(txn, kFinalizedBlockHash, hash);
 }
 
+//! Search the items still missing by hash in each snapshot in reverse order, doing one batch lookup per snapshot
+template <typename T, typename ViewSegments, typename LookupByHash>
+static void read_missing_from_snapshots(std::span<const Hash> hashes, std::vector<std::optional<T>>& items,
+                                        ViewSegments view_segments, LookupByHash lookup_by_hash) {
+    std::vector<std::size_t> missing_indexes;
+    for (std::size_t i{0}; i < items.size(); ++i) {
+        if (!items[i]) {
+            missing_indexes.push_back(i);
+        }
+    }
+    if (missing_indexes.empty()) {
+        return;
+    }
+
+    // We don't know the snapshots in advance: collect the missing hashes and look them up until all found
+    view_segments([&](const auto* snapshot) -> bool {
+        std::vector<Hash> missing_hashes;
+        missing_hashes.reserve(missing_indexes.size());
+        for (const auto index : missing_indexes) {
+            missing_hashes.push_back(hashes[index]);
+        }
+        auto found_items{lookup_by_hash(snapshot, missing_hashes)};
+        std::vector<std::size_t> still_missing_indexes;
+        for (std::size_t i{0}; i < found_items.size(); ++i) {
+            if (found_items[i]) {
+                items[missing_indexes[i]] = std::move(found_items[i]);
+            } else {
+                still_missing_indexes.push_back(missing_indexes[i]);
+            }
+        }
+        missing_indexes = std::move(still_missing_indexes);
+        return missing_indexes.empty();
+    });
+}
+
 void DataModel::set_snapshot_repository(snapshot::SnapshotRepository* repository) {
     ensure(repository, "DataModel::set_snapshot_repository: repository is null");
     repository_ = repository;
@@ -984,6 +1038,19 @@ std::optional<BlockHeader> DataModel::read_header(const Hash& block_hash) const
     return read_header_from_snapshot(block_hash);
 }
 
+std::vector<std::optional<BlockHeader>> DataModel::read_headers(std::span<const Hash> block_hashes) const {
+    // Assume recent blocks are more probable: first lookup each block header in the db
+    std::vector<std::optional<BlockHeader>> block_headers;
+    block_headers.reserve(block_hashes.size());
+    for (const auto& block_hash : block_hashes) {
+        block_headers.push_back(db::read_header(txn_, block_hash));
+    }
+
+    // Then search for the missing ones in the snapshots (if any) in one batch per snapshot
+    read_headers_from_snapshot(block_hashes, block_headers);
+    return block_headers;
+}
+
 std::optional<BlockNum> DataModel::read_block_number(const Hash& block_hash) const {
     // Assume recent blocks are more probable: first lookup the block in the db
     auto block_number{db::read_block_number(txn_, block_hash)};
@@ -1019,7 +1086,11 @@ bool DataModel::read_body(BlockNum height, HashAsArray hash, bool read_senders,
     const bool found = db::read_body(txn_, height, hash, read_senders, body);
     if (found) return found;
 
-    return read_body_from_snapshot(height, read_senders, body);
+    if (!read_body_from_snapshot(height, read_senders, body)) return false;
+
+    // Block extra data is not frozen into snapshots together with the block body
+    read_extra_block_data(txn_, block_key(height, hash), body);
+    return true;
 }
 
 bool DataModel::read_body(const Hash& hash, BlockNum height, BlockBody& body) const {
@@ -1075,14 +1146,20 @@ bool DataModel::read_block(HashAsSpan hash, BlockNum height, bool read_senders,
     const bool found = db::read_block(txn_, hash, height, read_senders, block);
     if (found) return found;
 
-    return read_block_from_snapshot(height, read_senders, block);
+    if (!read_block_from_snapshot(height, read_senders, block)) return false;
+
+    read_extra_block_data(txn_, block_key(height, hash), block);
+    return true;
 }
 
 bool DataModel::read_block(const evmc::bytes32& hash, BlockNum height, Block& block) const {
     const bool found = db::read_block(txn_, hash, height, block);
     if (found) return found;
 
-    return read_block_from_snapshot(height, /*read_senders=*/true, block);
+    if (!read_block_from_snapshot(height, /*read_senders=*/true, block)) return false;
+
+    read_extra_block_data(txn_, block_key(height, hash.bytes), block);
+    return true;
 }
 
 bool DataModel::read_block_from_snapshot(BlockNum height, bool read_senders, Block& block) {
@@ -1126,6 +1203,18 @@ std::optional<BlockHeader> DataModel::read_header_from_snapshot(const Hash& hash
     return block_header;
 }
 
+void DataModel::read_headers_from_snapshot(std::span<const Hash> hashes, std::vector<std::optional<BlockHeader>>& headers) {
+    if (!repository_) {
+        return;
+    }
+
+    read_missing_from_snapshots(
+        hashes, headers, [](const auto& walker) { repository_->view_header_segments(walker); },
+        [](const snapshot::HeaderSnapshot* snapshot, std::span<const Hash> missing_hashes) {
+            return snapshot->headers_by_hash(missing_hashes);
+        });
+}
+
 bool DataModel::read_body_from_snapshot(BlockNum height, bool read_senders, BlockBody& body) {
     if (!repository_) {
         return false;
@@ -1168,7 +1257,7 @@ bool DataModel::is_body_in_snapshot(BlockNum height) {
 }
 
 bool DataModel::read_transactions_from_snapshot(BlockNum height, uint64_t base_txn_id, uint64_t txn_count,
-                                                bool read_senders, std::vector<Transaction> txs) {
+                                                bool read_senders, std::vector<Transaction>& txs) {
     txs.reserve(txn_count);
     if (txn_count == 0) {
         return true;
@@ -1205,6 +1294,55 @@ bool DataModel::read_rlp_transactions_from_snapshot(BlockNum height, std::vector
     return false;
 }
 
+std::vector<std::optional<Transaction>> DataModel::read_transactions(std::span<const Hash> txn_hashes) const {
+    // Assume recent transactions are more probable: first lookup each transaction in the db
+    std::vector<std::optional<Transaction>> transactions;
+    transactions.reserve(txn_hashes.size());
+    const auto tx_lookup{txn_.ro_cursor(db::table::kTxLookup)};
+    for (const auto& txn_hash : txn_hashes) {
+        transactions.push_back(read_transaction(*tx_lookup, txn_hash));
+    }
+    if (!repository_) {
+        return transactions;
+    }
+
+    // Then search for the missing ones in the snapshots in one batch per snapshot
+    read_missing_from_snapshots(
+        txn_hashes, transactions, [](const auto& walker) { repository_->view_tx_segments(walker); },
+        [](const snapshot::TransactionSnapshot* snapshot, std::span<const Hash> missing_hashes) {
+            return snapshot->txns_by_hash(missing_hashes);
+        });
+    return transactions;
+}
+
+std::optional<Transaction> DataModel::read_transaction(ROCursor& tx_lookup, const Hash& txn_hash) const {
+    // Lookup values are stored as block numbers without leading zeros
+    const auto lookup_data{tx_lookup.find(to_slice(ByteView{txn_hash.bytes}), /*throw_notfound=*/false)};
+    if (!lookup_data) {
+        return std::nullopt;
+    }
+    BlockNum block_number{0};
+    if (!endian::from_big_compact(from_slice(lookup_data.value), block_number)) {
+        return std::nullopt;
+    }
+    const auto block_hash{read_canonical_hash(txn_, block_number)};
+    if (!block_hash) {
+        return std::nullopt;
+    }
+
+    // Frozen blocks may be missing here even if still referenced by the lookup table
+    BlockBody body;
+    if (!db::read_body(txn_, block_number, block_hash->bytes, /*read_senders=*/true, body)) {
+        return std::nullopt;
+    }
+    for (auto& transaction : body.transactions) {
+        if (transaction.hash() == txn_hash) {
+            return std::move(transaction);
+        }
+    }
+    return std::nullopt;
+}
+
 bool DataModel::read_rlp_transactions(BlockNum height, const evmc::bytes32& hash, std::vector<Bytes>& transactions) const {
     bool found = db::read_rlp_transactions(txn_, height, hash, transactions);
     if (found) return true;
@@ -200,6 +200,13 @@ void delete_canonical_hash(RWTxn& txn, BlockNum b);
 //! \brief Write canonical hash
 void write_canonical_hash(RWTxn& txn, BlockNum b, const evmc::bytes32& hash);
 
+//! \brief Reads the total gas used by canonical blocks up to and including b from table::kCumulativeGasIndex
+std::optional<uint64_t> read_cumulative_gas_used(ROTxn& txn, BlockNum b);
+
+//! \brief Reads the total count of transactions in canonical blocks up to and including b from
+//! table::kCumulativeTransactionIndex
+std::optional<uint64_t> read_cumulative_transaction_count(ROTxn& txn, BlockNum b);
+
 //! \brief Gets/Increments the sequence value for a given map (bucket)
 //! \param [in] map_name : the name of the map to get a sequence for
 //! \param [in] increment : the value of increments to add to the sequence.
@@ -285,6 +292,9 @@ class DataModel {
     //! Read block header with the specified hash
     [[nodiscard]] std::optional<BlockHeader> read_header(const Hash& block_hash) const;
 
+    //! Read the block headers with the specified hashes, missing ones being std::nullopt
+    [[nodiscard]] std::vector<std::optional<BlockHeader>> read_headers(std::span<const Hash> block_hashes) const;
+
     //! Read block header with the specified block number
     [[nodiscard]] std::optional<BlockHeader> read_header(BlockNum block_number) const;
 
@@ -319,15 +329,21 @@ class DataModel {
     //! Read the RLP encoded block transactions at specified height
     [[nodiscard]] bool read_rlp_transactions(BlockNum height, const evmc::bytes32& hash, std::vector<Bytes>& rlp_txs) const;
 
+    //! Read the canonical transactions (with senders) having the specified hashes, missing ones being std::nullopt
+    [[nodiscard]] std::vector<std::optional<Transaction>> read_transactions(std::span<const Hash> txn_hashes) const;
+
   private:
+    std::optional<Transaction> read_transaction(ROCursor& tx_lookup, const Hash& txn_hash) const;
+
     static bool read_block_from_snapshot(BlockNum height, bool read_senders, Block& block);
     static std::optional<BlockHeader> read_header_from_snapshot(BlockNum height);
     static std::optional<BlockHeader> read_header_from_snapshot(const Hash& hash);
+    static void read_headers_from_snapshot(std::span<const Hash> hashes, std::vector<std::optional<BlockHeader>>& headers);
     static bool read_body_from_snapshot(BlockNum height, bool read_senders, BlockBody& body);
     static bool is_body_in_snapshot(BlockNum height);
     static bool read_rlp_transactions_from_snapshot(BlockNum height, std::vector<Bytes>& rlp_txs);
     static bool read_transactions_from_snapshot(BlockNum height, uint64_t base_txn_id, uint64_t txn_count,
-                                                bool read_senders, std::vector<Transaction> txs);
+                                                bool read_senders, std::vector<Transaction>& txs);
 
     static inline snapshot::SnapshotRepository* repository_{nullptr};
 
@@ -0,0 +1,196 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "analysis_store.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include <evmone/evmone.h>
+
+#include <silkworm/core/common/endian.hpp>
+#include <silkworm/infra/common/log.hpp>
+#include <silkworm/node/db/util.hpp>
+
+namespace silkworm::db {
+
+static constexpr MapConfig kCodeAnalyses{"CodeAnalyses"};
+static constexpr MapConfig kStoreInfo{"Info"};
+static constexpr const char* kVersionKey{"version"};
+
+//! Padding appended to legacy code by evmone::baseline::analyze: a full PUSH32 argument plus a final STOP
+static constexpr size_t kCodePadding{1 + 32};
+
+//! Codes starting with the EOF magic are analyzed per container, they are not persisted
+static bool is_eof(ByteView code) { return !code.empty() && code[0] == 0xEF; }
+
+static Bytes encode_analysis(ByteView code, const evmone::baseline::CodeAnalysis::JumpdestMap& jumpdest_map) {
+    Bytes value(sizeof(uint32_t) + (code.size() + 7) / 8, '\0');
+    endian::store_big_u32(value.data(), static_cast<uint32_t>(code.size()));
+    uint8_t* bitmap{&value[sizeof(uint32_t)]};
+    for (size_t i{0}; i < std::min(code.size(), jumpdest_map.size()); ++i) {
+        if (jumpdest_map[i]) {
+            bitmap[i / 8] |= static_cast<uint8_t>(1u << (i % 8));
+        }
+    }
+    return value;
+}
+
+static std::shared_ptr<evmone::baseline::CodeAnalysis> decode_analysis(ByteView code, ByteView value) {
+    if (value.size() != sizeof(uint32_t) + (code.size() + 7) / 8 || endian::load_big_u32(value.data()) != code.size()) {
+        return nullptr;
+    }
+    const uint8_t* bitmap{&value[sizeof(uint32_t)]};
+    evmone::baseline::CodeAnalysis::JumpdestMap jumpdest_map(code.size());
+    for (size_t i{0}; i < code.size(); ++i) {
+        jumpdest_map[i] = (bitmap[i / 8] >> (i % 8)) & 1u;
+    }
+    auto padded_code{std::make_unique<uint8_t[]>(code.size() + kCodePadding)};
+    std::copy_n(code.data(), code.size(), padded_code.get());
+    std::fill_n(padded_code.get() + code.size(), kCodePadding, uint8_t{0x00});  // OP_STOP
+    return std::make_shared<evmone::baseline::CodeAnalysis>(std::move(padded_code), code.size(), std::move(jumpdest_map));
+}
+
+PersistentAnalysisStore::PersistentAnalysisStore(const std::filesystem::path& path, AnalysisStoreSettings settings)
+    : settings_{settings} {
+    EnvConfig config{
+        .path = path.string(),
+        .create = !std::filesystem::exists(get_datafile_path(path)),
+        .max_size = 8_Gibi,
+        .growth_size = 64_Mebi,
+        .max_tables = 4,
+    };
+    env_ = open_env(config);
+    check_version();
+    writer_ = std::thread{[this]() { run(); }};
+}
+
+PersistentAnalysisStore::~PersistentAnalysisStore() {
+    {
+        std::unique_lock lock{mutex_};
+        stopping_ = true;
+    }
+    pending_cv_.notify_one();
+    if (writer_.joinable()) {
+        writer_.join();
+    }
+}
+
+std::string PersistentAnalysisStore::version_tag() {
+    evmc_vm* vm{evmc_create_evmone()};
+    std::string tag{"format-" + std::to_string(kFormatVersion) + "/evmone-" + vm->version};
+    vm->destroy(vm);
+    return tag;
+}
+
+void PersistentAnalysisStore::check_version() {
+    const auto tag{version_tag()};
+    RWTxn txn{env_};
+    auto info = txn.rw_cursor(kStoreInfo);
+    const auto data{info->find(mdbx::slice{kVersionKey}, /*throw_notfound=*/false)};
+    if (data && data.value.as_string() == tag) {
+        return;
+    }
+    auto analyses = txn.rw_cursor(kCodeAnalyses);
+    if (!analyses->empty()) {
+        log::Info("Code analysis store", {"path", env_.get_path().string(), "version", tag}) << " version changed, clearing";
+        txn->clear_map(open_map(txn, kCodeAnalyses));
+    }
+    info->upsert(mdbx::slice{kVersionKey}, mdbx::slice{tag});
+    txn.commit_and_stop();
+}
+
+std::shared_ptr<evmone::baseline::CodeAnalysis> PersistentAnalysisStore::load(const evmc::bytes32& code_hash,
+                                                                              ByteView code) noexcept {
+    if (code.size() < settings_.min_code_size || is_eof(code)) {
+        return nullptr;
+    }
+    try {
+        ROTxn txn{env_};
+        auto analyses = txn.ro_cursor(kCodeAnalyses);
+        const auto data{analyses->find(to_slice(code_hash), /*throw_notfound=*/false)};
+        if (!data) {
+            return nullptr;
+        }
+        return decode_analysis(code, from_slice(data.value));
+    } catch (const std::exception& ex) {
+        log::Warning("Code analysis store") << "load failed: " << ex.what();
+        return nullptr;
+    }
+}
+
+void PersistentAnalysisStore::on_analysis(const evmc::bytes32& code_hash, ByteView code,
+                                          const evmone::baseline::CodeAnalysis& analysis) noexcept {
+    if (code.size() < settings_.min_code_size || is_eof(code)) {
+        return;
+    }
+    std::unique_lock lock{mutex_};
+    if (analyses_.size() >= settings_.max_tracked) {
+        analyses_.clear();
+    }
+    auto& count{analyses_[code_hash]};
+    if (++count != settings_.min_analyses || pending_.size() >= settings_.max_pending) {
+        return;
+    }
+    pending_.emplace_back(code_hash, encode_analysis(code, analysis.jumpdest_map));
+    lock.unlock();
+    pending_cv_.notify_one();
+}
+
+void PersistentAnalysisStore::flush() {
+    std::unique_lock lock{mutex_};
+    flushed_cv_.wait(lock, [this]() { return pending_.empty() && !writing_; });
+}
+
+size_t PersistentAnalysisStore::size() {
+    ROTxn txn{env_};
+    return txn.ro_cursor(kCodeAnalyses)->size();
+}
+
+void PersistentAnalysisStore::run() {
+    std::vector<PendingEntry> entries;
+    while (true) {
+        {
+            std::unique_lock lock{mutex_};
+            writing_ = false;
+            flushed_cv_.notify_all();
+            pending_cv_.wait(lock, [this]() { return stopping_ || !pending_.empty(); });
+            if (pending_.empty()) {
+                return;  // stopping with nothing left to write
+            }
+            entries.swap(pending_);
+            writing_ = true;
+        }
+        write(entries);
+        entries.clear();
+    }
+}
+
+void PersistentAnalysisStore::write(std::vector<PendingEntry>& entries) {
+    try {
+        RWTxn txn{env_};
+        auto analyses = txn.rw_cursor(kCodeAnalyses);
+        for (const auto& [code_hash, value] : entries) {
+            analyses->upsert(to_slice(code_hash), to_slice(value));
+        }
+        txn.commit_and_stop();
+        SILK_TRACE << "Code analysis store: written " << entries.size() << " analyses";
+    } catch (const std::exception& ex) {
+        log::Warning("Code analysis store") << "write failed: " << ex.what();
+    }
+}
+
+}  // namespace silkworm::db
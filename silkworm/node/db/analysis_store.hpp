@@ -0,0 +1,93 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <absl/container/flat_hash_map.h>
+
+#include <silkworm/core/execution/evm.hpp>
+#include <silkworm/node/db/mdbx.hpp>
+
+namespace silkworm::db {
+
+struct AnalysisStoreSettings {
+    size_t min_code_size{1_Kibi};   // Smaller codes are analyzed faster than they are looked up
+    uint32_t min_analyses{2};       // Times a code must be analyzed in this process before being persisted
+    size_t max_pending{4096};       // Analyses waiting for the writer beyond this are dropped
+    size_t max_tracked{1'000'000};  // Analysis counters are reset when tracking more codes than this
+};
+
+//! \brief AnalysisStore persisting code analyses of the most analyzed contracts in a dedicated MDBX environment
+//! \details Each entry is keyed by code hash and holds the code size followed by the jumpdest bitmap: the padded
+//! code is rebuilt from the code provided by the caller. Entries are written by a background thread, so that
+//! execution never waits for disk. The environment is wiped whenever the format version or the evmone
+//! version differ from the stored ones.
+class PersistentAnalysisStore : public AnalysisStore {
+  public:
+    static constexpr uint32_t kFormatVersion{1};
+
+    explicit PersistentAnalysisStore(const std::filesystem::path& path, AnalysisStoreSettings settings = {});
+    ~PersistentAnalysisStore() override;
+
+    PersistentAnalysisStore(const PersistentAnalysisStore&) = delete;
+    PersistentAnalysisStore& operator=(const PersistentAnalysisStore&) = delete;
+
+    std::shared_ptr<evmone::baseline::CodeAnalysis> load(const evmc::bytes32& code_hash,
+                                                         ByteView code) noexcept override;
+
+    void on_analysis(const evmc::bytes32& code_hash, ByteView code,
+                     const evmone::baseline::CodeAnalysis& analysis) noexcept override;
+
+    //! \brief Blocks until all pending analyses have been written
+    void flush();
+
+    //! \brief Number of persisted analyses
+    [[nodiscard]] size_t size();
+
+    //! \brief Version tag of the stored entries: format version and evmone version
+    static std::string version_tag();
+
+  private:
+    using PendingEntry = std::pair<evmc::bytes32, Bytes>;
+
+    void check_version();
+    void run();
+    void write(std::vector<PendingEntry>& entries);
+
+    AnalysisStoreSettings settings_;
+    mdbx::env_managed env_;
+
+    std::mutex mutex_;
+    std::condition_variable pending_cv_;
+    std::condition_variable flushed_cv_;
+    std::vector<PendingEntry> pending_;
+    absl::flat_hash_map<evmc::bytes32, uint32_t> analyses_;
+    bool writing_{false};
+    bool stopping_{false};
+    std::thread writer_;
+};
+
+}  // namespace silkworm::db
@@ -0,0 +1,88 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "analysis_store.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/core/common/cast.hpp>
+#include <silkworm/core/common/util.hpp>
+#include <silkworm/infra/common/directories.hpp>
+#include <silkworm/infra/test/log.hpp>
+
+namespace silkworm::db {
+
+TEST_CASE("PersistentAnalysisStore") {
+    test::SetLogVerbosityGuard log_guard{log::Level::kNone};
+    TemporaryDirectory tmp_dir;
+    const auto store_path{tmp_dir.path() / "analysis"};
+    const AnalysisStoreSettings settings{.min_code_size = 4, .min_analyses = 2};
+
+    // JUMPDEST PUSH1 0x5b JUMPDEST PUSH2 0x5b5b STOP: the 0x5b bytes in push data are not jump destinations
+    const Bytes code{*from_hex("5b605b5b615b5b00")};
+    const auto code_hash{bit_cast<evmc_bytes32>(keccak256(code))};
+    const auto analysis{evmone::baseline::analyze(EVMC_ISTANBUL, code)};
+
+    {
+        PersistentAnalysisStore store{store_path, settings};
+        CHECK_FALSE(store.load(code_hash, code));
+
+        // Persisted only once analyzed min_analyses times
+        store.on_analysis(code_hash, code, analysis);
+        store.flush();
+        CHECK(store.size() == 0);
+        store.on_analysis(code_hash, code, analysis);
+        store.flush();
+        CHECK(store.size() == 1);
+
+        // Codes smaller than min_code_size are neither persisted nor looked up
+        const Bytes small_code{*from_hex("5b00")};
+        const auto small_code_hash{bit_cast<evmc_bytes32>(keccak256(small_code))};
+        const auto small_analysis{evmone::baseline::analyze(EVMC_ISTANBUL, small_code)};
+        store.on_analysis(small_code_hash, small_code, small_analysis);
+        store.on_analysis(small_code_hash, small_code, small_analysis);
+        store.flush();
+        CHECK(store.size() == 1);
+    }
+
+    SECTION("load after restart") {
+        PersistentAnalysisStore store{store_path, settings};
+        const auto loaded{store.load(code_hash, code)};
+        REQUIRE(loaded);
+        CHECK(loaded->jumpdest_map == analysis.jumpdest_map);
+        CHECK(loaded->jumpdest_map[0]);
+        CHECK_FALSE(loaded->jumpdest_map[2]);
+        CHECK(loaded->jumpdest_map[3]);
+
+        // Mismatching code is refused
+        const Bytes other_code{*from_hex("5b605b5b615b5b0000")};
+        CHECK_FALSE(store.load(code_hash, other_code));
+    }
+
+    SECTION("version change clears entries") {
+        {
+            auto env{open_env(EnvConfig{.path = store_path.string()})};
+            RWTxn txn{env};
+            txn.rw_cursor(MapConfig{"Info"})->upsert(mdbx::slice{"version"}, mdbx::slice{"format-0"});
+            txn.commit_and_stop();
+        }
+        PersistentAnalysisStore store{store_path, settings};
+        CHECK(store.size() == 0);
+        CHECK_FALSE(store.load(code_hash, code));
+    }
+}
+
+}  // namespace silkworm::db
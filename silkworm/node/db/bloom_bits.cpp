@@ -0,0 +1,184 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "bloom_bits.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <ethash/keccak.hpp>
+
+#include <silkworm/core/common/endian.hpp>
+#include <silkworm/core/common/util.hpp>
+
+namespace silkworm::db::bloom_bits {
+
+bool BitVector::empty() const {
+    uint8_t acc{0};
+    for (const auto b : bytes) {
+        acc = static_cast<uint8_t>(acc | b);
+    }
+    return acc == 0;
+}
+
+BitVector& BitVector::operator&=(const BitVector& other) {
+    for (size_t i{0}; i < kBitVectorSize; ++i) {
+        bytes[i] = static_cast<uint8_t>(bytes[i] & other.bytes[i]);
+    }
+    return *this;
+}
+
+BitVector& BitVector::operator|=(const BitVector& other) {
+    for (size_t i{0}; i < kBitVectorSize; ++i) {
+        bytes[i] = static_cast<uint8_t>(bytes[i] | other.bytes[i]);
+    }
+    return *this;
+}
+
+Bytes key(uint16_t bit, uint64_t section) {
+    Bytes key(sizeof(uint16_t) + sizeof(uint64_t), '\0');
+    endian::store_big_u16(&key[0], bit);
+    endian::store_big_u64(&key[sizeof(uint16_t)], section);
+    return key;
+}
+
+Bytes section_key(uint64_t section) {
+    Bytes key(sizeof(uint64_t), '\0');
+    endian::store_big_u64(&key[0], section);
+    return key;
+}
+
+// Sparse encoding: a bitset flagging the non-zero bytes (itself recursively encoded) followed by the non-zero bytes
+static Bytes encode(ByteView data) {
+    if (data.empty()) return {};
+    if (data.size() == 1) {
+        return data[0] == 0 ? Bytes{} : Bytes{data};
+    }
+    Bytes non_zero_bitset((data.size() + 7) / 8, '\0');
+    Bytes non_zero_bytes;
+    non_zero_bytes.reserve(data.size());
+    for (size_t i{0}; i < data.size(); ++i) {
+        if (data[i] != 0) {
+            non_zero_bytes.push_back(data[i]);
+            non_zero_bitset[i / 8] = static_cast<uint8_t>(non_zero_bitset[i / 8] | (0x80u >> (i % 8)));
+        }
+    }
+    if (non_zero_bytes.empty()) return {};
+    return encode(non_zero_bitset) + non_zero_bytes;
+}
+
+// Decodes into \p out (of the original size) and returns how many bytes of \p data have been consumed
+static size_t decode(ByteView data, Bytes& out) {
+    if (out.empty() || data.empty()) return 0;
+    if (out.size() == 1) {
+        out[0] = data[0];
+        return data[0] != 0 ? 1 : 0;
+    }
+    Bytes non_zero_bitset((out.size() + 7) / 8, '\0');
+    size_t pos{decode(data, non_zero_bitset)};
+    for (size_t i{0}; i < 8 * non_zero_bitset.size(); ++i) {
+        if ((non_zero_bitset[i / 8] & (0x80u >> (i % 8))) == 0) continue;
+        if (pos >= data.size()) throw std::runtime_error("bloom bits: missing data");
+        if (i >= out.size()) throw std::runtime_error("bloom bits: exceeded target size");
+        if (data[pos] == 0) throw std::runtime_error("bloom bits: zero byte in content");
+        out[i] = data[pos++];
+    }
+    return pos;
+}
+
+Bytes compress(const BitVector& vector) {
+    const ByteView data{vector.bytes.data(), vector.bytes.size()};
+    Bytes encoded{encode(data)};
+    return encoded.size() < data.size() ? encoded : Bytes{data};
+}
+
+BitVector decompress(ByteView data) {
+    BitVector vector;
+    if (data.size() > kBitVectorSize) throw std::runtime_error("bloom bits: data exceeds vector size");
+    if (data.size() == kBitVectorSize) {
+        std::copy(data.begin(), data.end(), vector.bytes.begin());
+        return vector;
+    }
+    Bytes out(kBitVectorSize, '\0');
+    if (decode(data, out) != data.size()) throw std::runtime_error("bloom bits: unreferenced data");
+    std::copy(out.begin(), out.end(), vector.bytes.begin());
+    return vector;
+}
+
+std::array<uint16_t, 3> bloom_bit_indices(ByteView data) {
+    const ethash::hash256 hash{keccak256(data)};
+    std::array<uint16_t, 3> indices{};
+    for (size_t i{0}; i < indices.size(); ++i) {
+        indices[i] = static_cast<uint16_t>((hash.bytes[2 * i + 1] + (hash.bytes[2 * i] << 8)) & 0x7FF);
+    }
+    return indices;
+}
+
+void Generator::add_bloom(size_t index, const Bloom& bloom) {
+    for (size_t byte_index{0}; byte_index < kBloomByteLength; ++byte_index) {
+        // Bloom bit i lives in byte kBloomByteLength - 1 - i / 8 at position i % 8 (see m3_2048)
+        const uint8_t bloom_byte{bloom[kBloomByteLength - 1 - byte_index]};
+        if (bloom_byte == 0) continue;
+        for (size_t j{0}; j < 8; ++j) {
+            if (bloom_byte & (1u << j)) {
+                vectors_[byte_index * 8 + j].set(index);
+            }
+        }
+    }
+}
+
+Matcher::Matcher(const std::vector<std::vector<Bytes>>& clauses) {
+    std::vector<std::vector<std::array<uint16_t, 3>>> clause_bits;
+    for (const auto& clause : clauses) {
+        if (clause.empty()) continue;  // wildcard
+        auto& alternatives{clause_bits.emplace_back()};
+        for (const auto& alternative : clause) {
+            const auto indices{bloom_bit_indices(alternative)};
+            alternatives.push_back(indices);
+            bits_.insert(bits_.end(), indices.begin(), indices.end());
+        }
+    }
+    std::sort(bits_.begin(), bits_.end());
+    bits_.erase(std::unique(bits_.begin(), bits_.end()), bits_.end());
+
+    const auto position{[&](uint16_t bit) {
+        return static_cast<size_t>(std::lower_bound(bits_.begin(), bits_.end(), bit) - bits_.begin());
+    }};
+    for (const auto& alternatives : clause_bits) {
+        auto& positions{clauses_.emplace_back()};
+        for (const auto& indices : alternatives) {
+            positions.push_back({position(indices[0]), position(indices[1]), position(indices[2])});
+        }
+    }
+}
+
+BitVector Matcher::match(std::span<const BitVector> vectors) const {
+    BitVector result;
+    result.bytes.fill(0xFF);
+    for (const auto& alternatives : clauses_) {
+        BitVector clause_result;
+        for (const auto& positions : alternatives) {
+            BitVector alternative_result{vectors[positions[0]]};
+            alternative_result &= vectors[positions[1]];
+            alternative_result &= vectors[positions[2]];
+            clause_result |= alternative_result;
+        }
+        result &= clause_result;
+    }
+    return result;
+}
+
+}  // namespace silkworm::db::bloom_bits
@@ -0,0 +1,105 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <silkworm/core/common/base.hpp>
+#include <silkworm/core/types/bloom.hpp>
+
+//! Geth-compatible rotated bloom bits: blocks are grouped in sections and for each section every one of the
+//! 2048 bloom bits is stored as a bit vector having one bit per block, so that a filter can be matched against
+//! a whole section by combining a handful of vectors instead of visiting every block
+namespace silkworm::db::bloom_bits {
+
+//! Number of blocks grouped in a section
+inline constexpr uint64_t kSectionSize{4096};
+
+//! Number of bits in a logs bloom, i.e. number of vectors in a section
+inline constexpr uint16_t kBloomBitLength{kBloomByteLength * 8};
+
+//! Number of bytes in a (decompressed) section bit vector
+inline constexpr size_t kBitVectorSize{kSectionSize / 8};
+
+//! Uncompressed bit vector of one bloom bit over a section: block i of the section is bit 7 - i % 8 of byte i / 8
+struct BitVector {
+    alignas(64) std::array<uint8_t, kBitVectorSize> bytes{};
+
+    [[nodiscard]] bool test(size_t i) const { return (bytes[i / 8] & (0x80u >> (i % 8))) != 0; }
+    void set(size_t i) { bytes[i / 8] = static_cast<uint8_t>(bytes[i / 8] | (0x80u >> (i % 8))); }
+    [[nodiscard]] bool empty() const;
+
+    //! Plain loops over the whole vector, left to the compiler to vectorize
+    BitVector& operator&=(const BitVector& other);
+    BitVector& operator|=(const BitVector& other);
+
+    friend bool operator==(const BitVector&, const BitVector&) = default;
+};
+
+//! Key of the vector for bloom bit \p bit in section \p section: bit (2 bytes BE) + section (8 bytes BE)
+Bytes key(uint16_t bit, uint64_t section);
+
+//! Key of a section in BloomBitsIndex: section (8 bytes BE)
+Bytes section_key(uint64_t section);
+
+//! Compresses a bit vector the same way Geth bitutil.CompressBytes does (sparse vectors become much shorter)
+Bytes compress(const BitVector& vector);
+
+//! Decompresses the output of compress()
+//! \throws std::runtime_error on malformed data
+BitVector decompress(ByteView data);
+
+//! The 3 bloom bits (as indices 0..2047) set by \p data in a logs bloom, see m3_2048
+std::array<uint16_t, 3> bloom_bit_indices(ByteView data);
+
+//! Accumulates the blooms of the blocks of one section into its 2048 bit vectors
+class Generator {
+  public:
+    //! Adds the bloom of the block at position \p index within the section
+    void add_bloom(size_t index, const Bloom& bloom);
+
+    [[nodiscard]] const BitVector& vector(uint16_t bit) const { return vectors_[bit]; }
+
+    void reset() { vectors_.fill({}); }
+
+  private:
+    std::array<BitVector, kBloomBitLength> vectors_{};
+};
+
+//! Matches a log filter against the bit vectors of a section.
+//! The filter is a list of clauses which must all match (e.g. addresses, topic 0, topic 1...) and each clause is a
+//! list of alternatives (e.g. any of the addresses): an empty clause is a wildcard
+class Matcher {
+  public:
+    explicit Matcher(const std::vector<std::vector<Bytes>>& clauses);
+
+    //! Sorted bloom bits whose vectors are needed by match(), empty if the filter matches everything
+    [[nodiscard]] const std::vector<uint16_t>& bits() const { return bits_; }
+
+    //! Candidate blocks of a section given the vectors of bits(), in the same order
+    [[nodiscard]] BitVector match(std::span<const BitVector> vectors) const;
+
+  private:
+    //! Per clause, per alternative, the positions in bits_ of its 3 bloom bits
+    std::vector<std::vector<std::array<size_t, 3>>> clauses_;
+    std::vector<uint16_t> bits_;
+};
+
+}  // namespace silkworm::db::bloom_bits
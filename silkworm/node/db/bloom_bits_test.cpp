@@ -0,0 +1,146 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "bloom_bits.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/core/common/util.hpp>
+
+namespace silkworm::db::bloom_bits {
+
+using namespace evmc::literals;
+
+using Clauses = std::vector<std::vector<Bytes>>;
+
+TEST_CASE("BloomBits compression") {
+    SECTION("empty vector") {
+        BitVector vector;
+        CHECK(compress(vector).empty());
+        CHECK(decompress({}) == vector);
+    }
+
+    SECTION("sparse vector") {
+        BitVector vector;
+        vector.set(0);
+        vector.set(9);
+        vector.set(4095);
+        const Bytes compressed{compress(vector)};
+        CHECK(compressed.size() < kBitVectorSize);
+        CHECK(decompress(compressed) == vector);
+    }
+
+    SECTION("dense vector is stored as is") {
+        BitVector vector;
+        vector.bytes.fill(0x5A);
+        const Bytes compressed{compress(vector)};
+        CHECK(compressed.size() == kBitVectorSize);
+        CHECK(decompress(compressed) == vector);
+    }
+
+    SECTION("Geth encoding") {
+        // Nested bitsets of non-zero bytes (1 byte <- 8 bytes <- 64 bytes <- 512 bytes) followed by the content
+        BitVector vector;
+        vector.bytes[8] = 0x01;
+        const Bytes compressed{compress(vector)};
+        CHECK(to_hex(compressed) == "80408001");
+        CHECK(decompress(compressed) == vector);
+    }
+
+    SECTION("malformed data") {
+        CHECK_THROWS(decompress(Bytes(kBitVectorSize + 1, '\0')));
+        CHECK_THROWS(decompress(*from_hex("80")));
+        CHECK_THROWS(decompress(*from_hex("8000")));
+    }
+}
+
+TEST_CASE("BloomBits keys") {
+    CHECK(to_hex(key(0x07FF, 3)) == "07ff0000000000000003");
+    CHECK(to_hex(section_key(3)) == "0000000000000003");
+}
+
+TEST_CASE("BloomBits generator") {
+    const auto address{0x22341ae42d6dd7384bc8584e50419ea3ac75b83f_address};
+    Bloom bloom{};
+    m3_2048(bloom, address);
+
+    Generator generator;
+    generator.add_bloom(7, bloom);
+
+    size_t set_vectors{0};
+    for (uint16_t bit{0}; bit < kBloomBitLength; ++bit) {
+        if (!generator.vector(bit).empty()) ++set_vectors;
+    }
+    const auto indices{bloom_bit_indices(address)};
+    CHECK(set_vectors <= 3);
+    for (const auto bit : indices) {
+        CHECK(generator.vector(bit).test(7));
+        CHECK(!generator.vector(bit).test(6));
+        // Byte 7 / 8 = 0, mask 0x80 >> 7
+        CHECK(generator.vector(bit).bytes[0] == 0x01);
+    }
+
+    generator.reset();
+    CHECK(generator.vector(indices[0]).empty());
+}
+
+TEST_CASE("BloomBits matcher") {
+    const auto address1{0x22341ae42d6dd7384bc8584e50419ea3ac75b83f_address};
+    const auto address2{0x8e4cc86ccd5a3bb6a3f2e6c36c8a3fb5fa5a8c4a_address};
+    const auto topic{0xddf252ad1be2c89b69c2b068fc378daa952ba7f163c4a11628f55a4df523b3ef_bytes32};
+
+    // Block 0: address1 + topic, block 1: address2 + topic, block 2: address1 only
+    Generator generator;
+    Bloom bloom0{};
+    m3_2048(bloom0, address1);
+    m3_2048(bloom0, topic);
+    generator.add_bloom(0, bloom0);
+    Bloom bloom1{};
+    m3_2048(bloom1, address2);
+    m3_2048(bloom1, topic);
+    generator.add_bloom(1, bloom1);
+    Bloom bloom2{};
+    m3_2048(bloom2, address1);
+    generator.add_bloom(2, bloom2);
+
+    const auto candidates{[&](const Matcher& matcher) {
+        std::vector<BitVector> vectors;
+        for (const auto bit : matcher.bits()) {
+            vectors.push_back(decompress(compress(generator.vector(bit))));
+        }
+        const BitVector result{matcher.match(vectors)};
+        std::vector<size_t> blocks;
+        for (size_t i{0}; i < 4; ++i) {
+            if (result.test(i)) blocks.push_back(i);
+        }
+        return blocks;
+    }};
+
+    const Bytes a1{address1.bytes, kAddressLength};
+    const Bytes a2{address2.bytes, kAddressLength};
+    const Bytes t{topic.bytes, kHashLength};
+
+    CHECK(candidates(Matcher{Clauses{{a1}}}) == std::vector<size_t>{0, 2});
+    CHECK(candidates(Matcher{Clauses{{a1, a2}}}) == std::vector<size_t>{0, 1, 2});
+    CHECK(candidates(Matcher{Clauses{{a1}, {t}}}) == std::vector<size_t>{0});
+    CHECK(candidates(Matcher{Clauses{{}, {t}}}) == std::vector<size_t>{0, 1});
+
+    const Matcher wildcard{Clauses{{}, {}}};
+    CHECK(wildcard.bits().empty());
+    CHECK(candidates(wildcard) == std::vector<size_t>{0, 1, 2, 3});
+}
+
+}  // namespace silkworm::db::bloom_bits
@@ -219,6 +219,48 @@ void Buffer::write_history_to_db() {
         written_size = 0;
     }
 
+    if (!call_traces_.empty()) {
+        auto call_traces_table{db::open_cursor(txn_, table::kCallTraceSet)};
+        for (const auto& [block_key, values] : call_traces_) {
+            auto k{to_slice(block_key)};
+            for (const auto& value : values) {
+                auto v{to_slice(value)};
+                mdbx::error::success_or_throw(call_traces_table.put(k, &v, MDBX_APPENDDUP));
+                written_size += k.length() + v.length();
+            }
+        }
+        call_traces_.clear();
+        total_written_size += written_size;
+        if (should_trace) {
+            auto [_, duration]{sw.lap()};
+            log::Trace("Append Call Traces", {"size", human_size(written_size), "in", StopWatch::format(duration)});
+        }
+        written_size = 0;
+    }
+
+    if (!block_totals_.empty()) {
+        auto gas_table{db::open_cursor(txn_, table::kCumulativeGasIndex)};
+        auto transaction_table{db::open_cursor(txn_, table::kCumulativeTransactionIndex)};
+        Bytes value(sizeof(uint64_t), '\0');
+        for (const auto& [block_key, totals] : block_totals_) {
+            auto k{to_slice(block_key)};
+            endian::store_big_u64(value.data(), totals.first);
+            auto v{to_slice(value)};
+            mdbx::error::success_or_throw(gas_table.put(k, &v, MDBX_UPSERT));
+            endian::store_big_u64(value.data(), totals.second);
+            v = to_slice(value);
+            mdbx::error::success_or_throw(transaction_table.put(k, &v, MDBX_UPSERT));
+            written_size += 2 * (k.length() + value.length());
+        }
+        block_totals_.clear();
+        total_written_size += written_size;
+        if (should_trace) {
+            auto [_, duration]{sw.lap()};
+            log::Trace("Upsert Block Totals", {"size", human_size(written_size), "in", StopWatch::format(duration)});
+        }
+        written_size = 0;
+    }
+
     batch_history_size_ = 0;
     auto [finish_time, _]{sw.stop()};
     log::Info("Flushed history",
@@ -367,6 +409,63 @@ void Buffer::insert_receipts(uint64_t block_number, const std::vector<Receipt>&
     batch_history_size_ += key.size() + value.size();
 }
 
+// Erigon CallTraces in eth/stagedsync/stage_execute.go
+void Buffer::insert_call_traces(BlockNum block_number, const CallTraces& traces) {
+    // Values are address + flags, sorted by address for dup append
+    absl::btree_map<evmc::address, uint8_t> flags_by_address;
+    for (const auto& sender : traces.senders) {
+        flags_by_address.emplace(sender, kCallTraceFromFlag);
+    }
+    for (const auto& recipient : traces.recipients) {
+        auto [it, inserted]{flags_by_address.emplace(recipient, kCallTraceToFlag)};
+        if (!inserted) {
+            it->second = kCallTraceFromFlag | kCallTraceToFlag;
+        }
+    }
+    if (flags_by_address.empty()) {
+        return;
+    }
+
+    Bytes key{block_key(block_number)};
+    auto& values{call_traces_[key]};
+    values.clear();
+    values.reserve(flags_by_address.size());
+    for (const auto& [address, flags] : flags_by_address) {
+        Bytes value(kAddressLength + 1, '\0');
+        std::memcpy(value.data(), address.bytes, kAddressLength);
+        value[kAddressLength] = flags;
+        batch_history_size_ += key.size() + value.size();
+        values.push_back(std::move(value));
+    }
+}
+
+void Buffer::insert_block_totals(BlockNum block_number, uint64_t gas_used, uint64_t transaction_count) {
+    if (block_number == 0) {
+        return;
+    }
+
+    // Running totals are taken from the previous block, either still buffered or already persisted
+    std::optional<std::pair<uint64_t, uint64_t>> previous;
+    if (block_number == 1) {
+        previous.emplace(0, 0);
+    } else if (auto it{block_totals_.find(block_key(block_number - 1))}; it != block_totals_.end()) {
+        previous = it->second;
+    } else {
+        const auto previous_gas{read_cumulative_gas_used(txn_, block_number - 1)};
+        const auto previous_transactions{read_cumulative_transaction_count(txn_, block_number - 1)};
+        if (previous_gas && previous_transactions) {
+            previous.emplace(*previous_gas, *previous_transactions);
+        }
+    }
+    if (!previous) {
+        return;
+    }
+
+    Bytes key{block_key(block_number)};
+    batch_history_size_ += 2 * (key.size() + sizeof(uint64_t));
+    block_totals_[key] = {previous->first + gas_used, previous->second + transaction_count};
+}
+
 evmc::bytes32 Buffer::state_root_hash() const {
     throw std::runtime_error(std::string(__FUNCTION__).append(" not yet implemented"));
 }
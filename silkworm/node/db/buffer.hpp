@@ -23,6 +23,7 @@
 #include <absl/container/flat_hash_map.h>
 #include <absl/container/flat_hash_set.h>
 
+#include <silkworm/core/execution/call_tracer.hpp>
 #include <silkworm/core/state/state.hpp>
 #include <silkworm/core/trie/hash_builder.hpp>
 #include <silkworm/core/types/account.hpp>
@@ -78,6 +79,13 @@ class Buffer : public State {
 
     void insert_receipts(uint64_t block_number, const std::vector<Receipt>& receipts) override;
 
+    //! \brief Stores the from/to addresses of all call frames in block as kCallTraceSet entries
+    void insert_call_traces(BlockNum block_number, const CallTraces& traces);
+
+    //! \brief Accrues block gas used and transactions count into kCumulativeGasIndex and kCumulativeTransactionIndex
+    //! \remarks Nothing is stored unless the totals for the previous block are known (or block_number is 1)
+    void insert_block_totals(BlockNum block_number, uint64_t gas_used, uint64_t transaction_count);
+
     /** @name State changes
      *  Change sets are backward changes of the state, i.e. account/storage values <em>at the beginning of a block</em>.
      */
@@ -155,6 +163,8 @@ class Buffer : public State {
     absl::btree_map<uint64_t, StorageChanges> block_storage_changes_;  // per block
     absl::btree_map<Bytes, Bytes> receipts_;
     absl::btree_map<Bytes, Bytes> logs_;
+    absl::btree_map<Bytes, std::vector<Bytes>> call_traces_;  // block key -> sorted address + flags
+    absl::btree_map<Bytes, std::pair<uint64_t, uint64_t>> block_totals_;  // block key -> cumulative gas + txn count
 
     mutable size_t batch_state_size_{0};    // Accounts in memory data for state
     mutable size_t batch_history_size_{0};  // Accounts in memory data for history
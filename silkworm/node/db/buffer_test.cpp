@@ -18,6 +18,7 @@
 
 #include <silkworm/core/common/endian.hpp>
 #include <silkworm/infra/test/log.hpp>
+#include <silkworm/node/db/access_layer.hpp>
 #include <silkworm/node/db/buffer.hpp>
 #include <silkworm/node/db/tables.hpp>
 #include <silkworm/node/test/context.hpp>
@@ -153,4 +154,77 @@ TEST_CASE("Account update") {
     }
 }
 
+TEST_CASE("Call traces") {
+    test::SetLogVerbosityGuard log_guard{log::Level::kNone};
+    test::Context context;
+    auto& txn{context.rw_txn()};
+
+    const auto sender{0xa000000000000000000000000000000000000000_address};
+    const auto recipient{0xb000000000000000000000000000000000000000_address};
+    const auto contract{0x0c00000000000000000000000000000000000000_address};
+
+    CallTraces traces;
+    traces.senders = {sender, contract};
+    traces.recipients = {recipient, contract};
+
+    Buffer buffer{txn, 0};
+    buffer.insert_call_traces(10, traces);
+    buffer.insert_call_traces(11, CallTraces{});
+    REQUIRE(buffer.current_batch_history_size() != 0);
+    buffer.write_to_db();
+
+    auto call_traces = txn.ro_cursor_dup_sort(table::kCallTraceSet);
+    REQUIRE(call_traces->size() == 3);
+
+    // Values are sorted by address, each one followed by its from/to flags
+    auto data{call_traces->find(to_slice(block_key(10)), /*throw_notfound=*/false)};
+    REQUIRE(data);
+    CHECK(from_slice(data.value) == Bytes{contract.bytes, kAddressLength} + Bytes{kCallTraceFromFlag | kCallTraceToFlag});
+    data = call_traces->to_current_next_multi(/*throw_notfound=*/false);
+    REQUIRE(data);
+    CHECK(from_slice(data.value) == Bytes{sender.bytes, kAddressLength} + Bytes{kCallTraceFromFlag});
+    data = call_traces->to_current_next_multi(/*throw_notfound=*/false);
+    REQUIRE(data);
+    CHECK(from_slice(data.value) == Bytes{recipient.bytes, kAddressLength} + Bytes{kCallTraceToFlag});
+
+    // Blocks without any call frame are not stored
+    CHECK(!call_traces->find(to_slice(block_key(11)), /*throw_notfound=*/false));
+}
+
+TEST_CASE("Block totals") {
+    test::SetLogVerbosityGuard log_guard{log::Level::kNone};
+    test::Context context;
+    auto& txn{context.rw_txn()};
+
+    {
+        Buffer buffer{txn, 0};
+        buffer.insert_block_totals(1, 21'000, 1);
+        buffer.insert_block_totals(2, 0, 0);
+        REQUIRE(buffer.current_batch_history_size() != 0);
+        buffer.write_to_db();
+    }
+    CHECK(read_cumulative_gas_used(txn, 1) == 21'000);
+    CHECK(read_cumulative_transaction_count(txn, 1) == 1);
+    CHECK(read_cumulative_gas_used(txn, 2) == 21'000);
+    CHECK(read_cumulative_transaction_count(txn, 2) == 1);
+
+    // Totals keep accruing from persisted ones
+    {
+        Buffer buffer{txn, 0};
+        buffer.insert_block_totals(3, 50'000, 2);
+        buffer.write_to_db();
+    }
+    CHECK(read_cumulative_gas_used(txn, 3) == 71'000);
+    CHECK(read_cumulative_transaction_count(txn, 3) == 3);
+
+    // Nothing is stored when previous totals are unknown
+    {
+        Buffer buffer{txn, 0};
+        buffer.insert_block_totals(10, 50'000, 2);
+        buffer.write_to_db();
+    }
+    CHECK(!read_cumulative_gas_used(txn, 10));
+    CHECK(!read_cumulative_transaction_count(txn, 10));
+}
+
 }  // namespace silkworm::db
@@ -256,31 +256,23 @@ class RWTxn : public ROTxn {
 
     void disable_commit() { commit_disabled_ = true; }
     void enable_commit() { commit_disabled_ = false; }
+    [[nodiscard]] bool commit_disabled() const { return commit_disabled_; }
 
     virtual std::unique_ptr<RWCursor> rw_cursor(const MapConfig& config);
     virtual std::unique_ptr<RWCursorDupSort> rw_cursor_dup_sort(const MapConfig& config);
 
-    void commit(const bool renew = true) {
-        /*
-         * renew is required here due to RAII
-         * RWTxn txn(env);
-         * txn.commit();
-         * env.close();
-         * causes a segfault for tx being aborted when the env is already closed
-         *
-         * Workarounds
-         * - either pass renew==false to last commit
-         * - or keep RWTxn in a lower scope
-         * */
-
-        if (!commit_disabled_) {
-            mdbx::env env = db();
-            managed_txn_.commit();
-            if (renew) {
-                managed_txn_ = env.start_write();  // renew transaction
-            }
-        }
-    }
+    /*
+     * renew is required here due to RAII
+     * RWTxn txn(env);
+     * txn.commit();
+     * env.close();
+     * causes a segfault for tx being aborted when the env is already closed
+     *
+     * Workarounds
+     * - either pass renew==false to last commit
+     * - or keep RWTxn in a lower scope
+     * */
+    void commit(bool renew = true);
     void commit_and_renew() { commit(true); }
     void commit_and_stop() { commit(false); }
 
@@ -38,6 +38,9 @@ class MemoryDatabase {
     ::mdbx::env_managed memory_env_;
 };
 
+//! In-memory MDBX database layered over an external read-only transaction, used by Fork to validate new payloads
+//! \remarks A native ordered overlay without MDBX is not viable yet: stages reach the underlying MDBX transaction
+//! through RWTxn::commit, clear_map and operator->, so they must be moved to cursor-only interfaces first
 class MemoryOverlay {
   public:
     MemoryOverlay(const std::filesystem::path& tmp_dir, ROTxn* txn);
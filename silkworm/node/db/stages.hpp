@@ -61,9 +61,15 @@ inline constexpr const char* kLogIndexKey{"LogIndex"};
 //! \brief Generating call traces index
 inline constexpr const char* kCallTracesKey{"CallTraces"};
 
+//! \brief Generating bloom bits index (from logs)
+inline constexpr const char* kBloomBitsKey{"BloomBits"};
+
 //! \brief Generating transactions lookup index
 inline constexpr const char* kTxLookupKey{"TxLookup"};
 
+//! \brief Moving old blocks from database into snapshots
+inline constexpr const char* kFreezeKey{"Freeze"};
+
 //! \brief Starts Backend
 inline constexpr const char* kTxPoolKey{"TxPool"};
 
@@ -96,7 +102,9 @@ inline constexpr const char* kAllStages[]{
     kStorageHistoryIndexKey,
     kLogIndexKey,
     kCallTracesKey,
+    kBloomBitsKey,
     kTxLookupKey,
+    kFreezeKey,
     kTxPoolKey,
     kFinishKey,
     kUnwindKey,
@@ -0,0 +1,440 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "state_snapshot.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <silkworm/core/common/cast.hpp>
+#include <silkworm/core/common/endian.hpp>
+#include <silkworm/core/common/util.hpp>
+#include <silkworm/core/rlp/encode.hpp>
+#include <silkworm/core/trie/hash_builder.hpp>
+#include <silkworm/core/trie/nibbles.hpp>
+#include <silkworm/core/types/account.hpp>
+#include <silkworm/infra/common/decoding_exception.hpp>
+#include <silkworm/infra/common/log.hpp>
+#include <silkworm/node/db/tables.hpp>
+#include <silkworm/node/db/util.hpp>
+#include <silkworm/node/etl/collector.hpp>
+
+namespace silkworm::db::state_snapshot {
+
+static constexpr uint8_t kMagic[4]{'S', 'W', 'S', 'T'};
+static constexpr size_t kHeaderSize{sizeof(kMagic) + sizeof(uint32_t) + sizeof(uint64_t) + kHashLength};
+static constexpr size_t kChunkHeaderSize{2 * sizeof(uint8_t) + 3 * sizeof(uint32_t) + kHashLength};
+static constexpr size_t kEntryHeaderSize{sizeof(uint16_t) + sizeof(uint32_t)};
+static constexpr size_t kNumPartitions{256};
+
+static constexpr SnapshotTable kSnapshotTables[]{SnapshotTable::kPlainState, SnapshotTable::kPlainCodeHash,
+                                                 SnapshotTable::kCode};
+
+static const MapConfig& map_config(SnapshotTable table) {
+    switch (table) {
+        case SnapshotTable::kPlainState:
+            return table::kPlainState;
+        case SnapshotTable::kPlainCodeHash:
+            return table::kPlainCodeHash;
+        case SnapshotTable::kCode:
+            return table::kCode;
+    }
+    throw std::runtime_error("invalid state snapshot table " + std::to_string(static_cast<int>(table)));
+}
+
+struct ChunkHeader {
+    SnapshotTable table{SnapshotTable::kPlainState};
+    uint8_t partition{0};
+    uint32_t sequence{0};
+    uint32_t entry_count{0};
+    uint32_t payload_size{0};
+    evmc::bytes32 checksum{};
+};
+
+struct ChunkLocation {
+    ChunkHeader header;
+    std::streamoff payload_offset{0};
+};
+
+static Bytes encode_chunk_header(const ChunkHeader& chunk) {
+    Bytes out(kChunkHeaderSize, '\0');
+    out[0] = static_cast<uint8_t>(chunk.table);
+    out[1] = chunk.partition;
+    endian::store_big_u32(&out[2], chunk.sequence);
+    endian::store_big_u32(&out[6], chunk.entry_count);
+    endian::store_big_u32(&out[10], chunk.payload_size);
+    std::memcpy(&out[14], chunk.checksum.bytes, kHashLength);
+    return out;
+}
+
+static ChunkHeader decode_chunk_header(ByteView in) {
+    ChunkHeader chunk;
+    if (in[0] > static_cast<uint8_t>(SnapshotTable::kCode)) {
+        throw std::runtime_error("invalid state snapshot table " + std::to_string(in[0]));
+    }
+    chunk.table = static_cast<SnapshotTable>(in[0]);
+    chunk.partition = in[1];
+    chunk.sequence = endian::load_big_u32(&in[2]);
+    chunk.entry_count = endian::load_big_u32(&in[6]);
+    chunk.payload_size = endian::load_big_u32(&in[10]);
+    std::memcpy(chunk.checksum.bytes, &in[14], kHashLength);
+    return chunk;
+}
+
+//! Serializes chunks coming from export threads into the output file
+class ChunkWriter {
+  public:
+    explicit ChunkWriter(std::ofstream& out) : out_{out} {}
+
+    void write(ChunkHeader& chunk, ByteView payload) {
+        chunk.payload_size = static_cast<uint32_t>(payload.size());
+        chunk.checksum = bit_cast<evmc_bytes32>(keccak256(payload));
+        const auto chunk_header{encode_chunk_header(chunk)};
+
+        std::scoped_lock lock{mutex_};
+        out_.write(byte_ptr_cast(chunk_header.data()), static_cast<std::streamsize>(chunk_header.size()));
+        out_.write(byte_ptr_cast(payload.data()), static_cast<std::streamsize>(payload.size()));
+        if (!out_) {
+            throw std::runtime_error("cannot write state snapshot chunk");
+        }
+        ++stats_.chunks;
+        stats_.entries += chunk.entry_count;
+        stats_.bytes += chunk_header.size() + payload.size();
+    }
+
+    [[nodiscard]] ExportStats stats() const { return stats_; }
+
+  private:
+    std::ofstream& out_;
+    std::mutex mutex_;
+    ExportStats stats_;
+};
+
+static void export_partition(ROTxn& txn, SnapshotTable table, uint8_t partition, size_t chunk_size,
+                             ChunkWriter& writer) {
+    ChunkHeader chunk{.table = table, .partition = partition};
+    Bytes payload;
+    payload.reserve(chunk_size + kEntryHeaderSize);
+
+    const auto flush = [&]() {
+        writer.write(chunk, payload);
+        ++chunk.sequence;
+        chunk.entry_count = 0;
+        payload.clear();
+    };
+
+    auto cursor = txn.ro_cursor(map_config(table));
+    const Bytes start_key(1, partition);
+    auto data{cursor->lower_bound(to_slice(start_key), /*throw_notfound=*/false)};
+    uint8_t entry_header[kEntryHeaderSize];
+    while (data && from_slice(data.key)[0] == partition) {
+        endian::store_big_u16(&entry_header[0], static_cast<uint16_t>(data.key.length()));
+        endian::store_big_u32(&entry_header[sizeof(uint16_t)], static_cast<uint32_t>(data.value.length()));
+        payload.append(entry_header, kEntryHeaderSize);
+        payload.append(from_slice(data.key));
+        payload.append(from_slice(data.value));
+        ++chunk.entry_count;
+        if (payload.size() >= chunk_size) {
+            flush();
+        }
+        data = cursor->to_next(/*throw_notfound=*/false);
+    }
+    if (chunk.entry_count > 0) {
+        flush();
+    }
+}
+
+//! Computes the state root from the hashed accounts and storage fed in key order, as loaded by import_state
+class StateRootBuilder {
+  public:
+    void add_account(ByteView address_hash, ByteView encoded_account) {
+        finish_account();
+        const auto account{Account::from_encoded_storage(encoded_account)};
+        success_or_throw(account);
+        address_hash_.assign(address_hash);
+        account_ = *account;
+        has_account_ = true;
+    }
+
+    //! Storage of other incarnations than the account one is stale and does not contribute to the root
+    void add_storage(ByteView storage_prefix, ByteView location_hash, ByteView value) {
+        if (!has_account_ || storage_prefix.substr(0, kHashLength) != ByteView{address_hash_} ||
+            endian::load_big_u64(&storage_prefix[kHashLength]) != account_.incarnation) {
+            return;
+        }
+        value_rlp_.clear();
+        rlp::encode(value_rlp_, value);
+        storage_builder_.add_leaf(trie::unpack_nibbles(location_hash), value_rlp_);
+    }
+
+    evmc::bytes32 root_hash() {
+        finish_account();
+        return state_builder_.root_hash();
+    }
+
+  private:
+    void finish_account() {
+        if (!has_account_) return;
+        const auto storage_root{storage_builder_.root_hash()};
+        storage_builder_.reset();
+        state_builder_.add_leaf(trie::unpack_nibbles(address_hash_), account_.rlp(storage_root));
+        has_account_ = false;
+    }
+
+    trie::HashBuilder state_builder_;
+    trie::HashBuilder storage_builder_;
+    Bytes address_hash_;
+    Account account_;
+    bool has_account_{false};
+    Bytes value_rlp_;
+};
+
+ExportStats export_state(mdbx::env& env, const std::filesystem::path& file_path, const Header& header,
+                         uint64_t header_txn_id, size_t num_threads, size_t chunk_size) {
+    std::ofstream out{file_path, std::ios::out | std::ios::binary | std::ios::trunc};
+    if (!out) {
+        throw std::runtime_error("cannot open state snapshot file " + file_path.string());
+    }
+    Bytes file_header(kHeaderSize, '\0');
+    std::memcpy(&file_header[0], kMagic, sizeof(kMagic));
+    endian::store_big_u32(&file_header[sizeof(kMagic)], kVersion);
+    endian::store_big_u64(&file_header[sizeof(kMagic) + sizeof(uint32_t)], header.block_number);
+    std::memcpy(&file_header[sizeof(kMagic) + sizeof(uint32_t) + sizeof(uint64_t)], header.state_root.bytes, kHashLength);
+    out.write(byte_ptr_cast(file_header.data()), static_cast<std::streamsize>(file_header.size()));
+
+    // Tasks are (table, partition) pairs picked up by threads in turn: this keeps all threads busy even when
+    // a few partitions are much heavier than the others (e.g. the EOS reserved address prefix)
+    constexpr size_t kNumTasks{std::size(kSnapshotTables) * kNumPartitions};
+    std::atomic<size_t> next_task{0};
+    std::atomic<bool> failed{false};
+    std::exception_ptr first_error;
+    std::mutex error_mutex;
+    ChunkWriter writer{out};
+
+    const auto worker = [&]() {
+        try {
+            ROTxn txn{env};
+            // All chunks must come from the MVCC snapshot which header has been read from
+            if (txn.id() != header_txn_id) {
+                throw std::runtime_error("database changed during state export (txn " + std::to_string(txn.id()) +
+                                         " instead of " + std::to_string(header_txn_id) + "): stop any writer first");
+            }
+            for (size_t task{next_task++}; task < kNumTasks && !failed; task = next_task++) {
+                export_partition(txn, kSnapshotTables[task / kNumPartitions], static_cast<uint8_t>(task % kNumPartitions),
+                                 chunk_size, writer);
+            }
+        } catch (...) {
+            std::scoped_lock lock{error_mutex};
+            if (!first_error) first_error = std::current_exception();
+            failed = true;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(std::max<size_t>(num_threads, 1));
+    for (size_t i{0}; i < std::max<size_t>(num_threads, 1); ++i) {
+        threads.emplace_back(worker);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    if (first_error) {
+        std::rethrow_exception(first_error);
+    }
+    out.close();
+
+    const auto stats{writer.stats()};
+    log::Info("State snapshot exported", {"file", file_path.string(), "block", std::to_string(header.block_number),
+                                          "chunks", std::to_string(stats.chunks), "entries", std::to_string(stats.entries),
+                                          "size", human_size(stats.bytes)});
+    return stats;
+}
+
+static Header read_header(std::ifstream& in, const std::filesystem::path& file_path) {
+    Bytes file_header(kHeaderSize, '\0');
+    in.read(byte_ptr_cast(file_header.data()), static_cast<std::streamsize>(file_header.size()));
+    if (!in || std::memcmp(file_header.data(), kMagic, sizeof(kMagic)) != 0) {
+        throw std::runtime_error("invalid state snapshot file " + file_path.string());
+    }
+    if (const auto version{endian::load_big_u32(&file_header[sizeof(kMagic)])}; version != kVersion) {
+        throw std::runtime_error("unsupported state snapshot version " + std::to_string(version));
+    }
+    Header header;
+    header.block_number = endian::load_big_u64(&file_header[sizeof(kMagic) + sizeof(uint32_t)]);
+    std::memcpy(header.state_root.bytes, &file_header[sizeof(kMagic) + sizeof(uint32_t) + sizeof(uint64_t)], kHashLength);
+    return header;
+}
+
+Header read_header(const std::filesystem::path& file_path) {
+    std::ifstream in{file_path, std::ios::in | std::ios::binary};
+    if (!in) {
+        throw std::runtime_error("cannot open state snapshot file " + file_path.string());
+    }
+    return read_header(in, file_path);
+}
+
+Header import_state(RWTxn& txn, const std::filesystem::path& file_path, const std::filesystem::path& etl_path) {
+    std::ifstream in{file_path, std::ios::in | std::ios::binary};
+    if (!in) {
+        throw std::runtime_error("cannot open state snapshot file " + file_path.string());
+    }
+    const auto header{read_header(in, file_path)};
+
+    // Index chunk headers only, payloads are read later in key order
+    std::vector<ChunkLocation> chunks;
+    Bytes chunk_header(kChunkHeaderSize, '\0');
+    while (in.peek() != std::ifstream::traits_type::eof()) {
+        in.read(byte_ptr_cast(chunk_header.data()), static_cast<std::streamsize>(chunk_header.size()));
+        if (!in) {
+            throw std::runtime_error("truncated state snapshot chunk header");
+        }
+        ChunkLocation location{decode_chunk_header(chunk_header), in.tellg()};
+        in.seekg(location.header.payload_size, std::ios::cur);
+        chunks.push_back(location);
+    }
+    in.clear();
+    std::sort(chunks.begin(), chunks.end(), [](const ChunkLocation& lhs, const ChunkLocation& rhs) {
+        return std::tie(lhs.header.table, lhs.header.partition, lhs.header.sequence) <
+               std::tie(rhs.header.table, rhs.header.partition, rhs.header.sequence);
+    });
+
+    for (const auto& config : {table::kPlainState, table::kPlainCodeHash, table::kCode, table::kHashedAccounts,
+                               table::kHashedStorage, table::kHashedCodeHash}) {
+        if (!txn.ro_cursor(config)->empty()) {
+            throw std::runtime_error(std::string(config.name) + " should be empty");
+        }
+    }
+
+    etl::Collector state_collector{etl_path};
+    etl::Collector code_hash_collector{etl_path};
+    evmc::address last_address{};
+    ethash_hash256 address_hash{keccak256(last_address.bytes)};
+    Bytes etl_storage_entry_key(kHashedStoragePrefixLength + kHashLength, '\0');
+    Bytes etl_code_hash_key(kHashedStoragePrefixLength, '\0');
+
+    // See HashState::hash_from_plainstate for the layout of collected entries
+    const auto collect_hashed = [&](SnapshotTable table, ByteView key, ByteView value) {
+        if (table == SnapshotTable::kCode) {
+            return;
+        }
+        if (std::memcmp(key.data(), last_address.bytes, kAddressLength) != 0) {
+            last_address = to_evmc_address(key);
+            address_hash = keccak256(last_address.bytes);
+        }
+        if (table == SnapshotTable::kPlainCodeHash) {
+            std::memcpy(&etl_code_hash_key[0], address_hash.bytes, kHashLength);
+            std::memcpy(&etl_code_hash_key[kHashLength], &key[kAddressLength], kIncarnationLength);
+            code_hash_collector.collect(etl::Entry{etl_code_hash_key, Bytes{value}});
+        } else if (key.length() == kAddressLength) {
+            state_collector.collect(etl::Entry{Bytes(address_hash.bytes, kHashLength), Bytes{value}});
+        } else {
+            std::memcpy(&etl_storage_entry_key[0], address_hash.bytes, kHashLength);
+            std::memcpy(&etl_storage_entry_key[kHashLength], &key[kAddressLength], kIncarnationLength);
+            std::memcpy(&etl_storage_entry_key[kHashedStoragePrefixLength], keccak256(value.substr(0, kHashLength)).bytes,
+                        kHashLength);
+            state_collector.collect(etl::Entry{etl_storage_entry_key, Bytes{value.substr(kHashLength)}});
+        }
+    };
+
+    Bytes payload;
+    size_t entries{0};
+    for (const auto& chunk : chunks) {
+        payload.resize(chunk.header.payload_size);
+        in.seekg(chunk.payload_offset);
+        in.read(byte_ptr_cast(payload.data()), static_cast<std::streamsize>(payload.size()));
+        if (!in) {
+            throw std::runtime_error("truncated state snapshot chunk payload");
+        }
+        if (bit_cast<evmc_bytes32>(keccak256(payload)) != chunk.header.checksum) {
+            throw std::runtime_error("state snapshot chunk checksum mismatch: table " +
+                                     std::to_string(static_cast<int>(chunk.header.table)) + " partition " +
+                                     std::to_string(chunk.header.partition) + " sequence " +
+                                     std::to_string(chunk.header.sequence));
+        }
+
+        auto target = txn.rw_cursor_dup_sort(map_config(chunk.header.table));
+        const auto put_flags{chunk.header.table == SnapshotTable::kPlainState ? MDBX_APPENDDUP : MDBX_APPEND};
+        ByteView view{payload};
+        for (uint32_t i{0}; i < chunk.header.entry_count; ++i) {
+            if (view.size() < kEntryHeaderSize) {
+                throw std::runtime_error("invalid state snapshot chunk entry");
+            }
+            const size_t key_size{endian::load_big_u16(&view[0])};
+            const size_t value_size{endian::load_big_u32(&view[sizeof(uint16_t)])};
+            view.remove_prefix(kEntryHeaderSize);
+            if (view.size() < key_size + value_size || key_size < kAddressLength) {
+                throw std::runtime_error("invalid state snapshot chunk entry");
+            }
+            const ByteView key{view.substr(0, key_size)};
+            const ByteView value{view.substr(key_size, value_size)};
+            view.remove_prefix(key_size + value_size);
+
+            auto k{to_slice(key)};
+            auto v{to_slice(value)};
+            mdbx::error::success_or_throw(target->put(k, &v, put_flags));
+            collect_hashed(chunk.header.table, key, value);
+        }
+        entries += chunk.header.entry_count;
+    }
+
+    // Hashed state is loaded in key order, i.e. each account followed by its storage: the state root is computed
+    // along the way and checked against the header one
+    StateRootBuilder state_root_builder;
+    auto account_target = txn.rw_cursor_dup_sort(table::kHashedAccounts);  // note: not a multi-value table
+    auto storage_target = txn.rw_cursor_dup_sort(table::kHashedStorage);
+    const etl::LoadFunc load_state_func = [&storage_target, &state_root_builder](
+                                              const etl::Entry& entry, RWCursorDupSort& target, MDBX_put_flags_t) -> void {
+        if (entry.key.length() == kHashLength) {
+            mdbx::slice k{entry.key.data(), entry.key.length()};
+            mdbx::slice v{entry.value.data(), entry.value.length()};
+            mdbx::error::success_or_throw(target.put(k, &v, MDBX_APPEND));
+            state_root_builder.add_account(entry.key, entry.value);
+        } else {
+            Bytes new_value(kHashLength + entry.value.length(), '\0');
+            std::memcpy(&new_value[0], &entry.key[kHashedStoragePrefixLength], kHashLength);
+            std::memcpy(&new_value[kHashLength], entry.value.data(), entry.value.length());
+            mdbx::slice k{entry.key.data(), kHashedStoragePrefixLength};
+            mdbx::slice v{new_value.data(), new_value.length()};
+            mdbx::error::success_or_throw(storage_target->put(k, &v, MDBX_APPENDDUP));
+            const ByteView key{entry.key};
+            state_root_builder.add_storage(key.substr(0, kHashedStoragePrefixLength),
+                                           key.substr(kHashedStoragePrefixLength), entry.value);
+        }
+    };
+    state_collector.load(*account_target, load_state_func, MDBX_put_flags_t::MDBX_APPENDDUP);
+    if (const auto state_root{state_root_builder.root_hash()}; state_root != header.state_root) {
+        throw std::runtime_error("state snapshot root mismatch: computed " + to_hex(state_root, true) + " expected " +
+                                 to_hex(header.state_root, true));
+    }
+    auto code_hash_target = txn.rw_cursor_dup_sort(table::kHashedCodeHash);  // note: not a multi-value table
+    code_hash_collector.load(*code_hash_target, nullptr, MDBX_put_flags_t::MDBX_APPEND);
+
+    log::Info("State snapshot imported", {"file", file_path.string(), "block", std::to_string(header.block_number),
+                                          "chunks", std::to_string(chunks.size()), "entries", std::to_string(entries)});
+    return header;
+}
+
+}  // namespace silkworm::db::state_snapshot
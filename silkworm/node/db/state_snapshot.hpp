@@ -0,0 +1,77 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+#include <evmc/evmc.hpp>
+
+#include <silkworm/core/common/base.hpp>
+#include <silkworm/node/db/mdbx.hpp>
+
+//! \brief Binary snapshot of the plain state, made of independently checksummed chunks
+//! \verbatim
+//! file   : header chunk*
+//! header : magic "SWST" | version u32 | block number u64 | state root (32 bytes)
+//! chunk  : table u8 | partition u8 | sequence u32 | entry count u32 | payload size u32 | keccak256(payload) | payload
+//! entry  : key size u16 | value size u32 | key | value
+//! \endverbatim
+//! \remark All integers are big-endian. Partitions are the first key byte: chunks of different partitions are
+//! interleaved in the file as written by export threads, import sorts them back by table, partition and sequence
+namespace silkworm::db::state_snapshot {
+
+inline constexpr uint32_t kVersion{1};
+inline constexpr size_t kDefaultChunkSize{16_Mebi};
+
+//! \brief Tables carried by the snapshot, in import order
+enum class SnapshotTable : uint8_t {
+    kPlainState = 0,
+    kPlainCodeHash = 1,
+    kCode = 2,
+};
+
+struct Header {
+    uint64_t block_number{0};
+    evmc::bytes32 state_root{};
+};
+
+struct ExportStats {
+    size_t chunks{0};
+    size_t entries{0};
+    size_t bytes{0};
+};
+
+//! \brief Exports PlainState, PlainCodeHash and Code into file_path spreading the key space among num_threads
+//! read-only transactions, each streaming chunks of about chunk_size bytes to disk
+//! \param header_txn_id [in] : id of the read-only transaction header has been read from, which must still be open
+//! \throws std::runtime_error if any export transaction sees another snapshot than header_txn_id (i.e. the db has
+//! been written meanwhile), as the exported state would not match the header state root
+ExportStats export_state(mdbx::env& env, const std::filesystem::path& file_path, const Header& header,
+                         uint64_t header_txn_id, size_t num_threads, size_t chunk_size = kDefaultChunkSize);
+
+//! \brief Reads just the header of a snapshot file
+//! \throws std::runtime_error on missing file or bad header
+Header read_header(const std::filesystem::path& file_path);
+
+//! \brief Bulk-loads a snapshot into empty PlainState, PlainCodeHash and Code tables using MDBX appends and builds
+//! HashedAccounts, HashedStorage and HashedCodeHash through ETL collectors working in etl_path
+//! \throws std::runtime_error on corrupted snapshot, non-empty target tables or state root not matching the header
+Header import_state(RWTxn& txn, const std::filesystem::path& file_path, const std::filesystem::path& etl_path);
+
+}  // namespace silkworm::db::state_snapshot
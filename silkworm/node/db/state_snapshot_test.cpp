@@ -0,0 +1,148 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "state_snapshot.hpp"
+
+#include <fstream>
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/core/common/cast.hpp>
+#include <silkworm/core/common/util.hpp>
+#include <silkworm/core/state/in_memory_state.hpp>
+#include <silkworm/core/types/account.hpp>
+#include <silkworm/infra/common/directories.hpp>
+#include <silkworm/infra/test/log.hpp>
+#include <silkworm/node/db/tables.hpp>
+#include <silkworm/node/db/util.hpp>
+#include <silkworm/node/test/context.hpp>
+
+namespace silkworm::db::state_snapshot {
+
+using namespace evmc::literals;
+
+static size_t count_entries(RWTxn& txn, const MapConfig& config) {
+    return txn.ro_cursor(config)->size();
+}
+
+TEST_CASE("State snapshot export and import") {
+    test::SetLogVerbosityGuard log_guard{log::Level::kNone};
+    TemporaryDirectory tmp_dir;
+    const auto file_path{tmp_dir.path() / "state.snapshot"};
+
+    const auto eoa{0x0a00000000000000000000000000000000000001_address};
+    const auto contract{0xbbbbbbbbbbbbbbbbbbbbbbbb0000000000000002_address};
+    const Bytes code{*from_hex("6000600055")};
+    const auto code_hash{bit_cast<evmc_bytes32>(keccak256(code))};
+    const auto location{0x01_bytes32};
+    const Account eoa_account{.nonce = 1, .balance = 1'000};
+    const Account contract_account{.nonce = 1, .code_hash = code_hash, .incarnation = 1};
+
+    // Expected state root computed independently
+    InMemoryState state;
+    state.update_account(eoa, std::nullopt, eoa_account);
+    state.update_account(contract, std::nullopt, contract_account);
+    for (uint8_t i{1}; i <= 100; ++i) {
+        evmc::bytes32 storage_location{location};
+        storage_location.bytes[kHashLength - 1] = i;
+        evmc::bytes32 storage_value{};
+        storage_value.bytes[kHashLength - 1] = i;
+        state.update_storage(contract, 1, storage_location, {}, storage_value);
+    }
+    const Header header{.block_number = 42, .state_root = state.state_root_hash()};
+    const auto bad_root_file_path{tmp_dir.path() / "bad_root.snapshot"};
+
+    {
+        test::Context source;
+        auto& txn{source.rw_txn()};
+        auto plain_state = txn.rw_cursor_dup_sort(table::kPlainState);
+        plain_state->upsert(to_slice(eoa), to_slice(eoa_account.encode_for_storage()));
+        plain_state->upsert(to_slice(contract), to_slice(contract_account.encode_for_storage()));
+        const Bytes storage_key{storage_prefix(contract, 1)};
+        for (uint8_t i{1}; i <= 100; ++i) {
+            Bytes storage_value(location.bytes, kHashLength);
+            storage_value[kHashLength - 1] = i;
+            storage_value.push_back(i);
+            plain_state->upsert(to_slice(storage_key), to_slice(storage_value));
+        }
+        txn.rw_cursor(table::kPlainCodeHash)->upsert(to_slice(storage_key), to_slice(code_hash));
+        txn.rw_cursor(table::kCode)->upsert(to_slice(code_hash), to_slice(code));
+        source.commit_txn();
+
+        // Tiny chunks to have several chunks per partition
+        ROTxn header_txn{source.env()};
+        const auto stats{export_state(source.env(), file_path, header, header_txn.id(), 4, 128)};
+        CHECK(stats.entries == 104);
+        CHECK(stats.chunks > 4);
+        export_state(source.env(), bad_root_file_path, Header{.block_number = 42, .state_root = 0xabcd_bytes32},
+                     header_txn.id(), 4, 128);
+
+        // Writes committed after reading the header make the export fail
+        {
+            RWTxn writer{source.env()};
+            writer.rw_cursor(table::kCode)->upsert(to_slice(0x01_bytes32), to_slice(code));
+            writer.commit_and_stop();
+        }
+        CHECK_THROWS_AS(export_state(source.env(), tmp_dir.path() / "changed.snapshot", header, header_txn.id(), 4),
+                        std::runtime_error);
+    }
+
+    const auto read{read_header(file_path)};
+    CHECK(read.block_number == header.block_number);
+    CHECK(read.state_root == header.state_root);
+
+    SECTION("import") {
+        test::Context target;
+        auto& txn{target.rw_txn()};
+        const auto imported{import_state(txn, file_path, target.dir().etl().path())};
+        CHECK(imported.block_number == header.block_number);
+
+        CHECK(count_entries(txn, table::kPlainState) == 102);
+        CHECK(count_entries(txn, table::kPlainCodeHash) == 1);
+        CHECK(count_entries(txn, table::kCode) == 1);
+        CHECK(count_entries(txn, table::kHashedAccounts) == 2);
+        CHECK(count_entries(txn, table::kHashedStorage) == 100);
+        CHECK(count_entries(txn, table::kHashedCodeHash) == 1);
+
+        auto hashed_accounts = txn.ro_cursor(table::kHashedAccounts);
+        CHECK(hashed_accounts->seek(to_slice(ByteView{keccak256(eoa.bytes).bytes, kHashLength})));
+        auto code_table = txn.ro_cursor(table::kCode);
+        const auto data{code_table->find(to_slice(code_hash), /*throw_notfound=*/false)};
+        REQUIRE(data);
+        CHECK(from_slice(data.value) == code);
+
+        // Importing twice is refused
+        CHECK_THROWS_AS(import_state(txn, file_path, target.dir().etl().path()), std::runtime_error);
+    }
+
+    SECTION("state root mismatch") {
+        test::Context target;
+        CHECK_THROWS_AS(import_state(target.rw_txn(), bad_root_file_path, target.dir().etl().path()),
+                        std::runtime_error);
+    }
+
+    SECTION("corrupted chunk") {
+        {
+            std::fstream file{file_path, std::ios::in | std::ios::out | std::ios::binary};
+            file.seekp(-1, std::ios::end);
+            file.put('\xff');
+        }
+        test::Context target;
+        CHECK_THROWS_AS(import_state(target.rw_txn(), file_path, target.dir().etl().path()), std::runtime_error);
+    }
+}
+
+}  // namespace silkworm::db::state_snapshot
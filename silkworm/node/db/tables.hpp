@@ -115,9 +115,21 @@ inline constexpr db::MapConfig kDifficulty{kDifficultyName};
 inline constexpr const char* kBlockReceiptsName{"Receipt"};
 inline constexpr db::MapConfig kBlockReceipts{kBlockReceiptsName};
 
+//! \details Stores the completed sections of the bloom bits index
+//! \struct
+//! \verbatim
+//!   key   : section_u64 (BE)
+//!   value : canonical hash of last block in section
+//! \endverbatim
 inline constexpr const char* kBloomBitsIndexName{"BloomBitsIndex"};
 inline constexpr db::MapConfig kBloomBitsIndex{kBloomBitsIndexName};
 
+//! \details Stores the rotated logs blooms of each section (4096 blocks): one bit vector per bloom bit
+//! \struct
+//! \verbatim
+//!   key   : bloom_bit_u16 (BE) + section_u64 (BE)
+//!   value : compressed bit vector (one bit per block in section)
+//! \endverbatim
 inline constexpr const char* kBloomBitsName{"BloomBits"};
 inline constexpr db::MapConfig kBloomBits{kBloomBitsName};
 
@@ -380,9 +392,21 @@ inline constexpr db::MapConfig kLastForkchoice{kLastForkchoiceName};
 inline constexpr const char* kIssuanceName{"Issuance"};
 inline constexpr db::MapConfig kIssuance{kIssuanceName};
 
+//! \details Stores the total gas used by all canonical blocks up to and including each block
+//! \def key : block_num_u64 (BE)
+//! \def value : cumulative gas used (u64 BE)
+//! \remark Written by Execution stage, which backfills it from canonical headers when missing (in committed chunks)
 inline constexpr const char* kCumulativeGasIndexName{"CumulativeGasIndex"};
 inline constexpr db::MapConfig kCumulativeGasIndex{kCumulativeGasIndexName};
 
+//! \details Stores the count of transactions in all canonical blocks up to and including each block, system
+//! transactions excluded
+//! \def key : block_num_u64 (BE)
+//! \def value : cumulative transaction count (u64 BE)
+//! \remark Written along with kCumulativeGasIndex
+inline constexpr const char* kCumulativeTransactionIndexName{"CumulativeTransactionIndex"};
+inline constexpr db::MapConfig kCumulativeTransactionIndex{kCumulativeTransactionIndexName};
+
 inline constexpr const char* kRuntimeStatesName{"RuntimeStates"};
 inline constexpr db::MapConfig kRuntimeStates{kRuntimeStatesName};
 
@@ -401,6 +425,8 @@ inline constexpr db::MapConfig kChainDataTables[]{
     kCallToIndex,
     kCallTraceSet,
     kCanonicalHashes,
+    kCumulativeGasIndex,
+    kCumulativeTransactionIndex,
     kHeaders,
     kDifficulty,
     kCode,
@@ -63,6 +63,10 @@ static_assert(kLocationLength == sizeof(evmc::bytes32));
 inline constexpr size_t kPlainStoragePrefixLength{kAddressLength + kIncarnationLength};
 inline constexpr size_t kHashedStoragePrefixLength{kHashLength + kIncarnationLength};
 
+//! Flags following the address in CallTraceSet values
+inline constexpr uint8_t kCallTraceFromFlag{1};
+inline constexpr uint8_t kCallTraceToFlag{2};
+
 enum RuntimeState: uint64_t {
     kLibProcessed, // Last irreversible block processed.
 };
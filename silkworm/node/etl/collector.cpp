@@ -25,11 +25,24 @@
 #include <silkworm/infra/common/log.hpp>
 #include <silkworm/infra/common/stopwatch.hpp>
 #include <silkworm/infra/concurrency/signal_handler.hpp>
+#include <silkworm/infra/metrics/registry.hpp>
 
 namespace silkworm::etl {
 
 namespace fs = std::filesystem;
 
+static metrics::Histogram& flush_duration() {
+    static auto& histogram{metrics::default_registry().histogram(
+        "silkworm_etl_flush_duration_seconds", "ETL buffer sort and flush to file duration", 1e-9)};
+    return histogram;
+}
+
+static metrics::Histogram& load_duration() {
+    static auto& histogram{metrics::default_registry().histogram(
+        "silkworm_etl_load_duration_seconds", "ETL collected data load into database duration", 1e-9)};
+    return histogram;
+}
+
 Collector::~Collector() {
     clear();  // Will ensure all files (if any) have been orderly closed and deleted
     if (work_path_managed_ && fs::exists(work_path_)) {
@@ -39,6 +52,7 @@ Collector::~Collector() {
 
 void Collector::flush_buffer() {
     if (buffer_.size()) {
+        metrics::ScopedTimer timer{flush_duration()};
         StopWatch sw(/*auto_start=*/true);
         buffer_.sort();
 
@@ -84,6 +98,7 @@ void Collector::load(db::RWCursorDupSort& target, const LoadFunc& load_func, MDB
     if (empty()) {
         return;
     }
+    metrics::ScopedTimer timer{load_duration()};
 
     if (file_providers_.empty()) {
         buffer_.sort();
@@ -0,0 +1,626 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "compressor.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <future>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <queue>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <silkworm/core/common/assert.hpp>
+#include <silkworm/core/common/cast.hpp>
+#include <silkworm/core/common/endian.hpp>
+#include <silkworm/core/common/hash_maps.hpp>
+#include <silkworm/infra/common/log.hpp>
+#include <silkworm/infra/common/memory_mapped_file.hpp>
+
+namespace silkworm::huffman {
+
+namespace {
+
+    //! Estimated cost in bits of a pattern in the encoded word (i.e. pattern code plus position code) used to cover
+    constexpr uint64_t kPatternCostBits{24};
+
+    //! Cost in bits of one uncovered byte in the encoded word
+    constexpr uint64_t kUncoveredByteCostBits{CHAR_BIT};
+
+    //! Max number of chunks encoded in memory in parallel for each worker before writing them
+    constexpr std::size_t kEncodedChunksPerWorker{2};
+
+    //! Compression uses Google ProtocolBuffers encoding (see also Go "varint" encoding)
+    void write_varint(uint64_t value, Bytes& out) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    void write_big_u64(uint64_t value, Bytes& out) {
+        out.resize(out.size() + sizeof(uint64_t));
+        endian::store_big_u64(out.data() + out.size() - sizeof(uint64_t), value);
+    }
+
+    uint64_t read_varint(ByteView data, std::size_t& offset) {
+        uint64_t value{0};
+        for (unsigned shift{0}; offset < data.size() && shift < 64; shift += 7) {
+            const uint8_t b = data[offset++];
+            value |= uint64_t{b & 0x7fu} << shift;
+            if ((b & 0x80) == 0) {
+                return value;
+            }
+        }
+        throw std::runtime_error{"invalid word length in spooled words at " + std::to_string(offset)};
+    }
+
+    //! Apply the function to each word in the chunk of spooled words
+    template <typename F>
+    void for_each_word(ByteView chunk, F&& fn) {
+        std::size_t offset{0};
+        while (offset < chunk.size()) {
+            const auto length = read_varint(chunk, offset);
+            fn(chunk.substr(offset, length));
+            offset += length;
+        }
+    }
+
+    //! Huffman code: the bits are reversed so that they can be written least significant first
+    struct Code {
+        uint64_t bits{0};
+        uint8_t length{0};
+    };
+
+    //! Compute the Huffman code lengths, i.e. the symbol depths in the Huffman tree, given the symbol frequencies
+    std::vector<uint8_t> huffman_depths(std::span<const uint64_t> frequencies) {
+        const std::size_t symbols_count = frequencies.size();
+        std::vector<uint8_t> depths(symbols_count, 0);
+        if (symbols_count < 2) {
+            return depths;
+        }
+        // Leaves are the nodes [0, symbols_count), each internal node has an index greater than its children
+        std::vector<std::size_t> parents(2 * symbols_count - 1, 0);
+        using Node = std::pair<uint64_t, std::size_t>;  // (weight, index)
+        std::priority_queue<Node, std::vector<Node>, std::greater<>> queue;
+        for (std::size_t i{0}; i < symbols_count; ++i) {
+            queue.emplace(frequencies[i], i);
+        }
+        for (std::size_t next{symbols_count}; queue.size() > 1; ++next) {
+            const auto [weight0, node0] = queue.top();
+            queue.pop();
+            const auto [weight1, node1] = queue.top();
+            queue.pop();
+            parents[node0] = parents[node1] = next;
+            queue.emplace(weight0 + weight1, next);
+        }
+        std::vector<uint8_t> node_depths(parents.size(), 0);
+        for (std::size_t i{parents.size() - 1}; i-- > 0;) {
+            node_depths[i] = static_cast<uint8_t>(node_depths[parents[i]] + 1);
+        }
+        std::copy_n(node_depths.begin(), symbols_count, depths.begin());
+        return depths;
+    }
+
+    //! Assign the canonical Huffman codes to the symbols given in tree order, i.e. by ascending depth
+    //! @details Decompressor reads the first code bit as the left/right choice at the root, so the canonical codes
+    //! are emitted most significant bit first by reversing them
+    template <typename GetDepth, typename SetCode>
+    void assign_canonical_codes(std::size_t symbols_count, GetDepth&& depth_of, SetCode&& set_code) {
+        uint64_t code{0};
+        uint8_t previous_depth{0};
+        for (std::size_t i{0}; i < symbols_count; ++i) {
+            const uint8_t depth = depth_of(i);
+            SILKWORM_ASSERT(depth <= 64);
+            code <<= (depth - previous_depth);
+            uint64_t reversed{0};
+            for (uint8_t b{0}; b < depth; ++b) {
+                reversed |= ((code >> b) & 1) << (depth - 1 - b);
+            }
+            set_code(i, Code{reversed, depth});
+            ++code;
+            previous_depth = depth;
+        }
+    }
+
+    //! Trie of dictionary patterns keyed by (node, next byte) to find all the patterns matching at some word offset
+    class PatternTrie {
+      public:
+        explicit PatternTrie(const std::vector<Bytes>& patterns) : patterns_(patterns), terminals_(1, kNoPattern) {
+            for (uint32_t p{0}; p < patterns.size(); ++p) {
+                uint32_t node{0};
+                for (const uint8_t b : patterns[p]) {
+                    const auto [it, inserted] = edges_.try_emplace(edge(node, b), static_cast<uint32_t>(terminals_.size()));
+                    if (inserted) {
+                        terminals_.push_back(kNoPattern);
+                    }
+                    node = it->second;
+                }
+                terminals_[node] = p;
+            }
+        }
+
+        //! Apply the function to the index of each pattern matching the data at the specified offset
+        template <typename F>
+        void for_each_match(ByteView data, std::size_t offset, F&& fn) const {
+            uint32_t node{0};
+            for (std::size_t i{offset}; i < data.size(); ++i) {
+                const auto it = edges_.find(edge(node, data[i]));
+                if (it == edges_.end()) {
+                    return;
+                }
+                node = it->second;
+                if (terminals_[node] != kNoPattern) {
+                    fn(terminals_[node]);
+                }
+            }
+        }
+
+        [[nodiscard]] const Bytes& pattern(uint32_t index) const { return patterns_[index]; }
+
+      private:
+        static constexpr uint32_t kNoPattern{std::numeric_limits<uint32_t>::max()};
+
+        static uint64_t edge(uint32_t node, uint8_t b) { return (uint64_t{node} << CHAR_BIT) | b; }
+
+        const std::vector<Bytes>& patterns_;
+        FlatHashMap<uint64_t, uint32_t> edges_;
+        std::vector<uint32_t> terminals_;
+    };
+
+    //! Occurrence of a dictionary pattern in a word
+    struct PatternMatch {
+        std::size_t offset{0};
+        uint32_t pattern{0};
+    };
+
+    //! Find the non-overlapping patterns covering the word at minimum estimated cost by dynamic programming
+    class WordCover {
+      public:
+        explicit WordCover(const PatternTrie& trie) : trie_(trie) {}
+
+        const std::vector<PatternMatch>& cover(ByteView word) {
+            const std::size_t length = word.size();
+            costs_.assign(length + 1, 0);
+            choices_.assign(length, kUncovered);
+            for (std::size_t i{length}; i-- > 0;) {
+                costs_[i] = kUncoveredByteCostBits + costs_[i + 1];
+                trie_.for_each_match(word, i, [&](uint32_t p) {
+                    const uint64_t cost = kPatternCostBits + costs_[i + trie_.pattern(p).size()];
+                    if (cost < costs_[i]) {
+                        costs_[i] = cost;
+                        choices_[i] = p;
+                    }
+                });
+            }
+            matches_.clear();
+            for (std::size_t i{0}; i < length;) {
+                if (choices_[i] == kUncovered) {
+                    ++i;
+                } else {
+                    matches_.push_back({i, choices_[i]});
+                    i += trie_.pattern(choices_[i]).size();
+                }
+            }
+            return matches_;
+        }
+
+      private:
+        static constexpr uint32_t kUncovered{std::numeric_limits<uint32_t>::max()};
+
+        const PatternTrie& trie_;
+        std::vector<uint64_t> costs_;
+        std::vector<uint32_t> choices_;
+        std::vector<PatternMatch> matches_;
+    };
+
+    //! Writer of codes into a byte buffer starting from the least significant bit
+    class BitWriter {
+      public:
+        explicit BitWriter(Bytes& out) : out_(out) {}
+
+        void write(const Code& code) {
+            for (uint8_t written{0}; written < code.length;) {
+                if (bit_position_ == 0) {
+                    out_.push_back(0);
+                }
+                const auto count = std::min<uint8_t>(static_cast<uint8_t>(code.length - written),
+                                                     static_cast<uint8_t>(CHAR_BIT - bit_position_));
+                const auto bits = static_cast<uint8_t>((code.bits >> written) & ((1u << count) - 1));
+                out_.back() = static_cast<uint8_t>(out_.back() | (bits << bit_position_));
+                written = static_cast<uint8_t>(written + count);
+                bit_position_ = static_cast<uint8_t>((bit_position_ + count) % CHAR_BIT);
+            }
+        }
+
+        //! Pad the last byte, so that next write starts at a new byte
+        void flush() { bit_position_ = 0; }
+
+      private:
+        Bytes& out_;
+        uint8_t bit_position_{0};
+    };
+
+    //! Repeated substring found in a sample of words
+    struct Repeat {
+        uint64_t score{0};
+        std::size_t offset{0};
+        std::size_t length{0};
+        uint64_t count{0};
+    };
+
+    //! Find the repeated substrings in the sample by enumerating the LCP intervals of its suffix array
+    //! @details Suffixes are clipped at the end of their word and at the max pattern length, so that the comparisons
+    //! are bounded and no pattern spans two words
+    std::vector<std::pair<Bytes, uint64_t>> find_repeats(ByteView sample, std::span<const uint32_t> word_ends) {
+        std::vector<uint32_t> suffixes;
+        suffixes.reserve(sample.size());
+        for (uint32_t i{0}; i < sample.size(); ++i) {
+            if (word_ends[i] - i >= Compressor::kMinPatternLength) {
+                suffixes.push_back(i);
+            }
+        }
+        const auto clipped = [&](uint32_t i) {
+            return sample.substr(i, std::min<std::size_t>(word_ends[i] - i, Compressor::kMaxPatternLength));
+        };
+        std::sort(suffixes.begin(), suffixes.end(), [&](uint32_t lhs, uint32_t rhs) {
+            return clipped(lhs) < clipped(rhs);
+        });
+
+        // Stack-based bottom-up traversal of the LCP intervals: each one is a substring repeated interval size times
+        std::vector<Repeat> repeats;
+        struct Interval {
+            std::size_t lcp{0};
+            std::size_t left{0};
+        };
+        std::vector<Interval> stack{{}};
+        for (std::size_t k{1}; k <= suffixes.size(); ++k) {
+            std::size_t lcp{0};
+            if (k < suffixes.size()) {
+                const ByteView previous{clipped(suffixes[k - 1])}, current{clipped(suffixes[k])};
+                const auto limit = std::min(previous.size(), current.size());
+                while (lcp < limit && previous[lcp] == current[lcp]) ++lcp;
+            }
+            std::size_t left{k - 1};
+            while (lcp < stack.back().lcp) {
+                const Interval interval{stack.back()};
+                stack.pop_back();
+                if (interval.lcp >= Compressor::kMinPatternLength) {
+                    const uint64_t count{k - interval.left};
+                    repeats.push_back({count * interval.lcp, suffixes[interval.left], interval.lcp, count});
+                }
+                left = interval.left;
+            }
+            if (lcp > stack.back().lcp) {
+                stack.push_back({lcp, left});
+            }
+        }
+
+        // Keep just the best ones, there cannot be more than that in the final dictionary
+        const auto by_score = [](const Repeat& lhs, const Repeat& rhs) { return lhs.score > rhs.score; };
+        if (repeats.size() > Compressor::kMaxDictionaryPatterns) {
+            std::nth_element(repeats.begin(), repeats.begin() + Compressor::kMaxDictionaryPatterns, repeats.end(), by_score);
+            repeats.resize(Compressor::kMaxDictionaryPatterns);
+        }
+        std::vector<std::pair<Bytes, uint64_t>> result;
+        result.reserve(repeats.size());
+        for (const auto& repeat : repeats) {
+            result.emplace_back(Bytes{sample.substr(repeat.offset, repeat.length)}, repeat.count);
+        }
+        return result;
+    }
+
+    //! Wait for all the futures before getting any result, so that no task is still running if one of them has thrown
+    template <typename T>
+    std::vector<T> get_all(std::vector<std::future<T>>& futures) {
+        for (auto& future : futures) {
+            future.wait();
+        }
+        std::vector<T> results;
+        results.reserve(futures.size());
+        for (auto& future : futures) {
+            results.push_back(future.get());
+        }
+        return results;
+    }
+
+}  // namespace
+
+Compressor::Compressor(std::filesystem::path compressed_path, const std::filesystem::path& tmp_dir, unsigned workers_count)
+    : compressed_path_(std::move(compressed_path)),
+      words_path_(tmp_dir / (compressed_path_.filename().string() + ".words.tmp")),
+      words_file_(words_path_, std::ios::binary | std::ios::trunc),
+      workers_count_(std::max(workers_count, 1u)) {
+    if (!words_file_) {
+        throw std::runtime_error{"cannot create temporary file: " + words_path_.string()};
+    }
+}
+
+Compressor::~Compressor() {
+    words_file_.close();
+    std::error_code ec;
+    std::filesystem::remove(words_path_, ec);
+}
+
+void Compressor::add_word(ByteView word) {
+    if (compressed_) {
+        throw std::logic_error{"compressor already done, cannot add words to: " + compressed_path_.string()};
+    }
+    Bytes length;
+    write_varint(word.size(), length);
+    words_file_.write(byte_ptr_cast(length.data()), static_cast<std::streamsize>(length.size()));
+    words_file_.write(byte_ptr_cast(word.data()), static_cast<std::streamsize>(word.size()));
+    words_size_ += length.size() + word.size();
+
+    if (word.empty()) {
+        ++empty_words_count_;
+    }
+    if (++words_count_ % kWordsPerChunk == 0) {
+        chunk_offsets_.push_back(words_size_);
+    }
+}
+
+std::vector<Bytes> Compressor::build_dictionary(const Chunks& chunks, ThreadPool& workers) const {
+    // Sample chunks evenly spread over the data, then find the repeats in each sample in parallel
+    const std::size_t sample_step = std::max<std::size_t>(chunks.size() / kMaxSampledChunks, 1);
+    std::vector<std::future<std::vector<std::pair<Bytes, uint64_t>>>> sample_results;
+    for (std::size_t c{0}; c < chunks.size(); c += sample_step) {
+        sample_results.push_back(workers.submit([chunk = chunks[c]]() {
+            Bytes sample;
+            std::vector<uint32_t> word_ends;
+            for_each_word(chunk, [&](ByteView word) {
+                if (sample.size() + word.size() > kMaxSampleSize) return;
+                sample.append(word);
+                word_ends.resize(sample.size(), static_cast<uint32_t>(sample.size()));
+            });
+            return find_repeats(sample, word_ends);
+        }));
+    }
+    std::vector<std::pair<Bytes, uint64_t>> pattern_counts;
+    for (auto& repeats : get_all(sample_results)) {
+        std::move(repeats.begin(), repeats.end(), std::back_inserter(pattern_counts));
+    }
+
+    // Merge the counts of the same pattern found in different samples, then select the best patterns by score,
+    // i.e. the ones saving most bytes
+    std::sort(pattern_counts.begin(), pattern_counts.end());
+    std::vector<std::pair<uint64_t, Bytes>> candidates;
+    for (std::size_t i{0}; i < pattern_counts.size();) {
+        uint64_t count{0};
+        std::size_t j{i};
+        for (; j < pattern_counts.size() && pattern_counts[j].first == pattern_counts[i].first; ++j) {
+            count += pattern_counts[j].second;
+        }
+        const uint64_t score = count * pattern_counts[i].first.size();
+        if (score >= kMinPatternScore) {
+            candidates.emplace_back(score, std::move(pattern_counts[i].first));
+        }
+        i = j;
+    }
+    std::sort(candidates.begin(), candidates.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.first != rhs.first ? lhs.first > rhs.first : lhs.second < rhs.second;
+    });
+    if (candidates.size() > kMaxDictionaryPatterns) {
+        candidates.resize(kMaxDictionaryPatterns);
+    }
+    std::vector<Bytes> patterns;
+    patterns.reserve(candidates.size());
+    for (auto& candidate : candidates) {
+        patterns.push_back(std::move(candidate.second));
+    }
+    return patterns;
+}
+
+void Compressor::compress() {
+    if (compressed_) {
+        throw std::logic_error{"compressor already done for: " + compressed_path_.string()};
+    }
+    compressed_ = true;
+    words_file_.close();
+    if (!words_file_) {
+        throw std::runtime_error{"cannot write temporary file: " + words_path_.string()};
+    }
+    SILK_INFO << "Compress words: " << words_count_ << " to: " << compressed_path_.string() << " start";
+
+    // Split the spooled words in chunks
+    std::unique_ptr<MemoryMappedFile> words_map;
+    Chunks chunks;
+    if (words_size_ > 0) {
+        words_map = std::make_unique<MemoryMappedFile>(words_path_);
+        words_map->advise_sequential();
+        const ByteView words{words_map->address(), words_map->length()};
+        if (chunk_offsets_.back() != words_size_) {
+            chunk_offsets_.push_back(words_size_);
+        }
+        for (std::size_t i{0}; i + 1 < chunk_offsets_.size(); ++i) {
+            chunks.push_back(words.substr(chunk_offsets_[i], chunk_offsets_[i + 1] - chunk_offsets_[i]));
+        }
+    }
+
+    ThreadPool workers{workers_count_};
+    const std::vector<Bytes> patterns = build_dictionary(chunks, workers);
+    const PatternTrie trie{patterns};
+    SILK_DEBUG << "Compress dictionary patterns: " << patterns.size();
+
+    // First pass: count the usages of each pattern and position, each worker taking a contiguous range of chunks
+    struct Usages {
+        std::vector<uint64_t> patterns;
+        FlatHashMap<uint64_t, uint64_t> positions;
+    };
+    const std::size_t chunks_per_worker = (chunks.size() + workers_count_ - 1) / workers_count_;
+    std::vector<std::future<Usages>> usage_results;
+    for (std::size_t first{0}; first < chunks.size(); first += chunks_per_worker) {
+        const std::size_t last = std::min(first + chunks_per_worker, chunks.size());
+        usage_results.push_back(workers.submit([&, first, last]() {
+            Usages usages{std::vector<uint64_t>(patterns.size(), 0), {}};
+            WordCover word_cover{trie};
+            for (std::size_t c{first}; c < last; ++c) {
+                for_each_word(chunks[c], [&](ByteView word) {
+                    ++usages.positions[word.size() + 1];
+                    if (word.empty()) return;
+                    std::size_t previous_offset{0};
+                    for (const auto& match : word_cover.cover(word)) {
+                        ++usages.patterns[match.pattern];
+                        ++usages.positions[match.offset - previous_offset + 1];
+                        previous_offset = match.offset;
+                    }
+                    ++usages.positions[0];
+                });
+            }
+            return usages;
+        }));
+    }
+    std::vector<uint64_t> pattern_uses(patterns.size(), 0);
+    FlatHashMap<uint64_t, uint64_t> position_uses;
+    for (const auto& usages : get_all(usage_results)) {
+        for (std::size_t p{0}; p < patterns.size(); ++p) {
+            pattern_uses[p] += usages.patterns[p];
+        }
+        for (const auto& [position, uses] : usages.positions) {
+            position_uses[position] += uses;
+        }
+    }
+
+    // Build the Huffman codes for the used patterns and write the dictionary in tree order
+    std::vector<uint32_t> used_patterns;
+    std::vector<uint64_t> used_pattern_uses;
+    for (uint32_t p{0}; p < patterns.size(); ++p) {
+        if (pattern_uses[p] > 0) {
+            used_patterns.push_back(p);
+            used_pattern_uses.push_back(pattern_uses[p]);
+        }
+    }
+    const auto pattern_depths = huffman_depths(used_pattern_uses);
+    std::vector<std::size_t> pattern_order(used_patterns.size());
+    for (std::size_t i{0}; i < pattern_order.size(); ++i) pattern_order[i] = i;
+    std::stable_sort(pattern_order.begin(), pattern_order.end(), [&](std::size_t lhs, std::size_t rhs) {
+        return pattern_depths[lhs] < pattern_depths[rhs];
+    });
+    std::vector<Code> pattern_codes(patterns.size());
+    Bytes pattern_dict;
+    assign_canonical_codes(
+        pattern_order.size(),
+        [&](std::size_t i) { return pattern_depths[pattern_order[i]]; },
+        [&](std::size_t i, Code code) {
+            const Bytes& pattern = patterns[used_patterns[pattern_order[i]]];
+            pattern_codes[used_patterns[pattern_order[i]]] = code;
+            write_varint(code.length, pattern_dict);
+            write_varint(pattern.size(), pattern_dict);
+            pattern_dict.append(pattern);
+        });
+
+    // Build the Huffman codes for the positions and write the dictionary in tree order
+    std::vector<uint64_t> positions;
+    positions.reserve(position_uses.size());
+    for (const auto& [position, _] : position_uses) {
+        positions.push_back(position);
+    }
+    std::sort(positions.begin(), positions.end());
+    std::vector<uint64_t> position_frequencies;
+    position_frequencies.reserve(positions.size());
+    for (const auto position : positions) {
+        position_frequencies.push_back(position_uses[position]);
+    }
+    auto position_depths = huffman_depths(position_frequencies);
+    if (position_depths.size() == 1) {
+        // Each word needs at least one bit for its length, otherwise a data stream made of empty words is empty
+        position_depths[0] = 1;
+    }
+    std::vector<std::size_t> position_order(positions.size());
+    for (std::size_t i{0}; i < position_order.size(); ++i) position_order[i] = i;
+    std::stable_sort(position_order.begin(), position_order.end(), [&](std::size_t lhs, std::size_t rhs) {
+        return position_depths[lhs] < position_depths[rhs];
+    });
+    FlatHashMap<uint64_t, Code> position_codes;
+    Bytes position_dict;
+    assign_canonical_codes(
+        position_order.size(),
+        [&](std::size_t i) { return position_depths[position_order[i]]; },
+        [&](std::size_t i, Code code) {
+            const uint64_t position = positions[position_order[i]];
+            position_codes[position] = code;
+            write_varint(code.length, position_dict);
+            write_varint(position, position_dict);
+        });
+
+    const std::filesystem::path tmp_path{compressed_path_.string() + ".tmp"};
+    std::ofstream out{tmp_path, std::ios::binary | std::ios::trunc};
+    if (!out) {
+        throw std::runtime_error{"cannot create compressed file: " + tmp_path.string()};
+    }
+    Bytes header;
+    write_big_u64(words_count_, header);
+    write_big_u64(empty_words_count_, header);
+    write_big_u64(pattern_dict.size(), header);
+    header.append(pattern_dict);
+    write_big_u64(position_dict.size(), header);
+    header.append(position_dict);
+    out.write(byte_ptr_cast(header.data()), static_cast<std::streamsize>(header.size()));
+
+    // Second pass: encode the chunks in parallel, then write them in order
+    const auto encode_chunk = [&](std::size_t c) {
+        Bytes encoded;
+        Bytes uncovered;
+        BitWriter writer{encoded};
+        WordCover word_cover{trie};
+        for_each_word(chunks[c], [&](ByteView word) {
+            writer.write(position_codes.at(word.size() + 1));
+            if (!word.empty()) {
+                std::size_t previous_offset{0}, uncovered_from{0};
+                for (const auto& match : word_cover.cover(word)) {
+                    writer.write(position_codes.at(match.offset - previous_offset + 1));
+                    writer.write(pattern_codes[match.pattern]);
+                    uncovered.append(word.substr(uncovered_from, match.offset - uncovered_from));
+                    previous_offset = match.offset;
+                    uncovered_from = match.offset + patterns[match.pattern].size();
+                }
+                writer.write(position_codes.at(0));
+                uncovered.append(word.substr(uncovered_from));
+            }
+            // Each word starts at a new byte and its uncovered bytes follow the codes
+            writer.flush();
+            encoded.append(uncovered);
+            uncovered.clear();
+        });
+        return encoded;
+    };
+    const std::size_t batch_size = workers_count_ * kEncodedChunksPerWorker;
+    for (std::size_t first{0}; first < chunks.size(); first += batch_size) {
+        std::vector<std::future<Bytes>> encoded_chunks;
+        for (std::size_t c{first}; c < std::min(first + batch_size, chunks.size()); ++c) {
+            encoded_chunks.push_back(workers.submit(encode_chunk, c));
+        }
+        for (const auto& encoded : get_all(encoded_chunks)) {
+            out.write(byte_ptr_cast(encoded.data()), static_cast<std::streamsize>(encoded.size()));
+        }
+    }
+    out.close();
+    if (!out) {
+        throw std::runtime_error{"cannot write compressed file: " + tmp_path.string()};
+    }
+    std::filesystem::rename(tmp_path, compressed_path_);
+
+    SILK_INFO << "Compress words: " << words_count_ << " to: " << compressed_path_.string() << " end [patterns="
+              << used_patterns.size() << " positions=" << positions.size() << "]";
+}
+
+}  // namespace silkworm::huffman
@@ -0,0 +1,110 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#include <silkworm/core/common/base.hpp>
+#include <silkworm/infra/concurrency/thread_pool.hpp>
+
+namespace silkworm::huffman {
+
+//! Snapshot encoder producing the compressed files read by Decompressor
+//! @details Words are spooled to a temporary file as they are added. When compressing, a dictionary of the most
+//! valuable repeated patterns is extracted from a sample of the words, then each word is covered by patterns twice:
+//! the first pass counts pattern and position usages to build the Huffman codes, the second one encodes the words.
+//! Both the dictionary sampling and the passes run on parallel chunks of words.
+class Compressor {
+  public:
+    //! The min length of the patterns in the dictionary
+    constexpr static std::size_t kMinPatternLength{5};
+
+    //! The max length of the patterns in the dictionary
+    constexpr static std::size_t kMaxPatternLength{128};
+
+    //! The max number of patterns in the dictionary
+    constexpr static std::size_t kMaxDictionaryPatterns{64 * 1024};
+
+    //! The min score (i.e. occurrences times length) for a pattern to enter the dictionary
+    constexpr static uint64_t kMinPatternScore{1'024};
+
+    //! The number of words in each chunk processed in parallel
+    constexpr static std::size_t kWordsPerChunk{16 * 1'024};
+
+    //! The max number of chunks sampled to build the dictionary
+    constexpr static std::size_t kMaxSampledChunks{64};
+
+    //! The max size in bytes of the words sampled from each chunk to build the dictionary
+    constexpr static std::size_t kMaxSampleSize{1_Mebi};
+
+    explicit Compressor(std::filesystem::path compressed_path,
+                        const std::filesystem::path& tmp_dir,
+                        unsigned workers_count = std::thread::hardware_concurrency());
+    ~Compressor();
+
+    Compressor(const Compressor&) = delete;
+    Compressor& operator=(const Compressor&) = delete;
+
+    [[nodiscard]] const std::filesystem::path& compressed_path() const { return compressed_path_; }
+
+    [[nodiscard]] uint64_t words_count() const { return words_count_; }
+
+    [[nodiscard]] uint64_t empty_words_count() const { return empty_words_count_; }
+
+    //! Append one word to the data, the word order is preserved in the compressed file
+    void add_word(ByteView word);
+
+    //! Build the dictionaries and write the compressed file, no more words can be added afterwards
+    void compress();
+
+  private:
+    using Chunks = std::vector<ByteView>;
+
+    [[nodiscard]] std::vector<Bytes> build_dictionary(const Chunks& chunks, ThreadPool& workers) const;
+
+    //! The path to the compressed file
+    std::filesystem::path compressed_path_;
+
+    //! The path to the temporary file where words are spooled
+    std::filesystem::path words_path_;
+
+    //! The temporary file where words are spooled as varint length followed by data
+    std::ofstream words_file_;
+
+    //! The number of worker threads used to compress
+    unsigned workers_count_;
+
+    //! The offsets in the temporary file of the first word in each chunk
+    std::vector<uint64_t> chunk_offsets_{0};
+
+    //! The current size of the temporary file
+    uint64_t words_size_{0};
+
+    //! The number of words added
+    uint64_t words_count_{0};
+
+    //! The number of *empty* words added
+    uint64_t empty_words_count_{0};
+
+    //! Flag indicating if the compressed file has been written
+    bool compressed_{false};
+};
+
+}  // namespace silkworm::huffman
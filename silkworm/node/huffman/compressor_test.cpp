@@ -0,0 +1,129 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "compressor.hpp"
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/core/common/endian.hpp>
+#include <silkworm/core/common/util.hpp>
+#include <silkworm/infra/common/directories.hpp>
+#include <silkworm/infra/test/log.hpp>
+#include <silkworm/node/huffman/decompressor.hpp>
+
+namespace silkworm::huffman {
+
+//! Compress the words, then check that decompressing gives them back in the same order
+static void check_round_trip(const std::vector<Bytes>& words, unsigned workers_count = 4) {
+    TemporaryDirectory tmp_dir;
+    const auto compressed_path{tmp_dir.path() / "test.seg"};
+    Compressor compressor{compressed_path, tmp_dir.path(), workers_count};
+    for (const auto& word : words) {
+        compressor.add_word(word);
+    }
+    compressor.compress();
+    CHECK(compressor.words_count() == words.size());
+
+    Decompressor decoder{compressed_path};
+    REQUIRE_NOTHROW(decoder.open());
+    CHECK(decoder.words_count() == words.size());
+    CHECK(decoder.empty_words_count() == compressor.empty_words_count());
+    auto it = decoder.make_iterator();
+    Bytes buffer;
+    for (const auto& word : words) {
+        REQUIRE(it.has_next());
+        buffer.clear();
+        it.next(buffer);
+        CHECK(buffer == word);
+    }
+    CHECK(!it.has_next());
+}
+
+TEST_CASE("Compressor::compress no words", "[silkworm][snapshot][compressor]") {
+    test::SetLogVerbosityGuard guard{log::Level::kNone};
+    check_round_trip({});
+}
+
+TEST_CASE("Compressor::compress single word", "[silkworm][snapshot][compressor]") {
+    test::SetLogVerbosityGuard guard{log::Level::kNone};
+    SECTION("empty") {
+        check_round_trip({Bytes{}});
+    }
+    SECTION("not empty") {
+        check_round_trip({*from_hex("68656c6c6f20776f726c64")});
+    }
+}
+
+TEST_CASE("Compressor::compress without patterns", "[silkworm][snapshot][compressor]") {
+    test::SetLogVerbosityGuard guard{log::Level::kNone};
+    std::vector<Bytes> words;
+    for (uint8_t i{0}; i < 100; ++i) {
+        words.emplace_back(Bytes(i % 7, i));
+    }
+    check_round_trip(words);
+}
+
+TEST_CASE("Compressor::compress with patterns", "[silkworm][snapshot][compressor]") {
+    test::SetLogVerbosityGuard guard{log::Level::kNone};
+    const Bytes prefix{*from_hex("f90211a0d7e8c5e5b7c0a5b4e1b7f0a8c3e9d2f1")};
+    const Bytes suffix{*from_hex("94a94f5374fce5edbc8e2a8697c15331677e6ebf0b808080")};
+    std::vector<Bytes> words;
+    const std::size_t words_count{3 * Compressor::kWordsPerChunk + 123};  // more than one chunk
+    std::size_t raw_size{0};
+    for (std::size_t i{0}; i < words_count; ++i) {
+        Bytes word;
+        if (i % 10 != 0) {  // some empty words
+            word = prefix;
+            word.resize(word.size() + sizeof(uint64_t));
+            endian::store_big_u64(word.data() + prefix.size(), i);
+            word.append(suffix.substr(0, i % suffix.size()));
+        }
+        raw_size += word.size();
+        words.push_back(std::move(word));
+    }
+
+    SECTION("one worker") {
+        check_round_trip(words, 1);
+    }
+    SECTION("many workers") {
+        check_round_trip(words, 4);
+    }
+    SECTION("compressed size") {
+        TemporaryDirectory tmp_dir;
+        const auto compressed_path{tmp_dir.path() / "test.seg"};
+        Compressor compressor{compressed_path, tmp_dir.path()};
+        for (const auto& word : words) {
+            compressor.add_word(word);
+        }
+        compressor.compress();
+        CHECK(std::filesystem::file_size(compressed_path) < raw_size / 2);
+    }
+}
+
+TEST_CASE("Compressor::add_word after compress", "[silkworm][snapshot][compressor]") {
+    test::SetLogVerbosityGuard guard{log::Level::kNone};
+    TemporaryDirectory tmp_dir;
+    Compressor compressor{tmp_dir.path() / "test.seg", tmp_dir.path()};
+    compressor.compress();
+    CHECK_THROWS_AS(compressor.add_word(Bytes{}), std::logic_error);
+    CHECK_THROWS_AS(compressor.compress(), std::logic_error);
+}
+
+}  // namespace silkworm::huffman
@@ -16,7 +16,7 @@
 
 #include "decompressor.hpp"
 
-#include <bitset>
+#include <iomanip>
 #include <stdexcept>
 #include <utility>
 #include <vector>
@@ -45,252 +45,85 @@ constexpr std::size_t kMinimumFileSize = 32;
 //! Maximum allowed depth in compressed file
 constexpr std::size_t kMaxAllowedDepth = 2048;
 
-DecodingTable::DecodingTable(std::size_t max_depth) : max_depth_(max_depth) {
-    bit_length_ = max_depth_ > kMaxTableBitLength ? kMaxTableBitLength : max_depth_;
+template <typename T>
+DecodingTable<T>::DecodingTable(std::size_t max_depth) : max_depth_(max_depth) {
+    bit_length_ = max_depth_ > kRootBitLength ? kRootBitLength : max_depth_;
+    add_table(bit_length_);
 }
 
-CodeWord::CodeWord() : CodeWord(0, 0, {}, nullptr, nullptr) {}
-
-CodeWord::CodeWord(uint16_t code, uint8_t length, ByteView pattern)
-    : CodeWord(code, length, pattern, nullptr, nullptr) {}
-
-CodeWord::CodeWord(uint16_t code, uint8_t length, ByteView pattern, std::unique_ptr<PatternTable> table, CodeWord* next)
-    : code_(code), code_length_(length), pattern_(pattern), table_(std::move(table)), next_(next) {}
-
-void CodeWord::reset_content(uint16_t code, uint8_t length, ByteView pattern) {
-    code_ = code;
-    code_length_ = length;
-    pattern_ = pattern;
-    table_ = nullptr;
-}
-
-void CodeWord::set_next(CodeWord* next) {
-    next_ = next;
-}
-
-std::ostream& operator<<(std::ostream& out, const PatternTable& pt) {
-    out << "Pattern Table:\n";
-    out << "bit length: " << pt.bit_length_ << "\n";
-    out << std::setfill('0');
-    const int bit_len = static_cast<int>(pt.bit_length_);
-    for (std::size_t i{0}; i < pt.codewords_.size(); ++i) {
-        const auto& cw = pt.codewords_[i];
-        if (cw) {
-            out << std::dec << std::setw(3) << i << " " << std::hex << std::setw(bit_len) << cw->code() << "\n";
-        } else {
-            out << std::dec << std::setw(3) << i << " NULL\n";
-        }
-    }
-    out << std::dec;
-    return out;
-}
-
-//! Build the table of word distances in range (0, 512) for each power of 2 in use except 2^0
-//! @details The resulting matrix has distance steps equal to 2^i for each i in (0, 9) i.e.
-//! 0 -> []
-//! 1 -> [2 4 6 8 10 12 ... 508 510]
-//! 2 -> [4 8 12 16 20 ... 504 508]
-//! ...
-//! 7 -> [128 256 384]
-//! 8 -> [256]
-//! 9 -> []
-//! @return the word distances for power of 2
-static PatternTable::WordDistances build_word_distances() {
-    PatternTable::WordDistances word_distances{};
-    for (std::size_t i{1}; i < PatternTable::kNumPowers; ++i) {
-        std::vector<int> distances{};
-        distances.reserve((std::size_t(1) << (PatternTable::kNumPowers - 1 - i)) - 1);
-        for (int j{1 << i}; 0 < j && j < PatternTable::kMaxPower; j += (1 << i)) {
-            distances.push_back(j);
-        }
-        word_distances[i] = std::move(distances);
-    }
-    return word_distances;
-}
-
-//! Initialize once and for all the word distances in the data for each power of 2
-const PatternTable::WordDistances PatternTable::word_distances_{build_word_distances()};
-
-//! Initialize condensed table threshold for bit length using default value
-std::size_t PatternTable::condensed_table_bit_length_threshold_{kDefaultCondensedTableBitLengthThreshold};
-
-void PatternTable::set_condensed_table_bit_length_threshold(std::size_t condensed_table_bit_length_threshold) {
-    if (condensed_table_bit_length_threshold > kMaxTableBitLength) {
-        throw std::invalid_argument{
-            "bit length threshold for condensed tables is too big: " +
-            std::to_string(condensed_table_bit_length_threshold) +
-            " max allowed value is: " +
-            std::to_string(kMaxTableBitLength)};
-    }
-    condensed_table_bit_length_threshold_ = condensed_table_bit_length_threshold;
-}
-
-PatternTable::PatternTable(std::size_t max_depth) : DecodingTable(max_depth) {
-    if (bit_length_ <= condensed_table_bit_length_threshold_) {
-        codewords_.resize(std::size_t(1) << bit_length_);
-    }
-}
-
-std::size_t PatternTable::build_condensed(std::span<Pattern> patterns) {
-    return build_condensed(patterns, max_depth_, 0, 0, 0);
-}
-
-std::size_t PatternTable::build_condensed(std::span<Pattern> patterns, uint64_t highest_depth, uint16_t code, int bits, uint64_t depth) {
-    SILK_DEBUG << "#patterns: " << patterns.size() << " highest_depth: " << highest_depth << " code: " << code
-               << " bits: " << std::bitset<CHAR_BIT>(static_cast<unsigned int>(bits)) << " depth: " << depth;
-    if (patterns.empty()) {
-        return 0;
-    }
-    const auto first_pattern = patterns.front();
-    if (depth == first_pattern.depth) {
-        insert_word(std::make_shared<CodeWord>(code, static_cast<uint8_t>(bits), first_pattern.value, nullptr, nullptr));
-        return 1;
-    }
-    if (bits == kMaxTableBitLength) {
-        auto new_table{std::make_unique<PatternTable>(highest_depth)};
-        const auto last_cw = insert_word(std::make_shared<CodeWord>(code, 0, ByteView{}, std::move(new_table), nullptr));
-        return last_cw->table()->build_condensed(patterns, highest_depth, 0, 0, depth);
-    }
-    const auto b0 = build_condensed(patterns, highest_depth - 1, code, bits + 1, depth + 1);
-    return b0 + build_condensed(patterns.subspan(b0), highest_depth - 1, static_cast<uint16_t>((1 << bits) | code), bits + 1, depth + 1);
-}
-
-CodeWord* PatternTable::insert_word(std::shared_ptr<CodeWord> codeword) {
-    CodeWord* inserted{nullptr};
-    if (bit_length_ <= condensed_table_bit_length_threshold_) {
-        const auto code_step = 1 << codeword->code_length();
-        const auto code_from = codeword->code();
-        const auto code_to =
-            bit_length_ != codeword->code_length() && codeword->code_length() > 0 ? code_from | 1 << bit_length_ : code_from + code_step;
-        for (auto c{code_from}; c < code_to; c += code_step) {
-            auto* cw = codewords_[c].get();
-            if (cw == nullptr) {
-                codewords_[c] = codeword;
-                inserted = codewords_[c].get();
-            } else {
-                cw->reset_content(c, codeword->code_length(), codeword->pattern());
-                inserted = cw;
-            }
-        }
-    } else {
-        codeword->set_next(nullptr);
-        if (head_ == nullptr) {
-            codewords_.push_back(std::move(codeword));
-            head_ = codewords_.front().get();
-            inserted = head_;
-        } else {
-            SILKWORM_ASSERT(!codewords_.empty());
-            codewords_.push_back(std::move(codeword));
-            inserted = codewords_.back().get();
-        }
-    }
-
-    return inserted;
-}
-
-const CodeWord* PatternTable::search_condensed(uint16_t code) const {
-    if (bit_length_ <= condensed_table_bit_length_threshold_) {
-        return codeword(code);
-    } else {
-        CodeWord* previous{nullptr};
-        for (auto* current = head_; current != nullptr; previous = current, current = current->next()) {
-            if (current->code() == code) {
-                if (previous != nullptr) {
-                    previous->set_next(current->next());
-                    current->set_next(head_);
-                    head_ = current;
-                }
-                return current;
-            }
-            const auto distance = code - current->code();
-            if ((distance & 0x1) != 0) {
-                continue;
-            }
-            if (check_distance(current->code_length(), distance)) {
-                if (previous != nullptr) {
-                    previous->set_next(current->next());
-                    current->set_next(head_);
-                    head_ = current;
-                }
-                return current;
-            }
-        }
-    }
-    return nullptr;
+template <typename T>
+std::size_t DecodingTable<T>::add_table(std::size_t bit_length) {
+    const std::size_t table_offset = blocks_.size() * kEntriesPerBlock;
+    const std::size_t table_size = std::size_t(1) << bit_length;
+    blocks_.resize(blocks_.size() + (table_size + kEntriesPerBlock - 1) / kEntriesPerBlock);
+    return table_offset;
 }
 
-bool PatternTable::check_distance(std::size_t power, int distance) {
-    const auto& distances = PatternTable::word_distances_[power];
-    auto it = std::find_if(distances.cbegin(), distances.cend(), [distance](const int d) {
-        return d == distance;
-    });
-    return it != distances.cend();
+template <typename T>
+std::size_t DecodingTable<T>::build(std::span<const Symbol<T>> symbols) {
+    symbols_.reserve(symbols.size());
+    return build_tree(symbols, max_depth_, 0, bit_length_, 0, 0, 0);
 }
 
-PositionTable::PositionTable(std::size_t max_depth) : DecodingTable(max_depth) {
-    positions_.resize(std::size_t(1) << bit_length_);
-    lengths_.resize(std::size_t(1) << bit_length_);
-    children_.resize(std::size_t(1) << bit_length_);
-}
-
-int PositionTable::build(std::span<Position> positions) {
-    return build_tree(positions, max_depth_, 0, 0, 0);
-}
-
-int PositionTable::build_tree(std::span<Position> positions, uint64_t highest_depth, uint16_t code, int bits, uint64_t depth) {
-    SILK_DEBUG << "build_tree #positions: " << positions.size() << " highest_depth: " << highest_depth << " code: " << code
-               << " bits: " << std::bitset<CHAR_BIT>(static_cast<unsigned int>(bits)) << " depth: " << depth;
-    if (positions.empty()) {
+template <typename T>
+std::size_t DecodingTable<T>::build_tree(std::span<const Symbol<T>> symbols, uint64_t highest_depth, std::size_t table_offset,
+                                         std::size_t table_bit_length, std::size_t code, std::size_t bits, uint64_t depth) {
+    SILK_DEBUG << "build_tree #symbols: " << symbols.size() << " highest_depth: " << highest_depth << " code: " << code
+               << " bits: " << bits << " depth: " << depth;
+    if (symbols.empty()) {
         return 0;
     }
-    const auto& first_position = positions.front();
-    if (depth == first_position.depth) {
-        if (bit_length_ == static_cast<std::size_t>(bits)) {
-            positions_[code] = first_position.value;
-            lengths_[code] = static_cast<uint8_t>(bits);
-            children_[code] = nullptr;
-        } else {
-            const auto code_step = 1 << bits;
-            const auto code_from = code;
-            const auto code_to = code_from | 1 << bit_length_;
-            for (auto c{code_from}; c < code_to; c += code_step) {
-                positions_[c] = first_position.value;
-                lengths_[c] = static_cast<uint8_t>(bits);
-                children_[c] = nullptr;
-            }
+    const auto& first_symbol = symbols.front();
+    if (depth == first_symbol.depth) {
+        // Replicate the leaf in all the entries whose lowest bits match the code, so that one lookup is enough
+        const Entry leaf{static_cast<uint32_t>(symbols_.size()), static_cast<uint8_t>(bits), 0};
+        const std::size_t code_step = std::size_t(1) << bits;
+        const std::size_t code_to = std::size_t(1) << table_bit_length;
+        for (auto c{code}; c < code_to; c += code_step) {
+            mutable_entry(table_offset + c) = leaf;
         }
+        symbols_.push_back(first_symbol.value);
         return 1;
     }
-    if (bits == kMaxTableBitLength) {
-        auto child_table{std::make_unique<PositionTable>(highest_depth)};
-        positions_[code] = 0;
-        lengths_[code] = 0;
-        children_[code] = std::move(child_table);
-        return children_[code]->build_tree(positions, highest_depth, 0, 0, depth);
+    if (bits == table_bit_length) {
+        if (highest_depth == 0) {
+            throw std::runtime_error{"decoding table is invalid: depth " + std::to_string(first_symbol.depth) +
+                                     " unreachable from depth " + std::to_string(depth)};
+        }
+        const std::size_t fallback_bit_length = highest_depth > kFallbackBitLength ? kFallbackBitLength : highest_depth;
+        const std::size_t fallback_offset = add_table(fallback_bit_length);
+        mutable_entry(table_offset + code) = Entry{static_cast<uint32_t>(fallback_offset), 0, static_cast<uint8_t>(fallback_bit_length)};
+        return build_tree(symbols, highest_depth, fallback_offset, fallback_bit_length, 0, 0, depth);
     }
-    const int b0 = build_tree(positions, highest_depth - 1, code, bits + 1, depth + 1);
-    return b0 + build_tree(positions.subspan(static_cast<std::size_t>(b0)), highest_depth - 1, static_cast<uint16_t>((1 << bits) | code), bits + 1, depth + 1);
+    const auto b0 = build_tree(symbols, highest_depth - 1, table_offset, table_bit_length, code, bits + 1, depth + 1);
+    return b0 + build_tree(symbols.subspan(b0), highest_depth - 1, table_offset, table_bit_length, (std::size_t(1) << bits) | code, bits + 1, depth + 1);
 }
 
-std::ostream& operator<<(std::ostream& out, const PositionTable& pt) {
-    out << "Position Table:\n";
-    out << "bit length: " << pt.bit_length_ << "\n";
+template <typename T>
+std::ostream& operator<<(std::ostream& out, const DecodingTable<T>& table) {
+    out << "Decoding Table:\n";
+    out << "bit length: " << table.bit_length() << " #symbols: " << table.num_symbols() << "\n";
     out << std::setfill('0');
-    for (std::size_t i{0}; i < pt.positions_.size(); ++i) {
-        const uint64_t position = pt.positions_[i];
-        const uint64_t length = pt.lengths_[i];
-        out << std::dec << std::setw(3) << i << " position: " << position << " length: " << length;
-        const auto& child = pt.children_[i];
-        if (child) {
-            out << "child:\n\t\t" << *child << "\n";
+    for (std::size_t i{0}; i < table.num_entries(); ++i) {
+        const auto& entry = table.entry(i);
+        out << std::dec << std::setw(4) << i;
+        if (entry.code_length > 0) {
+            out << " symbol: " << entry.index << " length: " << int(entry.code_length) << "\n";
+        } else if (entry.table_bit_length > 0) {
+            out << " table: " << entry.index << " bit length: " << int(entry.table_bit_length) << "\n";
         } else {
-            out << " child: NULL\n";
+            out << " NULL\n";
         }
     }
     out << std::dec;
     return out;
 }
 
+template class DecodingTable<ByteView>;
+template class DecodingTable<uint64_t>;
+template std::ostream& operator<<(std::ostream&, const DecodingTable<ByteView>&);
+template std::ostream& operator<<(std::ostream&, const DecodingTable<uint64_t>&);
+
 Decompressor::Decompressor(std::filesystem::path compressed_path) : compressed_path_(std::move(compressed_path)) {}
 
 Decompressor::~Decompressor() {
@@ -346,6 +179,44 @@ bool Decompressor::read_ahead(ReadAheadFuncRef fn) {
     return fn(it);
 }
 
+bool Decompressor::read_ahead(std::span<const uint64_t> chunk_offsets, ReadChunkFuncRef fn,
+                              concurrency::TaskScheduler& workers) {
+    if (!compressed_file_) {
+        throw std::logic_error{"decompressor closed, call open first"};
+    }
+    if (chunk_offsets.size() < 2) {
+        return true;
+    }
+    compressed_file_->advise_sequential();
+    auto _ = gsl::finally([&]() { compressed_file_->advise_random(); });
+
+    // All the chunks are read even if some fail, any exception is rethrown when no chunk is still being read
+    return workers.parallel_reduce(
+        0, chunk_offsets.size() - 1, 1, true,
+        [&](std::size_t i) { return fn(i, Iterator{this, chunk_offsets[i], chunk_offsets[i + 1]}); },
+        [](bool all_ok, bool chunk_ok) { return all_ok && chunk_ok; });
+}
+
+std::vector<uint64_t> Decompressor::chunk_offsets(uint64_t words_per_chunk) {
+    if (words_per_chunk == 0) {
+        throw std::invalid_argument{"invalid zero words per chunk"};
+    }
+    std::vector<uint64_t> offsets{0};
+    offsets.reserve(words_count_ / words_per_chunk + 2);
+    read_ahead([&](Iterator it) -> bool {
+        uint64_t word_count{0};
+        while (it.has_next()) {
+            const uint64_t next_offset = it.skip();
+            if (++word_count % words_per_chunk == 0 && it.has_next()) {
+                offsets.push_back(next_offset);
+            }
+        }
+        return true;
+    });
+    offsets.push_back(words_length_);
+    return offsets;
+}
+
 void Decompressor::close() {
     compressed_file_.reset();
 }
@@ -406,10 +277,10 @@ void Decompressor::read_patterns(ByteView dict) {
 
     pattern_dict_ = std::make_unique<PatternTable>(pattern_highest_depth);
     if (dict.length() > 0) {
-        pattern_dict_->build_condensed({patterns.data(), patterns.size()});
+        pattern_dict_->build(patterns);
     }
 
-    SILK_DEBUG << "#codewords: " << pattern_dict_->num_codewords();
+    SILK_DEBUG << "#patterns: " << pattern_dict_->num_symbols() << " #entries: " << pattern_dict_->num_entries();
     SILK_TRACE << *pattern_dict_;
 }
 
@@ -462,14 +333,17 @@ void Decompressor::read_positions(ByteView dict) {
 
     position_dict_ = std::make_unique<PositionTable>(position_highest_depth);
     if (dict.length() > 0) {
-        position_dict_->build({positions.data(), positions.size()});
+        position_dict_->build(positions);
     }
 
-    SILK_DEBUG << "#positions: " << position_dict_->num_positions();
+    SILK_DEBUG << "#positions: " << position_dict_->num_symbols() << " #entries: " << position_dict_->num_entries();
     SILK_TRACE << *position_dict_;
 }
 
-Decompressor::Iterator::Iterator(const Decompressor* decoder) : decoder_(decoder) {}
+Decompressor::Iterator::Iterator(const Decompressor* decoder) : Iterator(decoder, 0, decoder->words_length_) {}
+
+Decompressor::Iterator::Iterator(const Decompressor* decoder, uint64_t data_offset, uint64_t data_end)
+    : decoder_(decoder), word_offset_(data_offset), data_end_(data_end) {}
 
 ByteView Decompressor::Iterator::data() const {
     return ByteView{decoder_->words_start_, decoder_->words_length_};
@@ -645,36 +519,36 @@ void Decompressor::Iterator::reset(uint64_t data_offset) {
     bit_position_ = 0;
 }
 
-ByteView Decompressor::Iterator::next_pattern() {
-    const PatternTable* table = decoder_->pattern_dict_.get();
-    if (table->bit_length() == 0) {
-        return table->codeword(0)->pattern();
-    }
-    uint8_t length{0};
-    ByteView pattern{};
-    while (length == 0) {
-        const uint16_t code = next_code(table->bit_length());
-
-        const auto* codeword{table->search_condensed(code)};
-        if (codeword == nullptr) {
+template <typename T>
+T Decompressor::Iterator::next_symbol(const DecodingTable<T>& table) {
+    if (table.bit_length() == 0) {
+        return table.num_symbols() > 0 ? table.symbol(0) : T{};
+    }
+    std::size_t table_offset{0};
+    std::size_t bit_length{table.bit_length()};
+    while (true) {
+        const uint16_t code = next_code(bit_length);
+        const auto& entry = table.entry(table_offset + code);
+        if (entry.code_length > 0) {
+            advance(entry.code_length);
+            return table.symbol(entry.index);
+        }
+        if (entry.table_bit_length == 0) {
             const auto error_msg =
-                "Unexpected missing codeword for code: " + std::to_string(code) +
+                "Unexpected missing symbol for code: " + std::to_string(code) +
                 " in snapshot: " + decoder_->compressed_path().string();
             SILK_ERROR << error_msg;
             throw std::runtime_error{error_msg};
         }
-        length = codeword->code_length();
-        if (length == 0) {
-            table = codeword->table();
-            bit_position_ += 9;  // CHAR_BIT + 1
-        } else {
-            bit_position_ += length;
-            pattern = codeword->pattern();
-        }
-        word_offset_ += bit_position_ / CHAR_BIT;
-        bit_position_ = bit_position_ % CHAR_BIT;
+        // Code longer than current table: consume the whole table bit length and continue in the fallback table
+        advance(bit_length);
+        table_offset = entry.index;
+        bit_length = entry.table_bit_length;
     }
-    return pattern;
+}
+
+ByteView Decompressor::Iterator::next_pattern() {
+    return next_symbol(*decoder_->pattern_dict_);
 }
 
 uint64_t Decompressor::Iterator::next_position(bool clean) {
@@ -683,37 +557,24 @@ uint64_t Decompressor::Iterator::next_position(bool clean) {
         bit_position_ = 0;
     }
     SILK_TRACE << "Iterator::next_position word_offset_=" << word_offset_ << " bit_position_=" << int(bit_position_);
-    const PositionTable* table = decoder_->position_dict_.get();
-    if (table->bit_length() == 0) {
-        SILK_TRACE << "Iterator::next_position table->position(0)=" << table->position(0);
-        return table->position(0);
-    }
-    uint8_t length{0};
-    uint64_t position{0};
-    while (length == 0) {
-        const uint16_t code = next_code(table->bit_length());
-        length = table->length(code);
-        if (length == 0) {
-            table = table->child(code);
-            bit_position_ += 9;  // CHAR_BIT + 1
-        } else {
-            bit_position_ += length;
-            SILK_TRACE << "Iterator::next_position table->position(code)=" << table->position(code);
-            position = table->position(code);
-        }
-        word_offset_ += bit_position_ / CHAR_BIT;
-        bit_position_ = bit_position_ % CHAR_BIT;
-    }
-    return position;
+    return next_symbol(*decoder_->position_dict_);
 }
 
 uint16_t Decompressor::Iterator::next_code(std::size_t bit_length) {
-    uint16_t code = static_cast<uint16_t>(decoder_->words_start_[word_offset_]) >> bit_position_;
-    if (static_cast<std::size_t>(CHAR_BIT - bit_position_) < bit_length && word_offset_ + 1 < data_size()) {
-        code |= decoder_->words_start_[word_offset_ + 1] << (CHAR_BIT - bit_position_);
-    }
-    code &= (1 << bit_length) - 1;
-    return code;
+    uint32_t code = static_cast<uint32_t>(decoder_->words_start_[word_offset_]) >> bit_position_;
+    std::size_t available_bits = static_cast<std::size_t>(CHAR_BIT - bit_position_);
+    for (uint64_t offset{word_offset_ + 1}; available_bits < bit_length && offset < data_size(); ++offset) {
+        code |= static_cast<uint32_t>(decoder_->words_start_[offset]) << available_bits;
+        available_bits += CHAR_BIT;
+    }
+    code &= (uint32_t{1} << bit_length) - 1;
+    return static_cast<uint16_t>(code);
+}
+
+void Decompressor::Iterator::advance(std::size_t bit_count) {
+    const std::size_t bit_position = std::size_t{bit_position_} + bit_count;
+    word_offset_ += bit_position / CHAR_BIT;
+    bit_position_ = static_cast<uint8_t>(bit_position % CHAR_BIT);
 }
 
 }  // namespace silkworm::huffman
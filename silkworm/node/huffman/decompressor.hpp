@@ -30,160 +30,117 @@
 #include <silkworm/core/common/base.hpp>
 #include <silkworm/infra/common/log.hpp>
 #include <silkworm/infra/common/memory_mapped_file.hpp>
+#include <silkworm/infra/concurrency/task_scheduler.hpp>
 
 namespace silkworm::huffman {
 
-class DecodingTable {
-  public:
-    //! The max bit length for tables (we don't use tables larger than 2^9)
-    constexpr static std::size_t kMaxTableBitLength{9};
-
-    [[nodiscard]] std::size_t bit_length() const { return bit_length_; }
-
-  protected:
-    explicit DecodingTable(std::size_t max_depth);
-
-    std::size_t bit_length_{0};
-    std::size_t max_depth_;
+//! Symbol read from a Huffman dictionary together with the depth of its code in the Huffman tree
+template <typename T>
+struct Symbol {
+    uint64_t depth{};
+    T value{};
 };
 
-class PatternTable;
+using Pattern = Symbol<ByteView>;
+using Position = Symbol<uint64_t>;
 
-class CodeWord {
+//! Flattened table for decoding Huffman codes
+//! @details Codes up to kRootBitLength bits are decoded with one lookup in the root table, longer codes walk a chain
+//! of compact fallback sub-tables. All tables live in one contiguous array of cache-line aligned blocks.
+template <typename T>
+class DecodingTable {
   public:
-    explicit CodeWord();
-    explicit CodeWord(uint16_t code, uint8_t length, ByteView pattern);
-    explicit CodeWord(uint16_t code, uint8_t length, ByteView pattern, std::unique_ptr<PatternTable> table, CodeWord* next);
-
-    [[nodiscard]] uint16_t code() const { return code_; }
-    [[nodiscard]] uint8_t code_length() const { return code_length_; }
-    [[nodiscard]] ByteView pattern() const { return pattern_; }
-    [[nodiscard]] PatternTable* table() const { return table_.get(); }
-    [[nodiscard]] CodeWord* next() const { return next_; }
+    //! The max bit length of the root table
+    constexpr static std::size_t kRootBitLength{12};
+
+    //! The max bit length of the fallback tables for codes longer than kRootBitLength
+    constexpr static std::size_t kFallbackBitLength{6};
+
+    //! Either a leaf pointing to a decoded symbol or a link pointing to a fallback table
+    struct Entry {
+        //! Index of the symbol for leaves, offset of the fallback table for links
+        uint32_t index{0};
+        //! Number of bits in the code for leaves, zero for links
+        uint8_t code_length{0};
+        //! Bit length of the fallback table for links, zero for leaves
+        uint8_t table_bit_length{0};
+    };
 
-    void reset_content(uint16_t code, uint8_t length, ByteView pattern);
+    explicit DecodingTable(std::size_t max_depth);
 
-    void set_next(CodeWord* next);
+    [[nodiscard]] std::size_t max_depth() const { return max_depth_; }
 
-  private:
-    //! Code associated to the symbol
-    uint16_t code_{0};
-    //! Number of bits in the codes
-    uint8_t code_length_{0};
-    ByteView pattern_;
-    std::unique_ptr<PatternTable> table_;
-    CodeWord* next_;
-};
+    [[nodiscard]] std::size_t bit_length() const { return bit_length_; }
 
-struct Pattern {
-    uint64_t depth{};
-    ByteView value;
-};
+    [[nodiscard]] std::size_t num_symbols() const { return symbols_.size(); }
 
-class PatternTable : public DecodingTable {
-  public:
-    //! The default bit length threshold after which tables are condensed (default: all NOT condensed)
-    constexpr static std::size_t kDefaultCondensedTableBitLengthThreshold = kMaxTableBitLength;
-    constexpr static int kNumPowers{10};
-    constexpr static int kMaxPower{512};
-    using WordDistances = std::array<std::vector<int>, kNumPowers>;
-
-    //! @brief Set the bit length threshold after which tables will be condensed.
-    //! @attention Condensing reduces size of decompression table but leads to slower reads.
-    //! @details Tables with bit length greater than threshold will be condensed. To disable condensing completely
-    //! set `condensed_table_bit_length_threshold` to 9; to enable condensing for all tables, set it to 0; to
-    //! enable condensing for tables of size greater than 64, set it to 6.
-    static void set_condensed_table_bit_length_threshold(std::size_t condensed_table_bit_length_threshold);
-
-    explicit PatternTable(std::size_t max_depth);
-
-    [[nodiscard]] const CodeWord* codeword(std::size_t code) const {
-        return code < codewords_.size() ? codewords_[code].get() : nullptr;
-    }
+    [[nodiscard]] std::size_t num_entries() const { return blocks_.size() * kEntriesPerBlock; }
 
-    [[nodiscard]] std::size_t num_codewords() const { return codewords_.size(); }
+    [[nodiscard]] const T& symbol(std::size_t index) const { return symbols_[index]; }
 
-    [[nodiscard]] const CodeWord* search_condensed(uint16_t code) const;
+    [[nodiscard]] const Entry& entry(std::size_t index) const {
+        return blocks_[index / kEntriesPerBlock].entries[index % kEntriesPerBlock];
+    }
 
-    std::size_t build_condensed(std::span<Pattern> patterns);
+    //! Build the tables from the symbols in Huffman tree order
+    //! @return the number of symbols inserted
+    std::size_t build(std::span<const Symbol<T>> symbols);
 
   private:
-    static const WordDistances word_distances_;
-    static std::size_t condensed_table_bit_length_threshold_;
-
-    [[nodiscard]] static bool check_distance(std::size_t power, int distance);
-
-    std::size_t build_condensed(
-        std::span<Pattern> patterns,
-        uint64_t highest_depth,
-        uint16_t code,
-        int bits,
-        uint64_t depth);
+    static constexpr std::size_t kEntriesPerBlock{64 / sizeof(Entry)};
 
-    [[maybe_unused]] CodeWord* insert_word(std::shared_ptr<CodeWord> codeword);
-
-    std::vector<std::shared_ptr<CodeWord>> codewords_;
-    mutable CodeWord* head_{nullptr};
-
-    friend std::ostream& operator<<(std::ostream& out, const PatternTable& pt);
-};
-
-struct Position {
-    uint64_t depth;
-    uint64_t value;
-};
-
-class PositionTable : public DecodingTable {
-  public:
-    explicit PositionTable(std::size_t max_depth);
-
-    [[nodiscard]] std::size_t num_positions() const { return positions_.size(); }
-
-    [[nodiscard]] uint64_t position(std::size_t code) const {
-        return code < positions_.size() ? positions_[code] : 0;
-    }
-
-    [[nodiscard]] uint8_t length(std::size_t code) const {
-        return code < lengths_.size() ? lengths_[code] : 0;
-    }
+    struct alignas(64) EntryBlock {
+        std::array<Entry, kEntriesPerBlock> entries{};
+    };
 
-    [[nodiscard]] PositionTable* child(std::size_t code) const {
-        return code < children_.size() ? children_[code].get() : nullptr;
+    Entry& mutable_entry(std::size_t index) {
+        return blocks_[index / kEntriesPerBlock].entries[index % kEntriesPerBlock];
     }
 
-    int build(std::span<Position> positions);
+    //! Append a new table having the specified bit length
+    //! @return the offset of the first entry in the new table
+    std::size_t add_table(std::size_t bit_length);
 
-  private:
-    int build_tree(
-        std::span<Position> positions,
+    std::size_t build_tree(
+        std::span<const Symbol<T>> symbols,
         uint64_t highest_depth,
-        uint16_t code,
-        int bits,
+        std::size_t table_offset,
+        std::size_t table_bit_length,
+        std::size_t code,
+        std::size_t bits,
         uint64_t depth);
 
-    std::vector<uint64_t> positions_;
-    std::vector<uint8_t> lengths_;
-    std::vector<std::unique_ptr<PositionTable>> children_;
-
-    friend std::ostream& operator<<(std::ostream& out, const PositionTable& pt);
+    std::size_t max_depth_;
+    std::size_t bit_length_;
+    std::vector<EntryBlock> blocks_;
+    std::vector<T> symbols_;
 };
 
+template <typename T>
+std::ostream& operator<<(std::ostream& out, const DecodingTable<T>& table);
+
+using PatternTable = DecodingTable<ByteView>;
+using PositionTable = DecodingTable<uint64_t>;
+
 //! Snapshot decoder using modified Condensed Huffman Table (CHT) algorithm
 class Decompressor {
   public:
     //! The max number of patterns in decoding tables
-    constexpr static std::size_t kMaxTablePatterns = (1 << DecodingTable::kMaxTableBitLength) * 510;
+    constexpr static std::size_t kMaxTablePatterns = std::size_t{512} * 510;
 
     //! The max number of positions in decoding tables
-    constexpr static std::size_t kMaxTablePositions = (1 << DecodingTable::kMaxTableBitLength) * 100;
+    constexpr static std::size_t kMaxTablePositions = std::size_t{512} * 100;
 
     //! Read-only access to the file data stream
     class Iterator {
       public:
         explicit Iterator(const Decompressor* decoder);
 
+        //! Iterator restricted to the words in range [data_offset, data_end) of the data stream
+        explicit Iterator(const Decompressor* decoder, uint64_t data_offset, uint64_t data_end);
+
         [[nodiscard]] std::size_t data_size() const { return decoder_->words_length_; }
-        [[nodiscard]] bool has_next() const { return word_offset_ < decoder_->words_length_; }
+        [[nodiscard]] bool has_next() const { return word_offset_ < data_end_; }
 
         //! Extract one *compressed* word from current offset in the file and append it to buffer
         //! After extracting current word, move at the beginning of the next one
@@ -216,9 +173,16 @@ class Decompressor {
         //! Read the next position from the data stream
         [[nodiscard]] uint64_t next_position(bool clean);
 
+        //! Read the next symbol from the data stream decoding it with the specified table
+        template <typename T>
+        [[nodiscard]] T next_symbol(const DecodingTable<T>& table);
+
         //! Read next code from the data stream
         [[nodiscard]] inline uint16_t next_code(std::size_t bit_length);
 
+        //! Move forward in the data stream by the specified number of bits
+        inline void advance(std::size_t bit_count);
+
         //! The decoder on which iterator works
         const Decompressor* decoder_;
 
@@ -227,9 +191,13 @@ class Decompressor {
 
         //! Bit position [0..7] in current word of the data file
         uint8_t bit_position_{0};
+
+        //! End offset of the words accessible by this iterator in the data file
+        uint64_t data_end_{0};
     };
 
     using ReadAheadFuncRef = absl::FunctionRef<bool(Iterator)>;
+    using ReadChunkFuncRef = absl::FunctionRef<bool(std::size_t, Iterator)>;
 
     explicit Decompressor(std::filesystem::path compressed_file);
     ~Decompressor();
@@ -250,9 +218,21 @@ class Decompressor {
 
     void open();
 
+    [[nodiscard]] uint64_t data_size() const { return words_length_; }
+
     //! Read the data stream eagerly applying the specified function, expected read in sequential order
     bool read_ahead(ReadAheadFuncRef fn);
 
+    //! Read the data stream eagerly in parallel chunks, applying the specified function to each chunk on the workers
+    //! @param chunk_offsets the sorted word offsets delimiting the chunks, i.e. chunk i is [offsets[i], offsets[i+1])
+    //! @param fn the function called concurrently with the chunk index and the iterator restricted to the chunk
+    //! @return true if the function succeeded on all the chunks, false otherwise
+    bool read_ahead(std::span<const uint64_t> chunk_offsets, ReadChunkFuncRef fn, concurrency::TaskScheduler& workers);
+
+    //! Find the word offsets splitting the data stream in chunks of the specified number of words by skipping them
+    //! @return the sorted word offsets delimiting the chunks, including zero and the data size
+    std::vector<uint64_t> chunk_offsets(uint64_t words_per_chunk);
+
     //! Get an iterator to the compressed data
     [[nodiscard]] Iterator make_iterator() const { return Iterator{this}; }
 
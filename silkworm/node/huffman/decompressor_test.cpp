@@ -38,162 +38,106 @@ using Catch::Matchers::Message;
 
 namespace silkworm::huffman {
 
-//! DecodingTable exposed for white-box testing
-class DecodingTable_ForTest : public DecodingTable {
-  public:
-    explicit DecodingTable_ForTest(std::size_t max_depth) : DecodingTable(max_depth) {}
-    [[nodiscard]] std::size_t max_depth() const { return max_depth_; }
-};
-
-//! set_condensed_table_bit_length_threshold
-class SetCondensedTableBitLengthThresholdGuard {
-  public:
-    explicit SetCondensedTableBitLengthThresholdGuard(std::size_t threshold) {
-        PatternTable::set_condensed_table_bit_length_threshold(threshold);
-    }
-    ~SetCondensedTableBitLengthThresholdGuard() {
-        PatternTable::set_condensed_table_bit_length_threshold(PatternTable::kDefaultCondensedTableBitLengthThreshold);
-    }
-};
-
 TEST_CASE("DecodingTable::DecodingTable", "[silkworm][snapshot][decompressor]") {
     std::map<std::string, std::pair<std::size_t, std::size_t>> test_params{
         {"max depth is 0", {0, 0}},
-        {"max depth is < kMaxTableBitLength", {DecodingTable::kMaxTableBitLength - 1, DecodingTable::kMaxTableBitLength - 1}},
-        {"max depth is = kMaxTableBitLength", {DecodingTable::kMaxTableBitLength, DecodingTable::kMaxTableBitLength}},
-        {"max depth is > kMaxTableBitLength", {DecodingTable::kMaxTableBitLength + 1, DecodingTable::kMaxTableBitLength}},
+        {"max depth is < kRootBitLength", {PositionTable::kRootBitLength - 1, PositionTable::kRootBitLength - 1}},
+        {"max depth is = kRootBitLength", {PositionTable::kRootBitLength, PositionTable::kRootBitLength}},
+        {"max depth is > kRootBitLength", {PositionTable::kRootBitLength + 1, PositionTable::kRootBitLength}},
     };
     for (const auto& [test_name, test_pair] : test_params) {
         std::size_t max_depth = test_pair.first;
         std::size_t expected_bit_length = test_pair.second;
-        DecodingTable_ForTest table{max_depth};
+        PositionTable table{max_depth};
         CHECK(table.max_depth() == max_depth);
         CHECK(table.bit_length() == expected_bit_length);
+        CHECK(table.num_entries() >= (std::size_t(1) << expected_bit_length));
+        CHECK(table.num_symbols() == 0);
     }
 }
 
-TEST_CASE("CodeWord::CodeWord", "[silkworm][snapshot][decompressor]") {
-    std::vector<CodeWord> codewords{};
-    codewords.emplace_back();
-    codewords.emplace_back(0, 0, ByteView{});
-    codewords.emplace_back(0, 0, ByteView{}, nullptr, nullptr);
-    for (const auto& cw : codewords) {
-        CHECK(cw.code() == 0);
-        CHECK(cw.code_length() == 0);
-        CHECK(cw.pattern().empty());
-        CHECK(cw.table() == nullptr);
-        CHECK(cw.next() == nullptr);
-    }
-}
-
-TEST_CASE("CodeWord::reset_content", "[silkworm][snapshot][decompressor]") {
-    CodeWord parent_cw{};
-
-    uint16_t old_code{121};
-    uint8_t old_length{2};
-    Bytes old_pattern{0x11, 0x00, 0x11};
-    auto table_ptr = std::make_unique<PatternTable>(3);
-    const PatternTable* table = table_ptr.get();
-    CodeWord cw{old_code, old_length, old_pattern, std::move(table_ptr), &parent_cw};
-    CHECK(cw.code() == old_code);
-    CHECK(cw.code_length() == old_length);
-    CHECK(cw.pattern() == old_pattern);
-    CHECK(cw.table() == table);
-    CHECK(cw.next() == &parent_cw);
-
-    uint16_t new_code{111};
-    uint8_t new_length{1};
-    Bytes new_pattern{0x00, 0x11, 0x00};
-    CHECK_NOTHROW(cw.reset_content(new_code, new_length, new_pattern));
-
-    CHECK(cw.code() == new_code);
-    CHECK(cw.code_length() == new_length);
-    CHECK(cw.pattern() == new_pattern);
-    CHECK(cw.table() == nullptr);
-    CHECK(cw.next() == &parent_cw);
-}
-
-TEST_CASE("CodeWord::set_next", "[silkworm][snapshot][decompressor]") {
-    CodeWord parent1_cw{}, parent2_cw{};
-    CodeWord cw{0, 0, Bytes{}, std::make_unique<PatternTable>(3), &parent1_cw};
-    CHECK(cw.next() == &parent1_cw);
-
-    CHECK_NOTHROW(cw.set_next(&parent2_cw));
-
-    CHECK(cw.next() == &parent2_cw);
-}
-
-TEST_CASE("PatternTable::set_condensed_table_bit_length_threshold", "[silkworm][snapshot][decompressor]") {
-    SECTION("condensed_table_bit_length_threshold < kMaxTableBitLength") {
-        CHECK_NOTHROW(SetCondensedTableBitLengthThresholdGuard(PatternTable::kMaxTableBitLength - 1));
-    }
-    SECTION("condensed_table_bit_length_threshold = kMaxTableBitLength") {
-        CHECK_NOTHROW(SetCondensedTableBitLengthThresholdGuard(PatternTable::kMaxTableBitLength));
-    }
-    SECTION("condensed_table_bit_length_threshold > kMaxTableBitLength") {
-        CHECK_THROWS_AS(SetCondensedTableBitLengthThresholdGuard(PatternTable::kMaxTableBitLength + 1), std::invalid_argument);
-    }
-}
-
-TEST_CASE("PatternTable::PatternTable", "[silkworm][snapshot][decompressor]") {
-    PatternTable table{0};
-    CHECK(table.num_codewords() == 1);
-    CHECK(table.codeword(0) == nullptr);
-    CHECK(table.codeword(table.num_codewords()) == nullptr);
-}
-
-TEST_CASE("PatternTable::build_condensed", "[silkworm][snapshot][decompressor]") {
-    PatternTable table1{0};
-
+TEST_CASE("PatternTable::build", "[silkworm][snapshot][decompressor]") {
     std::span<Pattern> patterns0{};
     Bytes v1{0x00, 0x11};
     std::vector<Pattern> patterns1{{0, v1}};
     Bytes v2{0x00, 0x22};
     std::vector<Pattern> patterns2{{1, v1}, {2, v2}};
-    std::map<std::string, std::span<Pattern>> test_spans{
-        {"zero patterns", patterns0},
-        {"one pattern", std::span<Pattern>{patterns1.data(), patterns1.size()}},
-        {"two patterns", std::span<Pattern>{patterns2.data(), patterns2.size()}},
+    std::map<std::string, std::pair<std::span<Pattern>, std::size_t>> test_spans{
+        {"zero patterns", {patterns0, 0}},
+        {"one pattern", {std::span<Pattern>{patterns1.data(), patterns1.size()}, 0}},
+        {"two patterns", {std::span<Pattern>{patterns2.data(), patterns2.size()}, 2}},
     };
 
-    for (const auto& [test_name, pattern_span] : test_spans) {
+    for (const auto& [test_name, test_pair] : test_spans) {
         SECTION(test_name) {
-            CHECK(table1.build_condensed(pattern_span) == pattern_span.size());
+            const auto& [pattern_span, max_depth] = test_pair;
+            PatternTable table{max_depth};
+            CHECK(table.build(pattern_span) == pattern_span.size());
+            CHECK(table.num_symbols() == pattern_span.size());
+            for (std::size_t i{0}; i < pattern_span.size(); ++i) {
+                CHECK(table.symbol(i) == pattern_span[i].value);
+            }
         }
     }
 }
 
-TEST_CASE("PatternTable::search_condensed", "[silkworm][snapshot][decompressor]") {
-    PatternTable table1{0};
-    CHECK(table1.search_condensed(0) == nullptr);
-    PatternTable table2{DecodingTable::kMaxTableBitLength + 1};
-    CHECK(table2.search_condensed(0) == nullptr);
+TEST_CASE("PositionTable::build", "[silkworm][snapshot][decompressor]") {
+    SECTION("codes within root table") {
+        // Codes are read starting from the lowest bit: 0 -> 0, 01 -> 1, 11 -> 2
+        std::vector<Position> positions{{1, 10}, {2, 20}, {2, 30}};
+        PositionTable table{2};
+        CHECK(table.build(positions) == positions.size());
+        CHECK(table.bit_length() == 2);
+        CHECK(table.entry(0b00).code_length == 1);
+        CHECK(table.symbol(table.entry(0b00).index) == 10);
+        CHECK(table.entry(0b10).code_length == 1);
+        CHECK(table.symbol(table.entry(0b10).index) == 10);
+        CHECK(table.entry(0b01).code_length == 2);
+        CHECK(table.symbol(table.entry(0b01).index) == 20);
+        CHECK(table.entry(0b11).code_length == 2);
+        CHECK(table.symbol(table.entry(0b11).index) == 30);
+    }
+
+    SECTION("codes longer than root table") {
+        // Depths 1, 2, ..., kRootBitLength + 1, kRootBitLength + 1: all codes but the last two fit the root table
+        const std::size_t max_depth{PositionTable::kRootBitLength + 1};
+        std::vector<Position> positions;
+        for (uint64_t depth{1}; depth <= max_depth; ++depth) {
+            positions.push_back({depth, depth});
+        }
+        positions.push_back({max_depth, max_depth + 1});
+        PositionTable table{max_depth};
+        CHECK(table.build(positions) == positions.size());
+        CHECK(table.bit_length() == PositionTable::kRootBitLength);
+
+        const std::size_t all_ones_code = (std::size_t(1) << PositionTable::kRootBitLength) - 1;
+        for (std::size_t length{1}; length <= PositionTable::kRootBitLength; ++length) {
+            const auto& leaf = table.entry(all_ones_code >> (PositionTable::kRootBitLength - length + 1));
+            CHECK(leaf.code_length == static_cast<uint8_t>(length));
+            CHECK(table.symbol(leaf.index) == length);
+        }
+        const auto& link = table.entry(all_ones_code);
+        CHECK(link.code_length == 0);
+        CHECK(link.table_bit_length == 1);
+        CHECK(link.index % 8 == 0);
+        CHECK(table.symbol(table.entry(link.index).index) == max_depth);
+        CHECK(table.symbol(table.entry(link.index + 1).index) == max_depth + 1);
+    }
+
+    SECTION("invalid depth") {
+        std::vector<Position> positions{{2, 10}};
+        PositionTable table{1};
+        CHECK_THROWS_AS(table.build(positions), std::runtime_error);
+    }
 }
 
-TEST_CASE("PatternTable::operator<<", "[silkworm][snapshot][decompressor]") {
+TEST_CASE("DecodingTable::operator<<", "[silkworm][snapshot][decompressor]") {
     PatternTable table1{0};
     CHECK_NOTHROW(test::null_stream() << table1);
-    SetCondensedTableBitLengthThresholdGuard bit_length_threshold_guard{1};
-    PatternTable table2{0};
+    PositionTable table2{0};
     CHECK_NOTHROW(test::null_stream() << table2);
 }
 
-TEST_CASE("PositionTable::PositionTable", "[silkworm][snapshot][decompressor]") {
-    PositionTable table{0};
-    CHECK(table.num_positions() == 1);
-    CHECK(table.position(0) == 0);
-    CHECK(table.length(0) == 0);
-    CHECK(table.child(0) == nullptr);
-    CHECK(table.position(table.num_positions()) == 0);
-    CHECK(table.length(table.num_positions()) == 0);
-    CHECK(table.child(table.num_positions()) == nullptr);
-}
-
-TEST_CASE("PositionTable::operator<<", "[silkworm][snapshot][decompressor]") {
-    PositionTable table{0};
-    CHECK_NOTHROW(test::null_stream() << table);
-}
-
 TEST_CASE("Decompressor::Decompressor", "[silkworm][snapshot][decompressor]") {
     const auto tmp_file_path{silkworm::TemporaryDirectory::get_unique_temporary_path()};
     Decompressor decoder{tmp_file_path};
@@ -473,4 +417,57 @@ TEST_CASE("Decompressor: lorem ipsum next", "[silkworm][snapshot][decompressor]"
     CHECK(test_function(it));
 }
 
+TEST_CASE("Decompressor: lorem ipsum parallel read_ahead", "[silkworm][snapshot][decompressor]") {
+    test::SetLogVerbosityGuard guard{log::Level::kNone};
+    test::TemporaryFile tmp_file{};
+    tmp_file.write(kLoremIpsumDict);
+    Decompressor decoder{tmp_file.path()};
+    CHECK_NOTHROW(decoder.open());
+
+    constexpr std::size_t kWordsPerChunk{10};
+    const auto chunk_offsets = decoder.chunk_offsets(kWordsPerChunk);
+    const std::size_t chunk_count = (kLoremIpsumWords.size() + kWordsPerChunk - 1) / kWordsPerChunk;
+    REQUIRE(chunk_offsets.size() == chunk_count + 1);
+    CHECK(chunk_offsets.front() == 0);
+    CHECK(chunk_offsets.back() == decoder.data_size());
+
+    concurrency::TaskScheduler workers{4};
+    std::vector<std::vector<Bytes>> chunk_words(chunk_count);
+    const bool read_ok = decoder.read_ahead(
+        chunk_offsets,
+        [&](std::size_t chunk, auto it) -> bool {
+            while (it.has_next()) {
+                Bytes word;
+                it.next(word);
+                chunk_words[chunk].push_back(std::move(word));
+            }
+            return true;
+        },
+        workers);
+    CHECK(read_ok);
+
+    std::size_t i{0};
+    for (const auto& words : chunk_words) {
+        for (const auto& word : words) {
+            REQUIRE(i < kLoremIpsumWords.size());
+            const std::string word_plus_index{kLoremIpsumWords[i] + " " + std::to_string(i)};
+            CHECK(word == Bytes{word_plus_index.cbegin(), word_plus_index.cend()});
+            ++i;
+        }
+    }
+    CHECK(i == kLoremIpsumWords.size());
+
+    SECTION("failure in one chunk") {
+        CHECK_FALSE(decoder.read_ahead(
+            chunk_offsets, [](std::size_t chunk, auto) -> bool { return chunk != 1; }, workers));
+    }
+
+    SECTION("failure after close") {
+        decoder.close();
+        CHECK_THROWS_AS(decoder.read_ahead(
+                            chunk_offsets, [](std::size_t, auto) -> bool { return true; }, workers),
+                        std::logic_error);
+    }
+}
+
 }  // namespace silkworm::huffman
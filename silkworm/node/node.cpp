@@ -18,14 +18,18 @@
 
 #include <utility>
 
+#include <silkworm/core/crypto/signer_recovery.hpp>
 #include <silkworm/infra/common/log.hpp>
 #include <silkworm/infra/common/os.hpp>
 #include <silkworm/infra/concurrency/awaitable_wait_for_all.hpp>
+#include <silkworm/infra/concurrency/task_scheduler.hpp>
+#include <silkworm/infra/metrics/exposition_server.hpp>
 #include <silkworm/node/backend/ethereum_backend.hpp>
 #include <silkworm/node/backend/remote/backend_kv_server.hpp>
 #include <silkworm/node/common/preverified_hashes.hpp>
 #include <silkworm/node/common/resource_usage.hpp>
 #include <silkworm/node/snapshot/sync.hpp>
+#include <silkworm/node/stagedsync/block_preverifier.hpp>
 #include <silkworm/node/stagedsync/server.hpp>
 
 namespace silkworm::node {
@@ -56,10 +60,17 @@ class NodeImpl final {
     Task<void> start_backend_kv_grpc_server();
     Task<void> start_resource_usage_log();
     Task<void> start_execution_log_timer();
+    Task<void> start_metrics_server();
 
     Settings& settings_;
     mdbx::env& chaindata_db_;
 
+    //! The work-stealing scheduler shared by the CPU-bound tasks (e.g. sender recovery, snapshot indexing)
+    concurrency::TaskScheduler task_scheduler_;
+
+    //! The stateless checks of the new blocks, started on their arrival on the scheduler above
+    stagedsync::BlockPreverifier block_preverifier_;
+
     //! The repository for snapshots
     snapshot::SnapshotRepository snapshot_repository_;
 
@@ -75,6 +86,7 @@ class NodeImpl final {
 NodeImpl::NodeImpl(Settings& settings, SentryClientPtr sentry_client, mdbx::env& chaindata_db)
     : settings_{settings},
       chaindata_db_{chaindata_db},
+      block_preverifier_{task_scheduler_},
       snapshot_repository_{settings_.snapshot_settings},
       execution_server_{settings_, db::RWAccess{chaindata_db_}},
       execution_local_client_{execution_server_},
@@ -83,6 +95,8 @@ NodeImpl::NodeImpl(Settings& settings, SentryClientPtr sentry_client, mdbx::env&
     backend_ = std::make_unique<EthereumBackEnd>(settings_, &chaindata_db_, sentry_client_);
     backend_->set_node_name(settings_.node_name);
     backend_kv_rpc_server_ = std::make_unique<rpc::BackEndKvServer>(settings.server_settings, *backend_);
+    settings_.task_scheduler = &task_scheduler_;
+    settings_.block_preverifier = &block_preverifier_;
 }
 
 void NodeImpl::setup() {
@@ -102,13 +116,16 @@ void NodeImpl::setup_snapshots() {
         db::RWTxn rw_txn{chaindata_db_};
 
         // Snapshot sync - download chain from peers using snapshot files
-        snapshot::SnapshotSync snapshot_sync{&snapshot_repository_, settings_.chain_config.value()};
+        snapshot::SnapshotSync snapshot_sync{&snapshot_repository_, settings_.chain_config.value(), &task_scheduler_};
         snapshot_sync.download_and_index_snapshots(rw_txn);
 
         rw_txn.commit_and_stop();
 
         // Set snapshot repository into snapshot-aware database access
         db::DataModel::set_snapshot_repository(&snapshot_repository_);
+
+        // Set snapshot repository into the stages moving old blocks from database into snapshots
+        settings_.snapshot_repository = &snapshot_repository_;
     } else {
         log::Info() << "Snapshot sync disabled, no snapshot must be downloaded";
     }
@@ -121,7 +138,8 @@ Task<void> NodeImpl::run() {
 
 Task<void> NodeImpl::run_tasks() {
     using namespace concurrency::awaitable_wait_for_all;
-    co_await (start_execution_server() && start_resource_usage_log() && start_execution_log_timer());
+    co_await (start_execution_server() && start_resource_usage_log() && start_execution_log_timer() &&
+              start_metrics_server());
 }
 
 Task<void> NodeImpl::start_execution_server() {
@@ -158,6 +176,19 @@ Task<void> NodeImpl::start_execution_log_timer() {
     co_await silkworm::concurrency::async_thread(std::move(run), std::move(stop));
 }
 
+Task<void> NodeImpl::start_metrics_server() {
+    if (settings_.metrics_end_point.empty()) {
+        co_return;
+    }
+    auto& registry{metrics::default_registry()};
+    registry.counter_callback("silkworm_signer_cache_hits_total", "Recovered signer cache hits",
+                              []() { return static_cast<double>(signer_cache().stats().hits); });
+    registry.counter_callback("silkworm_signer_cache_misses_total", "Recovered signer cache misses",
+                              []() { return static_cast<double>(signer_cache().stats().misses); });
+    metrics::ExpositionServer metrics_server{settings_.metrics_end_point};
+    co_await metrics_server.run();
+}
+
 Node::Node(Settings& settings, SentryClientPtr sentry_client, mdbx::env& chaindata_db)
     : p_impl_(std::make_unique<NodeImpl>(settings, std::move(sentry_client), chaindata_db)) {}
 
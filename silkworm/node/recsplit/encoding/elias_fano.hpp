@@ -166,6 +166,15 @@ class EliasFanoList32 {
         return value;
     }
 
+    //! Prefetch the lower bits and jump table words read by get for the given index
+    void prefetch(uint64_t i) const {
+        succinct::prefetch(lower_bits_.data() + i * l_ / 64);
+        const uint64_t jump_super_q = (i / kSuperQ) * kSuperQSize32;
+        const uint64_t jump_inside_super_q = (i % kSuperQ) / kQ;
+        succinct::prefetch(jump_.data() + jump_super_q);
+        succinct::prefetch(jump_.data() + jump_super_q + 1 + (jump_inside_super_q >> 1));
+    }
+
     void add_offset(uint64_t offset) {
         if (l_ != 0) {
             set_bits(lower_bits_, i_ * l_, l_, offset & lower_bits_mask_);
@@ -346,6 +355,15 @@ class DoubleEliasFanoList16 {
         }
     }
 
+    //! Prefetch the lower bits and jump table words read by get2 and get3 for the given index
+    void prefetch(const uint64_t i) const {
+        succinct::prefetch(lower_bits.data() + i * (l_cum_keys + l_position) / 64);
+        const uint64_t jump_super_q = (i / kSuperQ) * kSuperQSize16 * 2;
+        const uint64_t jump_inside_super_q = (i % kSuperQ) / kQ;
+        succinct::prefetch(jump.data() + jump_super_q);
+        succinct::prefetch(jump.data() + jump_super_q + 2 + jump_inside_super_q / 2);
+    }
+
     void get2(const uint64_t i, uint64_t& cum_keys, uint64_t& position) const {
         uint64_t window_cum_keys{0}, select_cum_keys{0}, curr_word_cum_keys{0}, lower{0}, cum_delta{0};
         get(i, cum_keys, position, window_cum_keys, select_cum_keys, curr_word_cum_keys, lower, cum_delta);
@@ -192,6 +192,12 @@ class GolombRiceVector {
 
     [[nodiscard]] Reader reader() const { return Reader{data}; }
 
+    //! Prefetch the words holding the fixed and unary codes of the subtree starting at given bit position
+    void prefetch(const std::size_t bit_pos, const std::size_t unary_offset) const {
+        succinct::prefetch(data.data() + bit_pos / 64);
+        succinct::prefetch(data.data() + (bit_pos + unary_offset) / 64);
+    }
+
   private:
     Uint64Sequence data;
 
@@ -52,13 +52,17 @@
 #endif
 /* clang-format on */
 
+#include <algorithm>
 #include <array>
 #include <bit>
 #include <cassert>
 #include <chrono>
 #include <fstream>
+#include <future>
 #include <limits>
+#include <optional>
 #include <random>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <utility>
@@ -71,6 +75,7 @@
 #include <silkworm/infra/common/ensure.hpp>
 #include <silkworm/infra/common/log.hpp>
 #include <silkworm/infra/common/memory_mapped_file.hpp>
+#include <silkworm/infra/concurrency/task_scheduler.hpp>
 #include <silkworm/node/etl/collector.hpp>
 
 #pragma GCC diagnostic push
@@ -193,8 +198,16 @@ struct RecSplitSettings {
     uint64_t base_data_id;                                  // Application-specific base data ID written in index header
     bool double_enum_index{true};                           // Flag indicating if 2-level index is required
     std::size_t etl_optimal_size{etl::kOptimalBufferSize};  // Optimal size for offset and bucket ETL collectors
+    std::size_t num_threads{1};                             // The number of threads used to encode the buckets
+    concurrency::TaskScheduler* scheduler{nullptr};         // The shared scheduler encoding the buckets (if any)
 };
 
+//! Number of consecutive buckets encoded by each thread in one batch
+static constexpr std::size_t kBucketsPerTask{64};
+
+//! Number of keys whose lookups are interleaved in batch lookups
+static constexpr std::size_t kLookupBatchSize{16};
+
 //! Recursive splitting (RecSplit) is an efficient algorithm to identify minimal perfect hash functions.
 //! The template parameter LEAF_SIZE decides how large a leaf will be. Larger leaves imply slower construction, but less
 //! space and faster evaluation
@@ -214,15 +227,14 @@ class RecSplit {
           base_data_id_(settings.base_data_id),
           index_path_(settings.index_path),
           double_enum_index_(settings.double_enum_index),
+          num_threads_(settings.num_threads),
+          scheduler_(settings.scheduler),
           offset_collector_(settings.etl_optimal_size),
           bucket_collector_(settings.etl_optimal_size) {
         bucket_size_accumulator_.reserve(bucket_count_ + 1);
         bucket_position_accumulator_.reserve(bucket_count_ + 1);
         bucket_size_accumulator_.resize(1);      // Start with 0 as bucket accumulated size
         bucket_position_accumulator_.resize(1);  // Start with 0 as bucket accumulated position
-        current_bucket_.reserve(bucket_size_);
-        current_bucket_offsets_.reserve(bucket_size_);
-        count_.reserve(kLowerAggregationBound);
 
         // Generate random salt for murmur3 hash
         std::random_device rand_dev;
@@ -408,11 +420,38 @@ class RecSplit {
         index_output_stream.write(reinterpret_cast<const char*>(&bytes_per_record_), sizeof(uint8_t));
         SILK_DEBUG << "[index] written bytes per record: " << int(bytes_per_record_);
 
-        current_bucket_id_ = std::numeric_limits<uint64_t>::max();  // To make sure 0 bucket is detected
-
         auto bucket_collector_clear = gsl::finally([&]() { bucket_collector_.clear(); });
         SILK_INFO << "[index] calculating file=" << index_path_.string();
 
+        // Buckets are encoded independently in batches: while the workers encode one batch, the next one is loaded
+        // and then the encoded buckets are written in order, so that the index is the same as if built sequentially
+        std::optional<concurrency::TaskScheduler> own_workers;
+        concurrency::TaskScheduler* workers{scheduler_};
+        if (!workers && num_threads_ > 1) {
+            own_workers.emplace(num_threads_);
+            workers = &*own_workers;
+        }
+        const std::size_t batch_size{(workers ? workers->num_workers() : 1) * kBucketsPerTask};
+        std::vector<Bucket> loading_batch, encoding_batch;
+        std::vector<std::future<void>> encoding_tasks;
+        loading_batch.reserve(batch_size);
+        encoding_batch.reserve(batch_size);
+        // Any encoding task must be completed before its batch goes away, also on error
+        auto encoding_tasks_wait = gsl::finally([&]() {
+            for (auto& task : encoding_tasks) {
+                if (task.valid()) wait_for(task, workers);
+            }
+        });
+        // Write the batch being encoded (if any) and then start encoding the loaded one
+        const auto next_batch = [&]() -> std::optional<uint64_t> {
+            const auto collision_bucket_id = write_buckets(encoding_batch, encoding_tasks, workers, index_output_stream);
+            if (collision_bucket_id) return collision_bucket_id;
+            encoding_batch.swap(loading_batch);
+            loading_batch.clear();
+            encoding_tasks = encode_buckets(encoding_batch, workers);
+            return std::nullopt;
+        };
+
         // We use an exception for collision error condition because ETL currently does not support loading errors
         // TODO(canepat) refactor ETL to support errors in LoadFunc and propagate them to caller to get rid of CollisionError
         struct CollisionError : public std::runtime_error {
@@ -426,24 +465,25 @@ class RecSplit {
                 // k is the big-endian encoding of the bucket number and the v is the key that is assigned into that bucket
                 const uint64_t bucket_id = endian::load_big_u64(entry.key.data());
                 SILK_TRACE << "[index] processing bucket_id=" << bucket_id;
-                if (current_bucket_id_ != bucket_id) {
-                    if (current_bucket_id_ != std::numeric_limits<uint64_t>::max()) {
-                        bool collision = recsplit_current_bucket(index_output_stream);
-                        if (collision) throw CollisionError{bucket_id};
+                if (loading_batch.empty() || loading_batch.back().id != bucket_id) {
+                    if (loading_batch.size() == batch_size) {
+                        const auto collision_bucket_id = next_batch();
+                        if (collision_bucket_id) throw CollisionError{*collision_bucket_id};
                     }
-                    current_bucket_id_ = bucket_id;
+                    loading_batch.emplace_back(bucket_id, bucket_size_);
                 }
-                current_bucket_.emplace_back(endian::load_big_u64(entry.key.data() + sizeof(uint64_t)));
-                current_bucket_offsets_.emplace_back(endian::load_big_u64(entry.value.data()));
+                loading_batch.back().keys.emplace_back(endian::load_big_u64(entry.key.data() + sizeof(uint64_t)));
+                loading_batch.back().offsets.emplace_back(endian::load_big_u64(entry.value.data()));
             });
+            // Flush both the batch being encoded and the last loaded one
+            for (int i{0}; i < 2; ++i) {
+                const auto collision_bucket_id = next_batch();
+                if (collision_bucket_id) throw CollisionError{*collision_bucket_id};
+            }
         } catch (const CollisionError& error) {
             SILK_WARN << "[index] collision detected for bucket=" << error.bucket_id;
             return true;
         }
-        if (!current_bucket_.empty()) {
-            bool collision_detected = recsplit_current_bucket(index_output_stream);
-            if (collision_detected) return true;
-        }
         gr_builder_.append_fixed(1, 1);  // Sentinel (avoids checking for parts of size 1)
         golomb_rice_codes_ = gr_builder_.build();
 
@@ -529,8 +569,6 @@ class RecSplit {
         keys_added_ = 0;
         bucket_collector_.clear();
         offset_collector_.clear();
-        current_bucket_.clear();
-        current_bucket_offsets_.clear();
         max_offset_ = 0;
         bucket_size_accumulator_.resize(1);
         bucket_position_accumulator_.resize(1);
@@ -555,8 +593,118 @@ class RecSplit {
         uint64_t cum_keys, cum_keys_next, bit_pos;
         double_ef_index_.get3(bucket, cum_keys, cum_keys_next, bit_pos);
 
-        // Number of keys in this bucket
-        std::size_t m = cum_keys_next - cum_keys;
+        return search_bucket(hash, cum_keys, cum_keys_next - cum_keys, bit_pos);
+    }
+
+    /** Return the values associated with the given 128-bit hashes.
+     * The lookups are interleaved in small batches, so that the memory accesses of each stage are prefetched for
+     * all the hashes in the batch before being resolved.
+     * @param hashes the 128-bit hashes.
+     * @param values the associated values, must have the same size as hashes.
+     */
+    void operator()(std::span<const hash128_t> hashes, std::span<std::size_t> values) const {
+        ensure(built_, "RecSplit: perfect hash function not built yet");
+        ensure(key_count_ > 0, "RecSplit: invalid lookup with zero keys, use empty() to guard");
+        ensure(hashes.size() == values.size(), "RecSplit: hashes and values size mismatch");
+
+        if (key_count_ == 1) {
+            std::fill(values.begin(), values.end(), 0);
+            return;
+        }
+
+        std::array<uint64_t, kLookupBatchSize> buckets, cum_keys, cum_keys_next, bit_pos;
+        for (std::size_t first{0}; first < hashes.size(); first += kLookupBatchSize) {
+            const std::size_t count = std::min(kLookupBatchSize, hashes.size() - first);
+            for (std::size_t i{0}; i < count; ++i) {
+                buckets[i] = hash128_to_bucket(hashes[first + i]);
+                double_ef_index_.prefetch(buckets[i]);
+            }
+            for (std::size_t i{0}; i < count; ++i) {
+                double_ef_index_.get3(buckets[i], cum_keys[i], cum_keys_next[i], bit_pos[i]);
+                golomb_rice_codes_.prefetch(bit_pos[i], skip_bits(cum_keys_next[i] - cum_keys[i]));
+            }
+            for (std::size_t i{0}; i < count; ++i) {
+                values[first + i] = search_bucket(hashes[first + i], cum_keys[i], cum_keys_next[i] - cum_keys[i], bit_pos[i]);
+            }
+        }
+    }
+
+    //! Return the value associated with the given key within the MPHF mapping
+    std::size_t operator()(const std::string& key) const { return operator()(murmur_hash_3(key.c_str(), key.size())); }
+
+    //! Return the value associated with the given key within the index
+    std::size_t lookup(ByteView key) const { return lookup(key.data(), key.size()); }
+
+    //! Return the value associated with the given key within the index
+    std::size_t lookup(const std::string& key) const { return lookup(key.data(), key.size()); }
+
+    //! Return the value associated with the given key within the index
+    std::size_t lookup(const void* key, const size_t length) const {
+        const auto record = operator()(murmur_hash_3(key, length));
+        return read_record(record);
+    }
+
+    //! Return the values associated with the given keys within the index, interleaving the lookups in small batches
+    //! \param keys the keys to look up
+    //! \param values the associated values, must have the same size as keys
+    void lookup(std::span<const ByteView> keys, std::span<std::size_t> values) const {
+        ensure(keys.size() == values.size(), "RecSplit: keys and values size mismatch");
+
+        std::array<hash128_t, kLookupBatchSize> hashes;
+        for (std::size_t first{0}; first < keys.size(); first += kLookupBatchSize) {
+            const std::size_t count = std::min(kLookupBatchSize, keys.size() - first);
+            for (std::size_t i{0}; i < count; ++i) {
+                hashes[i] = murmur_hash_3(keys[first + i].data(), keys[first + i].size());
+            }
+            const auto records = values.subspan(first, count);
+            operator()(std::span{hashes.data(), count}, records);
+            for (const auto record : records) {
+                succinct::prefetch(encoded_file_->address() + record_position(record));
+            }
+            for (auto& record : records) {
+                record = read_record(record);
+            }
+        }
+    }
+
+    //! Return the offset of the i-th element in the index. Perfect hash table lookup is not performed,
+    //! only access to the Elias-Fano structure containing all offsets
+    std::size_t ordinal_lookup(uint64_t i) const { return ef_offsets_->get(i); }
+
+    //! Return the offsets of the given elements in the index, prefetching all of them before reading any
+    //! \param ordinals the element indexes
+    //! \param offsets the element offsets, must have the same size as ordinals
+    void ordinal_lookup(std::span<const uint64_t> ordinals, std::span<std::size_t> offsets) const {
+        ensure(ordinals.size() == offsets.size(), "RecSplit: ordinals and offsets size mismatch");
+        for (std::size_t first{0}; first < ordinals.size(); first += kLookupBatchSize) {
+            const std::size_t count = std::min(kLookupBatchSize, ordinals.size() - first);
+            for (std::size_t i{first}; i < first + count; ++i) {
+                ef_offsets_->prefetch(ordinals[i]);
+            }
+            for (std::size_t i{first}; i < first + count; ++i) {
+                offsets[i] = ef_offsets_->get(ordinals[i]);
+            }
+        }
+    }
+
+    //! Return the number of keys used to build the RecSplit instance
+    std::size_t key_count() const { return key_count_; }
+
+    bool empty() const { return key_count_ == 0; }
+    uint64_t base_data_id() const { return base_data_id_; }
+    uint64_t record_mask() const { return record_mask_; }
+    uint64_t bucket_count() const { return bucket_count_; }
+    uint16_t bucket_size() const { return bucket_size_; }
+
+    std::size_t file_size() const { return std::filesystem::file_size(index_path_); }
+
+    std::filesystem::file_time_type last_write_time() const {
+        return std::filesystem::last_write_time(index_path_);
+    }
+
+  private:
+    //! Find the value associated with the given 128-bit hash by walking the splitting tree of its bucket
+    std::size_t search_bucket(const hash128_t& hash, uint64_t cum_keys, std::size_t m, uint64_t bit_pos) const {
         auto reader = golomb_rice_codes_.reader();
         reader.read_reset(bit_pos, skip_bits(m));
         int level = 0;
@@ -601,19 +749,12 @@ class RecSplit {
         return cum_keys + remap16(remix(hash.second + b + kStartSeed[level]), m);
     }
 
-    //! Return the value associated with the given key within the MPHF mapping
-    std::size_t operator()(const std::string& key) const { return operator()(murmur_hash_3(key.c_str(), key.size())); }
+    //! Position in the index file of the given record
+    std::size_t record_position(std::size_t record) const { return 1 + 8 + bytes_per_record_ * (record + 1); }
 
-    //! Return the value associated with the given key within the index
-    std::size_t lookup(ByteView key) const { return lookup(key.data(), key.size()); }
-
-    //! Return the value associated with the given key within the index
-    std::size_t lookup(const std::string& key) const { return lookup(key.data(), key.size()); }
-
-    //! Return the value associated with the given key within the index
-    std::size_t lookup(const void* key, const size_t length) const {
-        const auto record = operator()(murmur_hash_3(key, length));
-        const auto position = 1 + 8 + bytes_per_record_ * (record + 1);
+    //! Read the given record from the index file
+    std::size_t read_record(std::size_t record) const {
+        const auto position = record_position(record);
 
         const auto address = encoded_file_->address();
         ensure(position + sizeof(uint64_t) < encoded_file_->length(),
@@ -621,26 +762,6 @@ class RecSplit {
         return endian::load_big_u64(address + position) & record_mask_;
     }
 
-    //! Return the offset of the i-th element in the index. Perfect hash table lookup is not performed,
-    //! only access to the Elias-Fano structure containing all offsets
-    std::size_t ordinal_lookup(uint64_t i) const { return ef_offsets_->get(i); }
-
-    //! Return the number of keys used to build the RecSplit instance
-    std::size_t key_count() const { return key_count_; }
-
-    bool empty() const { return key_count_ == 0; }
-    uint64_t base_data_id() const { return base_data_id_; }
-    uint64_t record_mask() const { return record_mask_; }
-    uint64_t bucket_count() const { return bucket_count_; }
-    uint16_t bucket_size() const { return bucket_size_; }
-
-    std::size_t file_size() const { return std::filesystem::file_size(index_path_); }
-
-    std::filesystem::file_time_type last_write_time() const {
-        return std::filesystem::last_write_time(index_path_);
-    }
-
-  private:
     static inline std::size_t skip_bits(std::size_t m) { return memo[m] & 0xFFFF; }
 
     static inline std::size_t skip_nodes(std::size_t m) { return (memo[m] >> 16) & 0x7FF; }
@@ -701,83 +822,169 @@ class RecSplit {
         return memo;
     }
 
-    //! Compute and store the splittings and bijections of the current bucket
-    bool recsplit_current_bucket(std::ofstream& index_output_stream) {
-        // Extend bucket size accumulator to accommodate current bucket index + 1
-        while (bucket_size_accumulator_.size() <= (current_bucket_id_ + 1)) {
-            bucket_size_accumulator_.push_back(bucket_size_accumulator_.back());
+    //! The keys of one bucket and their RecSplit encoding, which can be computed independently of other buckets
+    struct Bucket {
+        Bucket(uint64_t bucket_id, std::size_t capacity) : id{bucket_id} {
+            keys.reserve(capacity);
+            offsets.reserve(capacity);
         }
-        bucket_size_accumulator_.back() += current_bucket_.size();
-        SILKWORM_ASSERT(bucket_size_accumulator_.back() >= bucket_size_accumulator_[current_bucket_id_]);
 
+        //! Identifier of the bucket
+        uint64_t id;
+
+        //! 64-bit fingerprints of keys in the bucket
+        std::vector<uint64_t> keys;
+
+        //! Index offsets for the keys in the bucket
+        std::vector<uint64_t> offsets;
+
+        //! Fixed part of GR codes for splittings and bijections as (value, subtree size) in tree pre-order
+        std::vector<std::pair<uint64_t, uint16_t>> fixed_codes;
+
+        //! Unary part of GR codes for splittings and bijections in tree pre-order
+        std::vector<uint32_t> unary_codes;
+
+        //! Offsets in the order given by the bijections, ready to be written to the index file
+        Bytes encoded_offsets;
+
+        //! Flag indicating that the bucket contains duplicate keys, so it cannot be encoded
+        bool collision{false};
+    };
+
+    //! Temporary buffers for the RecSplit algorithm owned by each encoding thread
+    struct Workspace {
+        //! Temporary buffer for current bucket
+        std::vector<uint64_t> buffer_bucket;
+
+        //! Temporary buffer for current offsets
+        std::vector<uint64_t> buffer_offsets;
+
+        //! Temporary counters of key remapped occurrences
+        std::vector<std::size_t> count;
+    };
+
+    //! Start the encoding of the given buckets split in contiguous ranges among the workers, or encode them here if none
+    std::vector<std::future<void>> encode_buckets(std::vector<Bucket>& buckets, concurrency::TaskScheduler* workers) const {
+        std::vector<std::future<void>> tasks;
+        if (!workers) {
+            Workspace workspace;
+            for (auto& bucket : buckets) {
+                encode_bucket(bucket, workspace);
+            }
+            return tasks;
+        }
+        const std::size_t num_tasks{std::min<std::size_t>(workers->num_workers(), buckets.size())};
+        tasks.reserve(num_tasks);
+        for (std::size_t t{0}; t < num_tasks; ++t) {
+            const std::size_t begin{buckets.size() * t / num_tasks}, end{buckets.size() * (t + 1) / num_tasks};
+            tasks.emplace_back(workers->submit([this, &buckets, begin, end]() {
+                Workspace workspace;
+                for (std::size_t i{begin}; i < end; ++i) {
+                    encode_bucket(buckets[i], workspace);
+                }
+            }));
+        }
+        return tasks;
+    }
+
+    //! Wait for the encoding task, helping the workers if called by one of them (e.g. when building in a task)
+    static void wait_for(const std::future<void>& task, concurrency::TaskScheduler* workers) {
+        if (workers) {
+            workers->wait(task);
+        } else {
+            task.wait();
+        }
+    }
+
+    //! Compute the splittings and bijections of the given bucket
+    void encode_bucket(Bucket& bucket, Workspace& workspace) const {
         // Sets of size 0 and 1 are not further processed, just write them to index
-        if (current_bucket_.size() > 1) {
-            for (std::size_t i{1}; i < current_bucket_.size(); ++i) {
-                if (current_bucket_[i] == current_bucket_[i - 1]) {
-                    SILK_ERROR << "collision detected key=" << current_bucket_[i - 1];
-                    return true;
+        if (bucket.keys.size() > 1) {
+            for (std::size_t i{1}; i < bucket.keys.size(); ++i) {
+                if (bucket.keys[i] == bucket.keys[i - 1]) {
+                    SILK_ERROR << "collision detected key=" << bucket.keys[i - 1];
+                    bucket.collision = true;
+                    return;
                 }
             }
-            buffer_bucket_.reserve(current_bucket_.size());
-            buffer_offsets_.reserve(current_bucket_offsets_.size());
-            buffer_bucket_.resize(current_bucket_.size());
-            buffer_offsets_.resize(current_bucket_.size());
-
-            std::vector<uint32_t> unary;
-            recsplit(current_bucket_, current_bucket_offsets_, unary, index_output_stream);
-            gr_builder_.append_unary_all(unary);
+            workspace.buffer_bucket.resize(bucket.keys.size());
+            workspace.buffer_offsets.resize(bucket.keys.size());
+            bucket.encoded_offsets.reserve(bucket.keys.size() * bytes_per_record_);
+
+            recsplit(/*.level=*/0, bucket, /*.start=*/0, /*.end=*/bucket.keys.size(), workspace);
         } else {
-            for (const auto offset : current_bucket_offsets_) {
+            for (const auto offset : bucket.offsets) {
                 Bytes uint64_buffer(8, '\0');
                 endian::store_big_u64(uint64_buffer.data(), offset);
-                index_output_stream.write(reinterpret_cast<const char*>(uint64_buffer.data()), 8);
-                SILK_DEBUG << "[index] written offset: " << offset;
+                bucket.encoded_offsets.append(uint64_buffer);
             }
         }
+    }
+
+    //! Wait for the encoding of the given buckets and write them in order, return the first bucket with collision (if any)
+    std::optional<uint64_t> write_buckets(std::vector<Bucket>& buckets, std::vector<std::future<void>>& tasks,
+                                          concurrency::TaskScheduler* workers, std::ofstream& index_output_stream) {
+        for (auto& task : tasks) {
+            wait_for(task, workers);
+            task.get();
+        }
+        tasks.clear();
+        for (const auto& bucket : buckets) {
+            if (bucket.collision) return bucket.id;
+            write_bucket(bucket, index_output_stream);
+        }
+        buckets.clear();
+        return std::nullopt;
+    }
+
+    //! Store the splittings and bijections of the given bucket, buckets must be written in order
+    void write_bucket(const Bucket& bucket, std::ofstream& index_output_stream) {
+        current_bucket_id_ = bucket.id;
+
+        // Extend bucket size accumulator to accommodate current bucket index + 1
+        while (bucket_size_accumulator_.size() <= (current_bucket_id_ + 1)) {
+            bucket_size_accumulator_.push_back(bucket_size_accumulator_.back());
+        }
+        bucket_size_accumulator_.back() += bucket.keys.size();
+        SILKWORM_ASSERT(bucket_size_accumulator_.back() >= bucket_size_accumulator_[current_bucket_id_]);
+
+        for (const auto& [value, m] : bucket.fixed_codes) {
+            gr_builder_.append_fixed(value, golomb_param(m, memo));
+        }
+        if (bucket.keys.size() > 1) {
+            gr_builder_.append_unary_all(bucket.unary_codes);
+        }
+        index_output_stream.write(reinterpret_cast<const char*>(bucket.encoded_offsets.data()), static_cast<std::streamsize>(bucket.encoded_offsets.size()));
+
         // Extend bucket position accumulator to accommodate current bucket index + 1
         while (bucket_position_accumulator_.size() <= current_bucket_id_ + 1) {
             bucket_position_accumulator_.push_back(bucket_position_accumulator_.back());
         }
         bucket_position_accumulator_.back() = gr_builder_.get_bits();
         SILKWORM_ASSERT(bucket_position_accumulator_.back() >= bucket_position_accumulator_[current_bucket_id_]);
-        // Clear for the next bucket
-        current_bucket_.clear();
-        current_bucket_offsets_.clear();
-        return false;
     }
 
     //! Apply the RecSplit algorithm to the given bucket
-    void recsplit(std::vector<uint64_t>& bucket,
-                  std::vector<uint64_t>& offsets,
-                  std::vector<uint32_t>& unary,
-                  std::ofstream& index_ofs) {
-        recsplit(/*.level=*/0, bucket, offsets, /*.start=*/0, /*.end=*/bucket.size(), unary, index_ofs);
-    }
-
-    void recsplit(int level,
-                  std::vector<uint64_t>& bucket,
-                  std::vector<uint64_t>& offsets,
-                  std::size_t start,
-                  std::size_t end,
-                  std::vector<uint32_t>& unary,
-                  std::ofstream& index_ofs) {
+    void recsplit(int level, Bucket& bucket, std::size_t start, std::size_t end, Workspace& workspace) const {
+        auto& keys = bucket.keys;
+        auto& offsets = bucket.offsets;
         uint64_t salt = kStartSeed[level];
         const uint16_t m = end - start;
         SILKWORM_ASSERT(m > 1);
         if (m <= LEAF_SIZE) {
             // No need to build aggregation levels - just find bijection
             if (level == 7) {
-                SILK_DEBUG << "[index] recsplit m: " << m << " salt: " << salt << " start: " << start << " bucket[start]=" << bucket[start]
-                           << " current_bucket_id_=" << current_bucket_id_;
+                SILK_DEBUG << "[index] recsplit m: " << m << " salt: " << salt << " start: " << start << " bucket[start]=" << keys[start]
+                           << " bucket_id=" << bucket.id;
                 for (std::size_t j = 0; j < m; j++) {
-                    SILK_DEBUG << "[index] buffer m: " << m << " start: " << start << " j: " << j << " bucket[start + j]=" << bucket[start + j];
+                    SILK_DEBUG << "[index] buffer m: " << m << " start: " << start << " j: " << j << " bucket[start + j]=" << keys[start + j];
                 }
             }
             while (true) {
                 uint32_t mask{0};
                 bool fail{false};
                 for (uint16_t i{0}; !fail && i < m; i++) {
-                    uint32_t bit = uint32_t(1) << remap16(remix(bucket[start + i] + salt), m);
+                    uint32_t bit = uint32_t(1) << remap16(remix(keys[start + i] + salt), m);
                     if ((mask & bit) != 0) {
                         fail = true;
                     } else {
@@ -788,74 +995,73 @@ class RecSplit {
                 salt++;
             }
             for (std::size_t i{0}; i < m; i++) {
-                std::size_t j = remap16(remix(bucket[start + i] + salt), m);
-                buffer_offsets_[j] = offsets[start + i];
+                std::size_t j = remap16(remix(keys[start + i] + salt), m);
+                workspace.buffer_offsets[j] = offsets[start + i];
             }
             Bytes uint64_buffer(8, '\0');
             for (auto i{0}; i < m; i++) {
-                endian::store_big_u64(uint64_buffer.data(), buffer_offsets_[i]);
-                index_ofs.write(reinterpret_cast<const char*>(uint64_buffer.data() + (8 - bytes_per_record_)), bytes_per_record_);
-                if (level == 0) {
-                    SILK_DEBUG << "[index] written offset: " << buffer_offsets_[i];
-                }
+                endian::store_big_u64(uint64_buffer.data(), workspace.buffer_offsets[i]);
+                bucket.encoded_offsets.append(uint64_buffer.data() + (8 - bytes_per_record_), bytes_per_record_);
             }
             salt -= kStartSeed[level];
-            const auto log2golomb = golomb_param(m, memo);
-            gr_builder_.append_fixed(salt, log2golomb);
-            unary.push_back(static_cast<uint32_t>(salt >> log2golomb));
+            append_code(bucket, salt, m);
         } else {
             const auto [fanout, unit] = SplitStrategy::split_params(m);
 
             SILK_DEBUG << "[index] m > _leaf: m=" << m << " fanout=" << fanout << " unit=" << unit;
 
             SILKWORM_ASSERT(fanout <= kLowerAggregationBound);
-            count_.resize(fanout);
+            auto& count = workspace.count;
+            count.resize(fanout);
             while (true) {
-                std::fill(count_.begin(), count_.end(), 0);
+                std::fill(count.begin(), count.end(), 0);
                 for (std::size_t i{0}; i < m; i++) {
-                    count_[uint16_t(remap16(remix(bucket[start + i] + salt), m)) / unit]++;
+                    count[uint16_t(remap16(remix(keys[start + i] + salt), m)) / unit]++;
                 }
                 bool broken{false};
                 for (std::size_t i = 0; i < fanout - 1; i++) {
-                    broken = broken || (count_[i] != unit);
+                    broken = broken || (count[i] != unit);
                 }
                 if (!broken) break;
                 salt++;
             }
             for (std::size_t i{0}, c{0}; i < fanout; i++, c += unit) {
-                count_[i] = c;
+                count[i] = c;
             }
             for (std::size_t i{0}; i < m; i++) {
-                auto j = uint16_t(remap16(remix(bucket[start + i] + salt), m)) / unit;
-                buffer_bucket_[count_[j]] = bucket[start + i];
-                buffer_offsets_[count_[j]] = offsets[start + i];
-                count_[j]++;
+                auto j = uint16_t(remap16(remix(keys[start + i] + salt), m)) / unit;
+                workspace.buffer_bucket[count[j]] = keys[start + i];
+                workspace.buffer_offsets[count[j]] = offsets[start + i];
+                count[j]++;
             }
-            std::copy(buffer_bucket_.data(), buffer_bucket_.data() + m, bucket.data() + start);
-            std::copy(buffer_offsets_.data(), buffer_offsets_.data() + m, offsets.data() + start);
+            std::copy(workspace.buffer_bucket.data(), workspace.buffer_bucket.data() + m, keys.data() + start);
+            std::copy(workspace.buffer_offsets.data(), workspace.buffer_offsets.data() + m, offsets.data() + start);
 
             salt -= kStartSeed[level];
-            const auto log2golomb = golomb_param(m, memo);
-            gr_builder_.append_fixed(salt, log2golomb);
-            unary.push_back(static_cast<uint32_t>(salt >> log2golomb));
+            append_code(bucket, salt, m);
 
             std::size_t i;
             for (i = 0; i < m - unit; i += unit) {
-                recsplit(level + 1, bucket, offsets, start + i, start + i + unit, unary, index_ofs);
+                recsplit(level + 1, bucket, start + i, start + i + unit, workspace);
             }
             if (m - i > 1) {
-                recsplit(level + 1, bucket, offsets, start + i, end, unary, index_ofs);
+                recsplit(level + 1, bucket, start + i, end, workspace);
             } else if (m - i == 1) {
                 Bytes uint64_buffer(8, '\0');
                 endian::store_big_u64(uint64_buffer.data(), offsets[start + i]);
-                index_ofs.write(reinterpret_cast<const char*>(uint64_buffer.data() + (8 - bytes_per_record_)), bytes_per_record_);
-                if (level == 0) {
-                    SILK_DEBUG << "[index] written offset: " << offsets[start + i];
-                }
+                bucket.encoded_offsets.append(uint64_buffer.data() + (8 - bytes_per_record_), bytes_per_record_);
             }
         }
     }
 
+    //! Record the GR code of the splitting or bijection index for a subtree of size m
+    static void append_code(Bucket& bucket, uint64_t value, uint16_t m) {
+        // Do not touch the max Golomb param index here, it is updated when the bucket is written
+        const auto log2golomb = memo[m] >> 27;
+        bucket.fixed_codes.emplace_back(value, m);
+        bucket.unary_codes.push_back(static_cast<uint32_t>(value >> log2golomb));
+    }
+
     hash128_t inline murmur_hash_3(const void* data, const size_t length) const {
         hash128_t h{};
         hasher_->hash_x64_128(data, length, &h);
@@ -956,15 +1162,15 @@ class RecSplit {
     //! Identifier of the current bucket being accumulated
     uint64_t current_bucket_id_{0};
 
-    //! 64-bit fingerprints of keys in the current bucket accumulated before the recsplit is performed for that bucket
-    std::vector<uint64_t> current_bucket_;
-
-    //! Index offsets for the current bucket
-    std::vector<uint64_t> current_bucket_offsets_;
-
     //! Flag indicating if two-level index "recsplit -> enum" + "enum -> offset" is required
     bool double_enum_index_{true};
 
+    //! The number of threads used to encode the buckets when no shared scheduler is given
+    std::size_t num_threads_{1};
+
+    //! The shared scheduler encoding the buckets (if null, a dedicated one is created when num_threads_ > 1)
+    concurrency::TaskScheduler* scheduler_{nullptr};
+
     //! Flag indicating that the MPHF has been built and no more keys can be added
     bool built_{false};
 
@@ -980,21 +1186,12 @@ class RecSplit {
     //! Accumulator for position of every bucket in the encoding of the hash function
     std::vector<int64_t> bucket_position_accumulator_;
 
-    //! Temporary buffer for current bucket
-    std::vector<uint64_t> buffer_bucket_;
-
-    //! Temporary buffer for current offsets
-    std::vector<uint64_t> buffer_offsets_;
-
     //! Seed for Murmur3 hash used for converting keys to 64-bit values and assigning to buckets
     uint32_t salt_{0};
 
     //! Murmur3 hash factory
     std::unique_ptr<Murmur3> hasher_;
 
-    //! Temporary counters of key remapped occurrences
-    std::vector<std::size_t> count_;
-
     //! The memory-mapped RecSplit-encoded file when opening existing index for read
     std::optional<MemoryMappedFile> encoded_file_;
 };
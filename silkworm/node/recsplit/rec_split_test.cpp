@@ -16,6 +16,10 @@
 
 #include "rec_split.hpp"
 
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
 #include <vector>
 
 #include <catch2/catch.hpp>
@@ -154,6 +158,18 @@ TEST_CASE("RecSplit4: keys=1000 buckets=128", "[silkworm][node][recsplit]") {
         CHECK(rs.build() == false /*collision_detected*/);
         check_bijection(rs, hashed_keys);
     }
+
+    SECTION("random_hash128 OK: batch lookup") {
+        for (const auto& hk : hashed_keys) {
+            rs.add_key(hk, 0);
+        }
+        CHECK(rs.build() == false /*collision_detected*/);
+        std::vector<std::size_t> values(hashed_keys.size());
+        rs(hashed_keys, values);
+        for (std::size_t i{0}; i < hashed_keys.size(); ++i) {
+            CHECK(values[i] == rs(hashed_keys[i]));
+        }
+    }
 }
 
 TEST_CASE("RecSplit4: multiple keys-buckets", "[silkworm][node][recsplit]") {
@@ -203,6 +219,55 @@ TEST_CASE("RecSplit4: multiple keys-buckets", "[silkworm][node][recsplit]") {
     }
 }
 
+TEST_CASE("RecSplit4: parallel build", "[silkworm][node][recsplit]") {
+    test::SetLogVerbosityGuard guard{log::Level::kNone};
+    test::TemporaryFile sequential_index_file;
+    test::TemporaryFile parallel_index_file;
+    test::TemporaryFile shared_index_file;
+
+    constexpr int kTestNumKeys{20'000};
+    constexpr int kTestBucketSize{16};  // Many buckets to have several batches
+
+    std::vector<hash128_t> hashed_keys;
+    for (std::size_t i{0}; i < kTestNumKeys; ++i) {
+        hashed_keys.push_back({test::next_pseudo_random(), test::next_pseudo_random()});
+    }
+
+    const auto build_index = [&](const std::filesystem::path& index_path, std::size_t num_threads,
+                                 concurrency::TaskScheduler* scheduler = nullptr) {
+        RecSplitSettings settings{
+            .keys_count = hashed_keys.size(),
+            .bucket_size = kTestBucketSize,
+            .index_path = index_path,
+            .base_data_id = 0,
+            .num_threads = num_threads,
+            .scheduler = scheduler};
+        RecSplit4 rs{settings, /*.salt=*/kTestSalt};
+        for (std::size_t i{0}; i < hashed_keys.size(); ++i) {
+            rs.add_key(hashed_keys[i], i * 10);
+        }
+        CHECK(rs.build() == false /*collision_detected*/);
+        check_bijection(rs, hashed_keys);
+    };
+    build_index(sequential_index_file.path(), 1);
+    build_index(parallel_index_file.path(), 4);
+    concurrency::TaskScheduler scheduler{3};
+    build_index(shared_index_file.path(), 1, &scheduler);
+
+    // Parallel build must produce exactly the same index file as the sequential one
+    const auto read_file = [](const std::filesystem::path& path) {
+        std::ifstream file{path, std::ios::binary};
+        return std::string{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+    };
+    const auto sequential_index{read_file(sequential_index_file.path())};
+    CHECK(!sequential_index.empty());
+    CHECK(read_file(parallel_index_file.path()) == sequential_index);
+    CHECK(read_file(shared_index_file.path()) == sequential_index);
+
+    RecSplit4 rs_index{parallel_index_file.path()};
+    check_bijection(rs_index, hashed_keys);
+}
+
 TEST_CASE("RecSplit8: index lookup", "[silkworm][node][recsplit][.]") {
     test::SetLogVerbosityGuard guard{log::Level::kNone};
     test::TemporaryFile index_file;
@@ -226,6 +291,39 @@ TEST_CASE("RecSplit8: index lookup", "[silkworm][node][recsplit][.]") {
     }
 }
 
+TEST_CASE("RecSplit8: batch index lookup", "[silkworm][node][recsplit]") {
+    test::SetLogVerbosityGuard guard{log::Level::kNone};
+    test::TemporaryFile index_file;
+    RecSplitSettings settings{
+        .keys_count = 100,
+        .bucket_size = 10,
+        .index_path = index_file.path(),
+        .base_data_id = 0};
+    RecSplit8 rs1{settings, /*.salt=*/kTestSalt};
+
+    std::vector<std::string> keys;
+    for (size_t i{0}; i < settings.keys_count; ++i) {
+        keys.push_back("key " + std::to_string(i));
+        rs1.add_key(keys.back(), i * 17);
+    }
+    CHECK(rs1.build() == false /*collision_detected*/);
+
+    RecSplit8 rs2{settings.index_path};
+    std::vector<ByteView> key_views;
+    for (const auto& key : keys) {
+        key_views.emplace_back(reinterpret_cast<const uint8_t*>(key.data()), key.size());
+    }
+    std::vector<std::size_t> enumeration_indexes(keys.size());
+    rs2.lookup(key_views, enumeration_indexes);
+    std::vector<uint64_t> ordinals(enumeration_indexes.begin(), enumeration_indexes.end());
+    std::vector<std::size_t> offsets(keys.size());
+    rs2.ordinal_lookup(ordinals, offsets);
+    for (size_t i{0}; i < keys.size(); ++i) {
+        CHECK(enumeration_indexes[i] == rs2.lookup(keys[i]));
+        CHECK(offsets[i] == rs2.ordinal_lookup(ordinals[i]));
+    }
+}
+
 TEST_CASE("RecSplit8: double index lookup", "[silkworm][node][recsplit][.]") {
     test::SetLogVerbosityGuard guard{log::Level::kNone};
     test::TemporaryFile index_file;
@@ -242,6 +242,18 @@ inline uint64_t remap128(uint64_t x, uint64_t n) {
 #endif  // __SIZEOF_INT128__
 }
 
+/** Hint the processor to load the cache line containing the given address in view of an upcoming read.
+ * @param address the memory address to prefetch.
+ *
+ */
+inline void prefetch(const void* address) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+    __builtin_prefetch(address);
+#endif
+}
+
 /** Count the number of 1-bits in a word.
  * @param word binary word.
  *
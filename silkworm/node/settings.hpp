@@ -17,6 +17,7 @@
 #pragma once
 
 #include <memory>
+#include <string>
 
 #include <silkworm/infra/common/log.hpp>
 #include <silkworm/infra/grpc/server/server_settings.hpp>
@@ -31,6 +32,7 @@ struct Settings : public NodeSettings {
     sentry::Settings sentry_settings;              // Configuration for Sentry client + embedded server
     rpc::ServerSettings server_settings;           // Configuration for the gRPC server
     snapshot::SnapshotSettings snapshot_settings;  // Configuration for the database snapshots
+    std::string metrics_end_point;                 // Prometheus metrics end-point (empty means disabled)
 };
 
 }  // namespace silkworm::node
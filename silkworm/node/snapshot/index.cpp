@@ -17,6 +17,7 @@
 #include "index.hpp"
 
 #include <stdexcept>
+#include <vector>
 
 #include <magic_enum.hpp>
 
@@ -33,6 +34,11 @@ using RecSplitSettings = succinct::RecSplitSettings;
 using RecSplit8 = succinct::RecSplit8;
 
 void Index::build() {
+    concurrency::TaskScheduler scheduler;
+    build(scheduler);
+}
+
+void Index::build(concurrency::TaskScheduler& scheduler) {
     SILK_INFO << "Index::build path: " << segment_path_.path().string() << " start";
 
     huffman::Decompressor decoder{segment_path_.path()};
@@ -43,31 +49,49 @@ void Index::build() {
         .keys_count = decoder.words_count(),
         .bucket_size = kBucketSize,
         .index_path = index_file.path(),
-        .base_data_id = index_file.block_from()};
+        .base_data_id = index_file.block_from(),
+        .scheduler = &scheduler};
     RecSplit8 rec_split{rec_split_settings};
 
     SILK_INFO << "Build index for: " << segment_path_.path().string() << " start";
+
+    // Split the segment in chunks by skipping words, then decode and compute the keys for all chunks in parallel
+    SILK_INFO << "Process snapshot items to prepare index build for: " << segment_path_.path().string();
+    const auto chunk_offsets = decoder.chunk_offsets(kWordsPerChunk);
+    std::vector<std::vector<Bytes>> chunk_keys(chunk_offsets.size() - 1);
+    std::vector<std::vector<uint64_t>> chunk_word_offsets(chunk_offsets.size() - 1);
+    const auto process_chunk = [&](std::size_t chunk, huffman::Decompressor::Iterator it) -> bool {
+        auto& keys = chunk_keys[chunk];
+        auto& word_offsets = chunk_word_offsets[chunk];
+        keys.reserve(kWordsPerChunk);
+        word_offsets.reserve(kWordsPerChunk);
+        Bytes word{};
+        word.reserve(kPageSize);
+        uint64_t i{chunk * kWordsPerChunk}, offset{chunk_offsets[chunk]};
+        while (it.has_next()) {
+            const uint64_t next_position = it.next(word);
+            keys.push_back(make_key(i, word));
+            word_offsets.push_back(offset);
+            ++i;
+            offset = next_position;
+            word.clear();
+        }
+        return true;
+    };
+    const bool read_ok = decoder.read_ahead(chunk_offsets, process_chunk, scheduler);
+    if (!read_ok) throw std::runtime_error{"cannot build index for: " + segment_path_.path().string()};
+
     uint64_t iterations{0};
     bool collision_detected;
     do {
         iterations++;
-        SILK_INFO << "Process snapshot items to prepare index build for: " << segment_path_.path().string();
-        const bool read_ok = decoder.read_ahead([&](huffman::Decompressor::Iterator it) {
-            Bytes word{};
-            word.reserve(kPageSize);
-            uint64_t i{0}, offset{0};
-            while (it.has_next()) {
-                uint64_t next_position = it.next(word);
-                if (bool ok = walk(rec_split, i, offset, word); !ok) {
-                    return false;
-                }
-                ++i;
-                offset = next_position;
-                word.clear();
+        for (std::size_t chunk{0}; chunk < chunk_keys.size(); ++chunk) {
+            const auto& keys = chunk_keys[chunk];
+            const auto& word_offsets = chunk_word_offsets[chunk];
+            for (std::size_t j{0}; j < keys.size(); ++j) {
+                rec_split.add_key(keys[j].data(), keys[j].size(), word_offsets[j]);
             }
-            return true;
-        });
-        if (!read_ok) throw std::runtime_error{"cannot build index for: " + segment_path_.path().string()};
+        }
 
         SILK_INFO << "Build RecSplit index for: " << segment_path_.path().string() << " [" << iterations << "]";
         collision_detected = rec_split.build();
@@ -79,25 +103,23 @@ void Index::build() {
     SILK_TRACE << "Index::build path: " << segment_path_.path().string() << " end";
 }
 
-bool HeaderIndex::walk(RecSplit8& rec_split, uint64_t i, uint64_t offset, ByteView word) {
+Bytes HeaderIndex::make_key(uint64_t i, ByteView word) const {
     ensure(!word.empty(), "HeaderIndex: word empty i=" + std::to_string(i));
     const uint8_t first_hash_byte{word[0]};
     const ByteView rlp_encoded_header{word.data() + 1, word.size() - 1};
     const ethash::hash256 hash = keccak256(rlp_encoded_header);
     ensure(hash.bytes[0] == first_hash_byte,
            "HeaderIndex: invalid prefix=" + to_hex(first_hash_byte) + " hash=" + to_hex(hash.bytes));
-    rec_split.add_key(hash.bytes, kHashLength, offset);
-    return true;
+    return Bytes{hash.bytes, kHashLength};
 }
 
-bool BodyIndex::walk(RecSplit8& rec_split, uint64_t i, uint64_t offset, ByteView /*word*/) {
-    const auto size = test::encode_varint<uint64_t>(i, uint64_buffer_);
-    rec_split.add_key(uint64_buffer_.data(), size, offset);
-    uint64_buffer_.clear();
-    return true;
+Bytes BodyIndex::make_key(uint64_t i, ByteView /*word*/) const {
+    Bytes key;
+    test::encode_varint<uint64_t>(i, key);
+    return key;
 }
 
-void TransactionIndex::build() {
+void TransactionIndex::build(concurrency::TaskScheduler& scheduler) {
     SILK_INFO << "TransactionIndex::build path: " << segment_path_.path().string() << " start";
 
     const SnapshotPath bodies_segment = SnapshotPath::from(segment_path_.path().parent_path(),
@@ -131,7 +153,8 @@ void TransactionIndex::build() {
         .index_path = tx_idx_file.path(),
         .base_data_id = first_tx_id,
         .double_enum_index = true,
-        .etl_optimal_size = etl::kOptimalBufferSize / 2};
+        .etl_optimal_size = etl::kOptimalBufferSize / 2,
+        .scheduler = &scheduler};
     RecSplit8 tx_hash_rs{tx_hash_rs_settings, 1};
 
     const SnapshotPath tx2block_idx_file = segment_path_.index_file_for_type(SnapshotType::transactions2block);
@@ -142,7 +165,8 @@ void TransactionIndex::build() {
         .index_path = tx2block_idx_file.path(),
         .base_data_id = first_block_num,
         .double_enum_index = false,
-        .etl_optimal_size = etl::kOptimalBufferSize / 2};
+        .etl_optimal_size = etl::kOptimalBufferSize / 2,
+        .scheduler = &scheduler};
     RecSplit8 tx_hash_to_block_rs{tx_hash_to_block_rs_settings, 1};
 
     huffman::Decompressor bodies_decoder{bodies_segment.path()};
@@ -266,8 +290,8 @@ void TransactionIndex::build() {
     SILK_INFO << "TransactionIndex::build path: " << segment_path_.path().string() << " end";
 }
 
-bool TransactionIndex::walk(RecSplit8& /*rec_split*/, uint64_t /*i*/, uint64_t /*offset*/, ByteView /*word*/) {
-    return true;
+Bytes TransactionIndex::make_key(uint64_t /*i*/, ByteView /*word*/) const {
+    return {};
 }
 
 }  // namespace silkworm::snapshot
@@ -19,6 +19,7 @@
 #include <memory>
 #include <utility>
 
+#include <silkworm/infra/concurrency/task_scheduler.hpp>
 #include <silkworm/node/huffman/decompressor.hpp>
 #include <silkworm/node/recsplit/rec_split.hpp>
 #include <silkworm/node/snapshot/path.hpp>
@@ -30,15 +31,23 @@ class Index {
     static constexpr uint64_t kPageSize{4096};
     static constexpr std::size_t kBucketSize{2'000};
 
+    //! The number of words decoded and keyed by each task while building the index
+    static constexpr uint64_t kWordsPerChunk{4'096};
+
     explicit Index(SnapshotPath segment_path) : segment_path_(std::move(segment_path)) {}
     virtual ~Index() = default;
 
     [[nodiscard]] SnapshotPath path() const { return segment_path_.index_file(); }
 
-    virtual void build();
+    //! Build the index on a dedicated scheduler
+    void build();
+
+    //! Build the index decoding the segment and encoding the RecSplit buckets as tasks of the given scheduler
+    virtual void build(concurrency::TaskScheduler& scheduler);
 
   protected:
-    virtual bool walk(succinct::RecSplit8& rec_split, uint64_t i, uint64_t offset, ByteView word) = 0;
+    //! Compute the index key for the i-th word in the segment, called concurrently on different words
+    [[nodiscard]] virtual Bytes make_key(uint64_t i, ByteView word) const = 0;
 
     SnapshotPath segment_path_;
 };
@@ -48,28 +57,26 @@ class HeaderIndex : public Index {
     explicit HeaderIndex(SnapshotPath segment_path) : Index(std::move(segment_path)) {}
 
   protected:
-    bool walk(succinct::RecSplit8& rec_split, uint64_t i, uint64_t offset, ByteView word) override;
+    [[nodiscard]] Bytes make_key(uint64_t i, ByteView word) const override;
 };
 
 class BodyIndex : public Index {
   public:
-    explicit BodyIndex(SnapshotPath segment_path) : Index(std::move(segment_path)), uint64_buffer_(8, '\0') {}
+    explicit BodyIndex(SnapshotPath segment_path) : Index(std::move(segment_path)) {}
 
   protected:
-    bool walk(succinct::RecSplit8& rec_split, uint64_t i, uint64_t offset, ByteView word) override;
-
-  private:
-    Bytes uint64_buffer_;
+    [[nodiscard]] Bytes make_key(uint64_t i, ByteView word) const override;
 };
 
 class TransactionIndex : public Index {
   public:
     explicit TransactionIndex(SnapshotPath segment_path) : Index(std::move(segment_path)) {}
 
-    void build() override;
+    using Index::build;
+    void build(concurrency::TaskScheduler& scheduler) override;
 
   protected:
-    bool walk(succinct::RecSplit8& rec_split, uint64_t i, uint64_t offset, ByteView word) override;
+    [[nodiscard]] Bytes make_key(uint64_t i, ByteView word) const override;
 };
 
 }  // namespace silkworm::snapshot
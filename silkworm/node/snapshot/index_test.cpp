@@ -36,7 +36,13 @@ TEST_CASE("BodyIndex::build OK", "[silkworm][snapshot][index]") {
     test::SampleBodySnapshotFile valid_body_snapshot{};
     test::SampleBodySnapshotPath body_snapshot_path{valid_body_snapshot.path()};  // necessary to tweak the block numbers
     BodyIndex body_index{body_snapshot_path};
-    CHECK_NOTHROW(body_index.build());
+    SECTION("dedicated scheduler") {
+        CHECK_NOTHROW(body_index.build());
+    }
+    SECTION("shared scheduler") {
+        concurrency::TaskScheduler scheduler{2};
+        CHECK_NOTHROW(body_index.build(scheduler));
+    }
 }
 
 TEST_CASE("TransactionIndex::build KO: empty snapshot", "[silkworm][snapshot][index]") {
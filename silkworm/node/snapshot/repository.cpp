@@ -18,11 +18,13 @@
 
 #include <algorithm>
 #include <memory>
+#include <mutex>
 #include <utility>
 
 #include <silkworm/core/common/assert.hpp>
 #include <silkworm/infra/common/ensure.hpp>
 #include <silkworm/infra/common/log.hpp>
+#include <silkworm/infra/concurrency/task_scheduler.hpp>
 
 namespace silkworm::snapshot {
 
@@ -37,11 +39,13 @@ SnapshotRepository::~SnapshotRepository() {
 void SnapshotRepository::reopen_folder() {
     SILK_INFO << "Reopen snapshot repository folder: " << settings_.repository_dir.string();
     SnapshotPathList segment_files = get_segment_files();
+    std::unique_lock lock{segments_mutex_};
     reopen_list(segment_files, /*.optimistic=*/false);
 }
 
 void SnapshotRepository::close() {
     SILK_INFO << "Close snapshot repository folder: " << settings_.repository_dir.string();
+    std::unique_lock lock{segments_mutex_};
     for (const auto& [_, header_seg] : this->header_segments_) {
         header_seg->close();
     }
@@ -53,6 +57,52 @@ void SnapshotRepository::close() {
     }
 }
 
+void SnapshotRepository::add_segments(const SnapshotPathList& segment_files) {
+    std::unique_lock lock{segments_mutex_};
+    BlockNum segment_max_block{segment_max_block_};
+    for (const auto& seg_file : segment_files) {
+        SILK_INFO << "Add segment file: " << seg_file.path().filename().string();
+        bool snapshot_added{false};
+        switch (seg_file.type()) {
+            case SnapshotType::headers: {
+                snapshot_added = reopen_header(seg_file);
+                break;
+            }
+            case SnapshotType::bodies: {
+                snapshot_added = reopen_body(seg_file);
+                break;
+            }
+            case SnapshotType::transactions: {
+                snapshot_added = reopen_transaction(seg_file);
+                break;
+            }
+            default: {
+                SILKWORM_ASSERT(false);
+            }
+        }
+        if (snapshot_added && seg_file.block_to() > segment_max_block) {
+            segment_max_block = seg_file.block_to() - 1;
+        }
+    }
+    segment_max_block_ = segment_max_block;
+    idx_max_block_ = max_idx_available();
+}
+
+std::size_t SnapshotRepository::header_snapshots_count() const {
+    std::shared_lock lock{segments_mutex_};
+    return header_segments_.size();
+}
+
+std::size_t SnapshotRepository::body_snapshots_count() const {
+    std::shared_lock lock{segments_mutex_};
+    return body_segments_.size();
+}
+
+std::size_t SnapshotRepository::tx_snapshots_count() const {
+    std::shared_lock lock{segments_mutex_};
+    return tx_segments_.size();
+}
+
 std::vector<BlockNumRange> SnapshotRepository::missing_block_ranges() const {
     const auto ordered_segments = get_segment_files();
 
@@ -69,60 +119,77 @@ std::vector<BlockNumRange> SnapshotRepository::missing_block_ranges() const {
 }
 
 bool SnapshotRepository::for_each_header(const HeaderSnapshot::Walker& fn) {
+    std::shared_lock lock{segments_mutex_};
+    concurrency::TaskScheduler workers;
     for (const auto& [_, header_snapshot] : header_segments_) {
         SILK_DEBUG << "for_each_header header_snapshot: " << header_snapshot->fs_path().string();
-        const auto keep_going = header_snapshot->for_each_header([fn](const auto* header) {
-            return fn(header);
-        });
+        const auto keep_going = header_snapshot->for_each_header(
+            [fn](const auto* header) {
+                return fn(header);
+            },
+            workers);
         if (!keep_going) return false;
     }
     return true;
 }
 
 bool SnapshotRepository::for_each_body(const BodySnapshot::Walker& fn) {
+    std::shared_lock lock{segments_mutex_};
+    concurrency::TaskScheduler workers;
     for (const auto& [_, body_snapshot] : body_segments_) {
         SILK_DEBUG << "for_each_body body_snapshot: " << body_snapshot->fs_path().string();
-        const auto keep_going = body_snapshot->for_each_body([fn](BlockNum number, const auto* body) {
-            return fn(number, body);
-        });
+        const auto keep_going = body_snapshot->for_each_body(
+            [fn](BlockNum number, const auto* body) {
+                return fn(number, body);
+            },
+            workers);
         if (!keep_going) return false;
     }
     return true;
 }
 
 SnapshotRepository::ViewResult SnapshotRepository::view_header_segment(BlockNum number, const HeaderSnapshotWalker& walker) {
+    std::shared_lock lock{segments_mutex_};
     return view(header_segments_, number, walker);
 }
 
 SnapshotRepository::ViewResult SnapshotRepository::view_body_segment(BlockNum number, const BodySnapshotWalker& walker) {
+    std::shared_lock lock{segments_mutex_};
     return view(body_segments_, number, walker);
 }
 
 SnapshotRepository::ViewResult SnapshotRepository::view_tx_segment(BlockNum number, const TransactionSnapshotWalker& walker) {
+    std::shared_lock lock{segments_mutex_};
     return view(tx_segments_, number, walker);
 }
 
 std::size_t SnapshotRepository::view_header_segments(const HeaderSnapshotWalker& walker) {
+    std::shared_lock lock{segments_mutex_};
     return view(header_segments_, walker);
 }
 
 std::size_t SnapshotRepository::view_body_segments(const BodySnapshotWalker& walker) {
+    std::shared_lock lock{segments_mutex_};
     return view(body_segments_, walker);
 }
 
 std::size_t SnapshotRepository::view_tx_segments(const TransactionSnapshotWalker& walker) {
+    std::shared_lock lock{segments_mutex_};
     return view(tx_segments_, walker);
 }
 
 const HeaderSnapshot* SnapshotRepository::find_header_segment(BlockNum number) const {
+    std::shared_lock lock{segments_mutex_};
     return find_segment(header_segments_, number);
 }
 
 const BodySnapshot* SnapshotRepository::find_body_segment(BlockNum number) const {
+    std::shared_lock lock{segments_mutex_};
     return find_segment(body_segments_, number);
 }
 
 const TransactionSnapshot* SnapshotRepository::find_tx_segment(BlockNum number) const {
+    std::shared_lock lock{segments_mutex_};
     return find_segment(tx_segments_, number);
 }
 
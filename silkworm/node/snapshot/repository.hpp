@@ -16,9 +16,11 @@
 
 #pragma once
 
+#include <atomic>
 #include <filesystem>
 #include <functional>
 #include <optional>
+#include <shared_mutex>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -46,7 +48,7 @@ using TransactionSnapshotWalker = SnapshotWalker<TransactionSnapshot>;
 
 //! Read-only repository for all snapshot files.
 //! @details Some simplifications are currently in place:
-//! - it opens snapshots only on startup and they are immutable
+//! - it opens snapshots on startup and then only adds new ones, which are immutable
 //! - all snapshots of given blocks range must exist (to make such range available)
 //! - gaps in blocks range are not allowed
 //! - segments have [from:to) semantic
@@ -58,17 +60,20 @@ class SnapshotRepository {
     [[nodiscard]] const SnapshotSettings& settings() const { return settings_; }
     [[nodiscard]] std::filesystem::path path() const { return settings_.repository_dir; }
 
-    [[nodiscard]] BlockNum max_block_available() const { return std::min(segment_max_block_, idx_max_block_); }
+    [[nodiscard]] BlockNum max_block_available() const { return std::min(segment_max_block_.load(), idx_max_block_.load()); }
 
     void reopen_folder();
     void close();
 
+    //! Open the given segment files, which must have their indexes already built, in addition to the current ones
+    void add_segments(const SnapshotPathList& segment_files);
+
     bool for_each_header(const HeaderSnapshot::Walker& fn);
     bool for_each_body(const BodySnapshot::Walker& fn);
 
-    [[nodiscard]] std::size_t header_snapshots_count() const { return header_segments_.size(); }
-    [[nodiscard]] std::size_t body_snapshots_count() const { return body_segments_.size(); }
-    [[nodiscard]] std::size_t tx_snapshots_count() const { return tx_segments_.size(); }
+    [[nodiscard]] std::size_t header_snapshots_count() const;
+    [[nodiscard]] std::size_t body_snapshots_count() const;
+    [[nodiscard]] std::size_t tx_snapshots_count() const;
 
     [[nodiscard]] std::vector<BlockNumRange> missing_block_ranges() const;
     enum ViewResult {
@@ -130,10 +135,13 @@ class SnapshotRepository {
     SnapshotSettings settings_;
 
     //! All types of .seg files are available - up to this block number
-    BlockNum segment_max_block_{0};
+    std::atomic<BlockNum> segment_max_block_{0};
 
     //! All types of .idx files are available - up to this block number
-    BlockNum idx_max_block_{0};
+    std::atomic<BlockNum> idx_max_block_{0};
+
+    //! Mutual exclusion between readers of the segments and the addition of new segments
+    mutable std::shared_mutex segments_mutex_;
 
     //! The snapshots containing the block Headers
     SnapshotsByPath<HeaderSnapshot> header_segments_;
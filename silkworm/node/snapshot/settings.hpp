@@ -24,11 +24,17 @@
 
 namespace silkworm::snapshot {
 
+//! The number of most recent blocks always kept in the database when freezing, i.e. the reorg-safe distance from head
+constexpr uint64_t kDefaultFreezeThreshold{90'000};
+
 struct SnapshotSettings {
     std::filesystem::path repository_dir{DataDirectory{}.snapshots().path()};  // Path to the snapshot repository on disk
     bool enabled{true};                                                        // Flag indicating if snapshots are enabled
     bool no_downloader{false};                                                 // Flag indicating if snapshots download is disabled
     uint64_t segment_size{kDefaultSegmentSize};                                // The segment size measured as number of blocks
+    bool freeze{false};                                                        // Flag indicating if old blocks are moved from db to snapshots
+    uint64_t freeze_threshold{kDefaultFreezeThreshold};                        // The number of most recent blocks never frozen
+    bool freeze_keep_blocks{false};                                            // Flag indicating if frozen blocks are kept in db
     BitTorrentSettings bittorrent_settings;                                    // The Bittorrent protocol settings
 };
 
@@ -16,6 +16,8 @@
 
 #include "snapshot.hpp"
 
+#include <algorithm>
+
 #include <magic_enum.hpp>
 
 #include <silkworm/core/common/util.hpp>
@@ -62,6 +64,61 @@ bool Snapshot::for_each_item(const Snapshot::WordItemFunc& fn) {
     });
 }
 
+bool Snapshot::for_each_item(const Snapshot::WordItemFunc& fn, concurrency::TaskScheduler& workers) {
+    const auto* index = ordinal_index();
+    const std::size_t max_chunks{workers.num_workers()};
+    if (index == nullptr || max_chunks < 2 || item_count() <= kItemsPerChunk) {
+        return for_each_item(fn);
+    }
+
+    // Decode the items in rounds of parallel chunks, then visit each round in order to keep memory usage bounded
+    std::vector<std::vector<WordItem>> chunk_items(max_chunks);
+    std::vector<uint64_t> chunk_offsets;
+    chunk_offsets.reserve(max_chunks + 1);
+    const uint64_t items_per_round{kItemsPerChunk * max_chunks};
+    for (uint64_t first_position{0}; first_position < item_count(); first_position += items_per_round) {
+        const uint64_t end_position = std::min<uint64_t>(first_position + items_per_round, item_count());
+        chunk_offsets.clear();
+        for (uint64_t position{first_position}; position < end_position; position += kItemsPerChunk) {
+            chunk_offsets.push_back(index->ordinal_lookup(position));
+        }
+        chunk_offsets.push_back(end_position < item_count() ? index->ordinal_lookup(end_position) : decoder_.data_size());
+
+        const auto decode_chunk = [&](std::size_t chunk, huffman::Decompressor::Iterator it) -> bool {
+            auto& items = chunk_items[chunk];
+            const uint64_t chunk_position{first_position + chunk * kItemsPerChunk};
+            uint64_t offset{chunk_offsets[chunk]};
+            std::size_t count{0};
+            while (it.has_next()) {
+                if (count == items.size()) {
+                    items.emplace_back();
+                }
+                auto& item = items[count];
+                item.position = chunk_position + count;
+                item.offset = offset;
+                item.value.clear();
+                offset = it.next(item.value);
+                ++count;
+            }
+            items.resize(count);
+            // The index must locate exactly the expected number of items in each chunk
+            return count == std::min(kItemsPerChunk, end_position - chunk_position);
+        };
+        const bool read_ok = decoder_.read_ahead(chunk_offsets, decode_chunk, workers);
+        if (!read_ok) {
+            SILK_WARN << "Snapshot::for_each_item inconsistent index for: " << path_.string();
+            return false;
+        }
+
+        for (std::size_t chunk{0}; chunk + 1 < chunk_offsets.size(); ++chunk) {
+            for (auto& item : chunk_items[chunk]) {
+                if (!fn(item)) return false;
+            }
+        }
+    }
+    return true;
+}
+
 std::optional<Snapshot::WordItem> Snapshot::next_item(uint64_t offset) const {
     SILK_TRACE << "Snapshot::next_item offset: " << offset;
     auto data_iterator = decoder_.make_iterator();
@@ -97,14 +154,22 @@ SnapshotPath HeaderSnapshot::path() const {
 }
 
 bool HeaderSnapshot::for_each_header(const Walker& walker) {
-    return for_each_item([this, walker](const WordItem& item) -> bool {
+    return for_each_item(header_item_walker(walker));
+}
+
+bool HeaderSnapshot::for_each_header(const Walker& walker, concurrency::TaskScheduler& workers) {
+    return for_each_item(header_item_walker(walker), workers);
+}
+
+Snapshot::WordItemFunc HeaderSnapshot::header_item_walker(const Walker& walker) const {
+    return [this, walker](const WordItem& item) -> bool {
         BlockHeader header;
         const auto decode_ok = decode_header(item, header);
         if (!decode_ok) {
             return false;
         }
         return walker(&header);
-    });
+    };
 }
 
 std::optional<BlockHeader> HeaderSnapshot::next_header(uint64_t offset) const {
@@ -141,6 +206,31 @@ std::optional<BlockHeader> HeaderSnapshot::header_by_hash(const Hash& block_hash
     return header;
 }
 
+std::vector<std::optional<BlockHeader>> HeaderSnapshot::headers_by_hash(std::span<const Hash> block_hashes) const {
+    std::vector<std::optional<BlockHeader>> headers(block_hashes.size());
+    if (!idx_header_hash_ || block_hashes.empty()) {
+        return headers;
+    }
+
+    // First, get all the header ordinal positions in snapshot by using block hashes as MPHF index in one batch
+    std::vector<ByteView> keys(block_hashes.begin(), block_hashes.end());
+    std::vector<std::size_t> header_positions(block_hashes.size());
+    idx_header_hash_->lookup(keys, header_positions);
+    // Then, get all the header offsets in snapshot by using ordinal lookup in one batch
+    std::vector<uint64_t> header_ordinals(header_positions.begin(), header_positions.end());
+    std::vector<std::size_t> header_offsets(block_hashes.size());
+    idx_header_hash_->ordinal_lookup(header_ordinals, header_offsets);
+    // Finally, read the headers at specified offsets
+    for (std::size_t i{0}; i < block_hashes.size(); ++i) {
+        auto header = next_header(header_offsets[i]);
+        // We *must* ensure that the retrieved header hash matches because there is no way to know if key exists in MPHF
+        if (header and header->hash() == block_hashes[i]) {
+            headers[i] = std::move(header);
+        }
+    }
+    return headers;
+}
+
 std::optional<BlockHeader> HeaderSnapshot::header_by_number(BlockNum block_height) const {
     if (!idx_header_hash_) {
         return {};
@@ -196,12 +286,20 @@ SnapshotPath BodySnapshot::path() const {
 }
 
 bool BodySnapshot::for_each_body(const Walker& walker) {
-    return for_each_item([&](const WordItem& item) -> bool {
+    return for_each_item(body_item_walker(walker));
+}
+
+bool BodySnapshot::for_each_body(const Walker& walker, concurrency::TaskScheduler& workers) {
+    return for_each_item(body_item_walker(walker), workers);
+}
+
+Snapshot::WordItemFunc BodySnapshot::body_item_walker(const Walker& walker) const {
+    return [this, walker](const WordItem& item) -> bool {
         db::detail::BlockBodyForStorage body;
         success_or_throw(decode_body(item, body));
         const BlockNum number = block_from_ + item.position;
         return walker(number, &body);
-    });
+    };
 }
 
 std::pair<uint64_t, uint64_t> BodySnapshot::compute_txs_amount() {
@@ -317,6 +415,31 @@ std::optional<Transaction> TransactionSnapshot::txn_by_hash(const Hash& txn_hash
     return txn;
 }
 
+std::vector<std::optional<Transaction>> TransactionSnapshot::txns_by_hash(std::span<const Hash> txn_hashes) const {
+    std::vector<std::optional<Transaction>> transactions(txn_hashes.size());
+    if (!idx_txn_hash_ || txn_hashes.empty()) {
+        return transactions;
+    }
+
+    // First, get all the transaction ordinal positions in snapshot by using hashes as MPHF index in one batch
+    std::vector<ByteView> keys(txn_hashes.begin(), txn_hashes.end());
+    std::vector<std::size_t> txn_positions(txn_hashes.size());
+    idx_txn_hash_->lookup(keys, txn_positions);
+    // Then, get all the transaction offsets in snapshot by using ordinal lookup in one batch
+    std::vector<uint64_t> txn_ordinals(txn_positions.begin(), txn_positions.end());
+    std::vector<std::size_t> txn_offsets(txn_hashes.size());
+    idx_txn_hash_->ordinal_lookup(txn_ordinals, txn_offsets);
+    // Finally, read the transactions at specified offsets
+    for (std::size_t i{0}; i < txn_hashes.size(); ++i) {
+        auto txn = next_txn(txn_offsets[i]);
+        // We *must* ensure that the retrieved txn hash matches because there is no way to know if key exists in MPHF
+        if (txn and txn->hash() == txn_hashes[i]) {
+            transactions[i] = std::move(txn);
+        }
+    }
+    return transactions;
+}
+
 std::optional<Transaction> TransactionSnapshot::txn_by_id(uint64_t txn_id) const {
     if (!idx_txn_hash_) {
         return {};
@@ -357,8 +480,6 @@ std::vector<Transaction> TransactionSnapshot::txn_range(uint64_t base_txn_id, ui
         }
 
         transactions.push_back(std::move(transaction));
-
-        transactions.emplace_back();
         return true;
     });
 
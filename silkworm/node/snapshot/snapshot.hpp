@@ -21,11 +21,14 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <silkworm/core/common/base.hpp>
 #include <silkworm/core/types/block.hpp>
+#include <silkworm/infra/concurrency/task_scheduler.hpp>
 #include <silkworm/node/db/util.hpp>
 #include <silkworm/node/huffman/decompressor.hpp>
 #include <silkworm/node/recsplit/rec_split.hpp>
@@ -37,6 +40,9 @@ class Snapshot {
   public:
     static constexpr uint64_t kPageSize{4096};
 
+    //! The number of items decoded by each task in parallel scans
+    static constexpr uint64_t kItemsPerChunk{512};
+
     explicit Snapshot(std::filesystem::path path, BlockNum block_from, BlockNum block_to);
     virtual ~Snapshot() = default;
 
@@ -63,6 +69,9 @@ class Snapshot {
     };
     using WordItemFunc = std::function<bool(WordItem&)>;
     bool for_each_item(const WordItemFunc& fn);
+
+    //! Visit all the items in order, decoding them in parallel chunks located by the ordinal index if available
+    bool for_each_item(const WordItemFunc& fn, concurrency::TaskScheduler& workers);
     [[nodiscard]] std::optional<WordItem> next_item(uint64_t offset) const;
 
     void close();
@@ -71,6 +80,9 @@ class Snapshot {
     void close_segment();
     virtual void close_index() = 0;
 
+    //! The index giving the offset of each item from its ordinal position, if any
+    [[nodiscard]] virtual const succinct::RecSplitIndex* ordinal_index() const { return nullptr; }
+
     std::filesystem::path path_;
     BlockNum block_from_{0};
     BlockNum block_to_{0};
@@ -88,9 +100,11 @@ class HeaderSnapshot : public Snapshot {
 
     using Walker = std::function<bool(const BlockHeader* header)>;
     bool for_each_header(const Walker& walker);
+    bool for_each_header(const Walker& walker, concurrency::TaskScheduler& workers);
     [[nodiscard]] std::optional<BlockHeader> next_header(uint64_t offset) const;
 
     [[nodiscard]] std::optional<BlockHeader> header_by_hash(const Hash& block_hash) const;
+    [[nodiscard]] std::vector<std::optional<BlockHeader>> headers_by_hash(std::span<const Hash> block_hashes) const;
     [[nodiscard]] std::optional<BlockHeader> header_by_number(BlockNum block_height) const;
 
     void reopen_index() override;
@@ -98,8 +112,12 @@ class HeaderSnapshot : public Snapshot {
   protected:
     bool decode_header(const Snapshot::WordItem& item, BlockHeader& header) const;
 
+    [[nodiscard]] WordItemFunc header_item_walker(const Walker& walker) const;
+
     void close_index() override;
 
+    [[nodiscard]] const succinct::RecSplitIndex* ordinal_index() const override { return idx_header_hash_.get(); }
+
   private:
     //! Index header_hash -> headers_segment_offset
     std::unique_ptr<succinct::RecSplitIndex> idx_header_hash_;
@@ -118,6 +136,7 @@ class BodySnapshot : public Snapshot {
 
     using Walker = std::function<bool(BlockNum number, const StoredBlockBody* body)>;
     bool for_each_body(const Walker& walker);
+    bool for_each_body(const Walker& walker, concurrency::TaskScheduler& workers);
     [[nodiscard]] std::optional<StoredBlockBody> next_body(uint64_t offset) const;
 
     std::pair<uint64_t, uint64_t> compute_txs_amount();
@@ -129,8 +148,12 @@ class BodySnapshot : public Snapshot {
   protected:
     static DecodingResult decode_body(const Snapshot::WordItem& item, StoredBlockBody& body);
 
+    [[nodiscard]] WordItemFunc body_item_walker(const Walker& walker) const;
+
     void close_index() override;
 
+    [[nodiscard]] const succinct::RecSplitIndex* ordinal_index() const override { return idx_body_number_.get(); }
+
   private:
     //! Index block_num_u64 -> bodies_segment_offset
     std::unique_ptr<succinct::RecSplitIndex> idx_body_number_;
@@ -149,6 +172,7 @@ class TransactionSnapshot : public Snapshot {
     [[nodiscard]] std::optional<Transaction> next_txn(uint64_t offset) const;
 
     [[nodiscard]] std::optional<Transaction> txn_by_hash(const Hash& txn_hash) const;
+    [[nodiscard]] std::vector<std::optional<Transaction>> txns_by_hash(std::span<const Hash> txn_hashes) const;
     [[nodiscard]] std::optional<Transaction> txn_by_id(uint64_t txn_id) const;
     [[nodiscard]] std::vector<Transaction> txn_range(uint64_t base_txn_id, uint64_t txn_count, bool read_senders) const;
     [[nodiscard]] std::vector<Bytes> txn_rlp_range(uint64_t base_txn_id, uint64_t txn_count) const;
@@ -163,6 +187,8 @@ class TransactionSnapshot : public Snapshot {
 
     void close_index() override;
 
+    [[nodiscard]] const succinct::RecSplitIndex* ordinal_index() const override { return idx_txn_hash_.get(); }
+
   private:
     //! Index transaction_hash -> transactions_segment_offset
     std::unique_ptr<succinct::RecSplitIndex> idx_txn_hash_;
@@ -16,6 +16,7 @@
 
 #include "snapshot.hpp"
 
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -127,6 +128,30 @@ TEST_CASE("HeaderSnapshot::header_by_number OK", "[silkworm][snapshot][index][.]
     }
 }
 
+// https://etherscan.io/block/1500013
+TEST_CASE("HeaderSnapshot::headers_by_hash OK", "[silkworm][snapshot][index][.]") {
+    test::SetLogVerbosityGuard guard{log::Level::kNone};
+    test::SampleHeaderSnapshotFile valid_header_snapshot{};
+    test::SampleHeaderSnapshotPath header_snapshot_path{valid_header_snapshot.path()};  // necessary to tweak the block numbers
+    HeaderIndex header_index{header_snapshot_path};
+    REQUIRE_NOTHROW(header_index.build());
+
+    HeaderSnapshot header_snapshot{header_snapshot_path.path(), header_snapshot_path.block_from(), header_snapshot_path.block_to()};
+    header_snapshot.reopen_segment();
+    header_snapshot.reopen_index();
+    const Hash block_hash{0xbef48d7de01f2d7ea1a7e4d1ed401f73d6d0257a364f6770b25ba51a123ac35f_bytes32};
+    const Hash parent_hash{0x48a486d69a07e99ed6997eb0f9b8795e4e7d07c0ce5b8ee8e139d653fd1b01c3_bytes32};
+    const std::vector<Hash> block_hashes{block_hash, parent_hash, block_hash};
+    const auto headers = header_snapshot.headers_by_hash(block_hashes);
+    REQUIRE(headers.size() == block_hashes.size());
+    for (std::size_t i{0}; i < block_hashes.size(); ++i) {
+        CHECK(headers[i] == header_snapshot.header_by_hash(block_hashes[i]));
+    }
+    CHECK((headers[0] && headers[0]->number == 1'500'013));
+    CHECK(!headers[1]);
+    CHECK(header_snapshot.headers_by_hash({}).empty());
+}
+
 // https://etherscan.io/block/1500013
 TEST_CASE("BodySnapshot::body_by_number OK", "[silkworm][snapshot][index]") {
     test::SetLogVerbosityGuard guard{log::Level::kNone};
@@ -146,4 +171,34 @@ TEST_CASE("BodySnapshot::body_by_number OK", "[silkworm][snapshot][index]") {
     }
 }
 
+TEST_CASE("BodySnapshot::for_each_body parallel", "[silkworm][snapshot][index]") {
+    test::SetLogVerbosityGuard guard{log::Level::kNone};
+    test::SampleBodySnapshotFile valid_body_snapshot{};
+    test::SampleBodySnapshotPath body_snapshot_path{valid_body_snapshot.path()};  // necessary to tweak the block numbers
+    BodyIndex body_index{body_snapshot_path};
+    REQUIRE_NOTHROW(body_index.build());
+
+    BodySnapshot body_snapshot{body_snapshot_path.path(), body_snapshot_path.block_from(), body_snapshot_path.block_to()};
+    body_snapshot.reopen_segment();
+    body_snapshot.reopen_index();
+
+    using BodyEntry = std::tuple<BlockNum, uint64_t, uint64_t>;
+    std::vector<BodyEntry> sequential_bodies;
+    CHECK(body_snapshot.for_each_body([&](BlockNum number, const StoredBlockBody* body) {
+        sequential_bodies.emplace_back(number, body->base_txn_id, body->txn_count);
+        return true;
+    }));
+    CHECK(!sequential_bodies.empty());
+
+    concurrency::TaskScheduler workers{4};
+    std::vector<BodyEntry> parallel_bodies;
+    CHECK(body_snapshot.for_each_body(
+        [&](BlockNum number, const StoredBlockBody* body) {
+            parallel_bodies.emplace_back(number, body->base_txn_id, body->txn_count);
+            return true;
+        },
+        workers));
+    CHECK(parallel_bodies == sequential_bodies);
+}
+
 }  // namespace silkworm::snapshot
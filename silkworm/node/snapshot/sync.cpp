@@ -18,13 +18,13 @@
 
 #include <chrono>
 #include <latch>
+#include <optional>
 
 #include <magic_enum.hpp>
 
 #include <silkworm/core/types/hash.hpp>
 #include <silkworm/infra/common/ensure.hpp>
 #include <silkworm/infra/common/log.hpp>
-#include <silkworm/infra/concurrency/thread_pool.hpp>
 #include <silkworm/node/db/stages.hpp>
 #include <silkworm/node/etl/collector.hpp>
 #include <silkworm/node/snapshot/config.hpp>
@@ -35,10 +35,12 @@ namespace silkworm::snapshot {
 //! Interval between successive checks for either completion or stop requested
 static constexpr std::chrono::seconds kCheckCompletionInterval{1};
 
-SnapshotSync::SnapshotSync(SnapshotRepository* repository, const ChainConfig& config)
+SnapshotSync::SnapshotSync(SnapshotRepository* repository, const ChainConfig& config,
+                           concurrency::TaskScheduler* scheduler)
     : repository_{repository},
       settings_{repository_->settings()},
       config_(config),
+      scheduler_{scheduler},
       client_{settings_.bittorrent_settings} {
     ensure(repository_, "SnapshotSync: SnapshotRepository is null");
 }
@@ -191,25 +193,21 @@ bool SnapshotSync::stop() {
 }
 
 void SnapshotSync::build_missing_indexes() {
-    ThreadPool workers;
+    std::optional<concurrency::TaskScheduler> own_scheduler;
+    if (!scheduler_) {
+        own_scheduler.emplace();
+    }
+    concurrency::TaskScheduler& scheduler{scheduler_ ? *scheduler_ : *own_scheduler};
 
-    // Determine the missing indexes and build them in parallel
+    // Build the missing indexes one at a time: each build already spreads its decoding and bucket encoding as tasks
+    // over all the workers, so the cores are kept busy without holding many segments in memory at once
     const auto missing_indexes = repository_->missing_indexes();
     for (const auto& index : missing_indexes) {
-        workers.push_task([=]() {
-            log::Info() << "[Snapshots] Build index: " << index->path().filename() << " start";
-            index->build();
-            log::Info() << "[Snapshots] Build index: " << index->path().filename() << " end";
-        });
-    }
-
-    // Wait for all missing indexes to be built or stop request
-    while (workers.get_tasks_total() and not is_stopping()) {
-        std::this_thread::sleep_for(kCheckCompletionInterval);
+        if (is_stopping()) break;
+        log::Info() << "[Snapshots] Build index: " << index->path().filename() << " start";
+        index->build(scheduler);
+        log::Info() << "[Snapshots] Build index: " << index->path().filename() << " end";
     }
-    // Wait for any already-started-but-unfinished work in case of stop request
-    workers.pause();
-    workers.wait_for_tasks();
 }
 
 void SnapshotSync::update_database(db::RWTxn& txn, BlockNum max_block_available) {
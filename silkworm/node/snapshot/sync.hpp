@@ -22,6 +22,7 @@
 
 #include <silkworm/core/chain/config.hpp>
 #include <silkworm/infra/concurrency/stoppable.hpp>
+#include <silkworm/infra/concurrency/task_scheduler.hpp>
 #include <silkworm/node/bittorrent/client.hpp>
 #include <silkworm/node/db/access_layer.hpp>
 #include <silkworm/node/snapshot/repository.hpp>
@@ -31,7 +32,8 @@ namespace silkworm::snapshot {
 
 class SnapshotSync : public Stoppable {
   public:
-    SnapshotSync(SnapshotRepository* repository, const ChainConfig& config);
+    SnapshotSync(SnapshotRepository* repository, const ChainConfig& config,
+                 concurrency::TaskScheduler* scheduler = nullptr);
     ~SnapshotSync() override;
 
     bool stop() override;
@@ -52,6 +54,7 @@ class SnapshotSync : public Stoppable {
     SnapshotRepository* repository_;
     const SnapshotSettings& settings_;
     const ChainConfig& config_;
+    concurrency::TaskScheduler* scheduler_;  // The shared scheduler building the indexes (if null, a dedicated one)
     BitTorrentClient client_;
     std::thread client_thread_;
 };
@@ -0,0 +1,140 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "block_preverifier.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+#include <silkworm/core/common/util.hpp>
+#include <silkworm/core/crypto/signer_recovery.hpp>
+
+namespace silkworm::stagedsync {
+
+static ValidationResult check_body(const Block& block) {
+    if (protocol::compute_transaction_root(block) != block.header.transactions_root) {
+        return ValidationResult::kWrongTransactionsRoot;
+    }
+    if (protocol::compute_ommers_hash(block) != block.header.ommers_hash) {
+        return ValidationResult::kWrongOmmersHash;
+    }
+    if (protocol::compute_withdrawals_root(block) != block.header.withdrawals_root) {
+        return ValidationResult::kWrongWithdrawalsRoot;
+    }
+    return ValidationResult::kOk;
+}
+
+BlockPreverification::BlockPreverification(concurrency::TaskScheduler& scheduler, std::shared_ptr<const Block> block,
+                                           const Hash& block_hash)
+    : scheduler_{scheduler}, block_{std::move(block)}, block_hash_{block_hash}, senders_(block_->transactions.size()) {}
+
+void BlockPreverification::start(std::size_t senders_per_task) {
+    const auto& transactions{block_->transactions};
+    senders_per_task = std::max<std::size_t>(senders_per_task, 1);
+
+    // Recovery first, the senders being needed before the body status
+    std::scoped_lock lock{wait_mutex_};
+    senders_results_.reserve((transactions.size() + senders_per_task - 1) / senders_per_task);
+    for (std::size_t first{0}; first < transactions.size(); first += senders_per_task) {
+        const std::size_t last{std::min(first + senders_per_task, transactions.size())};
+        senders_results_.push_back(scheduler_.submit([self = shared_from_this(), first, last]() {
+            const auto& txns{self->block_->transactions};
+            std::vector<std::size_t> pending;
+            std::vector<SignerRecoveryInput> inputs;
+            for (std::size_t i{first}; i < last; ++i) {
+                if (is_special_signature(txns[i].r, txns[i].s)) {
+                    self->senders_[i] = decode_special_signature(txns[i].s);
+                    continue;
+                }
+                pending.push_back(i);
+                inputs.push_back(txns[i].signer_recovery_input());
+            }
+            std::vector<std::optional<evmc::address>> signers(inputs.size());
+            recover_signers(inputs, signers, /*cache=*/nullptr);
+            for (std::size_t j{0}; j < pending.size(); ++j) {
+                self->senders_[pending[j]] = signers[j];
+            }
+        }));
+    }
+    body_result_ = scheduler_.submit([self = shared_from_this()]() {
+        self->body_status_ = check_body(*self->block_);
+    });
+}
+
+bool BlockPreverification::is_ready() const {
+    const auto is_done = [](const std::future<void>& result) {
+        return !result.valid() || result.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    };
+    std::scoped_lock lock{wait_mutex_};
+    return is_done(body_result_) && std::all_of(senders_results_.cbegin(), senders_results_.cend(), is_done);
+}
+
+ValidationResult BlockPreverification::body_status() {
+    std::scoped_lock lock{wait_mutex_};
+    wait(body_result_);
+    return body_status_;
+}
+
+std::span<const std::optional<evmc::address>> BlockPreverification::senders() {
+    std::scoped_lock lock{wait_mutex_};
+    for (auto& result : senders_results_) {
+        wait(result);
+    }
+    return senders_;
+}
+
+void BlockPreverification::wait(std::future<void>& task_result) {
+    if (!task_result.valid()) return;  // already waited for
+    scheduler_.wait(task_result);
+    task_result.get();  // rethrow if the task failed
+}
+
+BlockPreverifier::BlockPreverifier(concurrency::TaskScheduler& scheduler, std::size_t max_blocks)
+    : scheduler_{scheduler}, max_blocks_{std::max<std::size_t>(max_blocks, 1)} {}
+
+std::shared_ptr<BlockPreverification> BlockPreverifier::start(std::shared_ptr<const Block> block, const Hash& block_hash) {
+    std::scoped_lock lock{mutex_};
+    const auto it = std::find_if(blocks_.cbegin(), blocks_.cend(), [&](const auto& b) { return b->block_hash() == block_hash; });
+    if (it != blocks_.cend()) {
+        return *it;
+    }
+    if (blocks_.size() == max_blocks_) {
+        blocks_.pop_front();  // its pending tasks keep it alive until done
+    }
+
+    auto preverification{std::make_shared<BlockPreverification>(scheduler_, std::move(block), block_hash)};
+    preverification->start(kSendersPerTask);
+    blocks_.push_back(preverification);
+    return preverification;
+}
+
+std::shared_ptr<BlockPreverification> BlockPreverifier::find(const Hash& block_hash) const {
+    std::scoped_lock lock{mutex_};
+    const auto it = std::find_if(blocks_.cbegin(), blocks_.cend(), [&](const auto& b) { return b->block_hash() == block_hash; });
+    return it != blocks_.cend() ? *it : nullptr;
+}
+
+std::size_t BlockPreverifier::size() const {
+    std::scoped_lock lock{mutex_};
+    return blocks_.size();
+}
+
+void BlockPreverifier::clear() {
+    std::scoped_lock lock{mutex_};
+    blocks_.clear();
+}
+
+}  // namespace silkworm::stagedsync
@@ -0,0 +1,115 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <evmc/evmc.hpp>
+
+#include <silkworm/core/protocol/validation.hpp>
+#include <silkworm/core/types/block.hpp>
+#include <silkworm/core/types/hash.hpp>
+#include <silkworm/infra/concurrency/task_scheduler.hpp>
+
+namespace silkworm::stagedsync {
+
+//! \brief The checks of a block which need no state (i.e. body against header and sender recovery), running as tasks
+//! of the scheduler from the arrival of the block while it is inserted and its chain is verified
+//! \details Senders are recovered in chunks of consecutive transactions scheduled in transaction order, so the first
+//! ones are available before the last ones are done. Bodies and Senders stages consume the outcome instead of redoing
+//! the checks and Execution takes the senders from here instead of the Senders table.
+//! \remarks Stages still run in sequence and Senders stage waits for all the chunks, so the recovery overlaps the
+//! insertion and the stages before Senders only: Execution never starts on the first chunks while the last ones are
+//! recovered, it just saves the reads of the Senders table
+class BlockPreverification : public std::enable_shared_from_this<BlockPreverification> {
+  public:
+    BlockPreverification(concurrency::TaskScheduler& scheduler, std::shared_ptr<const Block> block, const Hash& block_hash);
+
+    BlockPreverification(const BlockPreverification&) = delete;
+    BlockPreverification& operator=(const BlockPreverification&) = delete;
+
+    //! Schedule the tasks, each one keeping this object alive until done
+    void start(std::size_t senders_per_task);
+
+    [[nodiscard]] const Hash& block_hash() const { return block_hash_; }
+    [[nodiscard]] BlockNum block_num() const { return block_->header.number; }
+    [[nodiscard]] std::size_t transactions_count() const { return block_->transactions.size(); }
+
+    //! Whether all the tasks have completed
+    [[nodiscard]] bool is_ready() const;
+
+    //! The outcome of the checks of transactions root, ommers hash and withdrawals root against the header
+    ValidationResult body_status();
+
+    //! The senders of the transactions, std::nullopt for the ones whose signature is not recoverable
+    std::span<const std::optional<evmc::address>> senders();
+
+  private:
+    void wait(std::future<void>& task_result);
+
+    concurrency::TaskScheduler& scheduler_;
+    std::shared_ptr<const Block> block_;
+    Hash block_hash_;
+
+    ValidationResult body_status_{ValidationResult::kOk};
+    std::vector<std::optional<evmc::address>> senders_;
+
+    //! The mutex serializing the waits, std::future not being safe to share
+    mutable std::mutex wait_mutex_;
+    std::future<void> body_result_;
+    std::vector<std::future<void>> senders_results_;
+};
+
+//! \brief The registry of the blocks whose stateless checks have been started, bounded to the most recent ones
+class BlockPreverifier {
+  public:
+    static constexpr std::size_t kDefaultMaxBlocks{64};
+
+    //! The number of transactions whose senders are recovered by each task
+    static constexpr std::size_t kSendersPerTask{32};
+
+    explicit BlockPreverifier(concurrency::TaskScheduler& scheduler, std::size_t max_blocks = kDefaultMaxBlocks);
+
+    BlockPreverifier(const BlockPreverifier&) = delete;
+    BlockPreverifier& operator=(const BlockPreverifier&) = delete;
+
+    //! Start the checks of the block unless already started, forgetting the oldest block if full
+    std::shared_ptr<BlockPreverification> start(std::shared_ptr<const Block> block, const Hash& block_hash);
+
+    //! The checks of the block, if started and not forgotten yet
+    [[nodiscard]] std::shared_ptr<BlockPreverification> find(const Hash& block_hash) const;
+
+    [[nodiscard]] std::size_t size() const;
+
+    void clear();
+
+  private:
+    concurrency::TaskScheduler& scheduler_;
+    std::size_t max_blocks_;
+
+    mutable std::mutex mutex_;
+    std::deque<std::shared_ptr<BlockPreverification>> blocks_;  // oldest first, few enough to search linearly
+};
+
+}  // namespace silkworm::stagedsync
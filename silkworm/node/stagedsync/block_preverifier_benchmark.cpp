@@ -0,0 +1,134 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <intx/intx.hpp>
+
+#include <silkworm/core/common/util.hpp>
+#include <silkworm/core/crypto/signer_recovery.hpp>
+#include <silkworm/core/types/block.hpp>
+#include <silkworm/infra/common/log.hpp>
+#include <silkworm/node/stagedsync/block_preverifier.hpp>
+
+namespace silkworm::stagedsync {
+
+using evmc::literals::operator""_address;
+
+//! The number of payloads synthesized when none is given
+static constexpr std::size_t kSyntheticPayloads{32};
+
+//! The number of transactions in each synthesized payload
+static constexpr std::size_t kSyntheticTransactions{200};
+
+//! Payloads to replay read from the file in SILKWORM_BENCHMARK_PAYLOADS (one hex RLP-encoded block per line) if set,
+//! synthesized from the signed legacy transaction of the transaction tests otherwise
+static std::vector<std::shared_ptr<const Block>> load_payloads() {
+    std::vector<std::shared_ptr<const Block>> payloads;
+    if (const char* path{std::getenv("SILKWORM_BENCHMARK_PAYLOADS")}; path != nullptr) {
+        std::ifstream file{path};
+        for (std::string line; std::getline(file, line);) {
+            const auto encoded{from_hex(line)};
+            if (!encoded) continue;
+            ByteView view{*encoded};
+            auto block{std::make_shared<Block>()};
+            if (rlp::decode(view, *block)) {
+                payloads.push_back(std::move(block));
+            }
+        }
+        return payloads;
+    }
+
+    for (std::size_t n{0}; n < kSyntheticPayloads; ++n) {
+        auto block{std::make_shared<Block>()};
+        block->header.number = 17'000'000 + n;
+        for (std::size_t i{0}; i < kSyntheticTransactions; ++i) {
+            block->transactions.push_back(Transaction{
+                {.type = TransactionType::kLegacy,
+                 .chain_id = 1,
+                 .nonce = n * kSyntheticTransactions + i,
+                 .max_priority_fee_per_gas = 20000000000,
+                 .max_fee_per_gas = 20000000000,
+                 .gas_limit = 21000,
+                 .to = 0x727fc6a68321b754475c668a6abfb6e9e71c169a_address,
+                 .value = 10 * kEther},
+                true,
+                intx::from_string<intx::uint256>("0xbe67e0a07db67da8d446f76add590e54b6e92cb6b8f9835aeb67540579a27717"),
+                intx::from_string<intx::uint256>("0x2d690516512020171c1ec870f6ff45398cc8609250326be89915fb538e7bd718"),
+            });
+        }
+        block->header.transactions_root = protocol::compute_transaction_root(*block);
+        block->header.ommers_hash = protocol::compute_ommers_hash(*block);
+        payloads.push_back(std::move(block));
+    }
+    return payloads;
+}
+
+static void report_latency_percentiles(benchmark::State& state, std::vector<double>& latencies) {
+    if (latencies.empty()) return;
+    std::sort(latencies.begin(), latencies.end());
+    const auto percentile = [&](std::size_t p) { return latencies[(latencies.size() - 1) * p / 100]; };
+    state.counters["p50_us"] = percentile(50);
+    state.counters["p90_us"] = percentile(90);
+    state.counters["p99_us"] = percentile(99);
+}
+
+//! Latency of the stateless part of engine_newPayload for each replayed payload, checked serially on arrival (0) or
+//! as tasks of the scheduler started on arrival (1), the signer cache being cleared as in case of unseen transactions
+//! \remarks Only the checks themselves are measured, see benchmark_insert_and_verify for the end-to-end latency
+static void benchmark_payload_stateless_checks(benchmark::State& state) {
+    log::set_verbosity(log::Level::kNone);
+    const bool preverified{state.range(0) != 0};
+    const auto payloads{load_payloads()};
+
+    concurrency::TaskScheduler scheduler;
+    BlockPreverifier preverifier{scheduler, payloads.size() + 1};
+    std::vector<double> latencies;
+
+    for ([[maybe_unused]] auto _ : state) {
+        signer_cache().clear();
+        preverifier.clear();
+        for (const auto& payload : payloads) {
+            const auto start{std::chrono::steady_clock::now()};
+            if (preverified) {
+                const auto preverification{preverifier.start(payload, payload->header.hash())};
+                benchmark::DoNotOptimize(preverification->body_status());
+                benchmark::DoNotOptimize(preverification->senders().data());
+            } else {
+                Block block{*payload};
+                block.recover_senders();
+                benchmark::DoNotOptimize(protocol::compute_transaction_root(block) == block.header.transactions_root);
+                benchmark::DoNotOptimize(protocol::compute_ommers_hash(block) == block.header.ommers_hash);
+                benchmark::DoNotOptimize(protocol::compute_withdrawals_root(block) == block.header.withdrawals_root);
+            }
+            const std::chrono::duration<double, std::micro> latency{std::chrono::steady_clock::now() - start};
+            latencies.push_back(latency.count());
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * payloads.size()));
+    report_latency_percentiles(state, latencies);
+}
+
+BENCHMARK(benchmark_payload_stateless_checks)->Arg(0)->Arg(1)->UseRealTime();
+
+}  // namespace silkworm::stagedsync
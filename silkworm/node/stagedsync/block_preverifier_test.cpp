@@ -0,0 +1,153 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "block_preverifier.hpp"
+
+#include <memory>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <intx/intx.hpp>
+
+#include <silkworm/core/common/util.hpp>
+#include <silkworm/infra/test/log.hpp>
+
+namespace silkworm::stagedsync {
+
+using evmc::literals::operator""_address;
+
+//! A block of legacy transactions signed as the one in the Legacy Transaction RLP test, the nonce varying the sender
+static Block make_block(std::size_t transactions_count) {
+    Block block;
+    block.header.number = 17'000'000;
+    for (std::size_t i{0}; i < transactions_count; ++i) {
+        block.transactions.push_back(Transaction{
+            {.type = TransactionType::kLegacy,
+             .chain_id = 1,
+             .nonce = 12 + i,
+             .max_priority_fee_per_gas = 20000000000,
+             .max_fee_per_gas = 20000000000,
+             .gas_limit = 21000,
+             .to = 0x727fc6a68321b754475c668a6abfb6e9e71c169a_address,
+             .value = 10 * kEther},
+            true,
+            intx::from_string<intx::uint256>("0xbe67e0a07db67da8d446f76add590e54b6e92cb6b8f9835aeb67540579a27717"),
+            intx::from_string<intx::uint256>("0x2d690516512020171c1ec870f6ff45398cc8609250326be89915fb538e7bd718"),
+        });
+    }
+    block.header.transactions_root = protocol::compute_transaction_root(block);
+    block.header.ommers_hash = protocol::compute_ommers_hash(block);
+    return block;
+}
+
+TEST_CASE("BlockPreverification", "[silkworm][stagedsync][block_preverifier]") {
+    test::SetLogVerbosityGuard guard{log::Level::kNone};
+    concurrency::TaskScheduler scheduler{2};
+    auto block{make_block(100)};
+
+    SECTION("valid block") {
+        Block expected{block};
+        expected.recover_senders();
+
+        const auto preverification{std::make_shared<BlockPreverification>(
+            scheduler, std::make_shared<const Block>(block), Hash{uint64_t{1}})};
+        preverification->start(7);  // last task with fewer transactions
+        CHECK(preverification->transactions_count() == block.transactions.size());
+        CHECK(preverification->body_status() == ValidationResult::kOk);
+        const auto senders{preverification->senders()};
+        CHECK(preverification->is_ready());
+        REQUIRE(senders.size() == expected.transactions.size());
+        for (std::size_t i{0}; i < senders.size(); ++i) {
+            REQUIRE(senders[i]);
+            CHECK(senders[i] == expected.transactions[i].from);
+        }
+        CHECK(preverification->body_status() == ValidationResult::kOk);  // waiting again is fine
+    }
+
+    SECTION("wrong transactions root") {
+        block.header.transactions_root = kEmptyRoot;
+        const auto preverification{std::make_shared<BlockPreverification>(
+            scheduler, std::make_shared<const Block>(block), Hash{uint64_t{1}})};
+        preverification->start(BlockPreverifier::kSendersPerTask);
+        CHECK(preverification->body_status() == ValidationResult::kWrongTransactionsRoot);
+    }
+
+    SECTION("wrong ommers hash") {
+        block.header.ommers_hash = kEmptyRoot;
+        const auto preverification{std::make_shared<BlockPreverification>(
+            scheduler, std::make_shared<const Block>(block), Hash{uint64_t{1}})};
+        preverification->start(BlockPreverifier::kSendersPerTask);
+        CHECK(preverification->body_status() == ValidationResult::kWrongOmmersHash);
+    }
+
+    SECTION("unrecoverable signature") {
+        block.transactions[3].s = 0;
+        const auto preverification{std::make_shared<BlockPreverification>(
+            scheduler, std::make_shared<const Block>(block), Hash{uint64_t{1}})};
+        preverification->start(BlockPreverifier::kSendersPerTask);
+        const auto senders{preverification->senders()};
+        REQUIRE(senders.size() == block.transactions.size());
+        CHECK(!senders[3]);
+        CHECK(senders[4]);
+    }
+
+    SECTION("no transactions") {
+        const auto empty_block{make_block(0)};
+        const auto preverification{std::make_shared<BlockPreverification>(
+            scheduler, std::make_shared<const Block>(empty_block), Hash{uint64_t{1}})};
+        preverification->start(BlockPreverifier::kSendersPerTask);
+        CHECK(preverification->senders().empty());
+        CHECK(preverification->body_status() == ValidationResult::kOk);
+    }
+}
+
+TEST_CASE("BlockPreverifier", "[silkworm][stagedsync][block_preverifier]") {
+    test::SetLogVerbosityGuard guard{log::Level::kNone};
+    concurrency::TaskScheduler scheduler{2};
+    BlockPreverifier preverifier{scheduler, 2};
+    const auto block{std::make_shared<const Block>(make_block(10))};
+    const Hash hash1{uint64_t{1}}, hash2{uint64_t{2}}, hash3{uint64_t{3}};
+
+    SECTION("start once") {
+        const auto first{preverifier.start(block, hash1)};
+        const auto second{preverifier.start(block, hash1)};
+        CHECK(first == second);
+        CHECK(preverifier.size() == 1);
+        CHECK(preverifier.find(hash1) == first);
+        CHECK(preverifier.find(hash2) == nullptr);
+    }
+
+    SECTION("oldest forgotten") {
+        const auto first{preverifier.start(block, hash1)};
+        preverifier.start(block, hash2);
+        preverifier.start(block, hash3);
+        CHECK(preverifier.size() == 2);
+        CHECK(preverifier.find(hash1) == nullptr);
+        CHECK(preverifier.find(hash2) != nullptr);
+        CHECK(preverifier.find(hash3) != nullptr);
+        CHECK(first->body_status() == ValidationResult::kOk);  // still usable once forgotten
+        CHECK(first->senders().size() == 10);
+    }
+
+    SECTION("clear") {
+        preverifier.start(block, hash1);
+        preverifier.clear();
+        CHECK(preverifier.size() == 0);
+        CHECK(preverifier.find(hash1) == nullptr);
+    }
+}
+
+}  // namespace silkworm::stagedsync
@@ -22,6 +22,7 @@
 #include <silkworm/infra/common/ensure.hpp>
 #include <silkworm/node/db/access_layer.hpp>
 #include <silkworm/node/db/db_utils.hpp>
+#include <silkworm/node/stagedsync/block_preverifier.hpp>
 
 namespace silkworm::stagedsync {
 
@@ -73,6 +74,11 @@ bool ExecutionEngine::insert_block(const std::shared_ptr<Block> block) {
 
     if (block_progress_ < block->header.number) block_progress_ = block->header.number;
 
+    // when following the tip, start the stateless checks now so that they overlap insertion and chain verification
+    if (fork_tracking_active_ && node_settings_.block_preverifier) {
+        node_settings_.block_preverifier->start(block, header_hash);
+    }
+
     // if we are not tracking forks, just insert the block into the main chain
     if (!fork_tracking_active_) {
         main_chain_.insert_block(*block);  // BLOCKING
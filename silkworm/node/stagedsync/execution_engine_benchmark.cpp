@@ -0,0 +1,219 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <variant>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <intx/intx.hpp>
+#include <nlohmann/json.hpp>
+
+#include <silkworm/core/chain/config.hpp>
+#include <silkworm/core/chain/genesis.hpp>
+#include <silkworm/core/common/util.hpp>
+#include <silkworm/core/execution/processor.hpp>
+#include <silkworm/core/protocol/rule_set.hpp>
+#include <silkworm/core/protocol/validation.hpp>
+#include <silkworm/core/state/in_memory_state.hpp>
+#include <silkworm/core/trie/vector_root.hpp>
+#include <silkworm/core/types/block.hpp>
+#include <silkworm/core/types/bloom.hpp>
+#include <silkworm/core/types/receipt.hpp>
+#include <silkworm/infra/common/environment.hpp>
+#include <silkworm/infra/common/log.hpp>
+#include <silkworm/node/common/preverified_hashes.hpp>
+#include <silkworm/node/db/access_layer.hpp>
+#include <silkworm/node/db/stages.hpp>
+#include <silkworm/node/db/tables.hpp>
+#include <silkworm/node/db/util.hpp>
+#include <silkworm/node/stagedsync/block_preverifier.hpp>
+#include <silkworm/node/stagedsync/execution_engine.hpp>
+#include <silkworm/node/test/context.hpp>
+
+namespace silkworm::stagedsync {
+
+using evmc::literals::operator""_address;
+
+//! The number of blocks inserted and verified on top of the genesis
+static constexpr std::size_t kChainLength{32};
+
+//! The number of transactions in each block
+static constexpr std::size_t kTransactionsPerBlock{200};
+
+//! The signed legacy transaction of the transaction tests with varying nonces, i.e. valid signatures of distinct
+//! senders, recovered here to fund them
+static std::vector<Transaction> make_transactions() {
+    std::vector<Transaction> transactions;
+    transactions.reserve(kChainLength * kTransactionsPerBlock);
+    for (std::size_t nonce{0}; nonce < kChainLength * kTransactionsPerBlock; ++nonce) {
+        Transaction txn{
+            {.type = TransactionType::kLegacy,
+             .chain_id = kGoerliConfig.chain_id,
+             .nonce = nonce,
+             .max_priority_fee_per_gas = 20000000000,
+             .max_fee_per_gas = 20000000000,
+             .gas_limit = 21000,
+             .to = 0x727fc6a68321b754475c668a6abfb6e9e71c169a_address,
+             .value = 10 * kEther},
+            true,
+            intx::from_string<intx::uint256>("0xbe67e0a07db67da8d446f76add590e54b6e92cb6b8f9835aeb67540579a27717"),
+            intx::from_string<intx::uint256>("0x2d690516512020171c1ec870f6ff45398cc8609250326be89915fb538e7bd718"),
+        };
+        txn.recover_sender();
+        if (!txn.from) {
+            throw std::runtime_error("unrecoverable sender for nonce " + std::to_string(nonce));
+        }
+        transactions.push_back(std::move(txn));
+    }
+    return transactions;
+}
+
+//! A Goerli chain (i.e. Clique rules w/o block rewards nor base fee at its first blocks) on top of the genesis whose
+//! transactions are value transfers from funded senders, so that the whole
+//! pipeline accepts it: each sender is added to the genesis state with the nonce of its transaction and the header
+//! fields checked by Execution and InterHashes (gas used, receipts root, logs bloom, state root) are computed by
+//! executing the chain in memory beforehand
+static std::vector<std::shared_ptr<Block>> make_chain(const BlockHeader& genesis, db::RWTxn& txn) {
+    const auto& config{kGoerliConfig};
+    auto transactions{make_transactions()};
+
+    // Genesis allocations plus the funded senders, both in memory and in the plain state not hashed yet
+    InMemoryState state;
+    const auto genesis_json{nlohmann::json::parse(read_genesis_data(config.chain_id))};
+    for (const auto& item : genesis_json["alloc"].items()) {
+        const Account account{0, intx::from_string<intx::uint256>(item.value()["balance"].get<std::string>())};
+        state.update_account(to_evmc_address(*from_hex(item.key())), std::nullopt, account);
+    }
+    auto plain_state{db::open_cursor(txn, db::table::kPlainState)};
+    for (const auto& transaction : transactions) {
+        const Account sender{transaction.nonce, 100 * kEther};
+        state.update_account(*transaction.from, std::nullopt, sender);
+        const Bytes encoded{sender.encode_for_storage()};
+        plain_state.upsert(db::to_slice(*transaction.from), db::to_slice(encoded));
+    }
+
+    const auto rule_set{protocol::rule_set_factory(config)};
+    std::vector<std::shared_ptr<Block>> chain;
+    BlockHeader parent_header{genesis};
+    for (std::size_t n{0}; n < kChainLength; ++n) {
+        auto block{std::make_shared<Block>()};
+        block->header.number = parent_header.number + 1;
+        block->header.difficulty = 17'000'000'000 + block->header.number;
+        block->header.parent_hash = parent_header.hash();
+        block->header.beneficiary = 0xc8ebccc5f5689fa8659d83713341e5ad19349448_address;
+        block->header.gas_limit = 10'000'000;
+        block->header.timestamp = parent_header.timestamp + 12;
+        const auto first{transactions.begin() + static_cast<std::ptrdiff_t>(n * kTransactionsPerBlock)};
+        block->transactions.assign(first, first + static_cast<std::ptrdiff_t>(kTransactionsPerBlock));
+        block->header.transactions_root = protocol::compute_transaction_root(*block);
+        block->header.ommers_hash = protocol::compute_ommers_hash(*block);
+
+        ExecutionProcessor processor{*block, *rule_set, state, config, gas_prices_t{}};
+        std::vector<Receipt> receipts;
+        if (processor.execute_block_no_post_validation(receipts, evmone::gas_parameters{}) != ValidationResult::kOk) {
+            throw std::runtime_error("invalid block " + std::to_string(block->header.number));
+        }
+        processor.state().write_to_db(block->header.number);
+        block->header.gas_used = receipts.empty() ? 0 : receipts.back().cumulative_gas_used;
+        static constexpr auto kEncoder = [](Bytes& to, const Receipt& r) { rlp::encode(to, r); };
+        block->header.receipts_root = trie::root_hash(receipts, kEncoder);
+        for (const auto& receipt : receipts) {
+            join(block->header.logs_bloom, receipt.bloom);
+        }
+        block->header.state_root = state.state_root_hash();
+
+        // Senders are left to the pipeline (or to the checks started on insertion) as for blocks coming from the net
+        for (auto& transaction : block->transactions) {
+            transaction.from.reset();
+        }
+        parent_header = block->header;
+        chain.push_back(std::move(block));
+    }
+    return chain;
+}
+
+//! Latency of ExecutionEngine insert + verify (i.e. engine_newPayload) of each block of a chain followed at the tip,
+//! w/o (0) or w/ (1) the stateless checks started on insertion
+//! \remarks Verification stops before HistoryIndex: it covers Headers, BlockHashes, Bodies, Senders, Execution,
+//! HashState and InterHashes, i.e. the stages on the path of a payload status
+static void benchmark_insert_and_verify(benchmark::State& state) {
+    log::set_verbosity(log::Level::kNone);
+    const bool preverified{state.range(0) != 0};
+    PreverifiedHashes::current.clear();
+    Environment::set_stop_before_stage(db::stages::kHistoryIndexKey);
+
+    std::vector<double> latencies;
+    for ([[maybe_unused]] auto _ : state) {
+        state.PauseTiming();
+        test::Context context;
+        context.node_settings().chain_config = kGoerliConfig;
+        context.node_settings().chain_config->genesis_hash.emplace(kGoerliGenesisHash);
+        context.add_genesis_data();
+        const auto genesis{db::read_canonical_header(context.rw_txn(), 0)};
+        if (!genesis) {
+            state.SkipWithError("missing genesis");
+            break;
+        }
+        const auto chain{make_chain(*genesis, context.rw_txn())};
+        context.commit_txn();
+
+        concurrency::TaskScheduler scheduler;
+        BlockPreverifier preverifier{scheduler};
+        context.node_settings().task_scheduler = &scheduler;
+        context.node_settings().block_preverifier = preverified ? &preverifier : nullptr;
+
+        asio::io_context io;
+        db::RWAccess db_access{context.env()};
+        ExecutionEngine engine{io, context.node_settings(), db_access};
+        engine.open();
+
+        // The first fork choice makes the engine follow the tip, i.e. track forks and start checks on insertion
+        const Hash genesis_hash{genesis->hash()};
+        engine.notify_fork_choice_update(genesis_hash);
+        state.ResumeTiming();
+
+        for (const auto& block : chain) {
+            const Hash block_hash{block->header.hash()};
+            const auto start{std::chrono::steady_clock::now()};
+            engine.insert_block(block);
+            const auto verification{engine.verify_chain(block_hash).get()};
+            const std::chrono::duration<double, std::micro> latency{std::chrono::steady_clock::now() - start};
+            if (!std::holds_alternative<ValidChain>(verification)) {
+                state.SkipWithError("invalid chain");
+                break;
+            }
+            latencies.push_back(latency.count());
+            engine.notify_fork_choice_update(block_hash);
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kChainLength));
+    Environment::set_stop_before_stage("");  // i.e. none, not to affect the next benchmarks
+
+    if (latencies.empty()) return;
+    std::sort(latencies.begin(), latencies.end());
+    const auto percentile = [&](std::size_t p) { return latencies[(latencies.size() - 1) * p / 100]; };
+    state.counters["p50_us"] = percentile(50);
+    state.counters["p90_us"] = percentile(90);
+    state.counters["p99_us"] = percentile(99);
+}
+
+BENCHMARK(benchmark_insert_and_verify)->Arg(0)->Arg(1)->UseRealTime();
+
+}  // namespace silkworm::stagedsync
@@ -21,9 +21,12 @@
 
 #include <silkworm/infra/common/environment.hpp>
 #include <silkworm/node/stagedsync/stages/stage_blockhashes.hpp>
+#include <silkworm/node/stagedsync/stages/stage_bloom_bits.hpp>
 #include <silkworm/node/stagedsync/stages/stage_bodies.hpp>
+#include <silkworm/node/stagedsync/stages/stage_call_traces.hpp>
 #include <silkworm/node/stagedsync/stages/stage_execution.hpp>
 #include <silkworm/node/stagedsync/stages/stage_finish.hpp>
+#include <silkworm/node/stagedsync/stages/stage_freeze.hpp>
 #include <silkworm/node/stagedsync/stages/stage_hashstate.hpp>
 #include <silkworm/node/stagedsync/stages/stage_headers.hpp>
 #include <silkworm/node/stagedsync/stages/stage_history_index.hpp>
@@ -70,7 +73,9 @@ class ExecutionPipeline::LogTimer : public Timer {
 
 ExecutionPipeline::ExecutionPipeline(silkworm::NodeSettings* node_settings)
     : node_settings_{node_settings},
-      sync_context_{std::make_unique<SyncContext>()} {
+      sync_context_{std::make_unique<SyncContext>()},
+      state_root_{std::make_unique<trie::IncrementalStateRoot>()} {
+    sync_context_->state_root = state_root_.get();
     load_stages();
 }
 
@@ -104,8 +109,10 @@ std::optional<Hash> ExecutionPipeline::bad_block() {
  * 10 StageTrie -> stagedsync::InterHashes
  * 11 StageHistory -> stagedsync::HistoryIndex
  * 12 StageLogIndex -> stagedsync::LogIndex
- * 13 StageCallTraces -> TBD
+ * 13 StageCallTraces -> stagedsync::CallTraceIndex
+ *    (no Erigon counterpart) -> stagedsync::BloomBitsIndex
  * 14 StageTxLookup -> stagedsync::TxLookup
+ *    (no Erigon counterpart) -> stagedsync::Freeze
  * 15 StageFinish -> stagedsync::Finish
  */
 
@@ -128,8 +135,14 @@ void ExecutionPipeline::load_stages() {
                     std::make_unique<stagedsync::HistoryIndex>(node_settings_, sync_context_.get()));
     stages_.emplace(db::stages::kLogIndexKey,
                     std::make_unique<stagedsync::LogIndex>(node_settings_, sync_context_.get()));
+    stages_.emplace(db::stages::kCallTracesKey,
+                    std::make_unique<stagedsync::CallTraceIndex>(node_settings_, sync_context_.get()));
+    stages_.emplace(db::stages::kBloomBitsKey,
+                    std::make_unique<stagedsync::BloomBitsIndex>(node_settings_, sync_context_.get()));
     stages_.emplace(db::stages::kTxLookupKey,
                     std::make_unique<stagedsync::TxLookup>(node_settings_, sync_context_.get()));
+    stages_.emplace(db::stages::kFreezeKey,
+                    std::make_unique<stagedsync::Freeze>(node_settings_, sync_context_.get()));
     stages_.emplace(db::stages::kFinishKey,
                     std::make_unique<stagedsync::Finish>(node_settings_, sync_context_.get()));
     current_stage_ = stages_.begin();
@@ -145,14 +158,20 @@ void ExecutionPipeline::load_stages() {
                                      db::stages::kIntermediateHashesKey,
                                      db::stages::kHistoryIndexKey,
                                      db::stages::kLogIndexKey,
+                                     db::stages::kCallTracesKey,
+                                     db::stages::kBloomBitsKey,
                                      db::stages::kTxLookupKey,
+                                     db::stages::kFreezeKey,
                                      db::stages::kFinishKey,
                                  });
 
     stages_unwind_order_.insert(stages_unwind_order_.begin(),
                                 {
                                     db::stages::kFinishKey,
+                                    db::stages::kFreezeKey,
                                     db::stages::kTxLookupKey,
+                                    db::stages::kBloomBitsKey,
+                                    db::stages::kCallTracesKey,  // Needs to happen before unwinding Execution
                                     db::stages::kLogIndexKey,
                                     db::stages::kHistoryIndexKey,
                                     db::stages::kHashStateKey,           // Needs to happen before unwinding Execution
@@ -24,6 +24,7 @@
 #include <silkworm/infra/common/asio_timer.hpp>
 #include <silkworm/infra/common/stopwatch.hpp>
 #include <silkworm/node/stagedsync/stages/stage.hpp>
+#include <silkworm/node/stagedsync/stages/stage_interhashes/incremental_state_root.hpp>
 
 namespace silkworm::stagedsync {
 
@@ -45,7 +46,8 @@ class ExecutionPipeline : public Stoppable {
 
   private:
     silkworm::NodeSettings* node_settings_;
-    std::unique_ptr<SyncContext> sync_context_;  // context shared across stages
+    std::unique_ptr<SyncContext> sync_context_;               // context shared across stages
+    std::unique_ptr<trie::IncrementalStateRoot> state_root_;  // state changes taken from Execution for InterHashes
 
     using Stage_Container = std::map<const char*, std::unique_ptr<stagedsync::Stage>>;
     Stage_Container stages_;
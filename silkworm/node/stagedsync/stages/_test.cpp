@@ -483,6 +483,28 @@ TEST_CASE("Sync Stages") {
                 CHECK(account->balance == kEther);
                 CHECK(db::stages::read_stage_progress(txn, db::stages::kHashStateKey) == unwind_to);
             }
+
+            // Forward again from block 1 (i.e. from changesets) and check we're back to the same state
+            sync_context.unwind_point.reset();
+            actual_stage_result = magic_enum::enum_name<stagedsync::Stage::Result>(stage.forward(txn));
+            REQUIRE(expected_stage_result == actual_stage_result);
+            REQUIRE(db::stages::read_stage_progress(txn, db::stages::kHashStateKey) == 3);
+            hashed_accounts_table.bind(txn, db::table::kHashedAccounts);
+            REQUIRE(hashed_accounts_table.seek(db::to_slice(hashed_sender.bytes)));
+            {
+                auto account_encoded{db::from_slice(hashed_accounts_table.current().value)};
+                auto account{Account::from_encoded_storage(account_encoded)};
+                CHECK(account->nonce == 3);
+                CHECK(account->balance < kEther);
+            }
+            hashed_storage_table.bind(txn, db::table::kHashedStorage);
+            REQUIRE(hashed_storage_table.find(db::to_slice(storage_key)));
+            REQUIRE(hashed_storage_table.count_multivalue() == 2);
+            hashed_storage_table.to_current_first_multi();
+            db_val = hashed_storage_table.current().value;
+            REQUIRE(db_val.starts_with(db::to_slice(hashed_loc0.bytes)));
+            value = db::from_slice(db_val).substr(kHashLength);
+            CHECK(to_hex(value) == to_hex(zeroless_view(new_val)));
         }
     }
 }
@@ -30,6 +30,10 @@
 #include <silkworm/node/etl/collector.hpp>
 #include <silkworm/core/types/gas_prices.hpp>
 
+namespace silkworm::trie {
+class IncrementalStateRoot;
+}
+
 namespace silkworm::stagedsync {
 
 class StageError;
@@ -50,6 +54,10 @@ struct SyncContext {
     std::optional<BlockNum> previous_unwind_point;
 
     std::optional<evmc::bytes32> bad_block_hash;  // valued if we encountered a bad block
+
+    //! \brief Takes the state changes of the blocks as Execution runs them, so that InterHashes can compute the state
+    //! root in memory (if not null)
+    trie::IncrementalStateRoot* state_root{nullptr};
 };
 
 //! \brief Base Stage interface. All stages MUST inherit from this class and MUST override forward / unwind /
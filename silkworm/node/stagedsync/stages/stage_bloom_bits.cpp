@@ -0,0 +1,303 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "stage_bloom_bits.hpp"
+
+#include <magic_enum.hpp>
+
+#include <silkworm/core/common/endian.hpp>
+#include <silkworm/node/db/access_layer.hpp>
+
+namespace silkworm::stagedsync {
+
+using db::bloom_bits::kSectionSize;
+
+Stage::Result BloomBitsIndex::forward(db::RWTxn& txn) {
+    Stage::Result ret{Stage::Result::kSuccess};
+    operation_ = OperationType::Forward;
+    try {
+        throw_if_stopping();
+
+        // Check stage boundaries from previous execution and previous stage execution
+        const auto previous_progress{get_progress(txn)};
+        const auto target_progress{db::stages::read_stage_progress(txn, db::stages::kExecutionKey)};
+        if (previous_progress == target_progress) {
+            // Nothing to process
+            operation_ = OperationType::None;
+            return ret;
+        } else if (previous_progress > target_progress) {
+            // Something bad had happened.  Maybe we need to unwind ?
+            throw StageError(Stage::Result::kInvalidProgress,
+                             "BloomBits progress " + std::to_string(previous_progress) +
+                                 " greater than Execution progress " + std::to_string(target_progress));
+        }
+
+        // Sections already complete at previous progress have been written
+        uint64_t first_section{(previous_progress + 1) / kSectionSize};
+        const uint64_t end_section{(target_progress + 1) / kSectionSize};
+
+        // If this is first time we forward AND we have "prune receipts" set
+        // skip the sections whose logs are (partially) pruned
+        if (node_settings_->prune_mode->receipts().enabled() && !previous_progress) {
+            const auto threshold{node_settings_->prune_mode->receipts().value_from_head(target_progress)};
+            if (threshold) first_section = (threshold + kSectionSize) / kSectionSize;
+        }
+
+        reset_log_progress();
+        if (end_section > first_section + 1) {
+            log::Info(log_prefix_,
+                      {"op", std::string(magic_enum::enum_name<OperationType>(operation_)),
+                       "from", std::to_string(first_section * kSectionSize),
+                       "to", std::to_string(end_section * kSectionSize - 1),
+                       "sections", std::to_string(end_section - first_section)});
+        }
+
+        if (first_section < end_section)
+            forward_impl(txn, first_section, end_section);
+
+        reset_log_progress();
+        update_progress(txn, target_progress);
+        txn.commit();
+
+    } catch (const StageError& ex) {
+        log::Error(log_prefix_,
+                   {"function", std::string(__FUNCTION__), "exception", std::string(ex.what())});
+        ret = static_cast<Stage::Result>(ex.err());
+    } catch (const mdbx::exception& ex) {
+        log::Error(log_prefix_,
+                   {"function", std::string(__FUNCTION__), "exception", std::string(ex.what())});
+        ret = Stage::Result::kDbError;
+    } catch (const std::exception& ex) {
+        log::Error(log_prefix_,
+                   {"function", std::string(__FUNCTION__), "exception", std::string(ex.what())});
+        ret = Stage::Result::kUnexpectedError;
+    } catch (...) {
+        log::Error(log_prefix_,
+                   {"function", std::string(__FUNCTION__), "exception", "unexpected and undefined"});
+        ret = Stage::Result::kUnexpectedError;
+    }
+
+    operation_ = OperationType::None;
+    return ret;
+}
+
+Stage::Result BloomBitsIndex::unwind(db::RWTxn& txn) {
+    Stage::Result ret{Stage::Result::kSuccess};
+
+    if (!sync_context_->unwind_point.has_value()) return ret;
+    const BlockNum to{sync_context_->unwind_point.value()};
+
+    operation_ = OperationType::Unwind;
+    try {
+        throw_if_stopping();
+
+        // Check stage boundaries from previous execution and previous stage execution
+        const auto previous_progress{get_progress(txn)};
+        const auto execution_stage_progress{db::stages::read_stage_progress(txn, db::stages::kExecutionKey)};
+        if (previous_progress <= to || execution_stage_progress <= to) {
+            // Nothing to process
+            operation_ = OperationType::None;
+            return ret;
+        }
+
+        // Any section including blocks above the unwind point is no longer valid
+        const uint64_t first_section{(to + 1) / kSectionSize};
+        if ((previous_progress + 1) / kSectionSize > first_section) {
+            reset_log_progress();
+            unwind_impl(txn, first_section);
+        }
+
+        reset_log_progress();
+        update_progress(txn, to);
+        txn.commit();
+
+    } catch (const StageError& ex) {
+        log::Error(log_prefix_,
+                   {"function", std::string(__FUNCTION__), "exception", std::string(ex.what())});
+        ret = static_cast<Stage::Result>(ex.err());
+    } catch (const mdbx::exception& ex) {
+        log::Error(log_prefix_,
+                   {"function", std::string(__FUNCTION__), "exception", std::string(ex.what())});
+        ret = Stage::Result::kDbError;
+    } catch (const std::exception& ex) {
+        log::Error(log_prefix_,
+                   {"function", std::string(__FUNCTION__), "exception", std::string(ex.what())});
+        ret = Stage::Result::kUnexpectedError;
+    } catch (...) {
+        log::Error(log_prefix_,
+                   {"function", std::string(__FUNCTION__), "exception", "unexpected and undefined"});
+        ret = Stage::Result::kUnexpectedError;
+    }
+
+    operation_ = OperationType::None;
+    return ret;
+}
+
+void BloomBitsIndex::forward_impl(db::RWTxn& txn, uint64_t first_section, uint64_t end_section) {
+    using namespace std::chrono_literals;
+    auto log_time{std::chrono::steady_clock::now()};
+
+    std::unique_lock log_lck(sl_mutex_);
+    current_target_ = db::table::kBloomBits.name;
+    current_key_.clear();
+    log_lck.unlock();
+
+    // 2048 vectors of 512 bytes each: keep them off the stack
+    auto generator{std::make_unique<db::bloom_bits::Generator>()};
+
+    // Only the address and the topics of each log are added to the bloom of its block (see logs_bloom)
+    Bloom bloom{};
+    LogsBloomListener listener{bloom};
+
+    auto source = txn.ro_cursor(db::table::kLogs);
+    auto source_data{source->lower_bound(db::to_slice(db::block_key(first_section * kSectionSize)), false)};
+    for (uint64_t section{first_section}; section < end_section; ++section) {
+        const BlockNum section_start{section * kSectionSize};
+        generator->reset();
+        while (source_data) {
+            const auto reached_block_number{endian::load_big_u64(static_cast<uint8_t*>(source_data.key.data()))};
+            if (reached_block_number >= section_start + kSectionSize) break;
+
+            // Decode CBOR value content of the transaction logs into the block bloom
+            bloom.fill(0);
+            listener.reset();
+            cbor::input input(source_data.value.data(), static_cast<int>(source_data.value.length()));
+            cbor::decoder decoder(input, listener);
+            decoder.run();
+            generator->add_bloom(reached_block_number - section_start, bloom);
+
+            source_data = source->to_next(/*throw_notfound=*/false);
+        }
+
+        write_section(txn, section, *generator);
+
+        // Log and abort check
+        if (const auto now{std::chrono::steady_clock::now()}; log_time <= now) {
+            throw_if_stopping();
+            log_lck.lock();
+            current_key_ = std::to_string(section);
+            log_lck.unlock();
+            log_time = now + 5s;
+        }
+    }
+}
+
+void BloomBitsIndex::LogsBloomListener::on_array(int size) {
+    switch (state_) {
+        case State::kWaitLogs:
+            state_ = State::kWaitLog;
+            break;
+        case State::kWaitLog:
+            if (size != 3) unexpected();
+            state_ = State::kWaitAddress;
+            break;
+        case State::kWaitTopics:
+            if (size < 0) unexpected();
+            pending_topics_ = size;
+            state_ = size > 0 ? State::kWaitTopic : State::kWaitData;
+            break;
+        default:
+            unexpected();
+    }
+}
+
+void BloomBitsIndex::LogsBloomListener::on_bytes(unsigned char* data, int size) {
+    switch (state_) {
+        case State::kWaitAddress:
+            if (size != static_cast<int>(kAddressLength)) unexpected();
+            m3_2048(bloom_, ByteView{data, kAddressLength});
+            state_ = State::kWaitTopics;
+            break;
+        case State::kWaitTopic:
+            if (size != static_cast<int>(kHashLength)) unexpected();
+            m3_2048(bloom_, ByteView{data, kHashLength});
+            if (--pending_topics_ == 0) state_ = State::kWaitData;
+            break;
+        case State::kWaitData:
+            state_ = State::kWaitLog;
+            break;
+        default:
+            unexpected();
+    }
+}
+
+void BloomBitsIndex::LogsBloomListener::on_null() {
+    if (state_ != State::kWaitData) unexpected();
+    state_ = State::kWaitLog;
+}
+
+void BloomBitsIndex::write_section(db::RWTxn& txn, uint64_t section, const db::bloom_bits::Generator& generator) {
+    const BlockNum last_block{(section + 1) * kSectionSize - 1};
+    const auto last_hash{db::read_canonical_hash(txn, last_block)};
+    if (!last_hash) {
+        throw StageError(Stage::Result::kBadChainSequence,
+                         "Canonical hash at height " + std::to_string(last_block) + " not found");
+    }
+
+    auto target = txn.rw_cursor(db::table::kBloomBits);
+    for (uint16_t bit{0}; bit < db::bloom_bits::kBloomBitLength; ++bit) {
+        const Bytes vector{db::bloom_bits::compress(generator.vector(bit))};
+        target->upsert(db::to_slice(db::bloom_bits::key(bit, section)), db::to_slice(vector));
+    }
+
+    auto index = txn.rw_cursor(db::table::kBloomBitsIndex);
+    index->upsert(db::to_slice(db::bloom_bits::section_key(section)), db::to_slice(*last_hash));
+}
+
+void BloomBitsIndex::unwind_impl(db::RWTxn& txn, uint64_t first_section) {
+    std::unique_lock log_lck(sl_mutex_);
+    current_target_ = db::table::kBloomBitsIndex.name;
+    current_key_ = std::to_string(first_section);
+    log_lck.unlock();
+
+    auto index = txn.rw_cursor(db::table::kBloomBitsIndex);
+    db::cursor_erase(*index, db::bloom_bits::section_key(first_section), db::CursorMoveDirection::Forward);
+
+    log_lck.lock();
+    current_target_ = db::table::kBloomBits.name;
+    log_lck.unlock();
+
+    // Vectors are keyed by bit first: erase the tail of sections of each bit
+    auto target = txn.rw_cursor(db::table::kBloomBits);
+    for (uint16_t bit{0}; bit < db::bloom_bits::kBloomBitLength; ++bit) {
+        const Bytes start_key{db::bloom_bits::key(bit, first_section)};
+        const ByteView bit_prefix{start_key.data(), sizeof(uint16_t)};
+        auto data{target->lower_bound(db::to_slice(start_key), /*throw_notfound=*/false)};
+        while (data && db::from_slice(data.key).starts_with(bit_prefix)) {
+            target->erase();
+            data = target->to_next(/*throw_notfound=*/false);
+        }
+    }
+}
+
+std::vector<std::string> BloomBitsIndex::get_log_progress() {
+    std::vector<std::string> ret{"op", std::string(magic_enum::enum_name<OperationType>(operation_))};
+    std::unique_lock log_lck(sl_mutex_);
+    if (current_target_.empty()) {
+        ret.insert(ret.end(), {"db", "waiting ..."});
+    } else {
+        ret.insert(ret.end(), {"to", current_target_, "section", current_key_});
+    }
+    return ret;
+}
+
+void BloomBitsIndex::reset_log_progress() {
+    std::unique_lock log_lck(sl_mutex_);
+    current_target_.clear();
+    current_key_.clear();
+}
+
+}  // namespace silkworm::stagedsync
@@ -0,0 +1,102 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <stdexcept>
+
+#include <cbor/cbor.h>
+
+#include <silkworm/core/types/bloom.hpp>
+#include <silkworm/node/db/bloom_bits.hpp>
+#include <silkworm/node/stagedsync/stages/stage.hpp>
+
+namespace silkworm::stagedsync {
+
+//! \brief Builds the BloomBits and BloomBitsIndex tables, section by section, out of the logs collected by Execution
+//! \remarks Only complete sections are written: blocks of the trailing partial section are picked up again once
+//! the section is complete. Blooms are computed from the stored logs rather than read from block headers
+class BloomBitsIndex : public Stage {
+  public:
+    explicit BloomBitsIndex(NodeSettings* node_settings, SyncContext* sync_context)
+        : Stage(sync_context, db::stages::kBloomBitsKey, node_settings){};
+    ~BloomBitsIndex() override = default;
+
+    Stage::Result forward(db::RWTxn& txn) final;
+    Stage::Result unwind(db::RWTxn& txn) final;
+    Stage::Result prune(db::RWTxn&) final { return Stage::Result::kSuccess; };
+    std::vector<std::string> get_log_progress() final;
+
+    //! \brief Decoder of CBOR encoded logs adding only addresses and topics (not data) to a bloom, as Geth does
+    class LogsBloomListener : public cbor::listener {
+      public:
+        explicit LogsBloomListener(Bloom& bloom) : bloom_{bloom} {}
+
+        //! \brief Prepares the listener for the next CBOR encoded list of logs
+        void reset() { state_ = State::kWaitLogs; }
+
+        void on_array(int size) override;
+        void on_bytes(unsigned char* data, int size) override;
+        void on_null() override;
+
+        void on_integer(int) override { unexpected(); }
+        void on_string(std::string&) override { unexpected(); }
+        void on_map(int) override { unexpected(); }
+        void on_tag(unsigned int) override { unexpected(); }
+        void on_special(unsigned int) override { unexpected(); }
+        void on_bool(bool) override { unexpected(); }
+        void on_undefined() override { unexpected(); }
+        void on_error(const char*) override { unexpected(); }
+        void on_extra_integer(unsigned long long, int) override { unexpected(); }
+        void on_extra_tag(unsigned long long) override { unexpected(); }
+        void on_extra_special(unsigned long long) override { unexpected(); }
+        void on_double(double) override { unexpected(); }
+        void on_float32(float) override { unexpected(); }
+
+      private:
+        enum class State {
+            kWaitLogs,
+            kWaitLog,
+            kWaitAddress,
+            kWaitTopics,
+            kWaitTopic,
+            kWaitData,
+        };
+
+        [[noreturn]] static void unexpected() { throw std::runtime_error("Unexpected CBOR decoding error"); }
+
+        Bloom& bloom_;
+        State state_{State::kWaitLogs};
+        int pending_topics_{0};
+    };
+
+  private:
+    std::string current_target_;  // Current target of transformed data
+    std::string current_key_;     // Actual processing key
+
+    //! \brief Writes sections [first_section, end_section)
+    void forward_impl(db::RWTxn& txn, uint64_t first_section, uint64_t end_section);
+
+    //! \brief Erases all sections starting from first_section
+    void unwind_impl(db::RWTxn& txn, uint64_t first_section);
+
+    //! \brief Writes the bit vectors of a complete section and marks it as indexed
+    void write_section(db::RWTxn& txn, uint64_t section, const db::bloom_bits::Generator& generator);
+
+    void reset_log_progress();  // Clears out all logging vars
+};
+
+}  // namespace silkworm::stagedsync
@@ -0,0 +1,117 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <algorithm>
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/infra/test/log.hpp>
+#include <silkworm/node/db/access_layer.hpp>
+#include <silkworm/node/db/bloom_bits.hpp>
+#include <silkworm/node/db/stages.hpp>
+#include <silkworm/node/stagedsync/stages/stage_bloom_bits.hpp>
+#include <silkworm/node/test/context.hpp>
+#include <silkworm/node/types/log_cbor.hpp>
+
+using namespace evmc::literals;
+
+namespace silkworm {
+
+using db::bloom_bits::kSectionSize;
+
+static std::optional<db::bloom_bits::BitVector> read_vector(db::RWTxn& txn, uint16_t bit, uint64_t section) {
+    auto cursor = txn.ro_cursor(db::table::kBloomBits);
+    const auto data{cursor->find(db::to_slice(db::bloom_bits::key(bit, section)), /*throw_notfound=*/false)};
+    if (!data) return std::nullopt;
+    return db::bloom_bits::decompress(db::from_slice(data.value));
+}
+
+static bool is_section_indexed(db::RWTxn& txn, uint64_t section) {
+    auto cursor = txn.ro_cursor(db::table::kBloomBitsIndex);
+    return cursor->seek(db::to_slice(db::bloom_bits::section_key(section)));
+}
+
+TEST_CASE("Stage Bloom Bits") {
+    test::SetLogVerbosityGuard log_guard{log::Level::kNone};
+    test::Context context;
+    db::RWTxn& txn{context.rw_txn()};
+    txn.disable_commit();
+
+    const auto address{0x5a0b54d5dc17e0aadc383d2db43b0a0d3e029c4c_address};
+    const auto topic{0xddf252ad1be2c89b69c2b068fc378daa952ba7f163c4a11628f55a4df523b3ef_bytes32};
+    const auto data_word{0x000000000000000000000000d8da6bf26964af9d7eed9e03e53415d37aa96045_bytes32};
+
+    // Logs in block 5 (section 0) and in block kSectionSize + 3 (section 1)
+    auto logs = txn.rw_cursor(db::table::kLogs);
+    const std::vector<Log> logs5{Log{.address = address, .topics = {topic}, .data = Bytes{data_word.bytes, kHashLength}}};
+    logs->upsert(db::to_slice(db::log_key(5, 0)), db::to_slice(cbor_encode(logs5)));
+    const std::vector<Log> logs4099{Log{.address = address}};
+    logs->upsert(db::to_slice(db::log_key(kSectionSize + 3, 1)), db::to_slice(cbor_encode(logs4099)));
+    db::write_canonical_hash(txn, kSectionSize - 1, 0x01_bytes32);
+    db::write_canonical_hash(txn, 2 * kSectionSize - 1, 0x02_bytes32);
+
+    stagedsync::SyncContext sync_context{};
+    stagedsync::BloomBitsIndex stage_bloom_bits(&context.node_settings(), &sync_context);
+
+    const auto address_bits{db::bloom_bits::bloom_bit_indices(address)};
+    const auto topic_bits{db::bloom_bits::bloom_bit_indices(topic)};
+    const auto data_bits{db::bloom_bits::bloom_bit_indices(data_word)};
+
+    // Only section 0 is complete
+    db::stages::write_stage_progress(txn, db::stages::kExecutionKey, kSectionSize + 10);
+    REQUIRE(stage_bloom_bits.forward(txn) == stagedsync::Stage::Result::kSuccess);
+    REQUIRE(db::stages::read_stage_progress(txn, db::stages::kBloomBitsKey) == kSectionSize + 10);
+    CHECK(is_section_indexed(txn, 0));
+    CHECK(!is_section_indexed(txn, 1));
+    for (const auto bit : address_bits) {
+        const auto vector{read_vector(txn, bit, 0)};
+        REQUIRE(vector);
+        CHECK(vector->test(5));
+        CHECK(!vector->test(4));
+    }
+    for (const auto bit : topic_bits) {
+        const auto vector{read_vector(txn, bit, 0)};
+        REQUIRE(vector);
+        CHECK(vector->test(5));
+    }
+    // Log data is not part of the bloom
+    CHECK(!std::all_of(data_bits.begin(), data_bits.end(), [&](const auto bit) {
+        const auto vector{read_vector(txn, bit, 0)};
+        return vector && vector->test(5);
+    }));
+    CHECK(!read_vector(txn, address_bits[0], 1));
+
+    // Section 1 gets completed
+    db::stages::write_stage_progress(txn, db::stages::kExecutionKey, 2 * kSectionSize - 1);
+    REQUIRE(stage_bloom_bits.forward(txn) == stagedsync::Stage::Result::kSuccess);
+    CHECK(is_section_indexed(txn, 1));
+    for (const auto bit : address_bits) {
+        const auto vector{read_vector(txn, bit, 1)};
+        REQUIRE(vector);
+        CHECK(vector->test(3));
+    }
+
+    // Unwinding into section 1 drops it
+    sync_context.unwind_point.emplace(kSectionSize + 10);
+    REQUIRE(stage_bloom_bits.unwind(txn) == stagedsync::Stage::Result::kSuccess);
+    REQUIRE(db::stages::read_stage_progress(txn, db::stages::kBloomBitsKey) == kSectionSize + 10);
+    CHECK(is_section_indexed(txn, 0));
+    CHECK(!is_section_indexed(txn, 1));
+    CHECK(read_vector(txn, address_bits[0], 0));
+    CHECK(!read_vector(txn, address_bits[0], 1));
+}
+
+}  // namespace silkworm
@@ -24,6 +24,7 @@
 #include <silkworm/node/common/preverified_hashes.hpp>
 #include <silkworm/node/db/access_layer.hpp>
 #include <silkworm/node/db/stages.hpp>
+#include <silkworm/node/stagedsync/block_preverifier.hpp>
 
 namespace silkworm::stagedsync {
 
@@ -43,6 +44,7 @@ bool BodiesStage::BodyDataModel::unwind_needed() const { return unwind_needed_;
 BlockNum BodiesStage::BodyDataModel::unwind_point() const { return unwind_point_; }
 Hash BodiesStage::BodyDataModel::bad_block() const { return bad_block_; }
 void BodiesStage::BodyDataModel::set_preverified_height(BlockNum height) { preverified_height_ = height; }
+void BodiesStage::BodyDataModel::set_block_preverifier(BlockPreverifier* preverifier) { block_preverifier_ = preverifier; }
 
 // update_tables has the responsibility to update all tables related with the block that is passed as parameter
 // Right now there is no table that need to be updated but the name of the method is retained because it makes a pair
@@ -58,9 +60,17 @@ void BodiesStage::BodyDataModel::update_tables(const Block& block, const evmone:
         // Here we skip a full body pre-validation like
         // validation_result = rule_set_->pre_validate_block_body(block, chain_state_);
         // because we assume that the sync (BlockExchange) has already checked transaction & ommers root hash
+        // (or that they have been checked on block arrival, see BlockPreverifier)
+        if (block_preverifier_ && chain_config_.protocol_rule_set != protocol::RuleSetType::kTrust) {
+            if (const auto preverification{block_preverifier_->find(block_hash)}) {
+                validation_result = preverification->body_status();
+            }
+        }
 
-        auto eos_evm_version = chain_config_.eos_evm_version(block.header);
-        validation_result = protocol::pre_validate_transactions(block, chain_config_, eos_evm_version, gas_params);
+        if (validation_result == ValidationResult::kOk) {
+            auto eos_evm_version = chain_config_.eos_evm_version(block.header);
+            validation_result = protocol::pre_validate_transactions(block, chain_config_, eos_evm_version, gas_params);
+        }
         if (validation_result == ValidationResult::kOk) {
             validation_result = rule_set_->validate_ommers(block, chain_state_);
         }
@@ -114,6 +124,7 @@ Stage::Result BodiesStage::forward(db::RWTxn& tx) {
 
         BodyDataModel body_persistence(tx, current_height_, node_settings_->chain_config.value());
         body_persistence.set_preverified_height(PreverifiedHashes::current.height);
+        body_persistence.set_block_preverifier(node_settings_->block_preverifier);
 
         get_log_progress();  // this is a trick to set log progress initial value, please improve
         RepeatedMeasure<BlockNum> height_progress(current_height_);
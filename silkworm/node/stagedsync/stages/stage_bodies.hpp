@@ -25,6 +25,8 @@
 
 namespace silkworm::stagedsync {
 
+class BlockPreverifier;
+
 class BodiesStage : public Stage {
   public:
     BodiesStage(NodeSettings*, SyncContext*);
@@ -63,6 +65,7 @@ class BodiesStage : public Stage {
         bool get_canonical_block(BlockNum height, Block& block) const;
 
         void set_preverified_height(BlockNum height);
+        void set_block_preverifier(BlockPreverifier* preverifier);
 
       private:
         db::RWTxn& tx_;
@@ -75,6 +78,7 @@ class BodiesStage : public Stage {
         BlockNum highest_height_{0};
 
         BlockNum preverified_height_{0};
+        BlockPreverifier* block_preverifier_{nullptr};
 
         BlockNum unwind_point_{0};
         bool unwind_needed_{false};
@@ -0,0 +1,61 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <silkworm/node/db/bitmap.hpp>
+#include <silkworm/node/stagedsync/stages/stage.hpp>
+
+namespace silkworm::stagedsync {
+
+//! \brief Builds the CallFromIndex and CallToIndex bitmaps out of the call traces collected by Execution
+class CallTraceIndex : public Stage {
+  public:
+    explicit CallTraceIndex(NodeSettings* node_settings, SyncContext* sync_context)
+        : Stage(sync_context, db::stages::kCallTracesKey, node_settings){};
+    ~CallTraceIndex() override = default;
+
+    Stage::Result forward(db::RWTxn& txn) final;
+    Stage::Result unwind(db::RWTxn& txn) final;
+    Stage::Result prune(db::RWTxn& txn) final;
+    std::vector<std::string> get_log_progress() final;
+
+  private:
+    std::unique_ptr<etl::Collector> from_collector_{nullptr};
+    std::unique_ptr<etl::Collector> to_collector_{nullptr};
+    std::unique_ptr<db::bitmap::IndexLoader> index_loader_{nullptr};
+
+    std::atomic_bool loading_{false};  // Whether we're in ETL loading phase
+    std::string current_source_;       // Current source of data
+    std::string current_target_;       // Current target of transformed data
+    std::string current_key_;          // Actual processing key
+
+    void forward_impl(db::RWTxn& txn, BlockNum from, BlockNum to);
+    void unwind_impl(db::RWTxn& txn, BlockNum from, BlockNum to);
+    void prune_impl(db::RWTxn& txn, BlockNum threshold, const db::MapConfig& target);
+
+    //! \brief Collects bitmaps of block numbers for each call sender and recipient
+    void collect_bitmaps_from_call_traces(db::RWTxn& txn, BlockNum from, BlockNum to);
+
+    //! \brief Collects unique senders and recipients of call traces within provided boundaries
+    void collect_unique_keys_from_call_traces(db::RWTxn& txn, BlockNum from, BlockNum to,
+                                              std::map<Bytes, bool>& from_keys,
+                                              std::map<Bytes, bool>& to_keys);
+
+    void reset_log_progress();  // Clears out all logging vars
+};
+
+}  // namespace silkworm::stagedsync
@@ -0,0 +1,80 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <catch2/catch.hpp>
+
+#include <silkworm/core/execution/call_tracer.hpp>
+#include <silkworm/infra/test/log.hpp>
+#include <silkworm/node/db/bitmap.hpp>
+#include <silkworm/node/db/buffer.hpp>
+#include <silkworm/node/db/stages.hpp>
+#include <silkworm/node/stagedsync/stages/stage_call_traces.hpp>
+#include <silkworm/node/test/context.hpp>
+
+using namespace evmc::literals;
+
+namespace silkworm {
+
+static std::string read_bitmap(db::RWTxn& txn, const db::MapConfig& table, const evmc::address& address) {
+    db::PooledCursor index(txn, table);
+    auto data{index.lower_bound(db::to_slice(address), /*throw_notfound=*/false)};
+    if (!data || !db::from_slice(data.key).starts_with(ByteView{address.bytes, kAddressLength})) {
+        return "{}";
+    }
+    return db::bitmap::parse(data.value).toString();
+}
+
+TEST_CASE("Stage Call Traces") {
+    test::SetLogVerbosityGuard log_guard{log::Level::kNone};
+    test::Context context;
+    db::RWTxn& txn{context.rw_txn()};
+    txn.disable_commit();
+
+    const auto sender{0xb685342b8c54347aad148e1f22eff3eb3eb29391_address};
+    const auto contract{0x5a0b54d5dc17e0aadc383d2db43b0a0d3e029c4c_address};
+    const auto callee{0x000000000000000000000000000000000000dead_address};
+
+    // Block 1 deploys the contract, blocks 2 and 3 call it and block 3 makes it call the callee
+    db::Buffer buffer{txn, 0};
+    buffer.insert_call_traces(1, CallTraces{.senders = {sender}, .recipients = {contract}});
+    buffer.insert_call_traces(2, CallTraces{.senders = {sender}, .recipients = {contract}});
+    buffer.insert_call_traces(3, CallTraces{.senders = {sender, contract}, .recipients = {contract, callee}});
+    buffer.write_to_db();
+    db::stages::write_stage_progress(txn, db::stages::kExecutionKey, 3);
+
+    stagedsync::SyncContext sync_context{};
+    stagedsync::CallTraceIndex stage_call_traces(&context.node_settings(), &sync_context);
+    REQUIRE(stage_call_traces.forward(txn) == stagedsync::Stage::Result::kSuccess);
+    REQUIRE(db::stages::read_stage_progress(txn, db::stages::kCallTracesKey) == 3);
+
+    CHECK(read_bitmap(txn, db::table::kCallFromIndex, sender) == "{1,2,3}");
+    CHECK(read_bitmap(txn, db::table::kCallFromIndex, contract) == "{3}");
+    CHECK(read_bitmap(txn, db::table::kCallFromIndex, callee) == "{}");
+    CHECK(read_bitmap(txn, db::table::kCallToIndex, sender) == "{}");
+    CHECK(read_bitmap(txn, db::table::kCallToIndex, contract) == "{1,2,3}");
+    CHECK(read_bitmap(txn, db::table::kCallToIndex, callee) == "{3}");
+
+    sync_context.unwind_point.emplace(2);
+    REQUIRE(stage_call_traces.unwind(txn) == stagedsync::Stage::Result::kSuccess);
+    REQUIRE(db::stages::read_stage_progress(txn, db::stages::kCallTracesKey) == 2);
+
+    CHECK(read_bitmap(txn, db::table::kCallFromIndex, sender) == "{1,2}");
+    CHECK(read_bitmap(txn, db::table::kCallFromIndex, contract) == "{}");
+    CHECK(read_bitmap(txn, db::table::kCallToIndex, contract) == "{1,2}");
+    CHECK(read_bitmap(txn, db::table::kCallToIndex, callee) == "{}");
+}
+
+}  // namespace silkworm
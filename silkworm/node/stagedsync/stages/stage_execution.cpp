@@ -16,20 +16,40 @@
 
 #include "stage_execution.hpp"
 
+#include <algorithm>
 #include <span>
 #include <stdexcept>
 
 #include <magic_enum.hpp>
 
 #include <silkworm/core/common/endian.hpp>
+#include <silkworm/core/execution/call_tracer.hpp>
 #include <silkworm/core/execution/processor.hpp>
 #include <silkworm/infra/common/decoding_exception.hpp>
 #include <silkworm/infra/common/stopwatch.hpp>
+#include <silkworm/infra/metrics/registry.hpp>
 #include <silkworm/node/db/access_layer.hpp>
 #include <silkworm/node/db/buffer.hpp>
+#include <silkworm/node/stagedsync/block_preverifier.hpp>
+#include <silkworm/node/stagedsync/stages/stage_interhashes/incremental_state_root.hpp>
 
 namespace silkworm::stagedsync {
 
+//! Execution throughput, rates are derived by the metrics backend
+struct ExecutionMetrics {
+    metrics::Counter& blocks{metrics::default_registry().counter(
+        "silkworm_execution_blocks_total", "Blocks executed by the Execution stage")};
+    metrics::Counter& transactions{metrics::default_registry().counter(
+        "silkworm_execution_transactions_total", "Transactions executed by the Execution stage")};
+    metrics::Counter& gas{metrics::default_registry().counter(
+        "silkworm_execution_gas_total", "Gas used by the blocks executed by the Execution stage")};
+};
+
+static ExecutionMetrics& execution_metrics() {
+    static ExecutionMetrics execution_metrics;
+    return execution_metrics;
+}
+
 Stage::Result Execution::forward(db::RWTxn& txn) {
     Stage::Result ret{Stage::Result::kSuccess};
     operation_ = OperationType::Forward;
@@ -49,6 +69,7 @@ Stage::Result Execution::forward(db::RWTxn& txn) {
 
         // This is next stage probably needing full history
         auto hashstate_stage_progress{db::stages::read_stage_progress(txn, db::stages::kHashStateKey)};
+        auto call_traces_stage_progress{db::stages::read_stage_progress(txn, db::stages::kCallTracesKey)};
 
         if (previous_progress == senders_stage_progress) {
             // Nothing to process
@@ -88,10 +109,16 @@ Stage::Result Execution::forward(db::RWTxn& txn) {
             prune_history = std::min(prune_history, hashstate_stage_progress - 1);
             prune_receipts = std::min(prune_receipts, hashstate_stage_progress - 1);
         }
+        BlockNum prune_call_traces{node_settings_->prune_mode->call_traces().value_from_head(senders_stage_progress)};
+        if (call_traces_stage_progress) {
+            prune_call_traces = std::min(prune_call_traces, call_traces_stage_progress - 1);
+        }
 
         static constexpr size_t kCacheSize{5'000};
         AnalysisCache analysis_cache{kCacheSize};
         ObjectPool<evmone::ExecutionState> state_pool;
+        open_analysis_store();
+        backfill_block_totals(txn, previous_progress);
 
         prefetched_blocks_.clear();
 
@@ -102,7 +129,8 @@ Stage::Result Execution::forward(db::RWTxn& txn) {
                                                       analysis_cache,
                                                       state_pool,
                                                       prune_history,
-                                                      prune_receipts)};
+                                                      prune_receipts,
+                                                      prune_call_traces)};
 
             // If we return with success we must persist data
             // Though counterintuitive we also must persist on KInvalidBlock to allow subsequent unwind
@@ -113,7 +141,8 @@ Stage::Result Execution::forward(db::RWTxn& txn) {
 
             // Persist forward and prune progresses
             update_progress(txn, block_num_);
-            if (node_settings_->prune_mode->history().enabled() || node_settings_->prune_mode->receipts().enabled()) {
+            if (node_settings_->prune_mode->history().enabled() || node_settings_->prune_mode->receipts().enabled() ||
+                node_settings_->prune_mode->call_traces().enabled()) {
                 db::stages::write_stage_prune_progress(txn, db::stages::kExecutionKey, block_num_);
             }
 
@@ -181,11 +210,20 @@ void Execution::prefetch_blocks(db::RWTxn& txn, const BlockNum from, const Block
             }
 
             const auto hash_ptr{value.data()};
+            const Hash block_hash{ByteView{hash_ptr, kHashLength}};
+            const auto preverification{node_settings_->block_preverifier
+                                           ? node_settings_->block_preverifier->find(block_hash)
+                                           : nullptr};
             prefetched_blocks_.push_back();
+            Block& block{prefetched_blocks_.back()};
+            // Senders of blocks checked on arrival are taken from memory, skipping the Senders table
             if (!data_model.read_block(std::span<const uint8_t, kHashLength>{hash_ptr, kHashLength}, block_num,
-                                       /*read_senders=*/true, prefetched_blocks_.back())) {
+                                       /*read_senders=*/!preverification, block)) {
                 throw std::runtime_error("Unable to read block " + std::to_string(block_num));
             }
+            if (preverification && !read_preverified_senders(*preverification, block)) {
+                db::parse_senders(txn, db::block_key(block_num, block_hash.bytes), block.transactions);
+            }
             ++block_num;
         }};
         num_read = db::cursor_for_count(*canonicals, walk_function, count);
@@ -201,9 +239,91 @@ void Execution::prefetch_blocks(db::RWTxn& txn, const BlockNum from, const Block
     }
 }
 
+bool Execution::read_preverified_senders(BlockPreverification& preverification, Block& block) {
+    if (preverification.transactions_count() != block.transactions.size()) return false;
+    const auto senders{preverification.senders()};
+    if (std::any_of(senders.begin(), senders.end(), [](const auto& sender) { return !sender; })) return false;
+    for (std::size_t i{0}; i < senders.size(); ++i) {
+        block.transactions[i].from = senders[i];
+    }
+    return true;
+}
+
+//! \brief Appends the block totals of at most max_blocks blocks up to the given one after the last indexed block
+//! \return the number of backfilled blocks
+static BlockNum backfill_block_totals_chunk(db::RWTxn& txn, BlockNum max_block_num, BlockNum max_blocks) {
+    // Totals are written contiguously from genesis, so resume after the last ones (if any)
+    auto gas_index{txn.rw_cursor(db::table::kCumulativeGasIndex)};
+    auto transaction_index{txn.rw_cursor(db::table::kCumulativeTransactionIndex)};
+    BlockNum block_num{1};
+    uint64_t cumulative_gas{0};
+    uint64_t cumulative_transactions{0};
+    if (const auto last{transaction_index->to_last(/*throw_notfound=*/false)}; last) {
+        block_num = endian::load_big_u64(db::from_slice(last.key).data()) + 1;
+        cumulative_transactions = endian::load_big_u64(db::from_slice(last.value).data());
+        cumulative_gas = db::read_cumulative_gas_used(txn, block_num - 1).value_or(0);
+    }
+    if (block_num > max_block_num) {
+        return 0;
+    }
+
+    const BlockNum last_block_num{std::min(max_block_num, block_num + max_blocks - 1)};
+    db::DataModel data_model{txn};
+    Bytes value(sizeof(uint64_t), '\0');
+    for (BlockNum current_block_num{block_num}; current_block_num <= last_block_num; ++current_block_num) {
+        const auto header{data_model.read_canonical_header(current_block_num)};
+        BlockBody body;
+        if (!header || !data_model.read_canonical_body(current_block_num, body)) {
+            throw std::runtime_error("Unable to read block " + std::to_string(current_block_num));
+        }
+        cumulative_gas += header->gas_used;
+        cumulative_transactions += body.transactions.size();
+
+        const Bytes key{db::block_key(current_block_num)};
+        endian::store_big_u64(value.data(), cumulative_gas);
+        gas_index->upsert(db::to_slice(key), db::to_slice(value));
+        endian::store_big_u64(value.data(), cumulative_transactions);
+        transaction_index->upsert(db::to_slice(key), db::to_slice(value));
+    }
+    return last_block_num - block_num + 1;
+}
+
+void Execution::backfill_block_totals(db::RWTxn& txn, BlockNum max_block_num) {
+    // Never backfill within transactions not committing (e.g. a few blocks verified atomically): as long as the
+    // indexes have a gap Buffer does not extend them, so the next committing cycle resumes the backfill
+    if (max_block_num == 0 || txn.commit_disabled() || db::read_cumulative_transaction_count(txn, max_block_num)) {
+        return;
+    }
+
+    BlockNum num_blocks{0};
+    while (num_blocks < kMaxBackfilledBlocksPerCycle) {
+        throw_if_stopping();
+        const auto chunk_blocks{backfill_block_totals_chunk(txn, max_block_num, kBackfillChunkSize)};
+        if (chunk_blocks == 0) {
+            break;
+        }
+        txn.commit();
+        num_blocks += chunk_blocks;
+        log::Info(log_prefix_, {"op", "backfill block totals",
+                                "blocks", std::to_string(num_blocks),
+                                "to", std::to_string(max_block_num)});
+    }
+}
+
+void Execution::open_analysis_store() {
+    if (analysis_store_ || !node_settings_->data_directory) {
+        return;
+    }
+    try {
+        analysis_store_ = std::make_unique<db::PersistentAnalysisStore>(node_settings_->data_directory->path() / "analysis");
+    } catch (const std::exception& ex) {
+        log::Warning(log_prefix_, {"op", "open analysis store", "error", ex.what()});
+    }
+}
+
 Stage::Result Execution::execute_batch(db::RWTxn& txn, BlockNum max_block_num, AnalysisCache& analysis_cache,
                                        ObjectPool<evmone::ExecutionState>& state_pool, BlockNum prune_history_threshold,
-                                       BlockNum prune_receipts_threshold) {
+                                       BlockNum prune_receipts_threshold, BlockNum prune_call_traces_threshold) {
     Stage::Result ret{Stage::Result::kSuccess};
     using namespace std::chrono_literals;
     auto log_time{std::chrono::steady_clock::now()};
@@ -211,6 +331,7 @@ Stage::Result Execution::execute_batch(db::RWTxn& txn, BlockNum max_block_num, A
     try {
         db::Buffer buffer(txn, prune_history_threshold);
         std::vector<Receipt> receipts;
+        CallTraces call_traces;
 
         // Transform batch_size limit into Ggas
         size_t gas_max_history_size{node_settings_->batch_size * 1_Kibi / 2};  // 512MB -> 256Ggas roughly
@@ -218,6 +339,13 @@ Stage::Result Execution::execute_batch(db::RWTxn& txn, BlockNum max_block_num, A
         size_t gas_history_size{0};
         size_t gas_batch_size{0};
 
+        // Hand the state changes over to InterHashes only for short segments, which it processes incrementally
+        trie::IncrementalStateRoot* state_root{sync_context_->state_root};
+        if (state_root && max_block_num - block_num_ >= db::stages::kSmallBlockSegmentWidth) {
+            state_root->reset();
+            state_root = nullptr;
+        }
+
         {
             std::unique_lock progress_lock(progress_mtx_);
             lap_time_ = std::chrono::steady_clock::now();
@@ -242,16 +370,29 @@ Stage::Result Execution::execute_batch(db::RWTxn& txn, BlockNum max_block_num, A
             ExecutionProcessor processor(block, *rule_set_, buffer, node_settings_->chain_config.value(), gas_prices);
             processor.evm().analysis_cache = &analysis_cache;
             processor.evm().state_pool = &state_pool;
+            processor.evm().analysis_store = analysis_store_.get();
+
+            const bool collect_call_traces{block_num_ >= prune_call_traces_threshold};
+            if (collect_call_traces) {
+                call_traces.senders.clear();
+                call_traces.recipients.clear();
+                processor.evm().set_message_observer(make_call_traces_observer(call_traces));
+            }
 
-            // TODO Add Tracer and collect call traces
             auto gas_params = get_gas_params(txn, block);
             if (const auto res{processor.execute_and_write_block(receipts, gas_params)}; res != ValidationResult::kOk) {
                 // Persist work done so far
                 if (block_num_ >= prune_receipts_threshold) {
                     buffer.insert_receipts(block_num_, receipts);
                 }
+                if (collect_call_traces) {
+                    buffer.insert_call_traces(block_num_, call_traces);
+                }
                 buffer.write_to_db();
                 prefetched_blocks_.clear();
+                if (state_root) {
+                    state_root->reset();
+                }
 
                 // Notify sync_loop we need to unwind
                 sync_context_->unwind_point.emplace(block_num_ - 1u);
@@ -268,6 +409,18 @@ Stage::Result Execution::execute_batch(db::RWTxn& txn, BlockNum max_block_num, A
             if (block_num_ >= prune_receipts_threshold) {
                 buffer.insert_receipts(block_num_, receipts);
             }
+            if (collect_call_traces) {
+                buffer.insert_call_traces(block_num_, call_traces);
+            }
+            buffer.insert_block_totals(block_num_, receipts.empty() ? 0 : receipts.back().cumulative_gas_used,
+                                       block.transactions.size());
+            if (state_root) {
+                if (block_num_ >= prune_history_threshold) {
+                    state_root->collect(buffer, block_num_);
+                } else {
+                    state_root->reset();  // No changes recorded
+                }
+            }
 
             // Stats
             std::unique_lock progress_lock(progress_mtx_);
@@ -277,6 +430,9 @@ Stage::Result Execution::execute_batch(db::RWTxn& txn, BlockNum max_block_num, A
             gas_batch_size += block.header.gas_used;
             gas_history_size += block.header.gas_used;
             progress_lock.unlock();
+            execution_metrics().blocks.inc();
+            execution_metrics().transactions.inc(block.transactions.size());
+            execution_metrics().gas.inc(block.header.gas_used);
 
             prefetched_blocks_.pop_front();
 
@@ -321,12 +477,14 @@ Stage::Result Execution::execute_batch(db::RWTxn& txn, BlockNum max_block_num, A
 }
 
 Stage::Result Execution::unwind(db::RWTxn& txn) {
-    static const db::MapConfig unwind_tables[5] = {
-        db::table::kAccountChangeSet,  //
-        db::table::kStorageChangeSet,  //
-        db::table::kBlockReceipts,     //
-        db::table::kLogs,              //
-        db::table::kCallTraceSet       //
+    static const db::MapConfig unwind_tables[7] = {
+        db::table::kAccountChangeSet,           //
+        db::table::kStorageChangeSet,           //
+        db::table::kBlockReceipts,              //
+        db::table::kLogs,                       //
+        db::table::kCallTraceSet,               //
+        db::table::kCumulativeGasIndex,         //
+        db::table::kCumulativeTransactionIndex  //
     };
 
     Stage::Result ret{Stage::Result::kSuccess};
@@ -334,6 +492,9 @@ Stage::Result Execution::unwind(db::RWTxn& txn) {
     const BlockNum to{sync_context_->unwind_point.value()};
 
     operation_ = OperationType::Unwind;
+    if (sync_context_->state_root) {
+        sync_context_->state_root->reset();
+    }
     try {
         BlockNum previous_progress{db::stages::read_stage_progress(txn, db::stages::kExecutionKey)};
         if (to >= previous_progress) {
@@ -501,7 +662,7 @@ Stage::Result Execution::prune(db::RWTxn& txn) {
         }
 
         // Prune call traces
-        if (const auto prune_threshold{node_settings_->prune_mode->receipts().value_from_head(forward_progress)}; prune_threshold) {
+        if (const auto prune_threshold{node_settings_->prune_mode->call_traces().value_from_head(forward_progress)}; prune_threshold) {
             if (segment_width > db::stages::kSmallBlockSegmentWidth) {
                 log::Info(log_prefix_,
                           {"op", std::string(magic_enum::enum_name<OperationType>(operation_)),
@@ -628,7 +789,6 @@ void Execution::unwind_state_from_changeset(db::ROCursor& source_changeset, db::
         revert_state(new_key, new_value, plain_state_table, plain_code_table);
         src_data = source_changeset.to_previous(/*throw_notfound*/ false);
     }
-
 }
 
 }  // namespace silkworm::stagedsync
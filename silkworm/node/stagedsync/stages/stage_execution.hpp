@@ -20,10 +20,13 @@
 
 #include <silkworm/core/execution/evm.hpp>
 #include <silkworm/core/protocol/rule_set.hpp>
+#include <silkworm/node/db/analysis_store.hpp>
 #include <silkworm/node/stagedsync/stages/stage.hpp>
 
 namespace silkworm::stagedsync {
 
+class BlockPreverification;
+
 class Execution final : public Stage {
   public:
     explicit Execution(NodeSettings* node_settings, SyncContext* sync_context)
@@ -39,10 +42,23 @@ class Execution final : public Stage {
 
   private:
     static constexpr size_t kMaxPrefetchedBlocks{10240};
+    static constexpr BlockNum kBackfillChunkSize{10'000};               // Blocks backfilled per committed transaction
+    static constexpr BlockNum kMaxBackfilledBlocksPerCycle{1'000'000};  // Blocks backfilled before executing
 
     protocol::RuleSetPtr rule_set_;
     BlockNum block_num_{0};
     boost::circular_buffer<Block> prefetched_blocks_{/*buffer_capacity=*/kMaxPrefetchedBlocks};
+    std::unique_ptr<db::PersistentAnalysisStore> analysis_store_;  // Code analyses surviving restarts
+
+    //! \brief Opens the persistent code analysis store in the data directory, if not already open
+    //! \remarks Failures are logged and execution goes on without the store
+    void open_analysis_store();
+
+    //! \brief Fills the cumulative gas and transaction indexes up to the given block from canonical headers and bodies
+    //! \remarks Needed once on databases executed before the indexes were maintained, Buffer only extending them.
+    //! Runs as a migration in chunks of kBackfillChunkSize blocks, each one committed on its own, and stops after
+    //! kMaxBackfilledBlocksPerCycle blocks: the last indexed block is the persisted progress, resumed by next cycles
+    void backfill_block_totals(db::RWTxn& txn, BlockNum max_block_num);
 
     //! \brief Prefetches blocks for processing
     //! \param [in] from: the first block to prefetch (inclusive)
@@ -51,11 +67,17 @@ class Execution final : public Stage {
     //! or kMaxPrefetchedBlocks collected, whichever comes first
     void prefetch_blocks(db::RWTxn& txn, BlockNum from, BlockNum to);
 
+    //! \brief Fills the senders of the block from its stateless checks started on arrival
+    //! \return false if the checks are for another body or some of the senders could not be recovered
+    //! \remarks Senders stage has already waited for all the senders, so this never waits: the whole block is needed
+    //! before executing it, there is no per-chunk hand-over to Execution
+    static bool read_preverified_senders(BlockPreverification& preverification, Block& block);
+
     //! \brief Executes a batch of blocks
     //! \remarks A batch completes when either max block is reached or buffer dimensions overflow
     Stage::Result execute_batch(db::RWTxn& txn, BlockNum max_block_num, AnalysisCache& analysis_cache,
                                 ObjectPool<evmone::ExecutionState>& state_pool, BlockNum prune_history_threshold,
-                                BlockNum prune_receipts_threshold);
+                                BlockNum prune_receipts_threshold, BlockNum prune_call_traces_threshold);
 
     //! \brief For given changeset cursor/bucket it reverts the changes on states buckets
     static void unwind_state_from_changeset(db::ROCursor& source_changeset, db::RWCursorDupSort& plain_state_table,
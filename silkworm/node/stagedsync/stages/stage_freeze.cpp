@@ -0,0 +1,330 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "stage_freeze.hpp"
+
+#include <algorithm>
+
+#include <magic_enum.hpp>
+
+#include <silkworm/node/db/access_layer.hpp>
+#include <silkworm/node/huffman/compressor.hpp>
+#include <silkworm/node/snapshot/index.hpp>
+
+namespace silkworm::stagedsync {
+
+using snapshot::SnapshotPath;
+using snapshot::SnapshotType;
+
+Stage::Result Freeze::forward(db::RWTxn& txn) {
+    Stage::Result ret{Stage::Result::kSuccess};
+    operation_ = OperationType::Forward;
+    try {
+        throw_if_stopping();
+
+        // Check stage boundaries from previous execution and previous stage execution
+        const auto previous_progress{get_progress(txn)};
+        const auto target_progress{db::stages::read_stage_progress(txn, db::stages::kTxLookupKey)};
+        if (previous_progress == target_progress) {
+            // Nothing to process
+            operation_ = OperationType::None;
+            return ret;
+        } else if (previous_progress > target_progress) {
+            // Something bad had happened.  Maybe we need to unwind ?
+            throw StageError(Stage::Result::kInvalidProgress,
+                             "Freeze progress " + std::to_string(previous_progress) +
+                                 " greater than TxLookup progress " + std::to_string(target_progress));
+        }
+
+        auto* repository{node_settings_->snapshot_repository};
+        if (repository && repository->settings().freeze) {
+            const auto& settings{repository->settings()};
+            if (!node_settings_->data_directory) {
+                throw StageError(Stage::Result::kUnexpectedError, "Freeze requires a data directory for temporary files");
+            }
+
+            // The most recent blocks may still be reorganized: they are never frozen
+            const BlockNum freeze_to{target_progress + 1 > settings.freeze_threshold
+                                         ? target_progress + 1 - settings.freeze_threshold
+                                         : 0};
+            BlockNum block_from{repository->header_snapshots_count() > 0 ? repository->max_block_available() + 1 : 0};
+            if (settings.segment_size % snapshot::kFileNameBlockScaleFactor != 0 ||
+                block_from % snapshot::kFileNameBlockScaleFactor != 0) {
+                throw StageError(Stage::Result::kInvalidRange,
+                                 "Freeze segment size " + std::to_string(settings.segment_size) + " or start block " +
+                                     std::to_string(block_from) + " not multiple of " +
+                                     std::to_string(snapshot::kFileNameBlockScaleFactor));
+            }
+
+            reset_log_progress();
+            if (block_from + settings.segment_size <= freeze_to) {
+                log::Info(log_prefix_,
+                          {"op", std::string(magic_enum::enum_name<OperationType>(operation_)),
+                           "from", std::to_string(block_from),
+                           "to", std::to_string(freeze_to - 1),
+                           "segments", std::to_string((freeze_to - block_from) / settings.segment_size)});
+            }
+
+            for (; block_from + settings.segment_size <= freeze_to; block_from += settings.segment_size) {
+                throw_if_stopping();
+                freeze_segment(txn, *repository, block_from, block_from + settings.segment_size);
+
+                // Segments are now in the repository: make the erasure of their blocks durable
+                txn.commit();
+            }
+        }
+
+        reset_log_progress();
+        update_progress(txn, target_progress);
+        txn.commit();
+
+    } catch (const StageError& ex) {
+        log::Error(log_prefix_,
+                   {"function", std::string(__FUNCTION__), "exception", std::string(ex.what())});
+        ret = static_cast<Stage::Result>(ex.err());
+    } catch (const mdbx::exception& ex) {
+        log::Error(log_prefix_,
+                   {"function", std::string(__FUNCTION__), "exception", std::string(ex.what())});
+        ret = Stage::Result::kDbError;
+    } catch (const std::exception& ex) {
+        log::Error(log_prefix_,
+                   {"function", std::string(__FUNCTION__), "exception", std::string(ex.what())});
+        ret = Stage::Result::kUnexpectedError;
+    } catch (...) {
+        log::Error(log_prefix_,
+                   {"function", std::string(__FUNCTION__), "exception", "unexpected and undefined"});
+        ret = Stage::Result::kUnexpectedError;
+    }
+
+    operation_ = OperationType::None;
+    return ret;
+}
+
+Stage::Result Freeze::unwind(db::RWTxn& txn) {
+    Stage::Result ret{Stage::Result::kSuccess};
+
+    if (!sync_context_->unwind_point.has_value()) return ret;
+    const BlockNum to{sync_context_->unwind_point.value()};
+
+    operation_ = OperationType::Unwind;
+    try {
+        throw_if_stopping();
+
+        const auto previous_progress{get_progress(txn)};
+        if (previous_progress <= to) {
+            // Nothing to process
+            operation_ = OperationType::None;
+            return ret;
+        }
+
+        // Frozen blocks are below the freeze threshold, hence never unwound: just move the progress back
+        update_progress(txn, to);
+        txn.commit();
+
+    } catch (const StageError& ex) {
+        log::Error(log_prefix_,
+                   {"function", std::string(__FUNCTION__), "exception", std::string(ex.what())});
+        ret = static_cast<Stage::Result>(ex.err());
+    } catch (const mdbx::exception& ex) {
+        log::Error(log_prefix_,
+                   {"function", std::string(__FUNCTION__), "exception", std::string(ex.what())});
+        ret = Stage::Result::kDbError;
+    } catch (const std::exception& ex) {
+        log::Error(log_prefix_,
+                   {"function", std::string(__FUNCTION__), "exception", std::string(ex.what())});
+        ret = Stage::Result::kUnexpectedError;
+    } catch (...) {
+        log::Error(log_prefix_,
+                   {"function", std::string(__FUNCTION__), "exception", "unexpected and undefined"});
+        ret = Stage::Result::kUnexpectedError;
+    }
+
+    operation_ = OperationType::None;
+    return ret;
+}
+
+void Freeze::freeze_segment(db::RWTxn& txn, snapshot::SnapshotRepository& repository, BlockNum from, BlockNum to) {
+    using namespace std::chrono_literals;
+    auto log_time{std::chrono::steady_clock::now()};
+
+    const auto headers_path{SnapshotPath::from(repository.path(), snapshot::kSnapshotV1, from, to, SnapshotType::headers)};
+    const auto bodies_path{SnapshotPath::from(repository.path(), snapshot::kSnapshotV1, from, to, SnapshotType::bodies)};
+    const auto txs_path{SnapshotPath::from(repository.path(), snapshot::kSnapshotV1, from, to, SnapshotType::transactions)};
+
+    std::unique_lock log_lck(sl_mutex_);
+    current_target_ = headers_path.filename();
+    current_key_ = std::to_string(from);
+    log_lck.unlock();
+
+    // Transaction identifiers in snapshots are contiguous across segments, starting after the previous segment ones
+    uint64_t txn_id{0};
+    if (from > 0) {
+        const auto body_snapshot{repository.find_body_segment(from - 1)};
+        const auto last_body{body_snapshot ? body_snapshot->body_by_number(from - 1) : std::nullopt};
+        if (!last_body) {
+            throw StageError(Stage::Result::kBadChainSequence,
+                             "Body at height " + std::to_string(from - 1) + " not found in snapshots");
+        }
+        txn_id = last_body->base_txn_id + last_body->txn_count;
+    }
+
+    const auto& tmp_dir{node_settings_->data_directory->etl().path()};
+    huffman::Compressor headers_compressor{headers_path.path(), tmp_dir};
+    huffman::Compressor bodies_compressor{bodies_path.path(), tmp_dir};
+    huffman::Compressor txs_compressor{txs_path.path(), tmp_dir};
+
+    auto bodies = txn.ro_cursor(db::table::kBlockBodies);
+    auto transactions_table = txn.ro_cursor(db::table::kBlockTransactions);
+    std::vector<Transaction> transactions;
+    Bytes word;
+    for (BlockNum block_num{from}; block_num < to; ++block_num) {
+        const auto hash{db::read_canonical_hash(txn, block_num)};
+        if (!hash) {
+            throw StageError(Stage::Result::kBadChainSequence,
+                             "Canonical hash at height " + std::to_string(block_num) + " not found");
+        }
+
+        // Header word: first byte of block hash followed by the header RLP
+        const auto header_rlp{db::read_rlp_encoded_header(txn, block_num, *hash)};
+        if (!header_rlp) {
+            throw StageError(Stage::Result::kBadChainSequence,
+                             "Canonical header at height " + std::to_string(block_num) + " not found");
+        }
+        word.assign(1, hash->bytes[0]);
+        word.append(*header_rlp);
+        headers_compressor.add_word(word);
+
+        const Bytes key{db::block_key(block_num, hash->bytes)};
+        const auto body_data{bodies->find(db::to_slice(key), /*throw_notfound=*/false)};
+        if (!body_data) {
+            throw StageError(Stage::Result::kBadChainSequence,
+                             "Canonical body at height " + std::to_string(block_num) + " not found");
+        }
+        ByteView body_view{db::from_slice(body_data.value)};
+        auto stored_body{db::detail::decode_stored_block_body(body_view)};
+        db::read_transactions(*transactions_table, stored_body.base_txn_id, stored_body.txn_count, transactions);
+        const auto senders{db::read_senders(txn, key)};
+        if (senders.size() != transactions.size()) {
+            throw StageError(Stage::Result::kInvalidTransaction,
+                             "Senders count " + std::to_string(senders.size()) + " at height " +
+                                 std::to_string(block_num) + " mismatch transactions count " +
+                                 std::to_string(transactions.size()));
+        }
+
+        // Body word: the stored body renumbered to include one system transaction before and one after the block ones
+        const db::detail::BlockBodyForStorage body_for_snapshot{
+            .base_txn_id = txn_id,
+            .txn_count = transactions.size() + 2,
+            .ommers = std::move(stored_body.ommers),
+            .withdrawals = std::move(stored_body.withdrawals),
+        };
+        bodies_compressor.add_word(body_for_snapshot.encode());
+        txn_id += body_for_snapshot.txn_count;
+
+        // Transaction words: first byte of tx hash followed by sender and tx RLP, system transactions are empty
+        txs_compressor.add_word({});
+        for (std::size_t i{0}; i < transactions.size(); ++i) {
+            word.assign(1, transactions[i].hash().bytes[0]);
+            word.append(senders[i].bytes, kAddressLength);
+            rlp::encode(word, transactions[i]);
+            txs_compressor.add_word(word);
+        }
+        txs_compressor.add_word({});
+
+        // Log and abort check
+        if (const auto now{std::chrono::steady_clock::now()}; log_time <= now) {
+            throw_if_stopping();
+            log_lck.lock();
+            current_key_ = std::to_string(block_num);
+            log_lck.unlock();
+            log_time = now + 5s;
+        }
+    }
+
+    headers_compressor.compress();
+    bodies_compressor.compress();
+    txs_compressor.compress();
+
+    log_lck.lock();
+    current_key_ = "indexes";
+    log_lck.unlock();
+    snapshot::HeaderIndex{headers_path}.build();
+    snapshot::BodyIndex{bodies_path}.build();
+    snapshot::TransactionIndex{txs_path}.build();
+
+    repository.add_segments({headers_path, bodies_path, txs_path});
+
+    // Erased blocks can be served only by reading the snapshots, which a remote rpcdaemon using KV does not do
+    if (!repository.settings().freeze_keep_blocks) {
+        erase_blocks(txn, from, to);
+    }
+}
+
+void Freeze::erase_blocks(db::RWTxn& txn, BlockNum from, BlockNum to) {
+    // Keep the genesis block in db
+    const Bytes first_key{db::block_key(std::max(from, BlockNum{1}))};
+    const Bytes end_key{db::block_key(to)};
+
+    std::unique_lock log_lck(sl_mutex_);
+    current_target_ = db::table::kBlockBodies.name;
+    log_lck.unlock();
+
+    // Non-canonical bodies are erased as well, together with their transactions
+    auto bodies = txn.rw_cursor(db::table::kBlockBodies);
+    auto transactions = txn.rw_cursor(db::table::kBlockTransactions);
+    auto data{bodies->lower_bound(db::to_slice(first_key), /*throw_notfound=*/false)};
+    while (data && db::from_slice(data.key) < ByteView{end_key}) {
+        ByteView body_view{db::from_slice(data.value)};
+        const auto body{db::detail::decode_stored_block_body(body_view)};
+        auto tx_data{transactions->lower_bound(db::to_slice(db::block_key(body.base_txn_id)), /*throw_notfound=*/false)};
+        for (uint64_t i{0}; i < body.txn_count && tx_data; ++i) {
+            transactions->erase();
+            tx_data = transactions->to_next(/*throw_notfound=*/false);
+        }
+        bodies->erase();
+        data = bodies->to_next(/*throw_notfound=*/false);
+    }
+
+    log_lck.lock();
+    current_target_ = db::table::kHeaders.name;
+    log_lck.unlock();
+
+    auto headers = txn.rw_cursor(db::table::kHeaders);
+    data = headers->lower_bound(db::to_slice(first_key), /*throw_notfound=*/false);
+    while (data && db::from_slice(data.key) < ByteView{end_key}) {
+        headers->erase();
+        data = headers->to_next(/*throw_notfound=*/false);
+    }
+}
+
+std::vector<std::string> Freeze::get_log_progress() {
+    std::vector<std::string> ret{"op", std::string(magic_enum::enum_name<OperationType>(operation_))};
+    std::unique_lock log_lck(sl_mutex_);
+    if (current_target_.empty()) {
+        ret.insert(ret.end(), {"db", "waiting ..."});
+    } else {
+        ret.insert(ret.end(), {"to", current_target_, "key", current_key_});
+    }
+    return ret;
+}
+
+void Freeze::reset_log_progress() {
+    std::unique_lock log_lck(sl_mutex_);
+    current_target_.clear();
+    current_key_.clear();
+}
+
+}  // namespace silkworm::stagedsync
@@ -0,0 +1,54 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <silkworm/node/snapshot/repository.hpp>
+#include <silkworm/node/stagedsync/stages/stage.hpp>
+
+namespace silkworm::stagedsync {
+
+//! \brief Moves the blocks older than the freeze threshold from the database into new snapshot segments
+//! \remarks Only complete segments are frozen: each one gets its header, body and transaction files plus their
+//! indexes, then it is added to the snapshot repository and its headers, bodies and transactions are erased from db
+//! unless SnapshotSettings::freeze_keep_blocks is set. Erased blocks are readable only through the snapshots (e.g. by
+//! DataModel or a local rpcdaemon), not by a remote rpcdaemon using the KV interface.
+//! The genesis block is frozen but never erased. Frozen blocks are final, so unwinding does not touch them
+class Freeze : public Stage {
+  public:
+    explicit Freeze(NodeSettings* node_settings, SyncContext* sync_context)
+        : Stage(sync_context, db::stages::kFreezeKey, node_settings){};
+    ~Freeze() override = default;
+
+    Stage::Result forward(db::RWTxn& txn) final;
+    Stage::Result unwind(db::RWTxn& txn) final;
+    Stage::Result prune(db::RWTxn&) final { return Stage::Result::kSuccess; };
+    std::vector<std::string> get_log_progress() final;
+
+  private:
+    std::string current_target_;  // Current target of transformed data
+    std::string current_key_;     // Actual processing key
+
+    //! \brief Writes the segments of blocks [from, to) and adds them to the repository
+    void freeze_segment(db::RWTxn& txn, snapshot::SnapshotRepository& repository, BlockNum from, BlockNum to);
+
+    //! \brief Erases from db the headers, bodies and transactions of blocks [from, to) except genesis
+    void erase_blocks(db::RWTxn& txn, BlockNum from, BlockNum to);
+
+    void reset_log_progress();  // Clears out all logging vars
+};
+
+}  // namespace silkworm::stagedsync
@@ -0,0 +1,240 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <catch2/catch.hpp>
+#include <gsl/util>
+
+#include <silkworm/core/common/test_util.hpp>
+#include <silkworm/core/common/util.hpp>
+#include <silkworm/infra/common/directories.hpp>
+#include <silkworm/infra/test/log.hpp>
+#include <silkworm/node/db/access_layer.hpp>
+#include <silkworm/node/db/stages.hpp>
+#include <silkworm/node/snapshot/repository.hpp>
+#include <silkworm/node/stagedsync/stages/stage_freeze.hpp>
+#include <silkworm/node/test/context.hpp>
+
+namespace silkworm {
+
+using evmc::literals::operator""_bytes32;
+
+static void write_blocks(db::RWTxn& txn, BlockNum count, std::vector<Block>& blocks) {
+    const auto sample_transactions{test::sample_transactions()};
+    auto senders_table = txn.rw_cursor(db::table::kSenders);
+    evmc::bytes32 parent_hash{};
+    for (BlockNum number{0}; number < count; ++number) {
+        Block block;
+        block.header.number = number;
+        block.header.parent_hash = parent_hash;
+        block.header.gas_limit = 30'000'000;
+        // Each transaction must be unique to build the snapshot indexes
+        for (std::size_t i{0}; i < number % 3; ++i) {
+            Transaction transaction{sample_transactions[i % sample_transactions.size()]};
+            transaction.nonce = number * 3 + i;
+            transaction.from = evmc::address{};
+            transaction.from->bytes[0] = static_cast<uint8_t>(i + 1);
+            block.transactions.push_back(std::move(transaction));
+        }
+        const auto hash{block.header.hash()};
+        db::write_header(txn, block.header, /*with_header_numbers=*/true);
+        db::write_canonical_hash(txn, number, hash);
+        db::write_body(txn, block, hash, number);
+        Bytes senders;
+        for (const auto& transaction : block.transactions) {
+            senders.append(transaction.from->bytes, kAddressLength);
+        }
+        senders_table->upsert(db::to_slice(db::block_key(number, hash.bytes)), db::to_slice(senders));
+        parent_hash = hash;
+        blocks.push_back(std::move(block));
+    }
+}
+
+TEST_CASE("Stage Freeze") {
+    test::SetLogVerbosityGuard log_guard{log::Level::kNone};
+    test::Context context;
+    db::RWTxn& txn{context.rw_txn()};
+    txn.disable_commit();
+
+    constexpr BlockNum kSegmentSize{snapshot::kMinimumSegmentSize};
+    constexpr BlockNum kThreshold{100};
+    std::vector<Block> blocks;
+    write_blocks(txn, 2 * kSegmentSize + kThreshold + 50, blocks);
+
+    TemporaryDirectory snapshots_dir;
+    snapshot::SnapshotRepository repository{snapshot::SnapshotSettings{
+        .repository_dir = snapshots_dir.path(),
+        .segment_size = kSegmentSize,
+        .freeze = true,
+        .freeze_threshold = kThreshold,
+    }};
+    repository.reopen_folder();
+    context.node_settings().snapshot_repository = &repository;
+    db::DataModel::set_snapshot_repository(&repository);
+    [[maybe_unused]] auto _ = gsl::finally([] { db::DataModel::set_snapshot_repository(nullptr); });
+
+    stagedsync::SyncContext sync_context{};
+    stagedsync::Freeze stage_freeze(&context.node_settings(), &sync_context);
+
+    const auto check_block = [&](const Block& expected) {
+        const auto hash{expected.header.hash()};
+        db::DataModel data_model{txn};
+        Block block;
+        REQUIRE(data_model.read_block(hash, expected.header.number, block));
+        CHECK(block.header.hash() == hash);
+        REQUIRE(block.transactions.size() == expected.transactions.size());
+        for (std::size_t i{0}; i < block.transactions.size(); ++i) {
+            CHECK(block.transactions[i].hash() == expected.transactions[i].hash());
+            CHECK(block.transactions[i].from == expected.transactions[i].from);
+        }
+    };
+    const auto is_in_db = [&](BlockNum number) {
+        const auto hash{blocks[number].header.hash()};
+        BlockBody body;
+        return db::read_rlp_encoded_header(txn, number, hash).has_value() &&
+               db::read_body(txn, number, hash.bytes, /*read_senders=*/false, body);
+    };
+
+    SECTION("first segment only") {
+        // Blocks within the threshold from the target are not frozen
+        db::stages::write_stage_progress(txn, db::stages::kTxLookupKey, kSegmentSize + kThreshold - 2);
+        REQUIRE(stage_freeze.forward(txn) == stagedsync::Stage::Result::kSuccess);
+        CHECK(db::stages::read_stage_progress(txn, db::stages::kFreezeKey) == kSegmentSize + kThreshold - 2);
+        CHECK(repository.header_snapshots_count() == 0);
+        CHECK(is_in_db(kSegmentSize - 1));
+
+        db::stages::write_stage_progress(txn, db::stages::kTxLookupKey, kSegmentSize + kThreshold + 10);
+        REQUIRE(stage_freeze.forward(txn) == stagedsync::Stage::Result::kSuccess);
+        CHECK(repository.header_snapshots_count() == 1);
+        CHECK(repository.body_snapshots_count() == 1);
+        CHECK(repository.tx_snapshots_count() == 1);
+        CHECK(repository.max_block_available() == kSegmentSize - 1);
+
+        // Genesis is kept in db, frozen blocks are erased and the others are untouched
+        CHECK(is_in_db(0));
+        CHECK(!is_in_db(1));
+        CHECK(!is_in_db(kSegmentSize - 1));
+        CHECK(is_in_db(kSegmentSize));
+        for (const BlockNum number : {BlockNum{1}, BlockNum{2}, BlockNum{500}, kSegmentSize - 1, kSegmentSize}) {
+            check_block(blocks[number]);
+        }
+    }
+
+    SECTION("multiple segments") {
+        db::stages::write_stage_progress(txn, db::stages::kTxLookupKey, blocks.size() - 1);
+        REQUIRE(stage_freeze.forward(txn) == stagedsync::Stage::Result::kSuccess);
+        CHECK(repository.header_snapshots_count() == 2);
+        CHECK(repository.max_block_available() == 2 * kSegmentSize - 1);
+        CHECK(!is_in_db(2 * kSegmentSize - 1));
+        CHECK(is_in_db(2 * kSegmentSize));
+
+        // Transaction identifiers continue across segments
+        for (const BlockNum number : {kSegmentSize - 1, kSegmentSize, kSegmentSize + 1, 2 * kSegmentSize - 1}) {
+            check_block(blocks[number]);
+        }
+    }
+
+    SECTION("batch lookups by hash") {
+        db::stages::write_stage_progress(txn, db::stages::kTxLookupKey, kSegmentSize + kThreshold + 10);
+        REQUIRE(stage_freeze.forward(txn) == stagedsync::Stage::Result::kSuccess);
+        REQUIRE(repository.max_block_available() == kSegmentSize - 1);
+
+        db::DataModel data_model{txn};
+        const Hash unknown_hash{0x00000000000000000000000000000000000000000000000000000000000000ff_bytes32};
+
+        // Frozen headers come from the snapshots, the others from db
+        const std::vector<BlockNum> numbers{5, kSegmentSize - 1, 0, kSegmentSize + 5};
+        std::vector<Hash> block_hashes;
+        for (const auto number : numbers) {
+            block_hashes.emplace_back(blocks[number].header.hash());
+        }
+        block_hashes.push_back(unknown_hash);
+        const auto headers{data_model.read_headers(block_hashes)};
+        REQUIRE(headers.size() == block_hashes.size());
+        for (std::size_t i{0}; i < numbers.size(); ++i) {
+            REQUIRE(headers[i].has_value());
+            CHECK(headers[i]->number == numbers[i]);
+            CHECK(headers[i]->hash() == block_hashes[i]);
+        }
+        CHECK(!headers.back().has_value());
+
+        // Frozen transactions come from the snapshots even if still in the lookup table, the others from db
+        auto tx_lookup = txn.rw_cursor(db::table::kTxLookup);
+        std::vector<const Transaction*> expected_transactions;
+        std::vector<Hash> txn_hashes;
+        for (const BlockNum number : {BlockNum{1}, BlockNum{2}, kSegmentSize - 2, kSegmentSize + 1, kSegmentSize + 4}) {
+            REQUIRE(!blocks[number].transactions.empty());
+            for (const auto& transaction : blocks[number].transactions) {
+                const Hash txn_hash{transaction.hash()};
+                tx_lookup->upsert(db::to_slice(ByteView{txn_hash.bytes}), db::to_slice(zeroless_view(db::block_key(number))));
+                expected_transactions.push_back(&transaction);
+                txn_hashes.push_back(txn_hash);
+            }
+        }
+        txn_hashes.push_back(unknown_hash);
+        const auto transactions{data_model.read_transactions(txn_hashes)};
+        REQUIRE(transactions.size() == txn_hashes.size());
+        for (std::size_t i{0}; i < expected_transactions.size(); ++i) {
+            REQUIRE(transactions[i].has_value());
+            CHECK(transactions[i]->hash() == txn_hashes[i]);
+            CHECK(transactions[i]->from == expected_transactions[i]->from);
+        }
+        CHECK(!transactions.back().has_value());
+    }
+
+    SECTION("keep blocks") {
+        TemporaryDirectory keep_snapshots_dir;
+        snapshot::SnapshotRepository keep_repository{snapshot::SnapshotSettings{
+            .repository_dir = keep_snapshots_dir.path(),
+            .segment_size = kSegmentSize,
+            .freeze = true,
+            .freeze_threshold = kThreshold,
+            .freeze_keep_blocks = true,
+        }};
+        keep_repository.reopen_folder();
+        context.node_settings().snapshot_repository = &keep_repository;
+        db::DataModel::set_snapshot_repository(&keep_repository);
+
+        db::stages::write_stage_progress(txn, db::stages::kTxLookupKey, kSegmentSize + kThreshold + 10);
+        REQUIRE(stage_freeze.forward(txn) == stagedsync::Stage::Result::kSuccess);
+        CHECK(keep_repository.max_block_available() == kSegmentSize - 1);
+        CHECK(is_in_db(1));
+        CHECK(is_in_db(kSegmentSize - 1));
+        check_block(blocks[kSegmentSize - 1]);
+
+        context.node_settings().snapshot_repository = &repository;
+        db::DataModel::set_snapshot_repository(&repository);
+    }
+
+    SECTION("no data directory") {
+        auto data_directory{std::move(context.node_settings().data_directory)};
+        db::stages::write_stage_progress(txn, db::stages::kTxLookupKey, kSegmentSize + kThreshold + 10);
+        CHECK(stage_freeze.forward(txn) == stagedsync::Stage::Result::kUnexpectedError);
+        CHECK(repository.header_snapshots_count() == 0);
+        CHECK(is_in_db(1));
+        context.node_settings().data_directory = std::move(data_directory);
+    }
+
+    SECTION("unwind") {
+        db::stages::write_stage_progress(txn, db::stages::kTxLookupKey, blocks.size() - 1);
+        REQUIRE(stage_freeze.forward(txn) == stagedsync::Stage::Result::kSuccess);
+        sync_context.unwind_point = 2 * kSegmentSize + 10;
+        REQUIRE(stage_freeze.unwind(txn) == stagedsync::Stage::Result::kSuccess);
+        CHECK(db::stages::read_stage_progress(txn, db::stages::kFreezeKey) == 2 * kSegmentSize + 10);
+        CHECK(repository.max_block_available() == 2 * kSegmentSize - 1);
+    }
+}
+
+}  // namespace silkworm
@@ -16,16 +16,114 @@
 
 #include "stage_hashstate.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <future>
+#include <optional>
 #include <stdexcept>
+#include <vector>
 
+#include <gsl/util>
 #include <magic_enum.hpp>
 
 #include <silkworm/core/common/endian.hpp>
 #include <silkworm/infra/common/decoding_exception.hpp>
+#include <silkworm/infra/concurrency/task_scheduler.hpp>
 #include <silkworm/node/db/access_layer.hpp>
 
 namespace silkworm::stagedsync {
 
+//! The number of plain records read ahead while the previous batch is hashed
+static constexpr size_t kHashBatchSize{64 * 1024};
+
+//! The number of keys hashed by each task of the incremental paths
+static constexpr size_t kHashChunkSize{1024};
+
+//! Turns PlainState records into the HashedAccounts or HashedStorage ones they map to
+static void hash_plain_state(std::span<etl::Entry> entries) {
+    evmc::address last_address{};
+    ethash_hash256 address_hash{keccak256(last_address.bytes)};
+
+    for (auto& entry : entries) {
+        if (entry.key.length() != kAddressLength && entry.key.length() != db::kPlainStoragePrefixLength) {
+            std::string what{"Unexpected key length " + std::to_string(entry.key.length())};
+            throw StageError(Stage::Result::kUnexpectedError, what);
+        }
+
+        // Records of a slice are ordered by address (always initial 20 bytes of key)
+        // Rehash the address only when changes
+        if (std::memcmp(entry.key.data(), last_address.bytes, kAddressLength) != 0) {
+            last_address = to_evmc_address(entry.key);
+            address_hash = keccak256(last_address.bytes);
+        }
+
+        if (entry.key.length() == kAddressLength) {
+            // Hash account
+            // entry.key == Address
+            // entry.value == Account encoded for storage (must exist)
+            if (entry.value.empty()) {
+                const std::string what("Unexpected empty value in PlainState for Account " +
+                                       to_hex(last_address.bytes, /*with_prefix=*/true));
+                throw StageError(Stage::Result::kUnexpectedError, what);
+            }
+            entry.key.assign(address_hash.bytes, kHashLength);
+
+        } else {
+            // Hash storage
+            // entry.key   == Address + Incarnation
+            // entry.value == Location + zeroless Value
+            if (!(entry.value.length() > kHashLength)) {
+                const auto incarnation{endian::load_big_u64(&entry.key[kAddressLength])};
+                const std::string what("Unexpected empty value in PlainState for Account " +
+                                       to_hex(last_address.bytes, /*with_prefix=*/true) +
+                                       " incarnation " + std::to_string(incarnation));
+                throw StageError(Stage::Result::kUnexpectedError, what);
+            }
+
+            /*
+             * NOTE !
+             * Destination table kHashedStorage is dup-sorted but as Collector implements sorting only on entry
+             * key here we have to build the entry key as hashed address + incarnation + hashed storage location
+             * eventually leaving entry value to only hashed storage value. This ensures entries are collected
+             * and sorted properly and eventually the loader will move back hashed storage location in the value
+             * part of the db record. This way we can reliably insert records using MDBX_APPENDDUP
+             */
+            Bytes key(db::kHashedStoragePrefixLength + kHashLength, '\0');
+            std::memcpy(&key[0], address_hash.bytes, kHashLength);
+            std::memcpy(&key[kHashLength], &entry.key[kAddressLength], db::kIncarnationLength);
+            std::memcpy(&key[db::kHashedStoragePrefixLength],
+                        keccak256(ByteView{entry.value}.substr(0, kHashLength)).bytes, kHashLength);
+            entry.key = std::move(key);
+            entry.value.erase(0, kHashLength);
+        }
+    }
+}
+
+//! Turns PlainCodeHash records into the HashedCodeHash ones they map to
+static void hash_plain_code(std::span<etl::Entry> entries) {
+    evmc::address last_address{};
+    ethash_hash256 address_hash{keccak256(last_address.bytes)};
+
+    for (auto& entry : entries) {
+        if (entry.key.length() != kAddressLength + db::kIncarnationLength) {
+            std::string what{"Unexpected key len " + std::to_string(entry.key.length())};
+            throw StageError(Stage::Result::kUnexpectedError, what);
+        }
+
+        // Rehash the address only when changes
+        if (std::memcmp(entry.key.data(), last_address.bytes, kAddressLength) != 0) {
+            last_address = to_evmc_address(entry.key);
+            address_hash = keccak256(last_address.bytes);
+        }
+
+        // Key becomes Address Hash + Incarnation
+        Bytes key(db::kHashedStoragePrefixLength, '\0');
+        std::memcpy(&key[0], address_hash.bytes, kHashLength);
+        std::memcpy(&key[kHashLength], &entry.key[kAddressLength], db::kIncarnationLength);
+        entry.key = std::move(key);
+    }
+}
+
 Stage::Result HashState::forward(db::RWTxn& txn) {
     Stage::Result ret{Stage::Result::kSuccess};
     operation_ = OperationType::Forward;
@@ -184,91 +282,12 @@ Stage::Result HashState::hash_from_plainstate(db::RWTxn& txn) {
          * limit as PlainState holds info up to the highest executed block.
          */
 
-        evmc::address last_address{};
-        ethash_hash256 address_hash{keccak256(last_address.bytes)};  // We might have all zeroed addresses ?
-
         std::unique_lock log_lck(log_mtx_);
         current_source_ = std::string(db::table::kPlainState.name);
-        current_key_ = to_hex(last_address.bytes, /*with_prefix=*/true);
+        current_key_ = to_hex(evmc::address{}.bytes, /*with_prefix=*/true);
         log_lck.unlock();
 
-        // New Hashed Storage Entry Key (72 bytes)
-        // + Address hash  (32 bytes)
-        // + Incarnation   ( 8 bytes)
-        // + Location hash (32 bytes)
-        Bytes etl_storage_entry_key(72, '\0');
-
-        // Hash accounts
-        while (data) {
-            auto data_key_view{db::from_slice(data.key)};
-
-            // We're reading PlainState which keys are ordered by address (always initial 20 bytes of key)
-            // Rehash the address only when changes
-            if (std::memcmp(data_key_view.data(), last_address.bytes, kAddressLength) != 0) {
-                throw_if_stopping();
-                last_address = to_evmc_address(data_key_view);
-                address_hash = keccak256(last_address.bytes);
-                log_lck.lock();
-                current_key_ = to_hex(last_address.bytes, /*with_prefix=*/true);
-                log_lck.unlock();
-            }
-
-            if (data.key.length() == kAddressLength) {
-                // Hash account
-                // data.key == Address
-                // data.value == Account encoded for storage (must exist)
-                if (!data.value.length()) {
-                    const std::string what("Unexpected empty value in PlainState for Account " + current_key_);
-                    throw StageError(Stage::Result::kUnexpectedError, what);
-                }
-
-                etl::Entry entry{Bytes(address_hash.bytes, kHashLength), Bytes{db::from_slice(data.value)}};
-                collector_->collect(std::move(entry));
-
-            } else if (data.key.length() == db::kPlainStoragePrefixLength) {
-                // Hash storage
-                // data.key           == Address + Incarnation
-                // data.value (multi) == Location + zeroless Value
-
-                // See above for allocation
-                std::memcpy(&etl_storage_entry_key[0], address_hash.bytes, kHashLength);
-                std::memcpy(&etl_storage_entry_key[kHashLength], &data_key_view[kAddressLength],
-                            db::kIncarnationLength);
-
-                // Iterate dupkeys only to avoid re-hashing of same address
-                while (data) {
-                    if (!(data.value.length() > kHashLength)) {
-                        const auto incarnation{endian::load_big_u64(&data_key_view[kAddressLength])};
-                        const std::string what("Unexpected empty value in PlainState for Account " + current_key_ +
-                                               " incarnation " + std::to_string(incarnation));
-                        throw StageError(Stage::Result::kUnexpectedError, what);
-                    }
-
-                    /*
-                     * NOTE !
-                     * Destination table kHashedStorage is dup-sorted but as Collector implements sorting only on entry
-                     * key here we have to build the entry key as hashed address + incarnation + hashed storage location
-                     * eventually leaving entry value to only hashed storage value. This ensures entries are collected
-                     * and sorted properly and eventually the loader will move back hashed storage location in the value
-                     * part of the db record. This way we can reliably insert records using MDBX_APPENDDUP
-                     */
-
-                    auto data_value_view{db::from_slice(data.value)};
-                    std::memcpy(&etl_storage_entry_key[kHashLength + db::kIncarnationLength],
-                                keccak256(data_value_view.substr(0, kHashLength)).bytes, kHashLength);
-                    data_value_view.remove_prefix(kHashLength);
-                    etl::Entry entry{etl_storage_entry_key, Bytes{data_value_view}};
-                    collector_->collect(std::move(entry));
-                    data = source->to_current_next_multi(false);
-                }
-
-            } else {
-                std::string what{"Unexpected key length " + std::to_string(data.key.length())};
-                throw StageError(Stage::Result::kUnexpectedError, what);
-            }
-
-            data = source->to_next(/*throw_notfound=*/false);
-        }
+        collect_hashed_in_parallel(*source, data, hash_plain_state);
 
         throw_if_stopping();
 
@@ -340,41 +359,12 @@ Stage::Result HashState::hash_from_plaincode(db::RWTxn& txn) {
         auto source = txn.ro_cursor(db::table::kPlainCodeHash);
         auto data{source->to_first(/*throw_notfound=*/false)};
 
-        evmc::address last_address{};
-        Bytes new_key(db::kHashedStoragePrefixLength, '\0');
-
         std::unique_lock log_lck(log_mtx_);
         current_source_ = std::string(db::table::kPlainCodeHash.name);
-        current_key_ = to_hex(last_address.bytes, /*with_prefix=*/true);
+        current_key_ = to_hex(evmc::address{}.bytes, /*with_prefix=*/true);
         log_lck.unlock();
 
-        while (data) {
-            if (data.key.length() != kAddressLength + db::kIncarnationLength) {
-                std::string what{"Unexpected key len " + std::to_string(data.key.length())};
-                throw StageError(Stage::Result::kUnexpectedError, what);
-            }
-
-            auto data_key_view{db::from_slice(data.key)};
-
-            // We're reading PlainCodeHash which keys are ordered by address (always initial 20 bytes of key)
-            // Rehash the address only when changes
-            if (std::memcmp(data_key_view.data(), last_address.bytes, kAddressLength) != 0) {
-                throw_if_stopping();
-                last_address = to_evmc_address(data_key_view);
-                log_lck.lock();
-                current_key_ = to_hex(last_address.bytes, /*with_prefix=*/true);
-                log_lck.unlock();
-
-                const auto address_hash{keccak256(last_address.bytes)};
-                std::memcpy(&new_key[0], address_hash.bytes, kHashLength);
-            }
-
-            std::memcpy(&new_key[kHashLength], &data_key_view[kAddressLength], db::kIncarnationLength);
-
-            etl::Entry entry{new_key, Bytes{db::from_slice(data.value)}};
-            collector_->collect(std::move(entry));
-            data = source->to_next(/*throw_notfound=*/false);
-        }
+        collect_hashed_in_parallel(*source, data, hash_plain_code);
 
         throw_if_stopping();
 
@@ -411,6 +401,73 @@ Stage::Result HashState::hash_from_plaincode(db::RWTxn& txn) {
     return ret;
 }
 
+void HashState::collect_hashed_in_parallel(db::ROCursor& source, db::CursorResult data,
+                                           const HashSliceFunc& hash_slice) {
+    // Hash on the node scheduler if any, otherwise on a dedicated one
+    std::optional<concurrency::TaskScheduler> own_scheduler;
+    if (!node_settings_->task_scheduler) {
+        own_scheduler.emplace();
+    }
+    concurrency::TaskScheduler& scheduler{node_settings_->task_scheduler ? *node_settings_->task_scheduler : *own_scheduler};
+
+    // Batches are hashed in parallel slices, while the hashed entries are collected into the single collector so that
+    // its full-size buffer keeps the number of flushed files as low as with sequential hashing
+    const size_t num_slices{std::max<size_t>(scheduler.num_workers(), 1)};
+    std::vector<etl::Entry> batch;
+    std::vector<etl::Entry> hashing_batch;
+    std::vector<etl::Entry> hashed_batch;
+    const auto hash_batch = [&]() {
+        const size_t slice_size{(hashing_batch.size() + num_slices - 1) / num_slices};
+        scheduler.parallel_for(0, num_slices, 1, [&](size_t slice) {
+            const size_t first{std::min(slice * slice_size, hashing_batch.size())};
+            const size_t last{std::min(first + slice_size, hashing_batch.size())};
+            hash_slice(std::span<etl::Entry>{hashing_batch.data() + first, last - first});
+        });
+    };
+    const auto collect_hashed = [&]() {
+        for (auto& entry : hashed_batch) {
+            collector_->collect(std::move(entry));
+        }
+        hashed_batch.clear();
+    };
+
+    // The hashing of one batch must be complete before leaving, also on error
+    std::future<void> hashing;
+    auto hashing_wait = gsl::finally([&]() {
+        if (hashing.valid()) hashing.wait();
+    });
+
+    while (data) {
+        throw_if_stopping();
+        std::unique_lock log_lck(log_mtx_);
+        current_key_ = to_hex(db::from_slice(data.key).substr(0, kAddressLength), /*with_prefix=*/true);
+        log_lck.unlock();
+
+        batch.clear();
+        while (data && batch.size() < kHashBatchSize) {
+            batch.push_back({Bytes{db::from_slice(data.key)}, Bytes{db::from_slice(data.value)}});
+            data = source.to_next(/*throw_notfound=*/false);
+        }
+
+        if (hashing.valid()) {
+            scheduler.wait(hashing);
+            hashing.get();  // rethrows any hashing error
+            std::swap(hashing_batch, hashed_batch);
+        }
+        std::swap(batch, hashing_batch);
+        hashing = scheduler.submit(hash_batch);
+
+        // Collect the previous batch while the current one gets hashed
+        collect_hashed();
+    }
+    if (hashing.valid()) {
+        scheduler.wait(hashing);
+        hashing.get();
+        std::swap(hashing_batch, hashed_batch);
+        collect_hashed();
+    }
+}
+
 Stage::Result HashState::hash_from_account_changeset(db::RWTxn& txn, BlockNum previous_progress, BlockNum to) {
     Stage::Result ret{Stage::Result::kSuccess};
     try {
@@ -459,13 +516,13 @@ Stage::Result HashState::hash_from_account_changeset(db::RWTxn& txn, BlockNum pr
                 auto changeset_value_view{db::from_slice(changeset_data.value)};
                 evmc::address address{to_evmc_address(changeset_value_view)};
                 if (!changed_addresses.contains(address)) {
-                    auto address_hash{to_bytes32(keccak256(address.bytes).bytes)};
+                    // Address gets hashed later along with all the other ones
                     auto plainstate_data{source_plainstate->find(db::to_slice(address.bytes), /*throw_notfound=*/false)};
                     if (plainstate_data.done) {
                         Bytes current_value{db::from_slice(plainstate_data.value)};
-                        changed_addresses[address] = std::make_pair(address_hash, current_value);
+                        changed_addresses[address] = std::make_pair(evmc::bytes32{}, current_value);
                     } else {
-                        changed_addresses[address] = std::make_pair(address_hash, Bytes());
+                        changed_addresses[address] = std::make_pair(evmc::bytes32{}, Bytes());
                     }
                 }
                 changeset_data = source_changeset->to_current_next_multi(/*throw_notfound=*/false);
@@ -474,6 +531,7 @@ Stage::Result HashState::hash_from_account_changeset(db::RWTxn& txn, BlockNum pr
             changeset_data = source_changeset->to_next(/*throw_notfound=*/false);
         }
 
+        hash_changed_addresses(changed_addresses);
         ret = write_changes_from_changed_addresses(txn, changed_addresses);
 
     } catch (const mdbx::exception& ex) {
@@ -509,7 +567,6 @@ Stage::Result HashState::hash_from_storage_changeset(db::RWTxn& txn, BlockNum pr
         BlockNum reached_blocknum{0};
 
         db::StorageChanges storage_changes{};
-        absl::btree_map<evmc::address, evmc::bytes32> hashed_addresses{};
 
         std::unique_lock log_lck(log_mtx_);
         operation_ = OperationType::Forward;
@@ -554,10 +611,6 @@ Stage::Result HashState::hash_from_storage_changeset(db::RWTxn& txn, BlockNum pr
             if (!incarnation) {
                 throw StageError(Stage::Result::kUnexpectedError, "Unexpected EOA in StorageChangeset");
             }
-            if (!hashed_addresses.contains(address)) {
-                hashed_addresses[address] = to_bytes32(keccak256(address.bytes).bytes);
-                storage_changes[address].insert_or_assign(incarnation, absl::btree_map<evmc::bytes32, Bytes>());
-            }
 
             Bytes plain_storage_prefix{db::storage_prefix(address, incarnation)};
 
@@ -574,7 +627,7 @@ Stage::Result HashState::hash_from_storage_changeset(db::RWTxn& txn, BlockNum pr
             changeset_data = source_changeset->to_next(/*throw_notfound=*/false);
         }
 
-        ret = write_changes_from_changed_storage(txn, storage_changes, hashed_addresses);
+        ret = write_changes_from_changed_storage(txn, storage_changes);
 
     } catch (const mdbx::exception& ex) {
         log::Error(log_prefix_,
@@ -651,10 +704,10 @@ Stage::Result HashState::unwind_from_account_changeset(db::RWTxn& txn, BlockNum
                 evmc::address address{to_evmc_address(changeset_value_view)};
 
                 if (!changed_addresses.contains(address)) {
+                    // Address gets hashed later along with all the other ones
                     changeset_value_view.remove_prefix(kAddressLength);
-                    auto address_hash{to_bytes32(keccak256(address.bytes).bytes)};
                     Bytes previous_value(changeset_value_view.data(), changeset_value_view.length());
-                    changed_addresses[address] = std::make_pair(address_hash, previous_value);
+                    changed_addresses[address] = std::make_pair(evmc::bytes32{}, previous_value);
                 }
                 changeset_data = source_changeset->to_current_next_multi(/*throw_notfound=*/false);
             }
@@ -663,6 +716,7 @@ Stage::Result HashState::unwind_from_account_changeset(db::RWTxn& txn, BlockNum
             changeset_data = source_changeset->to_next(/*throw_notfound=*/false);
         }
 
+        hash_changed_addresses(changed_addresses);
         ret = write_changes_from_changed_addresses(txn, changed_addresses);
 
     } catch (const mdbx::exception& ex) {
@@ -705,7 +759,6 @@ Stage::Result HashState::unwind_from_storage_changeset(db::RWTxn& txn, BlockNum
         BlockNum reached_blocknum{0};
 
         db::StorageChanges storage_changes{};
-        absl::btree_map<evmc::address, evmc::bytes32> hashed_addresses{};
 
         std::unique_lock log_lck(log_mtx_);
         operation_ = OperationType::Unwind;
@@ -739,10 +792,6 @@ Stage::Result HashState::unwind_from_storage_changeset(db::RWTxn& txn, BlockNum
             if (!incarnation) {
                 throw std::runtime_error("Unexpected EOA in StorageChangeset");
             }
-            if (!hashed_addresses.contains(address)) {
-                hashed_addresses[address] = to_bytes32(keccak256(address.bytes).bytes);
-                storage_changes[address].insert_or_assign(incarnation, absl::btree_map<evmc::bytes32, Bytes>());
-            }
 
             while (changeset_data.done) {
                 auto changeset_value_view{db::from_slice(changeset_data.value)};
@@ -757,7 +806,7 @@ Stage::Result HashState::unwind_from_storage_changeset(db::RWTxn& txn, BlockNum
             changeset_data = source_changeset->to_next(/*throw_notfound=*/false);
         }
 
-        ret = write_changes_from_changed_storage(txn, storage_changes, hashed_addresses);
+        ret = write_changes_from_changed_storage(txn, storage_changes);
 
     } catch (const mdbx::exception& ex) {
         log::Error(log_prefix_,
@@ -780,9 +829,20 @@ Stage::Result HashState::unwind_from_storage_changeset(db::RWTxn& txn, BlockNum
     return ret;
 }
 
+void HashState::hash_changed_addresses(ChangedAddresses& changed_addresses) {
+    std::vector<std::pair<const evmc::address*, evmc::bytes32*>> addresses;
+    addresses.reserve(changed_addresses.size());
+    for (auto& [address, pair] : changed_addresses) {
+        addresses.emplace_back(&address, &pair.first);
+    }
+    for_each_in_chunks(addresses.size(), [&addresses](size_t i) {
+        *addresses[i].second = to_bytes32(keccak256(addresses[i].first->bytes).bytes);
+    });
+}
+
 Stage::Result HashState::write_changes_from_changed_addresses(db::RWTxn& txn, const ChangedAddresses& changed_addresses) {
     throw_if_stopping();
-    if(changed_addresses.size() == 0) return Stage::Result::kSuccess;
+    if (changed_addresses.size() == 0) return Stage::Result::kSuccess;
 
     std::unique_lock log_lck(log_mtx_);
     current_target_ = std::string(db::table::kHashedAccounts.name) + " " + std::string(db::table::kHashedCodeHash.name);
@@ -790,6 +850,16 @@ Stage::Result HashState::write_changes_from_changed_addresses(db::RWTxn& txn, co
     current_key_ = to_hex(changed_addresses.begin()->first.bytes, /*with_prefix=*/true);
     log_lck.unlock();
 
+    // Visit changes in hashed address order so that target tables are written sequentially
+    std::vector<ChangedAddresses::const_pointer> changes;
+    changes.reserve(changed_addresses.size());
+    for (const auto& change : changed_addresses) {
+        changes.push_back(&change);
+    }
+    std::sort(changes.begin(), changes.end(), [](const auto* lhs, const auto* rhs) {
+        return lhs->second.first < rhs->second.first;
+    });
+
     auto source_plaincode = txn.ro_cursor(db::table::kPlainCodeHash);
     auto target_hashed_accounts = txn.rw_cursor(db::table::kHashedAccounts);
     auto target_hashed_code = txn.rw_cursor(db::table::kHashedCodeHash);
@@ -797,12 +867,10 @@ Stage::Result HashState::write_changes_from_changed_addresses(db::RWTxn& txn, co
     Bytes plain_code_key(kAddressLength + db::kIncarnationLength, '\0');  // Only one allocation
     Bytes hashed_code_key(kHashLength + db::kIncarnationLength, '\0');    // Only one allocation
 
-    evmc::address last_address{};
-
-    for (const auto& [address, pair] : changed_addresses) {
-        if (address != last_address) {
+    for (size_t i{0}; i < changes.size(); ++i) {
+        const auto& [address, pair] = *changes[i];
+        if (i % 1024 == 0) {
             throw_if_stopping();
-            last_address = address;
             log_lck.lock();
             current_key_ = to_hex(address, true);
             log_lck.unlock();
@@ -837,42 +905,89 @@ Stage::Result HashState::write_changes_from_changed_addresses(db::RWTxn& txn, co
     return Stage::Result::kSuccess;
 }
 
-Stage::Result HashState::write_changes_from_changed_storage(
-    db::RWTxn& txn, db::StorageChanges& storage_changes,
-    const absl::btree_map<evmc::address, evmc::bytes32>& hashed_addresses) {
+Stage::Result HashState::write_changes_from_changed_storage(db::RWTxn& txn, const db::StorageChanges& storage_changes) {
     throw_if_stopping();
-    auto target_hashed_storage = txn.rw_cursor_dup_sort(db::table::kHashedStorage);
+    if (storage_changes.empty()) return Stage::Result::kSuccess;
 
     std::unique_lock log_lck(log_mtx_);
     loading_ = true;
     current_target_ = std::string(db::table::kHashedStorage.name);
+    current_key_ = to_hex(storage_changes.begin()->first, true);
     log_lck.unlock();
 
-    evmc::address last_address{};
-    Bytes hashed_storage_prefix(db::kHashedStoragePrefixLength, '\0');  // One allocation only
+    // Flatten the changes, then hash all addresses and locations in parallel chunks
+    struct HashedAddress {
+        const evmc::address* address;
+        evmc::bytes32 hash;
+    };
+    struct HashedLocation {
+        size_t address_index;  // Index into hashed addresses
+        uint64_t incarnation;
+        const evmc::bytes32* location;
+        const Bytes* value;
+        evmc::bytes32 hash;
+    };
+    std::vector<HashedAddress> addresses;
+    std::vector<HashedLocation> locations;
+    addresses.reserve(storage_changes.size());
     for (const auto& [address, data] : storage_changes) {
-        if (address != last_address) {
-            throw_if_stopping();
-            last_address = address;
-            std::memcpy(&hashed_storage_prefix[0], hashed_addresses.at(last_address).bytes, kHashLength);
+        addresses.push_back({&address, evmc::bytes32{}});
+        for (const auto& [incarnation, data1] : data) {
+            for (const auto& [location, value] : data1) {
+                locations.push_back({addresses.size() - 1, incarnation, &location, &value, evmc::bytes32{}});
+            }
+        }
+    }
+    for_each_in_chunks(addresses.size(), [&addresses](size_t i) {
+        addresses[i].hash = to_bytes32(keccak256(addresses[i].address->bytes).bytes);
+    });
+    for_each_in_chunks(locations.size(), [&locations](size_t i) {
+        locations[i].hash = to_bytes32(keccak256(locations[i].location->bytes).bytes);
+    });
+    throw_if_stopping();
+
+    // Write in hashed key order so that target table is written sequentially
+    std::sort(locations.begin(), locations.end(), [&addresses](const HashedLocation& lhs, const HashedLocation& rhs) {
+        if (lhs.address_index != rhs.address_index) {
+            return addresses[lhs.address_index].hash < addresses[rhs.address_index].hash;
+        }
+        if (lhs.incarnation != rhs.incarnation) {
+            return lhs.incarnation < rhs.incarnation;
+        }
+        return lhs.hash < rhs.hash;
+    });
 
+    auto target_hashed_storage = txn.rw_cursor_dup_sort(db::table::kHashedStorage);
+    Bytes hashed_storage_prefix(db::kHashedStoragePrefixLength, '\0');  // One allocation only
+    for (size_t i{0}; i < locations.size(); ++i) {
+        const auto& hashed_location{locations[i]};
+        const auto& hashed_address{addresses[hashed_location.address_index]};
+        if (i % 1024 == 0) {
+            throw_if_stopping();
             log_lck.lock();
-            current_key_ = to_hex(address, true);
+            current_key_ = to_hex(*hashed_address.address, true);
             log_lck.unlock();
         }
 
-        for (const auto& [incarnation, data1] : data) {
-            endian::store_big_u64(&hashed_storage_prefix[kHashLength], incarnation);
-            for (const auto& [location, value] : data1) {
-                auto hashed_location{keccak256(location.bytes)};
-                db::upsert_storage_value(*target_hashed_storage, hashed_storage_prefix, hashed_location.bytes, value);
-            }
-        }
+        std::memcpy(&hashed_storage_prefix[0], hashed_address.hash.bytes, kHashLength);
+        endian::store_big_u64(&hashed_storage_prefix[kHashLength], hashed_location.incarnation);
+        db::upsert_storage_value(*target_hashed_storage, hashed_storage_prefix, hashed_location.hash.bytes,
+                                 *hashed_location.value);
     }
 
     return Stage::Result::kSuccess;
 }
 
+void HashState::for_each_in_chunks(size_t count, const std::function<void(size_t)>& func) {
+    if (node_settings_->task_scheduler && count > kHashChunkSize) {
+        node_settings_->task_scheduler->parallel_for(0, count, kHashChunkSize, func);
+        return;
+    }
+    for (size_t i{0}; i < count; ++i) {
+        func(i);
+    }
+}
+
 std::vector<std::string> HashState::get_log_progress() {
     std::unique_lock log_lck(log_mtx_);
     std::vector<std::string> ret{"op", std::string(magic_enum::enum_name<OperationType>(operation_)),
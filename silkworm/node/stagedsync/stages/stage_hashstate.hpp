@@ -16,6 +16,9 @@
 
 #pragma once
 
+#include <functional>
+#include <span>
+
 #include <silkworm/node/stagedsync/stages/stage.hpp>
 
 namespace silkworm::stagedsync {
@@ -36,6 +39,9 @@ class HashState final : public Stage {
     //! \struct Address -> Address Hash -> Value
     using ChangedAddresses = absl::btree_map<evmc::address, std::pair<evmc::bytes32, Bytes>>;
 
+    //! \brief Transforms in place a slice of plain records read from the source table into the hashed ones
+    using HashSliceFunc = std::function<void(std::span<etl::Entry>)>;
+
     //! \brief Transforms PlainState into HashedAccounts and HashedStorage respectively in one single read pass over
     //! PlainState \remarks To be used only if this is very first time HashState stage runs forward (i.e. forwarding
     //! from 0)
@@ -45,6 +51,12 @@ class HashState final : public Stage {
     //! \remarks To be used only if this is very first time HashState stage runs forward (i.e. forwarding from 0)
     Stage::Result hash_from_plaincode(db::RWTxn& txn);
 
+    //! \brief Reads the records of source from the current position in batches, each batch being hashed in parallel
+    //! while the next one is read, and collects the results into collector_
+    //! \details Each worker hashes one slice of every batch in place, then the stage thread collects the hashed batch
+    //! while the next one is hashed: collector_ keeps its full-size buffer, hence no more flushed files than before
+    void collect_hashed_in_parallel(db::ROCursor& source, db::CursorResult data, const HashSliceFunc& hash_slice);
+
     //! \brief Detects account changes from AccountChangeSet and hashes the changed keys
     //! \remarks Though it could be used for initial sync only is way slower and builds an index of changed accounts.
     Stage::Result hash_from_account_changeset(db::RWTxn& txn, BlockNum previous_progress, BlockNum to);
@@ -60,12 +72,19 @@ class HashState final : public Stage {
     //! \brief Detects storage changes from StorageChangeSet and reverts hashed states
     Stage::Result unwind_from_storage_changeset(db::RWTxn& txn, BlockNum previous_progress, BlockNum to);
 
+    //! \brief Hashes in parallel chunks the addresses collected from account changeset scan
+    void hash_changed_addresses(ChangedAddresses& changed_addresses);
+
     //! \brief Writes to db the changes collected from account changeset scan either in forward or unwind mode
+    //! \remarks Changes are written in hashed address order, i.e. sequentially in the target tables
     Stage::Result write_changes_from_changed_addresses(db::RWTxn& txn, const ChangedAddresses& changed_addresses);
 
-    //! \brief Writes to db the changes collected from storage changeset scan either in forward or unwind mode
-    Stage::Result write_changes_from_changed_storage(db::RWTxn& txn, db::StorageChanges& storage_changes,
-                                                     const absl::btree_map<evmc::address, evmc::bytes32>& hashed_addresses);
+    //! \brief Hashes in parallel chunks the changes collected from storage changeset scan, then writes them to db in
+    //! hashed key order either in forward or unwind mode
+    Stage::Result write_changes_from_changed_storage(db::RWTxn& txn, const db::StorageChanges& storage_changes);
+
+    //! \brief Applies func to each index in [0, count) in parallel chunks on the node scheduler, if any, else serially
+    void for_each_in_chunks(size_t count, const std::function<void(size_t)>& func);
 
     //! \brief Resets all fields related to log progress tracking
     void reset_log_progress();
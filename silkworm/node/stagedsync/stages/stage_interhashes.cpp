@@ -82,8 +82,15 @@ Stage::Result InterHashes::forward(db::RWTxn& txn) {
         if (!previous_progress || segment_width > db::stages::kLargeBlockSegmentWorthRegen) {
             // Full regeneration
             ret = regenerate_intermediate_hashes(txn, &expected_state_root);
+        } else if (sync_context_->state_root &&
+                   sync_context_->state_root->covers(previous_progress, hashstate_stage_progress)) {
+            // Incremental update from the changes taken during execution
+            ret = increment_intermediate_hashes(txn, *sync_context_->state_root, &expected_state_root);
         } else {
             // Incremental update
+            if (sync_context_->state_root) {
+                sync_context_->state_root->reset();
+            }
             ret = increment_intermediate_hashes(txn, previous_progress, hashstate_stage_progress, &expected_state_root);
         }
 
@@ -127,6 +134,9 @@ Stage::Result InterHashes::unwind(db::RWTxn& txn) {
     const BlockNum to{sync_context_->unwind_point.value()};
 
     operation_ = OperationType::Unwind;
+    if (sync_context_->state_root) {
+        sync_context_->state_root->reset();
+    }
 
     try {
         throw_if_stopping();
@@ -556,6 +566,61 @@ Stage::Result InterHashes::increment_intermediate_hashes(db::RWTxn& txn, BlockNu
     return ret;
 }
 
+Stage::Result InterHashes::increment_intermediate_hashes(db::RWTxn& txn, trie::IncrementalStateRoot& state_root,
+                                                         const evmc::bytes32* expected_root) {
+    std::unique_lock log_lck(log_mtx_);
+    incremental_ = true;
+    current_source_ = "Execution";
+    current_target_.clear();
+    current_key_.clear();
+    log_lck.unlock();
+    Stage::Result ret{Stage::Result::kSuccess};
+
+    try {
+        const evmc::bytes32 computed_root{state_root.calculate_root(txn, node_settings_->task_scheduler)};
+
+        // As for the other paths the computed root is not checked against the expected one
+        if (expected_root != nullptr && computed_root != *expected_root) {
+            log::Trace(log_prefix_, {"expected root", to_hex(*expected_root, true), "got", to_hex(computed_root, true)});
+        }
+
+        log_lck.lock();
+        loading_ = true;
+        current_source_ = "memory";
+        current_target_ = std::string(db::table::kTrieOfAccounts.name) + " " + std::string(db::table::kTrieOfStorage.name);
+        log_lck.unlock();
+
+        state_root.flush(txn);
+
+        log_lck.lock();
+        loading_ = false;
+        current_target_.clear();
+        log_lck.unlock();
+
+    } catch (const StageError& ex) {
+        log::Error(log_prefix_,
+                   {"function", std::string(__FUNCTION__), "exception", std::string(ex.what())});
+        ret = static_cast<Stage::Result>(ex.err());
+    } catch (const mdbx::exception& ex) {
+        log::Error(log_prefix_,
+                   {"function", std::string(__FUNCTION__), "exception", std::string(ex.what())});
+        ret = Stage::Result::kDbError;
+    } catch (const std::exception& ex) {
+        log::Error(log_prefix_,
+                   {"function", std::string(__FUNCTION__), "exception", std::string(ex.what())});
+        ret = Stage::Result::kUnexpectedError;
+    } catch (...) {
+        log::Error(log_prefix_,
+                   {"function", std::string(__FUNCTION__), "exception", "unexpected and undefined"});
+        ret = Stage::Result::kUnexpectedError;
+    }
+
+    if (ret != Stage::Result::kSuccess) {
+        state_root.reset();
+    }
+    return ret;
+}
+
 void InterHashes::flush_collected_nodes(db::RWTxn& txn) {
     // Proceed with loading of newly generated nodes and deletion of obsolete ones.
     std::unique_lock log_lck(log_mtx_);
@@ -20,6 +20,7 @@
 #include <silkworm/core/trie/prefix_set.hpp>
 #include <silkworm/node/etl/collector.hpp>
 #include <silkworm/node/stagedsync/stages/stage.hpp>
+#include <silkworm/node/stagedsync/stages/stage_interhashes/incremental_state_root.hpp>
 #include <silkworm/node/stagedsync/stages/stage_interhashes/trie_loader.hpp>
 
 namespace silkworm::stagedsync {
@@ -58,6 +59,13 @@ class InterHashes final : public Stage {
     [[nodiscard]] Stage::Result increment_intermediate_hashes(db::RWTxn& txn, BlockNum from, BlockNum to,
                                                               const evmc::bytes32* expected_root = nullptr);
 
+    //! \brief Same as above for the changes of the blocks in (from, to] taken by state_root during execution, so the
+    //! change sets are not read back
+    //! \remarks might throw
+    //! \return the state root
+    [[nodiscard]] Stage::Result increment_intermediate_hashes(db::RWTxn& txn, trie::IncrementalStateRoot& state_root,
+                                                              const evmc::bytes32* expected_root = nullptr);
+
     //! \brief Persists in TrieAccount and TrieStorage the collected nodes (and respective deletions if any)
     void flush_collected_nodes(db::RWTxn& txn);
 
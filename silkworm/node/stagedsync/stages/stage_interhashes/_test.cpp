@@ -19,8 +19,11 @@
 #include <silkworm/core/trie/hash_builder.hpp>
 #include <silkworm/core/trie/nibbles.hpp>
 #include <silkworm/core/types/account.hpp>
+#include <silkworm/infra/concurrency/task_scheduler.hpp>
+#include <silkworm/node/db/buffer.hpp>
 #include <silkworm/node/db/tables.hpp>
 #include <silkworm/node/etl/collector.hpp>
+#include <silkworm/node/stagedsync/stages/stage_interhashes/incremental_state_root.hpp>
 #include <silkworm/node/stagedsync/stages/stage_interhashes/trie_cursor.hpp>
 #include <silkworm/node/stagedsync/stages/stage_interhashes/trie_loader.hpp>
 #include <silkworm/node/test/context.hpp>
@@ -869,4 +872,177 @@ TEST_CASE("Trie Storage : incremental vs regeneration") {
     REQUIRE(fused_nodes == incremental_nodes);
 }
 
+TEST_CASE("IncrementalStateRoot : executed changes vs regeneration") {
+    test::Context context;
+    auto& txn{context.rw_txn()};
+
+    static constexpr size_t n{1'000};
+
+    db::PooledCursor hashed_accounts{txn, db::table::kHashedAccounts};
+    db::PooledCursor hashed_storage{txn, db::table::kHashedStorage};
+    db::PooledCursor account_trie{txn, db::table::kTrieOfAccounts};
+    db::PooledCursor storage_trie{txn, db::table::kTrieOfStorage};
+
+    static constexpr Account one_eth{0, 1 * kEther};
+    static constexpr Account two_eth{0, 2 * kEther};
+    static constexpr Account three_eth{0, 3 * kEther};
+
+    static constexpr uint64_t incarnation1{3};
+    static constexpr uint64_t incarnation2{1};
+    static constexpr Account contract1{1, 7 * kEther, kEmptyHash, incarnation1};
+    static constexpr Account contract2{1, 13 * kEther, kEmptyHash, incarnation2};
+    static constexpr auto address1{0x1000000000000000000000000000000000000000_address};
+    static constexpr auto address2{0x2000000000000000000000000000000000000000_address};
+    static const auto hashed_address1{keccak256(address1)};
+    static const auto hashed_address2{keccak256(address2)};
+    static const Bytes storage_prefix1{db::storage_prefix(hashed_address1.bytes, incarnation1)};
+    static const Bytes storage_prefix2{db::storage_prefix(hashed_address2.bytes, incarnation2)};
+
+    static const evmc::bytes32 value_x{int_to_bytes32(0x42)};
+    static const evmc::bytes32 value_y{0x71f602b294119bf452f1923814f5c6de768221254d3056b1bd63e72dc3142a29_bytes32};
+
+    const auto upsert_account = [&](uint64_t i, const Account& account) {
+        const auto hash{keccak256(int_to_address(i))};
+        hashed_accounts.upsert(db::to_slice(hash.bytes), db::to_slice(account.encode_for_storage()));
+    };
+    const auto upsert_storage = [&](const Bytes& storage_prefix, uint64_t i, const evmc::bytes32& value) {
+        const auto hashed_location{keccak256(int_to_bytes32(i))};
+        db::upsert_storage_value(hashed_storage, storage_prefix, hashed_location.bytes, zeroless_view(value.bytes));
+    };
+
+    // ------------------------------------------------------------------------------
+    // Genesis: 3n accounts holding 1 ETH and two contracts with 3n storage slots each
+    // ------------------------------------------------------------------------------
+    for (uint64_t i{0}; i < 3 * n; ++i) {
+        upsert_account(i, one_eth);
+    }
+    hashed_accounts.upsert(db::to_slice(hashed_address1.bytes), db::to_slice(contract1.encode_for_storage()));
+    hashed_accounts.upsert(db::to_slice(hashed_address2.bytes), db::to_slice(contract2.encode_for_storage()));
+    for (uint64_t i{0}; i < 3 * n; ++i) {
+        upsert_storage(storage_prefix1, i, value_x);
+        upsert_storage(storage_prefix2, i, value_x);
+    }
+    (void)regenerate_intermediate_hashes(txn, context.dir().etl().path());
+
+    // ------------------------------------------------------------------------------
+    // Take A: execute blocks 1 and 2, then compute the root from the taken changes
+    // ------------------------------------------------------------------------------
+    db::Buffer buffer{txn, /*prune_history_threshold=*/0};
+    IncrementalStateRoot state_root;
+
+    buffer.begin_block(1);
+    for (uint64_t i{0}; i < n; ++i) {
+        buffer.update_account(int_to_address(i), one_eth, two_eth);  // changed
+    }
+    for (uint64_t i{n}; i < 2 * n; ++i) {
+        buffer.update_account(int_to_address(i), one_eth, std::nullopt);  // deleted
+    }
+    for (uint64_t i{3 * n}; i < 4 * n; ++i) {
+        buffer.update_account(int_to_address(i), std::nullopt, one_eth);  // created
+    }
+    for (uint64_t i{0}; i < n; ++i) {
+        buffer.update_storage(address1, incarnation1, int_to_bytes32(i), value_x, value_y);
+    }
+    for (uint64_t i{n}; i < 2 * n; ++i) {
+        buffer.update_storage(address1, incarnation1, int_to_bytes32(i), value_x, evmc::bytes32{});
+    }
+    for (uint64_t i{3 * n}; i < 4 * n; ++i) {
+        buffer.update_storage(address1, incarnation1, int_to_bytes32(i), evmc::bytes32{}, value_x);
+    }
+    buffer.update_account(address1, contract1, contract1);
+    buffer.update_account(address2, contract2, std::nullopt);  // destructed with its storage
+    state_root.collect(buffer, 1);
+
+    buffer.begin_block(2);
+    buffer.update_account(int_to_address(0), two_eth, three_eth);
+    buffer.update_account(int_to_address(3 * n), one_eth, std::nullopt);                     // created then deleted
+    buffer.update_storage(address1, incarnation1, int_to_bytes32(0), value_y, value_x);      // back to genesis
+    buffer.update_storage(address1, incarnation1, int_to_bytes32(3 * n), value_x, value_y);  // created then changed
+    buffer.update_account(address1, contract1, contract1);
+    state_root.collect(buffer, 2);
+
+    CHECK(state_root.covers(0, 2));
+    CHECK_FALSE(state_root.covers(1, 2));
+    CHECK(state_root.changed_accounts_count() == 3 * n + 2);
+    CHECK(state_root.changed_storage_count() == 3 * n);
+
+    evmc::bytes32 incremental_root;
+    SECTION("serial") {
+        incremental_root = state_root.calculate_root(txn);
+    }
+    SECTION("parallel") {
+        concurrency::TaskScheduler scheduler{2};
+        incremental_root = state_root.calculate_root(txn, &scheduler);
+    }
+    state_root.flush(txn);
+    CHECK(state_root.empty());
+
+    const std::map<Bytes, Node> incremental_account_nodes{read_all_nodes(account_trie)};
+    const std::map<Bytes, Node> incremental_storage_nodes{read_all_nodes(storage_trie)};
+
+    // ------------------------------------------------------------------------------
+    // Take B: generate intermediate hashes for the state as of Block 2 in one go
+    // ------------------------------------------------------------------------------
+    txn->clear_map(db::open_map(txn, db::table::kHashedAccounts));
+    txn->clear_map(db::open_map(txn, db::table::kHashedStorage));
+
+    upsert_account(0, three_eth);
+    for (uint64_t i{1}; i < n; ++i) {
+        upsert_account(i, two_eth);
+    }
+    for (uint64_t i{2 * n}; i < 3 * n; ++i) {
+        upsert_account(i, one_eth);
+    }
+    for (uint64_t i{3 * n + 1}; i < 4 * n; ++i) {
+        upsert_account(i, one_eth);
+    }
+    hashed_accounts.upsert(db::to_slice(hashed_address1.bytes), db::to_slice(contract1.encode_for_storage()));
+    upsert_storage(storage_prefix1, 0, value_x);
+    for (uint64_t i{1}; i < n; ++i) {
+        upsert_storage(storage_prefix1, i, value_y);
+    }
+    for (uint64_t i{2 * n}; i < 4 * n; ++i) {
+        upsert_storage(storage_prefix1, i, i == 3 * n ? value_y : value_x);
+    }
+
+    txn->clear_map(db::open_map(txn, db::table::kTrieOfAccounts));
+    txn->clear_map(db::open_map(txn, db::table::kTrieOfStorage));
+    const auto fused_root{regenerate_intermediate_hashes(txn, context.dir().etl().path())};
+
+    // ------------------------------------------------------------------------------
+    // A and B should yield the same result
+    // ------------------------------------------------------------------------------
+    REQUIRE(to_hex(fused_root.bytes, true) == to_hex(incremental_root.bytes, true));
+    CHECK(read_all_nodes(account_trie) == incremental_account_nodes);
+    CHECK(read_all_nodes(storage_trie) == incremental_storage_nodes);
+}
+
+TEST_CASE("IncrementalStateRoot : taking blocks") {
+    test::Context context;
+    auto& txn{context.rw_txn()};
+
+    db::Buffer buffer{txn, /*prune_history_threshold=*/0};
+    IncrementalStateRoot state_root;
+    CHECK(state_root.empty());
+
+    static constexpr Account one_eth{0, 1 * kEther};
+    for (BlockNum block_num : {5u, 6u, 8u}) {
+        buffer.begin_block(block_num);
+        buffer.update_account(int_to_address(block_num), std::nullopt, one_eth);
+        state_root.collect(buffer, block_num);
+    }
+
+    // Block 7 is missing so taking restarts from block 8
+    CHECK_FALSE(state_root.covers(4, 8));
+    CHECK(state_root.covers(7, 8));
+    CHECK(state_root.changed_accounts_count() == 1);
+
+    // Nothing calculated yet
+    CHECK_THROWS_AS(state_root.flush(txn), std::logic_error);
+
+    state_root.reset();
+    CHECK(state_root.empty());
+    CHECK(state_root.changed_accounts_count() == 0);
+}
+
 }  // namespace silkworm::trie
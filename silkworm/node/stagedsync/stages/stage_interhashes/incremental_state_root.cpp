@@ -0,0 +1,558 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "incremental_state_root.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include <silkworm/core/common/cast.hpp>
+#include <silkworm/core/common/util.hpp>
+#include <silkworm/core/rlp/encode.hpp>
+#include <silkworm/core/trie/hash_builder.hpp>
+#include <silkworm/core/trie/nibbles.hpp>
+#include <silkworm/core/trie/prefix_set.hpp>
+#include <silkworm/infra/common/decoding_exception.hpp>
+#include <silkworm/infra/common/log.hpp>
+#include <silkworm/infra/common/stopwatch.hpp>
+#include <silkworm/node/db/tables.hpp>
+#include <silkworm/node/db/util.hpp>
+#include <silkworm/node/stagedsync/stages/stage_interhashes/trie_cursor.hpp>
+
+namespace silkworm::trie {
+
+namespace {
+
+    //! The size of the buffers of the collectors of pending nodes, few of them being expected
+    constexpr std::size_t kNodesBufferSize{64_Mebi};
+
+    //! The smallest hashed key starting with the given packed key (possibly shorter)
+    evmc::bytes32 lower_bound_key(ByteView packed_key) {
+        evmc::bytes32 key{};
+        std::memcpy(key.bytes, packed_key.data(), std::min(packed_key.length(), kHashLength));
+        return key;
+    }
+
+    Bytes read_root_node(db::ROTxn& txn) {
+        auto trie_accounts{txn.ro_cursor(db::table::kTrieOfAccounts)};
+        const auto data{trie_accounts->to_first(/*throw_notfound=*/false)};
+        return data && data.key.empty() ? Bytes{db::from_slice(data.value)} : Bytes{};
+    }
+
+    //! \brief Walks kHashedAccounts overridden by the account changes, in hashed address order
+    class HashedAccounts {
+      public:
+        using Changes = absl::btree_map<evmc::bytes32, IncrementalStateRoot::AccountChange>;
+
+        HashedAccounts(db::ROCursor& db_cursor, const Changes& changes) : db_cursor_{db_cursor}, changes_{changes} {}
+
+        //! Moves to the first account whose hashed address is not less than the packed key
+        bool seek(ByteView packed_key) {
+            db_data_ = packed_key.empty() ? db_cursor_.to_first(false) : db_cursor_.lower_bound(db::to_slice(packed_key), false);
+            change_it_ = changes_.lower_bound(lower_bound_key(packed_key));
+            return settle();
+        }
+
+        bool next() {
+            if (from_db_) {
+                db_data_ = db_cursor_.to_next(false);
+            }
+            if (from_changes_) {
+                ++change_it_;
+            }
+            return settle();
+        }
+
+        [[nodiscard]] ByteView key() const { return key_; }
+        [[nodiscard]] const Account& account() const { return account_; }
+
+      private:
+        bool settle() {
+            while (true) {
+                const bool has_db{static_cast<bool>(db_data_)};
+                const bool has_change{change_it_ != changes_.end()};
+                if (!has_db && !has_change) {
+                    return false;
+                }
+                const ByteView db_key{has_db ? db::from_slice(db_data_.key) : ByteView{}};
+                const ByteView change_key{has_change ? ByteView{change_it_->first.bytes} : ByteView{}};
+                const int order{!has_db ? 1 : (!has_change ? -1 : db_key.compare(change_key))};
+                from_db_ = order <= 0;
+                from_changes_ = order >= 0;
+                if (!from_changes_) {
+                    key_ = db_key;
+                    const auto account{Account::from_encoded_storage(db::from_slice(db_data_.value))};
+                    success_or_throw(account);
+                    account_ = *account;
+                    return true;
+                }
+                if (change_it_->second.current) {
+                    key_ = change_key;
+                    account_ = *change_it_->second.current;
+                    return true;
+                }
+                next_deleted();
+            }
+        }
+
+        void next_deleted() {
+            if (from_db_) {
+                db_data_ = db_cursor_.to_next(false);
+            }
+            ++change_it_;
+        }
+
+        db::ROCursor& db_cursor_;
+        const Changes& changes_;
+        db::CursorResult db_data_;
+        Changes::const_iterator change_it_;
+        bool from_db_{false};
+        bool from_changes_{false};
+        ByteView key_;
+        Account account_;
+    };
+
+    //! \brief Walks the slots in kHashedStorage of one storage prefix overridden by their changes, in hashed
+    //! location order
+    class HashedStorage {
+      public:
+        using Changes = IncrementalStateRoot::StorageChanges;
+
+        explicit HashedStorage(db::ROCursorDupSort& db_cursor) : db_cursor_{db_cursor} {}
+
+        void bind(ByteView prefix, const Changes* changes) {
+            prefix_ = prefix;
+            changes_ = changes;
+        }
+
+        //! Moves to the first slot whose hashed location is not less than the packed key
+        bool seek(ByteView packed_key) {
+            db_data_ = db_cursor_.lower_bound_multivalue(db::to_slice(prefix_), db::to_slice(packed_key), false);
+            if (changes_) {
+                change_it_ = changes_->lower_bound(lower_bound_key(packed_key));
+            }
+            return settle();
+        }
+
+        bool next() {
+            if (from_db_) {
+                db_data_ = db_cursor_.to_current_next_multi(false);
+            }
+            if (from_changes_) {
+                ++change_it_;
+            }
+            return settle();
+        }
+
+        [[nodiscard]] ByteView location() const { return location_; }
+        [[nodiscard]] ByteView value() const { return value_; }  // Zeroless
+
+      private:
+        bool settle() {
+            while (true) {
+                const bool has_db{static_cast<bool>(db_data_)};
+                const bool has_change{changes_ != nullptr && change_it_ != changes_->end()};
+                if (!has_db && !has_change) {
+                    return false;
+                }
+                const ByteView db_value{has_db ? db::from_slice(db_data_.value) : ByteView{}};
+                const ByteView db_location{db_value.substr(0, std::min(db_value.length(), kHashLength))};
+                const ByteView change_location{has_change ? ByteView{change_it_->first.bytes} : ByteView{}};
+                const int order{!has_db ? 1 : (!has_change ? -1 : db_location.compare(change_location))};
+                from_db_ = order <= 0;
+                from_changes_ = order >= 0;
+                if (!from_changes_) {
+                    location_ = db_location;
+                    value_ = db_value.substr(db_location.length());
+                    return true;
+                }
+                value_ = zeroless_view(change_it_->second.current.bytes);
+                if (!value_.empty()) {
+                    location_ = change_location;
+                    return true;
+                }
+                if (from_db_) {
+                    db_data_ = db_cursor_.to_current_next_multi(false);
+                }
+                ++change_it_;
+            }
+        }
+
+        db::ROCursorDupSort& db_cursor_;
+        ByteView prefix_;
+        const Changes* changes_{nullptr};
+        db::CursorResult db_data_;
+        Changes::const_iterator change_it_;
+        bool from_db_{false};
+        bool from_changes_{false};
+        ByteView location_;
+        ByteView value_;
+    };
+
+    //! \brief A leaf or a branch node to be added to a HashBuilder, recorded while walking the db
+    struct TrieStep {
+        Bytes key;  // Nibbled
+        bool is_leaf{false};
+        Bytes value;             // RLP of the leaf value (storage)
+        evmc::bytes32 hash;      // Hash of the branch node, storage root of the leaf (accounts)
+        bool in_db_trie{false};  // Whether the branch node has children in trie
+    };
+
+    //! \brief A storage trie whose root is to be hashed from the recorded steps
+    struct StorageJob {
+        Bytes prefix;
+        std::vector<TrieStep> steps;
+        evmc::bytes32 root;
+        std::vector<etl::Entry> nodes;
+    };
+
+    constexpr std::size_t kNoJob{std::numeric_limits<std::size_t>::max()};
+
+    //! \brief A step of the account trie, whose leaf needs the storage root computed by a job (if any)
+    struct AccountStep : public TrieStep {
+        Account account;
+        std::size_t storage_job{kNoJob};
+    };
+
+    //! \brief Records the steps of the storage trie of the job prefix, see TrieLoader::calculate_storage_root
+    void walk_storage(TrieCursor& trie_storage_cursor, HashedStorage& hashed_storage, StorageJob& job) {
+        auto trie_storage_data{trie_storage_cursor.to_prefix(job.prefix)};
+        while (true) {
+            if (trie_storage_data.first_uncovered.has_value()) {
+                for (bool found{hashed_storage.seek(*trie_storage_data.first_uncovered)}; found;
+                     found = hashed_storage.next()) {
+                    auto nibbled_location{unpack_nibbles(hashed_storage.location())};
+                    if (trie_storage_data.key.has_value() && trie_storage_data.key.value() < nibbled_location) {
+                        break;
+                    }
+                    TrieStep& step{job.steps.emplace_back()};
+                    step.key = std::move(nibbled_location);
+                    step.is_leaf = true;
+                    rlp::encode(step.value, hashed_storage.value());
+                }
+            }
+
+            // Interrupt loop when no more keys to process
+            if (!trie_storage_data.key.has_value()) {
+                break;
+            }
+
+            TrieStep& step{job.steps.emplace_back()};
+            step.key = *trie_storage_data.key;
+            step.hash = *trie_storage_data.hash;
+            step.in_db_trie = trie_storage_data.children_in_trie;
+
+            // Have we just sent Storage root for this contract ?
+            if (trie_storage_data.key->empty()) {
+                break;
+            }
+
+            trie_storage_data = trie_storage_cursor.to_next();
+        }
+    }
+
+    void hash_storage(StorageJob& job) {
+        HashBuilder storage_hash_builder;
+        storage_hash_builder.node_collector = [&job](ByteView nibbled_key, const Node& node) {
+            Bytes key{job.prefix};
+            key.append(nibbled_key);
+            Bytes value{node.state_mask() ? node.encode_for_storage() : Bytes{}};  // Node with no state should be deleted
+            job.nodes.push_back({std::move(key), std::move(value)});
+        };
+        for (auto& step : job.steps) {
+            if (step.is_leaf) {
+                storage_hash_builder.add_leaf(std::move(step.key), step.value);
+            } else {
+                storage_hash_builder.add_branch_node(std::move(step.key), step.hash, step.in_db_trie);
+            }
+        }
+        job.root = storage_hash_builder.root_hash();
+        job.steps.clear();
+    }
+
+}  // namespace
+
+IncrementalStateRoot::IncrementalStateRoot(std::size_t max_cached_nodes)
+    : account_nodes_{kNodesBufferSize},
+      storage_nodes_{kNodesBufferSize},
+      account_trie_cache_{max_cached_nodes / 2},
+      storage_trie_cache_{max_cached_nodes / 2, db::kHashedStoragePrefixLength} {}
+
+void IncrementalStateRoot::collect(const db::Buffer& buffer, BlockNum block_num) {
+    if (!last_block_ || block_num != *last_block_ + 1) {
+        reset();
+        base_block_ = block_num - 1;
+    }
+    last_block_ = block_num;
+    calculated_ = false;
+
+    if (const auto it{buffer.account_changes().find(block_num)}; it != buffer.account_changes().end()) {
+        for (const auto& [address, encoded_initial] : it->second) {
+            auto [change_it, inserted]{accounts_.try_emplace(hashed_address(address))};
+            auto& change{change_it->second};
+            if (inserted && !encoded_initial.empty()) {
+                const auto incarnation{Account::incarnation_from_encoded_storage(encoded_initial)};
+                success_or_throw(incarnation);
+                change.existed = true;
+                change.initial_incarnation = *incarnation;
+            }
+            change.current = buffer.read_account(address);
+        }
+    }
+
+    if (const auto it{buffer.storage_changes().find(block_num)}; it != buffer.storage_changes().end()) {
+        for (const auto& [address, incarnations] : it->second) {
+            const auto hashed{hashed_address(address)};
+            // Accounts with changed storage have account changes too (see Buffer::update_account), just in case
+            if (auto [change_it, inserted]{accounts_.try_emplace(hashed)}; inserted) {
+                auto& change{change_it->second};
+                change.current = buffer.read_account(address);
+                change.existed = change.current.has_value();
+                change.initial_incarnation = change.existed ? change.current->incarnation : 0;
+            }
+            for (const auto& [incarnation, locations] : incarnations) {
+                auto& changes{storage_[db::storage_prefix(hashed.bytes, incarnation)]};
+                for (const auto& [location, initial_value] : locations) {
+                    auto [slot_it, inserted]{changes.try_emplace(hashed_location(location))};
+                    if (inserted) {
+                        slot_it->second.created = initial_value.empty();
+                        ++changed_storage_count_;
+                    }
+                    slot_it->second.current = buffer.read_storage(address, incarnation, location);
+                }
+            }
+        }
+    }
+}
+
+bool IncrementalStateRoot::covers(BlockNum from, BlockNum to) const {
+    return base_block_ == from && last_block_ == to;
+}
+
+evmc::bytes32 IncrementalStateRoot::calculate_root(db::ROTxn& txn, concurrency::TaskScheduler* scheduler) {
+    std::unique_ptr<StopWatch> sw;
+    if (log::test_verbosity(log::Level::kTrace)) {
+        sw = std::make_unique<StopWatch>(/*auto_start=*/true);
+    }
+
+    validate_caches(txn);
+    account_nodes_.clear();
+    storage_nodes_.clear();
+
+    PrefixSet account_changes;
+    for (const auto& [hashed, change] : accounts_) {
+        account_changes.insert(unpack_nibbles(hashed.bytes), /*marker=*/!change.existed);
+    }
+    PrefixSet storage_changes;
+    Bytes storage_key;
+    for (const auto& [prefix, changes] : storage_) {
+        for (const auto& [hashed, change] : changes) {
+            storage_key.assign(prefix).append(unpack_nibbles(hashed.bytes));
+            storage_changes.insert(storage_key, /*marker=*/change.created);
+        }
+    }
+
+    auto hashed_accounts_cursor{txn.ro_cursor(db::table::kHashedAccounts)};
+    auto hashed_storage_cursor{txn.ro_cursor_dup_sort(db::table::kHashedStorage)};
+    auto trie_accounts{txn.ro_cursor(db::table::kTrieOfAccounts)};
+    auto trie_storage{txn.ro_cursor(db::table::kTrieOfStorage)};
+    HashedAccounts hashed_accounts{*hashed_accounts_cursor, accounts_};
+    HashedStorage hashed_storage{*hashed_storage_cursor};
+    TrieCursor trie_account_cursor{*trie_accounts, &account_changes, &account_nodes_, &account_trie_cache_};
+    TrieCursor trie_storage_cursor{*trie_storage, &storage_changes, &storage_nodes_, &storage_trie_cache_};
+
+    // Walk the db recording the steps of the tries, see TrieLoader::calculate_root
+    std::vector<AccountStep> account_steps;
+    std::vector<StorageJob> storage_jobs;
+    auto trie_account_data{trie_account_cursor.to_prefix({})};
+    while (true) {
+        if (trie_account_data.first_uncovered.has_value()) {
+            for (bool found{hashed_accounts.seek(*trie_account_data.first_uncovered)}; found;
+                 found = hashed_accounts.next()) {
+                auto nibbled_address{unpack_nibbles(hashed_accounts.key())};
+                if (trie_account_data.key.has_value() && trie_account_data.key.value() < nibbled_address) {
+                    break;
+                }
+
+                AccountStep& step{account_steps.emplace_back()};
+                step.key = std::move(nibbled_address);
+                step.is_leaf = true;
+                step.account = hashed_accounts.account();
+                step.hash = kEmptyRoot;
+                if (step.account.incarnation) {
+                    StorageJob job;
+                    job.prefix = db::storage_prefix(hashed_accounts.key(), step.account.incarnation);
+                    const auto changes_it{storage_.find(job.prefix)};
+                    hashed_storage.bind(job.prefix, changes_it != storage_.end() ? &changes_it->second : nullptr);
+                    walk_storage(trie_storage_cursor, hashed_storage, job);
+                    if (job.steps.size() == 1 && !job.steps[0].is_leaf && job.steps[0].key.empty()) {
+                        step.hash = job.steps[0].hash;  // Unchanged storage trie
+                    } else if (!job.steps.empty()) {
+                        step.storage_job = storage_jobs.size();
+                        storage_jobs.push_back(std::move(job));
+                    }
+                }
+            }
+        }
+
+        // Interrupt loop when no more keys to process
+        if (!trie_account_data.key.has_value()) {
+            break;
+        }
+
+        AccountStep& step{account_steps.emplace_back()};
+        step.key = *trie_account_data.key;
+        step.hash = *trie_account_data.hash;
+        step.in_db_trie = trie_account_data.children_in_trie;
+
+        // If root node added we can exit
+        if (trie_account_data.key->empty()) {
+            break;
+        }
+
+        trie_account_data = trie_account_cursor.to_next();
+    }
+
+    // Hash the changed storage tries in parallel, then the account trie
+    if (scheduler != nullptr && storage_jobs.size() > 1) {
+        scheduler->parallel_for(0, storage_jobs.size(), 1, [&](std::size_t i) { hash_storage(storage_jobs[i]); });
+    } else {
+        std::for_each(storage_jobs.begin(), storage_jobs.end(), hash_storage);
+    }
+    for (auto& job : storage_jobs) {
+        for (auto& node : job.nodes) {
+            storage_nodes_.collect(std::move(node));
+        }
+    }
+
+    HashBuilder account_hash_builder;
+    account_hash_builder.node_collector = [&](ByteView nibbled_key, const Node& node) {
+        Bytes value{node.state_mask() ? node.encode_for_storage() : Bytes{}};  // Node with no state should be deleted
+        account_nodes_.collect({Bytes{nibbled_key}, value});
+    };
+    for (auto& step : account_steps) {
+        if (step.is_leaf) {
+            const auto& storage_root{step.storage_job == kNoJob ? step.hash : storage_jobs[step.storage_job].root};
+            account_hash_builder.add_leaf(std::move(step.key), step.account.rlp(storage_root));
+        } else {
+            account_hash_builder.add_branch_node(std::move(step.key), step.hash, step.in_db_trie);
+        }
+    }
+    const auto root_hash{account_hash_builder.root_hash()};
+    calculated_ = true;
+
+    if (sw) {
+        const auto [_, duration]{sw->stop()};
+        log::Trace("Incremental state root",
+                   {"blocks", std::to_string(*last_block_ - *base_block_),
+                    "accounts", std::to_string(accounts_.size()),
+                    "slots", std::to_string(changed_storage_count_),
+                    "storage tries", std::to_string(storage_jobs.size()),
+                    "cache hits", std::to_string(account_trie_cache_.hits() + storage_trie_cache_.hits()),
+                    "in", StopWatch::format(duration)});
+    }
+    return root_hash;
+}
+
+void IncrementalStateRoot::flush(db::RWTxn& txn) {
+    if (!calculated_) {
+        throw std::logic_error("IncrementalStateRoot::flush: no root calculated for the taken changes");
+    }
+
+    // Delete the storage tries of the destructed accounts
+    auto trie_storage{txn.rw_cursor(db::table::kTrieOfStorage)};
+    for (const auto& [hashed, change] : accounts_) {
+        if (!change.initial_incarnation ||
+            (change.current.has_value() && change.current->incarnation == change.initial_incarnation)) {
+            continue;
+        }
+        const Bytes prefix{db::storage_prefix(hashed.bytes, change.initial_incarnation)};
+        const auto prefix_slice{db::to_slice(prefix)};
+        auto data{trie_storage->lower_bound(prefix_slice, /*throw_notfound=*/false)};
+        while (data && data.key.starts_with(prefix_slice)) {
+            storage_trie_cache_.invalidate(db::from_slice(data.key));
+            trie_storage->erase();
+            data = trie_storage->to_next(/*throw_notfound=*/false);
+        }
+    }
+
+    // Write the pending nodes telling the caches
+    const auto load_into = [](TrieNodeCache& cache) -> etl::LoadFunc {
+        return [&cache](const etl::Entry& entry, db::RWCursorDupSort& target, MDBX_put_flags_t flags) {
+            cache.invalidate(entry.key);
+            const auto key{db::to_slice(entry.key)};
+            if (entry.value.empty()) {
+                target.erase(key);
+            } else {
+                auto value{db::to_slice(entry.value)};
+                mdbx::error::success_or_throw(target.put(key, &value, flags));
+            }
+        };
+    };
+    auto target{txn.rw_cursor_dup_sort(db::table::kTrieOfAccounts)};  // note: not a multi-value table
+    MDBX_put_flags_t flags{target->empty() ? MDBX_put_flags_t::MDBX_APPEND : MDBX_put_flags_t::MDBX_UPSERT};
+    account_nodes_.load(*target, load_into(account_trie_cache_), flags);
+
+    target->bind(txn, db::table::kTrieOfStorage);
+    flags = target->empty() ? MDBX_put_flags_t::MDBX_APPEND : MDBX_put_flags_t::MDBX_UPSERT;
+    storage_nodes_.load(*target, load_into(storage_trie_cache_), flags);
+
+    caches_root_node_ = read_root_node(txn);
+    reset();
+}
+
+void IncrementalStateRoot::reset() {
+    base_block_.reset();
+    last_block_.reset();
+    accounts_.clear();
+    storage_.clear();
+    changed_storage_count_ = 0;
+    hashed_addresses_.clear();
+    hashed_locations_.clear();
+    calculated_ = false;
+    account_nodes_.clear();
+    storage_nodes_.clear();
+}
+
+evmc::bytes32 IncrementalStateRoot::hashed_address(const evmc::address& address) {
+    auto [it, inserted]{hashed_addresses_.try_emplace(address)};
+    if (inserted) {
+        it->second = bit_cast<evmc_bytes32>(keccak256(address));
+    }
+    return it->second;
+}
+
+evmc::bytes32 IncrementalStateRoot::hashed_location(const evmc::bytes32& location) {
+    auto [it, inserted]{hashed_locations_.try_emplace(location)};
+    if (inserted) {
+        it->second = bit_cast<evmc_bytes32>(keccak256(location));
+    }
+    return it->second;
+}
+
+void IncrementalStateRoot::validate_caches(db::ROTxn& txn) {
+    const Bytes root_node{read_root_node(txn)};
+    if (root_node != caches_root_node_) {
+        account_trie_cache_.clear();
+        storage_trie_cache_.clear();
+        caches_root_node_ = root_node;
+    }
+}
+
+}  // namespace silkworm::trie
@@ -0,0 +1,123 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include <absl/container/btree_map.h>
+#include <absl/container/flat_hash_map.h>
+#include <evmc/evmc.hpp>
+
+#include <silkworm/core/common/base.hpp>
+#include <silkworm/core/types/account.hpp>
+#include <silkworm/infra/concurrency/task_scheduler.hpp>
+#include <silkworm/node/db/buffer.hpp>
+#include <silkworm/node/db/mdbx.hpp>
+#include <silkworm/node/etl/collector.hpp>
+#include <silkworm/node/stagedsync/stages/stage_interhashes/trie_node_cache.hpp>
+
+namespace silkworm::trie {
+
+//! \brief Computes the state root in memory from the changes of the executed blocks, taken from db::Buffer as they
+//! are executed, so neither the change sets nor the hashed state tables need to be read back
+//! \details Keys are hashed once when changes are taken. The root is computed from TrieOfAccounts and TrieOfStorage
+//! as of the block before the first taken one, walking the hashed state tables overridden by the taken changes: the
+//! walk only reads the db, then the changed storage tries are hashed in parallel and the account trie last. The new
+//! nodes are kept until flush, which is meant to happen once per cycle (see InterHashes). The upper nodes of both tries
+//! are kept in bounded caches surviving flushes, dropped whenever the trie tables are found changed by someone else.
+class IncrementalStateRoot {
+  public:
+    static constexpr std::size_t kDefaultMaxCachedNodes{64 * 1'024};
+
+    //! \brief The change of an account since the block before the first taken one
+    struct AccountChange {
+        bool existed{false};              // Whether the account existed before the first taken block
+        uint64_t initial_incarnation{0};  // Its incarnation if it did
+        std::optional<Account> current;
+    };
+
+    //! \brief The change of a storage location since the block before the first taken one
+    struct StorageChange {
+        bool created{false};  // Whether the value was zero before the first taken block
+        evmc::bytes32 current;
+    };
+
+    using StorageChanges = absl::btree_map<evmc::bytes32, StorageChange>;  // hashed location -> change
+
+    explicit IncrementalStateRoot(std::size_t max_cached_nodes = kDefaultMaxCachedNodes);
+
+    // Not copyable nor movable
+    IncrementalStateRoot(const IncrementalStateRoot&) = delete;
+    IncrementalStateRoot& operator=(const IncrementalStateRoot&) = delete;
+
+    //! \brief Takes the account and storage changes of the block, to be called right after its execution
+    //! \remarks Blocks must be taken in sequence: otherwise the changes taken so far are dropped and taking restarts
+    void collect(const db::Buffer& buffer, BlockNum block_num);
+
+    //! \brief Whether the taken changes are exactly the ones of blocks in (from, to]
+    [[nodiscard]] bool covers(BlockNum from, BlockNum to) const;
+
+    [[nodiscard]] bool empty() const { return !last_block_.has_value(); }
+    [[nodiscard]] std::size_t changed_accounts_count() const { return accounts_.size(); }
+    [[nodiscard]] std::size_t changed_storage_count() const { return changed_storage_count_; }
+
+    //! \brief Computes the state root as of the last taken block, the tables of the tries reflecting the block before
+    //! the first one: the new nodes are kept pending until flush
+    //! \param scheduler [in] : the scheduler to hash the storage tries in parallel (if any)
+    //! \remark May throw
+    [[nodiscard]] evmc::bytes32 calculate_root(db::ROTxn& txn, concurrency::TaskScheduler* scheduler = nullptr);
+
+    //! \brief Writes the nodes pending from the last calculate_root into TrieOfAccounts and TrieOfStorage, deletes the
+    //! storage tries of the destructed accounts, then drops the taken changes
+    //! \remark May throw
+    void flush(db::RWTxn& txn);
+
+    //! \brief Drops the taken changes and the pending nodes (e.g. on unwind)
+    void reset();
+
+    [[nodiscard]] const TrieNodeCache& account_trie_cache() const { return account_trie_cache_; }
+    [[nodiscard]] const TrieNodeCache& storage_trie_cache() const { return storage_trie_cache_; }
+
+  private:
+    evmc::bytes32 hashed_address(const evmc::address& address);
+    evmc::bytes32 hashed_location(const evmc::bytes32& location);
+
+    //! \brief Drops the caches unless the root node of TrieOfAccounts is still the one they have been filled from
+    void validate_caches(db::ROTxn& txn);
+
+    std::optional<BlockNum> base_block_;  // The block before the first taken one
+    std::optional<BlockNum> last_block_;  // The last taken block
+
+    absl::btree_map<evmc::bytes32, AccountChange> accounts_;  // hashed address -> change
+    absl::btree_map<Bytes, StorageChanges> storage_;          // storage prefix (hashed address + incarnation) -> changes
+    std::size_t changed_storage_count_{0};
+
+    absl::flat_hash_map<evmc::address, evmc::bytes32> hashed_addresses_;
+    absl::flat_hash_map<evmc::bytes32, evmc::bytes32> hashed_locations_;
+
+    bool calculated_{false};        // Whether the pending nodes reflect all the taken changes
+    etl::Collector account_nodes_;  // Nodes pending for TrieOfAccounts (empty value for deletion)
+    etl::Collector storage_nodes_;  // Nodes pending for TrieOfStorage (empty value for deletion)
+
+    TrieNodeCache account_trie_cache_;
+    TrieNodeCache storage_trie_cache_;
+    Bytes caches_root_node_;  // The root node of TrieOfAccounts the caches have been filled from
+};
+
+}  // namespace silkworm::trie
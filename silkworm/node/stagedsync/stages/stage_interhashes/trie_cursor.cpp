@@ -70,8 +70,9 @@ void SubNode::parse(ByteView k, ByteView v) {
     deleted = false;
 }
 
-TrieCursor::TrieCursor(db::ROCursor& db_cursor, PrefixSet* changed, etl::Collector* collector)
-    : db_cursor_(db_cursor), changed_list_{changed}, collector_{collector} {
+TrieCursor::TrieCursor(db::ROCursor& db_cursor, PrefixSet* changed, etl::Collector* collector,
+                       TrieNodeCache* cache)
+    : db_cursor_(db_cursor), changed_list_{changed}, collector_{collector}, cache_{cache} {
     curr_key_.reserve(64);
     prev_key_.reserve(64);
     prefix_.reserve(64);
@@ -219,20 +220,42 @@ TrieCursor::move_operation_result TrieCursor::to_next() {
 bool TrieCursor::db_seek(ByteView seek_key) {
     buffer_.assign(prefix_).append(seek_key);
     const auto buffer_slice{db::to_slice(buffer_)};
-    auto data{buffer_.empty() ? db_cursor_.to_first(false) : db_cursor_.lower_bound(buffer_slice, false)};
-    if (!data || !data.key.starts_with(buffer_slice)) {
-        return false;
+    const uint32_t node_level{level_ + (seek_key.empty() ? 0 : 1u)};  // Down one level for child node. Stay at zero for root node
+
+    ByteView db_cursor_key;  // Save db_cursor_ key ...
+    ByteView db_cursor_val;  // ... and value
+    const bool cacheable{cache_ != nullptr && cache_->is_cacheable(buffer_)};
+    if (const TrieNodeCache::Entry * cached{cacheable ? cache_->find(buffer_) : nullptr}; cached != nullptr) {
+        if (!cached->found) {
+            return false;
+        }
+        // Copy as the cache may evict the entry while the node is in use
+        auto& [cached_key, cached_value]{cached_nodes_[node_level]};
+        cached_key.assign(cached->key);
+        cached_value.assign(cached->value);
+        db_cursor_key = cached_key;
+        db_cursor_val = cached_value;
+    } else {
+        auto data{buffer_.empty() ? db_cursor_.to_first(false) : db_cursor_.lower_bound(buffer_slice, false)};
+        const bool found{data && data.key.starts_with(buffer_slice)};
+        if (cacheable) {
+            cache_->put(buffer_, found ? TrieNodeCache::Entry{true, Bytes{db::from_slice(data.key)}, Bytes{db::from_slice(data.value)}}
+                                       : TrieNodeCache::Entry{});
+        }
+        if (!found) {
+            return false;
+        }
+        db_cursor_key = db::from_slice(data.key);
+        db_cursor_val = db::from_slice(data.value);
     }
 
-    ByteView db_cursor_key{db::from_slice(data.key)};  // Save db_cursor_ key ...
-    db_cursor_key.remove_prefix(prefix_.length());     // ... and remove prefix_ so we have node key
+    db_cursor_key.remove_prefix(prefix_.length());  // ... and remove prefix_ so we have node key
     if (seek_key.empty() && !db_cursor_key.empty()) {
         // Note ! an empty seek_key means we're looking for a root node with empty key which does not exist
         return false;
     }
 
-    ByteView db_cursor_val{db::from_slice(data.value)};  // Save db_cursor_ value
-    level_ += seek_key.empty() ? 0 : 1u;                 // Down one level for child node. Stay at zero for root node
+    level_ = node_level;
     auto& new_node{sub_nodes_[level_]};
     new_node.parse(db_cursor_key, db_cursor_val);
     return true;
@@ -20,6 +20,7 @@
 #include <silkworm/core/trie/prefix_set.hpp>
 #include <silkworm/node/db/mdbx.hpp>
 #include <silkworm/node/etl/collector.hpp>
+#include <silkworm/node/stagedsync/stages/stage_interhashes/trie_node_cache.hpp>
 
 namespace silkworm::trie {
 
@@ -71,7 +72,8 @@ class SubNode : public Node {
 
 class TrieCursor {
   public:
-    explicit TrieCursor(db::ROCursor& db_cursor, PrefixSet* changed, etl::Collector* collector = nullptr);
+    explicit TrieCursor(db::ROCursor& db_cursor, PrefixSet* changed, etl::Collector* collector = nullptr,
+                        TrieNodeCache* cache = nullptr);
 
     // Not copyable nor movable
     TrieCursor(const TrieCursor&) = delete;
@@ -99,6 +101,9 @@ class TrieCursor {
     bool skip_state_{true};                  // Whether account(s) state scan can be skipped
     std::array<SubNode, 32> sub_nodes_{{}};  // Collection of sub-nodes being unrolled
 
+    // Keys and values of the sub-nodes served by cache_ (if any), as sub_nodes_ only hold views
+    std::array<std::pair<Bytes, Bytes>, 32> cached_nodes_{};
+
     Bytes prefix_{};  // Db key prefix for this trie (0 bytes TrieAccount - 40 bytes TrieStorage)
     Bytes buffer_{};  // A convenience buffer
 
@@ -106,6 +111,7 @@ class TrieCursor {
     PrefixSet* changed_list_;    // The collection of changed nibbled keys
     ByteView next_created_{};    // The next created account/location in changed list
     etl::Collector* collector_;  // Pointer to a collector for deletion of obsolete keys
+    TrieNodeCache* cache_;       // Pointer to a cache of the upper nodes (if any)
 
     bool db_seek(ByteView seek_key);  // Seeks lowerbound of provided key using db_cursor_
     void db_delete(SubNode& node);    // Collects deletion of node being rebuilt or no longer needed
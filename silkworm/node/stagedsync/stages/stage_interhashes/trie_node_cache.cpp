@@ -0,0 +1,55 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "trie_node_cache.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include <silkworm/core/common/cast.hpp>
+
+namespace silkworm::trie {
+
+TrieNodeCache::TrieNodeCache(std::size_t max_size, std::size_t prefix_length)
+    : prefix_length_{prefix_length}, entries_{max_size} {}
+
+bool TrieNodeCache::is_cacheable(ByteView seek_key) const noexcept {
+    return seek_key.length() >= prefix_length_ && seek_key.length() - prefix_length_ <= kMaxCachedDepth;
+}
+
+const TrieNodeCache::Entry* TrieNodeCache::find(ByteView seek_key) {
+    const Entry* entry{entries_.get(std::string{byte_view_to_string_view(seek_key)})};
+    ++(entry ? hits_ : misses_);
+    return entry;
+}
+
+void TrieNodeCache::put(ByteView seek_key, Entry entry) {
+    entries_.put(std::string{byte_view_to_string_view(seek_key)}, std::move(entry));
+}
+
+void TrieNodeCache::invalidate(ByteView node_key) {
+    if (node_key.length() < prefix_length_ || entries_.size() == 0) {
+        return;
+    }
+    const std::size_t max_length{std::min(node_key.length(), prefix_length_ + kMaxCachedDepth)};
+    for (std::size_t length{prefix_length_}; length <= max_length; ++length) {
+        entries_.remove(std::string{byte_view_to_string_view(node_key.substr(0, length))});
+    }
+}
+
+void TrieNodeCache::clear() { entries_.clear(); }
+
+}  // namespace silkworm::trie
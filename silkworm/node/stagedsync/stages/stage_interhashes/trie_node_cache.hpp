@@ -0,0 +1,77 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <silkworm/core/common/base.hpp>
+#include <silkworm/core/common/lru_cache.hpp>
+
+namespace silkworm::trie {
+
+//! \brief Bounded cache of the outcomes of TrieCursor seeks for the upper nodes of TrieOfAccounts or TrieOfStorage,
+//! i.e. the ones read again and again by each incremental computation of the state root
+//! \remarks The cache must be told about every node written or deleted (see invalidate), not being thread safe it is
+//! used by one cursor at a time
+class TrieNodeCache {
+  public:
+    //! The max length in nibbles of the sought keys (after the table prefix) whose nodes are cached
+    static constexpr std::size_t kMaxCachedDepth{5};
+
+    //! \brief The outcome of a seek, i.e. the first node whose key starts with the sought one (if any)
+    struct Entry {
+        bool found{false};
+        Bytes key;  // Full db key of the node
+        Bytes value;
+    };
+
+    //! \param max_size [in] : the max number of cached seeks
+    //! \param prefix_length [in] : the length of the table prefix (0 bytes TrieAccount - 40 bytes TrieStorage)
+    explicit TrieNodeCache(std::size_t max_size, std::size_t prefix_length = 0);
+
+    // Not copyable nor movable
+    TrieNodeCache(const TrieNodeCache&) = delete;
+    TrieNodeCache& operator=(const TrieNodeCache&) = delete;
+
+    //! \brief Whether the nodes sought with this key (table prefix included) are to be cached
+    [[nodiscard]] bool is_cacheable(ByteView seek_key) const noexcept;
+
+    //! \brief The outcome of a previous seek, nullptr if not cached
+    //! \remarks The entry may be evicted by the next put
+    [[nodiscard]] const Entry* find(ByteView seek_key);
+
+    void put(ByteView seek_key, Entry entry);
+
+    //! \brief Forgets the seeks whose outcome a write or deletion of the node may change, i.e. the ones for its prefixes
+    void invalidate(ByteView node_key);
+
+    void clear();
+
+    [[nodiscard]] std::size_t size() const noexcept { return entries_.size(); }
+    [[nodiscard]] uint64_t hits() const noexcept { return hits_; }
+    [[nodiscard]] uint64_t misses() const noexcept { return misses_; }
+
+  private:
+    std::size_t prefix_length_;
+    lru_cache<std::string, Entry> entries_;  // sought key -> outcome
+    uint64_t hits_{0};
+    uint64_t misses_{0};
+};
+
+}  // namespace silkworm::trie
@@ -63,6 +63,8 @@ class LogIndex : public Stage {
 
     void reset_log_progress();  // Clears out all logging vars
 
+  public:
+    //! \brief Decoder of CBOR encoded logs forwarding every byte string (addresses, topics and data)
     using cbor_function = std::function<void(unsigned char*, int)>;
     class CborListener : public cbor::listener {
       public:
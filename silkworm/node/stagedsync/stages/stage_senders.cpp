@@ -17,6 +17,8 @@
 #include "stage_senders.hpp"
 
 #include <algorithm>
+#include <cstring>
+#include <optional>
 #include <stdexcept>
 #include <thread>
 
@@ -24,11 +26,12 @@
 #include <magic_enum.hpp>
 
 #include <silkworm/core/common/assert.hpp>
-#include <silkworm/core/crypto/ecdsa.h>
 #include <silkworm/core/crypto/secp256k1n.hpp>
+#include <silkworm/core/crypto/signer_recovery.hpp>
 #include <silkworm/core/protocol/validation.hpp>
 #include <silkworm/infra/common/stopwatch.hpp>
 #include <silkworm/node/db/access_layer.hpp>
+#include <silkworm/node/stagedsync/block_preverifier.hpp>
 #include <eosevm/version.hpp>
 using namespace eosevm;
 namespace silkworm::stagedsync {
@@ -241,12 +244,6 @@ Stage::Result Senders::prune(db::RWTxn& txn) {
 }
 
 Stage::Result Senders::parallel_recover(db::RWTxn& txn) {
-
-    // secp256k1_context is thread safe and can be reused, but the creation is expensive (~10ms)
-    static secp256k1_context* context = secp256k1_context_create(SILKWORM_SECP256K1_CONTEXT_FLAGS);
-    // release only when the process exits
-    static auto _ = gsl::finally([&]() { if (context) secp256k1_context_destroy(context); });
-
     Stage::Result ret{Stage::Result::kSuccess};
     try {
         db::DataModel data_model{txn};
@@ -267,8 +264,22 @@ Stage::Result Senders::parallel_recover(db::RWTxn& txn) {
                                                                   " > target progress " + std::to_string(target_block_num));
         }
 
+        // Recover the senders as tasks of the node scheduler if any, otherwise of a dedicated one
+        std::optional<concurrency::TaskScheduler> own_scheduler;
+        if (!node_settings_->task_scheduler) {
+            own_scheduler.emplace();
+        }
+        concurrency::TaskScheduler& scheduler{node_settings_->task_scheduler ? *node_settings_->task_scheduler : *own_scheduler};
+        // Any recovery task still running must complete before leaving, also on error
+        auto recovery_tasks_wait = gsl::finally([&]() {
+            for (auto& batch_result : results_) {
+                if (batch_result.valid()) batch_result.wait();
+            }
+            results_.clear();
+        });
+
         log::Info(log_prefix_, {"op", "parallel_recover",
-                                "num_threads", std::to_string(std::thread::hardware_concurrency()),
+                                "num_threads", std::to_string(scheduler.num_workers()),
                                 "max_batch_size", std::to_string(max_batch_size_)});
 
         BlockNum start_block_num{previous_progress + 1u};
@@ -279,9 +290,6 @@ Stage::Result Senders::parallel_recover(db::RWTxn& txn) {
 
         // success_or_throw(read_canonical_hashes(txn, start_block, target_block));  too many hashes to load in memory at first cycle
 
-        // Create the pool of worker threads crunching the address recovery tasks
-        ThreadPool worker_pool;
-
         // Load block transactions from db and recover tx senders in batches
         log::Trace(log_prefix_, {"op", "read bodies",
                                  "from", std::to_string(start_block_num), "to", std::to_string(target_block_num)});
@@ -316,26 +324,36 @@ Stage::Result Senders::parallel_recover(db::RWTxn& txn) {
             if (block_body.transactions.empty()) continue;
 
             total_collected_senders += block_body.transactions.size();
+
+            // Take the senders recovered since the block arrival, if any, rather than recovering them again
+            if (const auto preverification{find_preverification(*current_hash, block_body.transactions.size())}) {
+                success_or_throw(check_transactions(*header, current_block_num, block_body.transactions));
+                collect_senders(current_block_num, *current_hash, preverification->senders());
+                increment_total_processed_blocks();
+                continue;
+            }
+
             success_or_throw(add_to_batch(*header, current_block_num, *current_hash, std::move(block_body.transactions)));
 
             // Process batch in parallel if max size has been reached
             if (batch_->size() >= max_batch_size_) {
                 increment_total_collected_transactions(batch_->size());
-                recover_batch(worker_pool, context);
+                recover_batch(scheduler);
             }
         }
 
         // Recover last incomplete batch [likely]
         if (!batch_->empty()) {
             increment_total_collected_transactions(batch_->size());
-            recover_batch(worker_pool, context);
+            recover_batch(scheduler);
         }
 
         // Wait for all senders to be recovered and collected in ETL
-        while (collected_senders_ != total_collected_senders) {
+        while (!results_.empty()) {
+            scheduler.wait(results_.front());
             collect_senders();
-            std::this_thread::sleep_for(1ms);
         }
+        SILKWORM_ASSERT(collected_senders_ == total_collected_senders);
 
         // Store all recovered senders into db
         log::Trace(log_prefix_, {"op", "store senders", "reached_block_num", std::to_string(target_block_num)});
@@ -364,11 +382,7 @@ Stage::Result Senders::parallel_recover(db::RWTxn& txn) {
     return ret;
 }
 
-Stage::Result Senders::add_to_batch(const BlockHeader& header, BlockNum block_num, Hash block_hash, std::vector<Transaction>&& transactions) {
-    if (is_stopping()) {
-        return Stage::Result::kAborted;
-    }
-
+Stage::Result Senders::check_transactions(const BlockHeader& header, BlockNum block_num, const std::vector<Transaction>& transactions) {
     // We're only interested in revisions up to London, so it's OK to not detect time-based forks.
     const evmc_revision rev{node_settings_->chain_config->revision(header)};
     const bool has_spurious_dragon{rev >= EVMC_SPURIOUS_DRAGON};
@@ -401,6 +415,20 @@ Stage::Result Senders::add_to_batch(const BlockHeader& header, BlockNum block_nu
             }
         }
 
+        ++tx_id;
+    }
+    return Stage::Result::kSuccess;
+}
+
+Stage::Result Senders::add_to_batch(const BlockHeader& header, BlockNum block_num, Hash block_hash, std::vector<Transaction>&& transactions) {
+    if (is_stopping()) {
+        return Stage::Result::kAborted;
+    }
+    if (const auto result{check_transactions(header, block_num, transactions)}; result != Stage::Result::kSuccess) {
+        return result;
+    }
+
+    for (const auto& transaction : transactions) {
         Bytes rlp{};
         transaction.encode_for_signing(rlp);
 
@@ -409,44 +437,66 @@ Stage::Result Senders::add_to_batch(const BlockHeader& header, BlockNum block_nu
         intx::be::unsafe::store(batch_->back().tx_signature + kHashLength, transaction.s);
         batch_->back().rlp = std::move(rlp);
         batch_->back().is_special_signature = is_special_signature(transaction.r, transaction.s);
-
-        ++tx_id;
     }
     increment_total_processed_blocks();
 
     return is_stopping() ? Stage::Result::kAborted : Stage::Result::kSuccess;
 }
 
-void Senders::recover_batch(ThreadPool& worker_pool, secp256k1_context* context) {
+std::shared_ptr<BlockPreverification> Senders::find_preverification(const Hash& block_hash, std::size_t transactions_count) const {
+    if (!node_settings_->block_preverifier) return nullptr;
+    auto preverification{node_settings_->block_preverifier->find(block_hash)};
+    if (preverification && preverification->transactions_count() != transactions_count) return nullptr;
+    return preverification;
+}
+
+void Senders::recover_batch(concurrency::TaskScheduler& scheduler) {
     // Launch parallel senders recovery
     log::Trace(log_prefix_, {"op", "recover_batch", "first", std::to_string(batch_->cbegin()->block_num)});
 
     StopWatch sw;
     const auto start = sw.start();
 
-    // Wait until total unfinished tasks in worker pool falls below 2 * num workers
-    static const auto kMaxUnfinishedTasks{2 * worker_pool.get_thread_count()};
-    while (worker_pool.get_tasks_total() >= kMaxUnfinishedTasks) {
-        std::this_thread::sleep_for(1ms);
+    // Wait until total uncollected batches fall below 2 * num workers, collecting the oldest ones meanwhile
+    const std::size_t max_uncollected_batches{2 * scheduler.num_workers()};
+    while (results_.size() >= max_uncollected_batches) {
+        scheduler.wait(results_.front());
+        collect_senders();
     }
 
-    // Swap the waiting batch w/ an empty one and submit a new recovery task to the worker pool
+    // Swap the waiting batch w/ an empty one and submit a new recovery task to the scheduler
     std::shared_ptr<std::vector<AddressRecovery>> ready_batch{std::make_shared<std::vector<AddressRecovery>>()};
     ready_batch->reserve(max_batch_size_);
     ready_batch.swap(batch_);
-    auto batch_result = worker_pool.submit([=]() {
-        std::for_each(ready_batch->begin(), ready_batch->end(), [&](auto& package) {
-            if(package.is_special_signature) {
+    auto batch_result = scheduler.submit([=]() {
+        // Recover the whole batch at once, sharing the signer cache with execution, RPC and ECREC precompile
+        std::vector<AddressRecovery*> pending;
+        std::vector<SignerRecoveryInput> inputs;
+        pending.reserve(ready_batch->size());
+        inputs.reserve(ready_batch->size());
+        for (auto& package : *ready_batch) {
+            if (package.is_special_signature) {
                 const auto s = intx::be::unsafe::load<intx::uint256>(&package.tx_signature[32]);
                 package.tx_from = decode_special_signature(s);
-            } else {
-                const auto tx_hash{keccak256(package.rlp)};
-                const bool ok = silkworm_recover_address(package.tx_from.bytes, tx_hash.bytes, package.tx_signature, package.odd_y_parity, context);
-                if (!ok) {
-                    throw std::runtime_error("Unable to recover from address in block " + std::to_string(package.block_num));
-                }
+                continue;
             }
-        });
+            const auto tx_hash{keccak256(package.rlp)};
+            SignerRecoveryInput input{.odd_y_parity = package.odd_y_parity};
+            std::memcpy(input.message_hash.bytes, tx_hash.bytes, kHashLength);
+            std::memcpy(input.signature.data(), package.tx_signature, input.signature.size());
+            pending.push_back(&package);
+            inputs.push_back(input);
+        }
+
+        std::vector<std::optional<evmc::address>> senders(inputs.size());
+        // Synced transactions are seen once, so caching their signers would only evict the ones of the tip
+        recover_signers(inputs, senders, /*cache=*/nullptr);
+        for (std::size_t i{0}; i < pending.size(); ++i) {
+            if (!senders[i]) {
+                throw std::runtime_error("Unable to recover from address in block " + std::to_string(pending[i]->block_num));
+            }
+            pending[i]->tx_from = *senders[i];
+        }
         return ready_batch;
     });
     results_.emplace_back(std::move(batch_result));
@@ -505,6 +555,20 @@ void Senders::collect_senders(std::shared_ptr<AddressRecoveryBatch>& batch) {
     if (is_stopping()) throw StageError(Stage::Result::kAborted);
 }
 
+void Senders::collect_senders(BlockNum block_num, const Hash& block_hash, std::span<const std::optional<evmc::address>> senders) {
+    Bytes value;
+    value.reserve(senders.size() * kAddressLength);
+    for (const auto& sender : senders) {
+        if (!sender) {
+            throw std::runtime_error("Unable to recover from address in block " + std::to_string(block_num));
+        }
+        value.append(sender->bytes, kAddressLength);
+    }
+    collector_.collect({db::block_key(block_num, block_hash.bytes), std::move(value)});
+    collected_senders_ += senders.size();
+    increment_total_collected_transactions(senders.size());
+}
+
 void Senders::store_senders(db::RWTxn& txn) {
     if (!collector_.empty()) {
         log::Trace(log_prefix_, {"load ETL items", std::to_string(collector_.size())});
@@ -16,22 +16,24 @@
 
 #pragma once
 
-#include <secp256k1.h>
-
 #include <future>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <span>
 #include <vector>
 
 #include <evmc/evmc.h>
 
 #include <silkworm/core/common/base.hpp>
-#include <silkworm/infra/concurrency/thread_pool.hpp>
+#include <silkworm/infra/concurrency/task_scheduler.hpp>
 #include <silkworm/node/etl/collector.hpp>
 #include <silkworm/node/stagedsync/stages/stage.hpp>
 
 namespace silkworm::stagedsync {
 
+class BlockPreverification;
+
 //! \brief The information to compute the sender address from transaction signature
 struct AddressRecovery {
     BlockNum block_num{0};       // Number of block containing the transaction
@@ -58,10 +60,13 @@ class Senders final : public Stage {
   private:
     Stage::Result parallel_recover(db::RWTxn& txn);
 
+    Stage::Result check_transactions(const BlockHeader& header, BlockNum block_num, const std::vector<Transaction>& transactions);
     Stage::Result add_to_batch(const BlockHeader& header, BlockNum block_num, Hash block_hash, std::vector<Transaction>&& transactions);
-    void recover_batch(ThreadPool& worker_pool, secp256k1_context* context);
+    std::shared_ptr<BlockPreverification> find_preverification(const Hash& block_hash, std::size_t transactions_count) const;
+    void recover_batch(concurrency::TaskScheduler& scheduler);
     void collect_senders();
     void collect_senders(std::shared_ptr<AddressRecoveryBatch>& batch);
+    void collect_senders(BlockNum block_num, const Hash& block_hash, std::span<const std::optional<evmc::address>> senders);
     void store_senders(db::RWTxn& txn);
 
     void increment_total_processed_blocks();
@@ -28,6 +28,7 @@
 
 #include <silkworm/infra/common/log.hpp>
 #include <silkworm/infra/concurrency/awaitable_wait_for_all.hpp>
+#include <silkworm/infra/metrics/registry.hpp>
 
 namespace silkworm::sentry {
 
@@ -91,6 +92,9 @@ Task<void> MessageReceiver::unsubscribe_on_signal(std::shared_ptr<concurrency::E
 }
 
 Task<void> MessageReceiver::receive_messages(std::shared_ptr<rlpx::Peer> peer) {
+    static auto& received_messages{metrics::default_registry().counter(
+        "silkworm_sentry_received_messages_total", "Messages received from peers")};
+
     // loop until DisconnectedError
     while (true) {
         common::Message message;
@@ -99,6 +103,7 @@ Task<void> MessageReceiver::receive_messages(std::shared_ptr<rlpx::Peer> peer) {
         } catch (const rlpx::Peer::DisconnectedError& ex) {
             break;
         }
+        received_messages.inc();
 
         api::api_common::MessageFromPeer message_from_peer{
             std::move(message),
@@ -18,11 +18,16 @@
 
 #include <memory>
 
+#include <silkworm/infra/metrics/registry.hpp>
+
 #include "rlpx/peer.hpp"
 
 namespace silkworm::sentry {
 
 Task<void> MessageSender::start(PeerManager& peer_manager) {
+    static auto& sent_messages{metrics::default_registry().counter(
+        "silkworm_sentry_sent_messages_total", "Messages posted to peers")};
+
     // loop until receive() throws a cancelled exception
     while (true) {
         auto call = co_await send_message_channel_.receive();
@@ -34,6 +39,7 @@ Task<void> MessageSender::start(PeerManager& peer_manager) {
             if (key_opt && (!peer_filter.peer_public_key || (key_opt.value() == peer_filter.peer_public_key.value()))) {
                 sent_peer_keys.push_back(key_opt.value());
                 rlpx::Peer::post_message(peer, message);
+                sent_messages.inc();
             }
         };
 
@@ -23,12 +23,18 @@
 
 #include <silkworm/infra/common/log.hpp>
 #include <silkworm/infra/concurrency/awaitable_wait_for_all.hpp>
+#include <silkworm/infra/metrics/registry.hpp>
 #include <silkworm/sentry/common/random.hpp>
 
 namespace silkworm::sentry {
 
 using namespace boost::asio;
 
+static metrics::Gauge& peers_gauge() {
+    static auto& gauge{metrics::default_registry().gauge("silkworm_sentry_peers", "Peers connected after handshake")};
+    return gauge;
+}
+
 Task<void> PeerManager::start(
     rlpx::Server& server,
     discovery::Discovery& discovery,
@@ -164,12 +170,14 @@ void PeerManager::add_observer(std::weak_ptr<PeerManagerObserver> observer) {
 }
 
 void PeerManager::on_peer_added(const std::shared_ptr<rlpx::Peer>& peer) {
+    peers_gauge().add(1);
     for (auto& observer : observers()) {
         observer->on_peer_added(peer);
     }
 }
 
 void PeerManager::on_peer_removed(const std::shared_ptr<rlpx::Peer>& peer) {
+    peers_gauge().sub(1);
     for (auto& observer : observers()) {
         observer->on_peer_removed(peer);
     }
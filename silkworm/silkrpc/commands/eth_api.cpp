@@ -34,10 +34,12 @@
 #include <silkworm/core/execution/address.hpp>
 #include <silkworm/core/types/transaction.hpp>
 #include <silkworm/infra/common/log.hpp>
+#include <silkworm/node/db/bloom_bits.hpp>
 #include <silkworm/node/db/stages.hpp>
 #include <silkworm/node/db/tables.hpp>
 #include <silkworm/node/db/util.hpp>
 #include <silkworm/silkrpc/common/util.hpp>
+#include <silkworm/silkrpc/core/block_execution_context.hpp>
 #include <silkworm/silkrpc/core/blocks.hpp>
 #include <silkworm/silkrpc/core/cached_chain.hpp>
 #include <silkworm/silkrpc/core/call_many.hpp>
@@ -50,6 +52,7 @@
 #include <silkworm/silkrpc/core/receipts.hpp>
 #include <silkworm/silkrpc/core/state_reader.hpp>
 #include <silkworm/silkrpc/ethdb/bitmap.hpp>
+#include <silkworm/silkrpc/ethdb/bloom_bits.hpp>
 #include <silkworm/silkrpc/ethdb/cbor.hpp>
 #include <silkworm/silkrpc/ethdb/kv/cached_database.hpp>
 #include <silkworm/silkrpc/ethdb/transaction_database.hpp>
@@ -62,8 +65,6 @@
 #include <silkworm/silkrpc/types/syncing_data.hpp>
 #include <silkworm/silkrpc/types/transaction.hpp>
 
-#include <silkworm/silkrpc/core/gas_parameters.hpp>
-
 namespace silkworm::rpc::commands {
 
 awaitable<std::pair<uint64_t, uint64_t>> get_block_numbers(const Filter& filter, const core::rawdb::DatabaseReader& reader) {
@@ -1148,14 +1149,14 @@ awaitable<void> EthereumRpcApi::handle_eth_call(const nlohmann::json& request, s
         silkworm::Transaction txn{call.to_transaction()};
         if(!txn.from.has_value()) txn.from = evmc::address{0};
 
-        const auto [eos_evm_version, gas_params, gas_prices] = co_await load_gas_parameters(tx_database, chain_config_ptr, block_with_hash->block);
+        const auto block_context = co_await load_block_execution_context(workers_, tx_database, *chain_config_ptr, block_with_hash->block);
 
         const core::rawdb::DatabaseReader& db_reader =
             is_latest_block ? static_cast<core::rawdb::DatabaseReader&>(cached_database) : static_cast<core::rawdb::DatabaseReader&>(tx_database);
         const auto execution_result = co_await EVMExecutor::call(
-            *chain_config_ptr, workers_, block_with_hash->block, txn, [&](auto& io_executor, auto block_num) {
+            block_context, workers_, block_with_hash->block, txn, [&](auto& io_executor, auto block_num) {
                 return tx->create_state(io_executor, db_reader, block_num);
-            }, gas_params, gas_prices, eos_evm_version, {}, true, txn.from == evmc::address{0});
+            }, {}, true, txn.from == evmc::address{0});
 
         if (execution_result.success()) {
             make_glaze_json_content(reply, request["id"], execution_result.data);
@@ -1297,7 +1298,7 @@ awaitable<void> EthereumRpcApi::handle_eth_create_access_list(const nlohmann::js
         const auto block_with_hash = co_await core::read_block_by_number_or_hash(*block_cache_, tx_database, block_number_or_hash);
         const auto chain_id = co_await core::rawdb::read_chain_id(tx_database);
         const auto chain_config_ptr = lookup_chain_config(chain_id);
-        const auto [eos_evm_version, gas_params, gas_prices] = co_await load_gas_parameters(tx_database, chain_config_ptr, block_with_hash->block);
+        const auto block_context = co_await load_block_execution_context(workers_, tx_database, *chain_config_ptr, block_with_hash->block);
 
         const bool is_latest_block = co_await core::get_latest_executed_block_number(tx_database) == block_with_hash->block.header.number;
         const core::rawdb::DatabaseReader& db_reader =
@@ -1336,9 +1337,9 @@ awaitable<void> EthereumRpcApi::handle_eth_create_access_list(const nlohmann::js
 
             Tracers tracers{tracer};
             const auto execution_result = co_await EVMExecutor::call(
-                *chain_config_ptr, workers_, block_with_hash->block, txn, [&](auto& io_executor, auto block_num) {
+                block_context, workers_, block_with_hash->block, txn, [&](auto& io_executor, auto block_num) {
                     return tx->create_state(io_executor, db_reader, block_num);
-                }, gas_params, gas_prices, eos_evm_version,
+                },
                 std::move(tracers), /* refund */ true, /* gasBailout */ false);
 
             if (execution_result.pre_check_error) {
@@ -1403,7 +1404,7 @@ awaitable<void> EthereumRpcApi::handle_eth_call_bundle(const nlohmann::json& req
         const auto block_with_hash = co_await core::read_block_by_number_or_hash(*block_cache_, tx_database, block_number_or_hash);
         const auto chain_id = co_await core::rawdb::read_chain_id(tx_database);
         const auto chain_config_ptr = lookup_chain_config(chain_id);
-        const auto [eos_evm_version, gas_params, gas_prices] = co_await load_gas_parameters(tx_database, chain_config_ptr, block_with_hash->block);
+        const auto block_context = co_await load_block_execution_context(workers_, tx_database, *chain_config_ptr, block_with_hash->block);
 
         const bool is_latest_block = co_await core::get_latest_executed_block_number(tx_database) == block_with_hash->block.header.number;
         const core::rawdb::DatabaseReader& db_reader =
@@ -1427,9 +1428,9 @@ awaitable<void> EthereumRpcApi::handle_eth_call_bundle(const nlohmann::json& req
             }
 
             const auto execution_result = co_await EVMExecutor::call(
-                *chain_config_ptr, workers_, block_with_hash->block, tx_with_block->transaction, [&](auto& io_executor, auto block_num) {
+                block_context, workers_, block_with_hash->block, tx_with_block->transaction, [&](auto& io_executor, auto block_num) {
                     return tx->create_state(io_executor, db_reader, block_num);
-                }, gas_params, gas_prices, eos_evm_version, {}, true, false);
+                }, {}, true, false);
             if (execution_result.pre_check_error) {
                 reply = make_json_error(request["id"], -32000, execution_result.pre_check_error.value());
                 error = true;
@@ -2116,7 +2117,7 @@ awaitable<void> EthereumRpcApi::handle_fee_history(const nlohmann::json& request
         const auto chain_id = co_await core::rawdb::read_chain_id(tx_database);
         const auto chain_config_ptr = lookup_chain_config(chain_id);
 
-        rpc::fee_history::FeeHistoryOracle oracle{*chain_config_ptr, block_provider, receipts_provider};
+        rpc::fee_history::FeeHistoryOracle oracle{*chain_config_ptr, block_provider, receipts_provider, block_rewards_cache_};
 
         const auto block_number = co_await core::get_block_number(newest_block, tx_database);
         auto fee_history = co_await oracle.fee_history(block_number, block_count, reward_percentile);
@@ -2140,34 +2141,51 @@ awaitable<void> EthereumRpcApi::handle_fee_history(const nlohmann::json& request
 
 awaitable<void> EthereumRpcApi::get_logs(ethdb::TransactionDatabase& tx_database, std::uint64_t start, std::uint64_t end,
                                          FilterAddresses& addresses, FilterTopics& topics, std::vector<Log>& logs) {
-    SILK_INFO << "start block: " << start << " end block: " << end;
+    SILK_DEBUG << "start block: " << start << " end block: " << end;
 
     roaring::Roaring64Map block_numbers(roaring::api::roaring_bitmap_from_range(start, end+1, 1));
 
     SILK_DEBUG << "block_numbers.cardinality(): " << block_numbers.cardinality();
 
-    if (!topics.empty()) {
-        auto topics_bitmap = co_await ethdb::bitmap::from_topics(tx_database, db::table::kLogTopicIndexName, topics, start, end);
-        SILK_TRACE << "topics_bitmap: " << topics_bitmap.toString();
-        if (topics_bitmap.isEmpty()) {
-            block_numbers = topics_bitmap;
-        } else {
-            block_numbers &= topics_bitmap;
-        }
+    // On wide ranges match the bloom bits sections first, the per-key indexes are then used just for the blocks
+    // not covered by any section (e.g. the tail not yet making up a complete section)
+    roaring::Roaring64Map bloom_candidates;
+    if ((!addresses.empty() || !topics.empty()) && end - start + 1 >= db::bloom_bits::kSectionSize) {
+        auto bloom_match = co_await ethdb::bloom_bits::match(tx_database, addresses, topics, start, end);
+        SILK_DEBUG << "bloom_match.candidates.cardinality(): " << bloom_match.candidates.cardinality();
+        block_numbers -= bloom_match.indexed;
+        bloom_candidates = std::move(bloom_match.candidates);
     }
-    SILK_DEBUG << "block_numbers.cardinality(): " << block_numbers.cardinality();
-    SILK_TRACE << "block_numbers: " << block_numbers.toString();
 
-    if (!addresses.empty()) {
-        auto addresses_bitmap = co_await ethdb::bitmap::from_addresses(tx_database, db::table::kLogAddressIndexName, addresses, start, end);
-        if (addresses_bitmap.isEmpty()) {
-            block_numbers = addresses_bitmap;
-        } else {
-            block_numbers &= addresses_bitmap;
+    if (!block_numbers.isEmpty()) {
+        const auto first{block_numbers.minimum()};
+        const auto last{block_numbers.maximum()};
+
+        if (!topics.empty()) {
+            auto topics_bitmap = co_await ethdb::bitmap::from_topics(tx_database, db::table::kLogTopicIndexName, topics, first, last);
+            SILK_TRACE << "topics_bitmap: " << topics_bitmap.toString();
+            if (topics_bitmap.isEmpty()) {
+                block_numbers = topics_bitmap;
+            } else {
+                block_numbers &= topics_bitmap;
+            }
         }
+        SILK_DEBUG << "block_numbers.cardinality(): " << block_numbers.cardinality();
+        SILK_TRACE << "block_numbers: " << block_numbers.toString();
+
+        if (!addresses.empty()) {
+            auto addresses_bitmap = co_await ethdb::bitmap::from_addresses(tx_database, db::table::kLogAddressIndexName, addresses, first, last);
+            if (addresses_bitmap.isEmpty()) {
+                block_numbers = addresses_bitmap;
+            } else {
+                block_numbers &= addresses_bitmap;
+            }
+        }
+        SILK_DEBUG << "block_numbers.cardinality(): " << block_numbers.cardinality();
+        SILK_TRACE << "block_numbers: " << block_numbers.toString();
     }
-    SILK_DEBUG << "block_numbers.cardinality(): " << block_numbers.cardinality();
-    SILK_TRACE << "block_numbers: " << block_numbers.toString();
+
+    block_numbers |= bloom_candidates;
 
     if (block_numbers.cardinality() == 0) {
         co_return;
@@ -2223,7 +2241,7 @@ awaitable<void> EthereumRpcApi::get_logs(ethdb::TransactionDatabase& tx_database
             logs.insert(logs.end(), filtered_block_logs.begin(), filtered_block_logs.end());
         }
     }
-    SILK_INFO << "logs.size(): " << logs.size();
+    SILK_DEBUG << "logs.size(): " << logs.size();
 
     co_return;
 }
@@ -29,6 +29,7 @@
 #include <silkworm/infra/concurrency/private_service.hpp>
 #include <silkworm/infra/concurrency/shared_service.hpp>
 #include <silkworm/silkrpc/common/block_cache.hpp>
+#include <silkworm/silkrpc/core/fee_history_oracle.hpp>
 #include <silkworm/silkrpc/core/filter_storage.hpp>
 #include <silkworm/silkrpc/core/rawdb/accessors.hpp>
 #include <silkworm/silkrpc/ethbackend/backend.hpp>
@@ -62,6 +63,7 @@ class EthereumRpcApi {
           miner_{must_use_private_service<txpool::Miner>(io_context_)},
           tx_pool_{must_use_private_service<txpool::TransactionPool>(io_context_)},
           filter_storage_{must_use_shared_service<FilterStorage>(io_context_)},
+          block_rewards_cache_{must_use_shared_service<fee_history::BlockRewardsCache>(io_context_)},
           workers_{workers} {}
 
     virtual ~EthereumRpcApi() = default;
@@ -138,6 +140,7 @@ class EthereumRpcApi {
     txpool::Miner* miner_;
     txpool::TransactionPool* tx_pool_;
     FilterStorage* filter_storage_;
+    fee_history::BlockRewardsCache* block_rewards_cache_;
     boost::asio::thread_pool& workers_;
 
     friend class silkworm::http::RequestHandler;
@@ -0,0 +1,82 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "block_execution_context.hpp"
+
+#include <algorithm>
+
+#include <silkworm/core/common/assert.hpp>
+#include <silkworm/core/protocol/rule_set.hpp>
+#include <silkworm/infra/common/log.hpp>
+#include <silkworm/silkrpc/core/gas_parameters.hpp>
+#include <silkworm/silkrpc/core/rawdb/chain.hpp>
+
+namespace silkworm::rpc {
+
+std::shared_ptr<const std::vector<evmc::bytes32>> BlockExecutionContext::ancestor_hashes() const {
+    std::scoped_lock lock{ancestor_hashes_mutex_};
+    return ancestor_hashes_;
+}
+
+void BlockExecutionContext::publish_ancestor_hashes(const std::vector<evmc::bytes32>& hashes) const {
+    // EVM leaves zero hashes for the headers not found, don't make them stick
+    const auto known_end{std::find(hashes.cbegin(), hashes.cend(), evmc::bytes32{})};
+    const auto known_size{static_cast<std::size_t>(known_end - hashes.cbegin())};
+
+    std::scoped_lock lock{ancestor_hashes_mutex_};
+    if (ancestor_hashes_ && ancestor_hashes_->size() >= known_size) return;
+    ancestor_hashes_ = std::make_shared<const std::vector<evmc::bytes32>>(hashes.cbegin(), known_end);
+}
+
+boost::asio::awaitable<std::shared_ptr<const BlockExecutionContext>> build_block_execution_context(
+    const core::rawdb::DatabaseReader& reader, const ChainConfig& config, const Block& block) {
+    auto context{std::make_shared<BlockExecutionContext>()};
+    context->block_hash = block.header.hash();
+    context->header = block.header;
+    context->config = &config;
+    context->revision = config.revision(block.header);
+
+    const auto rule_set{protocol::rule_set_factory(config)};
+    SILKWORM_ASSERT(rule_set);
+    context->beneficiary = rule_set->get_beneficiary(block.header);
+
+    std::tie(context->eos_evm_version, context->gas_params, context->gas_prices) =
+        co_await load_gas_parameters(reader, &config, block);
+
+    co_return context;
+}
+
+boost::asio::awaitable<std::shared_ptr<const BlockExecutionContext>> load_block_execution_context(
+    BlockExecutionContextCache& cache, const core::rawdb::DatabaseReader& reader, const ChainConfig& config, const Block& block) {
+    const auto block_hash{block.header.hash()};
+    const auto cached_context{cache.get(block_hash)};
+    if (cached_context) {
+        SILK_TRACE << "load_block_execution_context: hit for block " << block.header.number;
+        co_return *cached_context;
+    }
+
+    auto context{co_await build_block_execution_context(reader, config, block)};
+    cache.insert(block_hash, context);
+    co_return context;
+}
+
+boost::asio::awaitable<std::shared_ptr<const BlockExecutionContext>> load_block_execution_context(
+    boost::asio::execution_context& workers, const core::rawdb::DatabaseReader& reader, const ChainConfig& config, const Block& block) {
+    auto& cache{boost::asio::use_service<BlockExecutionContextService>(workers).get_cache()};
+    co_return co_await load_block_execution_context(cache, reader, config, block);
+}
+
+}  // namespace silkworm::rpc
@@ -0,0 +1,113 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/execution_context.hpp>
+#include <evmc/evmc.hpp>
+#include <evmone/execution_state.hpp>
+
+#include <silkworm/core/chain/config.hpp>
+#include <silkworm/core/common/lru_cache.hpp>
+#include <silkworm/core/types/block.hpp>
+#include <silkworm/core/types/gas_prices.hpp>
+#include <silkworm/silkrpc/core/rawdb/accessors.hpp>
+
+namespace silkworm::rpc {
+
+//! The per-block inputs of EVM execution, built once and shared read-only by all the calls executed on top of the block
+//! @details The ancestor hashes are the only part filled later: the first executions walking the headers back on
+//! BLOCKHASH publish what they found, so that next executions on the same block find them in memory
+struct BlockExecutionContext {
+    evmc::bytes32 block_hash;
+    BlockHeader header;
+    const ChainConfig* config{nullptr};
+    evmc_revision revision{EVMC_FRONTIER};
+    evmc::address beneficiary;  // as given by the protocol rule set
+
+    uint64_t eos_evm_version{0};
+    evmone::gas_parameters gas_params;
+    gas_prices_t gas_prices;
+
+    [[nodiscard]] std::tuple<uint64_t, evmone::gas_parameters, gas_prices_t> gas_parameters() const {
+        return {eos_evm_version, gas_params, gas_prices};
+    }
+
+    //! Whether this context has been built for the given block
+    [[nodiscard]] bool matches(const Block& block) const { return header == block.header; }
+
+    //! The hashes of the ancestors known so far, parent first
+    [[nodiscard]] std::shared_ptr<const std::vector<evmc::bytes32>> ancestor_hashes() const;
+
+    //! Publish the hashes of the ancestors walked by an execution, if they are more than the ones already known
+    void publish_ancestor_hashes(const std::vector<evmc::bytes32>& hashes) const;
+
+  private:
+    mutable std::mutex ancestor_hashes_mutex_;
+    mutable std::shared_ptr<const std::vector<evmc::bytes32>> ancestor_hashes_;
+};
+
+class BlockExecutionContextCache {
+  public:
+    explicit BlockExecutionContextCache(std::size_t capacity = 128, bool shared_cache = true)
+        : context_cache_(capacity, shared_cache) {}
+
+    std::optional<std::shared_ptr<const BlockExecutionContext>> get(const evmc::bytes32& block_hash) {
+        return context_cache_.get_as_copy(block_hash);
+    }
+
+    void insert(const evmc::bytes32& block_hash, std::shared_ptr<const BlockExecutionContext> context) {
+        context_cache_.put(block_hash, std::move(context));
+    }
+
+  private:
+    lru_cache<evmc::bytes32, std::shared_ptr<const BlockExecutionContext>> context_cache_;
+};
+
+//! The block execution context cache shared by the tasks posted to the workers
+class BlockExecutionContextService : public boost::asio::detail::execution_context_service_base<BlockExecutionContextService> {
+  public:
+    explicit BlockExecutionContextService(boost::asio::execution_context& owner)
+        : boost::asio::detail::execution_context_service_base<BlockExecutionContextService>(owner) {}
+
+    void shutdown() override {}
+    BlockExecutionContextCache& get_cache() { return cache_; }
+
+  private:
+    BlockExecutionContextCache cache_;
+};
+
+//! Build the execution context of the block
+boost::asio::awaitable<std::shared_ptr<const BlockExecutionContext>> build_block_execution_context(
+    const core::rawdb::DatabaseReader& reader, const ChainConfig& config, const Block& block);
+
+//! Get the execution context of the block from the cache, building it on misses
+boost::asio::awaitable<std::shared_ptr<const BlockExecutionContext>> load_block_execution_context(
+    BlockExecutionContextCache& cache, const core::rawdb::DatabaseReader& reader, const ChainConfig& config, const Block& block);
+
+//! Get the execution context of the block from the cache attached to the workers
+boost::asio::awaitable<std::shared_ptr<const BlockExecutionContext>> load_block_execution_context(
+    boost::asio::execution_context& workers, const core::rawdb::DatabaseReader& reader, const ChainConfig& config, const Block& block);
+
+}  // namespace silkworm::rpc
@@ -0,0 +1,108 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "block_execution_context.hpp"
+
+#include <silkworm/infra/concurrency/coroutine.hpp>
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/thread_pool.hpp>
+#include <boost/asio/use_future.hpp>
+#include <catch2/catch.hpp>
+
+#include <silkworm/silkrpc/test/mock_database_reader.hpp>
+
+namespace silkworm::rpc {
+
+using evmc::literals::operator""_address, evmc::literals::operator""_bytes32;
+
+static const evmc::bytes32 kHash1{0x374f3a049e006f36f6cf91b02a3b0ee16c858af2f75858733eb0e927b5b7126c_bytes32};
+static const evmc::bytes32 kHash2{0x439816753229fc0736bf86a5048de4bc9fcdede8c91dadf88c828c76b2281dff_bytes32};
+static const evmc::bytes32 kHash3{0x209f062567c161c5f71b3f57a7de277b0e95c3455050b152d785ad7524ef8ee7_bytes32};
+
+TEST_CASE("BlockExecutionContextCache", "[silkrpc][core][block_execution_context]") {
+    BlockExecutionContextCache cache(1, true);
+    CHECK(!cache.get(kHash1));
+
+    auto context1 = std::make_shared<BlockExecutionContext>();
+    cache.insert(kHash1, context1);
+    const auto cached_context1{cache.get(kHash1)};
+    REQUIRE(cached_context1);
+    CHECK(*cached_context1 == context1);
+
+    cache.insert(kHash2, std::make_shared<BlockExecutionContext>());
+    CHECK(!cache.get(kHash1));
+    CHECK(cache.get(kHash2));
+}
+
+TEST_CASE("BlockExecutionContext::publish_ancestor_hashes", "[silkrpc][core][block_execution_context]") {
+    BlockExecutionContext context;
+    CHECK(!context.ancestor_hashes());
+
+    SECTION("known hashes only") {
+        context.publish_ancestor_hashes({kHash1, evmc::bytes32{}, kHash2});
+        REQUIRE(context.ancestor_hashes());
+        CHECK(*context.ancestor_hashes() == std::vector<evmc::bytes32>{kHash1});
+
+        context.publish_ancestor_hashes({evmc::bytes32{}});
+        CHECK(*context.ancestor_hashes() == std::vector<evmc::bytes32>{kHash1});
+    }
+
+    SECTION("longest walk wins") {
+        context.publish_ancestor_hashes({kHash1, kHash2});
+        const auto published{context.ancestor_hashes()};
+
+        context.publish_ancestor_hashes({kHash1});
+        CHECK(context.ancestor_hashes() == published);
+
+        context.publish_ancestor_hashes({kHash1, kHash2, kHash3});
+        CHECK(*context.ancestor_hashes() == std::vector<evmc::bytes32>{kHash1, kHash2, kHash3});
+        CHECK(*published == std::vector<evmc::bytes32>{kHash1, kHash2});
+    }
+}
+
+TEST_CASE("load_block_execution_context", "[silkrpc][core][block_execution_context]") {
+    boost::asio::thread_pool pool{1};
+    test::MockDatabaseReader db_reader;
+    BlockExecutionContextCache cache;
+
+    Block block;
+    block.header.number = 15'537'394;
+    block.header.beneficiary = 0x4675c7e5baafbffbca748158becba61ef3b0a263_address;
+
+    auto result = boost::asio::co_spawn(pool, load_block_execution_context(cache, db_reader, kMainnetConfig, block), boost::asio::use_future);
+    const auto context{result.get()};
+    REQUIRE(context);
+    CHECK(context->block_hash == block.header.hash());
+    CHECK(context->matches(block));
+    CHECK(context->revision == kMainnetConfig.revision(block.header));
+    CHECK(context->beneficiary == block.header.beneficiary);
+    CHECK(context->eos_evm_version == 0);
+
+    SECTION("cache hit") {
+        result = boost::asio::co_spawn(pool, load_block_execution_context(cache, db_reader, kMainnetConfig, block), boost::asio::use_future);
+        CHECK(result.get() == context);
+    }
+
+    SECTION("other block") {
+        block.header.number += 1;
+        CHECK(!context->matches(block));
+        result = boost::asio::co_spawn(pool, load_block_execution_context(cache, db_reader, kMainnetConfig, block), boost::asio::use_future);
+        CHECK(result.get() != context);
+    }
+}
+
+}  // namespace silkworm::rpc
@@ -0,0 +1,53 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "cached_state.hpp"
+
+#include <silkworm/infra/common/log.hpp>
+#include <silkworm/silkrpc/common/util.hpp>
+
+namespace silkworm::rpc::state {
+
+std::optional<silkworm::Account> CachedState::read_account(const evmc::address& address) const noexcept {
+    return read_through(accounts_, address, [&]() {
+        SILK_DEBUG << "CachedState::read_account miss address=" << address;
+        return inner_state_->read_account(address);
+    });
+}
+
+silkworm::ByteView CachedState::read_code(const evmc::bytes32& code_hash) const noexcept {
+    // Keep our own copy of the code, std::map guarantees stable references for the returned views
+    return read_through(code_, code_hash, [&]() {
+        SILK_DEBUG << "CachedState::read_code miss code_hash=" << code_hash;
+        return silkworm::Bytes{inner_state_->read_code(code_hash)};
+    });
+}
+
+evmc::bytes32 CachedState::read_storage(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& location) const noexcept {
+    return read_through(storage_, StorageKey{address, incarnation, location}, [&]() {
+        SILK_DEBUG << "CachedState::read_storage miss address=" << address << " location=" << location;
+        return inner_state_->read_storage(address, incarnation, location);
+    });
+}
+
+std::optional<silkworm::BlockHeader> CachedState::read_header(uint64_t block_number, const evmc::bytes32& block_hash) const noexcept {
+    return read_through(headers_, std::make_pair(block_number, block_hash), [&]() {
+        SILK_DEBUG << "CachedState::read_header miss block_number=" << block_number << " block_hash=" << block_hash;
+        return inner_state_->read_header(block_number, block_hash);
+    });
+}
+
+}  // namespace silkworm::rpc::state
@@ -0,0 +1,145 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <silkworm/core/state/state.hpp>
+
+namespace silkworm::rpc::state {
+
+//! Read-through cache on top of an immutable state snapshot, safe to share among concurrent EVM executions.
+//! Each state item is read at most once from the inner state and cache hits never wait for pending misses.
+//! The inner state is accessed by one reader at a time, because RemoteState shares one KV transaction stream.
+//! Any write is ignored as in RemoteState.
+class CachedState : public silkworm::State {
+  public:
+    explicit CachedState(std::shared_ptr<silkworm::State> inner_state) : inner_state_{std::move(inner_state)} {}
+
+    std::optional<silkworm::Account> read_account(const evmc::address& address) const noexcept override;
+
+    silkworm::ByteView read_code(const evmc::bytes32& code_hash) const noexcept override;
+
+    evmc::bytes32 read_storage(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& location) const noexcept override;
+
+    uint64_t previous_incarnation(const evmc::address& address) const noexcept override {
+        std::scoped_lock lock{inner_mutex_};
+        return inner_state_->previous_incarnation(address);
+    }
+
+    std::optional<silkworm::BlockHeader> read_header(uint64_t block_number, const evmc::bytes32& block_hash) const noexcept override;
+
+    bool read_body(uint64_t block_number, const evmc::bytes32& block_hash, silkworm::BlockBody& out) const noexcept override {
+        std::scoped_lock lock{inner_mutex_};
+        return inner_state_->read_body(block_number, block_hash, out);
+    }
+
+    std::optional<intx::uint256> total_difficulty(uint64_t block_number, const evmc::bytes32& block_hash) const noexcept override {
+        std::scoped_lock lock{inner_mutex_};
+        return inner_state_->total_difficulty(block_number, block_hash);
+    }
+
+    evmc::bytes32 state_root_hash() const override {
+        std::scoped_lock lock{inner_mutex_};
+        return inner_state_->state_root_hash();
+    }
+
+    uint64_t current_canonical_block() const override {
+        std::scoped_lock lock{inner_mutex_};
+        return inner_state_->current_canonical_block();
+    }
+
+    std::optional<evmc::bytes32> canonical_hash(uint64_t block_number) const override {
+        std::scoped_lock lock{inner_mutex_};
+        return inner_state_->canonical_hash(block_number);
+    }
+
+    void insert_block(const silkworm::Block& /*block*/, const evmc::bytes32& /*hash*/) override {}
+
+    void canonize_block(uint64_t /*block_number*/, const evmc::bytes32& /*block_hash*/) override {}
+
+    void decanonize_block(uint64_t /*block_number*/) override {}
+
+    void insert_receipts(uint64_t /*block_number*/, const std::vector<silkworm::Receipt>& /*receipts*/) override {}
+
+    void begin_block(uint64_t /*block_number*/) override {}
+
+    void update_account(
+        const evmc::address& /*address*/,
+        std::optional<silkworm::Account> /*initial*/,
+        std::optional<silkworm::Account> /*current*/) override {}
+
+    void update_account_code(
+        const evmc::address& /*address*/,
+        uint64_t /*incarnation*/,
+        const evmc::bytes32& /*code_hash*/,
+        silkworm::ByteView /*code*/) override {}
+
+    void update_storage(
+        const evmc::address& /*address*/,
+        uint64_t /*incarnation*/,
+        const evmc::bytes32& /*location*/,
+        const evmc::bytes32& /*initial*/,
+        const evmc::bytes32& /*current*/) override {}
+
+    void unwind_state_changes(uint64_t /*block_number*/) override {}
+
+  private:
+    using StorageKey = std::tuple<evmc::address, uint64_t, evmc::bytes32>;
+
+    //! State item read from the inner state by the first reader, the others waiting for just that item
+    template <typename T>
+    struct CachedItem {
+        std::once_flag loaded;
+        T value{};
+    };
+
+    //! Find or insert the item holding the map mutex, then read it from the inner state (if not yet) holding the inner one
+    template <typename Key, typename T, typename Read>
+    const T& read_through(std::map<Key, CachedItem<T>>& items, const Key& key, Read&& read) const {
+        CachedItem<T>* item{nullptr};
+        {
+            std::scoped_lock lock{mutex_};
+            item = &items.try_emplace(key).first->second;
+        }
+        std::call_once(item->loaded, [&]() {
+            std::scoped_lock lock{inner_mutex_};
+            item->value = read();
+        });
+        return item->value;
+    }
+
+    std::shared_ptr<silkworm::State> inner_state_;
+
+    //! Serializes all the inner state accesses, which may share one non thread-safe KV transaction
+    mutable std::mutex inner_mutex_;
+
+    //! Protects the maps only, whose nodes are never erased so that items stay valid once found
+    mutable std::mutex mutex_;
+    mutable std::map<evmc::address, CachedItem<std::optional<silkworm::Account>>> accounts_;
+    mutable std::map<evmc::bytes32, CachedItem<silkworm::Bytes>> code_;
+    mutable std::map<StorageKey, CachedItem<evmc::bytes32>> storage_;
+    mutable std::map<std::pair<uint64_t, evmc::bytes32>, CachedItem<std::optional<silkworm::BlockHeader>>> headers_;
+};
+
+}  // namespace silkworm::rpc::state
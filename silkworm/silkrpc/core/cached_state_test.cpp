@@ -0,0 +1,204 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "cached_state.hpp"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <evmc/evmc.hpp>
+
+#include <silkworm/core/common/util.hpp>
+#include <silkworm/core/state/in_memory_state.hpp>
+
+namespace silkworm::rpc::state {
+
+using evmc::literals::operator""_address;
+using evmc::literals::operator""_bytes32;
+
+//! In-memory state counting the reads it serves and the ones overlapping, which RemoteState cannot serve safely
+class CountingState : public silkworm::InMemoryState {
+  public:
+    std::optional<silkworm::Account> read_account(const evmc::address& address) const noexcept override {
+        ReadGuard guard{*this};
+        ++account_reads;
+        return InMemoryState::read_account(address);
+    }
+
+    silkworm::ByteView read_code(const evmc::bytes32& code_hash) const noexcept override {
+        ReadGuard guard{*this};
+        ++code_reads;
+        return InMemoryState::read_code(code_hash);
+    }
+
+    evmc::bytes32 read_storage(const evmc::address& address, uint64_t incarnation, const evmc::bytes32& location) const noexcept override {
+        ReadGuard guard{*this};
+        ++storage_reads;
+        return InMemoryState::read_storage(address, incarnation, location);
+    }
+
+    uint64_t previous_incarnation(const evmc::address& address) const noexcept override {
+        ReadGuard guard{*this};
+        return InMemoryState::previous_incarnation(address);
+    }
+
+    mutable std::atomic_int account_reads{0};
+    mutable std::atomic_int code_reads{0};
+    mutable std::atomic_int storage_reads{0};
+    mutable std::atomic_int overlapping_reads{0};
+
+  private:
+    //! Keep each read in flight a little longer to make any overlap between concurrent readers visible
+    struct ReadGuard {
+        explicit ReadGuard(const CountingState& state) : state_{state} {
+            if (++state_.in_flight_reads_ > 1) ++state_.overlapping_reads;
+            std::this_thread::yield();
+        }
+        ~ReadGuard() { --state_.in_flight_reads_; }
+
+        const CountingState& state_;
+    };
+
+    mutable std::atomic_int in_flight_reads_{0};
+};
+
+TEST_CASE("CachedState", "[silkrpc][core][cached_state]") {
+    const auto address{0x6d6cb17fc0a3ea1d6b2f0ec41de99dd8d6e4e2bd_address};
+    const auto location{0x0000000000000000000000000000000000000000000000000000000000000001_bytes32};
+    const auto value{0x00000000000000000000000000000000000000000000000000000000000000ff_bytes32};
+    const silkworm::Bytes code{*silkworm::from_hex("0x6042")};
+    const auto code_hash{0x4b4c4d4e4f505152535455565758595a5b5c5d5e5f606162636465666768696a_bytes32};
+
+    auto inner_state = std::make_shared<CountingState>();
+    silkworm::Account account{.nonce = 1, .balance = 1'000, .code_hash = code_hash, .incarnation = 1};
+    inner_state->update_account(address, std::nullopt, account);
+    inner_state->update_account_code(address, 1, code_hash, code);
+    inner_state->update_storage(address, 1, location, {}, value);
+    CachedState cached_state{inner_state};
+
+    SECTION("read_account reads inner state once") {
+        CHECK(cached_state.read_account(address) == account);
+        CHECK(cached_state.read_account(address) == account);
+        CHECK(inner_state->account_reads == 1);
+    }
+
+    SECTION("read_account caches missing account") {
+        const auto missing_address{0x0000000000000000000000000000000000000001_address};
+        CHECK(!cached_state.read_account(missing_address));
+        CHECK(!cached_state.read_account(missing_address));
+        CHECK(inner_state->account_reads == 1);
+    }
+
+    SECTION("read_code reads inner state once") {
+        CHECK(cached_state.read_code(code_hash) == code);
+        CHECK(cached_state.read_code(code_hash) == code);
+        CHECK(inner_state->code_reads == 1);
+    }
+
+    SECTION("read_storage reads inner state once") {
+        CHECK(cached_state.read_storage(address, 1, location) == value);
+        CHECK(cached_state.read_storage(address, 1, location) == value);
+        CHECK(inner_state->storage_reads == 1);
+        CHECK(cached_state.read_storage(address, 2, location) == evmc::bytes32{});
+        CHECK(inner_state->storage_reads == 2);
+    }
+
+    SECTION("writes do not reach inner state") {
+        silkworm::Account other{.nonce = 2};
+        cached_state.update_account(address, account, other);
+        cached_state.update_storage(address, 1, location, value, {});
+        CHECK(inner_state->read_account(address) == account);
+        CHECK(inner_state->read_storage(address, 1, location) == value);
+    }
+
+    SECTION("concurrent reads") {
+        constexpr int kNumThreads{4};
+        constexpr int kNumReads{1'000};
+        std::atomic_int mismatches{0};
+        std::vector<std::thread> threads;
+        threads.reserve(kNumThreads);
+        for (int t{0}; t < kNumThreads; ++t) {
+            threads.emplace_back([&]() {
+                for (int i{0}; i < kNumReads; ++i) {
+                    if (cached_state.read_account(address) != account) ++mismatches;
+                    if (cached_state.read_code(code_hash) != code) ++mismatches;
+                    if (cached_state.read_storage(address, 1, location) != value) ++mismatches;
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        CHECK(mismatches == 0);
+        CHECK(inner_state->account_reads == 1);
+        CHECK(inner_state->code_reads == 1);
+        CHECK(inner_state->storage_reads == 1);
+    }
+
+    SECTION("concurrent probes serialize inner reads of distinct items") {
+        constexpr int kNumProbes{4};
+        constexpr uint8_t kNumAccounts{64};
+        constexpr uint8_t kNumLocations{16};
+        std::vector<evmc::address> addresses;
+        for (uint8_t i{1}; i <= kNumAccounts; ++i) {
+            evmc::address other_address{};
+            other_address.bytes[19] = i;
+            inner_state->update_account(other_address, std::nullopt, silkworm::Account{.nonce = i, .incarnation = 1});
+            for (uint8_t j{0}; j < kNumLocations; ++j) {
+                evmc::bytes32 other_location{};
+                other_location.bytes[31] = j;
+                evmc::bytes32 other_value{};
+                other_value.bytes[0] = i;
+                other_value.bytes[31] = j;
+                inner_state->update_storage(other_address, 1, other_location, {}, other_value);
+            }
+            addresses.push_back(other_address);
+        }
+
+        std::atomic_int mismatches{0};
+        std::vector<std::thread> probes;
+        probes.reserve(kNumProbes);
+        for (int p{0}; p < kNumProbes; ++p) {
+            probes.emplace_back([&, p]() {
+                // Each probe walks the state in its own order, like EVM executions with different gas limits
+                for (std::size_t k{0}; k < addresses.size(); ++k) {
+                    const auto i{(k * 7 + static_cast<std::size_t>(p) * 13) % addresses.size()};
+                    const auto other_account{cached_state.read_account(addresses[i])};
+                    if (!other_account || other_account->nonce != i + 1) ++mismatches;
+                    cached_state.previous_incarnation(addresses[i]);
+                    for (uint8_t j{0}; j < kNumLocations; ++j) {
+                        evmc::bytes32 other_location{};
+                        other_location.bytes[31] = j;
+                        const auto other_value{cached_state.read_storage(addresses[i], 1, other_location)};
+                        if (other_value.bytes[0] != static_cast<uint8_t>(i + 1) || other_value.bytes[31] != j) ++mismatches;
+                    }
+                }
+            });
+        }
+        for (auto& probe : probes) {
+            probe.join();
+        }
+        CHECK(mismatches == 0);
+        CHECK(inner_state->overlapping_reads == 0);
+        CHECK(inner_state->account_reads == kNumAccounts);
+        CHECK(inner_state->storage_reads == kNumAccounts * kNumLocations);
+    }
+}
+
+}  // namespace silkworm::rpc::state
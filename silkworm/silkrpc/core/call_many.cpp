@@ -33,6 +33,7 @@
 #include <silkworm/infra/common/log.hpp>
 #include <silkworm/silkrpc/common/clock_time.hpp>
 #include <silkworm/silkrpc/common/util.hpp>
+#include <silkworm/silkrpc/core/block_execution_context.hpp>
 #include <silkworm/silkrpc/core/blocks.hpp>
 #include <silkworm/silkrpc/core/cached_chain.hpp>
 #include <silkworm/silkrpc/core/evm_executor.hpp>
@@ -41,7 +42,6 @@
 #include <silkworm/silkrpc/core/remote_state.hpp>
 #include <silkworm/silkrpc/ethdb/kv/cached_database.hpp>
 #include <silkworm/silkrpc/json/types.hpp>
-#include <silkworm/silkrpc/core/gas_parameters.hpp>
 namespace silkworm::rpc::call {
 
 using boost::asio::awaitable;
@@ -54,15 +54,14 @@ CallManyResult CallExecutor::executes_all_bundles(const silkworm::ChainConfig* c
                                                   const AccountsOverrides& accounts_overrides,
                                                   int32_t transaction_index,
                                                   boost::asio::any_io_executor& this_executor,
-                                                  const evmone::gas_parameters& gas_params,
-                                                  const silkworm::gas_prices_t& gas_prices,
-                                                  uint64_t eos_evm_version) {
+                                                  std::shared_ptr<const BlockExecutionContext> block_context) {
     CallManyResult result;
+    const auto [eos_evm_version, gas_params, gas_prices] = block_context->gas_parameters();
     const auto& block = block_with_hash.block;
     const auto& block_transactions = block.transactions;
     auto state = transaction_.create_state(this_executor, tx_database, block.header.number);
     state::OverrideState override_state{*state, accounts_overrides};
-    EVMExecutor executor{*config, workers_, state};
+    EVMExecutor executor{*config, workers_, state, block_context};
 
     std::uint64_t timeout = opt_timeout.value_or(5000);
     const auto start_time = clock_time::now();
@@ -174,13 +173,13 @@ boost::asio::awaitable<CallManyResult> CallExecutor::execute(const Bundles& bund
     if (transaction_index == -1) {
         transaction_index = static_cast<std::int32_t>(block_with_hash->block.transactions.size());
     }
-    const auto [eos_evm_version, gas_params, gas_prices] = co_await load_gas_parameters(tx_database, chain_config_ptr, block_with_hash->block);
+    const auto block_context = co_await load_block_execution_context(workers_, tx_database, *chain_config_ptr, block_with_hash->block);
 
     auto this_executor = co_await boost::asio::this_coro::executor;
     result = co_await boost::asio::async_compose<decltype(boost::asio::use_awaitable), void(CallManyResult)>(
         [&](auto&& self) {
-            boost::asio::post(workers_, [&, self = std::move(self)]() mutable {
-                result = executes_all_bundles(chain_config_ptr, *block_with_hash, tx_database, bundles, opt_timeout, accounts_overrides, transaction_index, this_executor, gas_params, gas_prices, eos_evm_version);
+            post_to_workers(workers_, [&, self = std::move(self)]() mutable {
+                result = executes_all_bundles(chain_config_ptr, *block_with_hash, tx_database, bundles, opt_timeout, accounts_overrides, transaction_index, this_executor, block_context);
                 boost::asio::post(this_executor, [result, self = std::move(self)]() mutable {
                     self.complete(result);
                 });
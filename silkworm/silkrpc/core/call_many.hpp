@@ -17,6 +17,7 @@
 #pragma once
 
 #include <map>
+#include <memory>
 #include <stack>
 #include <string>
 #include <vector>
@@ -32,6 +33,7 @@
 #pragma GCC diagnostic pop
 #include <silkworm/core/state/intra_block_state.hpp>
 #include <silkworm/silkrpc/common/block_cache.hpp>
+#include <silkworm/silkrpc/core/block_execution_context.hpp>
 #include <silkworm/silkrpc/core/evm_executor.hpp>
 #include <silkworm/silkrpc/core/rawdb/accessors.hpp>
 #include <silkworm/silkrpc/ethdb/kv/state_cache.hpp>
@@ -71,9 +73,7 @@ class CallExecutor {
                                         const AccountsOverrides& accounts_overrides,
                                         int32_t transaction_index,
                                         boost::asio::any_io_executor& executor,
-                                        const evmone::gas_parameters& gas_params,
-                                        const silkworm::gas_prices_t& gas_prices,
-                                        uint64_t eos_evm_version);
+                                        std::shared_ptr<const BlockExecutionContext> block_context);
 
   private:
     ethdb::Transaction& transaction_;
@@ -15,16 +15,21 @@
 */
 
 #include "estimate_gas_oracle.hpp"
-#include <silkworm/silkrpc/core/gas_parameters.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
 #include <string>
+#include <utility>
 
 #include <boost/asio/compose.hpp>
 #include <boost/asio/post.hpp>
 #include <boost/asio/use_awaitable.hpp>
 
 #include <silkworm/infra/common/log.hpp>
+#include <silkworm/silkrpc/core/block_execution_context.hpp>
 #include <silkworm/silkrpc/core/blocks.hpp>
+#include <silkworm/silkrpc/core/cached_state.hpp>
 #include <eosevm/version.hpp>
 namespace silkworm::rpc {
 
@@ -78,7 +83,8 @@ boost::asio::awaitable<intx::uint256> EstimateGasOracle::estimate_gas(const Call
 
     SILK_DEBUG << "hi: " << hi << ", lo: " << lo << ", cap: " << cap;
 
-    const auto [eos_evm_version, gas_params, gas_prices_orig] = co_await load_gas_parameters(tx_database_, &config_, block);
+    const auto block_context = co_await load_block_execution_context(workers_, tx_database_, config_, block);
+    const auto [eos_evm_version, gas_params, gas_prices_orig] = block_context->gas_parameters();
     silkworm::Transaction transaction{call.to_transaction()};
 
     // If conservative gas estimation is signaled, assert that inclusion_price is zero and adjust gas_prices if neccesary
@@ -95,57 +101,94 @@ boost::asio::awaitable<intx::uint256> EstimateGasOracle::estimate_gas(const Call
         }
     }
 
+    if (!transaction.from.has_value()) transaction.from = evmc::address{0};
+
+    // All the executions share one read-through cached state, so that each state read is paid once per call
     auto this_executor = co_await boost::asio::this_coro::executor;
-    auto exec_result = co_await boost::asio::async_compose<decltype(boost::asio::use_awaitable), void(ExecutionResult)>(
-        [&](auto&& self) {
-            boost::asio::post(workers_, [&, self = std::move(self)]() mutable {
-                auto state = transaction_.create_state(this_executor, tx_database_, block_number);
-                EVMExecutor executor{config_, workers_, state};
+    std::shared_ptr<silkworm::State> shared_state = std::make_shared<state::CachedState>(transaction_.create_state(this_executor, tx_database_, block_number));
 
-                ExecutionResult result{evmc_status_code::EVMC_SUCCESS};
-                if(!transaction.from.has_value()) transaction.from = evmc::address{0};
-                while (lo + 1 < hi) {
-                    auto mid = (hi + lo) / 2;
-                    transaction.gas_limit = mid;
+    // First execution with the highest gas limit: if it fails, no lower gas limit can succeed
+    auto results = co_await execute_probes(shared_state, block_context, block, transaction, {hi}, eos_evm_version, gas_params, gas_prices);
+    if (!results[0].success()) {
+        throw_exception(results[0], cap);
+    }
 
-                    result = try_execution(executor, block, transaction, eos_evm_version, gas_params, gas_prices);
+    // Gas used net of any refund (including EOS EVM v3 storage/overhead refunds) is a lower bound for the gas limit
+    const uint64_t gas_used = hi - std::min(hi, results[0].gas_left);
+    if (gas_used > lo + 1) {
+        lo = gas_used - 1;
+    }
+    SILK_DEBUG << "gas used at cap: " << gas_used << ", hi: " << hi << ", lo: " << lo;
+
+    // k-ary search: execute several candidate gas limits concurrently and shrink [lo, hi] around the first success
+    while (lo + 1 < hi) {
+        const auto gas_limits = probe_gas_limits(lo, hi);
+        results = co_await execute_probes(shared_state, block_context, block, transaction, gas_limits, eos_evm_version, gas_params, gas_prices);
+
+        std::size_t first_success{0};
+        for (; first_success < gas_limits.size(); ++first_success) {
+            auto& result = results[first_success];
+            if (result.pre_check_error && !result.pre_check_error.value().starts_with("intrinsic gas too low")) {
+                throw_exception(result, cap);
+            }
+            if (result.success()) {
+                break;
+            }
+        }
+        if (first_success < gas_limits.size()) {
+            hi = gas_limits[first_success];
+        }
+        if (first_success > 0) {
+            lo = gas_limits[first_success - 1];
+        }
+    }
 
-                    if(result.pre_check_error && !result.pre_check_error.value().starts_with("intrinsic gas too low")) {
-                        boost::asio::post(this_executor, [result, self = std::move(self)]() mutable {
-                            self.complete(result);
-                        });
-                        return;
-                    }
+    SILK_DEBUG << "EstimateGasOracle::estimate_gas returns " << hi;
+    co_return hi;
+}
+
+std::vector<uint64_t> EstimateGasOracle::probe_gas_limits(uint64_t lo, uint64_t hi) {
+    // Split (lo, hi) into num_probes + 1 equal intervals, all probes are distinct because hi - lo > num_probes
+    const uint64_t num_probes = std::min<uint64_t>(kEstimateGasMaxProbes, hi - lo - 1);
+    std::vector<uint64_t> gas_limits;
+    gas_limits.reserve(num_probes);
+    for (uint64_t i{1}; i <= num_probes; ++i) {
+        gas_limits.push_back(lo + (hi - lo) * i / (num_probes + 1));
+    }
+    return gas_limits;
+}
 
-                    if (result.success()) {
-                        hi = mid;
-                    } else {
-                        lo = mid;
+boost::asio::awaitable<std::vector<ExecutionResult>> EstimateGasOracle::execute_probes(std::shared_ptr<silkworm::State> shared_state,
+                                                                                       std::shared_ptr<const BlockExecutionContext> block_context,
+                                                                                       const silkworm::Block& block,
+                                                                                       const silkworm::Transaction& transaction,
+                                                                                       const std::vector<uint64_t>& gas_limits,
+                                                                                       uint64_t eos_evm_version,
+                                                                                       const evmone::gas_parameters& gas_params,
+                                                                                       const silkworm::gas_prices_t& gas_prices) {
+    auto this_executor = co_await boost::asio::this_coro::executor;
+    std::vector<ExecutionResult> results(gas_limits.size());
+    co_await boost::asio::async_compose<decltype(boost::asio::use_awaitable), void()>(
+        [&](auto&& self) {
+            // Each probe runs on its own worker with its own EVM, the last one to finish resumes the caller
+            auto pending = std::make_shared<std::atomic_size_t>(gas_limits.size());
+            auto completion = std::make_shared<std::decay_t<decltype(self)>>(std::move(self));
+            for (std::size_t i{0}; i < gas_limits.size(); ++i) {
+                post_to_workers(workers_, [&, i, pending, completion]() {
+                    silkworm::Transaction probe{transaction};
+                    probe.gas_limit = gas_limits[i];
+                    EVMExecutor executor{config_, workers_, shared_state, block_context};
+                    results[i] = try_execution(executor, block, probe, eos_evm_version, gas_params, gas_prices);
+                    if (--*pending == 0) {
+                        boost::asio::post(this_executor, [completion]() {
+                            completion->complete();
+                        });
                     }
-                }
-
-                if (hi == cap) {
-                    transaction.gas_limit = hi;
-                    result = try_execution(executor, block, transaction, eos_evm_version, gas_params, gas_prices);
-                    SILK_DEBUG << "HI == cap tested again with " << (result.success() ? "succeed" : "failed");
-                } else {
-                    result.pre_check_error = std::nullopt;
-                    result.error_code = EVMC_SUCCESS;
-                }
-
-                boost::asio::post(this_executor, [result, self = std::move(self)]() mutable {
-                    self.complete(result);
                 });
-            });
+            }
         },
         boost::asio::use_awaitable);
-
-    if (exec_result.success() == false) {
-        throw_exception(exec_result, cap);
-    }
-
-    SILK_DEBUG << "EstimateGasOracle::estimate_gas returns " << hi;
-    co_return hi;
+    co_return results;
 }
 
 ExecutionResult EstimateGasOracle::try_execution(EVMExecutor& executor, const silkworm::Block& block, const silkworm::Transaction& transaction, uint64_t eos_evm_version, const evmone::gas_parameters& gas_params, const silkworm::gas_prices_t& gas_prices) {
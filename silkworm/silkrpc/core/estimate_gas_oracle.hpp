@@ -17,6 +17,7 @@
 #pragma once
 
 #include <functional>
+#include <memory>
 #include <optional>
 #include <string>
 #include <vector>
@@ -28,6 +29,7 @@
 #include <silkworm/core/chain/config.hpp>
 #include <silkworm/core/common/util.hpp>
 #include <silkworm/core/types/block.hpp>
+#include <silkworm/silkrpc/core/block_execution_context.hpp>
 #include <silkworm/silkrpc/core/blocks.hpp>
 #include <silkworm/silkrpc/core/evm_executor.hpp>
 #include <silkworm/silkrpc/core/rawdb/accessors.hpp>
@@ -41,6 +43,9 @@ namespace silkworm::rpc {
 const std::uint64_t kTxGas = 21'000;
 const std::uint64_t kGasCap = 100'000'000;
 
+//! Max number of gas limits executed concurrently at each step of the estimation search
+const std::uint64_t kEstimateGasMaxProbes = 4;
+
 using BlockHeaderProvider = std::function<boost::asio::awaitable<silkworm::BlockHeader>(uint64_t)>;
 using AccountReader = std::function<boost::asio::awaitable<std::optional<silkworm::Account>>(const evmc::address&, uint64_t)>;
 
@@ -92,6 +97,15 @@ class EstimateGasOracle {
     virtual ExecutionResult try_execution(EVMExecutor& executor, const silkworm::Block& _block, const silkworm::Transaction& transaction, uint64_t eos_evm_version, const evmone::gas_parameters& gas_params, const silkworm::gas_prices_t& gas_prices);
 
   private:
+    static std::vector<uint64_t> probe_gas_limits(uint64_t lo, uint64_t hi);
+    boost::asio::awaitable<std::vector<ExecutionResult>> execute_probes(std::shared_ptr<silkworm::State> shared_state,
+                                                                        std::shared_ptr<const BlockExecutionContext> block_context,
+                                                                        const silkworm::Block& block,
+                                                                        const silkworm::Transaction& transaction,
+                                                                        const std::vector<uint64_t>& gas_limits,
+                                                                        uint64_t eos_evm_version,
+                                                                        const evmone::gas_parameters& gas_params,
+                                                                        const silkworm::gas_prices_t& gas_prices);
     void throw_exception(ExecutionResult& result, uint64_t cap);
 
     const BlockHeaderProvider& block_header_provider_;
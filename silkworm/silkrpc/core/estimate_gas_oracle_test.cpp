@@ -46,9 +46,26 @@ struct RemoteDatabaseTest : test::KVTestBase {
 
 using Catch::Matchers::Message;
 using testing::_;
+using testing::Invoke;
 using testing::InvokeWithoutArgs;
 using testing::Return;
 
+// Expected EVM executions: 1 at the cap, then min(kEstimateGasMaxProbes, hi - lo - 1) per round of the k-ary search
+
+//! Simulate a transaction which succeeds iff the gas limit is at least required_gas, reporting gas_used (after refunds)
+static auto execution_requiring(uint64_t required_gas, uint64_t gas_used) {
+    return [=](EVMExecutor&, const silkworm::Block&, const silkworm::Transaction& txn, uint64_t, const evmone::gas_parameters&,
+               const silkworm::gas_prices_t&) -> ExecutionResult {
+        if (txn.gas_limit < kTxGas) {
+            return ExecutionResult{.pre_check_error = "intrinsic gas too low"};
+        }
+        if (txn.gas_limit < required_gas) {
+            return ExecutionResult{.error_code = evmc_status_code::EVMC_OUT_OF_GAS, .gas_left = 0};
+        }
+        return ExecutionResult{.error_code = evmc_status_code::EVMC_SUCCESS, .gas_left = txn.gas_limit - gas_used};
+    };
+}
+
 TEST_CASE("EstimateGasException") {
     silkworm::test::SetLogVerbosityGuard log_guard{log::Level::kNone};
 
@@ -100,27 +117,10 @@ TEST_CASE("estimate gas") {
     ethdb::TransactionDatabase tx_database{*tx};
     MockEstimateGasOracle estimate_gas_oracle{block_header_provider, account_reader, config, workers, *tx, tx_database};
 
-    SECTION("Call empty, always fails but success in last step") {
-        ExecutionResult expect_result_ok{.error_code = evmc_status_code::EVMC_SUCCESS};
-        ExecutionResult expect_result_fail{.pre_check_error = "intrinsic gas too low"};
+    SECTION("Call empty, always fails but success at cap") {
         EXPECT_CALL(estimate_gas_oracle, try_execution(_, _, _, _, _, _))
-            .Times(16)
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillRepeatedly(Return(expect_result_ok));
+            .Times(26)
+            .WillRepeatedly(Invoke(execution_requiring(kTxGas * 2, kTxGas)));
         auto result = boost::asio::co_spawn(pool, estimate_gas_oracle.estimate_gas(call, block), boost::asio::use_future);
         const intx::uint256& estimate_gas = result.get();
 
@@ -128,86 +128,39 @@ TEST_CASE("estimate gas") {
     }
 
     SECTION("Call empty, always succeeds") {
-        ExecutionResult expect_result_ok{.error_code = evmc_status_code::EVMC_SUCCESS};
-        EXPECT_CALL(estimate_gas_oracle, try_execution(_, _, _, _, _, _)).Times(14).WillRepeatedly(Return(expect_result_ok));
+        EXPECT_CALL(estimate_gas_oracle, try_execution(_, _, _, _, _, _))
+            .Times(25)
+            .WillRepeatedly(Invoke(execution_requiring(kTxGas, kTxGas)));
         auto result = boost::asio::co_spawn(pool, estimate_gas_oracle.estimate_gas(call, block), boost::asio::use_future);
         const intx::uint256& estimate_gas = result.get();
         CHECK(estimate_gas == kTxGas);
     }
 
-    SECTION("Call empty, alternatively fails and succeeds") {
-        ExecutionResult expect_result_ok{.error_code = evmc_status_code::EVMC_SUCCESS};
-        ExecutionResult expect_result_fail{.pre_check_error = "intrinsic gas too low"};
+    SECTION("Call empty, succeeds above gas used") {
         EXPECT_CALL(estimate_gas_oracle, try_execution(_, _, _, _, _, _))
-            .Times(14)
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_ok))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_ok))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_ok))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_ok))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_ok))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_ok))
-            .WillOnce(Return(expect_result_fail))
-            .WillRepeatedly(Return(expect_result_ok));
+            .Times(26)
+            .WillRepeatedly(Invoke(execution_requiring(0x88b6, kTxGas)));
         auto result = boost::asio::co_spawn(pool, estimate_gas_oracle.estimate_gas(call, block), boost::asio::use_future);
         const intx::uint256& estimate_gas = result.get();
 
         CHECK(estimate_gas == 0x88b6);
     }
 
-    SECTION("Call empty, alternatively succeeds and fails") {
-        ExecutionResult expect_result_ok{.error_code = evmc_status_code::EVMC_SUCCESS};
-        ExecutionResult expect_result_fail{.pre_check_error = "intrinsic gas too low"};
+    SECTION("Call empty, succeeds just above gas used") {
         EXPECT_CALL(estimate_gas_oracle, try_execution(_, _, _, _, _, _))
-            .Times(14)
-            .WillOnce(Return(expect_result_ok))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_ok))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_ok))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_ok))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_ok))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_ok))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_ok))
-            .WillRepeatedly(Return(expect_result_fail));
+            .Times(24)
+            .WillRepeatedly(Invoke(execution_requiring(0x6d5e, 0x6d5e - 100)));
         auto result = boost::asio::co_spawn(pool, estimate_gas_oracle.estimate_gas(call, block), boost::asio::use_future);
         const intx::uint256& estimate_gas = result.get();
 
         CHECK(estimate_gas == 0x6d5e);
     }
 
-    SECTION("Call with gas, always fails but succes last step") {
+    SECTION("Call with gas, always fails but success at cap") {
         call.gas = kTxGas * 4;
-        ExecutionResult expect_result_ok{.error_code = evmc_status_code::EVMC_SUCCESS};
-        ExecutionResult expect_result_fail{.pre_check_error = "intrinsic gas too low"};
         EXPECT_CALL(estimate_gas_oracle, try_execution(_, _, _, _, _, _))
-            .Times(17)
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillRepeatedly(Return(expect_result_ok));
+            .Times(29)
+            .WillRepeatedly(Invoke(execution_requiring(kTxGas * 4, kTxGas)));
         auto result = boost::asio::co_spawn(pool, estimate_gas_oracle.estimate_gas(call, block), boost::asio::use_future);
         const intx::uint256& estimate_gas = result.get();
 
@@ -216,10 +169,9 @@ TEST_CASE("estimate gas") {
 
     SECTION("Call with gas, always succeeds") {
         call.gas = kTxGas * 4;
-        ExecutionResult expect_result_ok{.error_code = evmc_status_code::EVMC_SUCCESS};
         EXPECT_CALL(estimate_gas_oracle, try_execution(_, _, _, _, _, _))
-            .Times(15)
-            .WillRepeatedly(Return(expect_result_ok));
+            .Times(28)
+            .WillRepeatedly(Invoke(execution_requiring(kTxGas, kTxGas)));
         auto result = boost::asio::co_spawn(pool, estimate_gas_oracle.estimate_gas(call, block), boost::asio::use_future);
         const intx::uint256& estimate_gas = result.get();
 
@@ -227,29 +179,12 @@ TEST_CASE("estimate gas") {
     }
 
     SECTION("Call with gas_price, gas not capped") {
-        ExecutionResult expect_result_ok{.error_code = evmc_status_code::EVMC_SUCCESS};
-        ExecutionResult expect_result_fail{.pre_check_error = "intrinsic gas too low"};
         call.gas = kTxGas * 2;
         call.gas_price = intx::uint256{10'000};
 
         EXPECT_CALL(estimate_gas_oracle, try_execution(_, _, _, _, _, _))
-            .Times(16)
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillRepeatedly(Return(expect_result_ok));
+            .Times(26)
+            .WillRepeatedly(Invoke(execution_requiring(kTxGas * 2, kTxGas)));
         auto result = boost::asio::co_spawn(pool, estimate_gas_oracle.estimate_gas(call, block), boost::asio::use_future);
         const intx::uint256& estimate_gas = result.get();
 
@@ -257,26 +192,12 @@ TEST_CASE("estimate gas") {
     }
 
     SECTION("Call with gas_price, gas capped") {
-        ExecutionResult expect_result_ok{.error_code = evmc_status_code::EVMC_SUCCESS};
-        ExecutionResult expect_result_fail{.pre_check_error = "intrinsic gas too low"};
         call.gas = kTxGas * 2;
         call.gas_price = intx::uint256{40'000};
 
         EXPECT_CALL(estimate_gas_oracle, try_execution(_, _, _, _, _, _))
-            .Times(13)
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillRepeatedly(Return(expect_result_ok));
+            .Times(22)
+            .WillRepeatedly(Invoke(execution_requiring(0x61a8, kTxGas)));
         auto result = boost::asio::co_spawn(pool, estimate_gas_oracle.estimate_gas(call, block), boost::asio::use_future);
         const intx::uint256& estimate_gas = result.get();
 
@@ -284,30 +205,13 @@ TEST_CASE("estimate gas") {
     }
 
     SECTION("Call with gas_price and value, gas not capped") {
-        ExecutionResult expect_result_ok{.error_code = evmc_status_code::EVMC_SUCCESS};
-        ExecutionResult expect_result_fail{.pre_check_error = "intrinsic gas too low"};
         call.gas = kTxGas * 2;
         call.gas_price = intx::uint256{10'000};
         call.value = intx::uint256{500'000'000};
 
         EXPECT_CALL(estimate_gas_oracle, try_execution(_, _, _, _, _, _))
-            .Times(16)
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillRepeatedly(Return(expect_result_ok));
+            .Times(26)
+            .WillRepeatedly(Invoke(execution_requiring(kTxGas * 2, kTxGas)));
         auto result = boost::asio::co_spawn(pool, estimate_gas_oracle.estimate_gas(call, block), boost::asio::use_future);
         const intx::uint256& estimate_gas = result.get();
 
@@ -315,27 +219,13 @@ TEST_CASE("estimate gas") {
     }
 
     SECTION("Call with gas_price and value, gas capped") {
-        ExecutionResult expect_result_ok{.error_code = evmc_status_code::EVMC_SUCCESS};
-        ExecutionResult expect_result_fail{.pre_check_error = "intrinsic gas too low"};
         call.gas = kTxGas * 2;
         call.gas_price = intx::uint256{20'000};
         call.value = intx::uint256{500'000'000};
 
         EXPECT_CALL(estimate_gas_oracle, try_execution(_, _, _, _, _, _))
-            .Times(13)
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillOnce(Return(expect_result_fail))
-            .WillRepeatedly(Return(expect_result_ok));
+            .Times(22)
+            .WillRepeatedly(Invoke(execution_requiring(0x61a8, kTxGas)));
         auto result = boost::asio::co_spawn(pool, estimate_gas_oracle.estimate_gas(call, block), boost::asio::use_future);
         const intx::uint256& estimate_gas = result.get();
 
@@ -343,20 +233,33 @@ TEST_CASE("estimate gas") {
     }
 
     SECTION("Call gas above allowance, always succeeds, gas capped") {
-        ExecutionResult expect_result_ok{.error_code = evmc_status_code::EVMC_SUCCESS};
         call.gas = kGasCap * 2;
-        EXPECT_CALL(estimate_gas_oracle, try_execution(_, _, _, _, _, _)).Times(26).WillRepeatedly(Return(expect_result_ok));
+        EXPECT_CALL(estimate_gas_oracle, try_execution(_, _, _, _, _, _))
+            .Times(46)
+            .WillRepeatedly(Invoke(execution_requiring(kTxGas, kTxGas)));
         auto result = boost::asio::co_spawn(pool, estimate_gas_oracle.estimate_gas(call, block), boost::asio::use_future);
         const intx::uint256& estimate_gas = result.get();
 
         CHECK(estimate_gas == kTxGas);
     }
 
+    SECTION("Call gas above allowance, refund hides gas used, gas capped") {
+        call.gas = kGasCap * 2;
+        EXPECT_CALL(estimate_gas_oracle, try_execution(_, _, _, _, _, _))
+            .Times(47)
+            .WillRepeatedly(Invoke(execution_requiring(12'345'678, kTxGas)));
+        auto result = boost::asio::co_spawn(pool, estimate_gas_oracle.estimate_gas(call, block), boost::asio::use_future);
+        const intx::uint256& estimate_gas = result.get();
+
+        CHECK(estimate_gas == 12'345'678);
+    }
+
     SECTION("Call gas below minimum, always succeeds") {
-        ExecutionResult expect_result_ok{.error_code = evmc_status_code::EVMC_SUCCESS};
         call.gas = kTxGas / 2;
 
-        EXPECT_CALL(estimate_gas_oracle, try_execution(_, _, _, _, _, _)).Times(14).WillRepeatedly(Return(expect_result_ok));
+        EXPECT_CALL(estimate_gas_oracle, try_execution(_, _, _, _, _, _))
+            .Times(25)
+            .WillRepeatedly(Invoke(execution_requiring(kTxGas, kTxGas)));
         auto result = boost::asio::co_spawn(pool, estimate_gas_oracle.estimate_gas(call, block), boost::asio::use_future);
         const intx::uint256& estimate_gas = result.get();
 
@@ -368,7 +271,7 @@ TEST_CASE("estimate gas") {
         call.value = intx::uint256{2'000'000'000};
 
         try {
-            EXPECT_CALL(estimate_gas_oracle, try_execution(_, _, _, _, _, _)).Times(16).WillRepeatedly(Return(expect_result_fail));
+            EXPECT_CALL(estimate_gas_oracle, try_execution(_, _, _, _, _, _)).Times(1).WillRepeatedly(Return(expect_result_fail));
             auto result = boost::asio::co_spawn(pool, estimate_gas_oracle.estimate_gas(call, block), boost::asio::use_future);
             result.get();
             CHECK(false);
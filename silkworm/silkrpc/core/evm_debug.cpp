@@ -30,12 +30,12 @@
 
 #include <silkworm/infra/common/log.hpp>
 #include <silkworm/silkrpc/common/util.hpp>
+#include <silkworm/silkrpc/core/block_execution_context.hpp>
 #include <silkworm/silkrpc/core/cached_chain.hpp>
 #include <silkworm/silkrpc/core/evm_executor.hpp>
 #include <silkworm/silkrpc/core/rawdb/chain.hpp>
 #include <silkworm/silkrpc/ethdb/transaction_database.hpp>
 #include <silkworm/silkrpc/json/types.hpp>
-#include <silkworm/silkrpc/core/gas_parameters.hpp>
 namespace silkworm::rpc::debug {
 
 using boost::asio::awaitable;
@@ -347,14 +347,15 @@ awaitable<void> DebugExecutor::execute(json::Stream& stream, const silkworm::Blo
 
     const auto chain_id = co_await core::rawdb::read_chain_id(database_reader_);
     const auto chain_config_ptr = lookup_chain_config(chain_id);
-    const auto [eos_evm_version, gas_params, gas_prices] = co_await load_gas_parameters(database_reader_, chain_config_ptr, block);
+    const auto block_context = co_await load_block_execution_context(workers_, database_reader_, *chain_config_ptr, block);
+    const auto [eos_evm_version, gas_params, gas_prices] = block_context->gas_parameters();
     auto current_executor = co_await boost::asio::this_coro::executor;
 
     co_await boost::asio::async_compose<decltype(boost::asio::use_awaitable), void(void)>(
         [&](auto&& self) {
-            boost::asio::post(workers_, [&, self = std::move(self)]() mutable {
+            post_to_workers(workers_, [&, self = std::move(self)]() mutable {
                 auto state = tx_.create_state(current_executor, database_reader_, block_number - 1);
-                EVMExecutor executor{*chain_config_ptr, workers_, state};
+                EVMExecutor executor{*chain_config_ptr, workers_, state, block_context};
 
                 for (std::uint64_t idx = 0; idx < transactions.size(); idx++) {
                     rpc::Transaction txn{block.transactions[idx]};
@@ -412,14 +413,15 @@ awaitable<void> DebugExecutor::execute(json::Stream& stream, uint64_t block_numb
 
     const auto chain_id = co_await core::rawdb::read_chain_id(database_reader_);
     const auto chain_config_ptr = lookup_chain_config(chain_id);
-    const auto [eos_evm_version, gas_params, gas_prices] = co_await load_gas_parameters(database_reader_, chain_config_ptr, block);
+    const auto block_context = co_await load_block_execution_context(workers_, database_reader_, *chain_config_ptr, block);
+    const auto [eos_evm_version, gas_params, gas_prices] = block_context->gas_parameters();
     auto current_executor = co_await boost::asio::this_coro::executor;
 
     co_await boost::asio::async_compose<decltype(boost::asio::use_awaitable), void(void)>(
         [&](auto&& self) {
-            boost::asio::post(workers_, [&, self = std::move(self)]() mutable {
+            post_to_workers(workers_, [&, self = std::move(self)]() mutable {
                 auto state = tx_.create_state(current_executor, database_reader_, block_number);
-                EVMExecutor executor{*chain_config_ptr, workers_, state};
+                EVMExecutor executor{*chain_config_ptr, workers_, state, block_context};
 
                 for (auto idx{0}; idx < index; idx++) {
                     silkworm::Transaction txn{block.transactions[std::size_t(idx)]};
@@ -475,14 +477,16 @@ awaitable<void> DebugExecutor::execute(json::Stream& stream,
 
     const auto chain_id = co_await core::rawdb::read_chain_id(database_reader_);
     const auto chain_config_ptr = lookup_chain_config(chain_id);
-    const auto [eos_evm_version, gas_params, gas_prices] = co_await load_gas_parameters(database_reader_, chain_config_ptr, block);
+    const auto block_context = co_await load_block_execution_context(workers_, database_reader_, *chain_config_ptr, block);
+
+    const auto [eos_evm_version, gas_params, gas_prices] = block_context->gas_parameters();
 
     auto current_executor = co_await boost::asio::this_coro::executor;
     co_await boost::asio::async_compose<decltype(boost::asio::use_awaitable), void(void)>(
         [&](auto&& self) {
-            boost::asio::post(workers_, [&, self = std::move(self)]() mutable {
+            post_to_workers(workers_, [&, self = std::move(self)]() mutable {
                 auto state = tx_.create_state(current_executor, database_reader_, block.header.number);
-                EVMExecutor executor{*chain_config_ptr, workers_, state};
+                EVMExecutor executor{*chain_config_ptr, workers_, state, block_context};
 
                 for (auto idx{0}; idx < transaction_index; idx++) {
                     silkworm::Transaction txn{block_transactions[std::size_t(idx)]};
@@ -47,6 +47,28 @@ std::string ExecutionResult::error_message(bool full_error) const {
     return "n/a";
 }
 
+//! The number of transactions recovered by each subtask, large enough to amortize the scheduling overhead
+static constexpr std::size_t kSenderRecoveryGrain{8};
+
+void recover_senders(boost::asio::thread_pool& workers, std::vector<silkworm::Transaction>& transactions) {
+    const auto recover_sender = [&](std::size_t index) {
+        if (!transactions[index].from) {
+            transactions[index].recover_sender();
+        }
+    };
+    concurrency::TaskScheduler* scheduler{nullptr};
+    if (has_service<TaskSchedulerService>(workers)) {
+        scheduler = use_service<TaskSchedulerService>(workers).get_scheduler();
+    }
+    if (scheduler && transactions.size() > kSenderRecoveryGrain) {
+        scheduler->parallel_for(0, transactions.size(), kSenderRecoveryGrain, recover_sender);
+    } else {
+        for (std::size_t index{0}; index < transactions.size(); ++index) {
+            recover_sender(index);
+        }
+    }
+}
+
 static Bytes build_abi_selector(const std::string& signature) {
     const auto signature_hash = hash_of(byte_view_of_string(signature));
     return {std::begin(signature_hash.bytes), std::begin(signature_hash.bytes) + 4};
@@ -187,6 +209,14 @@ uint64_t EVMExecutor::refund_gas(const EVM& evm, const silkworm::Transaction& tx
     return gas_left;
 }
 
+evmc::address EVMExecutor::beneficiary(const BlockHeader& header) {
+    if (!rule_set_) {
+        rule_set_ = protocol::rule_set_factory(config_);
+        SILKWORM_ASSERT(rule_set_);
+    }
+    return rule_set_->get_beneficiary(header);
+}
+
 void EVMExecutor::reset_all() {
     ibs_state_.reset();
 }
@@ -239,8 +269,18 @@ ExecutionResult EVMExecutor::call(
     //TODO: get gas parameters
     EVM evm{block, ibs_state_, config_};
     evm.analysis_cache = svc.get_analysis_cache();
+    evm.analysis_store = svc.get_analysis_store();
     evm.state_pool = svc.get_object_pool();
-    evm.beneficiary = rule_set_->get_beneficiary(block.header);
+
+    const bool has_block_context{block_context_ && block_context_->matches(block)};
+    std::shared_ptr<const std::vector<evmc::bytes32>> ancestor_hashes;
+    if (has_block_context) {
+        evm.beneficiary = block_context_->beneficiary;
+        ancestor_hashes = block_context_->ancestor_hashes();
+        evm.block_hashes = ancestor_hashes.get();
+    } else {
+        evm.beneficiary = beneficiary(block.header);
+    }
 
     for (auto& tracer : tracers) {
         evm.add_tracer(*tracer);
@@ -255,7 +295,7 @@ ExecutionResult EVMExecutor::call(
         ibs_state_.set_nonce(*txn.from, txn.nonce);
     }
 
-    const evmc_revision rev{evm.revision()};
+    const evmc_revision rev{has_block_context ? block_context_->revision : evm.revision()};
     const intx::uint256 base_fee_per_gas{evm.block().header.base_fee_per_gas.value_or(0)};
 
     intx::uint256 inclusion_price;
@@ -327,6 +367,9 @@ ExecutionResult EVMExecutor::call(
         SILK_DEBUG << "EVMExecutor::call execute on EVM txn: " << &txn << " g0: " << static_cast<uint64_t>(g0) << " start";
         result = evm.execute(txn, txn.gas_limit - static_cast<uint64_t>(g0), scaled_gas_params);
         SILK_DEBUG << "EVMExecutor::call execute on EVM txn: " << &txn << " gas_left: " << result.gas_left << " end";
+        if (has_block_context && !evm.walked_block_hashes().empty()) {
+            block_context_->publish_ancestor_hashes(evm.walked_block_hashes());
+        }
     } catch (const std::exception& e) {
         SILK_ERROR << "exception: evm_execute: " << e.what() << "\n";
         std::string error_msg = "evm.execute: ";
@@ -382,12 +425,43 @@ awaitable<ExecutionResult> EVMExecutor::call(const silkworm::ChainConfig& config
                                              Tracers tracers,
                                              bool refund,
                                              bool gas_bailout) {
+    return call_on_workers(config, workers, block, txn, std::move(state_factory), gas_params, gas_prices, eos_evm_version,
+                           /*block_context=*/nullptr, std::move(tracers), refund, gas_bailout);
+}
+
+awaitable<ExecutionResult> EVMExecutor::call(std::shared_ptr<const BlockExecutionContext> block_context,
+                                             boost::asio::thread_pool& workers,
+                                             const silkworm::Block& block,
+                                             const silkworm::Transaction& txn,
+                                             StateFactory state_factory,
+                                             Tracers tracers,
+                                             bool refund,
+                                             bool gas_bailout) {
+    SILKWORM_ASSERT(block_context && block_context->config);
+    const auto& config{*block_context->config};
+    const auto [eos_evm_version, gas_params, gas_prices] = block_context->gas_parameters();
+    co_return co_await call_on_workers(config, workers, block, txn, std::move(state_factory), gas_params, gas_prices,
+                                       eos_evm_version, std::move(block_context), std::move(tracers), refund, gas_bailout);
+}
+
+awaitable<ExecutionResult> EVMExecutor::call_on_workers(const silkworm::ChainConfig& config,
+                                                        boost::asio::thread_pool& workers,
+                                                        const silkworm::Block& block,
+                                                        const silkworm::Transaction& txn,
+                                                        StateFactory state_factory,
+                                                        const evmone::gas_parameters& gas_params,
+                                                        const silkworm::gas_prices_t& gas_prices,
+                                                        uint64_t eos_evm_version,
+                                                        std::shared_ptr<const BlockExecutionContext> block_context,
+                                                        Tracers tracers,
+                                                        bool refund,
+                                                        bool gas_bailout) {
     auto this_executor = co_await boost::asio::this_coro::executor;
     const auto execution_result = co_await boost::asio::async_compose<decltype(boost::asio::use_awaitable), void(ExecutionResult)>(
         [&](auto&& self) {
-            boost::asio::post(workers, [&, self = std::move(self)]() mutable {
+            post_to_workers(workers, [&, self = std::move(self)]() mutable {
                 auto state = state_factory(this_executor, block.header.number);
-                EVMExecutor executor{config, workers, state};
+                EVMExecutor executor{config, workers, state, block_context};
                 auto exec_result = executor.call(block, txn, gas_params, gas_prices, eos_evm_version, tracers, refund, gas_bailout);
                 boost::asio::post(this_executor, [exec_result, self = std::move(self)]() mutable {
                     self.complete(exec_result);
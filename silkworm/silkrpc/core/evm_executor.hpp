@@ -18,6 +18,7 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <silkworm/infra/concurrency/coroutine.hpp>
@@ -25,6 +26,7 @@
 #include <boost/asio/awaitable.hpp>
 #include <boost/asio/impl/execution_context.hpp>
 #include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
 #include <boost/asio/thread_pool.hpp>
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wattributes"
@@ -37,6 +39,8 @@
 #include <silkworm/core/state/state.hpp>
 #include <silkworm/core/types/block.hpp>
 #include <silkworm/core/types/transaction.hpp>
+#include <silkworm/infra/concurrency/task_scheduler.hpp>
+#include <silkworm/silkrpc/core/block_execution_context.hpp>
 #include <silkworm/silkrpc/core/rawdb/accessors.hpp>
 #include <silkworm/silkrpc/core/state_reader.hpp>
 #include <silkworm/core/types/gas_prices.hpp>
@@ -62,18 +66,48 @@ using ServiceBase = boost::asio::detail::execution_context_service_base<T>;
 
 class AnalysisCacheService : public ServiceBase<AnalysisCacheService> {
   public:
-    explicit AnalysisCacheService(boost::asio::execution_context& owner)
-        : ServiceBase<AnalysisCacheService>(owner) {}
+    explicit AnalysisCacheService(boost::asio::execution_context& owner, AnalysisStore* analysis_store = nullptr)
+        : ServiceBase<AnalysisCacheService>(owner), analysis_store_{analysis_store} {}
 
     void shutdown() override {}
     ObjectPool<evmone::ExecutionState>* get_object_pool() { return &state_pool_; }
     AnalysisCache* get_analysis_cache() { return &analysis_cache_; }
+    AnalysisStore* get_analysis_store() { return analysis_store_; }
 
   private:
     ObjectPool<evmone::ExecutionState> state_pool_{true};
     AnalysisCache analysis_cache_{kCacheSize, true};
+    AnalysisStore* analysis_store_;
 };
 
+//! The work-stealing scheduler running the tasks posted to the workers in place of their own threads (if any)
+class TaskSchedulerService : public ServiceBase<TaskSchedulerService> {
+  public:
+    explicit TaskSchedulerService(boost::asio::execution_context& owner, concurrency::TaskScheduler* scheduler = nullptr)
+        : ServiceBase<TaskSchedulerService>(owner), scheduler_{scheduler} {}
+
+    void shutdown() override {}
+    concurrency::TaskScheduler* get_scheduler() { return scheduler_; }
+
+  private:
+    concurrency::TaskScheduler* scheduler_;
+};
+
+//! Run the task on the scheduler attached to the workers if any, otherwise on the workers themselves
+template <typename F>
+void post_to_workers(boost::asio::thread_pool& workers, F&& f) {
+    if (has_service<TaskSchedulerService>(workers)) {
+        if (auto* scheduler = use_service<TaskSchedulerService>(workers).get_scheduler()) {
+            scheduler->post(std::forward<F>(f));
+            return;
+        }
+    }
+    boost::asio::post(workers, std::forward<F>(f));
+}
+
+//! Recover the missing senders of the transactions, split into subtasks of the scheduler attached to the workers if any
+void recover_senders(boost::asio::thread_pool& workers, std::vector<silkworm::Transaction>& transactions);
+
 using Tracers = std::vector<std::shared_ptr<EvmTracer>>;
 
 class EVMExecutor {
@@ -90,15 +124,23 @@ class EVMExecutor {
                                            Tracers tracers = {},
                                            bool refund = true,
                                            bool gas_bailout = false);
+    static awaitable<ExecutionResult> call(std::shared_ptr<const BlockExecutionContext> block_context,
+                                           boost::asio::thread_pool& workers,
+                                           const silkworm::Block& block,
+                                           const silkworm::Transaction& txn,
+                                           StateFactory state_factory,
+                                           Tracers tracers = {},
+                                           bool refund = true,
+                                           bool gas_bailout = false);
     static std::string get_error_message(int64_t error_code, const Bytes& error_data, bool full_error = true);
 
-    EVMExecutor(const silkworm::ChainConfig& config, boost::asio::thread_pool& workers, std::shared_ptr<silkworm::State>& state)
+    EVMExecutor(const silkworm::ChainConfig& config, boost::asio::thread_pool& workers, std::shared_ptr<silkworm::State>& state,
+                std::shared_ptr<const BlockExecutionContext> block_context = nullptr)
         : config_(config),
           workers_{workers},
           state_{state},
           ibs_state_{*state_},
-          rule_set_(protocol::rule_set_factory(config)) {
-        SILKWORM_ASSERT(rule_set_);
+          block_context_{std::move(block_context)} {
         if (!has_service<AnalysisCacheService>(workers_)) {
             make_service<AnalysisCacheService>(workers_);
         }
@@ -113,15 +155,29 @@ class EVMExecutor {
     void reset_all();
 
   private:
+    static awaitable<ExecutionResult> call_on_workers(const silkworm::ChainConfig& config,
+                                                      boost::asio::thread_pool& workers,
+                                                      const silkworm::Block& block,
+                                                      const silkworm::Transaction& txn,
+                                                      StateFactory state_factory,
+                                                      const evmone::gas_parameters& gas_params,
+                                                      const silkworm::gas_prices_t& gas_prices,
+                                                      uint64_t eos_evm_version,
+                                                      std::shared_ptr<const BlockExecutionContext> block_context,
+                                                      Tracers tracers,
+                                                      bool refund,
+                                                      bool gas_bailout);
     static std::optional<std::string> pre_check(const EVM& evm, const silkworm::Transaction& txn,
                                                 const intx::uint256& base_fee_per_gas, const intx::uint128& g0);
     uint64_t refund_gas(const EVM& evm, const silkworm::Transaction& txn, uint64_t gas_left, uint64_t gas_refund);
+    evmc::address beneficiary(const BlockHeader& header);
 
     const silkworm::ChainConfig& config_;
     boost::asio::thread_pool& workers_;
     std::shared_ptr<silkworm::State> state_;
     IntraBlockState ibs_state_;
-    protocol::RuleSetPtr rule_set_;
+    std::shared_ptr<const BlockExecutionContext> block_context_;  // if any, the block-level inputs computed in advance
+    protocol::RuleSetPtr rule_set_;                               // created on demand when no block context matches
 };
 
 }  // namespace silkworm::rpc
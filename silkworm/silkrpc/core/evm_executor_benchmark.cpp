@@ -0,0 +1,125 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <algorithm>
+#include <future>
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/thread_pool.hpp>
+#include <boost/asio/use_future.hpp>
+
+#include <silkworm/core/chain/config.hpp>
+#include <silkworm/core/common/cast.hpp>
+#include <silkworm/core/common/endian.hpp>
+#include <silkworm/core/common/util.hpp>
+#include <silkworm/core/state/in_memory_state.hpp>
+#include <silkworm/infra/common/log.hpp>
+#include <silkworm/infra/concurrency/thread_affinity.hpp>
+#include <silkworm/infra/grpc/client/client_context_pool.hpp>
+#include <silkworm/silkrpc/core/evm_executor.hpp>
+
+namespace silkworm::rpc {
+
+using evmc::literals::operator""_address;
+
+static constexpr auto kContractAddress{0x6a7e8a58a1ba2e0a64c6a1a4d7c9ff2c1fbc3f20_address};
+
+//! Contract reading the storage slots in range (0, 512] in a loop, i.e. a typical read-only eth_call
+static constexpr std::string_view kLoopCode{"6102005b805450600190038060035700"};
+
+//! The number of eth_call requests served concurrently in each iteration
+static constexpr std::size_t kCallsPerIteration{64};
+
+static std::shared_ptr<State> make_contract_state() {
+    auto state{std::make_shared<InMemoryState>()};
+    const Bytes code{*from_hex(kLoopCode)};
+    const auto code_hash{bit_cast<evmc_bytes32>(keccak256(code))};
+    state->update_account(kContractAddress, std::nullopt, Account{.code_hash = code_hash, .incarnation = 1});
+    state->update_account_code(kContractAddress, 1, code_hash, code);
+    for (uint64_t slot{1}; slot <= 0x200; ++slot) {
+        evmc::bytes32 location;
+        endian::store_big_u64(location.bytes + 24, slot);
+        state->update_storage(kContractAddress, 1, location, {}, location);
+    }
+    return state;
+}
+
+//! Throughput of eth_call requests dispatched by the execution contexts to the workers, without (0) or with (1)
+//! execution contexts and workers pinned on separate halves of the available CPUs (i.e. --contexts.cpus, --workers.cpus)
+static void benchmark_eth_call(benchmark::State& state) {
+    log::set_verbosity(log::Level::kNone);
+    const bool pinned{state.range(0) != 0};
+
+    const auto available_cpus{concurrency::get_thread_affinity()};
+    const std::size_t num_cpus{std::max<std::size_t>(available_cpus.size(), 2)};
+    concurrency::ContextPoolSettings context_pool_settings{
+        .num_contexts = static_cast<uint32_t>(num_cpus / 2),
+        .wait_mode = concurrency::WaitMode::blocking,
+    };
+    const std::size_t num_workers{num_cpus - num_cpus / 2};
+    concurrency::CpuSet workers_cpu_set;
+    if (pinned && !available_cpus.empty()) {
+        const auto middle{available_cpus.cbegin() + static_cast<std::ptrdiff_t>(available_cpus.size() / 2)};
+        context_pool_settings.cpu_set = {available_cpus.cbegin(), std::max(middle, available_cpus.cbegin() + 1)};
+        context_pool_settings.affinity_mode = concurrency::AffinityMode::per_cpu;
+        workers_cpu_set = {std::min(middle, available_cpus.cend() - 1), available_cpus.cend()};
+    }
+
+    ClientContextPool context_pool{context_pool_settings};
+    boost::asio::thread_pool workers{num_workers};
+    if (pinned) {
+        concurrency::set_thread_pool_affinity(workers, num_workers, workers_cpu_set,
+                                              concurrency::AffinityMode::per_numa_node, "bench_worker_");
+    }
+    context_pool.start();
+
+    const auto contract_state{make_contract_state()};
+    const EVMExecutor::StateFactory state_factory = [&](auto&, BlockNum) { return contract_state; };
+    Block block;
+    block.header.number = 17'000'000;
+    block.header.gas_limit = 30'000'000;
+    Transaction txn;
+    txn.to = kContractAddress;
+    txn.gas_limit = 10'000'000;
+    const evmone::gas_parameters gas_params{};
+    const gas_prices_t gas_prices{};
+
+    for ([[maybe_unused]] auto _ : state) {
+        std::vector<std::future<ExecutionResult>> results;
+        results.reserve(kCallsPerIteration);
+        for (std::size_t i{0}; i < kCallsPerIteration; ++i) {
+            results.push_back(boost::asio::co_spawn(
+                context_pool.next_io_context(),
+                EVMExecutor::call(kMainnetConfig, workers, block, txn, state_factory, gas_params, gas_prices, 0),
+                boost::asio::use_future));
+        }
+        for (auto& result : results) {
+            benchmark::DoNotOptimize(result.get());
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kCallsPerIteration));
+
+    context_pool.stop();
+    context_pool.join();
+    workers.join();
+}
+
+BENCHMARK(benchmark_eth_call)->Arg(0)->Arg(1)->UseRealTime();
+
+}  // namespace silkworm::rpc
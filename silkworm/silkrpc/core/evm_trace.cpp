@@ -17,6 +17,7 @@
 #include "evm_trace.hpp"
 
 #include <algorithm>
+#include <iterator>
 #include <memory>
 #include <set>
 #include <stack>
@@ -35,12 +36,15 @@
 #include <silkworm/core/common/util.hpp>
 #include <silkworm/core/protocol/ethash_rule_set.hpp>
 #include <silkworm/infra/common/log.hpp>
+#include <silkworm/node/db/tables.hpp>
 #include <silkworm/silkrpc/common/util.hpp>
+#include <silkworm/silkrpc/core/block_execution_context.hpp>
 #include <silkworm/silkrpc/core/cached_chain.hpp>
 #include <silkworm/silkrpc/core/rawdb/chain.hpp>
+#include <silkworm/silkrpc/ethdb/bitmap.hpp>
 #include <silkworm/silkrpc/json/call.hpp>
 #include <silkworm/silkrpc/json/types.hpp>
-#include <silkworm/silkrpc/core/gas_parameters.hpp>
+#include <silkworm/silkrpc/stagedsync/stages.hpp>
 
 namespace silkworm::rpc::trace {
 
@@ -1238,13 +1242,15 @@ awaitable<std::vector<TraceCallResult>> TraceCallExecutor::trace_block_transacti
 
     const auto chain_id = co_await core::rawdb::read_chain_id(database_reader_);
     auto chain_config_ptr = lookup_chain_config(chain_id);
-    const auto [eos_evm_version, gas_params, gas_prices] = co_await load_gas_parameters(database_reader_, chain_config_ptr, block);
+    const auto block_context = co_await load_block_execution_context(workers_, database_reader_, *chain_config_ptr, block);
+
+    const auto [eos_evm_version, gas_params, gas_prices] = block_context->gas_parameters();
 
     auto current_executor = co_await boost::asio::this_coro::executor;
 
     const auto call_result = co_await boost::asio::async_compose<decltype(boost::asio::use_awaitable), void(std::vector<TraceCallResult>)>(
         [&](auto&& self) {
-            boost::asio::post(workers_, [&, self = std::move(self)]() mutable {
+            post_to_workers(workers_, [&, self = std::move(self)]() mutable {
                 auto state = tx_.create_state(current_executor, database_reader_, block_number - 1);
                 IntraBlockState initial_ibs{*state};
 
@@ -1252,14 +1258,14 @@ awaitable<std::vector<TraceCallResult>> TraceCallExecutor::trace_block_transacti
                 std::shared_ptr<EvmTracer> ibs_tracer = std::make_shared<trace::IntraBlockStateTracer>(state_addresses);
 
                 auto curr_state = tx_.create_state(current_executor, database_reader_, block_number - 1);
-                EVMExecutor executor{*chain_config_ptr, workers_, curr_state};
+                EVMExecutor executor{*chain_config_ptr, workers_, curr_state, block_context};
+
+                std::vector<silkworm::Transaction> block_transactions{transactions};
+                recover_senders(workers_, block_transactions);
 
                 std::vector<TraceCallResult> trace_call_result(transactions.size());
                 for (std::uint64_t index = 0; index < transactions.size(); index++) {
-                    silkworm::Transaction transaction{block.transactions[index]};
-                    if (!transaction.from) {
-                        transaction.recover_sender();
-                    }
+                    const silkworm::Transaction& transaction{block_transactions[index]};
 
                     auto& result = trace_call_result.at(index);
                     TraceCallTraces& traces = result.traces;
@@ -1317,18 +1323,20 @@ awaitable<TraceManyCallResult> TraceCallExecutor::trace_calls(const silkworm::Bl
 
     const auto chain_id = co_await core::rawdb::read_chain_id(database_reader_);
     const auto chain_config_ptr = lookup_chain_config(chain_id);
-    const auto [eos_evm_version, gas_params, gas_prices] = co_await load_gas_parameters(database_reader_, chain_config_ptr, block);
+    const auto block_context = co_await load_block_execution_context(workers_, database_reader_, *chain_config_ptr, block);
+
+    const auto [eos_evm_version, gas_params, gas_prices] = block_context->gas_parameters();
 
     auto current_executor = co_await boost::asio::this_coro::executor;
     const auto ret_result = co_await boost::asio::async_compose<decltype(boost::asio::use_awaitable), void(TraceManyCallResult)>(
         [&](auto&& self) {
-            boost::asio::post(workers_, [&, self = std::move(self)]() mutable {
+            post_to_workers(workers_, [&, self = std::move(self)]() mutable {
                 auto state = tx_.create_state(current_executor, database_reader_, block_number);
                 silkworm::IntraBlockState initial_ibs{*state};
                 StateAddresses state_addresses(initial_ibs);
 
                 auto curr_state = tx_.create_state(current_executor, database_reader_, block_number);
-                EVMExecutor executor{*chain_config_ptr, workers_, state};
+                EVMExecutor executor{*chain_config_ptr, workers_, state, block_context};
 
                 std::shared_ptr<silkworm::EvmTracer> ibs_tracer = std::make_shared<trace::IntraBlockStateTracer>(state_addresses);
 
@@ -1387,18 +1395,20 @@ boost::asio::awaitable<TraceDeployResult> TraceCallExecutor::trace_deploy_transa
 
     const auto chain_id = co_await core::rawdb::read_chain_id(database_reader_);
     const auto chain_config_ptr = lookup_chain_config(chain_id);
-    const auto [eos_evm_version, gas_params, gas_prices] = co_await load_gas_parameters(database_reader_, chain_config_ptr, block);
+    const auto block_context = co_await load_block_execution_context(workers_, database_reader_, *chain_config_ptr, block);
+
+    const auto [eos_evm_version, gas_params, gas_prices] = block_context->gas_parameters();
 
     auto current_executor = co_await boost::asio::this_coro::executor;
 
     const auto deploy_result = co_await boost::asio::async_compose<decltype(boost::asio::use_awaitable), void(TraceDeployResult)>(
         [&](auto&& self) {
-            boost::asio::post(workers_, [&, self = std::move(self)]() mutable {
+            post_to_workers(workers_, [&, self = std::move(self)]() mutable {
                 auto state = tx_.create_state(current_executor, database_reader_, block_number - 1);
                 silkworm::IntraBlockState initial_ibs{*state};
 
                 auto curr_state = tx_.create_state(current_executor, database_reader_, block_number - 1);
-                EVMExecutor executor{*chain_config_ptr, workers_, curr_state};
+                EVMExecutor executor{*chain_config_ptr, workers_, curr_state, block_context};
 
                 TraceDeployResult result;
 
@@ -1406,11 +1416,11 @@ boost::asio::awaitable<TraceDeployResult> TraceCallExecutor::trace_deploy_transa
 
                 Tracers tracers{create_tracer};
 
+                std::vector<silkworm::Transaction> block_transactions{transactions};
+                recover_senders(workers_, block_transactions);
+
                 for (std::uint64_t index = 0; index < transactions.size(); index++) {
-                    silkworm::Transaction transaction{block.transactions[index]};
-                    if (!transaction.from) {
-                        transaction.recover_sender();
-                    }
+                    const silkworm::Transaction& transaction{block_transactions[index]};
 
                     executor.call(block, transaction, gas_params, gas_prices, eos_evm_version, std::move(tracers), /*refund=*/true, /*gas_bailout=*/true);
                     executor.reset();
@@ -1461,18 +1471,20 @@ boost::asio::awaitable<TraceEntriesResult> TraceCallExecutor::trace_transaction_
 
     const auto chain_id = co_await core::rawdb::read_chain_id(database_reader_);
     const auto chain_config_ptr = lookup_chain_config(chain_id);
-    const auto [eos_evm_version, gas_params, gas_prices] = co_await load_gas_parameters(database_reader_, chain_config_ptr, transaction_with_block.block_with_hash.block);
+    const auto block_context = co_await load_block_execution_context(workers_, database_reader_, *chain_config_ptr, transaction_with_block.block_with_hash.block);
+
+    const auto [eos_evm_version, gas_params, gas_prices] = block_context->gas_parameters();
 
     auto current_executor = co_await boost::asio::this_coro::executor;
 
     const auto ret_entry_tracer = co_await boost::asio::async_compose<decltype(boost::asio::use_awaitable), void(std::shared_ptr<trace::EntryTracer>)>(
         [&](auto&& self) {
-            boost::asio::post(workers_, [&, self = std::move(self)]() mutable {
+            post_to_workers(workers_, [&, self = std::move(self)]() mutable {
                 auto state = tx_.create_state(current_executor, database_reader_, block_number - 1);
                 silkworm::IntraBlockState initial_ibs{*state};
 
                 auto curr_state = tx_.create_state(current_executor, database_reader_, block_number - 1);
-                EVMExecutor executor{*chain_config_ptr, workers_, curr_state};
+                EVMExecutor executor{*chain_config_ptr, workers_, curr_state, block_context};
 
                 auto entry_tracer = std::make_shared<trace::EntryTracer>(initial_ibs);
 
@@ -1495,18 +1507,20 @@ boost::asio::awaitable<std::string> TraceCallExecutor::trace_transaction_error(c
 
     const auto chain_id = co_await core::rawdb::read_chain_id(database_reader_);
     const auto chain_config_ptr = lookup_chain_config(chain_id);
-    const auto [eos_evm_version, gas_params, gas_prices] = co_await load_gas_parameters(database_reader_, chain_config_ptr, transaction_with_block.block_with_hash.block);
+    const auto block_context = co_await load_block_execution_context(workers_, database_reader_, *chain_config_ptr, transaction_with_block.block_with_hash.block);
+
+    const auto [eos_evm_version, gas_params, gas_prices] = block_context->gas_parameters();
 
     auto current_executor = co_await boost::asio::this_coro::executor;
 
     const auto ret_result = co_await boost::asio::async_compose<decltype(boost::asio::use_awaitable), void(std::string)>(
         [&](auto&& self) {
-            boost::asio::post(workers_, [&, self = std::move(self)]() mutable {
+            post_to_workers(workers_, [&, self = std::move(self)]() mutable {
                 auto state = tx_.create_state(current_executor, database_reader_, block_number - 1);
                 silkworm::IntraBlockState initial_ibs{*state};
 
                 auto curr_state = tx_.create_state(current_executor, database_reader_, block_number - 1);
-                EVMExecutor executor{*chain_config_ptr, workers_, curr_state};
+                EVMExecutor executor{*chain_config_ptr, workers_, curr_state, block_context};
                 Tracers tracers{};
 
                 auto execution_result = executor.call(transaction_with_block.block_with_hash.block, transaction_with_block.transaction, gas_params, gas_prices, eos_evm_version, std::move(tracers), /*refund=*/true, /*gas_bailout=*/true);
@@ -1530,14 +1544,16 @@ boost::asio::awaitable<TraceOperationsResult> TraceCallExecutor::trace_operation
 
     const auto chain_id = co_await core::rawdb::read_chain_id(database_reader_);
     const auto chain_config_ptr = lookup_chain_config(chain_id);
-    const auto [eos_evm_version, gas_params, gas_prices] = co_await load_gas_parameters(database_reader_, chain_config_ptr, transaction_with_block.block_with_hash.block);
+    const auto block_context = co_await load_block_execution_context(workers_, database_reader_, *chain_config_ptr, transaction_with_block.block_with_hash.block);
+
+    const auto [eos_evm_version, gas_params, gas_prices] = block_context->gas_parameters();
 
     auto current_executor = co_await boost::asio::this_coro::executor;
     auto state = tx_.create_state(current_executor, database_reader_, block_number - 1);
     silkworm::IntraBlockState initial_ibs{*state};
 
     auto curr_state = tx_.create_state(current_executor, database_reader_, block_number - 1);
-    EVMExecutor executor{*chain_config_ptr, workers_, curr_state};
+    EVMExecutor executor{*chain_config_ptr, workers_, curr_state, block_context};
     auto tracer = std::make_shared<trace::OperationTracer>(initial_ibs);
     Tracers tracers{tracer};
 
@@ -1567,25 +1583,51 @@ awaitable<void> TraceCallExecutor::trace_filter(const TraceFilter& trace_filter,
     filter.after = trace_filter.after;
     filter.count = trace_filter.count;
 
-    auto block_number = from_block_with_hash->block.header.number;
-    auto block_with_hash = from_block_with_hash;
-    while (block_number++ <= to_block_with_hash->block.header.number) {
-        const Block block{*block_with_hash, {}, false};
-        SILK_INFO << "TraceCallExecutor::trace_filter: processing "
-                  << " block_number: " << block_number - 1
-                  << " block: " << block;
-
-        co_await trace_block(*block_with_hash, filter, stream);
+    const auto from_block_number = from_block_with_hash->block.header.number;
+    const auto to_block_number = to_block_with_hash->block.header.number;
+    roaring::Roaring64Map block_numbers(roaring::api::roaring_bitmap_from_range(from_block_number, to_block_number + 1, 1));
 
-        if (filter.count == 0) {
-            break;
+    // Address filters can skip whole blocks using the call trace indices, up to the CallTraces stage progress
+    if (!filter.from_addresses.empty() || !filter.to_addresses.empty()) {
+        const auto indexed_block_number = co_await stages::get_sync_stage_progress(database_reader_, stages::kCallTraces);
+        if (indexed_block_number >= from_block_number) {
+            const auto last_indexed_block_number = std::min(indexed_block_number, to_block_number);
+            roaring::Roaring64Map indexed_block_numbers;
+            if (!trace_filter.from_addresses.empty()) {
+                indexed_block_numbers |= co_await ethdb::bitmap::from_addresses(database_reader_, db::table::kCallFromIndexName,
+                                                                                trace_filter.from_addresses, from_block_number, last_indexed_block_number);
+            }
+            if (!trace_filter.to_addresses.empty()) {
+                indexed_block_numbers |= co_await ethdb::bitmap::from_addresses(database_reader_, db::table::kCallToIndexName,
+                                                                                trace_filter.to_addresses, from_block_number, last_indexed_block_number);
+            }
+            if (last_indexed_block_number < to_block_number) {
+                indexed_block_numbers |= roaring::Roaring64Map(roaring::api::roaring_bitmap_from_range(last_indexed_block_number + 1, to_block_number + 1, 1));
+            }
+            block_numbers &= indexed_block_numbers;
         }
+        SILK_DEBUG << "TraceCallExecutor::trace_filter: #blocks to trace " << block_numbers.cardinality();
+    }
 
-        if (block_number == to_block_with_hash->block.header.number) {
+    for (const auto block_number : block_numbers) {
+        std::shared_ptr<BlockWithHash> block_with_hash;
+        if (block_number == from_block_number) {
+            block_with_hash = from_block_with_hash;
+        } else if (block_number == to_block_number) {
             block_with_hash = to_block_with_hash;
         } else {
             block_with_hash = co_await core::read_block_by_number(block_cache_, database_reader_, block_number);
         }
+        const Block block{*block_with_hash, {}, false};
+        SILK_DEBUG << "TraceCallExecutor::trace_filter: processing "
+                   << " block_number: " << block_number
+                   << " block: " << block;
+
+        co_await trace_block(*block_with_hash, filter, stream);
+
+        if (filter.count == 0) {
+            break;
+        }
     }
 
     stream->close_array();
@@ -1605,13 +1647,15 @@ awaitable<TraceCallResult> TraceCallExecutor::execute(std::uint64_t block_number
 
     const auto chain_id = co_await core::rawdb::read_chain_id(database_reader_);
     const auto chain_config_ptr = lookup_chain_config(chain_id);
-    const auto [eos_evm_version, gas_params, gas_prices] = co_await load_gas_parameters(database_reader_, chain_config_ptr, block);
+    const auto block_context = co_await load_block_execution_context(workers_, database_reader_, *chain_config_ptr, block);
+
+    const auto [eos_evm_version, gas_params, gas_prices] = block_context->gas_parameters();
 
     auto current_executor = co_await boost::asio::this_coro::executor;
 
     const auto trace_call_result = co_await boost::asio::async_compose<decltype(boost::asio::use_awaitable), void(TraceCallResult)>(
         [&](auto&& self) {
-            boost::asio::post(workers_, [&, self = std::move(self)]() mutable {
+            post_to_workers(workers_, [&, self = std::move(self)]() mutable {
                 auto state = tx_.create_state(current_executor, database_reader_, block_number);
                 silkworm::IntraBlockState initial_ibs{*state};
 
@@ -1621,13 +1665,14 @@ awaitable<TraceCallResult> TraceCallExecutor::execute(std::uint64_t block_number
                 tracers.push_back(tracer);
 
                 auto curr_state = tx_.create_state(current_executor, database_reader_, block_number);
-                EVMExecutor executor{*chain_config_ptr, workers_, curr_state};
-                for (std::size_t idx{0}; idx < transaction.transaction_index; idx++) {
-                    silkworm::Transaction txn{block.transactions[idx]};
+                EVMExecutor executor{*chain_config_ptr, workers_, curr_state, block_context};
 
-                    if (!txn.from) {
-                        txn.recover_sender();
-                    }
+                const auto previous_transactions_end{std::next(block.transactions.begin(), static_cast<std::ptrdiff_t>(transaction.transaction_index))};
+                std::vector<silkworm::Transaction> previous_transactions{block.transactions.begin(), previous_transactions_end};
+                recover_senders(workers_, previous_transactions);
+
+                for (std::size_t idx{0}; idx < previous_transactions.size(); idx++) {
+                    const silkworm::Transaction& txn{previous_transactions[idx]};
                     const auto execution_result = executor.call(block, txn, gas_params, gas_prices, eos_evm_version, tracers, /*refund=*/true, /*gas_bailout=*/true);
                     if (execution_result.pre_check_error) {
                         SILK_ERROR << "execution failed for tx " << idx << " due to pre-check error: " << *execution_result.pre_check_error;
@@ -1696,7 +1741,7 @@ void EntryTracer::on_execution_start(evmc_revision, const evmc_message& msg, evm
     auto sender = evmc::address{msg.sender};
     auto recipient = evmc::address{msg.recipient};
     auto code_address = evmc::address{msg.code_address};
-    
+
     bool create = ((initial_ibs_.get_nonce(recipient) == 0 && initial_ibs_.get_code_hash(recipient) == kEmptyHash) && recipient != code_address);
     auto input = silkworm::ByteView{msg.input_data, msg.input_size};
 
@@ -5300,41 +5300,6 @@ TEST_CASE_METHOD(TraceCallExecutorTest, "TraceCallExecutor::trace_filter") {
           "toBlock": "0x6DDD03"
         })"_json;
 
-        // TransactionDatabase::get_one: TABLE CanonicalHeader
-        static Bytes kCanonicalHeaderKey3{*silkworm::from_hex("00000000006ddd04")};
-        static Bytes kCanonicalHeaderValue3{*silkworm::from_hex("1b9ac5d63ba5c6a7e0c40a339499eef9b8b45fa247e701516f35a2357ccdaf1e")};
-        EXPECT_CALL(db_reader, get_one(db::table::kCanonicalHashesName, silkworm::ByteView{kCanonicalHeaderKey3}))
-            .WillOnce(InvokeWithoutArgs([]() -> boost::asio::awaitable<Bytes> {
-                co_return kCanonicalHeaderValue3;
-            }));
-
-        // TransactionDatabase::get: TABLE Header
-        static Bytes kHeaderKey2{*silkworm::from_hex("00000000006ddd041b9ac5d63ba5c6a7e0c40a339499eef9b8b45fa247e701516f35a2357ccdaf1e")};
-        static Bytes kHeaderValue2{*silkworm::from_hex(
-            "f9025ba0a316f156582fb5fba2166910becdb6342965a801fa473e18cd6a0c06143cac1aa01dcc4de8dec75d7aab85b567b6ccd41ad312"
-            "451b948a7413f0a142fd40d49347940000000000000000000000000000000000000000a000636fe848d9d0dd8d3fe77deef0286329b01f"
-            "4e971501d1dc481365deea77bfa056e81f171bcc55a6ff8345e692c0f86e5b48e01b996cadc001622fb5e363b421a056e81f171bcc55a6"
-            "ff8345e692c0f86e5b48e01b996cadc001622fb5e363b421b9010000000000000000000000000000000000000000000000000000000000"
-            "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
-            "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
-            "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
-            "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
-            "000000000000000001836ddd048401c9c380808462ca3c74b8614e65746865726d696e6420312e31332e332d302d306533323839663535"
-            "2d3230a499270541450663356185c61f970959545219dee7616763658a87d3c80730c32cca058d57ccc16cc0b0ca4269c4dee474ee3612"
-            "f83cbf54f9fbffddba6d154401a00000000000000000000000000000000000000000000000000000000000000000880000000000000000"
-            "07")};
-        EXPECT_CALL(db_reader, get_one(db::table::kHeadersName, silkworm::ByteView{kHeaderKey2}))
-            .WillOnce(InvokeWithoutArgs([]() -> boost::asio::awaitable<Bytes> {
-                co_return kHeaderValue2;
-            }));
-
-        // TransactionDatabase::get: TABLE BlockBody
-        static Bytes kBlockBodyKey2{*silkworm::from_hex("00000000006ddd041b9ac5d63ba5c6a7e0c40a339499eef9b8b45fa247e701516f35a2357ccdaf1e")};
-        static Bytes kBlockBodyValue2{*silkworm::from_hex("c78405c62e6f02c0")};
-        EXPECT_CALL(db_reader, get_one(db::table::kBlockBodiesName, silkworm::ByteView{kBlockBodyKey2}))
-            .WillOnce(InvokeWithoutArgs([]() -> boost::asio::awaitable<Bytes> {
-                co_return kBlockBodyValue2;
-            }));
         EXPECT_CALL(db_reader, get_one(db::table::kExtraBlockDataName, _)).WillRepeatedly(InvokeWithoutArgs([]() -> boost::asio::awaitable<Bytes> { co_return Bytes{}; }));
 
         BlockCache block_cache;
@@ -5385,41 +5350,9 @@ TEST_CASE_METHOD(TraceCallExecutorTest, "TraceCallExecutor::trace_filter") {
           "fromAddress": ["0x2031832e54a2200bf678286f560f49a950db2ad5"]
         })"_json;
 
-        // TransactionDatabase::get_one: TABLE CanonicalHeader
-        static Bytes kCanonicalHeaderKey3{*silkworm::from_hex("00000000006ddd04")};
-        static Bytes kCanonicalHeaderValue3{*silkworm::from_hex("1b9ac5d63ba5c6a7e0c40a339499eef9b8b45fa247e701516f35a2357ccdaf1e")};
-        EXPECT_CALL(db_reader, get_one(db::table::kCanonicalHashesName, silkworm::ByteView{kCanonicalHeaderKey3}))
-            .WillOnce(InvokeWithoutArgs([]() -> boost::asio::awaitable<Bytes> {
-                co_return kCanonicalHeaderValue3;
-            }));
-
-        // TransactionDatabase::get: TABLE Header
-        static Bytes kHeaderKey2{*silkworm::from_hex("00000000006ddd041b9ac5d63ba5c6a7e0c40a339499eef9b8b45fa247e701516f35a2357ccdaf1e")};
-        static Bytes kHeaderValue2{*silkworm::from_hex(
-            "f9025ba0a316f156582fb5fba2166910becdb6342965a801fa473e18cd6a0c06143cac1aa01dcc4de8dec75d7aab85b567b6ccd41ad312"
-            "451b948a7413f0a142fd40d49347940000000000000000000000000000000000000000a000636fe848d9d0dd8d3fe77deef0286329b01f"
-            "4e971501d1dc481365deea77bfa056e81f171bcc55a6ff8345e692c0f86e5b48e01b996cadc001622fb5e363b421a056e81f171bcc55a6"
-            "ff8345e692c0f86e5b48e01b996cadc001622fb5e363b421b9010000000000000000000000000000000000000000000000000000000000"
-            "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
-            "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
-            "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
-            "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
-            "000000000000000001836ddd048401c9c380808462ca3c74b8614e65746865726d696e6420312e31332e332d302d306533323839663535"
-            "2d3230a499270541450663356185c61f970959545219dee7616763658a87d3c80730c32cca058d57ccc16cc0b0ca4269c4dee474ee3612"
-            "f83cbf54f9fbffddba6d154401a00000000000000000000000000000000000000000000000000000000000000000880000000000000000"
-            "07")};
-        EXPECT_CALL(db_reader, get_one(db::table::kHeadersName, silkworm::ByteView{kHeaderKey2}))
-            .WillOnce(InvokeWithoutArgs([]() -> boost::asio::awaitable<Bytes> {
-                co_return kHeaderValue2;
-            }));
+        // TransactionDatabase::get: TABLE SyncStageProgress, call trace indices not built yet
+        EXPECT_CALL(db_reader, get(db::table::kSyncStageProgressName, _)).WillOnce(InvokeWithoutArgs([]() -> boost::asio::awaitable<KeyValue> { co_return KeyValue{}; }));
 
-        // TransactionDatabase::get: TABLE BlockBody
-        static Bytes kBlockBodyKey2{*silkworm::from_hex("00000000006ddd041b9ac5d63ba5c6a7e0c40a339499eef9b8b45fa247e701516f35a2357ccdaf1e")};
-        static Bytes kBlockBodyValue2{*silkworm::from_hex("c78405c62e6f02c0")};
-        EXPECT_CALL(db_reader, get_one(db::table::kBlockBodiesName, silkworm::ByteView{kBlockBodyKey2}))
-            .WillOnce(InvokeWithoutArgs([]() -> boost::asio::awaitable<Bytes> {
-                co_return kBlockBodyValue2;
-            }));
         EXPECT_CALL(db_reader, get_one(db::table::kExtraBlockDataName, _)).WillRepeatedly(InvokeWithoutArgs([]() -> boost::asio::awaitable<Bytes> { co_return Bytes{}; }));
 
         BlockCache block_cache;
@@ -5444,41 +5377,9 @@ TEST_CASE_METHOD(TraceCallExecutorTest, "TraceCallExecutor::trace_filter") {
           "fromAddress": ["0x2031832e54a2200bf678286f560f49a950db2ad5"]
         })"_json;
 
-        // TransactionDatabase::get_one: TABLE CanonicalHeader
-        static Bytes kCanonicalHeaderKey3{*silkworm::from_hex("00000000006ddd04")};
-        static Bytes kCanonicalHeaderValue3{*silkworm::from_hex("1b9ac5d63ba5c6a7e0c40a339499eef9b8b45fa247e701516f35a2357ccdaf1e")};
-        EXPECT_CALL(db_reader, get_one(db::table::kCanonicalHashesName, silkworm::ByteView{kCanonicalHeaderKey3}))
-            .WillOnce(InvokeWithoutArgs([]() -> boost::asio::awaitable<Bytes> {
-                co_return kCanonicalHeaderValue3;
-            }));
-
-        // TransactionDatabase::get: TABLE Header
-        static Bytes kHeaderKey2{*silkworm::from_hex("00000000006ddd041b9ac5d63ba5c6a7e0c40a339499eef9b8b45fa247e701516f35a2357ccdaf1e")};
-        static Bytes kHeaderValue2{*silkworm::from_hex(
-            "f9025ba0a316f156582fb5fba2166910becdb6342965a801fa473e18cd6a0c06143cac1aa01dcc4de8dec75d7aab85b567b6ccd41ad312"
-            "451b948a7413f0a142fd40d49347940000000000000000000000000000000000000000a000636fe848d9d0dd8d3fe77deef0286329b01f"
-            "4e971501d1dc481365deea77bfa056e81f171bcc55a6ff8345e692c0f86e5b48e01b996cadc001622fb5e363b421a056e81f171bcc55a6"
-            "ff8345e692c0f86e5b48e01b996cadc001622fb5e363b421b9010000000000000000000000000000000000000000000000000000000000"
-            "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
-            "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
-            "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
-            "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
-            "000000000000000001836ddd048401c9c380808462ca3c74b8614e65746865726d696e6420312e31332e332d302d306533323839663535"
-            "2d3230a499270541450663356185c61f970959545219dee7616763658a87d3c80730c32cca058d57ccc16cc0b0ca4269c4dee474ee3612"
-            "f83cbf54f9fbffddba6d154401a00000000000000000000000000000000000000000000000000000000000000000880000000000000000"
-            "07")};
-        EXPECT_CALL(db_reader, get_one(db::table::kHeadersName, silkworm::ByteView{kHeaderKey2}))
-            .WillOnce(InvokeWithoutArgs([]() -> boost::asio::awaitable<Bytes> {
-                co_return kHeaderValue2;
-            }));
+        // TransactionDatabase::get: TABLE SyncStageProgress, call trace indices not built yet
+        EXPECT_CALL(db_reader, get(db::table::kSyncStageProgressName, _)).WillOnce(InvokeWithoutArgs([]() -> boost::asio::awaitable<KeyValue> { co_return KeyValue{}; }));
 
-        // TransactionDatabase::get: TABLE BlockBody
-        static Bytes kBlockBodyKey2{*silkworm::from_hex("00000000006ddd041b9ac5d63ba5c6a7e0c40a339499eef9b8b45fa247e701516f35a2357ccdaf1e")};
-        static Bytes kBlockBodyValue2{*silkworm::from_hex("c78405c62e6f02c0")};
-        EXPECT_CALL(db_reader, get_one(db::table::kBlockBodiesName, silkworm::ByteView{kBlockBodyKey2}))
-            .WillOnce(InvokeWithoutArgs([]() -> boost::asio::awaitable<Bytes> {
-                co_return kBlockBodyValue2;
-            }));
         EXPECT_CALL(db_reader, get_one(db::table::kExtraBlockDataName, _)).WillRepeatedly(InvokeWithoutArgs([]() -> boost::asio::awaitable<Bytes> { co_return Bytes{}; }));
 
         BlockCache block_cache;
@@ -5496,6 +5397,35 @@ TEST_CASE_METHOD(TraceCallExecutorTest, "TraceCallExecutor::trace_filter") {
         ])"_json);
     }
 
+    SECTION("from block to block with fromAddress skipped by call trace index") {
+        TraceFilter trace_filter = R"({
+          "fromBlock": "0x6DDD02",
+          "toBlock": "0x6DDD03",
+          "fromAddress": ["0x2031832e54a2200bf678286f560f49a950db2ad5"]
+        })"_json;
+
+        // TransactionDatabase::get: TABLE SyncStageProgress, call trace indices up to date
+        EXPECT_CALL(db_reader, get(db::table::kSyncStageProgressName, _)).WillOnce(InvokeWithoutArgs([]() -> boost::asio::awaitable<KeyValue> {
+            co_return KeyValue{silkworm::Bytes{}, *silkworm::from_hex("00000000006ddd03")};
+        }));
+        // TransactionDatabase::walk: TABLE CallFromIndex, no block matching the sender
+        EXPECT_CALL(db_reader, walk(db::table::kCallFromIndexName, _, _, _)).WillOnce(InvokeWithoutArgs([]() -> boost::asio::awaitable<void> { co_return; }));
+
+        BlockCache block_cache;
+        std::shared_ptr<test::MockCursorDupSort> mock_cursor = std::make_shared<test::MockCursorDupSort>();
+        test::DummyTransaction tx{0, mock_cursor};
+        TraceCallExecutor executor{block_cache, db_reader, workers, tx};
+
+        stream.open_object();
+        spawn_and_wait(executor.trace_filter(trace_filter, &stream));
+        stream.close_object();
+        stream.close();
+
+        nlohmann::json json = nlohmann::json::parse(string_writer.get_content());
+        CHECK(json["result"] == R"([
+        ])"_json);
+    }
+
     SECTION("from block to block with count=0") {
         TraceFilter trace_filter = R"({
           "fromBlock": "0x6DDD02",
@@ -5560,41 +5490,6 @@ TEST_CASE_METHOD(TraceCallExecutorTest, "TraceCallExecutor::trace_filter") {
           "after": 0
         })"_json;
 
-        // TransactionDatabase::get_one: TABLE CanonicalHeader
-        static Bytes kCanonicalHeaderKey3{*silkworm::from_hex("00000000006ddd04")};
-        static Bytes kCanonicalHeaderValue3{*silkworm::from_hex("1b9ac5d63ba5c6a7e0c40a339499eef9b8b45fa247e701516f35a2357ccdaf1e")};
-        EXPECT_CALL(db_reader, get_one(db::table::kCanonicalHashesName, silkworm::ByteView{kCanonicalHeaderKey3}))
-            .WillOnce(InvokeWithoutArgs([]() -> boost::asio::awaitable<Bytes> {
-                co_return kCanonicalHeaderValue3;
-            }));
-
-        // TransactionDatabase::get: TABLE Header
-        static Bytes kHeaderKey2{*silkworm::from_hex("00000000006ddd041b9ac5d63ba5c6a7e0c40a339499eef9b8b45fa247e701516f35a2357ccdaf1e")};
-        static Bytes kHeaderValue2{*silkworm::from_hex(
-            "f9025ba0a316f156582fb5fba2166910becdb6342965a801fa473e18cd6a0c06143cac1aa01dcc4de8dec75d7aab85b567b6ccd41ad312"
-            "451b948a7413f0a142fd40d49347940000000000000000000000000000000000000000a000636fe848d9d0dd8d3fe77deef0286329b01f"
-            "4e971501d1dc481365deea77bfa056e81f171bcc55a6ff8345e692c0f86e5b48e01b996cadc001622fb5e363b421a056e81f171bcc55a6"
-            "ff8345e692c0f86e5b48e01b996cadc001622fb5e363b421b9010000000000000000000000000000000000000000000000000000000000"
-            "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
-            "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
-            "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
-            "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
-            "000000000000000001836ddd048401c9c380808462ca3c74b8614e65746865726d696e6420312e31332e332d302d306533323839663535"
-            "2d3230a499270541450663356185c61f970959545219dee7616763658a87d3c80730c32cca058d57ccc16cc0b0ca4269c4dee474ee3612"
-            "f83cbf54f9fbffddba6d154401a00000000000000000000000000000000000000000000000000000000000000000880000000000000000"
-            "07")};
-        EXPECT_CALL(db_reader, get_one(db::table::kHeadersName, silkworm::ByteView{kHeaderKey2}))
-            .WillOnce(InvokeWithoutArgs([]() -> boost::asio::awaitable<Bytes> {
-                co_return kHeaderValue2;
-            }));
-
-        // TransactionDatabase::get: TABLE BlockBody
-        static Bytes kBlockBodyKey2{*silkworm::from_hex("00000000006ddd041b9ac5d63ba5c6a7e0c40a339499eef9b8b45fa247e701516f35a2357ccdaf1e")};
-        static Bytes kBlockBodyValue2{*silkworm::from_hex("c78405c62e6f02c0")};
-        EXPECT_CALL(db_reader, get_one(db::table::kBlockBodiesName, silkworm::ByteView{kBlockBodyKey2}))
-            .WillOnce(InvokeWithoutArgs([]() -> boost::asio::awaitable<Bytes> {
-                co_return kBlockBodyValue2;
-            }));
         EXPECT_CALL(db_reader, get_one(db::table::kExtraBlockDataName, _)).WillRepeatedly(InvokeWithoutArgs([]() -> boost::asio::awaitable<Bytes> { co_return Bytes{}; }));
 
         BlockCache block_cache;
@@ -5645,41 +5540,6 @@ TEST_CASE_METHOD(TraceCallExecutorTest, "TraceCallExecutor::trace_filter") {
           "after": 1
         })"_json;
 
-        // TransactionDatabase::get_one: TABLE CanonicalHeader
-        static Bytes kCanonicalHeaderKey3{*silkworm::from_hex("00000000006ddd04")};
-        static Bytes kCanonicalHeaderValue3{*silkworm::from_hex("1b9ac5d63ba5c6a7e0c40a339499eef9b8b45fa247e701516f35a2357ccdaf1e")};
-        EXPECT_CALL(db_reader, get_one(db::table::kCanonicalHashesName, silkworm::ByteView{kCanonicalHeaderKey3}))
-            .WillOnce(InvokeWithoutArgs([]() -> boost::asio::awaitable<Bytes> {
-                co_return kCanonicalHeaderValue3;
-            }));
-
-        // TransactionDatabase::get: TABLE Header
-        static Bytes kHeaderKey2{*silkworm::from_hex("00000000006ddd041b9ac5d63ba5c6a7e0c40a339499eef9b8b45fa247e701516f35a2357ccdaf1e")};
-        static Bytes kHeaderValue2{*silkworm::from_hex(
-            "f9025ba0a316f156582fb5fba2166910becdb6342965a801fa473e18cd6a0c06143cac1aa01dcc4de8dec75d7aab85b567b6ccd41ad312"
-            "451b948a7413f0a142fd40d49347940000000000000000000000000000000000000000a000636fe848d9d0dd8d3fe77deef0286329b01f"
-            "4e971501d1dc481365deea77bfa056e81f171bcc55a6ff8345e692c0f86e5b48e01b996cadc001622fb5e363b421a056e81f171bcc55a6"
-            "ff8345e692c0f86e5b48e01b996cadc001622fb5e363b421b9010000000000000000000000000000000000000000000000000000000000"
-            "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
-            "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
-            "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
-            "00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
-            "000000000000000001836ddd048401c9c380808462ca3c74b8614e65746865726d696e6420312e31332e332d302d306533323839663535"
-            "2d3230a499270541450663356185c61f970959545219dee7616763658a87d3c80730c32cca058d57ccc16cc0b0ca4269c4dee474ee3612"
-            "f83cbf54f9fbffddba6d154401a00000000000000000000000000000000000000000000000000000000000000000880000000000000000"
-            "07")};
-        EXPECT_CALL(db_reader, get_one(db::table::kHeadersName, silkworm::ByteView{kHeaderKey2}))
-            .WillOnce(InvokeWithoutArgs([]() -> boost::asio::awaitable<Bytes> {
-                co_return kHeaderValue2;
-            }));
-
-        // TransactionDatabase::get: TABLE BlockBody
-        static Bytes kBlockBodyKey2{*silkworm::from_hex("00000000006ddd041b9ac5d63ba5c6a7e0c40a339499eef9b8b45fa247e701516f35a2357ccdaf1e")};
-        static Bytes kBlockBodyValue2{*silkworm::from_hex("c78405c62e6f02c0")};
-        EXPECT_CALL(db_reader, get_one(db::table::kBlockBodiesName, silkworm::ByteView{kBlockBodyKey2}))
-            .WillOnce(InvokeWithoutArgs([]() -> boost::asio::awaitable<Bytes> {
-                co_return kBlockBodyValue2;
-            }));
         EXPECT_CALL(db_reader, get_one(db::table::kExtraBlockDataName, _)).WillRepeatedly(InvokeWithoutArgs([]() -> boost::asio::awaitable<Bytes> { co_return Bytes{}; }));
 
         BlockCache block_cache;
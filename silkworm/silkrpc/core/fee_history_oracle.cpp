@@ -17,6 +17,9 @@
 #include "fee_history_oracle.hpp"
 
 #include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include <string>
 
 #include <boost/asio/post.hpp>
 #include <boost/asio/use_awaitable.hpp>
@@ -52,6 +55,27 @@ void to_json(nlohmann::json& json, const FeeHistory& fh) {
     }
 }
 
+Rewards percentiles(const BlockRewards& block_rewards, const std::vector<std::int8_t>& reward_percentile) {
+    Rewards rewards(reward_percentile.size());
+    const auto& sorted_rewards{block_rewards.sorted_rewards};
+    if (sorted_rewards.empty()) {
+        return rewards;
+    }
+
+    // Geth feeHistory: reward of the first transaction reaching the percentile of block gas used
+    std::size_t tx_index{0};
+    uint64_t sum_gas_used{sorted_rewards[0].second};
+    for (std::size_t idx{0}; idx < reward_percentile.size(); ++idx) {
+        const auto threshold_gas_used{static_cast<uint64_t>(static_cast<double>(block_rewards.gas_used) * reward_percentile[idx] / 100)};
+        while (sum_gas_used < threshold_gas_used && tx_index < sorted_rewards.size() - 1) {
+            ++tx_index;
+            sum_gas_used += sorted_rewards[tx_index].second;
+        }
+        rewards[idx] = sorted_rewards[tx_index].first;
+    }
+    return rewards;
+}
+
 boost::asio::awaitable<FeeHistory> FeeHistoryOracle::fee_history(uint64_t newest_block, uint64_t block_count, const std::vector<std::int8_t>& reward_percentile) {
     FeeHistory fee_history;
     if (block_count < 1) {
@@ -65,15 +89,15 @@ boost::asio::awaitable<FeeHistory> FeeHistoryOracle::fee_history(uint64_t newest
     for (size_t idx = 0; idx < reward_percentile.size(); idx++) {
         if (reward_percentile[idx] < 0 || reward_percentile[idx] > 100) {
             std::ostringstream ss;
-            ss << "ErrInvalidPercentile: " << std::dec << reward_percentile[idx];
+            ss << "ErrInvalidPercentile: " << std::dec << static_cast<int>(reward_percentile[idx]);
 
             fee_history.error = ss.str();
             co_return fee_history;
         }
         if (idx > 0 && reward_percentile[idx] < reward_percentile[idx - 1]) {
             std::ostringstream ss;
-            ss << "ErrInvalidPercentile: #" << idx - 1 << ":" << reward_percentile[idx - 1]
-               << "> #" << idx << ":" << reward_percentile[idx];
+            ss << "ErrInvalidPercentile: #" << idx - 1 << ":" << static_cast<int>(reward_percentile[idx - 1])
+               << "> #" << idx << ":" << static_cast<int>(reward_percentile[idx]);
             fee_history.error = ss.str();
             co_return fee_history;
         }
@@ -81,110 +105,99 @@ boost::asio::awaitable<FeeHistory> FeeHistoryOracle::fee_history(uint64_t newest
 
     auto max_history = reward_percentile.size() > 0 ? kDefaultMaxBlockHistory : kDefaultMaxHeaderHistory;
 
-    auto block_range = co_await resolve_block_range(newest_block, block_count, max_history);
-
-    fee_history.rewards.reserve(block_range.num_blocks);
-    fee_history.base_fees_per_gas.reserve(block_range.num_blocks + 1);
-    fee_history.gas_used_ratio.reserve(block_range.num_blocks);
+    const auto block_range = resolve_block_range(newest_block, block_count, max_history);
+    if (block_range.num_blocks == 0) {
+        co_return fee_history;
+    }
 
-    auto oldest_block = block_range.last_block + 1 - block_range.num_blocks;
-    for (auto idx = block_range.num_blocks; idx > 0; idx--) {
-        auto block_number = ++oldest_block - 1;
+    const auto oldest_block = block_range.last_block + 1 - block_range.num_blocks;
+    fee_history.oldest_block = oldest_block;
+    fee_history.base_fees_per_gas.resize(block_range.num_blocks + 1);
+    fee_history.gas_used_ratio.resize(block_range.num_blocks);
+    if (!reward_percentile.empty()) {
+        fee_history.rewards.resize(block_range.num_blocks);
+    }
 
-        if (block_number > block_range.last_block) {
-            continue;
-        }
-        BlockFees block_fees{block_number};
-
-        if (block_number >= block_range.block.block.header.number) {
-            block_fees.block = block_range.block;
-            block_fees.receipts = co_await receipts_provider_(block_fees.block);
-            ;
-        } else {
-            block_fees.block = *co_await block_provider_(block_number);
-            if (reward_percentile.size() > 0) {
-                block_fees.receipts = co_await receipts_provider_(block_fees.block);
-            }
+    for (auto block_number = oldest_block; block_number <= block_range.last_block; ++block_number) {
+        const auto block_with_hash = co_await block_provider_(block_number);
+        if (!block_with_hash) {
+            // TODO(sixtysixter) firstMissing management as in erigon
+            throw std::invalid_argument{"FeeHistoryOracle::fee_history block not found: " + std::to_string(block_number)};
         }
 
-        co_await process_block(block_fees, reward_percentile);
-        auto index = block_fees.block_number - oldest_block;
-        fee_history.rewards[index] = block_fees.rewards;
+        auto block_fees = co_await process_block(*block_with_hash, reward_percentile);
+        const auto index = block_number - oldest_block;
+        if (!reward_percentile.empty()) {
+            fee_history.rewards[index] = std::move(block_fees.rewards);
+        }
         fee_history.base_fees_per_gas[index] = block_fees.base_fee;
         fee_history.base_fees_per_gas[index + 1] = block_fees.next_base_fee;
         fee_history.gas_used_ratio[index] = block_fees.gas_used_ratio;
     }
-    // TODO(sixtysixter) firstMissing management as in erigon
 
     co_return fee_history;
 }
 
-boost::asio::awaitable<BlockRange> FeeHistoryOracle::resolve_block_range(uint64_t last_block, uint64_t block_count, uint64_t max_history) {
-    const auto block_with_hash = co_await block_provider_(last_block);
-    const auto receipts = co_await receipts_provider_(*block_with_hash);
-
-    if (max_history != 0) {
-        // limit retrieval to the given number of latest blocks
-        const auto too_old_count = last_block - max_history + block_count;
-        if (too_old_count > 0) {
-            // tooOldCount is the number of requested blocks that are too old to be served
-            if (block_count > too_old_count) {
-                block_count -= too_old_count;
-            } else {
-                co_return BlockRange{0};
-            }
-        }
+BlockRange FeeHistoryOracle::resolve_block_range(uint64_t last_block, uint64_t block_count, uint64_t max_history) {
+    // limit retrieval to the given number of latest blocks, which cannot go beyond genesis
+    if (max_history != 0 && block_count > max_history) {
+        block_count = max_history;
     }
-
-    BlockRange block_range{block_count, last_block, *block_with_hash, receipts};
-
-    co_return block_range;
+    if (block_count > last_block + 1) {
+        block_count = last_block + 1;
+    }
+    return BlockRange{block_count, last_block};
 }
 
-boost::asio::awaitable<void> FeeHistoryOracle::process_block(BlockFees& block_fees, const std::vector<std::int8_t>& reward_percentile) {
-    auto& header = block_fees.block.block.header;
+boost::asio::awaitable<BlockFees> FeeHistoryOracle::process_block(const BlockWithHash& block_with_hash, const std::vector<std::int8_t>& reward_percentile) {
+    const auto& header = block_with_hash.block.header;
 
+    BlockFees block_fees;
     block_fees.base_fee = header.base_fee_per_gas.value_or(0);
-    block_fees.gas_used_ratio = static_cast<double>(header.gas_used) / static_cast<double>(header.gas_limit);
+    block_fees.gas_used_ratio = header.gas_limit > 0 ? static_cast<double>(header.gas_used) / static_cast<double>(header.gas_limit) : 0;
 
-    const auto parent_block = co_await block_provider_(header.number - 1);
+    // Base fee of the next block follows from this header alone
+    const auto evmc_revision = config_.revision(header);
+    block_fees.next_base_fee = protocol::expected_base_fee_per_gas(header, evmc_revision).value_or(0);
 
-    const auto evmc_revision = config_.revision(parent_block->block.header);
-    block_fees.next_base_fee = protocol::expected_base_fee_per_gas(parent_block->block.header, evmc_revision).value_or(0);
-
-    if (reward_percentile.size() == 0) {
-        co_return;
-    }
-    if (block_fees.receipts.size() != block_fees.block.block.transactions.size()) {
-        co_return;
+    if (reward_percentile.empty()) {
+        co_return block_fees;
     }
 
-    if (block_fees.block.block.transactions.size() == 0) {
-        std::fill(block_fees.rewards.begin(), block_fees.rewards.end(), 0);
-        co_return;
-    }
+    const auto rewards = co_await block_rewards(block_with_hash);
+    block_fees.rewards = percentiles(*rewards, reward_percentile);
 
-    std::map<intx::uint256, std::uint64_t> gas_and_rewards;
-    for (size_t idx = 0; idx < block_fees.block.block.transactions.size(); idx++) {
-        const auto reward = block_fees.block.block.transactions[idx].effective_gas_price(block_fees.base_fee);
-        gas_and_rewards.emplace(reward, block_fees.receipts[idx].gas_used);
-    }
+    co_return block_fees;
+}
 
-    auto index = gas_and_rewards.begin();
-    auto last = --gas_and_rewards.end();
-    auto sum_gas_used = index->second;
-    for (size_t idx = 0; idx < reward_percentile.size(); idx++) {
-        std::uint8_t percentile = static_cast<std::uint8_t>(reward_percentile[idx]);
-        std::uint64_t threshold_gas_used = header.gas_used * percentile / 100;
-        while (index != last) {
-            index++;
-            if (sum_gas_used < threshold_gas_used) {
-                sum_gas_used += index->second;
-            }
+boost::asio::awaitable<std::shared_ptr<BlockRewards>> FeeHistoryOracle::block_rewards(const BlockWithHash& block_with_hash) {
+    if (rewards_cache_ != nullptr) {
+        if (auto cached_rewards = rewards_cache_->get(block_with_hash.hash)) {
+            co_return *cached_rewards;
         }
-        block_fees.rewards[idx] = index->first;
     }
 
-    co_return;
+    const auto& block = block_with_hash.block;
+    const auto base_fee = block.header.base_fee_per_gas.value_or(0);
+    auto rewards = std::make_shared<BlockRewards>();
+    rewards->gas_used = block.header.gas_used;
+
+    const auto receipts = co_await receipts_provider_(block_with_hash);
+    if (receipts.size() != block.transactions.size()) {
+        SILK_WARN << "FeeHistoryOracle::block_rewards receipts mismatch for block " << block.header.number
+                  << ": #txs " << block.transactions.size() << " #receipts " << receipts.size();
+        co_return rewards;
+    }
+    rewards->sorted_rewards.reserve(block.transactions.size());
+    for (size_t idx = 0; idx < block.transactions.size(); idx++) {
+        rewards->sorted_rewards.emplace_back(block.transactions[idx].priority_fee_per_gas(base_fee), receipts[idx].gas_used);
+    }
+    std::sort(rewards->sorted_rewards.begin(), rewards->sorted_rewards.end());
+
+    if (rewards_cache_ != nullptr) {
+        rewards_cache_->insert(block_with_hash.hash, rewards);
+    }
+    co_return rewards;
 }
+
 }  // namespace silkworm::rpc::fee_history
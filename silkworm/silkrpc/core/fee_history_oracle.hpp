@@ -16,16 +16,20 @@
 
 #pragma once
 
+#include <cstddef>
 #include <functional>
 #include <limits>
 #include <memory>
+#include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <silkworm/infra/concurrency/coroutine.hpp>
 
 #include <boost/asio/awaitable.hpp>
 
+#include <silkworm/core/common/lru_cache.hpp>
 #include <silkworm/core/common/util.hpp>
 #include <silkworm/core/types/block.hpp>
 #include <silkworm/core/types/transaction.hpp>
@@ -49,27 +53,50 @@ struct FeeHistory {
 
 void to_json(nlohmann::json& json, const FeeHistory& fh);
 
+//! Per-transaction effective priority fees of one block along with their gas used, sorted by fee
+struct BlockRewards {
+    uint64_t gas_used{0};
+    std::vector<std::pair<intx::uint256, uint64_t>> sorted_rewards;
+};
+
+//! Computes the effective priority fees at the given (non-decreasing) percentiles of gas used in block
+Rewards percentiles(const BlockRewards& block_rewards, const std::vector<std::int8_t>& reward_percentile);
+
+//! Cache of the block rewards by block hash, so that receipts are read once per block whatever the percentiles
+class BlockRewardsCache {
+  public:
+    explicit BlockRewardsCache(std::size_t capacity = 1024, bool shared_cache = true)
+        : rewards_cache_(capacity, shared_cache) {}
+
+    std::optional<std::shared_ptr<BlockRewards>> get(const evmc::bytes32& key) {
+        return rewards_cache_.get_as_copy(key);
+    }
+
+    void insert(const evmc::bytes32& key, const std::shared_ptr<BlockRewards> rewards) {
+        rewards_cache_.put(key, rewards);
+    }
+
+  private:
+    lru_cache<evmc::bytes32, std::shared_ptr<BlockRewards>> rewards_cache_;
+};
+
 struct BlockRange {
-    uint64_t num_blocks;
-    uint64_t last_block;
-    BlockWithHash block;
-    rpc::Receipts receipts;
+    uint64_t num_blocks{0};
+    uint64_t last_block{0};
 };
 
 struct BlockFees {
-    uint64_t block_number;
-    BlockWithHash block;
-    rpc::Receipts receipts;
     Rewards rewards;
     intx::uint256 base_fee;
     intx::uint256 next_base_fee;
-    double gas_used_ratio;
+    double gas_used_ratio{0};
 };
 
 class FeeHistoryOracle {
   public:
-    explicit FeeHistoryOracle(const silkworm::ChainConfig& config, const BlockProvider& block_provider, ReceiptsProvider& receipts_provider)
-        : config_{config}, block_provider_(block_provider), receipts_provider_(receipts_provider) {}
+    explicit FeeHistoryOracle(const silkworm::ChainConfig& config, const BlockProvider& block_provider, ReceiptsProvider& receipts_provider,
+                              BlockRewardsCache* rewards_cache = nullptr)
+        : config_{config}, block_provider_(block_provider), receipts_provider_(receipts_provider), rewards_cache_{rewards_cache} {}
     virtual ~FeeHistoryOracle() {}
 
     FeeHistoryOracle(const FeeHistoryOracle&) = delete;
@@ -79,15 +106,17 @@ class FeeHistoryOracle {
 
   private:
     static inline const std::uint32_t kDefaultMaxFeeHistory = 1024;
-    static inline const std::uint32_t kDefaultMaxHeaderHistory = 300;
-    static inline const std::uint32_t kDefaultMaxBlockHistory = 5;
+    static inline const std::uint32_t kDefaultMaxHeaderHistory = 1024;
+    static inline const std::uint32_t kDefaultMaxBlockHistory = 1024;
 
-    boost::asio::awaitable<BlockRange> resolve_block_range(uint64_t newest_block, uint64_t block_count, uint64_t max_history);
-    boost::asio::awaitable<void> process_block(BlockFees& block_fees, const std::vector<std::int8_t>& reward_percentile);
+    static BlockRange resolve_block_range(uint64_t last_block, uint64_t block_count, uint64_t max_history);
+    boost::asio::awaitable<BlockFees> process_block(const BlockWithHash& block_with_hash, const std::vector<std::int8_t>& reward_percentile);
+    boost::asio::awaitable<std::shared_ptr<BlockRewards>> block_rewards(const BlockWithHash& block_with_hash);
 
     const silkworm::ChainConfig& config_;
     const BlockProvider& block_provider_;
     const ReceiptsProvider& receipts_provider_;
+    BlockRewardsCache* rewards_cache_;
 };
 
 }  // namespace silkworm::rpc::fee_history
@@ -16,8 +16,12 @@
 
 #include "fee_history_oracle.hpp"
 
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/thread_pool.hpp>
+#include <boost/asio/use_future.hpp>
 #include <catch2/catch.hpp>
 
+#include <silkworm/core/chain/config.hpp>
 #include <silkworm/infra/common/log.hpp>
 #include <silkworm/infra/test/log.hpp>
 
@@ -56,4 +60,79 @@ TEST_CASE("FeeHistory: json serialization") {
         })"_json);
     }
 }
+
+TEST_CASE("FeeHistory: reward percentiles") {
+    silkworm::test::SetLogVerbosityGuard log_guard{log::Level::kNone};
+
+    SECTION("no transactions") {
+        const BlockRewards block_rewards;
+        CHECK(percentiles(block_rewards, {10, 90}) == Rewards{0, 0});
+    }
+
+    SECTION("gas weighted") {
+        const BlockRewards block_rewards{100'000, {{1, 21'000}, {2, 21'000}, {2, 0}, {10, 58'000}}};
+        CHECK(percentiles(block_rewards, {0, 25, 50, 100}) == Rewards{1, 2, 10, 10});
+        CHECK(percentiles(block_rewards, {}).empty());
+    }
+}
+
+TEST_CASE("FeeHistoryOracle: fee history") {
+    silkworm::test::SetLogVerbosityGuard log_guard{log::Level::kNone};
+    boost::asio::thread_pool pool{1};
+
+    BlockProvider block_provider = [](uint64_t block_number) -> boost::asio::awaitable<std::shared_ptr<BlockWithHash>> {
+        auto block_with_hash = std::make_shared<BlockWithHash>();
+        block_with_hash->block.header.number = block_number;
+        block_with_hash->block.header.gas_limit = 30'000'000;
+        block_with_hash->block.header.gas_used = 15'000'000;
+        block_with_hash->block.transactions.resize(1);
+        block_with_hash->block.transactions[0].max_fee_per_gas = 2;
+        block_with_hash->block.transactions[0].max_priority_fee_per_gas = 2;
+        block_with_hash->hash.bytes[31] = static_cast<uint8_t>(block_number);
+        co_return block_with_hash;
+    };
+    std::size_t receipts_reads{0};
+    ReceiptsProvider receipts_provider = [&receipts_reads](const BlockWithHash&) -> boost::asio::awaitable<rpc::Receipts> {
+        ++receipts_reads;
+        rpc::Receipts receipts(1);
+        receipts[0].gas_used = 15'000'000;
+        co_return receipts;
+    };
+    BlockRewardsCache rewards_cache;
+    FeeHistoryOracle oracle{kMainnetConfig, block_provider, receipts_provider, &rewards_cache};
+
+    SECTION("no percentiles") {
+        const std::vector<std::int8_t> reward_percentile;
+        auto result = boost::asio::co_spawn(pool, oracle.fee_history(9, 20, reward_percentile), boost::asio::use_future);
+        const auto fee_history = result.get();
+        CHECK(fee_history.oldest_block == 0);
+        CHECK(fee_history.base_fees_per_gas.size() == 11);
+        CHECK(fee_history.gas_used_ratio == std::vector<double>(10, 0.5));
+        CHECK(fee_history.rewards.empty());
+        CHECK(receipts_reads == 0);
+    }
+
+    SECTION("receipts read once per block") {
+        const std::vector<std::int8_t> reward_percentile{25, 75};
+        auto result1 = boost::asio::co_spawn(pool, oracle.fee_history(9, 4, reward_percentile), boost::asio::use_future);
+        const auto fee_history1 = result1.get();
+        CHECK(fee_history1.oldest_block == 6);
+        CHECK(fee_history1.base_fees_per_gas.size() == 5);
+        CHECK(fee_history1.gas_used_ratio.size() == 4);
+        CHECK(fee_history1.rewards == std::vector<Rewards>(4, Rewards{2, 2}));
+        CHECK(receipts_reads == 4);
+
+        auto result2 = boost::asio::co_spawn(pool, oracle.fee_history(9, 4, reward_percentile), boost::asio::use_future);
+        const auto fee_history2 = result2.get();
+        CHECK(fee_history2.rewards == fee_history1.rewards);
+        CHECK(receipts_reads == 4);
+    }
+
+    SECTION("invalid percentiles") {
+        const std::vector<std::int8_t> reward_percentile{75, 25};
+        auto result = boost::asio::co_spawn(pool, oracle.fee_history(9, 4, reward_percentile), boost::asio::use_future);
+        CHECK(result.get().error);
+    }
+}
+
 }  // namespace silkworm::rpc::fee_history
@@ -173,23 +173,42 @@ boost::asio::awaitable<evmc::bytes32> read_head_header_hash(const DatabaseReader
 }
 
 boost::asio::awaitable<uint64_t> read_cumulative_transaction_count(const DatabaseReader& reader, uint64_t block_number) {
-    const auto block_hash = co_await read_canonical_block_hash(reader, block_number);
-    const auto data = co_await read_body_rlp(reader, block_hash, block_number);
-    if (data.empty()) {
-        throw std::runtime_error{"empty block body RLP in read_body"};
-    }
-    SILK_TRACE << "RLP data for block body #" << block_number << ": " << silkworm::to_hex(data);
+    // Blocks not executed yet are not indexed: add their transactions down to the nearest indexed block
+    uint64_t unindexed_transaction_count{0};
+    for (auto current_block_number{block_number}; current_block_number > 0; --current_block_number) {
+        const auto block_key = silkworm::db::block_key(current_block_number);
+        const auto value = co_await reader.get_one(db::table::kCumulativeTransactionIndexName, block_key);
+        if (value.size() == sizeof(uint64_t)) {
+            const auto cumulative_transaction_count{boost::endian::load_big_u64(value.data()) + unindexed_transaction_count};
+            SILK_DEBUG << "rawdb::read_cumulative_transaction_count: " << cumulative_transaction_count;
+            co_return cumulative_transaction_count;
+        }
 
-    try {
-        silkworm::ByteView data_view{data};
-        auto stored_body{silkworm::db::detail::decode_stored_block_body(data_view)};
-        // 1 system txn in the beginning of block, and 1 at the end
-        SILK_DEBUG << "base_txn_id: " << stored_body.base_txn_id + 1 << " txn_count: " << stored_body.txn_count - 2;
-        co_return stored_body.base_txn_id + stored_body.txn_count - 1;
-    } catch (const silkworm::DecodingException& error) {
-        SILK_ERROR << "RLP decoding error for block body #" << block_number << " [" << error.what() << "]";
-        throw std::runtime_error{"RLP decoding error for block body [" + std::string(error.what()) + "]"};
+        const auto block_hash = co_await read_canonical_block_hash(reader, current_block_number);
+        const auto data = co_await read_body_rlp(reader, block_hash, current_block_number);
+        if (data.empty()) {
+            throw std::runtime_error{"empty block body RLP in read_body"};
+        }
+        SILK_TRACE << "RLP data for block body #" << current_block_number << ": " << silkworm::to_hex(data);
+
+        silkworm::db::detail::BlockBodyForStorage stored_body;
+        try {
+            silkworm::ByteView data_view{data};
+            stored_body = silkworm::db::detail::decode_stored_block_body(data_view);
+        } catch (const silkworm::DecodingException& error) {
+            SILK_ERROR << "RLP decoding error for block body #" << current_block_number << " [" << error.what() << "]";
+            throw std::runtime_error{"RLP decoding error for block body [" + std::string(error.what()) + "]"};
+        }
+        SILK_DEBUG << "base_txn_id: " << stored_body.base_txn_id << " txn_count: " << stored_body.txn_count;
+        if (stored_body.base_txn_id & kSnapshotTxnIdFlag) {
+            // Snapshot bodies come already renumbered without the system txns
+            co_return (stored_body.base_txn_id & ~kSnapshotTxnIdFlag) + stored_body.txn_count + unindexed_transaction_count;
+        }
+        // Database transaction ids also count unwound and non-canonical bodies, so only the count is meaningful
+        unindexed_transaction_count += stored_body.txn_count;
     }
+    // Genesis has no transactions
+    co_return unindexed_transaction_count;
 }
 
 boost::asio::awaitable<silkworm::BlockBody> read_body(const DatabaseReader& reader, const evmc::bytes32& block_hash, uint64_t block_number) {
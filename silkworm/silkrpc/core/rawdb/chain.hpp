@@ -39,6 +39,10 @@ namespace silkworm::rpc::core::rawdb {
 using Addresses = std::vector<evmc::address>;
 using Transactions = std::vector<silkworm::Transaction>;
 
+//! The flag set on the transaction IDs of the block bodies read from snapshots (see ethdb::file::SnapshotCursor):
+//! those IDs only make sense to walk BlockTransactions and must be stripped of the flag before any other use
+inline constexpr uint64_t kSnapshotTxnIdFlag{uint64_t{1} << 63};
+
 boost::asio::awaitable<uint64_t> read_header_number(const DatabaseReader& reader, const evmc::bytes32& block_hash);
 
 boost::asio::awaitable<ChainConfig> read_chain_config(const DatabaseReader& reader);
@@ -69,6 +73,8 @@ boost::asio::awaitable<evmc::bytes32> read_head_header_hash(const DatabaseReader
 
 boost::asio::awaitable<silkworm::BlockBody> read_body(const DatabaseReader& reader, const evmc::bytes32& block_hash, uint64_t block_number);
 
+//! Reads the count of transactions in all canonical blocks up to and including the given one from the
+//! CumulativeTransactionIndex, adding those of the stored bodies of the blocks not indexed yet
 boost::asio::awaitable<uint64_t> read_cumulative_transaction_count(const DatabaseReader& reader, uint64_t block_number);
 
 boost::asio::awaitable<silkworm::Bytes> read_header_rlp(const DatabaseReader& reader, const evmc::bytes32& block_hash, uint64_t block_number);
@@ -30,6 +30,7 @@
 #include <silkworm/core/common/util.hpp>
 #include <silkworm/infra/test/log.hpp>
 #include <silkworm/node/db/tables.hpp>
+#include <silkworm/node/db/util.hpp>
 #include <silkworm/silkrpc/core/blocks.hpp>
 #include <silkworm/silkrpc/test/mock_database_reader.hpp>
 
@@ -1421,14 +1422,58 @@ TEST_CASE("read_noncanonical_transactions") {
 
 TEST_CASE("read_cumulative_transaction_count") {
     silkworm::test::SetLogVerbosityGuard log_guard{log::Level::kNone};
+    SECTION("block indexed") {
+        boost::asio::thread_pool pool{1};
+        test::MockDatabaseReader db_reader;
+        const uint64_t block_number{4'000'000};
+        EXPECT_CALL(db_reader, get_one(db::table::kCumulativeTransactionIndexName, _)).WillOnce(InvokeWithoutArgs([]() -> boost::asio::awaitable<silkworm::Bytes> { co_return *silkworm::from_hex("000000000069e4fc"); }));
+        auto result = boost::asio::co_spawn(pool, read_cumulative_transaction_count(db_reader, block_number), boost::asio::use_future);
+        CHECK(result.get() == 6939900);
+    }
+
     SECTION("block found and matching") {
         boost::asio::thread_pool pool{1};
         test::MockDatabaseReader db_reader;
         const uint64_t block_number{4'000'000};
+        // Block not indexed yet on top of an indexed one
+        EXPECT_CALL(db_reader, get_one(db::table::kCumulativeTransactionIndexName, silkworm::db::block_key(block_number))).WillOnce(InvokeWithoutArgs([]() -> boost::asio::awaitable<silkworm::Bytes> { co_return silkworm::Bytes{}; }));
+        EXPECT_CALL(db_reader, get_one(db::table::kCumulativeTransactionIndexName, silkworm::db::block_key(block_number - 1))).WillOnce(InvokeWithoutArgs([]() -> boost::asio::awaitable<silkworm::Bytes> { co_return *silkworm::from_hex("000000000069e4fc"); }));
         EXPECT_CALL(db_reader, get_one(db::table::kCanonicalHashesName, _)).WillOnce(InvokeWithoutArgs([]() -> boost::asio::awaitable<silkworm::Bytes> { co_return *silkworm::from_hex("9816753229fc0736bf86a5048de4bc9fcdede8c91dadf88c828c76b2281dff"); }));
         EXPECT_CALL(db_reader, get_one(db::table::kBlockBodiesName, _)).WillOnce(InvokeWithoutArgs([]() -> boost::asio::awaitable<silkworm::Bytes> { co_return kBody; }));
         //EXPECT_CALL(db_reader, get_one(db::table::kExtraBlockDataName, _)).WillOnce(InvokeWithoutArgs([]() -> boost::asio::awaitable<Bytes> { co_return Bytes{}; }));
         auto result = boost::asio::co_spawn(pool, read_cumulative_transaction_count(db_reader, block_number), boost::asio::use_future);
+        CHECK(result.get() == 6939903);
+    }
+
+    SECTION("empty body after the genesis") {
+        boost::asio::thread_pool pool{1};
+        test::MockDatabaseReader db_reader;
+        const silkworm::db::detail::BlockBodyForStorage empty_body{.base_txn_id = 0, .txn_count = 0};
+        EXPECT_CALL(db_reader, get_one(db::table::kCumulativeTransactionIndexName, _)).WillOnce(InvokeWithoutArgs([]() -> boost::asio::awaitable<silkworm::Bytes> { co_return silkworm::Bytes{}; }));
+        EXPECT_CALL(db_reader, get_one(db::table::kCanonicalHashesName, _)).WillOnce(InvokeWithoutArgs([]() -> boost::asio::awaitable<silkworm::Bytes> { co_return *silkworm::from_hex("9816753229fc0736bf86a5048de4bc9fcdede8c91dadf88c828c76b2281dff"); }));
+        EXPECT_CALL(db_reader, get_one(db::table::kBlockBodiesName, _)).WillOnce(InvokeWithoutArgs([&]() -> boost::asio::awaitable<silkworm::Bytes> { co_return empty_body.encode(); }));
+        auto result = boost::asio::co_spawn(pool, read_cumulative_transaction_count(db_reader, 1), boost::asio::use_future);
+        CHECK(result.get() == 0);
+    }
+
+    SECTION("genesis") {
+        boost::asio::thread_pool pool{1};
+        test::MockDatabaseReader db_reader;
+        EXPECT_CALL(db_reader, get_one(_, _)).Times(0);
+        auto result = boost::asio::co_spawn(pool, read_cumulative_transaction_count(db_reader, 0), boost::asio::use_future);
+        CHECK(result.get() == 0);
+    }
+
+    SECTION("block found in snapshots") {
+        boost::asio::thread_pool pool{1};
+        test::MockDatabaseReader db_reader;
+        const uint64_t block_number{4'000'000};
+        // Body renumbered by SnapshotCursor w/o the 2 system txns
+        const silkworm::db::detail::BlockBodyForStorage snapshot_body{.base_txn_id = 6939736 | kSnapshotTxnIdFlag, .txn_count = 4};
+        EXPECT_CALL(db_reader, get_one(db::table::kCumulativeTransactionIndexName, _)).WillOnce(InvokeWithoutArgs([]() -> boost::asio::awaitable<silkworm::Bytes> { co_return silkworm::Bytes{}; }));
+        EXPECT_CALL(db_reader, get_one(db::table::kCanonicalHashesName, _)).WillOnce(InvokeWithoutArgs([]() -> boost::asio::awaitable<silkworm::Bytes> { co_return *silkworm::from_hex("9816753229fc0736bf86a5048de4bc9fcdede8c91dadf88c828c76b2281dff"); }));
+        EXPECT_CALL(db_reader, get_one(db::table::kBlockBodiesName, _)).WillOnce(InvokeWithoutArgs([&]() -> boost::asio::awaitable<silkworm::Bytes> { co_return snapshot_body.encode(); }));
+        auto result = boost::asio::co_spawn(pool, read_cumulative_transaction_count(db_reader, block_number), boost::asio::use_future);
         CHECK(result.get() == 6939740);
     }
 
@@ -1436,6 +1481,7 @@ TEST_CASE("read_cumulative_transaction_count") {
         boost::asio::thread_pool pool{1};
         test::MockDatabaseReader db_reader;
         const uint64_t block_number{4'000'000};
+        EXPECT_CALL(db_reader, get_one(db::table::kCumulativeTransactionIndexName, _)).WillOnce(InvokeWithoutArgs([]() -> boost::asio::awaitable<silkworm::Bytes> { co_return silkworm::Bytes{}; }));
         EXPECT_CALL(db_reader, get_one(db::table::kCanonicalHashesName, _)).WillOnce(InvokeWithoutArgs([]() -> boost::asio::awaitable<silkworm::Bytes> { co_return *silkworm::from_hex("9816753229fc0736bf86a5048de4bc9fcdede8c91dadf88c828c76b2281dff"); }));
         EXPECT_CALL(db_reader, get_one(db::table::kBlockBodiesName, _)).WillOnce(InvokeWithoutArgs([]() -> boost::asio::awaitable<silkworm::Bytes> { co_return silkworm::Bytes{}; }));
         auto result = boost::asio::co_spawn(pool, read_cumulative_transaction_count(db_reader, block_number), boost::asio::use_future);
@@ -1450,6 +1496,7 @@ TEST_CASE("read_cumulative_transaction_count") {
         boost::asio::thread_pool pool{1};
         test::MockDatabaseReader db_reader;
         const uint64_t block_number{4'000'000};
+        EXPECT_CALL(db_reader, get_one(db::table::kCumulativeTransactionIndexName, _)).WillOnce(InvokeWithoutArgs([]() -> boost::asio::awaitable<silkworm::Bytes> { co_return silkworm::Bytes{}; }));
         EXPECT_CALL(db_reader, get_one(db::table::kCanonicalHashesName, _)).WillOnce(InvokeWithoutArgs([]() -> boost::asio::awaitable<silkworm::Bytes> { co_return *silkworm::from_hex("9816753229fc0736bf86a5048de4bc9fcdede8c91dadf88c828c76b2281dff"); }));
         EXPECT_CALL(db_reader, get_one(db::table::kBlockBodiesName, _)).WillOnce(InvokeWithoutArgs([]() -> boost::asio::awaitable<silkworm::Bytes> { co_return silkworm::Bytes{0x00, 0x01}; }));
         //EXPECT_CALL(db_reader, get_one(db::table::kExtraBlockDataName, _)).WillOnce(InvokeWithoutArgs([]() -> boost::asio::awaitable<Bytes> { co_return Bytes{}; }));
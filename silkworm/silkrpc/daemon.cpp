@@ -23,14 +23,21 @@
 #include <filesystem>
 #include <stdexcept>
 
+#include <boost/asio/co_spawn.hpp>
 #include <boost/asio/signal_set.hpp>
 #include <boost/process/environment.hpp>
 #include <grpcpp/grpcpp.h>
+#include <magic_enum.hpp>
 
+#include <silkworm/core/crypto/signer_recovery.hpp>
 #include <silkworm/infra/common/ensure.hpp>
 #include <silkworm/infra/common/log.hpp>
 #include <silkworm/infra/concurrency/private_service.hpp>
 #include <silkworm/infra/concurrency/shared_service.hpp>
+#include <silkworm/infra/concurrency/thread_affinity.hpp>
+#include <silkworm/infra/metrics/registry.hpp>
+#include <silkworm/silkrpc/core/evm_executor.hpp>
+#include <silkworm/silkrpc/core/fee_history_oracle.hpp>
 #include <silkworm/silkrpc/ethbackend/remote_backend.hpp>
 #include <silkworm/silkrpc/ethdb/file/local_database.hpp>
 #include <silkworm/silkrpc/ethdb/kv/remote_database.hpp>
@@ -105,6 +112,12 @@ int Daemon::run(const DaemonSettings& settings, const DaemonInfo& info) {
             SILK_LOG << "Silkrpc launched with datadir " << *settings.datadir << " using "
                      << context_pool_settings.num_contexts << " contexts, " << settings.num_workers << " workers";
         }
+        if (!context_pool_settings.cpu_set.empty() || !settings.workers_cpu_set.empty()) {
+            SILK_LOG << "Silkrpc contexts on cpus: " << concurrency::to_string(context_pool_settings.cpu_set)
+                     << " (" << magic_enum::enum_name(context_pool_settings.affinity_mode) << ") workers on cpus: "
+                     << concurrency::to_string(settings.workers_cpu_set)
+                     << " (" << magic_enum::enum_name(settings.workers_affinity_mode) << ")";
+        }
 
         // Create the one-and-only Silkrpc daemon
         Daemon rpc_daemon{settings};
@@ -173,15 +186,37 @@ ChannelFactory Daemon::make_channel_factory(const DaemonSettings& settings) {
     };
 }
 
-Daemon::Daemon(DaemonSettings settings, std::shared_ptr<mdbx::env_managed> chaindata_env)
+Daemon::Daemon(DaemonSettings settings,
+               std::shared_ptr<mdbx::env_managed> chaindata_env,
+               snapshot::SnapshotRepository* snapshot_repository,
+               concurrency::TaskScheduler* task_scheduler)
     : settings_(std::move(settings)),
       create_channel_{make_channel_factory(settings_)},
       context_pool_{settings_.context_pool_settings.num_contexts},
-      worker_pool_{settings_.num_workers},
+      worker_pool_{0},
+      scheduler_{task_scheduler},
+      snapshot_repository_{snapshot_repository},
       kv_stub_{::remote::KV::NewStub(create_channel_())},
       rpc_quirk_flag_{settings_.rpc_quirk_flag} {
     // Check pre-conditions
     ensure(!settings_.datadir || !chaindata_env, "Daemon::Daemon datadir and chaindata_env are alternative");
+    ensure(!snapshot_repository || chaindata_env, "Daemon::Daemon snapshot_repository requires chaindata_env");
+
+    // Place the execution contexts on their CPUs (if required), e.g. to keep I/O and EVM apart: the workers are
+    // already placed by the scheduler
+    const auto& context_pool_settings{settings_.context_pool_settings};
+    context_pool_.set_affinity(context_pool_settings.cpu_set, context_pool_settings.affinity_mode);
+
+    // Run the tasks posted to the workers on the work-stealing scheduler, shared with the node (if any)
+    if (!scheduler_) {
+        own_scheduler_ = std::make_unique<concurrency::TaskScheduler>(concurrency::TaskSchedulerSettings{
+            .num_workers = settings_.num_workers,
+            .cpu_set = settings_.workers_cpu_set,
+            .affinity_mode = settings_.workers_affinity_mode,
+            .name = "rpc_worker_"});
+        scheduler_ = own_scheduler_.get();
+    }
+    boost::asio::make_service<TaskSchedulerService>(worker_pool_, scheduler_);
 
     // Load the channel authentication token (if required)
     if (settings_.jwt_secret_file) {
@@ -204,6 +239,16 @@ Daemon::Daemon(DaemonSettings settings, std::shared_ptr<mdbx::env_managed> chain
         chaindata_env_ = std::move(chaindata_env);
     }
 
+    // Back the workers' code analysis cache with the persistent store (if required)
+    if (settings_.datadir) {
+        try {
+            analysis_store_ = std::make_unique<db::PersistentAnalysisStore>(*settings_.datadir / "analysis");
+            boost::asio::make_service<AnalysisCacheService>(worker_pool_, analysis_store_.get());
+        } catch (const std::exception& ex) {
+            SILK_WARN << "Code analysis store not available: " << ex.what();
+        }
+    }
+
     // Create private and shared state in execution contexts
     add_private_services();
     add_shared_services();
@@ -224,7 +269,7 @@ void Daemon::add_private_services() {
 
         std::unique_ptr<ethdb::Database> database;
         if (chaindata_env_) {
-            database = std::make_unique<ethdb::file::LocalDatabase>(chaindata_env_);
+            database = std::make_unique<ethdb::file::LocalDatabase>(chaindata_env_, snapshot_repository_);
         } else {
             database = std::make_unique<ethdb::kv::RemoteDatabase>(grpc_context, grpc_channel);
         }
@@ -246,6 +291,30 @@ void Daemon::add_shared_services() {
     auto state_cache = std::make_shared<ethdb::kv::CoherentStateCache>();
     // Create the unique filter storage to be shared among the execution contexts
     auto filter_storage = std::make_shared<FilterStorage>(context_pool_.num_contexts() * kDefaultFilterStorageSize);
+    // Create the unique block rewards cache to be shared among the execution contexts
+    auto block_rewards_cache = std::make_shared<fee_history::BlockRewardsCache>();
+
+    // Expose the state cache effectiveness, the counters are sampled at scrape time
+    std::weak_ptr<ethdb::kv::CoherentStateCache> weak_state_cache{state_cache};
+    auto sample = [weak_state_cache](uint64_t (ethdb::kv::StateCache::*count)() const) {
+        return [=]() -> double {
+            const auto cache{weak_state_cache.lock()};
+            return cache ? static_cast<double>(((*cache).*count)()) : 0.0;
+        };
+    };
+    auto& registry{metrics::default_registry()};
+    registry.counter_callback("silkworm_rpc_state_cache_state_hits_total", "State cache hits for state entries",
+                              sample(&ethdb::kv::StateCache::state_hit_count));
+    registry.counter_callback("silkworm_rpc_state_cache_state_misses_total", "State cache misses for state entries",
+                              sample(&ethdb::kv::StateCache::state_miss_count));
+    registry.counter_callback("silkworm_rpc_state_cache_code_hits_total", "State cache hits for code entries",
+                              sample(&ethdb::kv::StateCache::code_hit_count));
+    registry.counter_callback("silkworm_rpc_state_cache_code_misses_total", "State cache misses for code entries",
+                              sample(&ethdb::kv::StateCache::code_miss_count));
+    registry.counter_callback("silkworm_signer_cache_hits_total", "Recovered signer cache hits",
+                              []() { return static_cast<double>(signer_cache().stats().hits); });
+    registry.counter_callback("silkworm_signer_cache_misses_total", "Recovered signer cache misses",
+                              []() { return static_cast<double>(signer_cache().stats().misses); });
 
     // Add the shared state to the execution contexts
     for (std::size_t i{0}; i < settings_.context_pool_settings.num_contexts; ++i) {
@@ -254,6 +323,7 @@ void Daemon::add_shared_services() {
         add_shared_service(io_context, block_cache);
         add_shared_service<ethdb::kv::StateCache>(io_context, state_cache);
         add_shared_service(io_context, filter_storage);
+        add_shared_service(io_context, block_rewards_cache);
     }
 }
 
@@ -296,6 +366,22 @@ void Daemon::start() {
         service->start();
     }
 
+    // Serve the metrics to Prometheus scrapes (if required)
+    if (not settings_.metrics_end_point.empty()) {
+        metrics_server_ = std::make_unique<metrics::ExpositionServer>(settings_.metrics_end_point);
+        boost::asio::co_spawn(context_pool_.next_io_context(), metrics_server_->run(), [](std::exception_ptr eptr) {
+            try {
+                if (eptr) std::rethrow_exception(eptr);
+            } catch (const boost::system::system_error& se) {
+                if (se.code() != boost::asio::error::operation_aborted) {
+                    SILK_ERROR << "Metrics server system_error: " << se.what();
+                }
+            } catch (const std::exception& e) {
+                SILK_ERROR << "Metrics server exception: " << e.what();
+            }
+        });
+    }
+
     // Open the KV state-changes stream feeding the state cache
     state_changes_stream_->open();
 
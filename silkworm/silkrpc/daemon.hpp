@@ -23,8 +23,12 @@
 #include <boost/asio/thread_pool.hpp>
 
 #include <silkworm/infra/common/log.hpp>
+#include <silkworm/infra/concurrency/task_scheduler.hpp>
 #include <silkworm/infra/grpc/client/client_context_pool.hpp>
 #include <silkworm/infra/grpc/common/version.hpp>
+#include <silkworm/infra/metrics/exposition_server.hpp>
+#include <silkworm/node/db/analysis_store.hpp>
+#include <silkworm/node/snapshot/repository.hpp>
 #include <silkworm/silkrpc/common/constants.hpp>
 #include <silkworm/silkrpc/ethdb/kv/state_changes_stream.hpp>
 #include <silkworm/silkrpc/http/server.hpp>
@@ -48,7 +52,10 @@ class Daemon {
   public:
     static int run(const DaemonSettings& settings, const DaemonInfo& info = {});
 
-    explicit Daemon(DaemonSettings settings, std::shared_ptr<mdbx::env_managed> chaindata_env = nullptr);
+    explicit Daemon(DaemonSettings settings,
+                    std::shared_ptr<mdbx::env_managed> chaindata_env = nullptr,
+                    snapshot::SnapshotRepository* snapshot_repository = nullptr,
+                    concurrency::TaskScheduler* task_scheduler = nullptr);
 
     Daemon(const Daemon&) = delete;
     Daemon& operator=(const Daemon&) = delete;
@@ -78,15 +85,30 @@ class Daemon {
     //! The execution contexts capturing the asynchronous scheduling model.
     ClientContextPool context_pool_;
 
-    //! The pool of workers for long-running tasks.
+    //! The persistent code analysis store shared by workers or \code nullptr if working remotely
+    std::unique_ptr<db::PersistentAnalysisStore> analysis_store_;
+
+    //! The execution context of the workers' services (e.g. code analysis cache), having no thread by itself.
     boost::asio::thread_pool worker_pool_;
 
+    //! The work-stealing scheduler owned by the daemon when not sharing an external one
+    std::unique_ptr<concurrency::TaskScheduler> own_scheduler_;
+
+    //! The work-stealing scheduler running the long-running tasks posted to the workers.
+    concurrency::TaskScheduler* scheduler_;
+
     //! The chaindata MDBX environment or \code nullptr if working remotely
     std::shared_ptr<mdbx::env_managed> chaindata_env_;
 
+    //! The repository of the blocks frozen out of the chaindata environment or \code nullptr if none
+    snapshot::SnapshotRepository* snapshot_repository_;
+
     //! The JSON RPC API services.
     std::vector<std::unique_ptr<http::Server>> rpc_services_;
 
+    //! The Prometheus metrics endpoint or \code nullptr if not enabled
+    std::unique_ptr<metrics::ExpositionServer> metrics_server_;
+
     //! The gRPC KV interface client stub.
     std::unique_ptr<::remote::KV::StubInterface> kv_stub_;
 
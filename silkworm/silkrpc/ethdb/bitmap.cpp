@@ -40,7 +40,7 @@ static Roaring64Map fast_or(size_t n, const std::vector<std::unique_ptr<Roaring6
     return result;
 }
 
-awaitable<Roaring64Map> get(core::rawdb::DatabaseReader& db_reader, const std::string& table, silkworm::Bytes& key,
+awaitable<Roaring64Map> get(const core::rawdb::DatabaseReader& db_reader, const std::string& table, silkworm::Bytes& key,
                        uint32_t from_block, uint32_t to_block) {
     std::vector<std::unique_ptr<Roaring64Map>> chunks;
 
@@ -65,7 +65,7 @@ awaitable<Roaring64Map> get(core::rawdb::DatabaseReader& db_reader, const std::s
     co_return result;
 }
 
-awaitable<Roaring64Map> from_topics(core::rawdb::DatabaseReader& db_reader, const std::string& table, const FilterTopics& topics,
+awaitable<Roaring64Map> from_topics(const core::rawdb::DatabaseReader& db_reader, const std::string& table, const FilterTopics& topics,
                                uint64_t start, uint64_t end) {
     SILK_DEBUG << "#topics: " << topics.size() << " start: " << start << " end: " << end;
     roaring::Roaring64Map result_bitmap;
@@ -92,7 +92,7 @@ awaitable<Roaring64Map> from_topics(core::rawdb::DatabaseReader& db_reader, cons
     co_return result_bitmap;
 }
 
-awaitable<Roaring64Map> from_addresses(core::rawdb::DatabaseReader& db_reader, const std::string& table, const FilterAddresses& addresses,
+awaitable<Roaring64Map> from_addresses(const core::rawdb::DatabaseReader& db_reader, const std::string& table, const FilterAddresses& addresses,
                                   uint64_t start, uint64_t end) {
     SILK_TRACE << "#addresses: " << addresses.size() << " start: " << start << " end: " << end;
     roaring::Roaring64Map result_bitmap;
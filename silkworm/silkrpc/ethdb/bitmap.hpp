@@ -36,13 +36,13 @@ namespace silkworm::rpc::ethdb::bitmap {
 
 using boost::asio::awaitable;
 
-awaitable<roaring::Roaring64Map> get(core::rawdb::DatabaseReader& db_reader, const std::string& table,
+awaitable<roaring::Roaring64Map> get(const core::rawdb::DatabaseReader& db_reader, const std::string& table,
                                 silkworm::Bytes& key, uint32_t from_block, uint32_t to_block);
 
-awaitable<roaring::Roaring64Map> from_topics(core::rawdb::DatabaseReader& db_reader, const std::string& table,
+awaitable<roaring::Roaring64Map> from_topics(const core::rawdb::DatabaseReader& db_reader, const std::string& table,
                                         const FilterTopics& topics, uint64_t start, uint64_t end);
 
-awaitable<roaring::Roaring64Map> from_addresses(core::rawdb::DatabaseReader& db_reader, const std::string& table,
+awaitable<roaring::Roaring64Map> from_addresses(const core::rawdb::DatabaseReader& db_reader, const std::string& table,
                                            const FilterAddresses& addresses, uint64_t start, uint64_t end);
 
 }  // namespace silkworm::rpc::ethdb::bitmap
@@ -0,0 +1,117 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "bloom_bits.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <vector>
+
+#include <boost/endian/conversion.hpp>
+
+#include <silkworm/infra/common/log.hpp>
+#include <silkworm/node/db/bloom_bits.hpp>
+#include <silkworm/node/db/tables.hpp>
+
+namespace silkworm::rpc::ethdb::bloom_bits {
+
+using silkworm::db::bloom_bits::kSectionSize;
+
+awaitable<MatchResult> match(const core::rawdb::DatabaseReader& db_reader, const FilterAddresses& addresses,
+                             const FilterTopics& topics, uint64_t start, uint64_t end) {
+    MatchResult result;
+    const uint64_t first_section{start / kSectionSize};
+    const uint64_t last_section{end / kSectionSize};
+
+    // Sections completed by the BloomBits stage
+    std::vector<uint64_t> sections;
+    const auto first_section_key{silkworm::db::bloom_bits::section_key(first_section)};
+    core::rawdb::Walker section_walker = [&](const silkworm::Bytes& k, const silkworm::Bytes&) {
+        const auto section{boost::endian::load_big_u64(k.data())};
+        if (section > last_section) return false;
+        sections.push_back(section);
+        return true;
+    };
+    co_await db_reader.walk(silkworm::db::table::kBloomBitsIndexName, first_section_key, 0, section_walker);
+    SILK_DEBUG << "bloom bits #sections: " << sections.size() << " first: " << first_section << " last: " << last_section;
+    if (sections.empty()) {
+        co_return result;
+    }
+
+    for (const auto section : sections) {
+        const uint64_t section_start{std::max(start, section * kSectionSize)};
+        const uint64_t section_end{std::min(end, (section + 1) * kSectionSize - 1)};
+        result.indexed.addRange(section_start, section_end + 1);
+    }
+
+    // Addresses make up the first clause, each topic position one more
+    std::vector<std::vector<silkworm::Bytes>> clauses;
+    auto& address_clause{clauses.emplace_back()};
+    for (const auto& address : addresses) {
+        address_clause.emplace_back(address.bytes, silkworm::kAddressLength);
+    }
+    for (const auto& subtopics : topics) {
+        auto& topic_clause{clauses.emplace_back()};
+        for (const auto& topic : subtopics) {
+            topic_clause.emplace_back(topic.bytes, silkworm::kHashLength);
+        }
+    }
+    const silkworm::db::bloom_bits::Matcher matcher{clauses};
+    if (matcher.bits().empty()) {
+        result.candidates = result.indexed;
+        co_return result;
+    }
+
+    // One walk per bloom bit over the sections of interest: vectors[section index][bit index]
+    const auto bit_count{matcher.bits().size()};
+    std::vector<std::vector<silkworm::db::bloom_bits::BitVector>> vectors(sections.size());
+    for (auto& section_vectors : vectors) {
+        section_vectors.resize(bit_count);
+    }
+    for (size_t bit_index{0}; bit_index < bit_count; ++bit_index) {
+        const auto bit_key{silkworm::db::bloom_bits::key(matcher.bits()[bit_index], sections.front())};
+        core::rawdb::Walker vector_walker = [&](const silkworm::Bytes& k, const silkworm::Bytes& v) {
+            const auto section{boost::endian::load_big_u64(&k[sizeof(uint16_t)])};
+            if (section > sections.back()) return false;
+            const auto it{std::lower_bound(sections.begin(), sections.end(), section)};
+            if (it != sections.end() && *it == section) {
+                const auto section_index{static_cast<size_t>(it - sections.begin())};
+                vectors[section_index][bit_index] = silkworm::db::bloom_bits::decompress(v);
+            }
+            return true;
+        };
+        co_await db_reader.walk(silkworm::db::table::kBloomBitsName, bit_key, static_cast<uint32_t>(sizeof(uint16_t) * CHAR_BIT), vector_walker);
+    }
+
+    for (size_t section_index{0}; section_index < sections.size(); ++section_index) {
+        const auto matches{matcher.match(vectors[section_index])};
+        const uint64_t section_start{sections[section_index] * kSectionSize};
+        for (size_t i{0}; i < silkworm::db::bloom_bits::kBitVectorSize; ++i) {
+            if (matches.bytes[i] == 0) continue;
+            for (size_t j{0}; j < 8; ++j) {
+                const uint64_t block_number{section_start + i * 8 + j};
+                if (matches.test(i * 8 + j) && block_number >= start && block_number <= end) {
+                    result.candidates.add(block_number);
+                }
+            }
+        }
+    }
+    SILK_DEBUG << "bloom bits candidates: " << result.candidates.cardinality() << " indexed: " << result.indexed.cardinality();
+
+    co_return result;
+}
+
+}  // namespace silkworm::rpc::ethdb::bloom_bits
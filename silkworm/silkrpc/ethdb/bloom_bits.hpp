@@ -0,0 +1,48 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <silkworm/infra/concurrency/coroutine.hpp>
+
+#include <boost/asio/awaitable.hpp>
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wold-style-cast"
+#pragma GCC diagnostic ignored "-Wconversion"
+#pragma GCC diagnostic ignored "-Wsign-conversion"
+#include <roaring/roaring64map.hh>
+#pragma GCC diagnostic pop
+
+#include <silkworm/silkrpc/core/rawdb/accessors.hpp>
+#include <silkworm/silkrpc/types/filter.hpp>
+
+namespace silkworm::rpc::ethdb::bloom_bits {
+
+using boost::asio::awaitable;
+
+struct MatchResult {
+    //! Blocks of the indexed sections whose bloom may match the filter
+    roaring::Roaring64Map candidates;
+    //! Blocks within the requested range covered by indexed sections
+    roaring::Roaring64Map indexed;
+};
+
+//! Matches log filter criteria against the bloom bits sections covering [start, end]: blocks not in
+//! MatchResult::indexed must be looked up in some other way
+awaitable<MatchResult> match(const core::rawdb::DatabaseReader& db_reader, const FilterAddresses& addresses,
+                             const FilterTopics& topics, uint64_t start, uint64_t end);
+
+}  // namespace silkworm::rpc::ethdb::bloom_bits
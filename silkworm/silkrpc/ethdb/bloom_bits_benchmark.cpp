@@ -0,0 +1,136 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wold-style-cast"
+#pragma GCC diagnostic ignored "-Wconversion"
+#pragma GCC diagnostic ignored "-Wsign-conversion"
+#include <roaring/roaring64map.hh>
+#pragma GCC diagnostic pop
+
+#include <silkworm/core/common/base.hpp>
+#include <silkworm/core/common/endian.hpp>
+#include <silkworm/node/db/bloom_bits.hpp>
+
+namespace silkworm::rpc::ethdb::bloom_bits {
+
+using namespace silkworm::db::bloom_bits;
+
+static constexpr uint64_t kBenchBlocks{1'000'000};
+static constexpr uint64_t kBenchAddresses{10'000};
+static constexpr uint64_t kBenchTopics{100};
+
+//! Synthetic chain of kBenchBlocks blocks having one log each, indexed both ways: per-key roaring bitmaps
+//! (as LogAddressIndex and LogTopicIndex) and compressed bloom bits sections (as BloomBits)
+struct BenchIndexes {
+    std::vector<Bytes> addresses;
+    std::vector<Bytes> topics;
+    std::vector<roaring::Roaring64Map> address_bitmaps;
+    std::vector<roaring::Roaring64Map> topic_bitmaps;
+    std::vector<std::vector<Bytes>> sections;  // sections[section][bit]
+
+    BenchIndexes() : address_bitmaps(kBenchAddresses), topic_bitmaps(kBenchTopics) {
+        for (uint64_t i{0}; i < kBenchAddresses; ++i) {
+            Bytes address(kAddressLength, '\0');
+            endian::store_big_u64(&address[kAddressLength - sizeof(uint64_t)], i + 1);
+            addresses.push_back(address);
+        }
+        for (uint64_t i{0}; i < kBenchTopics; ++i) {
+            Bytes topic(kHashLength, '\0');
+            endian::store_big_u64(&topic[kHashLength - sizeof(uint64_t)], i + 1);
+            topics.push_back(topic);
+        }
+        std::mt19937_64 rng{42};
+        auto generator{std::make_unique<Generator>()};
+        for (uint64_t block{0}; block < kBenchBlocks; ++block) {
+            const auto address_index{rng() % kBenchAddresses};
+            const auto topic_index{rng() % kBenchTopics};
+            address_bitmaps[address_index].add(block);
+            topic_bitmaps[topic_index].add(block);
+
+            Bloom bloom{};
+            m3_2048(bloom, addresses[address_index]);
+            m3_2048(bloom, topics[topic_index]);
+            generator->add_bloom(block % kSectionSize, bloom);
+
+            if (block % kSectionSize == kSectionSize - 1) {
+                auto& section{sections.emplace_back()};
+                for (uint16_t bit{0}; bit < kBloomBitLength; ++bit) {
+                    section.push_back(compress(generator->vector(bit)));
+                }
+                generator->reset();
+            }
+        }
+        for (auto& bitmap : address_bitmaps) bitmap.runOptimize();
+        for (auto& bitmap : topic_bitmaps) bitmap.runOptimize();
+    }
+};
+
+static const BenchIndexes& bench_indexes() {
+    static const BenchIndexes indexes;
+    return indexes;
+}
+
+//! Current path: union of the address bitmaps intersected with the topic bitmap
+static void benchmark_roaring_match(benchmark::State& state) {
+    const auto& indexes{bench_indexes()};
+    const auto num_addresses{static_cast<size_t>(state.range(0))};
+    for ([[maybe_unused]] auto _ : state) {
+        roaring::Roaring64Map addresses_bitmap;
+        for (size_t i{0}; i < num_addresses; ++i) {
+            addresses_bitmap |= indexes.address_bitmaps[i];
+        }
+        addresses_bitmap &= indexes.topic_bitmaps[0];
+        benchmark::DoNotOptimize(addresses_bitmap.cardinality());
+    }
+}
+
+BENCHMARK(benchmark_roaring_match)->Arg(1)->Arg(100)->Arg(1'000);
+
+//! Bloom bits path: decompression of the needed vectors and section matching
+static void benchmark_bloom_bits_match(benchmark::State& state) {
+    const auto& indexes{bench_indexes()};
+    const auto num_addresses{static_cast<size_t>(state.range(0))};
+    std::vector<std::vector<Bytes>> clauses(2);
+    clauses[0].assign(indexes.addresses.begin(), indexes.addresses.begin() + static_cast<std::ptrdiff_t>(num_addresses));
+    clauses[1].push_back(indexes.topics[0]);
+    const Matcher matcher{clauses};
+
+    std::vector<BitVector> vectors(matcher.bits().size());
+    for ([[maybe_unused]] auto _ : state) {
+        roaring::Roaring64Map candidates;
+        for (size_t section{0}; section < indexes.sections.size(); ++section) {
+            for (size_t i{0}; i < vectors.size(); ++i) {
+                vectors[i] = decompress(indexes.sections[section][matcher.bits()[i]]);
+            }
+            const auto matches{matcher.match(vectors)};
+            for (size_t i{0}; i < kSectionSize; ++i) {
+                if (matches.test(i)) candidates.add(section * kSectionSize + i);
+            }
+        }
+        benchmark::DoNotOptimize(candidates.cardinality());
+    }
+}
+
+BENCHMARK(benchmark_bloom_bits_match)->Arg(1)->Arg(100)->Arg(1'000);
+
+}  // namespace silkworm::rpc::ethdb::bloom_bits
@@ -0,0 +1,103 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "bloom_bits.hpp"
+
+#include <algorithm>
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/thread_pool.hpp>
+#include <boost/asio/use_future.hpp>
+#include <boost/endian/conversion.hpp>
+#include <catch2/catch.hpp>
+#include <gmock/gmock.h>
+
+#include <silkworm/infra/test/log.hpp>
+#include <silkworm/node/db/bloom_bits.hpp>
+#include <silkworm/node/db/tables.hpp>
+#include <silkworm/silkrpc/test/mock_database_reader.hpp>
+
+namespace silkworm::rpc::ethdb::bloom_bits {
+
+using testing::_;
+using testing::Invoke;
+using testing::InvokeWithoutArgs;
+using testing::Unused;
+using evmc::literals::operator""_address;
+
+TEST_CASE("bloom_bits::match", "[silkrpc][ethdb][bloom_bits]") {
+    silkworm::test::SetLogVerbosityGuard log_guard{log::Level::kNone};
+    boost::asio::thread_pool pool{1};
+    test::MockDatabaseReader db_reader;
+
+    const auto address{0x5a0b54d5dc17e0aadc383d2db43b0a0d3e029c4c_address};
+    const FilterAddresses addresses{address};
+    const FilterAddresses no_addresses;
+    const FilterTopics no_topics;
+
+    SECTION("no indexed section") {
+        EXPECT_CALL(db_reader, walk(db::table::kBloomBitsIndexName, _, _, _)).WillOnce(InvokeWithoutArgs([]() -> boost::asio::awaitable<void> { co_return; }));
+        auto result = boost::asio::co_spawn(pool, match(db_reader, addresses, no_topics, 10, 5'000), boost::asio::use_future);
+        const auto match_result{result.get()};
+        CHECK(match_result.candidates.isEmpty());
+        CHECK(match_result.indexed.isEmpty());
+    }
+
+    SECTION("first section indexed") {
+        EXPECT_CALL(db_reader, walk(db::table::kBloomBitsIndexName, _, _, _)).WillOnce(Invoke([](Unused, Unused, Unused, core::rawdb::Walker w) -> boost::asio::awaitable<void> {
+            for (uint64_t section{0}; section < 2; ++section) {
+                silkworm::Bytes key{silkworm::db::bloom_bits::section_key(section)};
+                silkworm::Bytes value(silkworm::kHashLength, '\0');
+                if (!w(key, value)) break;
+            }
+            co_return;
+        }));
+        // Only block 100 of section 0 has the address in its bloom
+        const auto address_bits{silkworm::db::bloom_bits::bloom_bit_indices(address)};
+        EXPECT_CALL(db_reader, walk(db::table::kBloomBitsName, _, 16, _)).WillRepeatedly(Invoke([address_bits](Unused, silkworm::ByteView start_key, Unused, core::rawdb::Walker w) -> boost::asio::awaitable<void> {
+            const auto bit{boost::endian::load_big_u16(start_key.data())};
+            silkworm::db::bloom_bits::BitVector vector;
+            if (std::find(address_bits.begin(), address_bits.end(), bit) != address_bits.end()) {
+                vector.set(100);
+            }
+            silkworm::Bytes key{silkworm::db::bloom_bits::key(bit, 0)};
+            silkworm::Bytes value{silkworm::db::bloom_bits::compress(vector)};
+            w(key, value);
+            co_return;
+        }));
+        auto result = boost::asio::co_spawn(pool, match(db_reader, addresses, no_topics, 10, 5'000), boost::asio::use_future);
+        const auto match_result{result.get()};
+        CHECK(match_result.candidates.toString() == "{100}");
+        CHECK(match_result.indexed.minimum() == 10);
+        CHECK(match_result.indexed.maximum() == silkworm::db::bloom_bits::kSectionSize - 1);
+        CHECK(match_result.indexed.cardinality() == silkworm::db::bloom_bits::kSectionSize - 10);
+    }
+
+    SECTION("no criteria matches all indexed blocks") {
+        EXPECT_CALL(db_reader, walk(db::table::kBloomBitsIndexName, _, _, _)).WillOnce(Invoke([](Unused, Unused, Unused, core::rawdb::Walker w) -> boost::asio::awaitable<void> {
+            silkworm::Bytes key{silkworm::db::bloom_bits::section_key(0)};
+            silkworm::Bytes value(silkworm::kHashLength, '\0');
+            w(key, value);
+            co_return;
+        }));
+        auto result = boost::asio::co_spawn(pool, match(db_reader, no_addresses, no_topics, 10, 5'000), boost::asio::use_future);
+        const auto match_result{result.get()};
+        CHECK(match_result.candidates == match_result.indexed);
+        CHECK(match_result.indexed.cardinality() == silkworm::db::bloom_bits::kSectionSize - 10);
+    }
+}
+
+}  // namespace silkworm::rpc::ethdb::bloom_bits
@@ -23,7 +23,9 @@
 
 namespace silkworm::rpc::ethdb::file {
 
-LocalDatabase::LocalDatabase(std::shared_ptr<mdbx::env_managed> chaindata_env) {
+LocalDatabase::LocalDatabase(std::shared_ptr<mdbx::env_managed> chaindata_env,
+                             snapshot::SnapshotRepository* snapshot_repository)
+    : snapshot_repository_{snapshot_repository} {
     SILK_TRACE << "LocalDatabase::ctor " << this;
     chaindata_env_ = std::move(chaindata_env);
 }
@@ -34,7 +36,7 @@ LocalDatabase::~LocalDatabase() {
 
 boost::asio::awaitable<std::unique_ptr<Transaction>> LocalDatabase::begin() {
     SILK_TRACE << "LocalDatabase::begin " << this << " start";
-    auto txn = std::make_unique<LocalTransaction>(chaindata_env_);
+    auto txn = std::make_unique<LocalTransaction>(chaindata_env_, snapshot_repository_);
     co_await txn->open();
     SILK_TRACE << "LocalDatabase::begin " << this << " txn: " << txn.get() << " end";
     co_return txn;
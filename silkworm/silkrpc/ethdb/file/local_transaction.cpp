@@ -21,6 +21,7 @@
 #include <silkworm/infra/concurrency/coroutine.hpp>
 
 #include <silkworm/silkrpc/core/local_state.hpp>
+#include <silkworm/silkrpc/ethdb/file/snapshot_cursor.hpp>
 
 namespace silkworm::rpc::ethdb::file {
 
@@ -53,8 +54,12 @@ boost::asio::awaitable<std::shared_ptr<CursorDupSort>> LocalTransaction::get_cur
             co_return cursor_it->second;
         }
     }
-    auto cursor = std::make_shared<LocalCursor>(rtxn_, ++last_cursor_id_, table);
+    std::shared_ptr<CursorDupSort> cursor = std::make_shared<LocalCursor>(rtxn_, ++last_cursor_id_, table);
     co_await cursor->open_cursor(table, is_cursor_sorted);
+    // Old blocks may have been moved from some tables into snapshots
+    if (snapshot_repository_ && SnapshotCursor::is_frozen_table(table)) {
+        cursor = std::make_shared<SnapshotCursor>(std::move(cursor), table, *snapshot_repository_);
+    }
     if (is_cursor_sorted) {
         dup_cursors_[table] = cursor;
     } else {
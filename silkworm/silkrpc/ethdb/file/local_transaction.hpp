@@ -27,6 +27,7 @@
 #include <boost/asio/awaitable.hpp>
 
 #include <silkworm/node/db/mdbx.hpp>
+#include <silkworm/node/snapshot/repository.hpp>
 #include <silkworm/silkrpc/ethdb/cursor.hpp>
 #include <silkworm/silkrpc/ethdb/file/local_cursor.hpp>
 #include <silkworm/silkrpc/ethdb/kv/cached_database.hpp>
@@ -36,8 +37,12 @@ namespace silkworm::rpc::ethdb::file {
 
 class LocalTransaction : public Transaction {
   public:
-    explicit LocalTransaction(std::shared_ptr<mdbx::env_managed> chaindata_env)
-        : chaindata_env_{std::move(chaindata_env)}, last_cursor_id_{0}, rtxn_{*chaindata_env_} {}
+    explicit LocalTransaction(std::shared_ptr<mdbx::env_managed> chaindata_env,
+                              snapshot::SnapshotRepository* snapshot_repository = nullptr)
+        : chaindata_env_{std::move(chaindata_env)},
+          snapshot_repository_{snapshot_repository},
+          last_cursor_id_{0},
+          rtxn_{*chaindata_env_} {}
 
     ~LocalTransaction() override = default;
 
@@ -60,6 +65,7 @@ class LocalTransaction : public Transaction {
     std::map<std::string, std::shared_ptr<CursorDupSort>> dup_cursors_;
 
     std::shared_ptr<mdbx::env_managed> chaindata_env_;
+    snapshot::SnapshotRepository* snapshot_repository_;
     uint32_t last_cursor_id_;
     db::ROTxn rtxn_;
 };
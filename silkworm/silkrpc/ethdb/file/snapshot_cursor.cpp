@@ -0,0 +1,222 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "snapshot_cursor.hpp"
+
+#include <utility>
+
+#include <silkworm/core/common/endian.hpp>
+#include <silkworm/core/common/util.hpp>
+#include <silkworm/core/rlp/decode.hpp>
+#include <silkworm/core/types/hash.hpp>
+#include <silkworm/infra/common/log.hpp>
+#include <silkworm/node/db/tables.hpp>
+#include <silkworm/node/db/util.hpp>
+
+namespace silkworm::rpc::ethdb::file {
+
+//! The size of the keys made of block number and block hash
+static constexpr std::size_t kBlockKeySize{sizeof(BlockNum) + kHashLength};
+
+bool SnapshotCursor::is_frozen_table(const std::string& table_name) {
+    return table_name == db::table::kHeadersName || table_name == db::table::kBlockBodiesName ||
+           table_name == db::table::kBlockTransactionsName || table_name == db::table::kTxLookupName;
+}
+
+SnapshotCursor::SnapshotCursor(std::shared_ptr<CursorDupSort> db_cursor, std::string table_name,
+                               snapshot::SnapshotRepository& repository)
+    : db_cursor_{std::move(db_cursor)}, table_name_{std::move(table_name)}, repository_{repository} {}
+
+boost::asio::awaitable<void> SnapshotCursor::open_cursor(const std::string& table_name, bool is_dup_sorted) {
+    txn_snapshot_ = nullptr;
+    co_await db_cursor_->open_cursor(table_name, is_dup_sorted);
+}
+
+boost::asio::awaitable<KeyValue> SnapshotCursor::seek(ByteView key) {
+    if (table_name_ == db::table::kBlockTransactionsName && key.size() == sizeof(uint64_t)) {
+        const auto txn_id{endian::load_big_u64(key.data())};
+        if (txn_id & kSnapshotTxnIdFlag) {
+            co_return seek_snapshot_txn(txn_id & ~kSnapshotTxnIdFlag);
+        }
+    }
+    txn_snapshot_ = nullptr;
+    co_return co_await db_cursor_->seek(key);
+}
+
+boost::asio::awaitable<KeyValue> SnapshotCursor::seek_exact(ByteView key) {
+    txn_snapshot_ = nullptr;
+    auto kv_pair{co_await db_cursor_->seek_exact(key)};
+    if (!kv_pair.key.empty()) {
+        co_return kv_pair;
+    }
+
+    std::optional<Bytes> value;
+    if (table_name_ == db::table::kHeadersName && key.size() == kBlockKeySize) {
+        value = read_header_rlp(endian::load_big_u64(key.data()), key.substr(sizeof(BlockNum)));
+    } else if (table_name_ == db::table::kBlockBodiesName && key.size() == kBlockKeySize) {
+        value = read_stored_body(endian::load_big_u64(key.data()), key.substr(sizeof(BlockNum)));
+    } else if (table_name_ == db::table::kTxLookupName && key.size() == kHashLength) {
+        value = read_block_number(key);
+    }
+    if (!value) {
+        co_return KeyValue{};
+    }
+    SILK_TRACE << "SnapshotCursor::seek_exact found in snapshots: " << table_name_ << " key: " << key;
+    co_return KeyValue{Bytes{key}, std::move(*value)};
+}
+
+boost::asio::awaitable<KeyValue> SnapshotCursor::prev() {
+    txn_snapshot_ = nullptr;
+    co_return co_await db_cursor_->prev();
+}
+
+boost::asio::awaitable<KeyValue> SnapshotCursor::last() {
+    txn_snapshot_ = nullptr;
+    co_return co_await db_cursor_->last();
+}
+
+boost::asio::awaitable<KeyValue> SnapshotCursor::next() {
+    if (txn_snapshot_) {
+        const auto* index{txn_snapshot_->idx_txn_hash()};
+        ++txn_id_;
+        if (txn_id_ >= index->base_data_id() + txn_snapshot_->item_count()) {
+            co_return seek_snapshot_txn(txn_id_);
+        }
+        co_return read_snapshot_txn();
+    }
+    co_return co_await db_cursor_->next();
+}
+
+boost::asio::awaitable<KeyValue> SnapshotCursor::next_dup() {
+    txn_snapshot_ = nullptr;
+    co_return co_await db_cursor_->next_dup();
+}
+
+boost::asio::awaitable<void> SnapshotCursor::close_cursor() {
+    txn_snapshot_ = nullptr;
+    co_await db_cursor_->close_cursor();
+}
+
+boost::asio::awaitable<silkworm::Bytes> SnapshotCursor::seek_both(ByteView key, ByteView value) {
+    txn_snapshot_ = nullptr;
+    co_return co_await db_cursor_->seek_both(key, value);
+}
+
+boost::asio::awaitable<KeyValue> SnapshotCursor::seek_both_exact(ByteView key, ByteView value) {
+    txn_snapshot_ = nullptr;
+    co_return co_await db_cursor_->seek_both_exact(key, value);
+}
+
+std::optional<Bytes> SnapshotCursor::read_header_rlp(BlockNum block_number, ByteView block_hash) const {
+    const auto* header_snapshot{repository_.find_header_segment(block_number)};
+    if (!header_snapshot || !header_snapshot->idx_header_hash()) {
+        return std::nullopt;
+    }
+    const auto* index{header_snapshot->idx_header_hash()};
+    const auto item{header_snapshot->next_item(index->ordinal_lookup(block_number - index->base_data_id()))};
+    if (!item || item->value.empty()) {
+        return std::nullopt;
+    }
+
+    // Header word is the first byte of block hash followed by header RLP: only canonical headers are in snapshots
+    const ByteView header_rlp{ByteView{item->value}.substr(1)};
+    const auto hash{keccak256(header_rlp)};
+    if (ByteView{hash.bytes, kHashLength} != block_hash) {
+        return std::nullopt;
+    }
+    return Bytes{header_rlp};
+}
+
+std::optional<Bytes> SnapshotCursor::read_stored_body(BlockNum block_number, ByteView block_hash) const {
+    // Only canonical bodies are in snapshots: check the block hash against the canonical header
+    if (!read_header_rlp(block_number, block_hash)) {
+        return std::nullopt;
+    }
+    const auto* body_snapshot{repository_.find_body_segment(block_number)};
+    if (!body_snapshot) {
+        return std::nullopt;
+    }
+    auto stored_body{body_snapshot->body_by_number(block_number)};
+    if (!stored_body) {
+        return std::nullopt;
+    }
+
+    // Snapshot bodies count one system transaction at the beginning and one at the end, database bodies do not
+    stored_body->base_txn_id = (stored_body->base_txn_id + 1) | kSnapshotTxnIdFlag;
+    stored_body->txn_count = stored_body->txn_count >= 2 ? stored_body->txn_count - 2 : 0;
+    return stored_body->encode();
+}
+
+std::optional<Bytes> SnapshotCursor::read_block_number(ByteView txn_hash) const {
+    const Hash hash{txn_hash};
+    std::optional<Bytes> value;
+    repository_.view_tx_segments([&](const snapshot::TransactionSnapshot* txn_snapshot) -> bool {
+        const auto* index{txn_snapshot->idx_txn_hash_2_block()};
+        // The transaction must be checked because there is no way to know if key exists in MPHF
+        if (!index || !txn_snapshot->txn_by_hash(hash)) {
+            return false;
+        }
+        // Lookup values are stored as block numbers without leading zeros
+        value = Bytes{zeroless_view(db::block_key(index->lookup(txn_hash)))};
+        return true;
+    });
+    return value;
+}
+
+KeyValue SnapshotCursor::seek_snapshot_txn(uint64_t txn_id) {
+    txn_snapshot_ = nullptr;
+    repository_.view_tx_segments([&](const snapshot::TransactionSnapshot* txn_snapshot) -> bool {
+        const auto* index{txn_snapshot->idx_txn_hash()};
+        if (index && index->base_data_id() <= txn_id && txn_id < index->base_data_id() + txn_snapshot->item_count()) {
+            txn_snapshot_ = txn_snapshot;
+        }
+        return txn_snapshot_ != nullptr;
+    });
+    if (!txn_snapshot_) {
+        return KeyValue{};
+    }
+
+    const auto* index{txn_snapshot_->idx_txn_hash()};
+    txn_id_ = txn_id;
+    txn_offset_ = index->ordinal_lookup(txn_id - index->base_data_id());
+    return read_snapshot_txn();
+}
+
+KeyValue SnapshotCursor::read_snapshot_txn() {
+    // Transaction word is the first byte of tx hash followed by sender address and tx RLP, system ones are empty
+    constexpr std::size_t kTxnRlpOffset{1 + kAddressLength};
+
+    const auto item{txn_snapshot_->next_item(txn_offset_)};
+    if (!item || item->value.size() <= kTxnRlpOffset) {
+        txn_snapshot_ = nullptr;
+        return KeyValue{};
+    }
+    txn_offset_ = item->offset;
+
+    // Typed transactions are wrapped into an RLP string in snapshots, whereas they are stored unwrapped in database
+    ByteView txn_rlp{ByteView{item->value}.substr(kTxnRlpOffset)};
+    if (txn_rlp[0] < 0xc0) {
+        const auto header{rlp::decode_header(txn_rlp)};
+        if (!header || header->list) {
+            SILK_ERROR << "SnapshotCursor: invalid transaction envelope for txn ID: " << txn_id_;
+            txn_snapshot_ = nullptr;
+            return KeyValue{};
+        }
+    }
+    return KeyValue{db::block_key(txn_id_ | kSnapshotTxnIdFlag), Bytes{txn_rlp}};
+}
+
+}  // namespace silkworm::rpc::ethdb::file
@@ -0,0 +1,99 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+
+#include <silkworm/infra/concurrency/coroutine.hpp>
+
+#include <boost/asio/awaitable.hpp>
+
+#include <silkworm/core/common/base.hpp>
+#include <silkworm/node/snapshot/repository.hpp>
+#include <silkworm/silkrpc/common/util.hpp>
+#include <silkworm/silkrpc/core/rawdb/chain.hpp>
+#include <silkworm/silkrpc/ethdb/cursor.hpp>
+
+namespace silkworm::rpc::ethdb::file {
+
+//! Cursor serving the blocks frozen into snapshots for the tables whose records are moved out of the database.
+//! @details Lookups are done in the database first, so the hot tip is served as before. On a miss, they fall back to
+//! the snapshot segments located through their RecSplit indexes: header records are the segment words as they are,
+//! transaction records are the segment words just unwrapped and body records are renumbered. The transaction IDs in
+//! the renumbered bodies carry kSnapshotTxnIdFlag, so that walking BlockTransactions from them iterates the words of
+//! the transaction segments instead of the database records.
+class SnapshotCursor : public CursorDupSort {
+  public:
+    //! The flag marking the transaction IDs referring to snapshots, the database sequence never gets there
+    static constexpr uint64_t kSnapshotTxnIdFlag{core::rawdb::kSnapshotTxnIdFlag};
+
+    //! Whether the given table has its records (partially) moved into snapshots
+    static bool is_frozen_table(const std::string& table_name);
+
+    explicit SnapshotCursor(std::shared_ptr<CursorDupSort> db_cursor, std::string table_name,
+                            snapshot::SnapshotRepository& repository);
+
+    [[nodiscard]] uint32_t cursor_id() const override { return db_cursor_->cursor_id(); };
+
+    boost::asio::awaitable<void> open_cursor(const std::string& table_name, bool is_dup_sorted) override;
+
+    boost::asio::awaitable<KeyValue> seek(silkworm::ByteView key) override;
+
+    boost::asio::awaitable<KeyValue> seek_exact(silkworm::ByteView key) override;
+
+    boost::asio::awaitable<KeyValue> prev() override;
+
+    boost::asio::awaitable<KeyValue> last() override;
+
+    boost::asio::awaitable<KeyValue> next() override;
+
+    boost::asio::awaitable<KeyValue> next_dup() override;
+
+    boost::asio::awaitable<void> close_cursor() override;
+
+    boost::asio::awaitable<silkworm::Bytes> seek_both(silkworm::ByteView key, silkworm::ByteView value) override;
+
+    boost::asio::awaitable<KeyValue> seek_both_exact(silkworm::ByteView key, silkworm::ByteView value) override;
+
+  private:
+    [[nodiscard]] std::optional<Bytes> read_header_rlp(BlockNum block_number, ByteView block_hash) const;
+    [[nodiscard]] std::optional<Bytes> read_stored_body(BlockNum block_number, ByteView block_hash) const;
+    [[nodiscard]] std::optional<Bytes> read_block_number(ByteView txn_hash) const;
+
+    //! Position the cursor on the transaction having the given ID (without flag) in snapshots
+    KeyValue seek_snapshot_txn(uint64_t txn_id);
+
+    //! Read the transaction the cursor is positioned on in snapshots
+    KeyValue read_snapshot_txn();
+
+    std::shared_ptr<CursorDupSort> db_cursor_;
+    std::string table_name_;
+    snapshot::SnapshotRepository& repository_;
+
+    //! The transaction segment the cursor is positioned on, if any
+    const snapshot::TransactionSnapshot* txn_snapshot_{nullptr};
+
+    //! The ID of the transaction the cursor is positioned on in the transaction segment
+    uint64_t txn_id_{0};
+
+    //! The offset of the transaction the cursor is positioned on in the transaction segment
+    uint64_t txn_offset_{0};
+};
+
+}  // namespace silkworm::rpc::ethdb::file
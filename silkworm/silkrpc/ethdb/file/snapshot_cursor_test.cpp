@@ -0,0 +1,197 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "snapshot_cursor.hpp"
+
+#include <memory>
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/thread_pool.hpp>
+#include <boost/asio/use_future.hpp>
+#include <catch2/catch.hpp>
+#include <gmock/gmock.h>
+#include <gsl/util>
+
+#include <silkworm/core/common/endian.hpp>
+#include <silkworm/core/common/test_util.hpp>
+#include <silkworm/core/rlp/decode.hpp>
+#include <silkworm/infra/common/directories.hpp>
+#include <silkworm/infra/test/log.hpp>
+#include <silkworm/node/db/access_layer.hpp>
+#include <silkworm/node/db/stages.hpp>
+#include <silkworm/node/stagedsync/stages/stage_freeze.hpp>
+#include <silkworm/node/test/context.hpp>
+#include <silkworm/silkrpc/test/mock_cursor.hpp>
+
+namespace silkworm::rpc::ethdb::file {
+
+using testing::_;
+using testing::InvokeWithoutArgs;
+
+static void write_blocks(db::RWTxn& txn, BlockNum count, std::vector<Block>& blocks) {
+    const auto sample_transactions{silkworm::test::sample_transactions()};
+    auto senders_table = txn.rw_cursor(db::table::kSenders);
+    evmc::bytes32 parent_hash{};
+    for (BlockNum number{0}; number < count; ++number) {
+        Block block;
+        block.header.number = number;
+        block.header.parent_hash = parent_hash;
+        block.header.gas_limit = 30'000'000;
+        // Each transaction must be unique to build the snapshot indexes
+        for (std::size_t i{0}; i < number % 3; ++i) {
+            Transaction transaction{sample_transactions[i % sample_transactions.size()]};
+            transaction.nonce = number * 3 + i;
+            transaction.from = evmc::address{};
+            transaction.from->bytes[0] = static_cast<uint8_t>(i + 1);
+            block.transactions.push_back(std::move(transaction));
+        }
+        const auto hash{block.header.hash()};
+        db::write_header(txn, block.header, /*with_header_numbers=*/true);
+        db::write_canonical_hash(txn, number, hash);
+        db::write_body(txn, block, hash, number);
+        Bytes senders;
+        for (const auto& transaction : block.transactions) {
+            senders.append(transaction.from->bytes, kAddressLength);
+        }
+        senders_table->upsert(db::to_slice(db::block_key(number, hash.bytes)), db::to_slice(senders));
+        parent_hash = hash;
+        blocks.push_back(std::move(block));
+    }
+}
+
+static evmc::bytes32 transaction_hash(const KeyValue& kv) {
+    ByteView value{kv.value};
+    Transaction transaction;
+    REQUIRE(rlp::decode_transaction(value, transaction, rlp::Eip2718Wrapping::kNone));
+    return transaction.hash();
+}
+
+TEST_CASE("SnapshotCursor", "[silkrpc][ethdb][file]") {
+    silkworm::test::SetLogVerbosityGuard log_guard{log::Level::kNone};
+    silkworm::test::Context context;
+    db::RWTxn& txn{context.rw_txn()};
+    txn.disable_commit();
+
+    // Freeze the first segment, blocks above it stay in the database
+    constexpr BlockNum kSegmentSize{snapshot::kMinimumSegmentSize};
+    constexpr BlockNum kThreshold{100};
+    std::vector<Block> blocks;
+    write_blocks(txn, kSegmentSize + kThreshold + 10, blocks);
+
+    TemporaryDirectory snapshots_dir;
+    snapshot::SnapshotRepository repository{snapshot::SnapshotSettings{
+        .repository_dir = snapshots_dir.path(),
+        .segment_size = kSegmentSize,
+        .freeze = true,
+        .freeze_threshold = kThreshold,
+    }};
+    repository.reopen_folder();
+    context.node_settings().snapshot_repository = &repository;
+    db::DataModel::set_snapshot_repository(&repository);
+    [[maybe_unused]] auto _ = gsl::finally([] { db::DataModel::set_snapshot_repository(nullptr); });
+
+    stagedsync::SyncContext sync_context{};
+    stagedsync::Freeze stage_freeze(&context.node_settings(), &sync_context);
+    db::stages::write_stage_progress(txn, db::stages::kTxLookupKey, blocks.size() - 1);
+    REQUIRE(stage_freeze.forward(txn) == stagedsync::Stage::Result::kSuccess);
+    REQUIRE(repository.max_block_available() == kSegmentSize - 1);
+
+    // The database cursor misses everything, so that lookups fall back to snapshots
+    boost::asio::thread_pool pool{1};
+    auto db_cursor{std::make_shared<silkworm::rpc::test::MockCursorDupSort>()};
+    EXPECT_CALL(*db_cursor, seek_exact(_)).WillRepeatedly(InvokeWithoutArgs([]() -> boost::asio::awaitable<KeyValue> {
+        co_return KeyValue{};
+    }));
+    const auto make_cursor = [&](const std::string& table_name) {
+        return SnapshotCursor{db_cursor, table_name, repository};
+    };
+
+    const Block& block{blocks[500]};
+    REQUIRE(block.transactions.size() == 2);
+    const auto block_hash{block.header.hash()};
+    const Bytes block_key{db::block_key(block.header.number, block_hash.bytes)};
+
+    SECTION("header") {
+        auto cursor{make_cursor(db::table::kHeadersName)};
+        auto result = boost::asio::co_spawn(pool, cursor.seek_exact(block_key), boost::asio::use_future);
+        const auto kv{result.get()};
+        CHECK(kv.key == block_key);
+        const auto header_hash{keccak256(kv.value)};
+        CHECK(to_bytes32({header_hash.bytes, kHashLength}) == block_hash);
+
+        // Only the canonical header is served
+        const Bytes wrong_key{db::block_key(block.header.number, blocks[501].header.hash().bytes)};
+        auto wrong_result = boost::asio::co_spawn(pool, cursor.seek_exact(wrong_key), boost::asio::use_future);
+        CHECK(wrong_result.get().key.empty());
+    }
+
+    SECTION("body and flagged transaction walk") {
+        auto body_cursor{make_cursor(db::table::kBlockBodiesName)};
+        auto body_result = boost::asio::co_spawn(pool, body_cursor.seek_exact(block_key), boost::asio::use_future);
+        const auto body_kv{body_result.get()};
+        REQUIRE(body_kv.key == block_key);
+        ByteView body_view{body_kv.value};
+        const auto stored_body{db::detail::decode_stored_block_body(body_view)};
+        CHECK(stored_body.txn_count == block.transactions.size());
+        REQUIRE((stored_body.base_txn_id & SnapshotCursor::kSnapshotTxnIdFlag) != 0);
+
+        // Walking from the flagged ID iterates the transaction segment, the database is never looked up
+        EXPECT_CALL(*db_cursor, seek(_)).Times(0);
+        EXPECT_CALL(*db_cursor, next()).Times(0);
+        auto txn_cursor{make_cursor(db::table::kBlockTransactionsName)};
+        const Bytes txn_key{db::block_key(stored_body.base_txn_id)};
+        auto first_result = boost::asio::co_spawn(pool, txn_cursor.seek(txn_key), boost::asio::use_future);
+        const auto first_kv{first_result.get()};
+        CHECK(first_kv.key == txn_key);
+        CHECK(transaction_hash(first_kv) == block.transactions[0].hash());
+        auto second_result = boost::asio::co_spawn(pool, txn_cursor.next(), boost::asio::use_future);
+        const auto second_kv{second_result.get()};
+        CHECK(endian::load_big_u64(second_kv.key.data()) == stored_body.base_txn_id + 1);
+        CHECK(transaction_hash(second_kv) == block.transactions[1].hash());
+    }
+
+    SECTION("unflagged transaction IDs go to the database") {
+        EXPECT_CALL(*db_cursor, seek(_)).WillOnce(InvokeWithoutArgs([]() -> boost::asio::awaitable<KeyValue> {
+            co_return KeyValue{*from_hex("0000000000000010"), *from_hex("c0")};
+        }));
+        auto txn_cursor{make_cursor(db::table::kBlockTransactionsName)};
+        const Bytes txn_key{db::block_key(0x10)};
+        auto result = boost::asio::co_spawn(pool, txn_cursor.seek(txn_key), boost::asio::use_future);
+        CHECK(result.get().key == txn_key);
+    }
+
+    SECTION("transaction lookup") {
+        auto cursor{make_cursor(db::table::kTxLookupName)};
+        const auto txn_hash{block.transactions[1].hash()};
+        const Bytes txn_key{txn_hash.bytes, kHashLength};
+        auto result = boost::asio::co_spawn(pool, cursor.seek_exact(txn_key), boost::asio::use_future);
+        const auto kv{result.get()};
+        CHECK(kv.key == txn_key);
+        CHECK(kv.value == Bytes{zeroless_view(db::block_key(block.header.number))});
+    }
+
+    SECTION("database records come first") {
+        const KeyValue db_kv{block_key, *from_hex("c0")};
+        EXPECT_CALL(*db_cursor, seek_exact(_)).WillOnce(InvokeWithoutArgs([&]() -> boost::asio::awaitable<KeyValue> {
+            co_return db_kv;
+        }));
+        auto cursor{make_cursor(db::table::kHeadersName)};
+        auto result = boost::asio::co_spawn(pool, cursor.seek_exact(block_key), boost::asio::use_future);
+        CHECK(result.get().value == db_kv.value);
+    }
+}
+
+}  // namespace silkworm::rpc::ethdb::file
@@ -16,7 +16,10 @@
 
 #include "state_cache.hpp"
 
+#include <algorithm>
 #include <optional>
+#include <utility>
+#include <vector>
 
 #include <magic_enum.hpp>
 
@@ -41,33 +44,60 @@ boost::asio::awaitable<std::optional<silkworm::Bytes>> CoherentStateView::get_co
     co_return co_await cache_->get_code(key, txn_);
 }
 
-CoherentStateCache::CoherentStateCache(CoherentCacheConfig config) : config_(config) {
+CoherentStatePartitions::CoherentStatePartitions(std::size_t num_shards) {
+    shards.reserve(num_shards);
+    fills.reserve(num_shards);
+    for (std::size_t i{0}; i < num_shards; ++i) {
+        shards.push_back(std::make_shared<CoherentStateShard>());
+        fills.push_back(std::make_unique<CoherentStateFill>());
+    }
+}
+
+std::size_t CoherentStatePartitions::size() const {
+    std::size_t total_size{0};
+    for (const auto& shard : shards) {
+        total_size += shard->size;
+    }
+    for (const auto& fill : fills) {
+        std::scoped_lock fill_lock{fill->mutex};
+        total_size += fill->entries.size();
+    }
+    return total_size;
+}
+
+std::size_t CoherentStatePartitions::size_bytes() const {
+    std::size_t total_bytes{0};
+    for (const auto& shard : shards) {
+        total_bytes += shard->size_bytes;
+    }
+    return total_bytes;
+}
+
+CoherentStateCache::CoherentStateCache(CoherentCacheConfig config)
+    : config_(config), state_view_roots_{std::make_shared<CoherentStateRoots>()} {
     if (config.max_views == 0) {
         throw std::invalid_argument{"unexpected zero max_views"};
     }
+    if (config.num_shards == 0) {
+        throw std::invalid_argument{"unexpected zero num_shards"};
+    }
+    state_eviction_queues_.resize(config.num_shards);
+    code_eviction_queues_.resize(config.num_shards);
 }
 
 std::unique_ptr<StateView> CoherentStateCache::get_view(Transaction& txn) {
     const auto view_id = txn.view_id();
-    std::unique_lock write_lock{rw_mutex_};
-    CoherentStateRoot* root = get_root(view_id);
-    return root->ready ? std::make_unique<CoherentStateView>(txn, this) : nullptr;
+    return get_root(view_id) ? std::make_unique<CoherentStateView>(txn, this) : nullptr;
 }
 
 std::size_t CoherentStateCache::latest_data_size() {
-    std::shared_lock read_lock{rw_mutex_};
-    if (latest_state_view_ == nullptr) {
-        return 0;
-    }
-    return static_cast<std::size_t>(latest_state_view_->cache.size());
+    const auto root = get_root(latest_state_view_id_);
+    return root ? root->cache.size() : 0;
 }
 
 std::size_t CoherentStateCache::latest_code_size() {
-    std::shared_lock read_lock{rw_mutex_};
-    if (latest_state_view_ == nullptr) {
-        return 0;
-    }
-    return static_cast<std::size_t>(latest_state_view_->code_cache.size());
+    const auto root = get_root(latest_state_view_id_);
+    return root ? root->code_cache.size() : 0;
 }
 
 void CoherentStateCache::on_new_block(const remote::StateChangeBatch& state_changes) {
@@ -76,34 +106,52 @@ void CoherentStateCache::on_new_block(const remote::StateChangeBatch& state_chan
         return;
     }
 
-    std::unique_lock write_lock{rw_mutex_};
+    std::scoped_lock update_lock{update_mutex_};
 
     const auto view_id = state_changes.state_version_id();
-    CoherentStateRoot* root = advance_root(view_id);
+    const auto roots = load_roots();
+
+    // Next root starts by sharing all the shards of the canonical previous one (if any)
+    auto root = std::make_shared<CoherentStateRoot>(config_.num_shards);
+    ShardChanges changes(config_.num_shards);
+    ShardChanges code_changes(config_.num_shards);
+    const auto previous_root_it = roots->find(view_id - 1);
+    if (previous_root_it != roots->end()) {
+        SILK_DEBUG << "CoherentStateCache::on_new_block canonical view_id-1=" << (view_id - 1) << " found";
+        const auto& previous_root = *previous_root_it->second;
+        root->cache.shards = previous_root.cache.shards;
+        root->code_cache.shards = previous_root.code_cache.shards;
+        fold_fills(previous_root.cache, changes);
+        fold_fills(previous_root.code_cache, code_changes);
+    } else {
+        SILK_DEBUG << "CoherentStateCache::on_new_block canonical view_id-1=" << (view_id - 1) << " not found";
+    }
+
+    ++generation_;
     for (const auto& state_change : state_changes.change_batch()) {
         for (const auto& account_change : state_change.changes()) {
             switch (account_change.action()) {
                 case remote::Action::UPSERT: {
-                    process_upsert_change(root, view_id, account_change);
+                    process_upsert_change(changes, account_change);
                     break;
                 }
                 case remote::Action::UPSERT_CODE: {
-                    process_upsert_change(root, view_id, account_change);
-                    process_code_change(root, view_id, account_change);
+                    process_upsert_change(changes, account_change);
+                    process_code_change(code_changes, account_change);
                     break;
                 }
                 case remote::Action::REMOVE: {
-                    process_delete_change(root, view_id, account_change);
+                    process_delete_change(changes, account_change);
                     break;
                 }
                 case remote::Action::STORAGE: {
                     if (config_.with_storage && account_change.storage_changes_size() > 0) {
-                        process_storage_change(root, view_id, account_change);
+                        process_storage_change(changes, account_change);
                     }
                     break;
                 }
                 case remote::Action::CODE: {
-                    process_code_change(root, view_id, account_change);
+                    process_code_change(code_changes, account_change);
                     break;
                 }
                 default: {
@@ -113,39 +161,46 @@ void CoherentStateCache::on_new_block(const remote::StateChangeBatch& state_chan
         }
     }
 
-    state_key_count_ = static_cast<std::size_t>(latest_state_view_->cache.size());
-    code_key_count_ = static_cast<std::size_t>(latest_state_view_->code_cache.size());
+    // Copy-on-write just the touched shards, evicting the least recently used entries beyond the limits
+    state_eviction_count_ += apply_changes(root->cache, changes, state_eviction_queues_, config_.max_state_bytes);
+    code_eviction_count_ += apply_changes(root->code_cache, code_changes, code_eviction_queues_, config_.max_code_bytes);
 
-    root->ready = true;
+    state_key_count_ = root->cache.size();
+    code_key_count_ = root->code_cache.size();
+
+    // Publish the new root by swapping the whole set of roots: readers already in flight keep their snapshot
+    auto next_roots = std::make_shared<CoherentStateRoots>(*roots);
+    evict_roots(*next_roots, view_id);
+    next_roots->insert_or_assign(view_id, std::move(root));
+    std::atomic_store_explicit(&state_view_roots_, std::shared_ptr<const CoherentStateRoots>{std::move(next_roots)},
+                               std::memory_order_release);
+    latest_state_view_id_ = view_id;
 }
 
-void CoherentStateCache::process_upsert_change(CoherentStateRoot* root, StateViewId view_id,
-                                               const remote::AccountChange& change) {
+void CoherentStateCache::process_upsert_change(ShardChanges& changes, const remote::AccountChange& change) {
     const auto address = silkworm::rpc::address_from_H160(change.address());
     const auto data_bytes = silkworm::bytes_of_string(change.data());
     SILK_DEBUG << "CoherentStateCache::process_upsert_change address: " << address << " data: " << data_bytes;
     const silkworm::Bytes address_key{address.bytes, silkworm::kAddressLength};
-    add({address_key, data_bytes}, root, view_id);
+    add(changes, address_key, data_bytes);
 }
 
-void CoherentStateCache::process_code_change(CoherentStateRoot* root, StateViewId view_id, const remote::AccountChange& change) {
+void CoherentStateCache::process_code_change(ShardChanges& changes, const remote::AccountChange& change) {
     const auto code_bytes = silkworm::bytes_of_string(change.code());
     const ethash::hash256 code_hash{silkworm::keccak256(code_bytes)};
     const silkworm::Bytes code_hash_key{code_hash.bytes, silkworm::kHashLength};
     SILK_DEBUG << "CoherentStateCache::process_code_change code_hash_key: " << code_hash_key;
-    add_code({code_hash_key, code_bytes}, root, view_id);
+    add(changes, code_hash_key, code_bytes);
 }
 
-void CoherentStateCache::process_delete_change(CoherentStateRoot* root, StateViewId view_id,
-                                               const remote::AccountChange& change) {
+void CoherentStateCache::process_delete_change(ShardChanges& changes, const remote::AccountChange& change) {
     const auto address = silkworm::rpc::address_from_H160(change.address());
     SILK_DEBUG << "CoherentStateCache::process_delete_change address: " << address;
     const silkworm::Bytes address_key{address.bytes, silkworm::kAddressLength};
-    add({address_key, {}}, root, view_id);
+    add(changes, address_key, {});
 }
 
-void CoherentStateCache::process_storage_change(CoherentStateRoot* root, StateViewId view_id,
-                                                const remote::AccountChange& change) {
+void CoherentStateCache::process_storage_change(ShardChanges& changes, const remote::AccountChange& change) {
     const auto address = silkworm::rpc::address_from_H160(change.address());
     SILK_DEBUG << "CoherentStateCache::process_storage_change address=" << address;
     for (const auto& storage_change : change.storage_changes()) {
@@ -153,93 +208,168 @@ void CoherentStateCache::process_storage_change(CoherentStateRoot* root, StateVi
         const auto storage_key = composite_storage_key(address, change.incarnation(), location_hash.bytes);
         const auto value = silkworm::bytes_of_string(storage_change.data());
         SILK_DEBUG << "CoherentStateCache::process_storage_change key=" << storage_key << " value=" << value;
-        add({storage_key, value}, root, view_id);
+        add(changes, storage_key, value);
     }
 }
 
-bool CoherentStateCache::add(KeyValue kv, CoherentStateRoot* root, StateViewId view_id) {
-    auto [it, inserted] = root->cache.insert(kv);
-    SILK_DEBUG << "Data cache kv.key=" << silkworm::to_hex(kv.key) << " inserted=" << inserted << " view=" << view_id;
-    std::optional<KeyValue> replaced;
-    if (!inserted) {
-        replaced = *it;
-        root->cache.erase(it);
-        std::tie(it, inserted) = root->cache.insert(kv);
-        SILKWORM_ASSERT(inserted);
-    }
-    if (latest_state_view_id_ != view_id) {
-        return inserted;
-    }
-    if (replaced) {
-        state_evictions_.remove(*replaced);
-        SILK_DEBUG << "Data evictions removed replaced.key=" << silkworm::to_hex(replaced->key);
+void CoherentStateCache::add(ShardChanges& changes, silkworm::Bytes key, silkworm::Bytes value) {
+    const auto index = shard_index(key);
+    changes[index].push_back(make_state_entry(std::move(key), std::move(value), generation_.load()));
+}
+
+void CoherentStateCache::fold_fills(const CoherentStatePartitions& previous, ShardChanges& changes) const {
+    // Entries loaded on miss in the previous view are still valid unless overwritten by the incoming block
+    for (std::size_t i{0}; i < previous.fills.size() && i < changes.size(); ++i) {
+        std::scoped_lock fill_lock{previous.fills[i]->mutex};
+        for (const auto& [_, entry] : previous.fills[i]->entries) {
+            changes[i].push_back(entry);
+        }
     }
-    state_evictions_.push_front(kv);
-
-    // Remove the longest unused key-value pair when size exceeded
-    if (state_evictions_.size() > config_.max_state_keys) {
-        const auto oldest = state_evictions_.back();
-        SILK_DEBUG << "Data cache resize oldest.key=" << silkworm::to_hex(oldest.key);
-        state_evictions_.pop_back();
-        const auto num_erased = root->cache.erase(oldest);
-        SILKWORM_ASSERT(num_erased == 1);
+}
+
+uint64_t CoherentStateCache::apply_changes(CoherentStatePartitions& partitions, ShardChanges& changes,
+                                           std::vector<EvictionQueue>& eviction_queues, uint64_t max_bytes) const {
+    const auto max_shard_bytes = max_bytes / config_.num_shards;
+    uint64_t num_evictions{0};
+    for (std::size_t i{0}; i < changes.size(); ++i) {
+        if (changes[i].empty()) {
+            continue;
+        }
+        // Copy the bucket pointers of the shard and then each touched bucket at most once
+        auto shard = std::make_shared<CoherentStateShard>(*partitions.shards[i]);
+        std::vector<std::shared_ptr<CoherentStateEntries>> copied_buckets(CoherentStateShard::kNumBuckets);
+        auto& eviction_queue = eviction_queues[i];
+        for (auto& entry : changes[i]) {
+            const auto bucket_id = bucket_index(entry->key);
+            auto& bucket = copied_buckets[bucket_id];
+            if (!bucket) {
+                const auto& shared_bucket = shard->buckets[bucket_id];
+                bucket = shared_bucket ? std::make_shared<CoherentStateEntries>(*shared_bucket)
+                                       : std::make_shared<CoherentStateEntries>();
+                shard->buckets[bucket_id] = bucket;
+            }
+            if (const auto it = bucket->find(entry->key); it != bucket->end()) {
+                shard->size_bytes -= cache_entry_size(it->second->key, it->second->value);
+                --shard->size;
+                bucket->erase(it);
+            }
+            shard->size_bytes += cache_entry_size(entry->key, entry->value);
+            ++shard->size;
+            eviction_queue.emplace_back(entry, entry->last_access.load(std::memory_order_relaxed));
+            const silkworm::ByteView entry_key{entry->key};
+            bucket->emplace(entry_key, std::move(entry));
+        }
+        num_evictions += evict(*shard, copied_buckets, eviction_queue, max_shard_bytes);
+        partitions.shards[i] = std::move(shard);
     }
-    return inserted;
+    return num_evictions;
 }
 
-bool CoherentStateCache::add_code(KeyValue kv, CoherentStateRoot* root, StateViewId view_id) {
-    auto [it, inserted] = root->code_cache.insert(kv);
-    SILK_DEBUG << "Code cache kv.key=" << silkworm::to_hex(kv.key) << " inserted=" << inserted << " view=" << view_id;
-    std::optional<KeyValue> replaced;
-    if (!inserted) {
-        replaced = *it;
-        root->code_cache.erase(it);
-        std::tie(it, inserted) = root->code_cache.insert(kv);
-        SILKWORM_ASSERT(inserted);
+uint64_t CoherentStateCache::evict(CoherentStateShard& shard, std::vector<std::shared_ptr<CoherentStateEntries>>& buckets,
+                                   EvictionQueue& eviction_queue, uint64_t max_shard_bytes) {
+    // The entry of the queue item if still in the shard, i.e. not replaced nor evicted meanwhile
+    const auto find_queued = [&](const CoherentStateEntryPtr& entry) -> const CoherentStateEntries* {
+        const auto& bucket = shard.buckets[bucket_index(entry->key)];
+        if (!bucket) return nullptr;
+        const auto it = bucket->find(entry->key);
+        return it != bucket->end() && it->second == entry ? bucket.get() : nullptr;
+    };
+
+    uint64_t num_evictions{0};
+    while (shard.size_bytes > max_shard_bytes) {
+        if (eviction_queue.empty()) {
+            // Shard inherited from a view other than the latest one (e.g. after an unwind): queue by last access
+            for (const auto& bucket : shard.buckets) {
+                if (!bucket) continue;
+                for (const auto& [_, entry] : *bucket) {
+                    eviction_queue.emplace_back(entry, entry->last_access.load(std::memory_order_relaxed));
+                }
+            }
+            std::sort(eviction_queue.begin(), eviction_queue.end(), [](const auto& lhs, const auto& rhs) {
+                return lhs.second < rhs.second;
+            });
+            if (eviction_queue.empty()) break;
+        }
+        auto [queued_entry, queued_generation] = std::move(eviction_queue.front());
+        eviction_queue.pop_front();
+        // Skip the stale items, i.e. entries already released by all the views or replaced/evicted in this shard
+        const auto entry = queued_entry.lock();
+        if (!entry || !find_queued(entry)) {
+            continue;
+        }
+        // Found accessed since queued: move it to the back as the most recently used one
+        if (const auto last_access = entry->last_access.load(std::memory_order_relaxed); last_access > queued_generation) {
+            eviction_queue.emplace_back(entry, last_access);
+            continue;
+        }
+        const auto bucket_id = bucket_index(entry->key);
+        auto& bucket = buckets[bucket_id];
+        if (!bucket) {
+            bucket = std::make_shared<CoherentStateEntries>(*shard.buckets[bucket_id]);
+            shard.buckets[bucket_id] = bucket;
+        }
+        SILK_DEBUG << "Cache resize victim.key=" << silkworm::to_hex(entry->key);
+        shard.size_bytes -= cache_entry_size(entry->key, entry->value);
+        --shard.size;
+        bucket->erase(entry->key);
+        ++num_evictions;
     }
-    if (latest_state_view_id_ != view_id) {
-        return inserted;
+
+    // Drop the items of replaced or evicted entries once they outnumber the live ones
+    if (eviction_queue.size() > 2 * shard.size + CoherentStateShard::kNumBuckets) {
+        std::erase_if(eviction_queue, [&](const auto& item) {
+            const auto entry = item.first.lock();
+            return !entry || !find_queued(entry);
+        });
     }
-    if (replaced) {
-        code_evictions_.remove(*replaced);
-        SILK_DEBUG << "Code evictions removed replaced.key=" << silkworm::to_hex(replaced->key);
+    return num_evictions;
+}
+
+std::optional<silkworm::Bytes> CoherentStateCache::find(const CoherentStatePartitions& partitions,
+                                                        silkworm::ByteView key) const {
+    const auto index = shard_index(key);
+    const auto generation = generation_.load(std::memory_order_relaxed);
+    const auto& bucket = partitions.shards[index]->buckets[bucket_index(key)];
+    if (bucket) {
+        if (const auto it = bucket->find(key); it != bucket->end()) {
+            const auto& entry = *it->second;
+            if (entry.last_access.load(std::memory_order_relaxed) != generation) {
+                entry.last_access.store(generation, std::memory_order_relaxed);
+            }
+            return entry.value;
+        }
     }
-    code_evictions_.push_front(kv);
-
-    // Remove the longest unused key-value pair when size exceeded
-    if (code_evictions_.size() > config_.max_code_keys) {
-        const auto oldest = code_evictions_.back();
-        SILK_DEBUG << "Code cache resize oldest.key=" << silkworm::to_hex(oldest.key);
-        code_evictions_.pop_back();
-        const auto num_erased = root->code_cache.erase(oldest);
-        SILKWORM_ASSERT(num_erased == 1);
+    const auto& shard_fill = *partitions.fills[index];
+    std::scoped_lock fill_lock{shard_fill.mutex};
+    if (const auto it = shard_fill.entries.find(key); it != shard_fill.entries.end()) {
+        return it->second->value;
     }
-    return inserted;
+    return std::nullopt;
 }
 
-boost::asio::awaitable<std::optional<silkworm::Bytes>> CoherentStateCache::get(const silkworm::Bytes& key, Transaction& txn) {
-    std::shared_lock read_lock{rw_mutex_};
+void CoherentStateCache::fill(const CoherentStatePartitions& partitions, silkworm::Bytes key, silkworm::Bytes value) const {
+    const auto index = shard_index(key);
+    auto entry = make_state_entry(std::move(key), std::move(value), generation_.load());
+    auto& shard_fill = *partitions.fills[index];
+    std::scoped_lock fill_lock{shard_fill.mutex};
+    const silkworm::ByteView entry_key{entry->key};
+    // Concurrent misses on the same key load the same value, so keep the first one
+    shard_fill.entries.try_emplace(entry_key, std::move(entry));
+}
 
+boost::asio::awaitable<std::optional<silkworm::Bytes>> CoherentStateCache::get(const silkworm::Bytes& key, Transaction& txn) {
     const auto view_id = txn.view_id();
-    const auto root_it = state_view_roots_.find(view_id);
-    if (root_it == state_view_roots_.end()) {
+    const auto root = get_root(view_id);
+    if (!root) {
         co_return std::nullopt;
     }
 
-    KeyValue kv{key};
-    auto& cache = root_it->second->cache;
-    const auto kv_it = cache.find(kv);
-    if (kv_it != cache.end()) {
+    if (auto value = find(root->cache, key)) {
         ++state_hit_count_;
 
-        SILK_DEBUG << "Hit in state cache key=" << key << " value=" << kv_it->value;
-
-        if (view_id == latest_state_view_id_) {
-            state_evictions_.remove(kv);
-            state_evictions_.push_front(kv);
-        }
+        SILK_DEBUG << "Hit in state cache key=" << key << " value=" << *value;
 
-        co_return kv_it->value;
+        co_return value;
     }
 
     ++state_miss_count_;
@@ -251,37 +381,24 @@ boost::asio::awaitable<std::optional<silkworm::Bytes>> CoherentStateCache::get(c
         co_return std::nullopt;
     }
 
-    read_lock.unlock();
-    std::unique_lock write_lock{rw_mutex_};
-
-    add({key, value}, root_it->second.get(), view_id);
+    fill(root->cache, key, value);
 
     co_return value;
 }
 
 boost::asio::awaitable<std::optional<silkworm::Bytes>> CoherentStateCache::get_code(const silkworm::Bytes& key, Transaction& txn) {
-    std::shared_lock read_lock{rw_mutex_};
-
     const auto view_id = txn.view_id();
-    const auto root_it = state_view_roots_.find(view_id);
-    if (root_it == state_view_roots_.end()) {
+    const auto root = get_root(view_id);
+    if (!root) {
         co_return std::nullopt;
     }
 
-    KeyValue kv{key};
-    auto& code_cache = root_it->second->code_cache;
-    const auto kv_it = code_cache.find(kv);
-    if (kv_it != code_cache.end()) {
+    if (auto value = find(root->code_cache, key)) {
         ++code_hit_count_;
 
-        SILK_DEBUG << "Hit in code cache key=" << key << " value=" << kv_it->value;
-
-        if (view_id == latest_state_view_id_) {
-            code_evictions_.remove(kv);
-            code_evictions_.push_front(kv);
-        }
+        SILK_DEBUG << "Hit in code cache key=" << key << " value=" << *value;
 
-        co_return kv_it->value;
+        co_return value;
     }
 
     ++code_miss_count_;
@@ -293,76 +410,51 @@ boost::asio::awaitable<std::optional<silkworm::Bytes>> CoherentStateCache::get_c
         co_return std::nullopt;
     }
 
-    read_lock.unlock();
-    std::unique_lock write_lock{rw_mutex_};
-
-    add_code({key, value}, root_it->second.get(), view_id);
+    fill(root->code_cache, key, value);
 
     co_return value;
 }
 
-CoherentStateRoot* CoherentStateCache::get_root(StateViewId view_id) {
-    const auto root_it = state_view_roots_.find(view_id);
-    if (root_it != state_view_roots_.end()) {
-        SILK_DEBUG << "CoherentStateCache::get_root view_id=" << view_id << " root=" << root_it->second.get() << " found";
-        return root_it->second.get();
-    }
-    const auto [new_root_it, _] = state_view_roots_.emplace(view_id, std::make_unique<CoherentStateRoot>());
-    SILK_DEBUG << "CoherentStateCache::get_root view_id=" << view_id << " root=" << root_it->second.get() << " created";
-    return new_root_it->second.get();
+std::size_t CoherentStateCache::shard_index(silkworm::ByteView key) const {
+    // Use the high bits for sharding because the low ones drive the probing inside each shard
+    const uint64_t hash = ByteViewHash{}(key);
+    return static_cast<std::size_t>((hash >> 32) % config_.num_shards);
 }
 
-CoherentStateRoot* CoherentStateCache::advance_root(StateViewId view_id) {
-    CoherentStateRoot* root = get_root(view_id);
+std::size_t CoherentStateCache::bucket_index(silkworm::ByteView key) {
+    // High bits above the shard ones, so that entries spread evenly over the buckets of each shard
+    const uint64_t hash = ByteViewHash{}(key);
+    return static_cast<std::size_t>((hash >> 48) % CoherentStateShard::kNumBuckets);
+}
 
-    const auto previous_root_it = state_view_roots_.find(view_id - 1);
-    if (previous_root_it != state_view_roots_.end() && previous_root_it->second->canonical) {
-        SILK_DEBUG << "CoherentStateCache::advance_root canonical view_id-1=" << (view_id - 1) << " found";
-        root->cache = previous_root_it->second->cache;
-        root->code_cache = previous_root_it->second->code_cache;
-    } else {
-        SILK_DEBUG << "CoherentStateCache::advance_root canonical view_id-1=" << (view_id - 1) << " not found";
-        state_evictions_.clear();
-        for (const auto& kv : root->cache) {
-            state_evictions_.push_front(kv);
-        }
-        code_evictions_.clear();
-        for (const auto& kv : root->code_cache) {
-            code_evictions_.push_front(kv);
-        }
+std::shared_ptr<CoherentStateRoot> CoherentStateCache::get_root(StateViewId view_id) const {
+    const auto roots = load_roots();
+    const auto root_it = roots->find(view_id);
+    if (root_it == roots->end()) {
+        SILK_DEBUG << "CoherentStateCache::get_root view_id=" << view_id << " not found";
+        return nullptr;
     }
-    root->canonical = true;
-
-    evict_roots(view_id);
-
-    latest_state_view_id_ = view_id;
-    latest_state_view_ = root;
-
-    state_eviction_count_ = state_evictions_.size();
-    code_eviction_count_ = code_evictions_.size();
+    return root_it->second;
+}
 
-    return root;
+std::shared_ptr<const CoherentStateRoots> CoherentStateCache::load_roots() const {
+    return std::atomic_load_explicit(&state_view_roots_, std::memory_order_acquire);
 }
 
-void CoherentStateCache::evict_roots(StateViewId next_view_id) {
-    SILK_DEBUG << "CoherentStateCache::evict_roots state_view_roots_.size()=" << state_view_roots_.size();
-    if (state_view_roots_.size() <= config_.max_views) {
+void CoherentStateCache::evict_roots(CoherentStateRoots& roots, StateViewId next_view_id) const {
+    SILK_DEBUG << "CoherentStateCache::evict_roots roots.size()=" << roots.size();
+    if (roots.size() < config_.max_views) {
         return;
     }
     if (next_view_id == 0) {
         // Next view ID is zero with cache not empty => view ID wrapping => clear the cache except for new latest view
-        std::erase_if(state_view_roots_, [&](const auto& item) {
-            auto const& [view_id, _] = item;
-            return view_id != next_view_id;
-        });
+        roots.clear();
         return;
     }
-    // Erase older state views in order not to exceed max_views
-    const auto max_view_id_to_delete = latest_state_view_id_ - config_.max_views + 1;
-    SILK_DEBUG << "CoherentStateCache::evict_roots max_view_id_to_delete=" << max_view_id_to_delete;
-    std::erase_if(state_view_roots_, [&](const auto& item) {
+    // Erase older state views in order not to exceed max_views including the next one
+    std::erase_if(roots, [&](const auto& item) {
         auto const& [view_id, _] = item;
-        return view_id <= max_view_id_to_delete;
+        return view_id < next_view_id && next_view_id - view_id >= config_.max_views;
     });
 }
 
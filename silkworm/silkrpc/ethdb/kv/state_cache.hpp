@@ -16,19 +16,24 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstddef>
-#include <list>
+#include <deque>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
-#include <shared_mutex>
+#include <string_view>
+#include <vector>
 
 #include <silkworm/infra/concurrency/coroutine.hpp>
 
-#include <absl/container/btree_set.h>
+#include <absl/container/flat_hash_map.h>
+#include <absl/hash/hash.h>
 #include <boost/asio/awaitable.hpp>
 
 #include <silkworm/core/common/base.hpp>
+#include <silkworm/core/common/cast.hpp>
 #include <silkworm/interfaces/remote/kv.pb.h>
 #include <silkworm/silkrpc/common/util.hpp>
 #include <silkworm/silkrpc/ethdb/transaction.hpp>
@@ -65,24 +70,101 @@ class StateCache {
     virtual uint64_t code_eviction_count() const = 0;
 };
 
+//! Key-value pair held in the cache, shared by all the state views in which it is still valid
+struct CoherentStateEntry {
+    CoherentStateEntry(silkworm::Bytes k, silkworm::Bytes v, uint64_t generation)
+        : key{std::move(k)}, value{std::move(v)}, last_access{generation} {
+        live_bytes.fetch_add(key.size() + value.size() + sizeof(CoherentStateEntry), std::memory_order_relaxed);
+    }
+    ~CoherentStateEntry() {
+        live_bytes.fetch_sub(key.size() + value.size() + sizeof(CoherentStateEntry), std::memory_order_relaxed);
+    }
+
+    silkworm::Bytes key;
+    silkworm::Bytes value;
+
+    //! Generation of the most recent hit, used to select the eviction victims
+    mutable std::atomic<uint64_t> last_access;
+
+    //! Bytes retained by all the entries alive in the process, i.e. still referenced by some view, fill or change
+    static inline std::atomic<std::size_t> live_bytes{0};
+};
+
+using CoherentStateEntryPtr = std::shared_ptr<const CoherentStateEntry>;
+
+//! Allocate the entry apart from its control block (i.e. no make_shared), so that the weak references held by the
+//! eviction queues do not pin the entry storage once the entry is replaced or evicted
+inline std::shared_ptr<CoherentStateEntry> make_state_entry(silkworm::Bytes key, silkworm::Bytes value,
+                                                            uint64_t generation) {
+    return std::shared_ptr<CoherentStateEntry>{new CoherentStateEntry{std::move(key), std::move(value), generation}};
+}
+
+//! Size in bytes accounted for the specified key-value pair when checking the cache limits
+inline std::size_t cache_entry_size(silkworm::ByteView key, silkworm::ByteView value) {
+    return key.size() + value.size() + sizeof(CoherentStateEntry);
+}
+
+struct ByteViewHash {
+    std::size_t operator()(silkworm::ByteView v) const noexcept {
+        return absl::Hash<std::string_view>{}(silkworm::byte_view_to_string_view(v));
+    }
+};
+
+using CoherentStateEntries = absl::flat_hash_map<silkworm::ByteView, CoherentStateEntryPtr, ByteViewHash>;
+
+//! Immutable partition of the key space split into buckets, the unit of copy-on-write: a block copies just the
+//! bucket pointers and the few entries of the buckets it touches, all the others being shared with the previous views
+struct CoherentStateShard {
+    static constexpr std::size_t kNumBuckets{256};
+
+    CoherentStateShard() : buckets(kNumBuckets) {}
+
+    std::vector<std::shared_ptr<const CoherentStateEntries>> buckets;  // null if empty
+    std::size_t size{0};
+    std::size_t size_bytes{0};
+};
+
+//! Entries loaded on cache miss, private to their view until folded into the next one
+struct CoherentStateFill {
+    mutable std::mutex mutex;
+    CoherentStateEntries entries;
+};
+
+//! Sharded key-value pairs of one state view (either account/storage data or code)
+struct CoherentStatePartitions {
+    explicit CoherentStatePartitions(std::size_t num_shards = 0);
+
+    [[nodiscard]] std::size_t size() const;
+    [[nodiscard]] std::size_t size_bytes() const;
+    [[nodiscard]] bool empty() const { return size() == 0; }
+
+    std::vector<std::shared_ptr<const CoherentStateShard>> shards;
+    std::vector<std::unique_ptr<CoherentStateFill>> fills;
+};
+
+//! Immutable root of one state view: once published it is never modified except for miss fills
 struct CoherentStateRoot {
-    absl::btree_set<KeyValue> cache;
-    absl::btree_set<KeyValue> code_cache;
-    bool ready{false};
-    bool canonical{false};
+    explicit CoherentStateRoot(std::size_t num_shards = 0) : cache{num_shards}, code_cache{num_shards} {}
+
+    CoherentStatePartitions cache;
+    CoherentStatePartitions code_cache;
 };
 
 using StateViewId = uint64_t;
 
+using CoherentStateRoots = std::map<StateViewId, std::shared_ptr<CoherentStateRoot>>;
+
 constexpr auto kDefaultMaxViews{5ul};
-constexpr auto kDefaultMaxStateKeys{1'000'000u};
-constexpr auto kDefaultMaxCodeKeys{10'000u};
+constexpr auto kDefaultMaxStateBytes{256 * kMebi};
+constexpr auto kDefaultMaxCodeBytes{128 * kMebi};
+constexpr auto kDefaultNumShards{64u};
 
 struct CoherentCacheConfig {
     uint64_t max_views{kDefaultMaxViews};
     bool with_storage{true};
-    uint32_t max_state_keys{kDefaultMaxStateKeys};
-    uint32_t max_code_keys{kDefaultMaxCodeKeys};
+    uint64_t max_state_bytes{kDefaultMaxStateBytes};
+    uint64_t max_code_bytes{kDefaultMaxCodeBytes};
+    uint32_t num_shards{kDefaultNumShards};
 };
 
 class CoherentStateCache;
@@ -103,6 +185,8 @@ class CoherentStateView : public StateView {
     CoherentStateCache* cache_;
 };
 
+//! Coherent cache of the latest state views. Readers never wait for block updates: the next root is built
+//! copy-on-write from the previous one without holding any lock and then published by atomically swapping the roots pointer
 class CoherentStateCache : public StateCache {
   public:
     explicit CoherentStateCache(CoherentCacheConfig config = {});
@@ -129,35 +213,53 @@ class CoherentStateCache : public StateCache {
   private:
     friend class CoherentStateView;
 
-    void process_upsert_change(CoherentStateRoot* root, StateViewId view_id, const remote::AccountChange& change);
-    void process_code_change(CoherentStateRoot* root, StateViewId view_id, const remote::AccountChange& change);
-    void process_delete_change(CoherentStateRoot* root, StateViewId view_id, const remote::AccountChange& change);
-    void process_storage_change(CoherentStateRoot* root, StateViewId view_id, const remote::AccountChange& change);
-    bool add(KeyValue kv, CoherentStateRoot* root, StateViewId view_id);
-    bool add_code(KeyValue kv, CoherentStateRoot* root, StateViewId view_id);
+    //! Entries changed by the incoming block grouped by shard
+    using ShardChanges = std::vector<std::vector<CoherentStateEntryPtr>>;
+
+    //! Entries of one shard of the latest view in the order they were inserted or last found accessed, each one with
+    //! the generation it was queued at: items whose entry has been replaced meanwhile are skipped when met
+    using EvictionQueue = std::deque<std::pair<std::weak_ptr<const CoherentStateEntry>, uint64_t>>;
+
+    void process_upsert_change(ShardChanges& changes, const remote::AccountChange& change);
+    void process_code_change(ShardChanges& changes, const remote::AccountChange& change);
+    void process_delete_change(ShardChanges& changes, const remote::AccountChange& change);
+    void process_storage_change(ShardChanges& changes, const remote::AccountChange& change);
+    void add(ShardChanges& changes, silkworm::Bytes key, silkworm::Bytes value);
+    void fold_fills(const CoherentStatePartitions& previous, ShardChanges& changes) const;
+    uint64_t apply_changes(CoherentStatePartitions& partitions, ShardChanges& changes,
+                           std::vector<EvictionQueue>& eviction_queues, uint64_t max_bytes) const;
+    static uint64_t evict(CoherentStateShard& shard, std::vector<std::shared_ptr<CoherentStateEntries>>& buckets,
+                          EvictionQueue& eviction_queue, uint64_t max_shard_bytes);
+    std::optional<silkworm::Bytes> find(const CoherentStatePartitions& partitions, silkworm::ByteView key) const;
+    void fill(const CoherentStatePartitions& partitions, silkworm::Bytes key, silkworm::Bytes value) const;
     boost::asio::awaitable<std::optional<silkworm::Bytes>> get(const silkworm::Bytes& key, Transaction& txn);
     boost::asio::awaitable<std::optional<silkworm::Bytes>> get_code(const silkworm::Bytes& key, Transaction& txn);
-    CoherentStateRoot* get_root(StateViewId view_id);
-    CoherentStateRoot* advance_root(StateViewId view_id);
-    void evict_roots(StateViewId next_view_id);
+    [[nodiscard]] std::size_t shard_index(silkworm::ByteView key) const;
+    [[nodiscard]] static std::size_t bucket_index(silkworm::ByteView key);
+    std::shared_ptr<CoherentStateRoot> get_root(StateViewId view_id) const;
+    std::shared_ptr<const CoherentStateRoots> load_roots() const;
+    void evict_roots(CoherentStateRoots& roots, StateViewId next_view_id) const;
 
     CoherentCacheConfig config_;
 
-    std::map<StateViewId, std::unique_ptr<CoherentStateRoot>> state_view_roots_;
-    StateViewId latest_state_view_id_{0};
-    CoherentStateRoot* latest_state_view_{nullptr};
-    std::list<KeyValue> state_evictions_;
-    std::list<KeyValue> code_evictions_;
-    std::shared_mutex rw_mutex_;
-
-    uint64_t state_hit_count_{0};
-    uint64_t state_miss_count_{0};
-    uint64_t state_key_count_{0};
-    uint64_t state_eviction_count_{0};
-    uint64_t code_hit_count_{0};
-    uint64_t code_miss_count_{0};
-    uint64_t code_key_count_{0};
-    uint64_t code_eviction_count_{0};
+    //! The published roots: readers take a snapshot, writers replace it as a whole (both atomically)
+    std::shared_ptr<const CoherentStateRoots> state_view_roots_;
+    //! Serializes the block updates
+    std::mutex update_mutex_;
+    //! LRU order of the entries of the latest view, one queue per shard (accessed under update_mutex_)
+    std::vector<EvictionQueue> state_eviction_queues_;
+    std::vector<EvictionQueue> code_eviction_queues_;
+    std::atomic<StateViewId> latest_state_view_id_{0};
+    std::atomic<uint64_t> generation_{0};
+
+    std::atomic<uint64_t> state_hit_count_{0};
+    std::atomic<uint64_t> state_miss_count_{0};
+    std::atomic<uint64_t> state_key_count_{0};
+    std::atomic<uint64_t> state_eviction_count_{0};
+    std::atomic<uint64_t> code_hit_count_{0};
+    std::atomic<uint64_t> code_miss_count_{0};
+    std::atomic<uint64_t> code_key_count_{0};
+    std::atomic<uint64_t> code_eviction_count_{0};
 };
 
 }  // namespace silkworm::rpc::ethdb::kv
@@ -0,0 +1,114 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/thread_pool.hpp>
+#include <boost/asio/use_future.hpp>
+
+#include <silkworm/core/common/base.hpp>
+#include <silkworm/core/common/endian.hpp>
+#include <silkworm/infra/common/log.hpp>
+#include <silkworm/infra/grpc/common/conversion.hpp>
+#include <silkworm/silkrpc/ethdb/kv/state_cache.hpp>
+#include <silkworm/silkrpc/test/dummy_transaction.hpp>
+
+namespace silkworm::rpc::ethdb::kv {
+
+static constexpr uint64_t kBenchViewId{1'000'000};
+
+//! Batch upserting the accounts in range [first, first + count)
+static remote::StateChangeBatch new_upsert_batch(uint64_t view_id, uint64_t first, uint64_t count) {
+    remote::StateChangeBatch batch;
+    batch.set_state_version_id(view_id);
+    remote::StateChange* change = batch.add_change_batch();
+    change->set_block_height(view_id);
+    const Bytes account_data(32, 0x01);
+    for (uint64_t i{first}; i < first + count; ++i) {
+        evmc::address address;
+        endian::store_big_u64(address.bytes + 12, i);
+        remote::AccountChange* account_change = change->add_changes();
+        account_change->set_allocated_address(H160_from_address(address).release());
+        account_change->set_action(remote::Action::UPSERT);
+        account_change->set_data(account_data.data(), account_data.size());
+    }
+    return batch;
+}
+
+//! Latency of a block update as a function of the number of keys already cached
+static void benchmark_on_new_block(benchmark::State& state) {
+    log::set_verbosity(log::Level::kNone);
+    const auto num_cached_keys{static_cast<uint64_t>(state.range(0))};
+    constexpr uint64_t kChangesPerBlock{500};
+
+    CoherentStateCache cache;
+    cache.on_new_block(new_upsert_batch(kBenchViewId, 0, num_cached_keys));
+    uint64_t view_id{kBenchViewId + 1};
+    for ([[maybe_unused]] auto _ : state) {
+        state.PauseTiming();
+        const auto batch{new_upsert_batch(view_id, (view_id * kChangesPerBlock) % num_cached_keys, kChangesPerBlock)};
+        state.ResumeTiming();
+        cache.on_new_block(batch);
+        ++view_id;
+    }
+}
+
+BENCHMARK(benchmark_on_new_block)->Arg(10'000)->Arg(100'000)->Arg(1'000'000);
+
+//! Throughput of concurrent cache hits, with or without block updates happening in the meantime
+static void benchmark_get_hit(benchmark::State& state) {
+    log::set_verbosity(log::Level::kNone);
+    constexpr uint64_t kNumKeys{100'000};
+    const bool with_updates{state.range(0) != 0};
+
+    static std::unique_ptr<CoherentStateCache> cache;
+    static std::atomic<uint64_t> latest_view_id{kBenchViewId};
+    if (state.thread_index() == 0) {
+        cache = std::make_unique<CoherentStateCache>();
+        cache->on_new_block(new_upsert_batch(kBenchViewId, 0, kNumKeys));
+        latest_view_id = kBenchViewId;
+    }
+    boost::asio::thread_pool pool{1};
+
+    uint64_t i{static_cast<uint64_t>(state.thread_index())};
+    for ([[maybe_unused]] auto _ : state) {
+        if (with_updates && state.thread_index() == 0 && i % 1'000 == 0) {
+            cache->on_new_block(new_upsert_batch(latest_view_id + 1, i % kNumKeys, 100));
+            ++latest_view_id;
+        }
+        evmc::address address;
+        endian::store_big_u64(address.bytes + 12, i++ % kNumKeys);
+        test::DummyTransaction txn{latest_view_id, nullptr};
+        auto view = cache->get_view(txn);
+        if (!view) continue;
+        const Bytes address_key{address.bytes, kAddressLength};
+        auto result = boost::asio::co_spawn(pool, view->get(address_key), boost::asio::use_future);
+        benchmark::DoNotOptimize(result.get());
+    }
+
+    if (state.thread_index() == 0) {
+        cache.reset();
+    }
+}
+
+BENCHMARK(benchmark_get_hit)->Arg(0)->Arg(1)->Threads(1)->Threads(4)->Threads(8);
+
+}  // namespace silkworm::rpc::ethdb::kv
@@ -16,9 +16,11 @@
 
 #include "state_cache.hpp"
 
+#include <atomic>
 #include <limits>
 #include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <boost/asio/co_spawn.hpp>
@@ -84,8 +86,19 @@ TEST_CASE("CoherentStateRoot", "[silkrpc][ethdb][kv][state_cache]") {
         CoherentStateRoot root;
         CHECK(root.cache.empty());
         CHECK(root.code_cache.empty());
-        CHECK(!root.ready);
-        CHECK(!root.canonical);
+        CHECK(root.cache.shards.empty());
+        CHECK(root.code_cache.shards.empty());
+    }
+
+    SECTION("CoherentStateRoot::CoherentStateRoot with shards") {
+        CoherentStateRoot root{kDefaultNumShards};
+        CHECK(root.cache.empty());
+        CHECK(root.code_cache.empty());
+        CHECK(root.cache.shards.size() == kDefaultNumShards);
+        CHECK(root.cache.fills.size() == kDefaultNumShards);
+        CHECK(root.code_cache.shards.size() == kDefaultNumShards);
+        CHECK(root.code_cache.fills.size() == kDefaultNumShards);
+        CHECK(root.cache.size_bytes() == 0);
     }
 }
 
@@ -94,8 +107,9 @@ TEST_CASE("CoherentCacheConfig", "[silkrpc][ethdb][kv][state_cache]") {
         CoherentCacheConfig config;
         CHECK(config.max_views == kDefaultMaxViews);
         CHECK(config.with_storage);
-        CHECK(config.max_state_keys == kDefaultMaxStateKeys);
-        CHECK(config.max_code_keys == kDefaultMaxCodeKeys);
+        CHECK(config.max_state_bytes == kDefaultMaxStateBytes);
+        CHECK(config.max_code_bytes == kDefaultMaxCodeBytes);
+        CHECK(config.num_shards == kDefaultNumShards);
     }
 }
 
@@ -241,8 +255,13 @@ TEST_CASE("CoherentStateCache::CoherentStateCache", "[silkrpc][ethdb][kv][state_
         CHECK(cache.state_eviction_count() == 0);
     }
 
-    SECTION("wrong config") {
-        CoherentCacheConfig config{0, true, kDefaultMaxStateKeys, kDefaultMaxCodeKeys};
+    SECTION("wrong config: zero max views") {
+        CoherentCacheConfig config{0, true, kDefaultMaxStateBytes, kDefaultMaxCodeBytes, kDefaultNumShards};
+        CHECK_THROWS_AS(CoherentStateCache{config}, std::invalid_argument);
+    }
+
+    SECTION("wrong config: zero shards") {
+        CoherentCacheConfig config{kDefaultMaxViews, true, kDefaultMaxStateBytes, kDefaultMaxCodeBytes, 0};
         CHECK_THROWS_AS(CoherentStateCache{config}, std::invalid_argument);
     }
 }
@@ -298,7 +317,7 @@ TEST_CASE("CoherentStateCache::get_view one view", "[silkrpc][ethdb][kv][state_c
         CHECK(cache.state_hit_count() == 1);
         CHECK(cache.state_miss_count() == 0);
         CHECK(cache.state_key_count() == 1);
-        CHECK(cache.state_eviction_count() == 1);
+        CHECK(cache.state_eviction_count() == 0);
     }
 
     SECTION("single upsert+code change batch => double search hit") {
@@ -491,14 +510,14 @@ TEST_CASE("CoherentStateCache::get_view two views", "[silkrpc][ethdb][kv][state_
         CHECK(cache.state_hit_count() == 1);
         CHECK(cache.state_miss_count() == 0);
         CHECK(cache.state_key_count() == 1);
-        CHECK(cache.state_eviction_count() == 1);
+        CHECK(cache.state_eviction_count() == 0);
 
         get_and_check_upsert(cache, txn2, kTestAddress1, kTestAccountData);
 
         CHECK(cache.state_hit_count() == 2);
         CHECK(cache.state_miss_count() == 0);
         CHECK(cache.state_key_count() == 1);
-        CHECK(cache.state_eviction_count() == 1);
+        CHECK(cache.state_eviction_count() == 0);
     }
 
     SECTION("two code change batches => two search hits in different views") {
@@ -519,7 +538,7 @@ TEST_CASE("CoherentStateCache::get_view two views", "[silkrpc][ethdb][kv][state_
         CHECK(cache.code_hit_count() == 1);
         CHECK(cache.code_miss_count() == 0);
         CHECK(cache.code_key_count() == 2);
-        CHECK(cache.code_eviction_count() == 1);
+        CHECK(cache.code_eviction_count() == 0);
 
         get_and_check_code(cache, txn2, kTestCode1);
         get_and_check_code(cache, txn2, kTestCode2);
@@ -527,7 +546,7 @@ TEST_CASE("CoherentStateCache::get_view two views", "[silkrpc][ethdb][kv][state_
         CHECK(cache.code_hit_count() == 3);
         CHECK(cache.code_miss_count() == 0);
         CHECK(cache.code_key_count() == 2);
-        CHECK(cache.code_eviction_count() == 1);
+        CHECK(cache.code_eviction_count() == 0);
     }
 }
 
@@ -559,13 +578,17 @@ TEST_CASE("CoherentStateCache::on_new_block exceed max views", "[silkrpc][ethdb]
     CHECK(cache.get_view(txn0) == nullptr);
 }
 
-TEST_CASE("CoherentStateCache::on_new_block exceed max keys", "[silkrpc][ethdb][kv][state_cache]") {
+TEST_CASE("CoherentStateCache::on_new_block exceed max bytes", "[silkrpc][ethdb][kv][state_cache]") {
     silkworm::test::SetLogVerbosityGuard log_guard{log::Level::kNone};
     constexpr auto kMaxKeys{2u};
-    const CoherentCacheConfig config{kDefaultMaxViews, /*with_storage=*/true, kMaxKeys, kMaxKeys};
+    const silkworm::Bytes address_key{kTestAddress1.bytes, silkworm::kAddressLength};
+    const auto max_state_bytes{kMaxKeys * cache_entry_size(address_key, kTestAccountData)};
+    const silkworm::Bytes code_hash_key(silkworm::kHashLength, 0);
+    const auto max_code_bytes{cache_entry_size(code_hash_key, kTestCode1) + cache_entry_size(code_hash_key, kTestCode2)};
+    const CoherentCacheConfig config{kDefaultMaxViews, /*with_storage=*/true, max_state_bytes, max_code_bytes, /*num_shards=*/1};
     CoherentStateCache cache{config};
 
-    // Create as many data and code keys as the maximum allowed number
+    // Create as many data and code keys as the maximum allowed size
     cache.on_new_block(new_batch_with_upsert_code(kTestViewId0, kTestBlockNumber, kTestBlockHash, kTestZeroTxs,
                                                   /*unwind=*/false, /*num_changes=*/kMaxKeys));
     CHECK(cache.state_key_count() == kMaxKeys);
@@ -573,13 +596,152 @@ TEST_CASE("CoherentStateCache::on_new_block exceed max keys", "[silkrpc][ethdb][
     CHECK(cache.state_eviction_count() == 0);
     CHECK(cache.code_eviction_count() == 0);
 
-    // Next incoming batch with *new keys* overflows the data and code keys
+    // Next incoming batch with *new keys* overflows the data and code sizes, so the oldest keys get evicted
     cache.on_new_block(new_batch_with_upsert_code(kTestViewId1, kTestBlockNumber + 1, kTestBlockHash, kTestZeroTxs,
                                                   /*unwind=*/false, /*num_changes=*/4, /*offset=*/2));
     CHECK(cache.state_key_count() == kMaxKeys);
     CHECK(cache.code_key_count() == kMaxKeys);
     CHECK(cache.state_eviction_count() == kMaxKeys);
     CHECK(cache.code_eviction_count() == kMaxKeys);
+
+    // The previous view is untouched by the evictions in the latest one
+    test::MockTransaction txn0, txn1;
+    EXPECT_CALL(txn0, view_id()).Times(2).WillRepeatedly(Return(kTestViewId0));
+    EXPECT_CALL(txn1, view_id()).Times(2).WillRepeatedly(Return(kTestViewId1));
+    get_and_check_code(cache, txn0, kTestCode1);
+    get_and_check_code(cache, txn1, kTestCode4);
+}
+
+TEST_CASE("CoherentStateCache::on_new_block overwrite churn stays within max bytes", "[silkrpc][ethdb][kv][state_cache]") {
+    silkworm::test::SetLogVerbosityGuard log_guard{log::Level::kNone};
+    constexpr auto kNumBlocks{1'000u};
+    constexpr auto kMaxKeys{2u};
+    const silkworm::Bytes address_key{kTestAddress1.bytes, silkworm::kAddressLength};
+    const auto max_state_bytes{kMaxKeys * cache_entry_size(address_key, kTestAccountData)};
+    const silkworm::Bytes code_hash_key(silkworm::kHashLength, 0);
+    const auto max_code_bytes{cache_entry_size(code_hash_key, kTestCode1) + cache_entry_size(code_hash_key, kTestCode2)};
+    const CoherentCacheConfig config{/*max_views=*/1, /*with_storage=*/true, max_state_bytes, max_code_bytes,
+                                     /*num_shards=*/1};
+    const auto initial_live_bytes{CoherentStateEntry::live_bytes.load()};
+    CoherentStateCache cache{config};
+
+    // Every block overwrites all the keys, so the replaced and evicted entries must be released at once
+    for (auto i{0u}; i < kNumBlocks; ++i) {
+        cache.on_new_block(new_batch_with_upsert_code(kTestViewId0 + i, kTestBlockNumber + i, kTestBlockHash,
+                                                      kTestZeroTxs, /*unwind=*/false, /*num_changes=*/4));
+        CHECK(CoherentStateEntry::live_bytes.load() - initial_live_bytes <= max_state_bytes + max_code_bytes);
+    }
+    CHECK(cache.state_key_count() == kMaxKeys);
+    CHECK(cache.code_key_count() == kMaxKeys);
+}
+
+TEST_CASE("CoherentStateCache::on_new_block evicts the least recently used keys", "[silkrpc][ethdb][kv][state_cache]") {
+    silkworm::test::SetLogVerbosityGuard log_guard{log::Level::kNone};
+    const silkworm::Bytes code_hash_key(silkworm::kHashLength, 0);
+    const auto max_code_bytes{cache_entry_size(code_hash_key, kTestCode1) + cache_entry_size(code_hash_key, kTestCode2)};
+    const CoherentCacheConfig config{kDefaultMaxViews, /*with_storage=*/true, kDefaultMaxStateBytes, max_code_bytes, /*num_shards=*/1};
+    CoherentStateCache cache{config};
+
+    // Fill the code cache up to its limit, then access the oldest code in the next view
+    cache.on_new_block(new_batch_with_upsert_code(kTestViewId0, kTestBlockNumber, kTestBlockHash, kTestZeroTxs,
+                                                  /*unwind=*/false, /*num_changes=*/2));
+    cache.on_new_block(new_batch_with_upsert(kTestViewId1, kTestBlockNumber + 1, kTestBlockHash, kTestZeroTxs,
+                                             /*unwind=*/false));
+    test::MockTransaction txn1;
+    EXPECT_CALL(txn1, view_id()).Times(2).WillRepeatedly(Return(kTestViewId1));
+    get_and_check_code(cache, txn1, kTestCode1);
+
+    // Next code overflows the limit: the code not accessed since its insertion is evicted, not the oldest one
+    cache.on_new_block(new_batch_with_upsert_code(kTestViewId2, kTestBlockNumber + 2, kTestBlockHash, kTestZeroTxs,
+                                                  /*unwind=*/false, /*num_changes=*/3, /*offset=*/2));
+    CHECK(cache.code_key_count() == 2);
+    CHECK(cache.code_eviction_count() == 1);
+    test::MockTransaction txn2;
+    EXPECT_CALL(txn2, view_id()).Times(4).WillRepeatedly(Return(kTestViewId2));
+    get_and_check_code(cache, txn2, kTestCode1);
+    get_and_check_code(cache, txn2, kTestCode3);
+    CHECK(cache.code_miss_count() == 0);
+}
+
+TEST_CASE("CoherentStateCache::on_new_block carries over unchanged keys", "[silkrpc][ethdb][kv][state_cache]") {
+    silkworm::test::SetLogVerbosityGuard log_guard{log::Level::kNone};
+    CoherentStateCache cache;
+
+    cache.on_new_block(new_batch_with_upsert_code(kTestViewId0, kTestBlockNumber, kTestBlockHash, kTestZeroTxs,
+                                                  /*unwind=*/false, /*num_changes=*/4));
+    cache.on_new_block(new_batch_with_upsert(kTestViewId1, kTestBlockNumber + 1, kTestBlockHash, kTestZeroTxs,
+                                             /*unwind=*/false));
+    CHECK(cache.latest_data_size() == 4);
+    CHECK(cache.latest_code_size() == 4);
+
+    // All code keys are carried over to the next view and are still found in both views
+    test::MockTransaction txn0, txn1;
+    EXPECT_CALL(txn0, view_id()).Times(8).WillRepeatedly(Return(kTestViewId0));
+    EXPECT_CALL(txn1, view_id()).Times(8).WillRepeatedly(Return(kTestViewId1));
+    for (const auto& code : kTestCodes) {
+        get_and_check_code(cache, txn0, code);
+        get_and_check_code(cache, txn1, code);
+    }
+    CHECK(cache.code_hit_count() == 2 * kTestCodes.size());
+    CHECK(cache.code_miss_count() == 0);
+}
+
+TEST_CASE("CoherentStateCache::get concurrent with on_new_block", "[silkrpc][ethdb][kv][state_cache]") {
+    silkworm::test::SetLogVerbosityGuard log_guard{log::Level::kNone};
+    constexpr auto kNumBlocks{500u};
+    constexpr auto kNumReaders{4u};
+    CoherentStateCache cache;
+    boost::asio::thread_pool pool{kNumReaders};
+
+    cache.on_new_block(new_batch_with_upsert(kTestViewId0, kTestBlockNumber, kTestBlockHash, kTestZeroTxs, /*unwind=*/false));
+    std::atomic<uint64_t> latest_view_id{kTestViewId0};
+    std::atomic_bool done{false};
+    std::atomic<uint64_t> num_reads{0};
+    std::atomic<uint64_t> num_mismatches{0};
+
+    // Readers continuously query the latest view, which may even be evicted in the meantime
+    std::vector<std::thread> readers;
+    for (auto i{0u}; i < kNumReaders; ++i) {
+        readers.emplace_back([&]() {
+            auto mock_cursor = std::make_shared<test::MockCursorDupSort>();
+            const silkworm::Bytes address_key{kTestAddress1.bytes, silkworm::kAddressLength};
+            while (!done) {
+                test::DummyTransaction txn{latest_view_id, mock_cursor};
+                std::unique_ptr<StateView> view = cache.get_view(txn);
+                if (!view) continue;
+                auto result = boost::asio::co_spawn(pool, view->get(address_key), boost::asio::use_future);
+                const auto value = result.get();
+                if (value) {
+                    ++num_reads;
+                    if (*value != kTestAccountData) ++num_mismatches;
+                }
+            }
+        });
+    }
+
+    // Writer keeps publishing new views with new keys
+    for (uint64_t i{1}; i <= kNumBlocks; ++i) {
+        const auto view_id = kTestViewId0 + i;
+        auto batch = new_batch_with_upsert(view_id, kTestBlockNumber + i, kTestBlockHash, kTestZeroTxs, /*unwind=*/false);
+        auto* storage_change = batch.mutable_change_batch(0)->add_changes();
+        storage_change->set_allocated_address(silkworm::rpc::H160_from_address(kTestAddress2).release());
+        storage_change->set_action(remote::Action::STORAGE);
+        storage_change->set_incarnation(kTestIncarnation);
+        auto* slot = storage_change->add_storage_changes();
+        slot->set_allocated_location(silkworm::rpc::H256_from_bytes32(evmc::bytes32{i}).release());
+        slot->set_data(kTestStorageData1.data(), kTestStorageData1.size());
+        cache.on_new_block(batch);
+        latest_view_id = view_id;
+    }
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    CHECK(num_mismatches == 0);
+    CHECK(cache.state_hit_count() == num_reads);
+    CHECK(cache.state_miss_count() == 0);
+    CHECK(cache.latest_data_size() == kNumBlocks + 1);
 }
 
 TEST_CASE("CoherentStateCache::on_new_block clear the cache on view ID wrapping", "[silkrpc][ethdb][kv][state_cache]") {
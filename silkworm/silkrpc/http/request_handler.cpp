@@ -31,6 +31,7 @@
 #include <nlohmann/json.hpp>
 
 #include <silkworm/infra/common/log.hpp>
+#include <silkworm/infra/metrics/registry.hpp>
 #include <silkworm/silkrpc/commands/eth_api.hpp>
 #include <silkworm/silkrpc/common/clock_time.hpp>
 #include <silkworm/silkrpc/http/header.hpp>
@@ -38,6 +39,13 @@
 
 namespace silkworm::rpc::http {
 
+//! Latency of the served JSON RPC methods: only methods found in the API table get a series
+static metrics::Family<metrics::Histogram>& method_duration() {
+    static auto& family{metrics::default_registry().histogram_family(
+        "silkworm_rpc_method_duration_seconds", "JSON RPC method handling duration", "method", 1e-9)};
+    return family;
+}
+
 boost::asio::awaitable<void> RequestHandler::handle(const http::Request& request) {
     auto start = clock_time::now();
 
@@ -100,7 +108,7 @@ boost::asio::awaitable<void> RequestHandler::handle(const http::Request& request
 
     co_await do_write(reply);
 
-    SILK_INFO << "handle_user_request t=" << clock_time::since(start) << "ns";
+    SILK_DEBUG << "handle_user_request t=" << clock_time::since(start) << "ns";
 }
 
 boost::asio::awaitable<void> RequestHandler::handle_request_and_create_reply(const nlohmann::json& request_json, http::Reply& reply) {
@@ -121,16 +129,19 @@ boost::asio::awaitable<void> RequestHandler::handle_request_and_create_reply(con
     // Dispatch JSON handlers in this order: 1) glaze JSON 2) nlohmann JSON 3) JSON streaming
     const auto json_glaze_handler = rpc_api_table_.find_json_glaze_handler(method);
     if (json_glaze_handler) {
+        metrics::ScopedTimer timer{method_duration().with(method)};
         co_await handle_request(request_id, *json_glaze_handler, request_json, reply);
         co_return;
     }
     const auto json_handler = rpc_api_table_.find_json_handler(method);
     if (json_handler) {
+        metrics::ScopedTimer timer{method_duration().with(method)};
         co_await handle_request(request_id, *json_handler, request_json, reply);
         co_return;
     }
     const auto stream_handler = rpc_api_table_.find_stream_handler(method);
     if (stream_handler) {
+        metrics::ScopedTimer timer{method_duration().with(method)};
         co_await handle_request(*stream_handler, request_json);
         co_return;
     }
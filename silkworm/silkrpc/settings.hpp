@@ -34,10 +34,13 @@ struct DaemonSettings {
     std::string eth_api_spec{kDefaultEth1ApiSpec};
     std::string private_api_addr{kDefaultPrivateApiAddr};
     uint32_t num_workers{std::thread::hardware_concurrency() / 2};
+    concurrency::CpuSet workers_cpu_set;  // The CPUs running the workers (empty means no pinning)
+    concurrency::AffinityMode workers_affinity_mode{concurrency::AffinityMode::shared};
     std::optional<std::string> jwt_secret_file;
     bool skip_protocol_check{false};
     uint64_t rpc_quirk_flag{0};
     std::optional<uint32_t> max_readers;
+    std::string metrics_end_point;  // Prometheus metrics end-point (empty means disabled)
 };
 
 }  // namespace silkworm::rpc
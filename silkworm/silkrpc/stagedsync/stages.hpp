@@ -28,6 +28,7 @@ namespace silkworm::rpc::stages {
 
 const silkworm::Bytes kHeaders = silkworm::bytes_of_string(silkworm::db::stages::kHeadersKey);
 const silkworm::Bytes kExecution = silkworm::bytes_of_string(silkworm::db::stages::kExecutionKey);
+const silkworm::Bytes kCallTraces = silkworm::bytes_of_string(silkworm::db::stages::kCallTracesKey);
 const silkworm::Bytes kFinish = silkworm::bytes_of_string(silkworm::db::stages::kFinishKey);
 
 boost::asio::awaitable<uint64_t> get_sync_stage_progress(const core::rawdb::DatabaseReader& database, const silkworm::Bytes& stake_key);
@@ -27,6 +27,7 @@
 #include <silkworm/node/common/preverified_hashes.hpp>
 #include <silkworm/sync/messages/inbound_message.hpp>
 #include <silkworm/sync/messages/internal_message.hpp>
+#include <silkworm/sync/messages/outbound_get_block_headers.hpp>
 #include <silkworm/sync/sentry_client.hpp>
 
 namespace silkworm {
@@ -110,11 +111,14 @@ void BlockExchange::execution_loop() {
 
             auto now = system_clock::now();
 
+            // re-issue requests not answered in time
+            for (auto request_id : sentry_.peer_scheduler().expire_requests(now)) {
+                body_sequence_.request_expired(request_id);  // header requests are renewed by header chain timeouts
+                statistics_.timeout_msgs++;
+            }
+
             // request headers & bodies from remote peers
-            size_t outstanding_requests = header_chain_.outstanding_requests(now) +
-                                          body_sequence_.outstanding_requests(now);
-            size_t peers_capacity = SentryClient::kPerPeerMaxOutstandingRequests * sentry_.active_peers();
-            size_t room_for_new_requests = peers_capacity > outstanding_requests ? peers_capacity - outstanding_requests : 0;
+            size_t room_for_new_requests = free_request_slots(now);
 
             auto body_requests = room_for_new_requests == 1
                                      ? Singleton<RandomNumber>::instance().generate_one() % 2  // 50% chance to request a body
@@ -123,7 +127,9 @@ void BlockExchange::execution_loop() {
             room_for_new_requests -= request_bodies(now, body_requests);           // do the computed nr. of body requests
             room_for_new_requests -= request_headers(now, room_for_new_requests);  // do the remaining nr. of header requests
 
-            request_bodies(now, room_for_new_requests);  // if headers do not used all the room we use it for body requests
+            room_for_new_requests -= request_bodies(now, room_for_new_requests);  // if headers do not used all the room we use it for body requests
+
+            if (room_for_new_requests > 0) request_stalled_bodies(now);  // nothing else to do, try to speed up the tail
 
             // todo: check if it is better to apply a policy based on the current sync status
             // for example: if (header_chain_.current_height() - body_sequence_.current_height() > stride) { ... }
@@ -150,11 +156,28 @@ void BlockExchange::execution_loop() {
     stop();
 }
 
+size_t BlockExchange::free_request_slots(time_point_t tp) {
+    auto& scheduler = sentry_.peer_scheduler();
+    uint64_t active_peers = sentry_.active_peers();
+
+    if (scheduler.peers() == 0) {  // no peer performance known yet, use a fixed depth
+        size_t outstanding_requests = header_chain_.outstanding_requests(tp) +
+                                      body_sequence_.outstanding_requests(tp);
+        size_t peers_capacity = SentryClient::kPerPeerMaxOutstandingRequests * active_peers;
+        return peers_capacity > outstanding_requests ? peers_capacity - outstanding_requests : 0;
+    }
+
+    // the adaptive depth of the known peers plus a probe request for each peer not yet known
+    size_t unknown_peers = active_peers > scheduler.peers() ? active_peers - scheduler.peers() : 0;
+    return scheduler.free_slots() + unknown_peers;
+}
+
 size_t BlockExchange::request_headers(time_point_t tp, size_t max_nr_of_requests) {
     if (max_nr_of_requests == 0) return 0;
     if (!downloading_active_) return 0;
     if (header_chain_.in_sync()) return 0;
 
+    auto& scheduler = sentry_.peer_scheduler();
     size_t sent_requests = 0;
     do {
         auto request_message = header_chain_.request_headers(tp);
@@ -162,6 +185,15 @@ size_t BlockExchange::request_headers(time_point_t tp, size_t max_nr_of_requests
 
         if (!request_message) break;
 
+        // header batches are fixed by the header chain, only the peer is chosen by its performance
+        auto get_headers_message = std::dynamic_pointer_cast<OutboundGetBlockHeaders>(request_message);
+        if (get_headers_message && get_headers_message->packet_present()) {
+            auto target_peer = scheduler.select_peer();
+            if (target_peer && scheduler.may_have_block(*target_peer, get_headers_message->min_block())) {
+                get_headers_message->target_peer() = std::move(target_peer);
+            }
+        }
+
         request_message->execute(db_access_, header_chain_, body_sequence_, sentry_);
 
         statistics_.sent_msgs += request_message->sent_requests();
@@ -180,19 +212,29 @@ size_t BlockExchange::request_bodies(time_point_t tp, size_t max_nr_of_requests)
     if (!downloading_active_) return 0;
     if (body_sequence_.has_completed()) return 0;
 
+    auto& scheduler = sentry_.peer_scheduler();
     size_t sent_requests = 0;
     do {
-        auto request_message = body_sequence_.request_bodies(tp);
+        // batch size follows the target peer rate
+        auto target_peer = scheduler.select_peer();
+        size_t max_blocks = target_peer ? scheduler.batch_size(*target_peer) : BodySequence::kMaxBlocksPerMessage;
+
+        auto request_message = body_sequence_.request_bodies(tp, max_blocks);
         statistics_.tried_msgs += 1;
 
         if (!request_message) break;
 
+        if (target_peer && scheduler.may_have_block(*target_peer, request_message->min_block())) {
+            request_message->target_peer() = std::move(target_peer);
+        }
+
         request_message->execute(db_access_, header_chain_, body_sequence_, sentry_);
 
         statistics_.sent_msgs += request_message->sent_requests();
         statistics_.nack_msgs += request_message->nack_requests();
 
         if (request_message->nack_requests() > 0) break;
+        if (!request_message->packet_present()) break;  // nothing more to request
 
         sent_requests++;
     } while (sent_requests < max_nr_of_requests);
@@ -200,6 +242,31 @@ size_t BlockExchange::request_bodies(time_point_t tp, size_t max_nr_of_requests)
     return sent_requests;
 }
 
+size_t BlockExchange::request_stalled_bodies(time_point_t tp) {
+    if (!downloading_active_) return 0;
+    if (body_sequence_.has_completed()) return 0;
+
+    auto& scheduler = sentry_.peer_scheduler();
+    auto fastest_peer = scheduler.fastest_peer();
+    if (!fastest_peer) return 0;
+
+    auto request_message = body_sequence_.request_stalled_bodies(tp, scheduler.stall_threshold(*fastest_peer),
+                                                                 scheduler.batch_size(*fastest_peer));
+    if (!request_message) return 0;
+
+    if (scheduler.may_have_block(*fastest_peer, request_message->min_block())) {
+        request_message->target_peer() = std::move(fastest_peer);
+    }
+
+    request_message->execute(db_access_, header_chain_, body_sequence_, sentry_);
+
+    statistics_.sent_msgs += request_message->sent_requests();
+    statistics_.nack_msgs += request_message->nack_requests();
+    statistics_.speculative_msgs += request_message->sent_requests();
+
+    return request_message->sent_requests();
+}
+
 void BlockExchange::collect_headers() {
     if (!downloading_active_) return;
 
@@ -223,7 +290,11 @@ void BlockExchange::log_status() {
     static Network_Statistics prev_statistic{};
     auto now = std::chrono::system_clock::now();
 
-    log::Debug() << "BlockExchange         peers: " << sentry_.active_peers();
+    auto peers_summary = sentry_.peer_scheduler().summary();
+    statistics_.peers_rtt_ms = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(peers_summary.average_rtt).count());
+    statistics_.peers_bytes_per_sec = static_cast<uint64_t>(peers_summary.bytes_per_second);
+
+    log::Debug() << "BlockExchange         peers: " << sentry_.active_peers() << " (" << peers_summary << ")";
     log::Debug() << "BlockExchange      messages: " << std::setfill('_') << std::right
                  << "in-queue:" << std::setw(5) << messages_.size()
                  //<< ", peers:"     << std::setw(2) << sentry_.active_peers()
@@ -72,6 +72,8 @@ class BlockExchange final : public ActiveComponent {
     void receive_message(std::shared_ptr<InboundMessage> message);
     size_t request_headers(time_point_t tp, size_t max_requests);
     size_t request_bodies(time_point_t tp, size_t max_requests);
+    size_t request_stalled_bodies(time_point_t tp);
+    size_t free_request_slots(time_point_t tp);
     void collect_headers();
     void collect_bodies();
     void log_status();
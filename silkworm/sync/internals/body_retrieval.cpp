@@ -16,6 +16,8 @@
 
 #include "body_retrieval.hpp"
 
+#include <algorithm>
+
 #include <silkworm/core/types/block.hpp>
 
 namespace silkworm {
@@ -23,12 +25,16 @@ namespace silkworm {
 BodyRetrieval::BodyRetrieval(db::ROAccess db_access) : db_tx_{db_access.start_ro_tx()} {}
 
 std::vector<BlockBody> BodyRetrieval::recover(std::vector<Hash> request) {
+    // Never look further than the response limits allow, then resolve all the block numbers at once
+    request.resize(std::min(request.size(), static_cast<size_t>(2 * max_bodies_serve + 1)));
+    db::DataModel data_model{db_tx_};
+    const auto headers{data_model.read_headers(request)};
+
     std::vector<BlockBody> response;
     size_t bytes = 0;
     for (size_t i = 0; i < request.size(); ++i) {
-        Hash& hash = request[i];
         BlockBody body;
-        if (!db::read_body(db_tx_, hash, body)) {
+        if (!headers[i] || !data_model.read_body(request[i], headers[i]->number, body)) {
             continue;
         }
         response.push_back(body);
@@ -134,7 +134,7 @@ Penalty BodySequence::accept_new_block(const Block& block, const PeerId&) {
     return Penalty::NoPenalty;
 }
 
-auto BodySequence::request_bodies(time_point_t tp) -> std::shared_ptr<OutboundMessage> {
+auto BodySequence::request_bodies(time_point_t tp, size_t max_blocks) -> std::shared_ptr<OutboundGetBlockBodies> {
     if (tp - last_nack_ < SentryClient::kNoPeerDelay)
         return nullptr;
 
@@ -146,11 +146,11 @@ auto BodySequence::request_bodies(time_point_t tp) -> std::shared_ptr<OutboundMe
     auto& packet = body_request->packet();
     packet.requestId = Singleton<RandomNumber>::instance().generate_one();
 
-    auto penalizations = renew_stale_requests(packet, min_block, tp, timeout);
+    auto penalizations = renew_stale_requests(packet, min_block, tp, timeout, max_blocks);
 
-    if (packet.request.size() < kMaxBlocksPerMessage &&  // not full yet
-        requests() < kMaxInMemoryRequests) {             // not too many requests in memory
-        make_new_requests(packet, min_block, tp, timeout);
+    if (packet.request.size() < max_blocks &&  // not full yet
+        requests() < kMaxInMemoryRequests) {   // not too many requests in memory
+        make_new_requests(packet, min_block, tp, timeout, max_blocks);
     }
 
     statistics_.requested_items += packet.request.size();
@@ -172,7 +172,8 @@ auto BodySequence::request_bodies(time_point_t tp) -> std::shared_ptr<OutboundMe
 
 //! Re-evaluate past (stale) requests
 auto BodySequence::renew_stale_requests(GetBlockBodiesPacket66& packet, BlockNum& min_block,
-                                        time_point_t tp, seconds_t timeout) -> std::vector<PeerPenalization> {
+                                        time_point_t tp, seconds_t timeout, size_t max_blocks)
+    -> std::vector<PeerPenalization> {
     std::vector<PeerPenalization> penalizations;
     BlockNum start_block = std::numeric_limits<BlockNum>::max();
     size_t count = 0;
@@ -187,6 +188,7 @@ auto BodySequence::renew_stale_requests(GetBlockBodiesPacket66& packet, BlockNum
             packet.request.push_back(past_request.block_hash);
             past_request.request_time = tp;
             past_request.request_id = packet.requestId;
+            past_request.speculated = false;
 
             min_block = std::max(min_block, past_request.block_height);
 
@@ -199,7 +201,7 @@ auto BodySequence::renew_stale_requests(GetBlockBodiesPacket66& packet, BlockNum
             //            << ", hash= " << past_request.block_hash;
         }
 
-        if (packet.request.size() >= kMaxBlocksPerMessage) break;
+        if (packet.request.size() >= max_blocks) break;
     }
 
     if (count) {
@@ -210,7 +212,7 @@ auto BodySequence::renew_stale_requests(GetBlockBodiesPacket66& packet, BlockNum
 }
 
 void BodySequence::make_new_requests(GetBlockBodiesPacket66& packet, BlockNum& min_block,
-                                     time_point_t tp, seconds_t) {
+                                     time_point_t tp, seconds_t, size_t max_blocks) {
     BlockNum start_block = std::numeric_limits<BlockNum>::max();
     size_t count = 0;
 
@@ -235,7 +237,7 @@ void BodySequence::make_new_requests(GetBlockBodiesPacket66& packet, BlockNum& m
 
         new_request.request_id = packet.requestId;
 
-        if (packet.request.size() >= kMaxBlocksPerMessage) break;
+        if (packet.request.size() >= max_blocks) break;
     }
 
     if (count) {
@@ -243,6 +245,47 @@ void BodySequence::make_new_requests(GetBlockBodiesPacket66& packet, BlockNum& m
     }
 }
 
+//! Re-issue requests that are taking too long, only when there is nothing new to request (i.e. in the download tail)
+//! so that a slow peer does not hold back the whole batch; the first response wins, the other is a duplicate
+auto BodySequence::request_stalled_bodies(time_point_t tp, duration_t stalled_after, size_t max_blocks)
+    -> std::shared_ptr<OutboundGetBlockBodies> {
+    bool all_requested = std::all_of(body_requests_.begin(), body_requests_.end(), [](const auto& br) {
+        return br.second.request_id != 0 || br.second.ready;
+    });
+    if (!all_requested) return nullptr;
+
+    auto body_request = std::make_shared<OutboundGetBlockBodies>();
+    auto& packet = body_request->packet();
+    packet.requestId = Singleton<RandomNumber>::instance().generate_one();
+    BlockNum min_block{0};
+
+    for (auto& br : body_requests_) {
+        BodyRequest& past_request = br.second;
+
+        if (past_request.ready || past_request.speculated || tp - past_request.request_time < stalled_after)
+            continue;
+
+        packet.request.push_back(past_request.block_hash);
+        past_request.request_time = tp;
+        past_request.request_id = packet.requestId;
+        past_request.speculated = true;
+
+        min_block = std::max(min_block, past_request.block_height);
+
+        if (packet.request.size() >= max_blocks) break;
+    }
+
+    if (packet.request.empty()) return nullptr;
+
+    SILK_TRACE << "BodySequence: re-issuing " << packet.request.size() << " stalled body requests";
+
+    statistics_.requested_items += packet.request.size();
+    statistics_.speculated_items += packet.request.size();
+
+    body_request->min_block() = min_block;
+    return body_request;
+}
+
 //! Save headers of witch it has to download bodies
 void BodySequence::download_bodies(const Headers& headers) {
     for (auto header : headers) {
@@ -291,6 +334,15 @@ void BodySequence::request_nack(const GetBlockBodiesPacket66& packet) {
     statistics_.requested_items -= packet.request.size();
 }
 
+void BodySequence::request_expired(uint64_t request_id) {
+    seconds_t timeout = SentryClient::kRequestDeadline;
+    for (auto& br : body_requests_) {
+        BodyRequest& past_request = br.second;
+        if (past_request.request_id == request_id && !past_request.ready)
+            past_request.request_time -= timeout;  // make it stale so that it will be renewed
+    }
+}
+
 bool BodySequence::is_valid_body(const BlockHeader& header, const BlockBody& body) {
     if (header.ommers_hash != protocol::compute_ommers_hash(body)) {
         return false;
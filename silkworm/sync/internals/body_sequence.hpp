@@ -63,11 +63,19 @@ class BodySequence {
     void download_bodies(const Headers& headers);
 
     //! core functionalities: trigger the internal algorithms to decide what bodies we miss
-    auto request_bodies(time_point_t tp) -> std::shared_ptr<OutboundMessage>;
+    auto request_bodies(time_point_t tp, size_t max_blocks = kMaxBlocksPerMessage)
+        -> std::shared_ptr<OutboundGetBlockBodies>;
+
+    //! core functionalities: near the end of the download, re-issue requests pending for too long
+    auto request_stalled_bodies(time_point_t tp, duration_t stalled_after, size_t max_blocks = kMaxBlocksPerMessage)
+        -> std::shared_ptr<OutboundGetBlockBodies>;
 
     //! it needs to know if the request issued was not delivered
     void request_nack(const GetBlockBodiesPacket66&);
 
+    //! it needs to know if the request issued was not answered in time
+    void request_expired(uint64_t request_id);
+
     //! core functionalities: process received bodies
     Penalty accept_requested_bodies(BlockBodiesPacket66&, const PeerId&);
 
@@ -96,9 +104,9 @@ class BodySequence {
 
   protected:
     using MinBlock = BlockNum;
-    auto renew_stale_requests(GetBlockBodiesPacket66&, MinBlock&, time_point_t, seconds_t timeout)
+    auto renew_stale_requests(GetBlockBodiesPacket66&, MinBlock&, time_point_t, seconds_t timeout, size_t max_blocks)
         -> std::vector<PeerPenalization>;
-    void make_new_requests(GetBlockBodiesPacket66&, MinBlock&, time_point_t, seconds_t timeout);
+    void make_new_requests(GetBlockBodiesPacket66&, MinBlock&, time_point_t, seconds_t timeout, size_t max_blocks);
 
     static bool is_valid_body(const BlockHeader&, const BlockBody&);
 
@@ -111,6 +119,7 @@ class BodySequence {
         time_point_t request_time;
         bool ready{false};
         bool to_announce{false};
+        bool speculated{false};  // already re-issued to another peer while pending
     };
 
     bool fulfill_from_announcements(BodyRequest&);
@@ -479,6 +479,84 @@ TEST_CASE("body downloading", "[silkworm][sync][BodySequence]") {
         REQUIRE(statistic.rejected_items() == 0);
     }
 
+    SECTION("renewing expired requests") {
+        auto message1 = bs.request_bodies(tp);
+        REQUIRE(message1 != nullptr);
+        REQUIRE(message1->packet().request.size() == 1);
+        uint64_t request_id1 = message1->packet().requestId;
+
+        bs.request_expired(request_id1 + 1);  // unrelated request, nothing to renew
+        auto message2 = bs.request_bodies(tp);
+        REQUIRE(message2 != nullptr);
+        REQUIRE(!message2->packet_present());
+
+        bs.request_expired(request_id1);  // renewed immediately, without waiting the request deadline
+        auto message3 = bs.request_bodies(tp);
+        REQUIRE(message3 != nullptr);
+        REQUIRE(message3->packet().request.size() == 1);
+        REQUIRE(message3->packet().requestId != request_id1);
+
+        auto& statistic = bs.statistics();
+        REQUIRE(statistic.requested_items == 2);
+    }
+
+    SECTION("limiting the number of bodies per request") {
+        BlockHeader header2;
+        header2.number = 2;
+        header2.parent_hash = header1_hash;
+        bs.download_bodies({make_shared<BlockHeader>(header2)});
+
+        auto message1 = bs.request_bodies(tp, 1);
+        REQUIRE(message1 != nullptr);
+        REQUIRE(message1->packet().request.size() == 1);
+        REQUIRE(message1->packet().request[0] == header1_hash);
+
+        auto message2 = bs.request_bodies(tp, 1);
+        REQUIRE(message2 != nullptr);
+        REQUIRE(message2->packet().request.size() == 1);
+        REQUIRE(message2->packet().request[0] == header2.hash());
+    }
+
+    SECTION("re-issuing stalled requests") {
+        BlockHeader header2;
+        header2.number = 2;
+        header2.parent_hash = header1_hash;
+        bs.download_bodies({make_shared<BlockHeader>(header2)});
+
+        auto message1 = bs.request_bodies(tp, 1);
+        REQUIRE(message1->packet().request.size() == 1);
+
+        // header 2 not yet requested, no speculation
+        REQUIRE(bs.request_stalled_bodies(tp + 2s, 1s) == nullptr);
+
+        auto message2 = bs.request_bodies(tp + 1s, 1);
+        REQUIRE(message2->packet().request.size() == 1);
+
+        // only the request pending for enough time is re-issued
+        auto stalled = bs.request_stalled_bodies(tp + 1500ms, 1s);
+        REQUIRE(stalled != nullptr);
+        REQUIRE(stalled->packet().request.size() == 1);
+        REQUIRE(stalled->packet().request[0] == header1_hash);
+        REQUIRE(stalled->min_block() == 1);
+
+        // and only once
+        REQUIRE(bs.request_stalled_bodies(tp + 5s, 1s) != nullptr);  // header 2 now stalled
+        REQUIRE(bs.request_stalled_bodies(tp + 10s, 1s) == nullptr);
+
+        // the original response, even if late, is accepted
+        BlockBodiesPacket66 response_packet;
+        response_packet.requestId = message1->packet().requestId;
+        response_packet.request.push_back(block1);
+        PeerId peer_id{byte_ptr_cast("1")};
+        bs.accept_requested_bodies(response_packet, peer_id);
+        REQUIRE(bs.body_requests_.find(header1.number)->second.ready);
+
+        auto& statistic = bs.statistics();
+        REQUIRE(statistic.speculated_items == 2);
+        REQUIRE(statistic.requested_items == 4);
+        REQUIRE(statistic.accepted_items == 1);
+    }
+
     SECTION("accepting and using an announced block") {
         // accepting announcement
         PeerId peer_id{byte_ptr_cast("1")};
@@ -0,0 +1,237 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "peer_scheduler.hpp"
+
+#include <algorithm>
+#include <iomanip>
+
+namespace silkworm {
+
+using namespace std::chrono;
+
+static double smooth(double average, double sample, bool first_sample) {
+    return first_sample ? sample : average + PeerScheduler::kSmoothingFactor * (sample - average);
+}
+
+Peer_Statistics* PeerScheduler::peer_stats(const PeerId& peer) {
+    const auto it = peers_.find(peer);
+    return it != peers_.end() ? &it->second : nullptr;
+}
+
+duration_t PeerScheduler::request_timeout(const Peer_Statistics& stats) {
+    if (!stats.measured()) return kMaxRequestTimeout;
+    return std::clamp<duration_t>(stats.rtt * kTimeoutRttMultiplier, kMinRequestTimeout, kMaxRequestTimeout);
+}
+
+void PeerScheduler::add_peer(const PeerId& peer) {
+    std::scoped_lock lock{mutex_};
+    auto [it, inserted] = peers_.try_emplace(peer);
+    if (inserted) {
+        it->second.batch_size = kInitialBatchSize;
+    }
+}
+
+void PeerScheduler::remove_peer(const PeerId& peer) {
+    std::scoped_lock lock{mutex_};
+    peers_.erase(peer);
+    std::erase_if(pending_requests_, [&](const auto& entry) { return entry.second.peer == peer; });
+}
+
+void PeerScheduler::update_max_block(const PeerId& peer, BlockNum block_num) {
+    std::scoped_lock lock{mutex_};
+    // Messages still queued for a removed peer must not bring it back
+    auto* stats = peer_stats(peer);
+    if (!stats) return;
+    stats->max_block = std::max(stats->max_block, block_num);
+}
+
+void PeerScheduler::request_sent(const PeerId& peer, uint64_t request_id, time_point_t tp) {
+    std::scoped_lock lock{mutex_};
+    auto* stats = peer_stats(peer);
+    if (!stats) return;
+    stats->in_flight++;
+    pending_requests_.emplace(request_id, PendingRequest{peer, tp, tp + request_timeout(*stats)});
+}
+
+void PeerScheduler::response_received(const PeerId& peer, uint64_t request_id, size_t bytes, size_t items,
+                                      time_point_t tp) {
+    std::scoped_lock lock{mutex_};
+    auto* stats_ptr = peer_stats(peer);
+    if (!stats_ptr) return;
+    auto& stats = *stats_ptr;
+    stats.received_bytes += bytes;
+
+    auto [first, last] = pending_requests_.equal_range(request_id);
+    auto pending = std::find_if(first, last, [&](const auto& entry) { return entry.second.peer == peer; });
+    if (pending == last) return;  // late response to an expired request or not requested: no timing available
+
+    const duration_t rtt = std::max<duration_t>(tp - pending->second.sent, milliseconds(1));
+    pending_requests_.erase(pending);
+    stats.in_flight--;
+
+    const bool first_sample = !stats.measured();
+    const double rtt_seconds = duration<double>(rtt).count();
+    stats.rtt = first_sample ? rtt : stats.rtt + duration_cast<duration_t>(kSmoothingFactor * (rtt - stats.rtt));
+    stats.bytes_per_second = smooth(stats.bytes_per_second, static_cast<double>(bytes) / rtt_seconds, first_sample);
+    stats.items_per_second = smooth(stats.items_per_second, static_cast<double>(items) / rtt_seconds, first_sample);
+    stats.responses++;
+
+    if (items == 0) {
+        // Empty answers (e.g. the peer has not got the blocks) are failures that just come quickly
+        stats.failure_rate = smooth(stats.failure_rate, 1.0, false);
+        return;
+    }
+    stats.failure_rate = smooth(stats.failure_rate, 0.0, false);
+    stats.max_in_flight = std::min(stats.max_in_flight + 1, kMaxInFlight);
+
+    // Keep the expected response time around the target, growing at most twofold at once (like a slow start)
+    const auto target_items = static_cast<size_t>(stats.items_per_second * duration<double>(kTargetResponseTime).count());
+    stats.batch_size = std::clamp(std::min(target_items, 2 * stats.batch_size), kMinBatchSize, kMaxBatchSize);
+}
+
+std::vector<uint64_t> PeerScheduler::expire_requests(time_point_t tp) {
+    std::scoped_lock lock{mutex_};
+    std::vector<uint64_t> expired_ids;
+    for (auto it = pending_requests_.begin(); it != pending_requests_.end();) {
+        const auto& [request_id, pending] = *it;
+        if (tp < pending.deadline) {
+            ++it;
+            continue;
+        }
+        if (auto* stats = peer_stats(pending.peer)) {
+            stats->in_flight--;
+            stats->timeouts++;
+            stats->failure_rate = smooth(stats->failure_rate, 1.0, false);
+            stats->max_in_flight = std::max<size_t>(stats->max_in_flight / 2, 1);
+            stats->batch_size = std::max(stats->batch_size / 2, kMinBatchSize);
+        }
+        expired_ids.push_back(request_id);
+        it = pending_requests_.erase(it);
+    }
+    return expired_ids;
+}
+
+std::optional<PeerId> PeerScheduler::select_peer() const {
+    std::scoped_lock lock{mutex_};
+    const PeerId* selected{nullptr};
+    double selected_score{0};
+    for (const auto& [peer, stats] : peers_) {
+        if (!has_free_slot(stats)) continue;
+        // Probe the new peers first, their single slot bounds the risk; peers that only let requests expire are
+        // probed and score zero, so they do not hold the next requests hostage
+        if (!stats.probed()) return peer;
+        // Expected rate per request queued at the peer: slow peers keep getting work but proportionally less
+        const double score = stats.score() / static_cast<double>(stats.in_flight + 1);
+        if (!selected || score > selected_score) {
+            selected = &peer;
+            selected_score = score;
+        }
+    }
+    if (!selected) return std::nullopt;
+    return *selected;
+}
+
+std::optional<PeerId> PeerScheduler::fastest_peer() const {
+    std::scoped_lock lock{mutex_};
+    const PeerId* fastest{nullptr};
+    double fastest_score{0};
+    for (const auto& [peer, stats] : peers_) {
+        if (!stats.measured() || !has_free_slot(stats)) continue;
+        if (!fastest || stats.score() > fastest_score) {
+            fastest = &peer;
+            fastest_score = stats.score();
+        }
+    }
+    if (!fastest) return std::nullopt;
+    return *fastest;
+}
+
+bool PeerScheduler::may_have_block(const PeerId& peer, BlockNum block_num) const {
+    std::scoped_lock lock{mutex_};
+    const auto it = peers_.find(peer);
+    if (it == peers_.end()) return false;
+    return it->second.max_block == 0 || it->second.max_block >= block_num;  // unknown height gets the benefit of doubt
+}
+
+size_t PeerScheduler::batch_size(const PeerId& peer) const {
+    std::scoped_lock lock{mutex_};
+    const auto it = peers_.find(peer);
+    return it != peers_.end() ? it->second.batch_size : kInitialBatchSize;
+}
+
+duration_t PeerScheduler::stall_threshold(const PeerId& peer) const {
+    std::scoped_lock lock{mutex_};
+    const auto it = peers_.find(peer);
+    if (it == peers_.end() || !it->second.measured()) return kMaxRequestTimeout;
+    return std::clamp<duration_t>(2 * it->second.rtt, kMinStallTime, kMinRequestTimeout);
+}
+
+size_t PeerScheduler::peers() const {
+    std::scoped_lock lock{mutex_};
+    return peers_.size();
+}
+
+size_t PeerScheduler::free_slots() const {
+    std::scoped_lock lock{mutex_};
+    size_t slots{0};
+    for (const auto& [_, stats] : peers_) {
+        if (has_free_slot(stats)) slots += stats.max_in_flight - stats.in_flight;
+    }
+    return slots;
+}
+
+size_t PeerScheduler::in_flight() const {
+    std::scoped_lock lock{mutex_};
+    return pending_requests_.size();
+}
+
+std::optional<Peer_Statistics> PeerScheduler::statistics(const PeerId& peer) const {
+    std::scoped_lock lock{mutex_};
+    const auto it = peers_.find(peer);
+    if (it == peers_.end()) return std::nullopt;
+    return it->second;
+}
+
+PeerScheduler::Summary PeerScheduler::summary() const {
+    std::scoped_lock lock{mutex_};
+    Summary summary{.peers = peers_.size()};
+    duration_t total_rtt{};
+    size_t measured_peers{0};
+    for (const auto& [_, stats] : peers_) {
+        summary.bytes_per_second += stats.bytes_per_second;
+        summary.timeouts += stats.timeouts;
+        if (stats.measured()) {
+            total_rtt += stats.rtt;
+            measured_peers++;
+        }
+    }
+    if (measured_peers > 0) {
+        summary.average_rtt = total_rtt / static_cast<duration_t::rep>(measured_peers);
+    }
+    return summary;
+}
+
+std::ostream& operator<<(std::ostream& os, const PeerScheduler::Summary& summary) {
+    os << std::setfill('_') << std::right
+       << "peers=" << std::setw(3) << summary.peers << ", "
+       << "avg-rtt(ms)=" << std::setw(5) << duration_cast<milliseconds>(summary.average_rtt).count() << ", "
+       << "rate(kB/s)=" << std::setw(6) << static_cast<uint64_t>(summary.bytes_per_second / 1000) << ", "
+       << "timeouts=" << summary.timeouts;
+    return os;
+}
+
+}  // namespace silkworm
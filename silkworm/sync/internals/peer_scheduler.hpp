@@ -0,0 +1,127 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <vector>
+
+#include "types.hpp"
+
+namespace silkworm {
+
+//! The download performance of one peer, estimated from the timing of its responses
+struct Peer_Statistics {
+    duration_t rtt{};            // smoothed round-trip time of the responses
+    double bytes_per_second{0};  // smoothed download rate
+    double items_per_second{0};  // smoothed rate of headers or bodies served
+    double failure_rate{0};      // smoothed fraction of requests expired or answered with nothing
+    size_t in_flight{0};         // requests sent and neither answered nor expired yet
+    size_t max_in_flight{1};     // adaptive in-flight depth
+    size_t batch_size{0};        // adaptive number of bodies per request
+    BlockNum max_block{0};       // highest block the peer is known to have (zero if unknown)
+    uint64_t responses{0};       // number of responses received
+    uint64_t timeouts{0};        // number of requests expired without response
+    uint64_t received_bytes{0};  // total size of the responses received
+
+    [[nodiscard]] bool measured() const { return responses > 0; }
+
+    //! Whether any request of the peer has ended yet, either answered or expired
+    [[nodiscard]] bool probed() const { return responses > 0 || timeouts > 0; }
+
+    //! The expected serving rate, i.e. the items per second discounted by the failure rate
+    [[nodiscard]] double score() const { return items_per_second * (1.0 - failure_rate); }
+};
+
+/** PeerScheduler decides which peer should serve the next header or body request.
+ *  It tracks each request sent to a peer until the matching response arrives or the request expires, so that:
+ *    - RTT, download rate and failure rate are estimated for each peer (exponentially weighted moving averages),
+ *    - in-flight depth grows additively on responses and halves on timeouts (AIMD),
+ *    - body batch size follows the peer rate to keep responses around a target time,
+ *    - request deadlines follow the peer RTT instead of a fixed timeout,
+ *    - requests go to the best-scoring peer with a free slot, slow peers receiving proportionally less work.
+ *  It is thread safe: requests and responses are tracked by the block exchange, peer events by the sentry client.
+ */
+class PeerScheduler {
+  public:
+    // adaptive tuning parameters
+    static constexpr double kSmoothingFactor{0.25};
+    static constexpr size_t kMinBatchSize{8};
+    static constexpr size_t kInitialBatchSize{32};
+    static constexpr size_t kMaxBatchSize{128};  // go-ethereum client acceptance limit
+    static constexpr size_t kMaxInFlight{8};
+    static constexpr milliseconds_t kTargetResponseTime{std::chrono::milliseconds(2000)};
+    static constexpr milliseconds_t kMinStallTime{std::chrono::milliseconds(1000)};
+    static constexpr seconds_t kMinRequestTimeout{std::chrono::seconds(5)};
+    static constexpr seconds_t kMaxRequestTimeout{std::chrono::seconds(30)};  // same as the remote sentry deadline
+    static constexpr int kTimeoutRttMultiplier{4};
+
+    //! peer tracking
+    void add_peer(const PeerId& peer);
+    void remove_peer(const PeerId& peer);
+    void update_max_block(const PeerId& peer, BlockNum block_num);
+
+    //! request tracking
+    void request_sent(const PeerId& peer, uint64_t request_id, time_point_t tp);
+    void response_received(const PeerId& peer, uint64_t request_id, size_t bytes, size_t items, time_point_t tp);
+
+    //! expire the requests whose deadline has passed, returning their ids to be re-issued
+    std::vector<uint64_t> expire_requests(time_point_t tp);
+
+    //! scheduling
+    [[nodiscard]] std::optional<PeerId> select_peer() const;   // unprobed peers first, then best score per slot
+    [[nodiscard]] std::optional<PeerId> fastest_peer() const;  // best-scoring measured peer having a free slot
+    [[nodiscard]] bool may_have_block(const PeerId& peer, BlockNum block_num) const;
+    [[nodiscard]] size_t batch_size(const PeerId& peer) const;
+    [[nodiscard]] duration_t stall_threshold(const PeerId& peer) const;  // age of requests worth re-issuing to peer
+
+    //! minor functionalities
+    [[nodiscard]] size_t peers() const;
+    [[nodiscard]] size_t free_slots() const;
+    [[nodiscard]] size_t in_flight() const;
+    [[nodiscard]] std::optional<Peer_Statistics> statistics(const PeerId& peer) const;
+
+    struct Summary {
+        size_t peers{0};
+        duration_t average_rtt{};    // over the measured peers
+        double bytes_per_second{0};  // aggregated over all the peers
+        uint64_t timeouts{0};
+    };
+    [[nodiscard]] Summary summary() const;
+
+  private:
+    struct PendingRequest {
+        PeerId peer;
+        time_point_t sent;
+        time_point_t deadline;
+    };
+
+    Peer_Statistics* peer_stats(const PeerId& peer);  // nullptr if the peer is not tracked (e.g. already removed)
+    [[nodiscard]] static duration_t request_timeout(const Peer_Statistics& stats);
+    [[nodiscard]] static bool has_free_slot(const Peer_Statistics& stats) { return stats.in_flight < stats.max_in_flight; }
+
+    mutable std::mutex mutex_;
+    std::map<PeerId, Peer_Statistics> peers_;
+    std::multimap<uint64_t, PendingRequest> pending_requests_;  // by request id, one entry per peer receiving it
+};
+
+std::ostream& operator<<(std::ostream& os, const PeerScheduler::Summary& summary);
+
+}  // namespace silkworm
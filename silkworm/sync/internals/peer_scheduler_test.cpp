@@ -0,0 +1,171 @@
+/*
+   Copyright 2023 The Silkworm Authors
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#include "peer_scheduler.hpp"
+
+#include <catch2/catch.hpp>
+
+namespace silkworm {
+
+TEST_CASE("PeerScheduler", "[silkworm][sync][PeerScheduler]") {
+    using namespace std::chrono_literals;
+
+    const PeerId fast_peer{0x01};
+    const PeerId slow_peer{0x02};
+    const time_point_t tp = std::chrono::system_clock::now();
+
+    PeerScheduler scheduler;
+    scheduler.add_peer(fast_peer);
+    scheduler.add_peer(slow_peer);
+
+    SECTION("new peers get one slot and the initial batch size") {
+        CHECK(scheduler.peers() == 2);
+        CHECK(scheduler.free_slots() == 2);
+        CHECK(scheduler.batch_size(fast_peer) == PeerScheduler::kInitialBatchSize);
+        CHECK(scheduler.select_peer().has_value());
+        CHECK(!scheduler.fastest_peer().has_value());  // nobody measured yet
+    }
+
+    SECTION("responses update rates, depth and batch size") {
+        scheduler.request_sent(fast_peer, 1, tp);
+        CHECK(scheduler.in_flight() == 1);
+        scheduler.response_received(fast_peer, 1, 100'000, 32, tp + 100ms);
+        CHECK(scheduler.in_flight() == 0);
+
+        auto stats = scheduler.statistics(fast_peer);
+        REQUIRE(stats);
+        CHECK(stats->rtt == 100ms);
+        CHECK(stats->bytes_per_second == Approx(1'000'000));
+        CHECK(stats->items_per_second == Approx(320));
+        CHECK(stats->max_in_flight == 2);
+        CHECK(stats->batch_size == 2 * PeerScheduler::kInitialBatchSize);  // growth is bounded to twofold
+
+        scheduler.request_sent(fast_peer, 2, tp + 1s);
+        scheduler.response_received(fast_peer, 2, 100'000, 64, tp + 1s + 100ms);
+        stats = scheduler.statistics(fast_peer);
+        CHECK(stats->batch_size == PeerScheduler::kMaxBatchSize);
+        CHECK(stats->max_in_flight == 3);
+    }
+
+    SECTION("empty responses count as failures") {
+        scheduler.request_sent(fast_peer, 1, tp);
+        scheduler.response_received(fast_peer, 1, 10, 0, tp + 100ms);
+        auto stats = scheduler.statistics(fast_peer);
+        CHECK(stats->failure_rate > 0);
+        CHECK(stats->max_in_flight == 1);
+    }
+
+    SECTION("unmatched responses are not timed") {
+        scheduler.response_received(fast_peer, 42, 1'000, 10, tp);
+        auto stats = scheduler.statistics(fast_peer);
+        CHECK(!stats->measured());
+        CHECK(stats->received_bytes == 1'000);
+    }
+
+    SECTION("expired requests shrink the peer window") {
+        scheduler.request_sent(fast_peer, 1, tp);
+        scheduler.response_received(fast_peer, 1, 100'000, 32, tp + 100ms);
+        scheduler.request_sent(fast_peer, 2, tp + 1s);
+        scheduler.request_sent(fast_peer, 3, tp + 1s);
+
+        // deadline follows the rtt: 4 * 100ms is below the min timeout
+        CHECK(scheduler.expire_requests(tp + 1s + PeerScheduler::kMinRequestTimeout - 1ms).empty());
+        auto expired = scheduler.expire_requests(tp + 1s + PeerScheduler::kMinRequestTimeout);
+        CHECK(expired == std::vector<uint64_t>{2, 3});
+        CHECK(scheduler.in_flight() == 0);
+
+        auto stats = scheduler.statistics(fast_peer);
+        CHECK(stats->timeouts == 2);
+        CHECK(stats->max_in_flight == 1);
+        CHECK(stats->batch_size == PeerScheduler::kInitialBatchSize / 2);
+        CHECK(stats->failure_rate > 0);
+
+        // the late response is accounted as bytes only
+        scheduler.response_received(fast_peer, 2, 1'000, 10, tp + 10s);
+        CHECK(scheduler.statistics(fast_peer)->responses == 1);
+    }
+
+    SECTION("selection prefers unmeasured peers, then faster ones") {
+        scheduler.request_sent(fast_peer, 1, tp);
+        scheduler.response_received(fast_peer, 1, 100'000, 32, tp + 100ms);
+        CHECK(scheduler.select_peer() == slow_peer);  // not measured yet
+
+        scheduler.request_sent(slow_peer, 2, tp);
+        scheduler.response_received(slow_peer, 2, 100'000, 32, tp + 2s);
+        CHECK(scheduler.select_peer() == fast_peer);
+        CHECK(scheduler.fastest_peer() == fast_peer);
+
+        // saturate the fast peer, work then goes to the slow one
+        scheduler.request_sent(fast_peer, 3, tp + 3s);
+        scheduler.request_sent(fast_peer, 4, tp + 3s);
+        CHECK(scheduler.select_peer() == slow_peer);
+        CHECK(scheduler.fastest_peer() == slow_peer);
+
+        scheduler.request_sent(slow_peer, 5, tp + 3s);
+        scheduler.request_sent(slow_peer, 6, tp + 3s);
+        CHECK(scheduler.free_slots() == 0);
+        CHECK(!scheduler.select_peer());
+    }
+
+    SECTION("peers never answering are not probed again first") {
+        scheduler.request_sent(slow_peer, 1, tp);
+        CHECK(scheduler.expire_requests(tp + PeerScheduler::kMaxRequestTimeout) == std::vector<uint64_t>{1});
+        scheduler.request_sent(fast_peer, 2, tp);
+        scheduler.response_received(fast_peer, 2, 100'000, 32, tp + 100ms);
+
+        auto stats = scheduler.statistics(slow_peer);
+        CHECK(!stats->measured());
+        CHECK(stats->probed());
+        CHECK(scheduler.select_peer() == fast_peer);
+    }
+
+    SECTION("peer height and removal") {
+        CHECK(scheduler.may_have_block(fast_peer, 1'000));  // unknown height
+        scheduler.update_max_block(fast_peer, 100);
+        CHECK(scheduler.may_have_block(fast_peer, 100));
+        CHECK(!scheduler.may_have_block(fast_peer, 101));
+
+        scheduler.request_sent(fast_peer, 1, tp);
+        scheduler.remove_peer(fast_peer);
+        CHECK(scheduler.peers() == 1);
+        CHECK(scheduler.in_flight() == 0);
+        CHECK(!scheduler.may_have_block(fast_peer, 1));
+
+        // late messages of a removed peer do not resurrect it
+        scheduler.update_max_block(fast_peer, 200);
+        scheduler.response_received(fast_peer, 1, 1'000, 10, tp + 100ms);
+        scheduler.request_sent(fast_peer, 2, tp);
+        CHECK(scheduler.peers() == 1);
+        CHECK(scheduler.in_flight() == 0);
+        CHECK(!scheduler.statistics(fast_peer));
+        CHECK(scheduler.select_peer() == slow_peer);
+    }
+
+    SECTION("summary") {
+        scheduler.request_sent(fast_peer, 1, tp);
+        scheduler.response_received(fast_peer, 1, 100'000, 32, tp + 100ms);
+        scheduler.request_sent(slow_peer, 2, tp);
+        scheduler.response_received(slow_peer, 2, 100'000, 32, tp + 300ms);
+
+        auto summary = scheduler.summary();
+        CHECK(summary.peers == 2);
+        CHECK(summary.average_rtt == 200ms);
+        CHECK(summary.bytes_per_second == Approx(1'000'000 + 100'000.0 / 0.3));
+        CHECK(summary.timeouts == 0);
+    }
+}
+
+}  // namespace silkworm
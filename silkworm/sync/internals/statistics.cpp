@@ -32,6 +32,7 @@ std::ostream& operator<<(std::ostream& os, const Download_Statistics& stats) {
        << "req=" << std::setw(7) << std::right << stats.requested_items << ", "
        << "rec=" << std::setw(7) << std::right << stats.received_items << " (" << perc_received << "%) -> "
        << "acc=" << std::setw(7) << std::right << stats.accepted_items << " (" << perc_accepted << "%), "
+       << "spe=" << stats.speculated_items << ", "
        << "rej=" << std::setw(7) << std::right << stats.rejected_items() << " (" << perc_rejected << "%";
 
     os << ", reasons: "
@@ -61,6 +62,10 @@ void Network_Statistics::inaccurate_reset() {
     processed_msgs = 0;
     nack_msgs = 0;
     malformed_msgs = 0;
+    timeout_msgs = 0;
+    speculative_msgs = 0;
+    peers_rtt_ms = 0;
+    peers_bytes_per_sec = 0;
 }
 
 void Network_Statistics::inaccurate_copy(const Network_Statistics& other) {
@@ -74,6 +79,10 @@ void Network_Statistics::inaccurate_copy(const Network_Statistics& other) {
     processed_msgs = other.processed_msgs.load();
     nack_msgs = other.nack_msgs.load();
     malformed_msgs = other.malformed_msgs.load();
+    timeout_msgs = other.timeout_msgs.load();
+    speculative_msgs = other.speculative_msgs.load();
+    peers_rtt_ms = other.peers_rtt_ms.load();
+    peers_bytes_per_sec = other.peers_bytes_per_sec.load();
 }
 
 #define SHOW(LABEL, VARIABLE, FACTOR)                                                     \
@@ -99,6 +108,11 @@ std::ostream& operator<<(std::ostream& os, std::tuple<Network_Statistics&, Netwo
     SHOW("nonsolic", nonsolic_msgs, 1);
     SHOW("internal", internal_msgs, 1);
     SHOW("malformed", malformed_msgs, 1);
+    SHOW("timeout", timeout_msgs, 1);
+    SHOW("speculative", speculative_msgs, 1);
+
+    os << ", peers-rtt(ms):" << std::setw(5) << curr.peers_rtt_ms.load()
+       << ", peers-rate(kB/s):" << std::setw(5) << curr.peers_bytes_per_sec.load() / 1000;
 
     os << " [last_update=" << elapsed.count() << "s]";
 
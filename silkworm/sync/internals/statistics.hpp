@@ -32,6 +32,7 @@ struct Download_Statistics {
     uint64_t requested_items{0};
     uint64_t received_items{0};
     uint64_t accepted_items{0};
+    uint64_t speculated_items{0};  // requested again while still pending
     uint64_t rejected_items() const { return received_items - accepted_items; }
 
     struct Reject_Causes {
@@ -54,6 +55,12 @@ struct Network_Statistics {
     std::atomic<uint64_t> processed_msgs{0};
     std::atomic<uint64_t> nack_msgs{0};
     std::atomic<uint64_t> malformed_msgs{0};
+    std::atomic<uint64_t> timeout_msgs{0};
+    std::atomic<uint64_t> speculative_msgs{0};
+
+    // peer performance as estimated by the peer scheduler
+    std::atomic<uint64_t> peers_rtt_ms{0};
+    std::atomic<uint64_t> peers_bytes_per_sec{0};
 
     void inaccurate_reset();
     void inaccurate_copy(const Network_Statistics&);
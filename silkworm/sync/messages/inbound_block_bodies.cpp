@@ -24,7 +24,7 @@
 namespace silkworm {
 
 InboundBlockBodies::InboundBlockBodies(ByteView data, PeerId peer_id)
-    : peerId_(std::move(peer_id)) {
+    : peerId_(std::move(peer_id)), received_at_(std::chrono::system_clock::now()), data_size_(data.size()) {
     success_or_throw(rlp::decode(data, packet_));
     SILK_TRACE << "Received message " << *this;
 }
@@ -32,6 +32,8 @@ InboundBlockBodies::InboundBlockBodies(ByteView data, PeerId peer_id)
 void InboundBlockBodies::execute(db::ROAccess, HeaderChain&, BodySequence& bs, SentryClient& sentry) {
     SILK_TRACE << "Processing message " << *this;
 
+    sentry.peer_scheduler().response_received(peerId_, packet_.requestId, data_size_, packet_.request.size(), received_at_);
+
     Penalty penalty = bs.accept_requested_bodies(packet_, peerId_);
 
     if (penalty != Penalty::NoPenalty) {
@@ -36,6 +36,8 @@ class InboundBlockBodies : public InboundMessage {
   private:
     PeerId peerId_;
     BlockBodiesPacket66 packet_;
+    time_point_t received_at_;  // for response time measurement, as execution may be delayed
+    size_t data_size_;
 };
 
 }  // namespace silkworm
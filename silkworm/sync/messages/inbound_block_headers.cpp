@@ -24,7 +24,7 @@
 namespace silkworm {
 
 InboundBlockHeaders::InboundBlockHeaders(ByteView data, PeerId peer_id)
-    : peerId_(std::move(peer_id)) {
+    : peerId_(std::move(peer_id)), received_at_(std::chrono::system_clock::now()), data_size_(data.size()) {
     success_or_throw(rlp::decode(data, packet_));
     SILK_TRACE << "Received message " << *this;
 }
@@ -39,6 +39,9 @@ void InboundBlockHeaders::execute(db::ROAccess, HeaderChain& hc, BodySequence&,
         highestBlock = std::max(highestBlock, header.number);
     }
 
+    sentry.peer_scheduler().response_received(peerId_, packet_.requestId, data_size_, packet_.request.size(), received_at_);
+    sentry.peer_scheduler().update_max_block(peerId_, highestBlock);
+
     // Save the headers
     auto [penalty, requestMoreHeaders] = hc.accept_headers(packet_.request, packet_.requestId, peerId_);
 
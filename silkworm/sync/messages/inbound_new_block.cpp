@@ -21,6 +21,7 @@
 #include <silkworm/infra/common/decoding_exception.hpp>
 #include <silkworm/infra/common/log.hpp>
 #include <silkworm/sync/internals/body_sequence.hpp>
+#include <silkworm/sync/sentry_client.hpp>
 
 namespace silkworm {
 
@@ -31,9 +32,11 @@ InboundNewBlock::InboundNewBlock(ByteView data, PeerId peer_id)
     SILK_TRACE << "Received message " << *this;
 }
 
-void InboundNewBlock::execute(db::ROAccess, HeaderChain&, BodySequence& bs, SentryClient&) {
+void InboundNewBlock::execute(db::ROAccess, HeaderChain&, BodySequence& bs, SentryClient& sentry) {
     SILK_TRACE << "Processing message " << *this;
 
+    sentry.peer_scheduler().update_max_block(peerId_, packet_.block.header.number);
+
     // todo: complete implementation
     /*
     // use packet_.td ?
@@ -28,6 +28,7 @@ namespace silkworm {
 GetBlockBodiesPacket66& OutboundGetBlockBodies::packet() { return packet_; }
 std::vector<PeerPenalization>& OutboundGetBlockBodies::penalties() { return penalizations_; }
 BlockNum& OutboundGetBlockBodies::min_block() { return min_block_; }
+std::optional<PeerId>& OutboundGetBlockBodies::target_peer() { return target_peer_; }
 bool OutboundGetBlockBodies::packet_present() const { return !packet_.request.empty(); }
 
 void OutboundGetBlockBodies::execute(db::ROAccess, HeaderChain&, BodySequence& bs, SentryClient& sentry) {
@@ -60,7 +61,13 @@ Bytes OutboundGetBlockBodies::message_data() const {
 std::vector<PeerId> OutboundGetBlockBodies::send_packet(SentryClient& sentry) {
     // SILK_TRACE << "Sending message OutboundGetBlockBodies with send_message_by_min_block, content:" << packet_;
 
-    auto peers = sentry.send_message_by_min_block(*this, min_block_, 0);
+    auto peers = target_peer_ ? sentry.send_message_by_id(*this, *target_peer_)
+                              : sentry.send_message_by_min_block(*this, min_block_, 0);
+
+    auto now = std::chrono::system_clock::now();
+    for (const auto& peer_id : peers) {
+        sentry.peer_scheduler().request_sent(peer_id, packet_.requestId, now);
+    }
 
     // SILK_TRACE << "Received sentry result of OutboundGetBlockBodies reqId=" << packet_.requestId << ": "
     //            << std::to_string(peers.size()) + " peer(s)";
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <optional>
 #include <vector>
 
 #include <silkworm/sync/packets/get_block_bodies_packet.hpp>
@@ -42,6 +43,7 @@ class OutboundGetBlockBodies : public OutboundMessage {
     GetBlockBodiesPacket66& packet();
     std::vector<PeerPenalization>& penalties();
     BlockNum& min_block();
+    std::optional<PeerId>& target_peer();  // if set, the request goes to this peer only
 
     [[nodiscard]] bool packet_present() const;
 
@@ -51,6 +53,7 @@ class OutboundGetBlockBodies : public OutboundMessage {
     GetBlockBodiesPacket66 packet_{};
     std::vector<PeerPenalization> penalizations_;
     BlockNum min_block_{0};
+    std::optional<PeerId> target_peer_;
 };
 
 }  // namespace silkworm
@@ -27,8 +27,16 @@ namespace silkworm {
 
 GetBlockHeadersPacket66& OutboundGetBlockHeaders::packet() { return packet_; }
 std::vector<PeerPenalization>& OutboundGetBlockHeaders::penalties() { return penalizations_; }
+std::optional<PeerId>& OutboundGetBlockHeaders::target_peer() { return target_peer_; }
 bool OutboundGetBlockHeaders::packet_present() const { return (packet_.request.amount != 0); }
 
+BlockNum OutboundGetBlockHeaders::min_block() const {
+    if (!std::holds_alternative<BlockNum>(packet_.request.origin)) return 0;
+    BlockNum min_block = std::get<BlockNum>(packet_.request.origin);
+    if (!packet_.request.reverse) min_block += packet_.request.amount * packet_.request.skip;
+    return min_block;
+}
+
 void OutboundGetBlockHeaders::execute(db::ROAccess, HeaderChain& hc, BodySequence&, SentryClient& sentry) {
     if (packet_present()) {
         auto send_outcome = send_packet(sentry);
@@ -63,12 +71,15 @@ std::vector<PeerId> OutboundGetBlockHeaders::send_packet(SentryClient& sentry) {
     if (std::get<BlockNum>(packet_.request.origin) == 0 || packet_.request.amount == 0)
         throw std::logic_error("OutboundGetBlockHeaders expects block number > 0 and amount > 0");
 
-    BlockNum min_block = std::get<BlockNum>(packet_.request.origin);  // choose target peer
-    if (!packet_.request.reverse) min_block += packet_.request.amount * packet_.request.skip;
-
     // SILK_TRACE << "Sending message OutboundGetBlockHeaders with send_message_by_min_block, content:" << packet_;
 
-    auto peers = sentry.send_message_by_min_block(*this, min_block, 0);
+    auto peers = target_peer_ ? sentry.send_message_by_id(*this, *target_peer_)
+                              : sentry.send_message_by_min_block(*this, min_block(), 0);
+
+    auto now = std::chrono::system_clock::now();
+    for (const auto& peer_id : peers) {
+        sentry.peer_scheduler().request_sent(peer_id, packet_.requestId, now);
+    }
 
     // SILK_TRACE << "Received sentry result of OutboundGetBlockHeaders reqId=" << packet_.requestId << ": "
     //            << std::to_string(peers.size()) + " peer(s)";
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <optional>
 #include <vector>
 
 #include <silkworm/sync/packets/get_block_headers_packet.hpp>
@@ -42,13 +43,16 @@ class OutboundGetBlockHeaders : public OutboundMessage {
 
     GetBlockHeadersPacket66& packet();
     std::vector<PeerPenalization>& penalties();
+    std::optional<PeerId>& target_peer();  // if set, the request goes to this peer only
     [[nodiscard]] bool packet_present() const;
+    [[nodiscard]] BlockNum min_block() const;  // the height a peer must have to serve the request
 
   private:
     std::vector<PeerId> send_packet(SentryClient&);
 
     GetBlockHeadersPacket66 packet_{};
     std::vector<PeerPenalization> penalizations_;
+    std::optional<PeerId> target_peer_;
 };
 
 }  // namespace silkworm
@@ -282,6 +282,13 @@ boost::asio::awaitable<void> SentryClient::receive_peer_events() {
     std::function<awaitable<void>(silkworm::sentry::api::api_common::PeerEvent)> consumer = [this](auto event) -> awaitable<void> {
         co_await count_active_peers_async();
 
+        PeerId peer_id = event.peer_public_key->serialized();
+        if (event.event_id == silkworm::sentry::api::api_common::PeerEventId::kAdded) {
+            peer_scheduler_.add_peer(peer_id);
+        } else {
+            peer_scheduler_.remove_peer(peer_id);
+        }
+
         auto service = co_await sentry_client_->service();
         auto peer_info_opt = co_await service->peer_by_id(event.peer_public_key.value());
 
@@ -289,6 +296,12 @@ boost::asio::awaitable<void> SentryClient::receive_peer_events() {
     };
 
     auto service = co_await sentry_client_->service();
+
+    // Peers connected before subscribing to the events are scheduled as well: the scheduler only tracks known peers
+    for (const auto& peer_info : co_await service->peers()) {
+        peer_scheduler_.add_peer(peer_info.url.public_key().serialized());
+    }
+
     co_await service->peer_events(std::move(consumer));
 }
 
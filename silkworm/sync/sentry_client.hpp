@@ -32,6 +32,7 @@
 #include <silkworm/sentry/api/api_common/message_from_peer.hpp>
 #include <silkworm/sentry/api/api_common/peer_event.hpp>
 #include <silkworm/sentry/api/api_common/sentry_client.hpp>
+#include <silkworm/sync/internals/peer_scheduler.hpp>
 #include <silkworm/sync/internals/types.hpp>
 #include <silkworm/sync/messages/inbound_message.hpp>
 #include <silkworm/sync/messages/outbound_message.hpp>
@@ -93,6 +94,9 @@ class SentryClient {
 
     uint64_t active_peers();  // return cached peers count
 
+    // per-peer performance tracking of header & body requests
+    PeerScheduler& peer_scheduler() { return peer_scheduler_; }
+
     // receive messages and peer events
     boost::asio::awaitable<void> async_run();
 
@@ -114,6 +118,7 @@ class SentryClient {
     concurrency::TaskGroup tasks_;
 
     std::atomic<uint64_t> active_peers_{0};
+    PeerScheduler peer_scheduler_;
 };
 
 }  // namespace silkworm
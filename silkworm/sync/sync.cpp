@@ -48,6 +48,7 @@ Sync::Sync(boost::asio::io_context& io_context,
             .eth_api_spec = kDefaultEth2ApiSpec,
             .private_api_addr = rpc_settings.private_api_addr,
             .num_workers = 1,  // single-client so just one worker should be OK
+            .workers_cpu_set = rpc_settings.workers_cpu_set,
             .jwt_secret_file = rpc_settings.jwt_secret_file,
         };
         // TODO(canepat) replace customized std::shared_ptr by using ::mdbx::env instead of
@@ -56,7 +57,8 @@ Sync::Sync(boost::asio::io_context& io_context,
             void operator()(mdbx::env_managed*) {}
         };
         std::shared_ptr<mdbx::env_managed> env_ptr{&chaindata_env, env_custom_deleter{}};
-        engine_rpc_server_ = std::make_unique<rpc::Daemon>(engine_rpc_settings, env_ptr);
+        engine_rpc_server_ = std::make_unique<rpc::Daemon>(engine_rpc_settings, env_ptr, rpc_settings.snapshot_repository,
+                                                           rpc_settings.task_scheduler);
 
         // Create the synchronization algorithm based on Casper + LMD-GHOST, i.e. PoS
         auto pos_sync = std::make_unique<PoSSync>(block_exchange_, execution);
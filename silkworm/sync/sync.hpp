@@ -40,7 +40,10 @@ struct EngineRpcSettings {
     std::string private_api_addr{kDefaultPrivateApiAddr};
     log::Level log_verbosity{log::Level::kInfo};
     concurrency::WaitMode wait_mode{concurrency::WaitMode::blocking};
+    concurrency::CpuSet workers_cpu_set;  // The CPUs running the workers (empty means no pinning)
     std::string jwt_secret_file;
+    snapshot::SnapshotRepository* snapshot_repository{nullptr};  // Blocks frozen out of chaindata (if any)
+    concurrency::TaskScheduler* task_scheduler{nullptr};         // Node scheduler running the workers' tasks (if any)
 };
 
 class Sync {